@@ -25,7 +25,7 @@
 
 // Version number for shader translation API.
 // It is incremented every time the API changes.
-#define ANGLE_SH_VERSION 174
+#define ANGLE_SH_VERSION 177
 
 enum ShShaderSpec
 {
@@ -218,6 +218,11 @@ const ShCompileOptions SH_EMULATE_ATAN2_FLOAT_FUNCTION = UINT64_C(1) << 30;
 // "uniform highp uint webgl_angle_ViewID_OVR".
 const ShCompileOptions SH_TRANSLATE_VIEWID_OVR_TO_UNIFORM = UINT64_C(1) << 31;
 
+// Runs every AST traversal pass in a traversal of its own instead of sharing traversals between
+// the passes that allow it. The translation is the same either way, this is only used to test
+// that it is.
+const ShCompileOptions SH_DONT_SHARE_AST_TRAVERSALS = UINT64_C(1) << 32;
+
 // Defines alternate strategies for implementing array index clamping.
 enum ShArrayIndexClampingStrategy
 {
@@ -390,6 +395,15 @@ using ShHandle = void *;
 namespace sh
 {
 
+// Time taken by one step of the last compilation, for example parsing, an AST pass or the output
+// of the object code. Passes that share a single traversal of the AST are reported as one step,
+// with their names joined by '+'.
+struct PassTiming
+{
+    std::string name;
+    double seconds;
+};
+
 //
 // Driver must call this first, once, before doing any other compiler operations.
 // If the function succeeds, the return value is true, else false.
@@ -500,6 +514,17 @@ const std::vector<sh::InterfaceBlock> *GetInterfaceBlocks(const ShHandle handle)
 sh::WorkGroupSize GetComputeShaderLocalGroupSize(const ShHandle handle);
 int GetVertexShaderNumViews(const ShHandle handle);
 
+// Returns the time taken by each step of the last compilation, in the order the steps ran.
+// Parameters:
+// handle: Specifies the compiler
+const std::vector<sh::PassTiming> *GetPassTimings(const ShHandle handle);
+
+// Returns the most memory the pool allocator used for the last compilation, not counting the
+// built-in symbol table it keeps from compile to compile.
+// Parameters:
+// handle: Specifies the compiler
+size_t GetPeakPoolAllocatorBytes(const ShHandle handle);
+
 // Returns true if the passed in variables pack in maxVectors followingthe packing rules from the
 // GLSL 1.017 spec, Appendix A, section 7.
 // Returns false otherwise. Also look at the SH_ENFORCE_PACKING_RESTRICTIONS
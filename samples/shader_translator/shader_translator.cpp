@@ -11,7 +11,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
 #include <sstream>
+#include <string>
 #include <vector>
 #include "angle_gl.h"
 
@@ -26,9 +30,28 @@ enum TFailCode
     EFailCompilerCreate,
 };
 
+// The compilers are created on first use and reused for every shader of their type.
+struct Compilers
+{
+    ShHandle vertex   = 0;
+    ShHandle fragment = 0;
+    ShHandle compute  = 0;
+};
+
 static void usage();
 static sh::GLenum FindShaderType(const char *fileName);
-static bool CompileFile(char *fileName, ShHandle compiler, ShCompileOptions compileOptions);
+static ShHandle GetCompiler(sh::GLenum shaderType,
+                            ShShaderSpec spec,
+                            ShShaderOutput output,
+                            ShBuiltInResources *resources,
+                            Compilers *compilers);
+static bool CompileFile(const char *fileName, ShHandle compiler, ShCompileOptions compileOptions);
+static bool CompileBatch(const char *listFileName,
+                         ShShaderSpec spec,
+                         ShShaderOutput output,
+                         ShBuiltInResources *resources,
+                         ShCompileOptions compileOptions,
+                         Compilers *compilers);
 static void LogMsg(const char *msg, const char *name, const int num, const char *logName);
 static void PrintVariable(const std::string &prefix, size_t index, const sh::ShaderVariable &var);
 static void PrintActiveVariables(ShHandle compiler);
@@ -71,11 +94,10 @@ int main(int argc, char *argv[])
 
     ShCompileOptions compileOptions = 0;
     int numCompiles = 0;
-    ShHandle vertexCompiler = 0;
-    ShHandle fragmentCompiler = 0;
-    ShHandle computeCompiler  = 0;
+    Compilers compilers;
     ShShaderSpec spec = SH_GLES2_SPEC;
     ShShaderOutput output = SH_ESSL_OUTPUT;
+    std::vector<const char *> listFileNames;
 
     sh::Initialize();
 
@@ -94,6 +116,16 @@ int main(int argc, char *argv[])
               case 'o': compileOptions |= SH_OBJECT_CODE; break;
               case 'u': compileOptions |= SH_VARIABLES; break;
               case 'p': resources.WEBGL_debug_shader_precision = 1; break;
+              case 'l':
+                if (argv[0][2] == '=')
+                {
+                    listFileNames.push_back(&argv[0][3]);
+                }
+                else
+                {
+                    failCode = EFailUsage;
+                }
+                break;
               case 's':
                 if (argv[0][2] == '=')
                 {
@@ -224,42 +256,8 @@ int main(int argc, char *argv[])
         }
         else
         {
-            if (spec != SH_GLES2_SPEC && spec != SH_WEBGL_SPEC)
-            {
-                resources.MaxDrawBuffers = 8;
-                resources.MaxVertexTextureImageUnits = 16;
-                resources.MaxTextureImageUnits       = 16;
-            }
-            ShHandle compiler = 0;
-            switch (FindShaderType(argv[0]))
-            {
-              case GL_VERTEX_SHADER:
-                if (vertexCompiler == 0)
-                {
-                    vertexCompiler =
-                        sh::ConstructCompiler(GL_VERTEX_SHADER, spec, output, &resources);
-                }
-                compiler = vertexCompiler;
-                break;
-              case GL_FRAGMENT_SHADER:
-                if (fragmentCompiler == 0)
-                {
-                    fragmentCompiler =
-                        sh::ConstructCompiler(GL_FRAGMENT_SHADER, spec, output, &resources);
-                }
-                compiler = fragmentCompiler;
-                break;
-              case GL_COMPUTE_SHADER:
-                  if (computeCompiler == 0)
-                  {
-                      computeCompiler =
-                          sh::ConstructCompiler(GL_COMPUTE_SHADER, spec, output, &resources);
-                  }
-                  compiler = computeCompiler;
-                  break;
-
-              default: break;
-            }
+            ShHandle compiler =
+                GetCompiler(FindShaderType(argv[0]), spec, output, &resources, &compilers);
             if (compiler)
             {
                 bool compiled = CompileFile(argv[0], compiler, compileOptions);
@@ -296,17 +294,31 @@ int main(int argc, char *argv[])
         }
     }
 
-    if ((vertexCompiler == 0) && (fragmentCompiler == 0) && (computeCompiler == 0))
+    // The lists are translated once every option is parsed, so that the options apply to them
+    // wherever they are on the command line.
+    for (const char *listFileName : listFileNames)
+    {
+        if (failCode != ESuccess)
+        {
+            break;
+        }
+        if (!CompileBatch(listFileName, spec, output, &resources, compileOptions, &compilers))
+        {
+            failCode = EFailCompile;
+        }
+    }
+
+    if ((compilers.vertex == 0) && (compilers.fragment == 0) && (compilers.compute == 0))
         failCode = EFailUsage;
     if (failCode == EFailUsage)
         usage();
 
-    if (vertexCompiler)
-        sh::Destruct(vertexCompiler);
-    if (fragmentCompiler)
-        sh::Destruct(fragmentCompiler);
-    if (computeCompiler)
-        sh::Destruct(computeCompiler);
+    if (compilers.vertex)
+        sh::Destruct(compilers.vertex);
+    if (compilers.fragment)
+        sh::Destruct(compilers.fragment);
+    if (compilers.compute)
+        sh::Destruct(compilers.compute);
 
     sh::Finalize();
 
@@ -320,11 +332,13 @@ void usage()
 {
     // clang-format off
     printf(
-        "Usage: translate [-i -o -u -l -p -b=e -b=g -b=h9 -x=i -x=d] file1 file2 ...\n"
+        "Usage: translate [-i -o -u -l=FILE -p -b=e -b=g -b=h9 -x=i -x=d] file1 file2 ...\n"
         "Where: filename : filename ending in .frag or .vert\n"
         "       -i       : print intermediate tree\n"
         "       -o       : print translated code\n"
         "       -u       : print active attribs, uniforms, varyings and program outputs\n"
+        "       -l=FILE  : translate the shaders listed in FILE, one filename per line, and\n"
+        "                  print the time taken instead of the translations\n"
         "       -p       : use precision emulation\n"
         "       -s=e2    : use GLES2 spec (this is by default)\n"
         "       -s=e3    : use GLES3 spec (in development)\n"
@@ -382,10 +396,49 @@ sh::GLenum FindShaderType(const char *fileName)
     return GL_FRAGMENT_SHADER;
 }
 
+//
+//   Return the compiler for the shader type, creating it if this is the first shader of that type.
+//
+ShHandle GetCompiler(sh::GLenum shaderType,
+                     ShShaderSpec spec,
+                     ShShaderOutput output,
+                     ShBuiltInResources *resources,
+                     Compilers *compilers)
+{
+    if (spec != SH_GLES2_SPEC && spec != SH_WEBGL_SPEC)
+    {
+        resources->MaxDrawBuffers             = 8;
+        resources->MaxVertexTextureImageUnits = 16;
+        resources->MaxTextureImageUnits       = 16;
+    }
+
+    ShHandle *compiler = nullptr;
+    switch (shaderType)
+    {
+        case GL_VERTEX_SHADER:
+            compiler = &compilers->vertex;
+            break;
+        case GL_FRAGMENT_SHADER:
+            compiler = &compilers->fragment;
+            break;
+        case GL_COMPUTE_SHADER:
+            compiler = &compilers->compute;
+            break;
+        default:
+            return 0;
+    }
+
+    if (*compiler == 0)
+    {
+        *compiler = sh::ConstructCompiler(shaderType, spec, output, resources);
+    }
+    return *compiler;
+}
+
 //
 //   Read a file's data into a string, and compile it using sh::Compile
 //
-bool CompileFile(char *fileName, ShHandle compiler, ShCompileOptions compileOptions)
+bool CompileFile(const char *fileName, ShHandle compiler, ShCompileOptions compileOptions)
 {
     ShaderSource source;
     if (!ReadShaderSource(fileName, source))
@@ -397,6 +450,83 @@ bool CompileFile(char *fileName, ShHandle compiler, ShCompileOptions compileOpti
     return ret ? true : false;
 }
 
+//
+//   Translate every shader listed in a file with the same compilers, the way a browser or a game
+//   translates all of its shaders at startup, and print how long that took. Per-shader output is
+//   skipped, except for the info log of the shaders that fail to compile.
+//
+bool CompileBatch(const char *listFileName,
+                  ShShaderSpec spec,
+                  ShShaderOutput output,
+                  ShBuiltInResources *resources,
+                  ShCompileOptions compileOptions,
+                  Compilers *compilers)
+{
+    std::ifstream list(listFileName);
+    if (!list)
+    {
+        printf("Error: unable to open shader list: %s\n", listFileName);
+        return false;
+    }
+
+    // Time spent in each stage of the translation, in the order the stages first ran.
+    std::vector<std::pair<std::string, double>> stageSeconds;
+    size_t peakPoolAllocatorBytes = 0;
+    int numCompiled               = 0;
+    int numFailed                 = 0;
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    std::string fileName;
+    while (std::getline(list, fileName))
+    {
+        if (fileName.empty())
+            continue;
+
+        ShHandle compiler =
+            GetCompiler(FindShaderType(fileName.c_str()), spec, output, resources, compilers);
+        if (!compiler)
+        {
+            printf("Error: unable to create a compiler for: %s\n", fileName.c_str());
+            return false;
+        }
+
+        ++numCompiled;
+        if (!CompileFile(fileName.c_str(), compiler, compileOptions | SH_OBJECT_CODE))
+        {
+            ++numFailed;
+            printf("#### FAILED %s ####\n%s\n", fileName.c_str(), sh::GetInfoLog(compiler).c_str());
+            continue;
+        }
+
+        for (const sh::PassTiming &timing : *sh::GetPassTimings(compiler))
+        {
+            auto stage = stageSeconds.begin();
+            while (stage != stageSeconds.end() && stage->first != timing.name)
+                ++stage;
+            if (stage == stageSeconds.end())
+                stage = stageSeconds.insert(stage, std::make_pair(timing.name, 0.0));
+            stage->second += timing.seconds;
+        }
+        peakPoolAllocatorBytes =
+            std::max(peakPoolAllocatorBytes, sh::GetPeakPoolAllocatorBytes(compiler));
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    printf("#### BATCH %s ####\n", listFileName);
+    printf("shaders: %d (%d failed)\n", numCompiled, numFailed);
+    printf("total: %.3f ms (%.1f shaders/s)\n", elapsed.count() * 1000.0,
+           elapsed.count() > 0.0 ? numCompiled / elapsed.count() : 0.0);
+    for (const auto &stage : stageSeconds)
+    {
+        printf("  %-40s %10.3f ms\n", stage.first.c_str(), stage.second * 1000.0);
+    }
+    printf("peak pool allocator: %zu bytes\n\n", peakPoolAllocatorBytes);
+
+    return numFailed == 0;
+}
+
 void LogMsg(const char *msg, const char *name, const int num, const char *logName)
 {
     printf("#### %s %s %d %s ####\n", msg, name, num, logName);
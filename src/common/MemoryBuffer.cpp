@@ -8,6 +8,7 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <utility>
 
 #include "common/debug.h"
 
@@ -25,6 +26,18 @@ MemoryBuffer::~MemoryBuffer()
     mData = nullptr;
 }
 
+MemoryBuffer::MemoryBuffer(MemoryBuffer &&other) : MemoryBuffer()
+{
+    *this = std::move(other);
+}
+
+MemoryBuffer &MemoryBuffer::operator=(MemoryBuffer &&other)
+{
+    std::swap(mSize, other.mSize);
+    std::swap(mData, other.mData);
+    return *this;
+}
+
 bool MemoryBuffer::resize(size_t size)
 {
     if (size == 0)
@@ -0,0 +1,470 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// api_trace.cpp: A low-overhead trace of the API calls.
+
+#include "common/api_trace.h"
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+#include "common/angleutils.h"
+#include "common/debug.h"
+
+namespace angle
+{
+
+namespace priv
+{
+std::atomic<bool> g_apiTraceEnabled(false);
+}  // namespace priv
+
+namespace
+{
+
+// The records of one thread. Only the owning thread writes them. Each slot is guarded by a
+// sequence number, so that a flush from another thread can tell a slot it read while it was being
+// overwritten: the sequence is odd while the slot is written, and 2 * (n + 1) once it holds the
+// record n of the thread.
+class ApiTraceBuffer : angle::NonCopyable
+{
+  public:
+    explicit ApiTraceBuffer(uint32_t threadId);
+
+    void record(const char *entryPoint,
+                const char *format,
+                uint64_t timestamp,
+                const uint64_t *args,
+                size_t argCount);
+
+    // Only called with the lock of the registry held. Returns the number of records that were
+    // overwritten before they could be flushed.
+    size_t flush(std::vector<ApiTraceRecord> *records);
+
+  private:
+    struct Slot
+    {
+        std::atomic<uint64_t> sequence;
+        std::atomic<const char *> entryPoint;
+        std::atomic<const char *> format;
+        std::atomic<uint64_t> timestamp;
+        std::atomic<uint32_t> argCount;
+        std::atomic<uint64_t> args[kMaxApiTraceArgs];
+    };
+
+    const uint32_t mThreadId;
+    std::atomic<uint64_t> mWriteCount;
+    uint64_t mReadCount;
+    std::unique_ptr<Slot[]> mSlots;
+};
+
+ApiTraceBuffer::ApiTraceBuffer(uint32_t threadId)
+    : mThreadId(threadId),
+      mWriteCount(0),
+      mReadCount(0),
+      mSlots(new Slot[kApiTraceRecordsPerThread])
+{
+    for (size_t slotIndex = 0; slotIndex < kApiTraceRecordsPerThread; ++slotIndex)
+    {
+        mSlots[slotIndex].sequence.store(0, std::memory_order_relaxed);
+    }
+}
+
+void ApiTraceBuffer::record(const char *entryPoint,
+                            const char *format,
+                            uint64_t timestamp,
+                            const uint64_t *args,
+                            size_t argCount)
+{
+    const uint64_t recordIndex = mWriteCount.load(std::memory_order_relaxed);
+    Slot &slot                 = mSlots[recordIndex % kApiTraceRecordsPerThread];
+
+    slot.sequence.store(2 * recordIndex + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.entryPoint.store(entryPoint, std::memory_order_relaxed);
+    slot.format.store(format, std::memory_order_relaxed);
+    slot.timestamp.store(timestamp, std::memory_order_relaxed);
+    slot.argCount.store(static_cast<uint32_t>(argCount), std::memory_order_relaxed);
+    for (size_t argIndex = 0; argIndex < argCount; ++argIndex)
+    {
+        slot.args[argIndex].store(args[argIndex], std::memory_order_relaxed);
+    }
+
+    slot.sequence.store(2 * recordIndex + 2, std::memory_order_release);
+    mWriteCount.store(recordIndex + 1, std::memory_order_release);
+}
+
+size_t ApiTraceBuffer::flush(std::vector<ApiTraceRecord> *records)
+{
+    const uint64_t writeCount = mWriteCount.load(std::memory_order_acquire);
+    const uint64_t oldest =
+        writeCount > kApiTraceRecordsPerThread ? writeCount - kApiTraceRecordsPerThread : 0;
+    const uint64_t first = std::max(mReadCount, oldest);
+    size_t dropped       = static_cast<size_t>(first - mReadCount);
+
+    for (uint64_t recordIndex = first; recordIndex < writeCount; ++recordIndex)
+    {
+        const Slot &slot = mSlots[recordIndex % kApiTraceRecordsPerThread];
+
+        const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * recordIndex + 2)
+        {
+            // The thread has already started to write a more recent record in this slot.
+            ++dropped;
+            continue;
+        }
+
+        ApiTraceRecord record;
+        record.entryPoint = slot.entryPoint.load(std::memory_order_relaxed);
+        record.format     = slot.format.load(std::memory_order_relaxed);
+        record.timestamp  = slot.timestamp.load(std::memory_order_relaxed);
+        record.threadId   = mThreadId;
+        record.argCount   = std::min<uint32_t>(slot.argCount.load(std::memory_order_relaxed),
+                                             static_cast<uint32_t>(kMaxApiTraceArgs));
+        for (uint32_t argIndex = 0; argIndex < record.argCount; ++argIndex)
+        {
+            record.args[argIndex] = slot.args[argIndex].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+        {
+            ++dropped;
+            continue;
+        }
+
+        records->push_back(record);
+    }
+
+    mReadCount = writeCount;
+    return dropped;
+}
+
+// The buffers of the threads that recorded a call.
+class ApiTraceRegistry : angle::NonCopyable
+{
+  public:
+    ApiTraceRegistry() : mNextThreadId(0), mExitedThreadDropped(0) {}
+
+    ApiTraceBuffer *getCurrentThreadBuffer();
+    size_t flush(std::vector<ApiTraceRecord> *records);
+
+    // Keeps the records of a thread that exits until the next flush, and frees its buffer.
+    void removeBuffer(ApiTraceBuffer *buffer);
+
+  private:
+    std::mutex mMutex;
+    uint32_t mNextThreadId;
+    std::vector<ApiTraceBuffer *> mBuffers;
+
+    // The records of the threads that exited since the last flush. At most
+    // kApiTraceRecordsPerThread of them are kept, the ones of the threads that exited first are
+    // dropped first.
+    std::vector<ApiTraceRecord> mExitedThreadRecords;
+    size_t mExitedThreadDropped;
+};
+
+ApiTraceRegistry *GetApiTraceRegistry();
+
+// Returns the buffer of the calling thread to the registry when the thread exits.
+struct ApiTraceBufferDeleter
+{
+    void operator()(ApiTraceBuffer *buffer) const { GetApiTraceRegistry()->removeBuffer(buffer); }
+};
+
+thread_local std::unique_ptr<ApiTraceBuffer, ApiTraceBufferDeleter> t_currentThreadBuffer;
+
+ApiTraceBuffer *ApiTraceRegistry::getCurrentThreadBuffer()
+{
+    if (!t_currentThreadBuffer)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        ApiTraceBuffer *buffer = new ApiTraceBuffer(mNextThreadId++);
+        mBuffers.push_back(buffer);
+        t_currentThreadBuffer.reset(buffer);
+    }
+    return t_currentThreadBuffer.get();
+}
+
+size_t ApiTraceRegistry::flush(std::vector<ApiTraceRecord> *records)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    const size_t firstRecord = records->size();
+    records->insert(records->end(), mExitedThreadRecords.begin(), mExitedThreadRecords.end());
+    mExitedThreadRecords.clear();
+
+    size_t dropped       = mExitedThreadDropped;
+    mExitedThreadDropped = 0;
+    for (ApiTraceBuffer *buffer : mBuffers)
+    {
+        dropped += buffer->flush(records);
+    }
+
+    std::stable_sort(records->begin() + firstRecord, records->end(),
+                     [](const ApiTraceRecord &a, const ApiTraceRecord &b) {
+                         return a.timestamp < b.timestamp;
+                     });
+    return dropped;
+}
+
+void ApiTraceRegistry::removeBuffer(ApiTraceBuffer *buffer)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mExitedThreadDropped += buffer->flush(&mExitedThreadRecords);
+    if (mExitedThreadRecords.size() > kApiTraceRecordsPerThread)
+    {
+        size_t excess = mExitedThreadRecords.size() - kApiTraceRecordsPerThread;
+        mExitedThreadRecords.erase(mExitedThreadRecords.begin(),
+                                   mExitedThreadRecords.begin() + excess);
+        mExitedThreadDropped += excess;
+    }
+
+    mBuffers.erase(std::find(mBuffers.begin(), mBuffers.end(), buffer));
+    delete buffer;
+}
+
+ApiTraceRegistry *GetApiTraceRegistry()
+{
+    // Never destroyed, since threads may still record calls during the static destruction.
+    static ApiTraceRegistry *registry = new ApiTraceRegistry();
+    return registry;
+}
+
+uint64_t GetTimestamp()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+// Formats one conversion of a printf format with a recorded argument. |spec| holds the flags,
+// width and precision, without the length modifier.
+void FormatApiTraceArg(const std::string &spec,
+                       char conversion,
+                       uint64_t arg,
+                       bool longLong,
+                       std::string *out)
+{
+    char buffer[128];
+    int length = 0;
+    switch (conversion)
+    {
+        case 'd':
+        case 'i':
+            if (longLong)
+            {
+                length = snprintf(buffer, sizeof(buffer), (spec + "ll" + conversion).c_str(),
+                                  static_cast<long long>(arg));
+            }
+            else
+            {
+                length = snprintf(buffer, sizeof(buffer), (spec + conversion).c_str(),
+                                  static_cast<int>(static_cast<uint32_t>(arg)));
+            }
+            break;
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+            if (longLong)
+            {
+                length = snprintf(buffer, sizeof(buffer), (spec + "ll" + conversion).c_str(),
+                                  static_cast<unsigned long long>(arg));
+            }
+            else
+            {
+                length = snprintf(buffer, sizeof(buffer), (spec + conversion).c_str(),
+                                  static_cast<unsigned int>(arg));
+            }
+            break;
+        case 'c':
+            length = snprintf(buffer, sizeof(buffer), (spec + conversion).c_str(),
+                              static_cast<int>(arg));
+            break;
+        case 'e':
+        case 'E':
+        case 'f':
+        case 'F':
+        case 'g':
+        case 'G':
+        {
+            double value;
+            memcpy(&value, &arg, sizeof(value));
+            length = snprintf(buffer, sizeof(buffer), (spec + conversion).c_str(), value);
+            break;
+        }
+        case 'p':
+            // The formats of the entry points print the 0x prefix of the pointers.
+            length =
+                snprintf(buffer, sizeof(buffer), "%08llx", static_cast<unsigned long long>(arg));
+            break;
+        case 's':
+            length = snprintf(buffer, sizeof(buffer), "0x%08llx",
+                              static_cast<unsigned long long>(arg));
+            break;
+        default:
+            UNREACHABLE();
+            break;
+    }
+
+    if (length > 0)
+    {
+        out->append(buffer, std::min(static_cast<size_t>(length), sizeof(buffer) - 1));
+    }
+}
+
+void AppendJSONString(const char *string, std::string *out)
+{
+    out->push_back('"');
+    for (const char *character = string; *character != '\0'; ++character)
+    {
+        switch (*character)
+        {
+            case '"':
+                out->append("\\\"");
+                break;
+            case '\\':
+                out->append("\\\\");
+                break;
+            case '\n':
+                out->append("\\n");
+                break;
+            case '\t':
+                out->append("\\t");
+                break;
+            default:
+                if (static_cast<unsigned char>(*character) < 0x20)
+                {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", *character);
+                    out->append(escaped);
+                }
+                else
+                {
+                    out->push_back(*character);
+                }
+                break;
+        }
+    }
+    out->push_back('"');
+}
+
+}  // anonymous namespace
+
+namespace priv
+{
+
+void RecordApiCall(const char *entryPoint,
+                   const char *format,
+                   const uint64_t *args,
+                   size_t argCount)
+{
+    ApiTraceBuffer *buffer = GetApiTraceRegistry()->getCurrentThreadBuffer();
+    buffer->record(entryPoint, format, GetTimestamp(), args, argCount);
+}
+
+}  // namespace priv
+
+void SetApiTraceEnabled(bool enabled)
+{
+    priv::g_apiTraceEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+size_t FlushApiTrace(std::vector<ApiTraceRecord> *records)
+{
+    return GetApiTraceRegistry()->flush(records);
+}
+
+std::string FormatApiTraceRecord(const ApiTraceRecord &record)
+{
+    std::string result = record.entryPoint;
+
+    size_t argIndex = 0;
+    for (const char *character = record.format; *character != '\0'; ++character)
+    {
+        if (*character != '%')
+        {
+            result.push_back(*character);
+            continue;
+        }
+
+        ++character;
+        if (*character == '%')
+        {
+            result.push_back('%');
+            continue;
+        }
+
+        std::string spec = "%";
+        while (*character != '\0' && strchr("-+ #0123456789.", *character) != nullptr)
+        {
+            spec.push_back(*character);
+            ++character;
+        }
+
+        bool longLong = false;
+        while (*character != '\0' && strchr("hlLjzt", *character) != nullptr)
+        {
+            longLong = longLong || *character != 'h';
+            ++character;
+        }
+
+        if (*character == '\0' || strchr("diuxXoceEfFgGps", *character) == nullptr)
+        {
+            // Not a conversion, print the format as it is.
+            result.append(spec);
+            if (*character == '\0')
+            {
+                break;
+            }
+            result.push_back(*character);
+            continue;
+        }
+
+        if (argIndex >= record.argCount)
+        {
+            result.append("<missing>");
+            continue;
+        }
+        FormatApiTraceArg(spec, *character, record.args[argIndex++], longLong, &result);
+    }
+
+    return result;
+}
+
+std::string ExportApiTraceAsJSON(const std::vector<ApiTraceRecord> &records)
+{
+    std::string json = "{\"traceEvents\":[";
+
+    for (size_t recordIndex = 0; recordIndex < records.size(); ++recordIndex)
+    {
+        const ApiTraceRecord &record = records[recordIndex];
+
+        char header[128];
+        snprintf(header, sizeof(header),
+                 "%s\n{\"ph\":\"i\",\"s\":\"t\",\"pid\":0,\"tid\":%u,\"ts\":%llu.%03u,\"name\":",
+                 recordIndex > 0 ? "," : "", record.threadId,
+                 static_cast<unsigned long long>(record.timestamp / 1000),
+                 static_cast<unsigned int>(record.timestamp % 1000));
+        json.append(header);
+        AppendJSONString(record.entryPoint, &json);
+        json.append(",\"args\":{\"call\":");
+        AppendJSONString(FormatApiTraceRecord(record).c_str(), &json);
+        json.append("}}");
+    }
+
+    json.append("\n]}\n");
+    return json;
+}
+
+}  // namespace angle
@@ -0,0 +1,112 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// api_trace.h: A low-overhead trace of the API calls. Each call the EVENT macro traces is recorded
+// as a binary record of its entry point, a timestamp and its raw arguments into a ring buffer of
+// the calling thread. The records are only formatted when the trace is flushed.
+
+#ifndef COMMON_API_TRACE_H_
+#define COMMON_API_TRACE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace angle
+{
+
+constexpr size_t kMaxApiTraceArgs = 16;
+
+// The records a thread keeps before the oldest ones are overwritten.
+constexpr size_t kApiTraceRecordsPerThread = 4096;
+
+struct ApiTraceRecord
+{
+    // The name of the entry point and the printf format of its arguments, both string literals.
+    const char *entryPoint;
+    const char *format;
+    // Nanoseconds of a monotonic clock.
+    uint64_t timestamp;
+    // A sequential id of the recording thread.
+    uint32_t threadId;
+    uint32_t argCount;
+    uint64_t args[kMaxApiTraceArgs];
+};
+
+namespace priv
+{
+extern std::atomic<bool> g_apiTraceEnabled;
+
+inline uint64_t PackApiTraceArg(double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline uint64_t PackApiTraceArg(float value)
+{
+    return PackApiTraceArg(static_cast<double>(value));
+}
+
+template <typename T>
+inline typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value,
+                               uint64_t>::type
+PackApiTraceArg(T value)
+{
+    // Sign extended, so that a %d of a 64-bit value prints the same number.
+    return static_cast<uint64_t>(static_cast<int64_t>(value));
+}
+
+template <typename T>
+inline uint64_t PackApiTraceArg(T *value)
+{
+    return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value));
+}
+
+void RecordApiCall(const char *entryPoint,
+                   const char *format,
+                   const uint64_t *args,
+                   size_t argCount);
+}  // namespace priv
+
+// The trace is off by default. Checking it costs the entry points a relaxed load.
+inline bool IsApiTraceEnabled()
+{
+    return priv::g_apiTraceEnabled.load(std::memory_order_relaxed);
+}
+
+void SetApiTraceEnabled(bool enabled);
+
+// Records a call in the ring buffer of the calling thread. Never blocks once the thread has a
+// buffer.
+template <typename... Args>
+void RecordApiCall(const char *entryPoint, const char *format, Args... args)
+{
+    static_assert(sizeof...(Args) <= kMaxApiTraceArgs, "Too many arguments to trace.");
+    const uint64_t packedArgs[sizeof...(Args) + 1] = {priv::PackApiTraceArg(args)..., 0};
+    priv::RecordApiCall(entryPoint, format, packedArgs, sizeof...(Args));
+}
+
+// Appends the records of all the threads made since the last flush to |records|, ordered by their
+// timestamps. Returns the number of records that were overwritten before they could be flushed.
+size_t FlushApiTrace(std::vector<ApiTraceRecord> *records);
+
+// Formats a record as "entryPoint(arguments)". Strings are printed as their addresses since the
+// memory they pointed to may no longer be valid.
+std::string FormatApiTraceRecord(const ApiTraceRecord &record);
+
+// Exports records in the JSON format of the Chrome trace viewer, as instant events.
+std::string ExportApiTraceAsJSON(const std::vector<ApiTraceRecord> &records);
+
+}  // namespace angle
+
+#endif  // COMMON_API_TRACE_H_
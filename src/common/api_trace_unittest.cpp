@@ -0,0 +1,203 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// api_trace_unittest:
+//   Tests of the binary trace of the API calls.
+//
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "common/api_trace.h"
+#include "common/debug.h"
+
+using namespace angle;
+
+namespace
+{
+
+enum class TestEnum
+{
+    Value = 3,
+};
+
+class ApiTraceTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        // Discards the records of the previous tests.
+        std::vector<ApiTraceRecord> records;
+        FlushApiTrace(&records);
+        SetApiTraceEnabled(true);
+    }
+
+    void TearDown() override { SetApiTraceEnabled(false); }
+};
+
+void TracedEntryPoint(unsigned int mode, int first, float value, const void *pointer)
+{
+    EVENT("(GLenum mode = 0x%X, GLint first = %d, GLfloat value = %f, const void *pointer = 0x%0.8p)",
+          mode, first, value, pointer);
+}
+
+void UntracedArgumentsEntryPoint()
+{
+    EVENT("()");
+}
+
+// The arguments are recorded raw and formatted like the EVENT format says.
+TEST_F(ApiTraceTest, RecordAndFormat)
+{
+    TracedEntryPoint(0x1907, -12, 0.5f, reinterpret_cast<const void *>(0x1234));
+    UntracedArgumentsEntryPoint();
+
+    std::vector<ApiTraceRecord> records;
+    ASSERT_EQ(0u, FlushApiTrace(&records));
+    ASSERT_EQ(2u, records.size());
+
+    EXPECT_EQ(4u, records[0].argCount);
+    EXPECT_EQ(0x1907u, records[0].args[0]);
+    EXPECT_EQ(static_cast<uint64_t>(-12), records[0].args[1]);
+    EXPECT_EQ(
+        "TracedEntryPoint(GLenum mode = 0x1907, GLint first = -12, GLfloat value = 0.500000, "
+        "const void *pointer = 0x00001234)",
+        FormatApiTraceRecord(records[0]));
+
+    EXPECT_EQ(0u, records[1].argCount);
+    EXPECT_EQ("UntracedArgumentsEntryPoint()", FormatApiTraceRecord(records[1]));
+    EXPECT_LE(records[0].timestamp, records[1].timestamp);
+
+    // The records are flushed once.
+    records.clear();
+    EXPECT_EQ(0u, FlushApiTrace(&records));
+    EXPECT_TRUE(records.empty());
+}
+
+// Nothing is recorded while the trace is off.
+TEST_F(ApiTraceTest, Disabled)
+{
+    SetApiTraceEnabled(false);
+    UntracedArgumentsEntryPoint();
+
+    std::vector<ApiTraceRecord> records;
+    EXPECT_EQ(0u, FlushApiTrace(&records));
+    EXPECT_TRUE(records.empty());
+}
+
+// The formatting handles the lengths, the types of the arguments and malformed formats.
+TEST_F(ApiTraceTest, FormatConversions)
+{
+    const char *name = "name";
+    RecordApiCall("Conversions", "(%u, %llu, %d, %g, %s, %c, 100%%, %Xs, %ur)",
+                  static_cast<int>(-1), static_cast<uint64_t>(1) << 40, static_cast<short>(-3),
+                  2.5, name, 'a', 0xABu, 7u);
+    RecordApiCall("Missing", "(%d, %d)", 1);
+    RecordApiCall("Enum", "(%d, %d)", TestEnum::Value, true);
+
+    std::vector<ApiTraceRecord> records;
+    FlushApiTrace(&records);
+    ASSERT_EQ(3u, records.size());
+
+    char namePointer[32];
+    snprintf(namePointer, sizeof(namePointer), "0x%08llx",
+             static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(name)));
+    EXPECT_EQ(std::string("Conversions(4294967295, 1099511627776, -3, 2.5, ") + namePointer +
+                  ", a, 100%, ABs, 7r)",
+              FormatApiTraceRecord(records[0]));
+    EXPECT_EQ("Missing(1, <missing>)", FormatApiTraceRecord(records[1]));
+    EXPECT_EQ("Enum(3, 1)", FormatApiTraceRecord(records[2]));
+}
+
+// The oldest records of a thread are overwritten and counted as dropped.
+TEST_F(ApiTraceTest, Overwrite)
+{
+    const size_t callCount = kApiTraceRecordsPerThread + 100;
+    for (size_t call = 0; call < callCount; ++call)
+    {
+        RecordApiCall("Call", "(%d)", static_cast<int>(call));
+    }
+
+    std::vector<ApiTraceRecord> records;
+    EXPECT_EQ(100u, FlushApiTrace(&records));
+    ASSERT_EQ(kApiTraceRecordsPerThread, records.size());
+    for (size_t recordIndex = 0; recordIndex < records.size(); ++recordIndex)
+    {
+        EXPECT_EQ(recordIndex + 100, records[recordIndex].args[0]);
+    }
+}
+
+// Threads record concurrently with a flush. Every record is either flushed intact or counted as
+// dropped.
+TEST_F(ApiTraceTest, MultipleThreads)
+{
+    constexpr size_t kThreadCount    = 4;
+    constexpr size_t kCallsPerThread = 20000;
+
+    std::atomic<size_t> runningThreads(kThreadCount);
+    std::vector<std::thread> threads;
+    for (size_t threadIndex = 0; threadIndex < kThreadCount; ++threadIndex)
+    {
+        threads.emplace_back([threadIndex, &runningThreads]() {
+            for (size_t call = 0; call < kCallsPerThread; ++call)
+            {
+                RecordApiCall("Call", "(%d, %d, %d)", static_cast<int>(threadIndex),
+                              static_cast<int>(call), static_cast<int>(threadIndex + call));
+            }
+            --runningThreads;
+        });
+    }
+
+    std::vector<ApiTraceRecord> records;
+    size_t dropped = 0;
+    while (runningThreads > 0)
+    {
+        dropped += FlushApiTrace(&records);
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    dropped += FlushApiTrace(&records);
+
+    EXPECT_EQ(kThreadCount * kCallsPerThread, records.size() + dropped);
+
+    std::vector<uint64_t> nextCall(kThreadCount, 0);
+    for (const ApiTraceRecord &record : records)
+    {
+        ASSERT_EQ(3u, record.argCount);
+        ASSERT_LT(record.args[0], kThreadCount);
+        EXPECT_EQ(record.args[0] + record.args[1], record.args[2]);
+
+        // The calls of a thread keep their order.
+        EXPECT_GE(record.args[1], nextCall[record.args[0]]);
+        nextCall[record.args[0]] = record.args[1] + 1;
+    }
+}
+
+// The JSON export escapes the formatted calls.
+TEST_F(ApiTraceTest, ExportJSON)
+{
+    RecordApiCall("Quote", "(\"%d\"\\\n)", 5);
+
+    std::vector<ApiTraceRecord> records;
+    FlushApiTrace(&records);
+    ASSERT_EQ(1u, records.size());
+    records[0].timestamp = 1234567;
+    records[0].threadId  = 2;
+
+    EXPECT_EQ(
+        "{\"traceEvents\":[\n"
+        "{\"ph\":\"i\",\"s\":\"t\",\"pid\":0,\"tid\":2,\"ts\":1234.567,\"name\":\"Quote\","
+        "\"args\":{\"call\":\"Quote(\\\"5\\\"\\\\\\n)\"}}\n"
+        "]}\n",
+        ExportApiTraceAsJSON(records));
+    EXPECT_EQ("{\"traceEvents\":[\n]}\n", ExportApiTraceAsJSON(std::vector<ApiTraceRecord>()));
+}
+
+}  // anonymous namespace
@@ -18,6 +18,7 @@
 #include <string>
 
 #include "common/angleutils.h"
+#include "common/api_trace.h"
 
 #if !defined(TRACE_OUTPUT_FILE)
 #define TRACE_OUTPUT_FILE "angle_debug.txt"
@@ -196,15 +197,38 @@ std::ostream &FmtHexInt(std::ostream &os, T value)
 #define WARN() ANGLE_LOG(WARN)
 #define ERR() ANGLE_LOG(ERR)
 
+// A macro to record an API call in the binary trace, when it is enabled.
+#if defined(_MSC_VER)
+#define ANGLE_RECORD_API_CALL(message, ...)                           \
+    do                                                                \
+    {                                                                 \
+        if (angle::IsApiTraceEnabled())                               \
+        {                                                             \
+            angle::RecordApiCall(__FUNCTION__, message, __VA_ARGS__); \
+        }                                                             \
+    } while (0)
+#else
+#define ANGLE_RECORD_API_CALL(message, ...)                             \
+    do                                                                  \
+    {                                                                   \
+        if (angle::IsApiTraceEnabled())                                 \
+        {                                                               \
+            angle::RecordApiCall(__FUNCTION__, message, ##__VA_ARGS__); \
+        }                                                               \
+    } while (0)
+#endif  // _MSC_VER
+
 // A macro to log a performance event around a scope.
 #if defined(ANGLE_TRACE_ENABLED)
 #if defined(_MSC_VER)
-#define EVENT(message, ...) gl::ScopedPerfEventHelper scopedPerfEventHelper ## __LINE__("%s" message "\n", __FUNCTION__, __VA_ARGS__);
+#define EVENT(message, ...) gl::ScopedPerfEventHelper scopedPerfEventHelper ## __LINE__("%s" message "\n", __FUNCTION__, __VA_ARGS__); \
+    ANGLE_RECORD_API_CALL(message, __VA_ARGS__)
 #else
-#define EVENT(message, ...) gl::ScopedPerfEventHelper scopedPerfEventHelper("%s" message "\n", __FUNCTION__, ##__VA_ARGS__);
+#define EVENT(message, ...) gl::ScopedPerfEventHelper scopedPerfEventHelper("%s" message "\n", __FUNCTION__, ##__VA_ARGS__); \
+    ANGLE_RECORD_API_CALL(message, ##__VA_ARGS__)
 #endif // _MSC_VER
 #else
-#define EVENT(message, ...) (void(0))
+#define EVENT(message, ...) ANGLE_RECORD_API_CALL(message, ##__VA_ARGS__)
 #endif
 
 #if defined(COMPILER_GCC) || defined(__clang__)
@@ -21,6 +21,11 @@ const char *GetSharedLibraryExtension();
 Optional<std::string> GetCWD();
 bool SetCWD(const char *dirName);
 
+// Returns an empty string if the variable isn't set.
+std::string GetEnvironmentVar(const char *variableName);
+
+unsigned int GetCurrentProcessID();
+
 }  // namespace angle
 
 #endif  // COMMON_SYSTEM_UTILS_H_
@@ -14,6 +14,7 @@
 #include <unistd.h>
 
 #include <array>
+#include <cstdlib>
 
 namespace angle
 {
@@ -81,4 +82,15 @@ bool SetCWD(const char *dirName)
     return (chdir(dirName) == 0);
 }
 
+std::string GetEnvironmentVar(const char *variableName)
+{
+    const char *value = getenv(variableName);
+    return (value == nullptr ? std::string() : std::string(value));
+}
+
+unsigned int GetCurrentProcessID()
+{
+    return static_cast<unsigned int>(getpid());
+}
+
 }  // namespace angle
@@ -71,4 +71,21 @@ bool SetCWD(const char *dirName)
     return (SetCurrentDirectoryA(dirName) == TRUE);
 }
 
+std::string GetEnvironmentVar(const char *variableName)
+{
+    std::array<char, MAX_PATH> valueBuf;
+    DWORD result =
+        GetEnvironmentVariableA(variableName, valueBuf.data(), static_cast<DWORD>(valueBuf.size()));
+    if (result == 0 || result >= valueBuf.size())
+    {
+        return std::string();
+    }
+    return std::string(valueBuf.data());
+}
+
+unsigned int GetCurrentProcessID()
+{
+    return static_cast<unsigned int>(GetCurrentProcessId());
+}
+
 }  // namespace angle
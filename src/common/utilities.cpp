@@ -10,6 +10,8 @@
 #include "common/mathutil.h"
 #include "common/platform.h"
 
+#include <algorithm>
+#include <limits>
 #include <set>
 
 #if defined(ANGLE_ENABLE_WINDOWS_STORE)
@@ -45,6 +47,7 @@ gl::IndexRange ComputeTypedIndexRange(const IndexType *indices,
                 minIndex = indices[i];
                 maxIndex = indices[i];
                 nonPrimitiveRestartIndices++;
+                i++;
                 break;
             }
         }
@@ -89,6 +92,147 @@ gl::IndexRange ComputeTypedIndexRange(const IndexType *indices,
                           nonPrimitiveRestartIndices);
 }
 
+#if defined(ANGLE_USE_SSE)
+
+// SSE2 only has unsigned min and max for bytes, wider indices are biased into the signed range.
+// Restart indices are all ones, which is the largest value of each type in either range.
+struct UnsignedByteSSE2
+{
+    using IndexType = GLubyte;
+
+    static __m128i Bias(__m128i value) { return value; }
+    static __m128i Min(__m128i a, __m128i b) { return _mm_min_epu8(a, b); }
+    static __m128i Max(__m128i a, __m128i b) { return _mm_max_epu8(a, b); }
+    static __m128i CompareEqual(__m128i a, __m128i b) { return _mm_cmpeq_epi8(a, b); }
+};
+
+struct UnsignedShortSSE2
+{
+    using IndexType = GLushort;
+
+    static __m128i Bias(__m128i value) { return _mm_xor_si128(value, _mm_set1_epi16(-0x8000)); }
+    static __m128i Min(__m128i a, __m128i b) { return _mm_min_epi16(a, b); }
+    static __m128i Max(__m128i a, __m128i b) { return _mm_max_epi16(a, b); }
+    static __m128i CompareEqual(__m128i a, __m128i b) { return _mm_cmpeq_epi16(a, b); }
+};
+
+struct UnsignedIntSSE2
+{
+    using IndexType = GLuint;
+
+    static __m128i Bias(__m128i value)
+    {
+        return _mm_xor_si128(value, _mm_set1_epi32(std::numeric_limits<int32_t>::min()));
+    }
+    static __m128i Min(__m128i a, __m128i b)
+    {
+        __m128i aGreater = _mm_cmpgt_epi32(a, b);
+        return _mm_or_si128(_mm_and_si128(aGreater, b), _mm_andnot_si128(aGreater, a));
+    }
+    static __m128i Max(__m128i a, __m128i b)
+    {
+        __m128i aGreater = _mm_cmpgt_epi32(a, b);
+        return _mm_or_si128(_mm_and_si128(aGreater, a), _mm_andnot_si128(aGreater, b));
+    }
+    static __m128i CompareEqual(__m128i a, __m128i b) { return _mm_cmpeq_epi32(a, b); }
+};
+
+size_t SumBytes(__m128i bytes)
+{
+    __m128i sums = _mm_sad_epu8(bytes, _mm_setzero_si128());
+    return static_cast<size_t>(_mm_cvtsi128_si32(sums) + _mm_extract_epi16(sums, 4));
+}
+
+template <class Ops>
+gl::IndexRange ComputeTypedIndexRangeSSE2(const typename Ops::IndexType *indices,
+                                          size_t count,
+                                          bool primitiveRestartEnabled)
+{
+    using IndexType                  = typename Ops::IndexType;
+    constexpr size_t kIndicesPerLoad = sizeof(__m128i) / sizeof(IndexType);
+
+    ASSERT(count >= kIndicesPerLoad);
+
+    const __m128i allOnes = _mm_set1_epi32(-1);
+    __m128i minValues     = Ops::Bias(allOnes);
+    __m128i maxValues     = Ops::Bias(_mm_setzero_si128());
+
+    // Restart indices are counted per byte of their mask, and the byte counters are summed up
+    // before they can overflow.
+    __m128i restartByteCounts = _mm_setzero_si128();
+    size_t restartBytes       = 0;
+    unsigned int loadsCounted = 0;
+
+    size_t i = 0;
+    for (; i + kIndicesPerLoad <= count; i += kIndicesPerLoad)
+    {
+        __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(indices + i));
+
+        // Restart indices can't lower the minimum, but are zeroed so that they don't raise the
+        // maximum either.
+        __m128i maxCandidates = values;
+        if (primitiveRestartEnabled)
+        {
+            __m128i restartMask = Ops::CompareEqual(values, allOnes);
+            maxCandidates       = _mm_andnot_si128(restartMask, values);
+            restartByteCounts   = _mm_sub_epi8(restartByteCounts, restartMask);
+
+            if (++loadsCounted == std::numeric_limits<uint8_t>::max())
+            {
+                restartBytes += SumBytes(restartByteCounts);
+                restartByteCounts = _mm_setzero_si128();
+                loadsCounted      = 0;
+            }
+        }
+
+        minValues = Ops::Min(minValues, Ops::Bias(values));
+        maxValues = Ops::Max(maxValues, Ops::Bias(maxCandidates));
+    }
+
+    restartBytes += SumBytes(restartByteCounts);
+    size_t restartIndices = restartBytes / sizeof(IndexType);
+
+    IndexType minLanes[kIndicesPerLoad];
+    IndexType maxLanes[kIndicesPerLoad];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(minLanes), Ops::Bias(minValues));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(maxLanes), Ops::Bias(maxValues));
+
+    IndexType minIndex = minLanes[0];
+    IndexType maxIndex = maxLanes[0];
+    for (size_t lane = 1; lane < kIndicesPerLoad; lane++)
+    {
+        minIndex = std::min(minIndex, minLanes[lane]);
+        maxIndex = std::max(maxIndex, maxLanes[lane]);
+    }
+
+    const IndexType restartIndex = std::numeric_limits<IndexType>::max();
+    for (; i < count; i++)
+    {
+        if (primitiveRestartEnabled && indices[i] == restartIndex)
+        {
+            restartIndices++;
+            continue;
+        }
+        minIndex = std::min(minIndex, indices[i]);
+        maxIndex = std::max(maxIndex, indices[i]);
+    }
+
+    // Match the scalar path when every index is a restart index.
+    if (restartIndices == count)
+    {
+        return gl::IndexRange();
+    }
+
+    return gl::IndexRange(static_cast<size_t>(minIndex), static_cast<size_t>(maxIndex),
+                          count - restartIndices);
+}
+
+// Below this many indices the setup and the final reduction of the SIMD path cost more than they
+// save.
+constexpr size_t kMinIndexCountForSIMD = 64;
+
+#endif  // defined(ANGLE_USE_SSE)
+
 }  // anonymous namespace
 
 namespace gl
@@ -561,6 +705,35 @@ IndexRange ComputeIndexRange(GLenum indexType,
                              const GLvoid *indices,
                              size_t count,
                              bool primitiveRestartEnabled)
+{
+#if defined(ANGLE_USE_SSE)
+    if (count >= kMinIndexCountForSIMD && supportsSSE2())
+    {
+        switch (indexType)
+        {
+            case GL_UNSIGNED_BYTE:
+                return ComputeTypedIndexRangeSSE2<UnsignedByteSSE2>(
+                    static_cast<const GLubyte *>(indices), count, primitiveRestartEnabled);
+            case GL_UNSIGNED_SHORT:
+                return ComputeTypedIndexRangeSSE2<UnsignedShortSSE2>(
+                    static_cast<const GLushort *>(indices), count, primitiveRestartEnabled);
+            case GL_UNSIGNED_INT:
+                return ComputeTypedIndexRangeSSE2<UnsignedIntSSE2>(
+                    static_cast<const GLuint *>(indices), count, primitiveRestartEnabled);
+            default:
+                UNREACHABLE();
+                return IndexRange();
+        }
+    }
+#endif  // defined(ANGLE_USE_SSE)
+
+    return ComputeIndexRangeScalar(indexType, indices, count, primitiveRestartEnabled);
+}
+
+IndexRange ComputeIndexRangeScalar(GLenum indexType,
+                                   const GLvoid *indices,
+                                   size_t count,
+                                   bool primitiveRestartEnabled)
 {
     switch (indexType)
     {
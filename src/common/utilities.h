@@ -60,6 +60,12 @@ IndexRange ComputeIndexRange(GLenum indexType,
                              size_t count,
                              bool primitiveRestartEnabled);
 
+// Same as ComputeIndexRange, but never uses SIMD instructions.
+IndexRange ComputeIndexRangeScalar(GLenum indexType,
+                                   const GLvoid *indices,
+                                   size_t count,
+                                   bool primitiveRestartEnabled);
+
 // Get the primitive restart index value for the given index type.
 GLuint GetPrimitiveRestartIndex(GLenum indexType);
 
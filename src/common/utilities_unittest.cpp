@@ -5,6 +5,11 @@
 
 // utilities_unittest.cpp: Unit tests for ANGLE's GL utility functions
 
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -52,4 +57,113 @@ TEST(ParseResourceName, TrailingWhitespace)
     EXPECT_EQ(GL_INVALID_INDEX, index);
 }
 
+template <typename IndexType>
+void CheckIndexRanges(GLenum indexType)
+{
+    const IndexType restartIndex = std::numeric_limits<IndexType>::max();
+
+    std::mt19937 generator(13);
+    std::vector<IndexType> indices(5000 + 16);
+
+    // Cover every alignment of the first index, counts around the SIMD thresholds, counts large
+    // enough to overflow per-byte counters, and ranges whose extremes are in the leftover indices
+    // at the end.
+    for (size_t offset = 0; offset < 16; ++offset)
+    {
+        for (size_t count : {1u, 15u, 16u, 17u, 63u, 64u, 65u, 100u, 257u, 1024u, 5000u})
+        {
+            for (int pattern = 0; pattern < 4; ++pattern)
+            {
+                for (IndexType &index : indices)
+                {
+                    index = static_cast<IndexType>(50 + generator() % 100);
+                }
+
+                IndexType *first = indices.data() + offset;
+                if (pattern == 1)
+                {
+                    // Extremes at the last index, and restart indices that are counted when
+                    // primitive restart is disabled.
+                    first[count / 2] = restartIndex;
+                    first[count - 1] = 1;
+                }
+                else if (pattern == 2)
+                {
+                    for (size_t i = 0; i < count; i += 3)
+                    {
+                        first[i] = restartIndex;
+                    }
+                }
+                else if (pattern == 3)
+                {
+                    std::fill(first, first + count, restartIndex);
+                }
+
+                for (bool primitiveRestart : {false, true})
+                {
+                    gl::IndexRange expected =
+                        gl::ComputeIndexRangeScalar(indexType, first, count, primitiveRestart);
+                    gl::IndexRange actual =
+                        gl::ComputeIndexRange(indexType, first, count, primitiveRestart);
+
+                    EXPECT_EQ(expected.start, actual.start)
+                        << "offset " << offset << " count " << count << " pattern " << pattern;
+                    EXPECT_EQ(expected.end, actual.end)
+                        << "offset " << offset << " count " << count << " pattern " << pattern;
+                    EXPECT_EQ(expected.vertexIndexCount, actual.vertexIndexCount)
+                        << "offset " << offset << " count " << count << " pattern " << pattern;
+                }
+            }
+        }
+    }
+}
+
+// Test that the index range of unsigned bytes matches the scalar computation.
+TEST(ComputeIndexRange, UnsignedByte)
+{
+    CheckIndexRanges<GLubyte>(GL_UNSIGNED_BYTE);
+}
+
+// Test that the index range of unsigned shorts matches the scalar computation.
+TEST(ComputeIndexRange, UnsignedShort)
+{
+    CheckIndexRanges<GLushort>(GL_UNSIGNED_SHORT);
+}
+
+// Test that the index range of unsigned ints matches the scalar computation.
+TEST(ComputeIndexRange, UnsignedInt)
+{
+    CheckIndexRanges<GLuint>(GL_UNSIGNED_INT);
+}
+
+// Test a few index ranges with known results.
+TEST(ComputeIndexRange, KnownRanges)
+{
+    std::vector<GLushort> indices(200, 7);
+    indices[3]   = 0xFFFF;
+    indices[150] = 2;
+    indices[199] = 0xFFFE;
+
+    gl::IndexRange range = gl::ComputeIndexRange(GL_UNSIGNED_SHORT, indices.data(), 200, false);
+    EXPECT_EQ(2u, range.start);
+    EXPECT_EQ(0xFFFFu, range.end);
+    EXPECT_EQ(200u, range.vertexIndexCount);
+
+    range = gl::ComputeIndexRange(GL_UNSIGNED_SHORT, indices.data(), 200, true);
+    EXPECT_EQ(2u, range.start);
+    EXPECT_EQ(0xFFFEu, range.end);
+    EXPECT_EQ(199u, range.vertexIndexCount);
+
+    range = gl::ComputeIndexRange(GL_UNSIGNED_SHORT, indices.data(), 4, true);
+    EXPECT_EQ(7u, range.start);
+    EXPECT_EQ(7u, range.end);
+    EXPECT_EQ(3u, range.vertexIndexCount);
+
+    std::vector<GLuint> restartIndices(100, 0xFFFFFFFFu);
+    range = gl::ComputeIndexRange(GL_UNSIGNED_INT, restartIndices.data(), 100, true);
+    EXPECT_EQ(0u, range.start);
+    EXPECT_EQ(0u, range.end);
+    EXPECT_EQ(0u, range.vertexIndexCount);
+}
+
 }
@@ -84,10 +84,21 @@ MacroExpander::MacroExpander(Lexer *lexer,
                              MacroSet *macroSet,
                              Diagnostics *diagnostics,
                              int allowedMacroExpansionDepth)
+    : MacroExpander(lexer, macroSet, diagnostics, allowedMacroExpansionDepth, &mOwnTokenArena)
+{
+}
+
+MacroExpander::MacroExpander(Lexer *lexer,
+                             MacroSet *macroSet,
+                             Diagnostics *diagnostics,
+                             int allowedMacroExpansionDepth,
+                             std::vector<Token> *tokenArena)
     : mLexer(lexer),
       mMacroSet(macroSet),
       mDiagnostics(diagnostics),
-      mTotalTokensInContexts(0),
+      mHasReserveToken(false),
+      mTokenArena(tokenArena),
+      mTokenArenaBase(tokenArena->size()),
       mAllowedMacroExpansionDepth(allowedMacroExpansionDepth),
       mDeferReenablingMacros(false)
 {
@@ -96,10 +107,7 @@ MacroExpander::MacroExpander(Lexer *lexer,
 MacroExpander::~MacroExpander()
 {
     ASSERT(mMacrosToReenable.empty());
-    for (MacroContext *context : mContextStack)
-    {
-        delete context;
-    }
+    mTokenArena->resize(mTokenArenaBase);
 }
 
 void MacroExpander::lex(Token *token)
@@ -143,26 +151,26 @@ void MacroExpander::lex(Token *token)
 
 void MacroExpander::getToken(Token *token)
 {
-    if (mReserveToken.get())
+    if (mHasReserveToken)
     {
-        *token = *mReserveToken;
-        mReserveToken.reset();
+        *token           = mReserveToken;
+        mHasReserveToken = false;
         return;
     }
 
     // First pop all empty macro contexts.
-    while (!mContextStack.empty() && mContextStack.back()->empty())
+    while (!mContextStack.empty() && mContextStack.back().empty())
     {
         popMacro();
     }
 
     if (!mContextStack.empty())
     {
-        *token = mContextStack.back()->get();
+        *token = (*mTokenArena)[mContextStack.back().index++];
     }
     else
     {
-        ASSERT(mTotalTokensInContexts == 0);
+        ASSERT(totalTokensInContexts() == 0);
         mLexer->lex(token);
     }
 }
@@ -171,14 +179,16 @@ void MacroExpander::ungetToken(const Token &token)
 {
     if (!mContextStack.empty())
     {
-        MacroContext *context = mContextStack.back();
-        context->unget();
-        ASSERT(context->replacements[context->index] == token);
+        MacroContext &context = mContextStack.back();
+        ASSERT(context.index > context.begin);
+        --context.index;
+        ASSERT((*mTokenArena)[context.index] == token);
     }
     else
     {
-        ASSERT(!mReserveToken.get());
-        mReserveToken.reset(new Token(token));
+        ASSERT(!mHasReserveToken);
+        mReserveToken    = token;
+        mHasReserveToken = true;
     }
 }
 
@@ -200,18 +210,14 @@ bool MacroExpander::pushMacro(std::shared_ptr<Macro> macro, const Token &identif
     ASSERT(identifier.type == Token::IDENTIFIER);
     ASSERT(identifier.text == macro->name);
 
-    std::vector<Token> replacements;
-    if (!expandMacro(*macro, identifier, &replacements))
+    size_t begin = 0;
+    if (!expandMacro(*macro, identifier, &begin))
         return false;
 
     // Macro is disabled for expansion until it is popped off the stack.
     macro->disabled = true;
 
-    MacroContext *context = new MacroContext;
-    context->macro        = macro;
-    context->replacements.swap(replacements);
-    mContextStack.push_back(context);
-    mTotalTokensInContexts += context->replacements.size();
+    mContextStack.emplace_back(macro, begin, mTokenArena->size());
     return true;
 }
 
@@ -219,31 +225,27 @@ void MacroExpander::popMacro()
 {
     ASSERT(!mContextStack.empty());
 
-    MacroContext *context = mContextStack.back();
-    mContextStack.pop_back();
+    const MacroContext &context = mContextStack.back();
 
-    ASSERT(context->empty());
-    ASSERT(context->macro->disabled);
-    ASSERT(context->macro->expansionCount > 0);
+    ASSERT(context.empty());
+    ASSERT(context.end == mTokenArena->size());
+    ASSERT(context.macro->disabled);
+    ASSERT(context.macro->expansionCount > 0);
     if (mDeferReenablingMacros)
     {
-        mMacrosToReenable.push_back(context->macro);
+        mMacrosToReenable.push_back(context.macro);
     }
     else
     {
-        context->macro->disabled = false;
+        context.macro->disabled = false;
     }
-    context->macro->expansionCount--;
-    mTotalTokensInContexts -= context->replacements.size();
-    delete context;
+    context.macro->expansionCount--;
+    mTokenArena->resize(context.begin);
+    mContextStack.pop_back();
 }
 
-bool MacroExpander::expandMacro(const Macro &macro,
-                                const Token &identifier,
-                                std::vector<Token> *replacements)
+bool MacroExpander::expandMacro(const Macro &macro, const Token &identifier, size_t *beginOut)
 {
-    replacements->clear();
-
     // In the case of an object-like macro, the replacement list gets its location
     // from the identifier, but in the case of a function-like macro, the replacement
     // list gets its location from the closing parenthesis of the macro invocation.
@@ -251,15 +253,17 @@ bool MacroExpander::expandMacro(const Macro &macro,
     SourceLocation replacementLocation = identifier.location;
     if (macro.type == Macro::kTypeObj)
     {
-        replacements->assign(macro.replacements.begin(), macro.replacements.end());
+        *beginOut = mTokenArena->size();
+        mTokenArena->insert(mTokenArena->end(), macro.replacements.begin(),
+                            macro.replacements.end());
 
         if (macro.predefined)
         {
             const char kLine[] = "__LINE__";
             const char kFile[] = "__FILE__";
 
-            ASSERT(replacements->size() == 1);
-            Token &repl = replacements->front();
+            ASSERT(mTokenArena->size() == *beginOut + 1);
+            Token &repl = mTokenArena->back();
             if (macro.name == kLine)
             {
                 repl.text = ToString(identifier.location.line);
@@ -278,13 +282,16 @@ bool MacroExpander::expandMacro(const Macro &macro,
         if (!collectMacroArgs(macro, identifier, &args, &replacementLocation))
             return false;
 
-        replaceMacroParams(macro, args, replacements);
+        // Collecting the arguments may have popped macros off the stack, so the replacement list
+        // starts at the end of what's left of the arena.
+        *beginOut = mTokenArena->size();
+        replaceMacroParams(macro, args);
     }
 
-    for (std::size_t i = 0; i < replacements->size(); ++i)
+    for (size_t i = *beginOut; i < mTokenArena->size(); ++i)
     {
-        Token &repl = replacements->at(i);
-        if (i == 0)
+        Token &repl = (*mTokenArena)[i];
+        if (i == *beginOut)
         {
             // The first token in the replacement list inherits the padding
             // properties of the identifier token.
@@ -379,7 +386,8 @@ bool MacroExpander::collectMacroArgs(const Macro &macro,
     // Pre-expand each argument before substitution.
     // This step expands each argument individually before they are
     // inserted into the macro body.
-    size_t numTokens = 0;
+    size_t numTokens              = 0;
+    const size_t tokensInContexts = totalTokensInContexts();
     for (auto &arg : *args)
     {
         TokenLexer lexer(&arg);
@@ -389,7 +397,8 @@ bool MacroExpander::collectMacroArgs(const Macro &macro,
                                  token.text);
             return false;
         }
-        MacroExpander expander(&lexer, mMacroSet, mDiagnostics, mAllowedMacroExpansionDepth - 1);
+        MacroExpander expander(&lexer, mMacroSet, mDiagnostics, mAllowedMacroExpansionDepth - 1,
+                               mTokenArena);
 
         arg.clear();
         expander.lex(&token);
@@ -398,7 +407,7 @@ bool MacroExpander::collectMacroArgs(const Macro &macro,
             arg.push_back(token);
             expander.lex(&token);
             numTokens++;
-            if (numTokens + mTotalTokensInContexts > kMaxContextTokens)
+            if (numTokens + tokensInContexts > kMaxContextTokens)
             {
                 mDiagnostics->report(Diagnostics::PP_OUT_OF_MEMORY, token.location, token.text);
                 return false;
@@ -408,16 +417,15 @@ bool MacroExpander::collectMacroArgs(const Macro &macro,
     return true;
 }
 
-void MacroExpander::replaceMacroParams(const Macro &macro,
-                                       const std::vector<MacroArg> &args,
-                                       std::vector<Token> *replacements)
+void MacroExpander::replaceMacroParams(const Macro &macro, const std::vector<MacroArg> &args)
 {
+    // The replacement list is appended to the arena, so it counts towards the total as it grows.
+    const size_t begin = mTokenArena->size();
     for (std::size_t i = 0; i < macro.replacements.size(); ++i)
     {
-        if (!replacements->empty() &&
-            replacements->size() + mTotalTokensInContexts > kMaxContextTokens)
+        if (mTokenArena->size() > begin && totalTokensInContexts() > kMaxContextTokens)
         {
-            const Token &token = replacements->back();
+            const Token &token = mTokenArena->back();
             mDiagnostics->report(Diagnostics::PP_OUT_OF_MEMORY, token.location, token.text);
             return;
         }
@@ -425,7 +433,7 @@ void MacroExpander::replaceMacroParams(const Macro &macro,
         const Token &repl = macro.replacements[i];
         if (repl.type != Token::IDENTIFIER)
         {
-            replacements->push_back(repl);
+            mTokenArena->push_back(repl);
             continue;
         }
 
@@ -436,7 +444,7 @@ void MacroExpander::replaceMacroParams(const Macro &macro,
             std::find(macro.parameters.begin(), macro.parameters.end(), repl.text);
         if (iter == macro.parameters.end())
         {
-            replacements->push_back(repl);
+            mTokenArena->push_back(repl);
             continue;
         }
 
@@ -446,32 +454,22 @@ void MacroExpander::replaceMacroParams(const Macro &macro,
         {
             continue;
         }
-        std::size_t iRepl = replacements->size();
-        replacements->insert(replacements->end(), arg.begin(), arg.end());
+        std::size_t iRepl = mTokenArena->size();
+        mTokenArena->insert(mTokenArena->end(), arg.begin(), arg.end());
         // The replacement token inherits padding properties from
         // macro replacement token.
-        replacements->at(iRepl).setHasLeadingSpace(repl.hasLeadingSpace());
+        (*mTokenArena)[iRepl].setHasLeadingSpace(repl.hasLeadingSpace());
     }
 }
 
-MacroExpander::MacroContext::MacroContext() : macro(0), index(0)
+MacroExpander::MacroContext::MacroContext(std::shared_ptr<Macro> macro, size_t begin, size_t end)
+    : macro(macro), begin(begin), index(begin), end(end)
 {
 }
 
 bool MacroExpander::MacroContext::empty() const
 {
-    return index == replacements.size();
-}
-
-const Token &MacroExpander::MacroContext::get()
-{
-    return replacements[index++];
-}
-
-void MacroExpander::MacroContext::unget()
-{
-    ASSERT(index > 0);
-    --index;
+    return index == end;
 }
 
 }  // namespace pp
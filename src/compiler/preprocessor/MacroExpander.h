@@ -12,6 +12,7 @@
 
 #include "compiler/preprocessor/Lexer.h"
 #include "compiler/preprocessor/Macro.h"
+#include "compiler/preprocessor/Token.h"
 
 namespace pp
 {
@@ -30,44 +31,62 @@ class MacroExpander : public Lexer
 
     void lex(Token *token) override;
 
+    // Puts back a token so that it is the next one to be read. Also used by the preprocessor to
+    // hand over a token it lexed without going through the expander.
+    void ungetToken(const Token &token);
+
   private:
+    // Expanders of macro arguments share the token arena of the expander they were created by.
+    MacroExpander(Lexer *lexer,
+                  MacroSet *macroSet,
+                  Diagnostics *diagnostics,
+                  int allowedMacroExpansionDepth,
+                  std::vector<Token> *tokenArena);
+
+    size_t totalTokensInContexts() const { return mTokenArena->size() - mTokenArenaBase; }
+
     void getToken(Token *token);
-    void ungetToken(const Token &token);
     bool isNextTokenLeftParen();
 
     bool pushMacro(std::shared_ptr<Macro> macro, const Token &identifier);
     void popMacro();
 
-    bool expandMacro(const Macro &macro, const Token &identifier, std::vector<Token> *replacements);
+    // Appends the replacement list of the macro to the token arena, starting at |beginOut|.
+    bool expandMacro(const Macro &macro, const Token &identifier, size_t *beginOut);
 
     typedef std::vector<Token> MacroArg;
     bool collectMacroArgs(const Macro &macro,
                           const Token &identifier,
                           std::vector<MacroArg> *args,
                           SourceLocation *closingParenthesisLocation);
-    void replaceMacroParams(const Macro &macro,
-                            const std::vector<MacroArg> &args,
-                            std::vector<Token> *replacements);
+    void replaceMacroParams(const Macro &macro, const std::vector<MacroArg> &args);
 
+    // The replacement list of a macro being expanded, as a range of the token arena.
     struct MacroContext
     {
-        MacroContext();
+        MacroContext(std::shared_ptr<Macro> macro, size_t begin, size_t end);
         bool empty() const;
-        const Token &get();
-        void unget();
 
         std::shared_ptr<Macro> macro;
-        std::size_t index;
-        std::vector<Token> replacements;
+        size_t begin;
+        size_t index;
+        size_t end;
     };
 
     Lexer *mLexer;
     MacroSet *mMacroSet;
     Diagnostics *mDiagnostics;
 
-    std::unique_ptr<Token> mReserveToken;
-    std::vector<MacroContext *> mContextStack;
-    size_t mTotalTokensInContexts;
+    bool mHasReserveToken;
+    Token mReserveToken;
+
+    // Replacement lists of the macros on the context stack, stacked in the same order. The arena
+    // only grows to the deepest nesting of expansions, after which expanding a macro doesn't
+    // allocate.
+    std::vector<Token> mOwnTokenArena;
+    std::vector<Token> *mTokenArena;
+    size_t mTokenArenaBase;
+    std::vector<MacroContext> mContextStack;
 
     int mAllowedMacroExpansionDepth;
 
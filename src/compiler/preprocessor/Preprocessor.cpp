@@ -6,6 +6,8 @@
 
 #include "compiler/preprocessor/Preprocessor.h"
 
+#include <string.h>
+
 #include "common/debug.h"
 #include "compiler/preprocessor/DiagnosticsBase.h"
 #include "compiler/preprocessor/DirectiveParser.h"
@@ -17,6 +19,26 @@
 namespace pp
 {
 
+namespace
+{
+
+bool HasDirectives(size_t count, const char *const string[], const int length[])
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        int len          = length ? length[i] : -1;
+        const char *hash = len < 0 ? strchr(string[i], '#')
+                                   : static_cast<const char *>(memchr(string[i], '#', len));
+        if (hash != nullptr)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // anonymous namespace
+
 struct PreprocessorImpl
 {
     Diagnostics *diagnostics;
@@ -25,6 +47,10 @@ struct PreprocessorImpl
     DirectiveParser directiveParser;
     MacroExpander macroExpander;
 
+    // Set while the source has no directives and hasn't used any macro. Tokens then go straight
+    // from the tokenizer to the compiler, skipping the directive parser and the macro expander.
+    bool directiveFree;
+
     PreprocessorImpl(Diagnostics *diag,
                      DirectiveHandler *directiveHandler,
                      const PreprocessorSettings &settings)
@@ -35,9 +61,34 @@ struct PreprocessorImpl
                           diag,
                           directiveHandler,
                           settings.maxMacroExpansionDepth),
-          macroExpander(&directiveParser, &macroSet, diag, settings.maxMacroExpansionDepth)
+          macroExpander(&directiveParser, &macroSet, diag, settings.maxMacroExpansionDepth),
+          directiveFree(false)
     {
     }
+
+    void lex(Token *token)
+    {
+        if (!directiveFree)
+        {
+            macroExpander.lex(token);
+            return;
+        }
+
+        // Without directives, all the directive parser would do is drop the newlines.
+        do
+        {
+            tokenizer.lex(token);
+        } while (token->type == '\n');
+
+        // Only the predefined macros can be used, but they still need to be expanded. Hand the
+        // rest of the source over to the full path from the first one on.
+        if (token->type == Token::IDENTIFIER && macroSet.find(token->text) != macroSet.end())
+        {
+            directiveFree = false;
+            macroExpander.ungetToken(*token);
+            macroExpander.lex(token);
+        }
+    }
 };
 
 Preprocessor::Preprocessor(Diagnostics *diagnostics,
@@ -62,7 +113,13 @@ bool Preprocessor::init(size_t count, const char *const string[], const int leng
     predefineMacro("__VERSION__", kDefaultGLSLVersion);
     predefineMacro("GL_ES", 1);
 
-    return mImpl->tokenizer.init(count, string, length);
+    if (!mImpl->tokenizer.init(count, string, length))
+    {
+        return false;
+    }
+
+    mImpl->directiveFree = !HasDirectives(count, string, length);
+    return true;
 }
 
 void Preprocessor::predefineMacro(const char *name, int value)
@@ -75,7 +132,7 @@ void Preprocessor::lex(Token *token)
     bool validToken = false;
     while (!validToken)
     {
-        mImpl->macroExpander.lex(token);
+        mImpl->lex(token);
         switch (token->type)
         {
             // We should not be returning internal preprocessing tokens.
@@ -7,6 +7,7 @@
 #include "compiler/translator/AddAndTrueToLoopCondition.h"
 
 #include "compiler/translator/IntermNode.h"
+#include "compiler/translator/PassManager.h"
 
 namespace sh
 {
@@ -16,10 +17,10 @@ namespace
 
 // An AST traverser that rewrites for and while loops by replacing "condition" with
 // "condition && true" to work around condition bug on Intel Mac.
-class AddAndTrueToLoopConditionTraverser : public TIntermTraverser
+class AddAndTrueToLoopConditionTraverser : public TTraversalPass
 {
   public:
-    AddAndTrueToLoopConditionTraverser() : TIntermTraverser(true, false, false) {}
+    AddAndTrueToLoopConditionTraverser() : TTraversalPass(TreeEdits::DURING_TRAVERSAL) {}
 
     bool visitLoop(Visit, TIntermLoop *loop) override
     {
@@ -50,10 +51,15 @@ class AddAndTrueToLoopConditionTraverser : public TIntermTraverser
 
 }  // anonymous namespace
 
-void AddAndTrueToLoopCondition(TIntermNode *root)
+void AddAndTrueToLoopCondition(TIntermBlock *root)
 {
     AddAndTrueToLoopConditionTraverser traverser;
-    root->traverse(&traverser);
+    traverser.run(root);
+}
+
+std::unique_ptr<TTraversalPass> CreateAddAndTrueToLoopConditionPass()
+{
+    return std::unique_ptr<TTraversalPass>(new AddAndTrueToLoopConditionTraverser());
 }
 
 }  // namespace sh
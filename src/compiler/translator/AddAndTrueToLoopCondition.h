@@ -9,11 +9,15 @@
 #ifndef COMPILER_TRANSLATOR_ADDANDTRUETOLOOPCONDITION_H_
 #define COMPILER_TRANSLATOR_ADDANDTRUETOLOOPCONDITION_H_
 
-class TIntermNode;
+#include <memory>
+
 namespace sh
 {
+class TIntermBlock;
+class TTraversalPass;
 
-void AddAndTrueToLoopCondition(TIntermNode *root);
+void AddAndTrueToLoopCondition(TIntermBlock *root);
+std::unique_ptr<TTraversalPass> CreateAddAndTrueToLoopConditionPass();
 
 }  // namespace sh
 
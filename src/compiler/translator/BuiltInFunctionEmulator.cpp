@@ -6,17 +6,18 @@
 
 #include "angle_gl.h"
 #include "compiler/translator/BuiltInFunctionEmulator.h"
-#include "compiler/translator/SymbolTable.h"
 #include "compiler/translator/Cache.h"
+#include "compiler/translator/PassManager.h"
+#include "compiler/translator/SymbolTable.h"
 
 namespace sh
 {
 
-class BuiltInFunctionEmulator::BuiltInFunctionEmulationMarker : public TIntermTraverser
+class BuiltInFunctionEmulator::BuiltInFunctionEmulationMarker : public TTraversalPass
 {
   public:
     BuiltInFunctionEmulationMarker(BuiltInFunctionEmulator &emulator)
-        : TIntermTraverser(true, false, false), mEmulator(emulator)
+        : TTraversalPass(TreeEdits::DURING_TRAVERSAL), mEmulator(emulator)
     {
     }
 
@@ -245,6 +246,12 @@ void BuiltInFunctionEmulator::markBuiltInFunctionsForEmulation(TIntermNode *root
     root->traverse(&marker);
 }
 
+std::unique_ptr<TTraversalPass> BuiltInFunctionEmulator::createMarkingPass()
+{
+    ASSERT(hasEmulatedFunctions());
+    return std::unique_ptr<TTraversalPass>(new BuiltInFunctionEmulationMarker(*this));
+}
+
 void BuiltInFunctionEmulator::cleanup()
 {
     mFunctions.clear();
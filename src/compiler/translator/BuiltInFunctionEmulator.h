@@ -7,12 +7,16 @@
 #ifndef COMPILER_TRANSLATOR_BUILTINFUNCTIONEMULATOR_H_
 #define COMPILER_TRANSLATOR_BUILTINFUNCTIONEMULATOR_H_
 
+#include <memory>
+
 #include "compiler/translator/InfoSink.h"
 #include "compiler/translator/IntermNode.h"
 
 namespace sh
 {
 
+class TTraversalPass;
+
 //
 // This class decides which built-in functions need to be replaced with the emulated ones. It can be
 // used to work around driver bugs or implement functions that are not natively implemented on a
@@ -25,6 +29,11 @@ class BuiltInFunctionEmulator
 
     void markBuiltInFunctionsForEmulation(TIntermNode *root);
 
+    // Does the same marking as a pass that can share a traversal with other passes. Only needed
+    // if hasEmulatedFunctions() returns true.
+    bool hasEmulatedFunctions() const { return !mEmulatedFunctions.empty(); }
+    std::unique_ptr<TTraversalPass> createMarkingPass();
+
     void cleanup();
 
     // "name" gets written as "webgl_name_emu".
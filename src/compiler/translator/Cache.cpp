@@ -11,6 +11,8 @@
 #include "common/angleutils.h"
 #include "common/debug.h"
 #include "compiler/translator/Cache.h"
+#include "compiler/translator/Initialize.h"
+#include "compiler/translator/SymbolTable.h"
 
 namespace sh
 {
@@ -57,6 +59,16 @@ TCache::TypeKey::TypeKey(TBasicType basicType,
 
 TCache *TCache::sCache = nullptr;
 
+constexpr size_t TCache::kTypeShardCount;
+
+TCache::TCache()
+{
+}
+
+TCache::~TCache()
+{
+}
+
 void TCache::initialize()
 {
     if (sCache == nullptr)
@@ -70,6 +82,13 @@ void TCache::destroy()
     SafeDelete(sCache);
 }
 
+TCache::TypeShard &TCache::getTypeShard(const TypeKey &key)
+{
+    // Fibonacci hashing spreads the few bits that differ between keys over the shard index.
+    uint64_t hash = key.value * UINT64_C(0x9E3779B97F4A7C15);
+    return sCache->mTypeShards[static_cast<size_t>(hash >> 60) % kTypeShardCount];
+}
+
 const TType *TCache::getType(TBasicType basicType,
                              TPrecision precision,
                              TQualifier qualifier,
@@ -77,19 +96,55 @@ const TType *TCache::getType(TBasicType basicType,
                              unsigned char secondarySize)
 {
     TypeKey key(basicType, precision, qualifier, primarySize, secondarySize);
-    auto it = sCache->mTypes.find(key);
-    if (it != sCache->mTypes.end())
+    TypeShard &shard = getTypeShard(key);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.types.find(key);
+    if (it != shard.types.end())
     {
         return it->second;
     }
 
-    TScopedAllocator scopedAllocator(&sCache->mAllocator);
+    TScopedAllocator scopedAllocator(&shard.allocator);
 
     TType *type = new TType(basicType, precision, qualifier, primarySize, secondarySize);
     type->realize();
-    sCache->mTypes.insert(std::make_pair(key, type));
+    shard.types.insert(std::make_pair(key, type));
 
     return type;
 }
 
+const TSymbolTable *TCache::getBuiltInSymbolTable(sh::GLenum shaderType,
+                                                  ShShaderSpec spec,
+                                                  const ShBuiltInResources &resources,
+                                                  const std::string &resourcesString)
+{
+    SymbolTableKey key(shaderType, spec, resourcesString);
+
+    std::lock_guard<std::mutex> lock(sCache->mBuiltInSymbolTablesMutex);
+    auto it = sCache->mBuiltInSymbolTables.find(key);
+    if (it != sCache->mBuiltInSymbolTables.end())
+    {
+        return it->second.get();
+    }
+
+    TScopedAllocator scopedAllocator(&sCache->mAllocator);
+
+    std::unique_ptr<TSymbolTable> symbolTable(new TSymbolTable());
+    symbolTable->push();  // COMMON_BUILTINS
+    symbolTable->push();  // ESSL1_BUILTINS
+    symbolTable->push();  // ESSL3_BUILTINS
+    symbolTable->push();  // ESSL3_1_BUILTINS
+
+    InsertBuiltInFunctions(shaderType, spec, resources, *symbolTable);
+    IdentifyBuiltIns(shaderType, spec, resources, *symbolTable);
+
+    // Nothing may be allocated from a compiler's pool on behalf of the shared symbols later on.
+    symbolTable->realizeBuiltIns();
+
+    const TSymbolTable *builtIns = symbolTable.get();
+    sCache->mBuiltInSymbolTables[key] = std::move(symbolTable);
+    return builtIns;
+}
+
 }  // namespace sh
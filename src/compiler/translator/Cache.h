@@ -11,17 +11,29 @@
 
 #include <stdint.h>
 #include <string.h>
+#include <array>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
 
+#include "GLSLANG/ShaderLang.h"
 #include "compiler/translator/Types.h"
 #include "compiler/translator/PoolAlloc.h"
 
 namespace sh
 {
 
+class TSymbolTable;
+
+// The cache is shared by all the compilers of the process and is safe to use from several threads
+// at once.
 class TCache
 {
   public:
+    ~TCache();
+
     static void initialize();
     static void destroy();
 
@@ -48,8 +60,16 @@ class TCache
                                 unsigned char primarySize,
                                 unsigned char secondarySize);
 
+    // Returns the built-in levels for a shader type, spec and set of resources, building them on
+    // first use. |resourcesString| must identify every resource the built-ins depend on. The
+    // returned table is only meant to be shared through TSymbolTable::pushSharedBuiltInLevels.
+    static const TSymbolTable *getBuiltInSymbolTable(sh::GLenum shaderType,
+                                                     ShShaderSpec spec,
+                                                     const ShBuiltInResources &resources,
+                                                     const std::string &resourcesString);
+
   private:
-    TCache() {}
+    TCache();
 
     union TypeKey {
         TypeKey(TBasicType basicType,
@@ -73,9 +93,30 @@ class TCache
     };
     typedef std::map<TypeKey, const TType *> TypeMap;
 
-    TypeMap mTypes;
+    // Types are looked up while parsing every shader, so they are split in shards by key, each
+    // with its own lock and pool, so that compilers on different threads rarely wait for each
+    // other.
+    struct TypeShard
+    {
+        std::mutex mutex;
+        TypeMap types;
+        TPoolAllocator allocator;
+    };
+    static constexpr size_t kTypeShardCount = 16;
+
+    static TypeShard &getTypeShard(const TypeKey &key);
+
+    std::array<TypeShard, kTypeShardCount> mTypeShards;
+
+    // Guards the built-in symbol tables. A table is built at most once, while holding the lock.
+    std::mutex mBuiltInSymbolTablesMutex;
     TPoolAllocator mAllocator;
 
+    // Declared after mAllocator, which owns the symbols, so that the tables are destroyed first.
+    typedef std::tuple<sh::GLenum, ShShaderSpec, std::string> SymbolTableKey;
+    typedef std::map<SymbolTableKey, std::unique_ptr<TSymbolTable>> SymbolTableMap;
+    SymbolTableMap mBuiltInSymbolTables;
+
     static TCache *sCache;
 };
 
@@ -19,6 +19,7 @@
 #include "compiler/translator/Initialize.h"
 #include "compiler/translator/InitializeVariables.h"
 #include "compiler/translator/ParseContext.h"
+#include "compiler/translator/PassManager.h"
 #include "compiler/translator/PruneEmptyDeclarations.h"
 #include "compiler/translator/RegenerateStructNames.h"
 #include "compiler/translator/RemoveInvariantDeclaration.h"
@@ -137,19 +138,27 @@ namespace
 class TScopedPoolAllocator
 {
   public:
-    TScopedPoolAllocator(TPoolAllocator *allocator) : mAllocator(allocator)
+    // The pool only grows until it is popped, so the memory it uses when the scope ends is the
+    // most it used in the scope. That is written to |peakBytesOut|.
+    TScopedPoolAllocator(TPoolAllocator *allocator, size_t *peakBytesOut)
+        : mAllocator(allocator),
+          mPeakBytesOut(peakBytesOut),
+          mBytesInUseBeforeScope(allocator->getBytesInUse())
     {
         mAllocator->push();
         SetGlobalPoolAllocator(mAllocator);
     }
     ~TScopedPoolAllocator()
     {
+        *mPeakBytesOut = mAllocator->getBytesInUse() - mBytesInUseBeforeScope;
         SetGlobalPoolAllocator(NULL);
         mAllocator->pop();
     }
 
   private:
     TPoolAllocator *mAllocator;
+    size_t *mPeakBytesOut;
+    size_t mBytesInUseBeforeScope;
 };
 
 class TScopedSymbolTableLevel
@@ -218,7 +227,8 @@ TCompiler::TCompiler(sh::GLenum type, ShShaderSpec spec, ShShaderOutput output)
       mDiagnostics(infoSink.info),
       mSourcePath(NULL),
       mComputeShaderLocalSizeDeclared(false),
-      mTemporaryIndex(0)
+      mTemporaryIndex(0),
+      mPeakPoolAllocatorBytes(0)
 {
     mComputeShaderLocalSize.fill(1);
 }
@@ -298,9 +308,13 @@ TIntermBlock *TCompiler::compileTreeImpl(const char *const shaderStrings[],
     TScopedSymbolTableLevel scopedSymbolLevel(&symbolTable);
 
     // Parse shader.
-    bool success = (PaParseStrings(numStrings - firstSource, &shaderStrings[firstSource], nullptr,
-                                   &parseContext) == 0) &&
-                   (parseContext.getTreeRoot() != nullptr);
+    bool success = false;
+    {
+        TScopedPassTimer timer("Parse", &mPassTimings);
+        success = (PaParseStrings(numStrings - firstSource, &shaderStrings[firstSource], nullptr,
+                                  &parseContext) == 0) &&
+                  (parseContext.getTreeRoot() != nullptr);
+    }
 
     shaderVersion = parseContext.getShaderVersion();
     if (success && MapSpecToShaderVersion(shaderSpec) < shaderVersion)
@@ -335,151 +349,239 @@ TIntermBlock *TCompiler::compileTreeImpl(const char *const shaderStrings[],
             success = false;
         }
 
-        // Disallow expressions deemed too complex.
-        if (success && (compileOptions & SH_LIMIT_EXPRESSION_COMPLEXITY))
-            success = limitExpressionComplexity(root);
-
-        // Create the function DAG and check there is no recursion
-        if (success)
-            success = initCallDag(root);
-
-        if (success && (compileOptions & SH_LIMIT_CALL_STACK_DEPTH))
-            success = checkCallDepth();
-
-        // Checks which functions are used and if "main" exists
         if (success)
         {
-            functionMetadata.clear();
-            functionMetadata.resize(mCallDag.size());
-            success = tagUsedFunctions();
+            TPassManager passManager(&mPassTimings,
+                                     (compileOptions & SH_DONT_SHARE_AST_TRAVERSALS) == 0);
+            addPasses(&passManager, compileOptions);
+            success = passManager.run(root);
         }
+    }
 
-        if (success && !(compileOptions & SH_DONT_PRUNE_UNUSED_FUNCTIONS))
-            success = pruneUnusedFunctions(root);
+    if (success)
+        return root;
 
-        // Prune empty declarations to work around driver bugs and to keep declaration output
-        // simple.
-        if (success)
-            PruneEmptyDeclarations(root);
+    return NULL;
+}
 
-        if (success && shaderVersion == 300 && shaderType == GL_FRAGMENT_SHADER)
-            success = validateOutputs(root);
+void TCompiler::addPasses(TPassManager *passManager, ShCompileOptions compileOptions)
+{
+    // Disallow expressions deemed too complex.
+    if (compileOptions & SH_LIMIT_EXPRESSION_COMPLEXITY)
+    {
+        passManager->addPass("LimitExpressionComplexity", {}, [this](TIntermBlock *root) {
+            return limitExpressionComplexity(root);
+        });
+    }
 
-        if (success && shouldRunLoopAndIndexingValidation(compileOptions))
-            success =
-                ValidateLimitations(root, shaderType, symbolTable, shaderVersion, &mDiagnostics);
+    // Create the function DAG and check there is no recursion
+    passManager->addPass("InitCallDAG", {},
+                         [this](TIntermBlock *root) { return initCallDag(root); });
 
-        bool multiview2 = IsExtensionEnabled(extensionBehavior, "GL_OVR_multiview2");
-        if (success && compileResources.OVR_multiview && IsWebGLBasedSpec(shaderSpec) &&
-            (IsExtensionEnabled(extensionBehavior, "GL_OVR_multiview") || multiview2))
-            success = ValidateMultiviewWebGL(root, shaderType, symbolTable, shaderVersion,
-                                             multiview2, &mDiagnostics);
+    if (compileOptions & SH_LIMIT_CALL_STACK_DEPTH)
+    {
+        passManager->addPass("CheckCallDepth", {"InitCallDAG"},
+                             [this](TIntermBlock *root) { return checkCallDepth(); });
+    }
 
-        // Fail compilation if precision emulation not supported.
-        if (success && getResources().WEBGL_debug_shader_precision &&
-            getPragma().debugShaderPrecision)
-        {
-            if (!EmulatePrecision::SupportedInLanguage(outputType))
-            {
-                mDiagnostics.globalError("Precision emulation not supported for this output type.");
-                success = false;
-            }
-        }
+    // Checks which functions are used and if "main" exists
+    passManager->addPass("TagUsedFunctions", {"InitCallDAG"}, [this](TIntermBlock *root) {
+        functionMetadata.clear();
+        functionMetadata.resize(mCallDag.size());
+        return tagUsedFunctions();
+    });
 
-        // Built-in function emulation needs to happen after validateLimitations pass.
-        if (success)
-        {
-            // TODO(jmadill): Remove global pool allocator.
-            GetGlobalPoolAllocator()->lock();
-            initBuiltInFunctionEmulator(&builtInFunctionEmulator, compileOptions);
-            GetGlobalPoolAllocator()->unlock();
-            builtInFunctionEmulator.markBuiltInFunctionsForEmulation(root);
-        }
+    if (!(compileOptions & SH_DONT_PRUNE_UNUSED_FUNCTIONS))
+    {
+        passManager->addPass("PruneUnusedFunctions", {"TagUsedFunctions"},
+                             [this](TIntermBlock *root) { return pruneUnusedFunctions(root); });
+    }
 
-        // Clamping uniform array bounds needs to happen after validateLimitations pass.
-        if (success && (compileOptions & SH_CLAMP_INDIRECT_ARRAY_BOUNDS))
-            arrayBoundsClamper.MarkIndirectArrayBoundsForClamping(root);
+    // Prune empty declarations to work around driver bugs and to keep declaration output
+    // simple. This is a walk of its own: it has to run before ValidateOutputs, which would count
+    // an empty "out vec4;" as an output without a location, and the traversal passes below can
+    // only run after ValidateLimitations, so there is no traversal pass next to it to share with.
+    passManager->addPass("PruneEmptyDeclarations", {}, [](TIntermBlock *root) {
+        PruneEmptyDeclarations(root);
+        return true;
+    });
+
+    if (shaderVersion == 300 && shaderType == GL_FRAGMENT_SHADER)
+    {
+        passManager->addPass("ValidateOutputs", {},
+                             [this](TIntermBlock *root) { return validateOutputs(root); });
+    }
+
+    if (shouldRunLoopAndIndexingValidation(compileOptions))
+    {
+        passManager->addPass("ValidateLimitations", {}, [this](TIntermBlock *root) {
+            return ValidateLimitations(root, shaderType, symbolTable, shaderVersion,
+                                       &mDiagnostics);
+        });
+    }
+
+    bool multiview2 = IsExtensionEnabled(extensionBehavior, "GL_OVR_multiview2");
+    if (compileResources.OVR_multiview && IsWebGLBasedSpec(shaderSpec) &&
+        (IsExtensionEnabled(extensionBehavior, "GL_OVR_multiview") || multiview2))
+    {
+        passManager->addPass("ValidateMultiviewWebGL", {}, [this, multiview2](TIntermBlock *root) {
+            return ValidateMultiviewWebGL(root, shaderType, symbolTable, shaderVersion,
+                                          multiview2, &mDiagnostics);
+        });
+    }
+
+    // Fail compilation if precision emulation not supported.
+    if (getResources().WEBGL_debug_shader_precision && getPragma().debugShaderPrecision &&
+        !EmulatePrecision::SupportedInLanguage(outputType))
+    {
+        passManager->addPass("CheckPrecisionEmulation", {}, [this](TIntermBlock *root) {
+            mDiagnostics.globalError("Precision emulation not supported for this output type.");
+            return false;
+        });
+    }
 
-        // gl_Position is always written in compatibility output mode
-        if (success && shaderType == GL_VERTEX_SHADER &&
-            ((compileOptions & SH_INIT_GL_POSITION) ||
-             (outputType == SH_GLSL_COMPATIBILITY_OUTPUT)))
+    // gl_Position is always written in compatibility output mode. This runs before marking the
+    // built-in functions and the indexing to clamp, which don't apply to the initialization, so
+    // that the marking can share a traversal with the rewrites below.
+    if (shaderType == GL_VERTEX_SHADER &&
+        ((compileOptions & SH_INIT_GL_POSITION) || (outputType == SH_GLSL_COMPATIBILITY_OUTPUT)))
+    {
+        passManager->addPass("InitializeGLPosition", {}, [this](TIntermBlock *root) {
             initializeGLPosition(root);
+            return true;
+        });
+    }
 
-        // This pass might emit short circuits so keep it before the short circuit unfolding
-        if (success && (compileOptions & SH_REWRITE_DO_WHILE_LOOPS))
-            RewriteDoWhile(root, getTemporaryIndex());
+    // Built-in function emulation needs to happen after validateLimitations pass.
+    // TODO(jmadill): Remove global pool allocator.
+    GetGlobalPoolAllocator()->lock();
+    initBuiltInFunctionEmulator(&builtInFunctionEmulator, compileOptions);
+    GetGlobalPoolAllocator()->unlock();
+    if (builtInFunctionEmulator.hasEmulatedFunctions())
+    {
+        passManager->addTraversalPass("BuiltInFunctionEmulation", {"ValidateLimitations"},
+                                      builtInFunctionEmulator.createMarkingPass());
+    }
 
-        if (success && (compileOptions & SH_ADD_AND_TRUE_TO_LOOP_CONDITION))
-            sh::AddAndTrueToLoopCondition(root);
+    // Clamping uniform array bounds needs to happen after validateLimitations pass.
+    if (compileOptions & SH_CLAMP_INDIRECT_ARRAY_BOUNDS)
+    {
+        passManager->addTraversalPass("ArrayBoundsClamping", {"ValidateLimitations"},
+                                      arrayBoundsClamper.CreateMarkingPass());
+    }
+
+    if (compileOptions & SH_REWRITE_DO_WHILE_LOOPS)
+    {
+        passManager->addTraversalPass("RewriteDoWhile", {},
+                                      CreateRewriteDoWhilePass(getTemporaryIndex()));
+    }
 
-        if (success && (compileOptions & SH_UNFOLD_SHORT_CIRCUIT))
+    if (compileOptions & SH_ADD_AND_TRUE_TO_LOOP_CONDITION)
+    {
+        passManager->addTraversalPass("AddAndTrueToLoopCondition", {},
+                                      CreateAddAndTrueToLoopConditionPass());
+    }
+
+    // The loop rewrites might emit short circuits, so they need to run before the short circuit
+    // unfolding.
+    if (compileOptions & SH_UNFOLD_SHORT_CIRCUIT)
+    {
+        passManager->addTraversalPass("UnfoldShortCircuit",
+                                      {"RewriteDoWhile", "AddAndTrueToLoopCondition"},
+                                      std::unique_ptr<TTraversalPass>(new UnfoldShortCircuitAST()));
+    }
+
+    // pow() calls can't be operands of the short circuits replaced above, so the queued
+    // replacements of the two passes don't overlap.
+    if (compileOptions & SH_REMOVE_POW_WITH_CONSTANT_EXPONENT)
+    {
+        passManager->addTraversalPass("RemovePow", {}, CreateRemovePowPass());
+    }
+
+    if (shouldCollectVariables(compileOptions))
+    {
+        passManager->addPass("CollectVariables", {}, [this](TIntermBlock *root) {
+            collectVariables(root);
+            return true;
+        });
+        if (compileOptions & SH_USE_UNUSED_STANDARD_SHARED_BLOCKS)
         {
-            UnfoldShortCircuitAST unfoldShortCircuit;
-            root->traverse(&unfoldShortCircuit);
-            unfoldShortCircuit.updateTree();
+            passManager->addPass("UseUnusedStandardAndSharedBlocks", {"CollectVariables"},
+                                 [this](TIntermBlock *root) {
+                                     useAllMembersInUnusedStandardAndSharedBlocks(root);
+                                     return true;
+                                 });
         }
-
-        if (success && (compileOptions & SH_REMOVE_POW_WITH_CONSTANT_EXPONENT))
+        if (compileOptions & SH_ENFORCE_PACKING_RESTRICTIONS)
         {
-            RemovePow(root);
+            passManager->addPass("EnforcePackingRestrictions", {"CollectVariables"},
+                                 [this](TIntermBlock *root) {
+                                     if (!enforcePackingRestrictions())
+                                     {
+                                         mDiagnostics.globalError("too many uniforms");
+                                         return false;
+                                     }
+                                     return true;
+                                 });
         }
-
-        if (success && shouldCollectVariables(compileOptions))
+        if (compileOptions & SH_INIT_OUTPUT_VARIABLES)
         {
-            collectVariables(root);
-            if (compileOptions & SH_USE_UNUSED_STANDARD_SHARED_BLOCKS)
-            {
-                useAllMembersInUnusedStandardAndSharedBlocks(root);
-            }
-            if (compileOptions & SH_ENFORCE_PACKING_RESTRICTIONS)
-            {
-                success = enforcePackingRestrictions();
-                if (!success)
-                {
-                    mDiagnostics.globalError("too many uniforms");
-                }
-            }
-            if (success && (compileOptions & SH_INIT_OUTPUT_VARIABLES))
-            {
-                initializeOutputVariables(root);
-            }
+            passManager->addPass("InitializeOutputVariables", {"CollectVariables"},
+                                 [this](TIntermBlock *root) {
+                                     initializeOutputVariables(root);
+                                     return true;
+                                 });
         }
+    }
 
-        // Removing invariant declarations must be done after collecting variables.
-        // Otherwise, built-in invariant declarations don't apply.
-        if (success && RemoveInvariant(shaderType, shaderVersion, outputType, compileOptions))
-            sh::RemoveInvariantDeclaration(root);
+    // Removing invariant declarations must be done after collecting variables.
+    // Otherwise, built-in invariant declarations don't apply.
+    if (RemoveInvariant(shaderType, shaderVersion, outputType, compileOptions))
+    {
+        passManager->addPass("RemoveInvariantDeclaration", {"CollectVariables"},
+                             [](TIntermBlock *root) {
+                                 RemoveInvariantDeclaration(root);
+                                 return true;
+                             });
+    }
 
-        if (success && (compileOptions & SH_SCALARIZE_VEC_AND_MAT_CONSTRUCTOR_ARGS))
-        {
+    if (compileOptions & SH_SCALARIZE_VEC_AND_MAT_CONSTRUCTOR_ARGS)
+    {
+        passManager->addPass("ScalarizeVecAndMatConstructorArgs", {}, [this](TIntermBlock *root) {
             ScalarizeVecAndMatConstructorArgs(root, shaderType, fragmentPrecisionHigh,
                                               &mTemporaryIndex);
-        }
+            return true;
+        });
+    }
 
-        if (success && (compileOptions & SH_REGENERATE_STRUCT_NAMES))
-        {
+    if (compileOptions & SH_REGENERATE_STRUCT_NAMES)
+    {
+        passManager->addPass("RegenerateStructNames", {}, [this](TIntermBlock *root) {
             RegenerateStructNames gen(symbolTable, shaderVersion);
             root->traverse(&gen);
-        }
-
-        if (success && shaderType == GL_FRAGMENT_SHADER && shaderVersion == 100 &&
-            compileResources.EXT_draw_buffers && compileResources.MaxDrawBuffers > 1 &&
-            IsExtensionEnabled(extensionBehavior, "GL_EXT_draw_buffers"))
-        {
-            EmulateGLFragColorBroadcast(root, compileResources.MaxDrawBuffers, &outputVariables);
-        }
-
-        if (success)
-        {
-            DeferGlobalInitializers(root);
-        }
+            return true;
+        });
     }
 
-    if (success)
-        return root;
+    if (shaderType == GL_FRAGMENT_SHADER && shaderVersion == 100 &&
+        compileResources.EXT_draw_buffers && compileResources.MaxDrawBuffers > 1 &&
+        IsExtensionEnabled(extensionBehavior, "GL_EXT_draw_buffers"))
+    {
+        passManager->addPass("EmulateGLFragColorBroadcast", {"CollectVariables"},
+                             [this](TIntermBlock *root) {
+                                 EmulateGLFragColorBroadcast(root, compileResources.MaxDrawBuffers,
+                                                             &outputVariables);
+                                 return true;
+                             });
+    }
 
-    return NULL;
+    // Also a walk of its own. It moves global initializers into a function, so it has to see the
+    // temporaries that ScalarizeVecAndMatConstructorArgs inserts and the renamed structs, and run
+    // after the passes above that collect or rewrite outputs.
+    passManager->addPass("DeferGlobalInitializers", {}, [](TIntermBlock *root) {
+        DeferGlobalInitializers(root);
+        return true;
+    });
 }
 
 bool TCompiler::compile(const char *const shaderStrings[],
@@ -502,7 +604,7 @@ bool TCompiler::compile(const char *const shaderStrings[],
         compileOptions |= SH_FLATTEN_PRAGMA_STDGL_INVARIANT_ALL;
     }
 
-    TScopedPoolAllocator scopedAlloc(&allocator);
+    TScopedPoolAllocator scopedAlloc(&allocator, &mPeakPoolAllocatorBytes);
     TIntermBlock *root = compileTreeImpl(shaderStrings, numStrings, compileOptions);
 
     if (root)
@@ -511,7 +613,10 @@ bool TCompiler::compile(const char *const shaderStrings[],
             TIntermediate::outputTree(root, infoSink.info);
 
         if (compileOptions & SH_OBJECT_CODE)
+        {
+            TScopedPassTimer timer("Translate", &mPassTimings);
             translate(root, compileOptions);
+        }
 
         // The IntermNode tree doesn't need to be deleted here, since the
         // memory will be freed in a big chunk by the PoolAllocator.
@@ -534,11 +639,11 @@ bool TCompiler::InitBuiltInSymbolTable(const ShBuiltInResources &resources)
     compileResources = resources;
     setResourceString();
 
+    // The built-in levels only depend on the parameters that make up the resource string, so
+    // they are built once per process and shared by every compiler with the same parameters.
     assert(symbolTable.isEmpty());
-    symbolTable.push();  // COMMON_BUILTINS
-    symbolTable.push();  // ESSL1_BUILTINS
-    symbolTable.push();  // ESSL3_BUILTINS
-    symbolTable.push();  // ESSL3_1_BUILTINS
+    symbolTable.pushSharedBuiltInLevels(
+        *TCache::getBuiltInSymbolTable(shaderType, shaderSpec, resources, builtInResourcesString));
 
     TPublicType integer;
     integer.initializeBasicType(EbtInt);
@@ -574,10 +679,6 @@ bool TCompiler::InitBuiltInSymbolTable(const ShBuiltInResources &resources)
     // It isn't specified whether Sampler2DRect has default precision.
     initSamplerDefaultPrecision(EbtSampler2DRect);
 
-    InsertBuiltInFunctions(shaderType, shaderSpec, resources, symbolTable);
-
-    IdentifyBuiltIns(shaderType, shaderSpec, resources, symbolTable);
-
     return true;
 }
 
@@ -649,7 +750,9 @@ void TCompiler::setResourceString()
         << ":MaxVertexAtomicCounterBuffers:" << compileResources.MaxVertexAtomicCounterBuffers
         << ":MaxFragmentAtomicCounterBuffers:" << compileResources.MaxFragmentAtomicCounterBuffers
         << ":MaxCombinedAtomicCounterBuffers:" << compileResources.MaxCombinedAtomicCounterBuffers
-        << ":MaxAtomicCounterBufferSize:" << compileResources.MaxAtomicCounterBufferSize;
+        << ":MaxAtomicCounterBufferSize:" << compileResources.MaxAtomicCounterBufferSize
+        << ":OVR_multiview:" << compileResources.OVR_multiview
+        << ":MaxViewsOVR:" << compileResources.MaxViewsOVR;
     // clang-format on
 
     builtInResourcesString = strstream.str();
@@ -679,6 +782,8 @@ void TCompiler::clearResults()
 
     mSourcePath     = NULL;
     mTemporaryIndex = 0;
+
+    mPassTimings.clear();
 }
 
 bool TCompiler::initCallDag(TIntermNode *root)
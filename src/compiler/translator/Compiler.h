@@ -29,6 +29,7 @@ namespace sh
 {
 
 class TCompiler;
+class TPassManager;
 #ifdef ANGLE_ENABLE_HLSL
 class TranslatorHLSL;
 #endif  // ANGLE_ENABLE_HLSL
@@ -103,6 +104,8 @@ class TCompiler : public TShHandleBase
     bool isComputeShaderLocalSizeDeclared() const { return mComputeShaderLocalSizeDeclared; }
     const sh::WorkGroupSize &getComputeShaderLocalSize() const { return mComputeShaderLocalSize; }
     int getNumViews() const { return mNumViews; }
+    const std::vector<PassTiming> &getPassTimings() const { return mPassTimings; }
+    size_t getPeakPoolAllocatorBytes() const { return mPeakPoolAllocatorBytes; }
 
     // Clears the results from the previous compilation.
     void clearResults();
@@ -202,6 +205,8 @@ class TCompiler : public TShHandleBase
     TIntermBlock *compileTreeImpl(const char *const shaderStrings[],
                                   size_t numStrings,
                                   const ShCompileOptions compileOptions);
+    // Adds the passes that run on the AST after parsing.
+    void addPasses(TPassManager *passManager, ShCompileOptions compileOptions);
 
     sh::GLenum shaderType;
     ShShaderSpec shaderSpec;
@@ -255,6 +260,9 @@ class TCompiler : public TShHandleBase
     TPragma mPragma;
 
     unsigned int mTemporaryIndex;
+
+    std::vector<PassTiming> mPassTimings;
+    size_t mPeakPoolAllocatorBytes;
 };
 
 //
@@ -13,6 +13,7 @@
 #include <math.h>
 #include <stdlib.h>
 #include <algorithm>
+#include <unordered_map>
 #include <vector>
 
 #include "common/mathutil.h"
@@ -3334,26 +3335,28 @@ void TIntermTraverser::updateTree()
             ASSERT(inserted);
         }
     }
-    for (size_t ii = 0; ii < mReplacements.size(); ++ii)
+    // In AST traversing, a parent is visited before its children. After we replace a node, if its
+    // immediate child is to be replaced, we need to make sure we don't update the replaced node;
+    // instead, we update the replacement node. The dropped nodes are looked up in a map, so that
+    // traversals queueing many replacements don't take quadratic time.
+    std::unordered_map<TIntermNode *, TIntermNode *> droppedNodeReplacements;
+    for (const NodeUpdateEntry &replacement : mReplacements)
     {
-        const NodeUpdateEntry &replacement = mReplacements[ii];
-        ASSERT(replacement.parent);
-        bool replaced =
-            replacement.parent->replaceChildNode(replacement.original, replacement.replacement);
+        TIntermNode *parent = replacement.parent;
+        ASSERT(parent);
+        auto droppedParent = droppedNodeReplacements.find(parent);
+        while (droppedParent != droppedNodeReplacements.end())
+        {
+            parent        = droppedParent->second;
+            droppedParent = droppedNodeReplacements.find(parent);
+        }
+
+        bool replaced = parent->replaceChildNode(replacement.original, replacement.replacement);
         ASSERT(replaced);
 
         if (!replacement.originalBecomesChildOfReplacement)
         {
-            // In AST traversing, a parent is visited before its children.
-            // After we replace a node, if its immediate child is to
-            // be replaced, we need to make sure we don't update the replaced
-            // node; instead, we update the replacement node.
-            for (size_t jj = ii + 1; jj < mReplacements.size(); ++jj)
-            {
-                NodeUpdateEntry &replacement2 = mReplacements[jj];
-                if (replacement2.parent == replacement.original)
-                    replacement2.parent = replacement.replacement;
-            }
+            droppedNodeReplacements[replacement.original] = replacement.replacement;
         }
     }
     for (size_t ii = 0; ii < mMultiReplacements.size(); ++ii)
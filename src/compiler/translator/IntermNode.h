@@ -1151,6 +1151,9 @@ class TIntermTraverser : angle::NonCopyable
     std::vector<NodeInsertMultipleEntry> mInsertions;
 
   private:
+    // Keeps the traversal state of the passes it drives up to date.
+    friend class TFusedTraverser;
+
     static TName GetInternalFunctionName(const char *name);
 
     // To replace a single node with another on the parent node
@@ -0,0 +1,492 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PassManager.cpp: Implements TPassManager and the traverser that runs several traversal passes in
+// a single traversal of the tree.
+//
+
+#include "compiler/translator/PassManager.h"
+
+#include <algorithm>
+
+namespace sh
+{
+
+// Pre-visits every node with the passes it drives, in the order of the passes. A pass that skips
+// the children of a node isn't called for the nodes in that subtree. The traversal path, parent
+// blocks and scope of the passes are kept up to date, so that the passes can use the same helpers
+// as when they run in a traversal of their own.
+class TFusedTraverser : public TIntermTraverser
+{
+  public:
+    explicit TFusedTraverser(const std::vector<TTraversalPass *> &passes);
+
+    void traverseSymbol(TIntermSymbol *node) override;
+    void traverseRaw(TIntermRaw *node) override;
+    void traverseConstantUnion(TIntermConstantUnion *node) override;
+    void traverseSwizzle(TIntermSwizzle *node) override;
+    void traverseBinary(TIntermBinary *node) override;
+    void traverseUnary(TIntermUnary *node) override;
+    void traverseTernary(TIntermTernary *node) override;
+    void traverseIfElse(TIntermIfElse *node) override;
+    void traverseSwitch(TIntermSwitch *node) override;
+    void traverseCase(TIntermCase *node) override;
+    void traverseFunctionPrototype(TIntermFunctionPrototype *node) override;
+    void traverseFunctionDefinition(TIntermFunctionDefinition *node) override;
+    void traverseAggregate(TIntermAggregate *node) override;
+    void traverseBlock(TIntermBlock *node) override;
+    void traverseInvariantDeclaration(TIntermInvariantDeclaration *node) override;
+    void traverseDeclaration(TIntermDeclaration *node) override;
+    void traverseLoop(TIntermLoop *node) override;
+    void traverseBranch(TIntermBranch *node) override;
+
+  private:
+    // RAII helper that adds the node to the traversal path of every pass, and makes the passes
+    // that skipped its children visit nodes again once its subtree is done.
+    class ScopedNodeInPassPaths final : angle::NonCopyable
+    {
+      public:
+        ScopedNodeInPassPaths(TFusedTraverser *traverser, TIntermNode *node);
+        ~ScopedNodeInPassPaths();
+
+      private:
+        TFusedTraverser *mTraverser;
+        TIntermNode *mNode;
+    };
+
+    // Returns true if any of the passes wants to visit the children of the node.
+    template <typename NodeType>
+    bool preVisitPasses(NodeType *node, bool (TIntermTraverser::*visitFunction)(Visit, NodeType *));
+    template <typename NodeType>
+    void visitPasses(NodeType *node, void (TIntermTraverser::*visitFunction)(NodeType *));
+
+    void traverseSequence(TIntermSequence *sequence);
+
+    std::vector<TTraversalPass *> mPasses;
+
+    // The node whose subtree each pass skips, or nullptr if the pass visits the current node.
+    std::vector<TIntermNode *> mSkippedSubtrees;
+};
+
+TFusedTraverser::ScopedNodeInPassPaths::ScopedNodeInPassPaths(TFusedTraverser *traverser,
+                                                              TIntermNode *node)
+    : mTraverser(traverser), mNode(node)
+{
+    for (TTraversalPass *pass : mTraverser->mPasses)
+    {
+        pass->incrementDepth(node);
+    }
+}
+
+TFusedTraverser::ScopedNodeInPassPaths::~ScopedNodeInPassPaths()
+{
+    for (size_t passIndex = 0; passIndex < mTraverser->mPasses.size(); ++passIndex)
+    {
+        mTraverser->mPasses[passIndex]->decrementDepth();
+        if (mTraverser->mSkippedSubtrees[passIndex] == mNode)
+        {
+            mTraverser->mSkippedSubtrees[passIndex] = nullptr;
+        }
+    }
+}
+
+TFusedTraverser::TFusedTraverser(const std::vector<TTraversalPass *> &passes)
+    : TIntermTraverser(true, false, false),
+      mPasses(passes),
+      mSkippedSubtrees(passes.size(), nullptr)
+{
+}
+
+template <typename NodeType>
+bool TFusedTraverser::preVisitPasses(NodeType *node,
+                                     bool (TIntermTraverser::*visitFunction)(Visit, NodeType *))
+{
+    bool visitChildren = false;
+    for (size_t passIndex = 0; passIndex < mPasses.size(); ++passIndex)
+    {
+        if (mSkippedSubtrees[passIndex] != nullptr)
+        {
+            continue;
+        }
+
+        TIntermTraverser *pass = mPasses[passIndex];
+        if ((pass->*visitFunction)(PreVisit, node))
+        {
+            visitChildren = true;
+        }
+        else
+        {
+            mSkippedSubtrees[passIndex] = node;
+        }
+    }
+    return visitChildren;
+}
+
+template <typename NodeType>
+void TFusedTraverser::visitPasses(NodeType *node,
+                                  void (TIntermTraverser::*visitFunction)(NodeType *))
+{
+    for (size_t passIndex = 0; passIndex < mPasses.size(); ++passIndex)
+    {
+        if (mSkippedSubtrees[passIndex] == nullptr)
+        {
+            TIntermTraverser *pass = mPasses[passIndex];
+            (pass->*visitFunction)(node);
+        }
+    }
+}
+
+void TFusedTraverser::traverseSequence(TIntermSequence *sequence)
+{
+    for (TIntermNode *child : *sequence)
+    {
+        child->traverse(this);
+    }
+}
+
+void TFusedTraverser::traverseSymbol(TIntermSymbol *node)
+{
+    ScopedNodeInPassPaths addToPaths(this, node);
+    visitPasses(node, &TIntermTraverser::visitSymbol);
+}
+
+void TFusedTraverser::traverseRaw(TIntermRaw *node)
+{
+    ScopedNodeInPassPaths addToPaths(this, node);
+    visitPasses(node, &TIntermTraverser::visitRaw);
+}
+
+void TFusedTraverser::traverseConstantUnion(TIntermConstantUnion *node)
+{
+    ScopedNodeInPassPaths addToPaths(this, node);
+    visitPasses(node, &TIntermTraverser::visitConstantUnion);
+}
+
+void TFusedTraverser::traverseSwizzle(TIntermSwizzle *node)
+{
+    ScopedNodeInPassPaths addToPaths(this, node);
+    if (preVisitPasses(node, &TIntermTraverser::visitSwizzle))
+    {
+        node->getOperand()->traverse(this);
+    }
+}
+
+void TFusedTraverser::traverseBinary(TIntermBinary *node)
+{
+    ScopedNodeInPassPaths addToPaths(this, node);
+    if (preVisitPasses(node, &TIntermTraverser::visitBinary))
+    {
+        if (node->getLeft())
+            node->getLeft()->traverse(this);
+        if (node->getRight())
+            node->getRight()->traverse(this);
+    }
+}
+
+void TFusedTraverser::traverseUnary(TIntermUnary *node)
+{
+    ScopedNodeInPassPaths addToPaths(this, node);
+    if (preVisitPasses(node, &TIntermTraverser::visitUnary))
+    {
+        node->getOperand()->traverse(this);
+    }
+}
+
+void TFusedTraverser::traverseTernary(TIntermTernary *node)
+{
+    ScopedNodeInPassPaths addToPaths(this, node);
+    if (preVisitPasses(node, &TIntermTraverser::visitTernary))
+    {
+        node->getCondition()->traverse(this);
+        if (node->getTrueExpression())
+            node->getTrueExpression()->traverse(this);
+        if (node->getFalseExpression())
+            node->getFalseExpression()->traverse(this);
+    }
+}
+
+void TFusedTraverser::traverseIfElse(TIntermIfElse *node)
+{
+    ScopedNodeInPassPaths addToPaths(this, node);
+    if (preVisitPasses(node, &TIntermTraverser::visitIfElse))
+    {
+        node->getCondition()->traverse(this);
+        if (node->getTrueBlock())
+            node->getTrueBlock()->traverse(this);
+        if (node->getFalseBlock())
+            node->getFalseBlock()->traverse(this);
+    }
+}
+
+void TFusedTraverser::traverseSwitch(TIntermSwitch *node)
+{
+    ScopedNodeInPassPaths addToPaths(this, node);
+    if (preVisitPasses(node, &TIntermTraverser::visitSwitch))
+    {
+        node->getInit()->traverse(this);
+        if (node->getStatementList())
+            node->getStatementList()->traverse(this);
+    }
+}
+
+void TFusedTraverser::traverseCase(TIntermCase *node)
+{
+    ScopedNodeInPassPaths addToPaths(this, node);
+    if (preVisitPasses(node, &TIntermTraverser::visitCase) && node->getCondition())
+    {
+        node->getCondition()->traverse(this);
+    }
+}
+
+void TFusedTraverser::traverseFunctionPrototype(TIntermFunctionPrototype *node)
+{
+    ScopedNodeInPassPaths addToPaths(this, node);
+    if (preVisitPasses(node, &TIntermTraverser::visitFunctionPrototype))
+    {
+        traverseSequence(node->getSequence());
+    }
+}
+
+void TFusedTraverser::traverseFunctionDefinition(TIntermFunctionDefinition *node)
+{
+    ScopedNodeInPassPaths addToPaths(this, node);
+    if (preVisitPasses(node, &TIntermTraverser::visitFunctionDefinition))
+    {
+        for (TTraversalPass *pass : mPasses)
+        {
+            pass->mInGlobalScope = false;
+        }
+
+        node->getFunctionPrototype()->traverse(this);
+        node->getBody()->traverse(this);
+
+        for (TTraversalPass *pass : mPasses)
+        {
+            pass->mInGlobalScope = true;
+        }
+    }
+}
+
+void TFusedTraverser::traverseAggregate(TIntermAggregate *node)
+{
+    ScopedNodeInPassPaths addToPaths(this, node);
+    if (preVisitPasses(node, &TIntermTraverser::visitAggregate))
+    {
+        traverseSequence(node->getSequence());
+    }
+}
+
+void TFusedTraverser::traverseBlock(TIntermBlock *node)
+{
+    ScopedNodeInPassPaths addToPaths(this, node);
+    for (TTraversalPass *pass : mPasses)
+    {
+        pass->pushParentBlock(node);
+    }
+
+    if (preVisitPasses(node, &TIntermTraverser::visitBlock))
+    {
+        for (TIntermNode *child : *node->getSequence())
+        {
+            child->traverse(this);
+            for (TTraversalPass *pass : mPasses)
+            {
+                pass->incrementParentBlockPos();
+            }
+        }
+    }
+
+    for (TTraversalPass *pass : mPasses)
+    {
+        pass->popParentBlock();
+    }
+}
+
+void TFusedTraverser::traverseInvariantDeclaration(TIntermInvariantDeclaration *node)
+{
+    ScopedNodeInPassPaths addToPaths(this, node);
+    if (preVisitPasses(node, &TIntermTraverser::visitInvariantDeclaration))
+    {
+        node->getSymbol()->traverse(this);
+    }
+}
+
+void TFusedTraverser::traverseDeclaration(TIntermDeclaration *node)
+{
+    ScopedNodeInPassPaths addToPaths(this, node);
+    if (preVisitPasses(node, &TIntermTraverser::visitDeclaration))
+    {
+        traverseSequence(node->getSequence());
+    }
+}
+
+void TFusedTraverser::traverseLoop(TIntermLoop *node)
+{
+    ScopedNodeInPassPaths addToPaths(this, node);
+    if (preVisitPasses(node, &TIntermTraverser::visitLoop))
+    {
+        if (node->getInit())
+            node->getInit()->traverse(this);
+        if (node->getCondition())
+            node->getCondition()->traverse(this);
+        if (node->getBody())
+            node->getBody()->traverse(this);
+        if (node->getExpression())
+            node->getExpression()->traverse(this);
+    }
+}
+
+void TFusedTraverser::traverseBranch(TIntermBranch *node)
+{
+    ScopedNodeInPassPaths addToPaths(this, node);
+    if (preVisitPasses(node, &TIntermTraverser::visitBranch) && node->getExpression())
+    {
+        node->getExpression()->traverse(this);
+    }
+}
+
+TScopedPassTimer::TScopedPassTimer(const std::string &name, std::vector<PassTiming> *timings)
+    : mName(name), mTimings(timings), mStartTime(std::chrono::steady_clock::now())
+{
+}
+
+TScopedPassTimer::~TScopedPassTimer()
+{
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - mStartTime;
+
+    PassTiming timing;
+    timing.name    = mName;
+    timing.seconds = elapsed.count();
+    mTimings->push_back(timing);
+}
+
+TPassManager::TPassManager(std::vector<PassTiming> *timings, bool shareTraversals)
+    : mTimings(timings), mShareTraversals(shareTraversals)
+{
+}
+
+TPassManager::~TPassManager()
+{
+}
+
+void TPassManager::addPass(const char *name,
+                           const std::vector<const char *> &dependencies,
+                           const PassFunction &function)
+{
+    Pass pass;
+    pass.function = function;
+    addPass(name, dependencies, &pass);
+}
+
+void TPassManager::addTraversalPass(const char *name,
+                                    const std::vector<const char *> &dependencies,
+                                    std::unique_ptr<TTraversalPass> traversalPass)
+{
+    Pass pass;
+    pass.traversalPass = std::move(traversalPass);
+    addPass(name, dependencies, &pass);
+}
+
+void TPassManager::addPass(const char *name,
+                           const std::vector<const char *> &dependencies,
+                           Pass *pass)
+{
+    // A pass that was already added can't depend on this one.
+    for (const Pass &previousPass : mPasses)
+    {
+        ASSERT(previousPass.name != name);
+        ASSERT(std::find(previousPass.dependencies.begin(), previousPass.dependencies.end(),
+                         name) == previousPass.dependencies.end());
+    }
+
+    pass->name = name;
+    pass->dependencies.assign(dependencies.begin(), dependencies.end());
+    mPasses.push_back(std::move(*pass));
+}
+
+bool TPassManager::canShareTraversal(size_t firstPassIndex, size_t passIndex) const
+{
+    const Pass &pass = mPasses[passIndex];
+    if (!pass.traversalPass)
+    {
+        return false;
+    }
+
+    for (size_t previousIndex = firstPassIndex; previousIndex < passIndex; ++previousIndex)
+    {
+        const Pass &previousPass = mPasses[previousIndex];
+        if (previousPass.traversalPass->getTreeEdits() ==
+                TTraversalPass::TreeEdits::AFTER_TRAVERSAL &&
+            std::find(pass.dependencies.begin(), pass.dependencies.end(), previousPass.name) !=
+                pass.dependencies.end())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TPassManager::runTraversal(TIntermBlock *root, size_t firstPassIndex, size_t endPassIndex)
+{
+    std::string name;
+    std::vector<TTraversalPass *> traversalPasses;
+    for (size_t passIndex = firstPassIndex; passIndex < endPassIndex; ++passIndex)
+    {
+        if (!name.empty())
+        {
+            name += "+";
+        }
+        name += mPasses[passIndex].name;
+        traversalPasses.push_back(mPasses[passIndex].traversalPass.get());
+    }
+
+    TScopedPassTimer timer(name, mTimings);
+
+    if (traversalPasses.size() == 1)
+    {
+        traversalPasses[0]->run(root);
+        return;
+    }
+
+    TFusedTraverser traverser(traversalPasses);
+    root->traverse(&traverser);
+
+    for (TTraversalPass *traversalPass : traversalPasses)
+    {
+        traversalPass->finish(root);
+    }
+}
+
+bool TPassManager::run(TIntermBlock *root)
+{
+    size_t passIndex = 0;
+    while (passIndex < mPasses.size())
+    {
+        const Pass &pass = mPasses[passIndex];
+        if (!pass.traversalPass)
+        {
+            TScopedPassTimer timer(pass.name, mTimings);
+            if (!pass.function(root))
+            {
+                return false;
+            }
+            ++passIndex;
+            continue;
+        }
+
+        size_t endPassIndex = passIndex + 1;
+        while (mShareTraversals && endPassIndex < mPasses.size() &&
+               canShareTraversal(passIndex, endPassIndex))
+        {
+            ++endPassIndex;
+        }
+
+        runTraversal(root, passIndex, endPassIndex);
+        passIndex = endPassIndex;
+    }
+    return true;
+}
+
+}  // namespace sh
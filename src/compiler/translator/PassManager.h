@@ -0,0 +1,119 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PassManager.h: Runs the passes that validate and transform the AST after parsing. Passes that
+// only pre-visit the tree share a single traversal when their dependencies allow it, and the time
+// taken by every step is recorded.
+//
+
+#ifndef COMPILER_TRANSLATOR_PASSMANAGER_H_
+#define COMPILER_TRANSLATOR_PASSMANAGER_H_
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/IntermNode.h"
+
+namespace sh
+{
+
+// A traverser that does all of its work in pre-visits, so that it can share a traversal of the
+// tree with other traversal passes. Edits made during the traversal may only touch the node being
+// visited and its subtree, and are seen by the passes that visit the node after this one.
+class TTraversalPass : public TIntermTraverser
+{
+  public:
+    enum class TreeEdits
+    {
+        // The tree is only read, or edited in place as it is visited.
+        DURING_TRAVERSAL,
+        // Replacements are queued and applied in finish(), so passes that depend on the edits
+        // need to run in a later traversal.
+        AFTER_TRAVERSAL
+    };
+
+    explicit TTraversalPass(TreeEdits treeEdits)
+        : TIntermTraverser(true, false, false), mTreeEdits(treeEdits)
+    {
+    }
+
+    TreeEdits getTreeEdits() const { return mTreeEdits; }
+
+    // Called once the traversal is done. Applies the queued replacements by default.
+    virtual void finish(TIntermBlock *root) { updateTree(); }
+
+    // Runs the pass in a traversal of its own.
+    void run(TIntermBlock *root)
+    {
+        root->traverse(this);
+        finish(root);
+    }
+
+  private:
+    TreeEdits mTreeEdits;
+};
+
+// Appends the time until it goes out of scope to the pass timings.
+class TScopedPassTimer final : angle::NonCopyable
+{
+  public:
+    TScopedPassTimer(const std::string &name, std::vector<PassTiming> *timings);
+    ~TScopedPassTimer();
+
+  private:
+    std::string mName;
+    std::vector<PassTiming> *mTimings;
+    std::chrono::steady_clock::time_point mStartTime;
+};
+
+class TPassManager final : angle::NonCopyable
+{
+  public:
+    // Returns false if the compilation fails.
+    using PassFunction = std::function<bool(TIntermBlock *root)>;
+
+    // If shareTraversals is false, every traversal pass runs in a traversal of its own.
+    TPassManager(std::vector<PassTiming> *timings, bool shareTraversals);
+    ~TPassManager();
+
+    // The dependencies are the names of the passes that need to run before this one. Passes that
+    // aren't added, for example because they're disabled, are ignored.
+    void addPass(const char *name,
+                 const std::vector<const char *> &dependencies,
+                 const PassFunction &function);
+    void addTraversalPass(const char *name,
+                          const std::vector<const char *> &dependencies,
+                          std::unique_ptr<TTraversalPass> pass);
+
+    // Runs the passes in the order they were added, and stops at the first pass that fails.
+    // Consecutive traversal passes share a traversal, unless one depends on the queued edits of
+    // another or sharing is disabled.
+    bool run(TIntermBlock *root);
+
+  private:
+    struct Pass
+    {
+        std::string name;
+        std::vector<std::string> dependencies;
+        PassFunction function;
+        std::unique_ptr<TTraversalPass> traversalPass;
+    };
+
+    void addPass(const char *name, const std::vector<const char *> &dependencies, Pass *pass);
+    bool canShareTraversal(size_t firstPassIndex, size_t passIndex) const;
+    void runTraversal(TIntermBlock *root, size_t firstPassIndex, size_t endPassIndex);
+
+    std::vector<Pass> mPasses;
+    std::vector<PassTiming> *mTimings;
+    bool mShareTraversals;
+};
+
+}  // namespace sh
+
+#endif  // COMPILER_TRANSLATOR_PASSMANAGER_H_
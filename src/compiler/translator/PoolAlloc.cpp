@@ -56,6 +56,7 @@ TPoolAllocator::TPoolAllocator(int growthIncrement, int allocationAlignment)
       pageSize(growthIncrement),
       freeList(0),
       inUseList(0),
+      mBytesInUse(0),
       numCalls(0),
       totalBytes(0),
 #endif
@@ -212,6 +213,7 @@ void TPoolAllocator::pop()
         inUseList->~tHeader();
 
         tHeader *nextInUse = inUseList->nextPage;
+        mBytesInUse -= inUseList->pageCount * pageSize;
         if (inUseList->pageCount > 1)
             delete[] reinterpret_cast<char *>(inUseList);
         else
@@ -297,6 +299,7 @@ void *TPoolAllocator::allocate(size_t numBytes)
         // Use placement-new to initialize header
         new (memory) tHeader(inUseList, (numBytesToAlloc + pageSize - 1) / pageSize);
         inUseList = memory;
+        mBytesInUse += inUseList->pageCount * pageSize;
 
         currentPageOffset = pageSize;  // make next allocation come from a new page
 
@@ -323,6 +326,7 @@ void *TPoolAllocator::allocate(size_t numBytes)
     // Use placement-new to initialize header
     new (memory) tHeader(inUseList, 1);
     inUseList = memory;
+    mBytesInUse += pageSize;
 
     unsigned char *ret = reinterpret_cast<unsigned char *>(inUseList) + headerSkip;
     currentPageOffset  = (headerSkip + allocationSize + alignmentMask) & ~alignmentMask;
@@ -338,6 +342,15 @@ void *TPoolAllocator::allocate(size_t numBytes)
 #endif
 }
 
+size_t TPoolAllocator::getBytesInUse() const
+{
+#if !defined(ANGLE_TRANSLATOR_DISABLE_POOL_ALLOC)
+    return mBytesInUse;
+#else  // !defined(ANGLE_TRANSLATOR_DISABLE_POOL_ALLOC)
+    return 0;
+#endif
+}
+
 void TPoolAllocator::lock()
 {
     ASSERT(!mLocked);
@@ -151,6 +151,12 @@ class TPoolAllocator
     //
     void *allocate(size_t numBytes);
 
+    //
+    // Returns the size of the pages that hold live allocations. Allocations come straight from
+    // malloc when the pool is disabled, and aren't counted.
+    //
+    size_t getBytesInUse() const;
+
     //
     // There is no deallocate.  The point of this class is that
     // deallocation can be skipped by the user of it, as the model
@@ -224,6 +230,7 @@ class TPoolAllocator
     tHeader *freeList;         // list of popped memory
     tHeader *inUseList;        // list of all memory currently being used
     tAllocStack mStack;        // stack of where to allocate from, to partition pool
+    size_t mBytesInUse;        // size of the pages in inUseList
 
     int numCalls;       // just an interesting statistic
     size_t totalBytes;  // just an interesting statistic
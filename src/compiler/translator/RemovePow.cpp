@@ -12,6 +12,7 @@
 
 #include "compiler/translator/InfoSink.h"
 #include "compiler/translator/IntermNode.h"
+#include "compiler/translator/PassManager.h"
 
 namespace sh
 {
@@ -31,22 +32,20 @@ bool IsProblematicPow(TIntermTyped *node)
 }
 
 // Traverser that converts all pow operations simultaneously.
-class RemovePowTraverser : public TIntermTraverser
+class RemovePowTraverser : public TTraversalPass
 {
   public:
     RemovePowTraverser();
 
     bool visitAggregate(Visit visit, TIntermAggregate *node) override;
-
-    void nextIteration() { mNeedAnotherIteration = false; }
-    bool needAnotherIteration() const { return mNeedAnotherIteration; }
+    void finish(TIntermBlock *root) override;
 
   protected:
     bool mNeedAnotherIteration;
 };
 
 RemovePowTraverser::RemovePowTraverser()
-    : TIntermTraverser(true, false, false), mNeedAnotherIteration(false)
+    : TTraversalPass(TreeEdits::AFTER_TRAVERSAL), mNeedAnotherIteration(false)
 {
 }
 
@@ -80,18 +79,30 @@ bool RemovePowTraverser::visitAggregate(Visit visit, TIntermAggregate *node)
     return true;
 }
 
+void RemovePowTraverser::finish(TIntermBlock *root)
+{
+    updateTree();
+
+    // Iterate as necessary, and reset the traverser between iterations.
+    while (mNeedAnotherIteration)
+    {
+        mNeedAnotherIteration = false;
+        root->traverse(this);
+        updateTree();
+    }
+}
+
 }  // namespace
 
-void RemovePow(TIntermNode *root)
+void RemovePow(TIntermBlock *root)
 {
     RemovePowTraverser traverser;
-    // Iterate as necessary, and reset the traverser between iterations.
-    do
-    {
-        traverser.nextIteration();
-        root->traverse(&traverser);
-        traverser.updateTree();
-    } while (traverser.needAnotherIteration());
+    traverser.run(root);
+}
+
+std::unique_ptr<TTraversalPass> CreateRemovePowPass()
+{
+    return std::unique_ptr<TTraversalPass>(new RemovePowTraverser());
 }
 
 }  // namespace sh
@@ -11,11 +11,15 @@
 #ifndef COMPILER_TRANSLATOR_REMOVEPOW_H_
 #define COMPILER_TRANSLATOR_REMOVEPOW_H_
 
+#include <memory>
+
 namespace sh
 {
-class TIntermNode;
+class TIntermBlock;
+class TTraversalPass;
 
-void RemovePow(TIntermNode *root);
+void RemovePow(TIntermBlock *root);
+std::unique_ptr<TTraversalPass> CreateRemovePowPass();
 }  // namespace sh
 
 #endif  // COMPILER_TRANSLATOR_REMOVEPOW_H_
@@ -10,6 +10,7 @@
 #include "compiler/translator/RewriteDoWhile.h"
 
 #include "compiler/translator/IntermNode.h"
+#include "compiler/translator/PassManager.h"
 
 namespace sh
 {
@@ -41,10 +42,14 @@ namespace
 // TODO(cwallez) when UnfoldShortCircuitIntoIf handles loops correctly, revisit this as we might
 // be able to use while (temp || CONDITION) with temp initially set to true then run
 // UnfoldShortCircuitIntoIf
-class DoWhileRewriter : public TIntermTraverser
+class DoWhileRewriter : public TTraversalPass
 {
   public:
-    DoWhileRewriter() : TIntermTraverser(true, false, false) {}
+    DoWhileRewriter(unsigned int *temporaryIndex) : TTraversalPass(TreeEdits::DURING_TRAVERSAL)
+    {
+        ASSERT(temporaryIndex != 0);
+        useTemporaryIndex(temporaryIndex);
+    }
 
     bool visitBlock(Visit, TIntermBlock *node) override
     {
@@ -146,14 +151,15 @@ class DoWhileRewriter : public TIntermTraverser
 
 }  // anonymous namespace
 
-void RewriteDoWhile(TIntermNode *root, unsigned int *temporaryIndex)
+void RewriteDoWhile(TIntermBlock *root, unsigned int *temporaryIndex)
 {
-    ASSERT(temporaryIndex != 0);
-
-    DoWhileRewriter rewriter;
-    rewriter.useTemporaryIndex(temporaryIndex);
+    DoWhileRewriter rewriter(temporaryIndex);
+    rewriter.run(root);
+}
 
-    root->traverse(&rewriter);
+std::unique_ptr<TTraversalPass> CreateRewriteDoWhilePass(unsigned int *temporaryIndex)
+{
+    return std::unique_ptr<TTraversalPass>(new DoWhileRewriter(temporaryIndex));
 }
 
 }  // namespace sh
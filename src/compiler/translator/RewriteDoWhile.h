@@ -10,10 +10,14 @@
 #ifndef COMPILER_TRANSLATOR_REWRITEDOWHILE_H_
 #define COMPILER_TRANSLATOR_REWRITEDOWHILE_H_
 
+#include <memory>
+
 namespace sh
 {
-class TIntermNode;
-void RewriteDoWhile(TIntermNode *root, unsigned int *temporaryIndex);
+class TIntermBlock;
+class TTraversalPass;
+void RewriteDoWhile(TIntermBlock *root, unsigned int *temporaryIndex);
+std::unique_ptr<TTraversalPass> CreateRewriteDoWhilePass(unsigned int *temporaryIndex);
 }  // namespace sh
 
 #endif  // COMPILER_TRANSLATOR_REWRITEDOWHILE_H_
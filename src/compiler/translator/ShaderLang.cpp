@@ -388,6 +388,28 @@ int GetVertexShaderNumViews(const ShHandle handle)
     return compiler->getNumViews();
 }
 
+const std::vector<PassTiming> *GetPassTimings(const ShHandle handle)
+{
+    TCompiler *compiler = GetCompilerFromHandle(handle);
+    if (!compiler)
+    {
+        return nullptr;
+    }
+
+    return &compiler->getPassTimings();
+}
+
+size_t GetPeakPoolAllocatorBytes(const ShHandle handle)
+{
+    TCompiler *compiler = GetCompilerFromHandle(handle);
+    if (!compiler)
+    {
+        return 0;
+    }
+
+    return compiler->getPeakPoolAllocatorBytes();
+}
+
 bool CheckVariablesWithinPackingLimits(int maxVectors, const std::vector<ShaderVariable> &variables)
 {
     VariablePacker packer;
@@ -31,7 +31,7 @@ static const char kFunctionMangledNameSeparator = '(';
 
 }  // anonymous namespace
 
-int TSymbolTable::uniqueIdCounter = 0;
+std::atomic<int> TSymbolTable::uniqueIdCounter(0);
 
 TSymbolUniqueId::TSymbolUniqueId() : mId(TSymbolTable::nextUniqueId())
 {
@@ -134,6 +134,28 @@ TSymbol *TSymbolTableLevel::find(const TString &name) const
         return (*it).second;
 }
 
+void TSymbolTableLevel::realizeSymbols() const
+{
+    for (const auto &entry : level)
+    {
+        const TSymbol *symbol = entry.second;
+        if (symbol->isVariable())
+        {
+            static_cast<const TVariable *>(symbol)->getType().realize();
+        }
+        else if (symbol->isFunction())
+        {
+            const TFunction *function = static_cast<const TFunction *>(symbol);
+            function->getMangledName();
+            function->getReturnType().realize();
+            for (size_t paramIndex = 0; paramIndex < function->getParamCount(); ++paramIndex)
+            {
+                function->getParam(paramIndex).type->realize();
+            }
+        }
+    }
+}
+
 TSymbol *TSymbolTable::find(const TString &name,
                             int shaderVersion,
                             bool *builtIn,
@@ -194,6 +216,28 @@ TSymbolTable::~TSymbolTable()
         pop();
 }
 
+void TSymbolTable::realizeBuiltIns() const
+{
+    ASSERT(static_cast<ESymbolLevel>(table.size()) > LAST_BUILTIN_LEVEL);
+    for (int level = 0; level <= LAST_BUILTIN_LEVEL; ++level)
+    {
+        table[level]->realizeSymbols();
+    }
+}
+
+void TSymbolTable::pushSharedBuiltInLevels(const TSymbolTable &builtIns)
+{
+    ASSERT(isEmpty());
+    ASSERT(builtIns.currentLevel() == LAST_BUILTIN_LEVEL);
+
+    for (TSymbolTableLevel *level : builtIns.table)
+    {
+        table.push_back(level);
+        precisionStack.push_back(new PrecisionStackLevel);
+    }
+    mSharedLevelCount = table.size();
+}
+
 bool IsGenType(const TType *type)
 {
     if (type)
@@ -497,6 +541,7 @@ TPrecision TSymbolTable::getDefaultPrecision(TBasicType type) const
 void TSymbolTable::insertUnmangledBuiltInName(const char *name, ESymbolLevel level)
 {
     ASSERT(level >= 0 && level < static_cast<ESymbolLevel>(table.size()));
+    ASSERT(static_cast<size_t>(level) >= mSharedLevelCount);
     table[level]->insertUnmangledBuiltInName(std::string(name));
 }
 
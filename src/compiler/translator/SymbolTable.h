@@ -32,6 +32,7 @@
 
 #include <array>
 #include <assert.h>
+#include <atomic>
 #include <set>
 
 #include "common/angleutils.h"
@@ -247,6 +248,10 @@ class TSymbolTableLevel
 
     TSymbol *find(const TString &name) const;
 
+    // Computes the lazily computed members of the symbols in this level and of their types, such as
+    // the mangled names and the sizes of the structures.
+    void realizeSymbols() const;
+
     void addInvariantVarying(const std::string &name) { mInvariantVaryings.insert(name); }
 
     bool isVaryingInvariant(const std::string &name)
@@ -289,7 +294,7 @@ const int GLOBAL_LEVEL       = 4;
 class TSymbolTable : angle::NonCopyable
 {
   public:
-    TSymbolTable()
+    TSymbolTable() : mSharedLevelCount(0)
     {
         // The symbol table cannot be used until push() is called, but
         // the lack of an initial call to push() can be used to detect
@@ -312,19 +317,41 @@ class TSymbolTable : angle::NonCopyable
 
     void pop()
     {
-        delete table.back();
+        // Shared levels are owned by the table they were built in.
+        if (table.size() > mSharedLevelCount)
+        {
+            delete table.back();
+        }
+        else
+        {
+            mSharedLevelCount--;
+        }
         table.pop_back();
 
         delete precisionStack.back();
         precisionStack.pop_back();
     }
 
+    // Builds everything the built-in symbols would otherwise compute lazily on first use. Must be
+    // called with the allocator the built-ins were created with before the table is shared.
+    void realizeBuiltIns() const;
+
+    // Uses the built-in levels of |builtIns| as the built-in levels of this table instead of
+    // inserting the built-ins again. |builtIns| must outlive this table, and the shared levels are
+    // never modified through it.
+    void pushSharedBuiltInLevels(const TSymbolTable &builtIns);
+
     bool declare(TSymbol *symbol) { return insert(currentLevel(), symbol); }
 
-    bool insert(ESymbolLevel level, TSymbol *symbol) { return table[level]->insert(symbol); }
+    bool insert(ESymbolLevel level, TSymbol *symbol)
+    {
+        ASSERT(static_cast<size_t>(level) >= mSharedLevelCount);
+        return table[level]->insert(symbol);
+    }
 
     bool insert(ESymbolLevel level, const char *ext, TSymbol *symbol)
     {
+        ASSERT(static_cast<size_t>(level) >= mSharedLevelCount);
         symbol->relateToExtension(ext);
         return table[level]->insert(symbol);
     }
@@ -487,6 +514,8 @@ class TSymbolTable : angle::NonCopyable
         table[currentLevel()]->setGlobalInvariant(invariant);
     }
 
+    // Unique ids are shared by all the compilers of the process, which may compile on different
+    // threads.
     static int nextUniqueId() { return ++uniqueIdCounter; }
 
     // Checks whether there is a built-in accessible by a shader with the specified version.
@@ -505,7 +534,10 @@ class TSymbolTable : angle::NonCopyable
     typedef TMap<TBasicType, TPrecision> PrecisionStackLevel;
     std::vector<PrecisionStackLevel *> precisionStack;
 
-    static int uniqueIdCounter;
+    // Number of levels at the bottom of |table| that belong to another symbol table.
+    size_t mSharedLevelCount;
+
+    static std::atomic<int> uniqueIdCounter;
 };
 
 }  // namespace sh
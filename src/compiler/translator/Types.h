@@ -484,8 +484,17 @@ class TType
                                         outputSymbols, outputSymbolsToAPINames);
     }
 
-    // Initializes all lazily-initialized members.
-    void realize() { getMangledName(); }
+    // Initializes all lazily-initialized members, including the ones of the structure, so that
+    // types shared between threads are never written to.
+    void realize() const
+    {
+        getMangledName();
+        if (structure)
+        {
+            structure->objectSize();
+            structure->deepestNesting();
+        }
+    }
 
   private:
     void invalidateMangledName() { mangled = ""; }
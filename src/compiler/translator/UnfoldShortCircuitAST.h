@@ -11,7 +11,7 @@
 #define COMPILER_TRANSLATOR_UNFOLDSHORTCIRCUITAST_H_
 
 #include "common/angleutils.h"
-#include "compiler/translator/IntermNode.h"
+#include "compiler/translator/PassManager.h"
 
 namespace sh
 {
@@ -20,10 +20,10 @@ namespace sh
 // be replaced, and creates the corresponding replacement nodes. However,
 // the actual replacements happen after the traverse through updateTree().
 
-class UnfoldShortCircuitAST : public TIntermTraverser
+class UnfoldShortCircuitAST : public TTraversalPass
 {
   public:
-    UnfoldShortCircuitAST() : TIntermTraverser(true, false, false) {}
+    UnfoldShortCircuitAST() : TTraversalPass(TreeEdits::AFTER_TRAVERSAL) {}
 
     bool visitBinary(Visit visit, TIntermBinary *) override;
 };
@@ -0,0 +1,416 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// generatemip.cpp: Defines the vectorized mip generation functions of the common formats.
+
+#include "image_util/generatemip.h"
+
+#include "common/platform.h"
+
+namespace angle
+{
+
+namespace priv
+{
+
+namespace
+{
+
+#if defined(ANGLE_USE_SSE)
+
+// The rows are averaged in chunks of this many bytes, small enough to stay in the L1 cache until
+// their pairs of pixels are averaged.
+constexpr size_t kChunkBytes = 1024;
+
+// gl::average rounds the average of unsigned bytes down, and _mm_avg_epu8 rounds it up, so the
+// odd sums are corrected by one.
+inline __m128i AverageUNorm8(__m128i a, __m128i b)
+{
+    const __m128i oddSums = _mm_and_si128(_mm_xor_si128(a, b), _mm_set1_epi8(1));
+    return _mm_sub_epi8(_mm_avg_epu8(a, b), oddSums);
+}
+
+// Splits the pixels of |lo| and |hi| into the even and the odd ones.
+template <size_t PixelBytes>
+inline void Deinterleave(__m128i lo, __m128i hi, __m128i *even, __m128i *odd);
+
+template <>
+inline void Deinterleave<1>(__m128i lo, __m128i hi, __m128i *even, __m128i *odd)
+{
+    const __m128i lowByteMask = _mm_set1_epi16(0x00FF);
+    *even = _mm_packus_epi16(_mm_and_si128(lo, lowByteMask), _mm_and_si128(hi, lowByteMask));
+    *odd  = _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+}
+
+template <>
+inline void Deinterleave<2>(__m128i lo, __m128i hi, __m128i *even, __m128i *odd)
+{
+    // Sign extended 16-bit values pack back to themselves.
+    *even = _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(lo, 16), 16),
+                            _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16));
+    *odd = _mm_packs_epi32(_mm_srai_epi32(lo, 16), _mm_srai_epi32(hi, 16));
+}
+
+template <>
+inline void Deinterleave<4>(__m128i lo, __m128i hi, __m128i *even, __m128i *odd)
+{
+    // The shuffles move the pixels without interpreting them as floats.
+    const __m128 loFloats = _mm_castsi128_ps(lo);
+    const __m128 hiFloats = _mm_castsi128_ps(hi);
+    *even = _mm_castps_si128(_mm_shuffle_ps(loFloats, hiFloats, _MM_SHUFFLE(2, 0, 2, 0)));
+    *odd  = _mm_castps_si128(_mm_shuffle_ps(loFloats, hiFloats, _MM_SHUFFLE(3, 1, 3, 1)));
+}
+
+// Converts the half floats in the low 16 bits of each lane to floats, the way
+// gl::float16ToFloat32 does.
+inline __m128 HalfToFloat(__m128i halves)
+{
+    const __m128i exponentMask = _mm_set1_epi32(0x0F800000);
+    const __m128i rebias       = _mm_set1_epi32(112 << 23);
+
+    const __m128i magnitude = _mm_slli_epi32(_mm_and_si128(halves, _mm_set1_epi32(0x7FFF)), 13);
+    const __m128i exponent  = _mm_and_si128(magnitude, exponentMask);
+
+    // Rebias the exponent from 15 to 127, and move the infinities and NaNs to the largest one.
+    __m128i bits           = _mm_add_epi32(magnitude, rebias);
+    const __m128i infOrNaN = _mm_cmpeq_epi32(exponent, exponentMask);
+    bits                   = _mm_add_epi32(bits, _mm_and_si128(infOrNaN, rebias));
+
+    // The denormals are normalized by making them 2^-14 too large, and subtracting 2^-14.
+    const __m128i denormal = _mm_cmpeq_epi32(exponent, _mm_setzero_si128());
+    const __m128 normalized =
+        _mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(bits, _mm_set1_epi32(1 << 23))),
+                   _mm_castsi128_ps(_mm_set1_epi32(113 << 23)));
+    bits = _mm_or_si128(_mm_andnot_si128(denormal, bits),
+                        _mm_and_si128(denormal, _mm_castps_si128(normalized)));
+
+    const __m128i sign = _mm_slli_epi32(_mm_and_si128(halves, _mm_set1_epi32(0x8000)), 16);
+    return _mm_castsi128_ps(_mm_or_si128(bits, sign));
+}
+
+// Converts floats to half floats in the low 16 bits of each lane, the way gl::float32ToFloat16
+// does.
+inline __m128i FloatToHalf(__m128 floats)
+{
+    const __m128i bits = _mm_castps_si128(floats);
+    const __m128i sign = _mm_srli_epi32(_mm_and_si128(bits, _mm_set1_epi32(0x80000000)), 16);
+    const __m128i abs  = _mm_and_si128(bits, _mm_set1_epi32(0x7FFFFFFF));
+    const __m128i one  = _mm_set1_epi32(1);
+
+    const __m128i roundedNormal = _mm_add_epi32(_mm_add_epi32(abs, _mm_set1_epi32(0xC8000FFF)),
+                                                _mm_and_si128(_mm_srli_epi32(abs, 13), one));
+    const __m128i normal = _mm_srli_epi32(roundedNormal, 13);
+
+    // The mantissas of the denormals are shifted right by 113 minus their exponent. Lanes can't
+    // be shifted by different amounts, but the mantissas fit in a float and can be scaled down by
+    // a power of two and truncated instead.
+    const __m128i mantissa = _mm_or_si128(_mm_and_si128(abs, _mm_set1_epi32(0x007FFFFF)),
+                                          _mm_set1_epi32(0x00800000));
+    const __m128i scale =
+        _mm_slli_epi32(_mm_add_epi32(_mm_srli_epi32(abs, 23), _mm_set1_epi32(14)), 23);
+    const __m128i shifted =
+        _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(mantissa), _mm_castsi128_ps(scale)));
+    const __m128i roundedDenormal =
+        _mm_add_epi32(_mm_add_epi32(shifted, _mm_set1_epi32(0x00000FFF)),
+                      _mm_and_si128(_mm_srli_epi32(shifted, 13), one));
+    const __m128i denormal = _mm_srli_epi32(roundedDenormal, 13);
+
+    const __m128i isInfinity = _mm_cmpgt_epi32(abs, _mm_set1_epi32(0x47FFEFFF));
+    const __m128i isDenormal = _mm_cmplt_epi32(abs, _mm_set1_epi32(0x38800000));
+    __m128i halves = _mm_or_si128(_mm_andnot_si128(isDenormal, normal),
+                                  _mm_and_si128(isDenormal, denormal));
+    halves = _mm_or_si128(_mm_andnot_si128(isInfinity, halves),
+                          _mm_and_si128(isInfinity, _mm_set1_epi32(0x7FFF)));
+    return _mm_or_si128(halves, sign);
+}
+
+// Packs the low 16 bits of the lanes of |lo| and |hi|.
+inline __m128i PackHalves(__m128i lo, __m128i hi)
+{
+    return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(lo, 16), 16),
+                           _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16));
+}
+
+inline __m128 AverageFloats(__m128 a, __m128 b)
+{
+    return _mm_mul_ps(_mm_add_ps(a, b), _mm_set1_ps(0.5f));
+}
+
+inline __m128i AverageHalves(__m128i a, __m128i b)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 lo    = AverageFloats(HalfToFloat(_mm_unpacklo_epi16(a, zero)),
+                                       HalfToFloat(_mm_unpacklo_epi16(b, zero)));
+    const __m128 hi    = AverageFloats(HalfToFloat(_mm_unpackhi_epi16(a, zero)),
+                                       HalfToFloat(_mm_unpackhi_epi16(b, zero)));
+    return PackHalves(FloatToHalf(lo), FloatToHalf(hi));
+}
+
+inline __m128i Load(const void *source)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+}
+
+inline void Store(void *dest, __m128i value)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dest), value);
+}
+
+// The kernels average two rows pixel by pixel, and the pairs of pixels of a row. They return how
+// many pixels they wrote, and T::average writes the rest.
+
+// Formats of unsigned normalized bytes, averaged byte by byte.
+template <typename T>
+struct UNorm8Kernel
+{
+    static size_t AverageRows(uint8_t *dest, const uint8_t *a, const uint8_t *b, size_t count)
+    {
+        const size_t bytes = count * sizeof(T);
+        size_t offset      = 0;
+        for (; offset + 16 <= bytes; offset += 16)
+        {
+            Store(dest + offset, AverageUNorm8(Load(a + offset), Load(b + offset)));
+        }
+        return offset / sizeof(T);
+    }
+
+    static size_t AveragePairs(uint8_t *dest, const uint8_t *source, size_t count)
+    {
+        const size_t bytes = count * sizeof(T);
+        size_t offset      = 0;
+        for (; offset + 16 <= bytes; offset += 16)
+        {
+            __m128i even, odd;
+            Deinterleave<sizeof(T)>(Load(source + 2 * offset), Load(source + 2 * offset + 16),
+                                    &even, &odd);
+            Store(dest + offset, AverageUNorm8(even, odd));
+        }
+        return offset / sizeof(T);
+    }
+};
+
+struct R16G16B16A16FKernel
+{
+    static size_t AverageRows(uint8_t *dest, const uint8_t *a, const uint8_t *b, size_t count)
+    {
+        size_t x = 0;
+        for (; x + 2 <= count; x += 2)
+        {
+            Store(dest + 8 * x, AverageHalves(Load(a + 8 * x), Load(b + 8 * x)));
+        }
+        return x;
+    }
+
+    static size_t AveragePairs(uint8_t *dest, const uint8_t *source, size_t count)
+    {
+        size_t x = 0;
+        for (; x + 2 <= count; x += 2)
+        {
+            // Each pair of pixels is the low and the high half of a vector.
+            const __m128i pair0 = Load(source + 16 * x);
+            const __m128i pair1 = Load(source + 16 * x + 16);
+            Store(dest + 8 * x, AverageHalves(_mm_unpacklo_epi64(pair0, pair1),
+                                              _mm_unpackhi_epi64(pair0, pair1)));
+        }
+        return x;
+    }
+};
+
+struct R32G32B32A32FKernel
+{
+    // A pixel is a vector.
+    static __m128 LoadPixel(const uint8_t *source)
+    {
+        return _mm_loadu_ps(reinterpret_cast<const float *>(source));
+    }
+
+    static size_t AverageRows(uint8_t *dest, const uint8_t *a, const uint8_t *b, size_t count)
+    {
+        for (size_t x = 0; x < count; ++x)
+        {
+            _mm_storeu_ps(reinterpret_cast<float *>(dest + 16 * x),
+                          AverageFloats(LoadPixel(a + 16 * x), LoadPixel(b + 16 * x)));
+        }
+        return count;
+    }
+
+    static size_t AveragePairs(uint8_t *dest, const uint8_t *source, size_t count)
+    {
+        for (size_t x = 0; x < count; ++x)
+        {
+            const __m128 average =
+                AverageFloats(LoadPixel(source + 32 * x), LoadPixel(source + 32 * x + 16));
+            _mm_storeu_ps(reinterpret_cast<float *>(dest + 16 * x), average);
+        }
+        return count;
+    }
+};
+
+template <typename T, typename Kernel>
+void AverageRows(T *dest, const T *a, const T *b, size_t count)
+{
+    size_t x = Kernel::AverageRows(reinterpret_cast<uint8_t *>(dest),
+                                   reinterpret_cast<const uint8_t *>(a),
+                                   reinterpret_cast<const uint8_t *>(b), count);
+    for (; x < count; ++x)
+    {
+        T::average(&dest[x], &a[x], &b[x]);
+    }
+}
+
+template <typename T, typename Kernel>
+void AveragePairs(T *dest, const T *source, size_t count)
+{
+    size_t x = Kernel::AveragePairs(reinterpret_cast<uint8_t *>(dest),
+                                    reinterpret_cast<const uint8_t *>(source), count);
+    for (; x < count; ++x)
+    {
+        T::average(&dest[x], &source[2 * x], &source[2 * x + 1]);
+    }
+}
+
+// Generates the mips of the images wider than one pixel, in the same order of averages as the
+// templates: through the depth, then the height, then the width.
+template <typename T, typename Kernel>
+void GenerateMipSSE2(size_t sourceWidth,
+                     size_t sourceHeight,
+                     size_t sourceDepth,
+                     const uint8_t *sourceData,
+                     size_t sourceRowPitch,
+                     size_t sourceDepthPitch,
+                     size_t destWidth,
+                     size_t destHeight,
+                     size_t destDepth,
+                     uint8_t *destData,
+                     size_t destRowPitch,
+                     size_t destDepthPitch)
+{
+    ASSERT(sourceWidth > 1);
+
+    constexpr size_t kChunkPixels = kChunkBytes / sizeof(T);
+    T chunks[2][kChunkPixels];
+
+    const size_t rowsPerY = sourceHeight > 1 ? 2 : 1;
+    const size_t rowsPerZ = sourceDepth > 1 ? 2 : 1;
+
+    for (size_t z = 0; z < destDepth; z++)
+    {
+        for (size_t y = 0; y < destHeight; y++)
+        {
+            const T *rows[4];
+            size_t rowCount = 0;
+            for (size_t sourceY = y * rowsPerY; sourceY < (y + 1) * rowsPerY; sourceY++)
+            {
+                for (size_t sourceZ = z * rowsPerZ; sourceZ < (z + 1) * rowsPerZ; sourceZ++)
+                {
+                    rows[rowCount++] = GetPixel<T>(sourceData, 0, sourceY, sourceZ,
+                                                   sourceRowPitch, sourceDepthPitch);
+                }
+            }
+            T *dest = GetPixel<T>(destData, 0, y, z, destRowPitch, destDepthPitch);
+
+            for (size_t x = 0; x < destWidth; x += kChunkPixels / 2)
+            {
+                const size_t count       = std::min(kChunkPixels / 2, destWidth - x);
+                const size_t sourceX     = x * 2;
+                const size_t sourceCount = count * 2;
+
+                const T *averagedRows = rows[0] + sourceX;
+                if (rowCount > 1)
+                {
+                    AverageRows<T, Kernel>(chunks[0], rows[0] + sourceX, rows[1] + sourceX,
+                                           sourceCount);
+                    if (rowCount > 2)
+                    {
+                        AverageRows<T, Kernel>(chunks[1], rows[2] + sourceX, rows[3] + sourceX,
+                                               sourceCount);
+                        AverageRows<T, Kernel>(chunks[0], chunks[0], chunks[1], sourceCount);
+                    }
+                    averagedRows = chunks[0];
+                }
+
+                AveragePairs<T, Kernel>(dest + x, averagedRows, count);
+            }
+        }
+    }
+}
+
+#else
+
+// The kernels are only named without SSE, by GetSSE2MipGenerationFunction which returns NULL.
+template <typename T>
+struct UNorm8Kernel;
+struct R16G16B16A16FKernel;
+struct R32G32B32A32FKernel;
+
+#endif  // defined(ANGLE_USE_SSE)
+
+template <typename T, typename Kernel>
+MipGenerationFunction GetSSE2MipGenerationFunction(size_t sourceWidth)
+{
+#if defined(ANGLE_USE_SSE)
+    // The images one pixel wide have nothing to vectorize along their rows.
+    if (sourceWidth > 1 && gl::supportsSSE2())
+    {
+        return GenerateMipSSE2<T, Kernel>;
+    }
+#endif  // defined(ANGLE_USE_SSE)
+    return NULL;
+}
+
+}  // anonymous namespace
+
+template <>
+MipGenerationFunction GetSIMDMipGenerationFunction<R8>(size_t sourceWidth,
+                                                       size_t sourceHeight,
+                                                       size_t sourceDepth)
+{
+    return GetSSE2MipGenerationFunction<R8, UNorm8Kernel<R8>>(sourceWidth);
+}
+
+template <>
+MipGenerationFunction GetSIMDMipGenerationFunction<R8G8>(size_t sourceWidth,
+                                                         size_t sourceHeight,
+                                                         size_t sourceDepth)
+{
+    return GetSSE2MipGenerationFunction<R8G8, UNorm8Kernel<R8G8>>(sourceWidth);
+}
+
+template <>
+MipGenerationFunction GetSIMDMipGenerationFunction<R8G8B8A8>(size_t sourceWidth,
+                                                             size_t sourceHeight,
+                                                             size_t sourceDepth)
+{
+    return GetSSE2MipGenerationFunction<R8G8B8A8, UNorm8Kernel<R8G8B8A8>>(sourceWidth);
+}
+
+template <>
+MipGenerationFunction GetSIMDMipGenerationFunction<B8G8R8A8>(size_t sourceWidth,
+                                                             size_t sourceHeight,
+                                                             size_t sourceDepth)
+{
+    return GetSSE2MipGenerationFunction<B8G8R8A8, UNorm8Kernel<B8G8R8A8>>(sourceWidth);
+}
+
+template <>
+MipGenerationFunction GetSIMDMipGenerationFunction<R16G16B16A16F>(size_t sourceWidth,
+                                                                  size_t sourceHeight,
+                                                                  size_t sourceDepth)
+{
+    return GetSSE2MipGenerationFunction<R16G16B16A16F, R16G16B16A16FKernel>(sourceWidth);
+}
+
+template <>
+MipGenerationFunction GetSIMDMipGenerationFunction<R32G32B32A32F>(size_t sourceWidth,
+                                                                  size_t sourceHeight,
+                                                                  size_t sourceDepth)
+{
+    return GetSSE2MipGenerationFunction<R32G32B32A32F, R32G32B32A32FKernel>(sourceWidth);
+}
+
+}  // namespace priv
+
+}  // namespace angle
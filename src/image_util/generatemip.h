@@ -27,6 +27,18 @@ inline void GenerateMip(size_t sourceWidth,
                         size_t destRowPitch,
                         size_t destDepthPitch);
 
+// Generates the levels 1 to |levelCount| - 1 of a mip chain from its level 0. The pixels of each
+// level are at |levelData[level]| with the pitches |rowPitches[level]| and |depthPitches[level]|.
+// 2D images are generated in a single pass over level 0.
+template <typename T>
+inline void GenerateMipChain(size_t width,
+                             size_t height,
+                             size_t depth,
+                             size_t levelCount,
+                             uint8_t *const *levelData,
+                             const size_t *rowPitches,
+                             const size_t *depthPitches);
+
 }  // namespace angle
 
 #include "generatemip.inl"
@@ -7,6 +7,9 @@
 // generatemip.inl: Defines the GenerateMip function, templated on the format
 // type of the image for which mip levels are being generated.
 
+#include <algorithm>
+#include <vector>
+
 #include "common/mathutil.h"
 
 #include "image_util/imageformats.h"
@@ -224,6 +227,28 @@ typedef void (*MipGenerationFunction)(size_t sourceWidth, size_t sourceHeight, s
                                       size_t destWidth, size_t destHeight, size_t destDepth,
                                       uint8_t *destData, size_t destRowPitch, size_t destDepthPitch);
 
+// Returns a vectorized mip generation function for the formats that have one, or NULL when the
+// format, the size of the image or the CPU isn't supported. The formats with one specialize this
+// in generatemip.cpp, and their functions are bit-exact with the templates above.
+template <typename T>
+inline MipGenerationFunction GetSIMDMipGenerationFunction(size_t sourceWidth, size_t sourceHeight, size_t sourceDepth)
+{
+    return NULL;
+}
+
+template <>
+MipGenerationFunction GetSIMDMipGenerationFunction<R8>(size_t sourceWidth, size_t sourceHeight, size_t sourceDepth);
+template <>
+MipGenerationFunction GetSIMDMipGenerationFunction<R8G8>(size_t sourceWidth, size_t sourceHeight, size_t sourceDepth);
+template <>
+MipGenerationFunction GetSIMDMipGenerationFunction<R8G8B8A8>(size_t sourceWidth, size_t sourceHeight, size_t sourceDepth);
+template <>
+MipGenerationFunction GetSIMDMipGenerationFunction<B8G8R8A8>(size_t sourceWidth, size_t sourceHeight, size_t sourceDepth);
+template <>
+MipGenerationFunction GetSIMDMipGenerationFunction<R16G16B16A16F>(size_t sourceWidth, size_t sourceHeight, size_t sourceDepth);
+template <>
+MipGenerationFunction GetSIMDMipGenerationFunction<R32G32B32A32F>(size_t sourceWidth, size_t sourceHeight, size_t sourceDepth);
+
 template <typename T>
 static MipGenerationFunction GetMipGenerationFunction(size_t sourceWidth, size_t sourceHeight, size_t sourceDepth)
 {
@@ -258,11 +283,68 @@ inline void GenerateMip(size_t sourceWidth, size_t sourceHeight, size_t sourceDe
     size_t mipHeight = std::max<size_t>(1, sourceHeight >> 1);
     size_t mipDepth = std::max<size_t>(1, sourceDepth >> 1);
 
-    priv::MipGenerationFunction generationFunction = priv::GetMipGenerationFunction<T>(sourceWidth, sourceHeight, sourceDepth);
+    priv::MipGenerationFunction generationFunction = priv::GetSIMDMipGenerationFunction<T>(sourceWidth, sourceHeight, sourceDepth);
+    if (generationFunction == NULL)
+    {
+        generationFunction = priv::GetMipGenerationFunction<T>(sourceWidth, sourceHeight, sourceDepth);
+    }
     ASSERT(generationFunction != NULL);
 
     generationFunction(sourceWidth, sourceHeight, sourceDepth, sourceData, sourceRowPitch, sourceDepthPitch,
                        mipWidth, mipHeight, mipDepth, destData, destRowPitch, destDepthPitch);
 }
 
+template <typename T>
+inline void GenerateMipChain(size_t width, size_t height, size_t depth, size_t levelCount,
+                             uint8_t *const *levelData, const size_t *rowPitches, const size_t *depthPitches)
+{
+    ASSERT(levelCount > 0);
+    ASSERT(std::max(std::max(width, height), depth) >> (levelCount - 1) >= 1);
+
+    // 3D images are generated a level at a time.
+    if (depth > 1)
+    {
+        for (size_t level = 1; level < levelCount; level++)
+        {
+            GenerateMip<T>(std::max<size_t>(1, width >> (level - 1)), std::max<size_t>(1, height >> (level - 1)),
+                           std::max<size_t>(1, depth >> (level - 1)), levelData[level - 1], rowPitches[level - 1],
+                           depthPitches[level - 1], levelData[level], rowPitches[level], depthPitches[level]);
+        }
+        return;
+    }
+
+    // Each row of a 2D image is generated as soon as the rows it averages are, while they are
+    // still in the cache, so that the image is read from memory once for the whole chain.
+    // rowsDone[level] counts the rows of the level generated so far.
+    std::vector<size_t> rowsDone(levelCount, 0);
+    rowsDone[0] = height;
+
+    const size_t firstLevelHeight = std::max<size_t>(1, height >> 1);
+    for (size_t row = 0; row < firstLevelHeight; row++)
+    {
+        for (size_t level = 1; level < levelCount; level++)
+        {
+            const size_t sourceWidth  = std::max<size_t>(1, width >> (level - 1));
+            const size_t sourceHeight = std::max<size_t>(1, height >> (level - 1));
+            const size_t destRow      = rowsDone[level];
+
+            // Stop at the first level that has all its rows, or that still waits for a row of the
+            // level above.
+            const size_t bandHeight = std::min<size_t>(sourceHeight, 2);
+            if (destRow >= std::max<size_t>(1, sourceHeight >> 1) ||
+                rowsDone[level - 1] < destRow * 2 + bandHeight)
+            {
+                break;
+            }
+
+            GenerateMip<T>(sourceWidth, bandHeight, 1,
+                           levelData[level - 1] + destRow * 2 * rowPitches[level - 1],
+                           rowPitches[level - 1], depthPitches[level - 1],
+                           levelData[level] + destRow * rowPitches[level], rowPitches[level],
+                           depthPitches[level]);
+            rowsDone[level]++;
+        }
+    }
+}
+
 }  // namespace angle
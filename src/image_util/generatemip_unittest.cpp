@@ -0,0 +1,347 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// generatemip_unittest.cpp: Unit tests for the mip generation functions. The formats with
+// vectorized functions are checked against the templates, for every combination of dimensions,
+// odd sizes and rows longer than the chunks the vectorized functions work in.
+//
+
+#include "image_util/generatemip.h"
+
+#include <string.h>
+#include <ostream>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace angle;
+
+namespace
+{
+
+using GenerateMipFunction = void (*)(size_t sourceWidth,
+                                     size_t sourceHeight,
+                                     size_t sourceDepth,
+                                     const uint8_t *sourceData,
+                                     size_t sourceRowPitch,
+                                     size_t sourceDepthPitch,
+                                     uint8_t *destData,
+                                     size_t destRowPitch,
+                                     size_t destDepthPitch);
+
+using GenerateMipChainFunction = void (*)(size_t width,
+                                          size_t height,
+                                          size_t depth,
+                                          size_t levelCount,
+                                          uint8_t *const *levelData,
+                                          const size_t *rowPitches,
+                                          const size_t *depthPitches);
+
+// Generates a mip with the templates, without the vectorized functions.
+template <typename T>
+void GenerateMipReference(size_t sourceWidth,
+                          size_t sourceHeight,
+                          size_t sourceDepth,
+                          const uint8_t *sourceData,
+                          size_t sourceRowPitch,
+                          size_t sourceDepthPitch,
+                          uint8_t *destData,
+                          size_t destRowPitch,
+                          size_t destDepthPitch)
+{
+    priv::MipGenerationFunction generationFunction =
+        priv::GetMipGenerationFunction<T>(sourceWidth, sourceHeight, sourceDepth);
+    generationFunction(sourceWidth, sourceHeight, sourceDepth, sourceData, sourceRowPitch,
+                       sourceDepthPitch, std::max<size_t>(1, sourceWidth >> 1),
+                       std::max<size_t>(1, sourceHeight >> 1),
+                       std::max<size_t>(1, sourceDepth >> 1), destData, destRowPitch,
+                       destDepthPitch);
+}
+
+// Random pixels. The float pixels have no NaNs, whose payloads can come out of either operand of a
+// sum.
+void RandomUNorm8(std::mt19937 *generator, uint8_t *pixel, size_t pixelBytes)
+{
+    for (size_t byte = 0; byte < pixelBytes; ++byte)
+    {
+        pixel[byte] = static_cast<uint8_t>((*generator)());
+    }
+}
+
+void RandomHalfFloats(std::mt19937 *generator, uint8_t *pixel, size_t pixelBytes)
+{
+    for (size_t channel = 0; channel < pixelBytes / 2; ++channel)
+    {
+        uint16_t value;
+        do
+        {
+            value = static_cast<uint16_t>((*generator)());
+        } while ((value & 0x7C00) == 0x7C00 && (value & 0x03FF) != 0);
+        memcpy(pixel + 2 * channel, &value, sizeof(value));
+    }
+}
+
+void RandomFloats(std::mt19937 *generator, uint8_t *pixel, size_t pixelBytes)
+{
+    for (size_t channel = 0; channel < pixelBytes / 4; ++channel)
+    {
+        uint32_t value;
+        do
+        {
+            value = (*generator)();
+        } while ((value & 0x7F800000) == 0x7F800000 && (value & 0x007FFFFF) != 0);
+        memcpy(pixel + 4 * channel, &value, sizeof(value));
+    }
+}
+
+struct GenerateMipParams
+{
+    const char *name;
+    GenerateMipFunction generateMip;
+    GenerateMipFunction generateMipReference;
+    GenerateMipChainFunction generateMipChain;
+    void (*randomPixel)(std::mt19937 *generator, uint8_t *pixel, size_t pixelBytes);
+    size_t pixelBytes;
+};
+
+std::ostream &operator<<(std::ostream &os, const GenerateMipParams &params)
+{
+    return os << params.name;
+}
+
+template <typename T>
+GenerateMipParams MipParams(const char *name,
+                            void (*randomPixel)(std::mt19937 *, uint8_t *, size_t))
+{
+    return GenerateMipParams{name, GenerateMip<T>, GenerateMipReference<T>, GenerateMipChain<T>,
+                             randomPixel, sizeof(T)};
+}
+
+// The pitches of an image with padded rows and slices.
+struct ImageLayout
+{
+    ImageLayout(size_t width, size_t height, size_t depth, size_t pixelBytes)
+        : rowPitch(width * pixelBytes + 12),
+          depthPitch(rowPitch * height + 8),
+          size(depthPitch * depth)
+    {
+    }
+
+    size_t rowPitch;
+    size_t depthPitch;
+    size_t size;
+};
+
+class GenerateMipTest : public testing::TestWithParam<GenerateMipParams>
+{
+  protected:
+    std::vector<uint8_t> randomImage(size_t width, size_t height, size_t depth);
+
+    // Generates a mip of a random image with the vectorized function and with the templates, and
+    // checks they are the same.
+    void checkMip(size_t width, size_t height, size_t depth);
+
+    // Generates a mip chain of a random image in one call, and checks it is the same as the one
+    // generated a level at a time.
+    void checkMipChain(size_t width, size_t height, size_t depth, size_t levelCount);
+
+    std::mt19937 mGenerator;
+};
+
+std::vector<uint8_t> GenerateMipTest::randomImage(size_t width, size_t height, size_t depth)
+{
+    const GenerateMipParams &params = GetParam();
+    ImageLayout layout(width, height, depth, params.pixelBytes);
+
+    // The padding is random too, none of it is averaged.
+    std::vector<uint8_t> image(layout.size);
+    for (size_t offset = 0; offset + params.pixelBytes <= image.size();
+         offset += params.pixelBytes)
+    {
+        params.randomPixel(&mGenerator, &image[offset], params.pixelBytes);
+    }
+    return image;
+}
+
+void GenerateMipTest::checkMip(size_t width, size_t height, size_t depth)
+{
+    const GenerateMipParams &params = GetParam();
+
+    ImageLayout sourceLayout(width, height, depth, params.pixelBytes);
+    std::vector<uint8_t> source = randomImage(width, height, depth);
+
+    // The padding of the mip is filled with a value never written, to catch writes past a row.
+    ImageLayout destLayout(std::max<size_t>(1, width >> 1), std::max<size_t>(1, height >> 1),
+                           std::max<size_t>(1, depth >> 1), params.pixelBytes);
+    std::vector<uint8_t> expected(destLayout.size, 0x5A);
+    std::vector<uint8_t> actual(expected);
+
+    params.generateMipReference(width, height, depth, source.data(), sourceLayout.rowPitch,
+                                sourceLayout.depthPitch, expected.data(), destLayout.rowPitch,
+                                destLayout.depthPitch);
+    params.generateMip(width, height, depth, source.data(), sourceLayout.rowPitch,
+                       sourceLayout.depthPitch, actual.data(), destLayout.rowPitch,
+                       destLayout.depthPitch);
+
+    ASSERT_EQ(expected, actual) << params.name << " " << width << "x" << height << "x" << depth;
+}
+
+void GenerateMipTest::checkMipChain(size_t width, size_t height, size_t depth, size_t levelCount)
+{
+    const GenerateMipParams &params = GetParam();
+
+    std::vector<std::vector<uint8_t>> expected;
+    std::vector<size_t> rowPitches;
+    std::vector<size_t> depthPitches;
+    expected.push_back(randomImage(width, height, depth));
+    for (size_t level = 0; level < levelCount; ++level)
+    {
+        ImageLayout layout(std::max<size_t>(1, width >> level),
+                           std::max<size_t>(1, height >> level),
+                           std::max<size_t>(1, depth >> level), params.pixelBytes);
+        rowPitches.push_back(layout.rowPitch);
+        depthPitches.push_back(layout.depthPitch);
+        if (level > 0)
+        {
+            expected.push_back(std::vector<uint8_t>(layout.size, 0x5A));
+            params.generateMip(std::max<size_t>(1, width >> (level - 1)),
+                               std::max<size_t>(1, height >> (level - 1)),
+                               std::max<size_t>(1, depth >> (level - 1)),
+                               expected[level - 1].data(), rowPitches[level - 1],
+                               depthPitches[level - 1], expected[level].data(), rowPitches[level],
+                               depthPitches[level]);
+        }
+    }
+
+    std::vector<std::vector<uint8_t>> actual(expected.size());
+    std::vector<uint8_t *> levelData;
+    actual[0] = expected[0];
+    levelData.push_back(actual[0].data());
+    for (size_t level = 1; level < levelCount; ++level)
+    {
+        actual[level].resize(expected[level].size(), 0x5A);
+        levelData.push_back(actual[level].data());
+    }
+
+    params.generateMipChain(width, height, depth, levelCount, levelData.data(), rowPitches.data(),
+                            depthPitches.data());
+
+    for (size_t level = 1; level < levelCount; ++level)
+    {
+        ASSERT_EQ(expected[level], actual[level]) << params.name << " " << width << "x" << height
+                                                  << "x" << depth << ", level " << level;
+    }
+}
+
+// Every combination of dimensions, with even and odd sizes.
+TEST_P(GenerateMipTest, MatchesTemplates)
+{
+    const size_t sizes[] = {1, 2, 3, 4, 7, 16, 33};
+    for (size_t width : sizes)
+    {
+        for (size_t height : sizes)
+        {
+            for (size_t depth : sizes)
+            {
+                if (width == 1 && height == 1 && depth == 1)
+                {
+                    continue;
+                }
+
+                checkMip(width, height, depth);
+                if (HasFatalFailure())
+                {
+                    return;
+                }
+            }
+        }
+    }
+}
+
+// Rows longer than the chunks the vectorized functions average at once.
+TEST_P(GenerateMipTest, LongRows)
+{
+    for (size_t width = 1020; width < 1030; ++width)
+    {
+        checkMip(width, 3, 1);
+        checkMip(width, 1, 1);
+        checkMip(width, 4, 2);
+        if (HasFatalFailure())
+        {
+            return;
+        }
+    }
+}
+
+// Mip chains of 2D images, including non-square ones whose levels become a row or a column.
+TEST_P(GenerateMipTest, MipChain2D)
+{
+    checkMipChain(64, 64, 1, 7);
+    checkMipChain(300, 201, 1, 9);
+    checkMipChain(1, 37, 1, 6);
+    checkMipChain(37, 1, 1, 6);
+    checkMipChain(1000, 3, 1, 10);
+    checkMipChain(5, 300, 1, 3);
+}
+
+// Mip chains of 3D images, generated a level at a time.
+TEST_P(GenerateMipTest, MipChain3D)
+{
+    checkMipChain(16, 16, 16, 5);
+    checkMipChain(33, 9, 5, 6);
+}
+
+INSTANTIATE_TEST_CASE_P(,
+                        GenerateMipTest,
+                        testing::Values(MipParams<R8>("R8", RandomUNorm8),
+                                        MipParams<R8G8>("R8G8", RandomUNorm8),
+                                        MipParams<R8G8B8A8>("R8G8B8A8", RandomUNorm8),
+                                        MipParams<B8G8R8A8>("B8G8R8A8", RandomUNorm8),
+                                        MipParams<R16G16B16A16F>("R16G16B16A16F",
+                                                                 RandomHalfFloats),
+                                        MipParams<R32G32B32A32F>("R32G32B32A32F", RandomFloats),
+                                        MipParams<R5G6B5>("R5G6B5", RandomUNorm8)));
+
+// Averages every half float with itself, with zero, with one and with a random value, since the
+// vectorized function converts them without the tables of gl::float16ToFloat32.
+TEST(GenerateMipHalfFloatTest, AllValues)
+{
+    std::mt19937 generator;
+    std::vector<uint16_t> source;
+    for (uint32_t value = 0; value < 0x10000; ++value)
+    {
+        const uint16_t half = static_cast<uint16_t>(value);
+        if ((half & 0x7C00) == 0x7C00 && (half & 0x03FF) != 0)
+        {
+            continue;
+        }
+
+        uint16_t randomHalf;
+        RandomHalfFloats(&generator, reinterpret_cast<uint8_t *>(&randomHalf), 2);
+
+        const uint16_t pair[8] = {half, half, half, half, half, 0, 0x3C00, randomHalf};
+        source.insert(source.end(), pair, pair + 8);
+    }
+
+    const size_t width = source.size() / 4;
+    std::vector<uint16_t> expected(width / 2 * 4);
+    std::vector<uint16_t> actual(expected.size());
+    const uint8_t *sourceData = reinterpret_cast<const uint8_t *>(source.data());
+
+    GenerateMipReference<R16G16B16A16F>(width, 1, 1, sourceData, width * 8, width * 8,
+                                        reinterpret_cast<uint8_t *>(expected.data()), width * 4,
+                                        width * 4);
+    GenerateMip<R16G16B16A16F>(width, 1, 1, sourceData, width * 8, width * 8,
+                               reinterpret_cast<uint8_t *>(actual.data()), width * 4, width * 4);
+
+    for (size_t index = 0; index < expected.size(); ++index)
+    {
+        ASSERT_EQ(expected[index], actual[index])
+            << "channel " << index % 4 << " of half " << source[index * 2];
+    }
+}
+
+}  // anonymous namespace
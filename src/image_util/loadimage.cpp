@@ -15,6 +15,178 @@
 namespace angle
 {
 
+namespace
+{
+
+#if defined(ANGLE_USE_SSE)
+
+// The SSE2 row loaders below convert as many pixels of a row as they can, bit-exact with the
+// scalar loops, and return how many they did. The caller converts the rest of the row.
+
+size_t LoadL8ToRGBA8RowSSE2(const uint8_t *source, uint8_t *dest, size_t width)
+{
+    const __m128i alpha = _mm_set1_epi8(-1);
+
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        __m128i luminance = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[x]));
+
+        // Pair each luminance with itself and with the alpha, then interleave the pairs.
+        __m128i lumLumLo   = _mm_unpacklo_epi8(luminance, luminance);
+        __m128i lumLumHi   = _mm_unpackhi_epi8(luminance, luminance);
+        __m128i lumAlphaLo = _mm_unpacklo_epi8(luminance, alpha);
+        __m128i lumAlphaHi = _mm_unpackhi_epi8(luminance, alpha);
+
+        __m128i *destVector = reinterpret_cast<__m128i *>(&dest[4 * x]);
+        _mm_storeu_si128(destVector + 0, _mm_unpacklo_epi16(lumLumLo, lumAlphaLo));
+        _mm_storeu_si128(destVector + 1, _mm_unpackhi_epi16(lumLumLo, lumAlphaLo));
+        _mm_storeu_si128(destVector + 2, _mm_unpacklo_epi16(lumLumHi, lumAlphaHi));
+        _mm_storeu_si128(destVector + 3, _mm_unpackhi_epi16(lumLumHi, lumAlphaHi));
+    }
+    return x;
+}
+
+size_t LoadLA8ToRGBA8RowSSE2(const uint8_t *source, uint8_t *dest, size_t width)
+{
+    const __m128i lowByteMask = _mm_set1_epi16(0x00FF);
+
+    size_t x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        __m128i lumAlpha = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[2 * x]));
+
+        __m128i lum    = _mm_and_si128(lumAlpha, lowByteMask);
+        __m128i lumLum = _mm_or_si128(lum, _mm_slli_epi16(lum, 8));
+
+        __m128i *destVector = reinterpret_cast<__m128i *>(&dest[4 * x]);
+        _mm_storeu_si128(destVector + 0, _mm_unpacklo_epi16(lumLum, lumAlpha));
+        _mm_storeu_si128(destVector + 1, _mm_unpackhi_epi16(lumLum, lumAlpha));
+    }
+    return x;
+}
+
+size_t LoadRGB8ToBGRX8RowSSE2(const uint8_t *source, uint8_t *dest, size_t width)
+{
+    const __m128i greenMask = _mm_set1_epi32(0x0000FF00);
+    const __m128i redMask   = _mm_set1_epi32(0x00FF0000);
+    const __m128i blueMask  = _mm_set1_epi32(0x000000FF);
+    const __m128i alpha     = _mm_set1_epi32(static_cast<int>(0xFF000000));
+
+    // Four pixels are converted at a time, but the load reads sixteen bytes, which is past the
+    // fourth pixel. Stop early enough to stay in the row.
+    size_t x = 0;
+    for (; x + 6 <= width; x += 4)
+    {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[3 * x]));
+
+        // Move the pixels to the start of their 32-bit lanes. The top byte of each lane is
+        // garbage until the alpha is written.
+        __m128i pixels01 = _mm_unpacklo_epi32(pixels, _mm_srli_si128(pixels, 3));
+        __m128i pixels23 =
+            _mm_unpacklo_epi32(_mm_srli_si128(pixels, 6), _mm_srli_si128(pixels, 9));
+        __m128i rgbx = _mm_unpacklo_epi64(pixels01, pixels23);
+
+        __m128i green = _mm_and_si128(rgbx, greenMask);
+        __m128i red   = _mm_and_si128(_mm_slli_epi32(rgbx, 16), redMask);
+        __m128i blue  = _mm_and_si128(_mm_srli_epi32(rgbx, 16), blueMask);
+        __m128i bgrx  = _mm_or_si128(_mm_or_si128(green, alpha), _mm_or_si128(red, blue));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[4 * x]), bgrx);
+    }
+    return x;
+}
+
+// The 16-bit formats are expanded to two vectors of 16-bit lanes, one with the red and green
+// bytes and one with the blue and alpha bytes, which are then interleaved into RGBA8 pixels.
+void StoreRGBA8FromRGAndBA(__m128i redGreen, __m128i blueAlpha, uint8_t *dest)
+{
+    __m128i *destVector = reinterpret_cast<__m128i *>(dest);
+    _mm_storeu_si128(destVector + 0, _mm_unpacklo_epi16(redGreen, blueAlpha));
+    _mm_storeu_si128(destVector + 1, _mm_unpackhi_epi16(redGreen, blueAlpha));
+}
+
+size_t LoadR5G6B5ToRGBA8RowSSE2(const uint16_t *source, uint8_t *dest, size_t width)
+{
+    const __m128i mask5 = _mm_set1_epi16(0x001F);
+    const __m128i mask6 = _mm_set1_epi16(0x003F);
+    const __m128i alpha = _mm_set1_epi16(static_cast<short>(0xFF00));
+
+    size_t x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        __m128i rgb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[x]));
+
+        __m128i red5   = _mm_srli_epi16(rgb, 11);
+        __m128i green6 = _mm_and_si128(_mm_srli_epi16(rgb, 5), mask6);
+        __m128i blue5  = _mm_and_si128(rgb, mask5);
+
+        __m128i red8   = _mm_or_si128(_mm_slli_epi16(red5, 3), _mm_srli_epi16(red5, 2));
+        __m128i green8 = _mm_or_si128(_mm_slli_epi16(green6, 2), _mm_srli_epi16(green6, 4));
+        __m128i blue8  = _mm_or_si128(_mm_slli_epi16(blue5, 3), _mm_srli_epi16(blue5, 2));
+
+        StoreRGBA8FromRGAndBA(_mm_or_si128(red8, _mm_slli_epi16(green8, 8)),
+                              _mm_or_si128(blue8, alpha), &dest[4 * x]);
+    }
+    return x;
+}
+
+size_t LoadRGBA4ToRGBA8RowSSE2(const uint16_t *source, uint8_t *dest, size_t width)
+{
+    const __m128i mask4   = _mm_set1_epi16(0x000F);
+    const __m128i mask4Hi = _mm_set1_epi16(0x0F00);
+
+    size_t x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        __m128i rgba = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[x]));
+
+        // Each byte of these holds a 4-bit channel, which is replicated to the high nibble.
+        __m128i redGreen4  = _mm_or_si128(_mm_srli_epi16(rgba, 12), _mm_and_si128(rgba, mask4Hi));
+        __m128i blueAlpha4 = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(rgba, 4), mask4),
+                                          _mm_slli_epi16(_mm_and_si128(rgba, mask4), 8));
+
+        StoreRGBA8FromRGAndBA(_mm_or_si128(redGreen4, _mm_slli_epi16(redGreen4, 4)),
+                              _mm_or_si128(blueAlpha4, _mm_slli_epi16(blueAlpha4, 4)),
+                              &dest[4 * x]);
+    }
+    return x;
+}
+
+size_t LoadRGB5A1ToRGBA8RowSSE2(const uint16_t *source, uint8_t *dest, size_t width)
+{
+    const __m128i mask5       = _mm_set1_epi16(0x001F);
+    const __m128i greenMask   = _mm_set1_epi16(0x07C0);
+    const __m128i lowBitsMask = _mm_set1_epi16(0x0707);
+    const __m128i alphaBit    = _mm_set1_epi16(0x0001);
+    const __m128i alphaMask   = _mm_set1_epi16(static_cast<short>(0xFF00));
+
+    size_t x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        __m128i rgba = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[x]));
+
+        // Red in the low byte and green in the high byte, both expanded from 5 to 8 bits at once.
+        // The mask keeps the green bits from shifting into the red byte.
+        __m128i redGreen5 = _mm_or_si128(_mm_srli_epi16(rgba, 11),
+                                         _mm_slli_epi16(_mm_and_si128(rgba, greenMask), 2));
+        __m128i redGreen8 = _mm_or_si128(_mm_slli_epi16(redGreen5, 3),
+                                         _mm_and_si128(_mm_srli_epi16(redGreen5, 2), lowBitsMask));
+
+        __m128i blue5 = _mm_and_si128(_mm_srli_epi16(rgba, 1), mask5);
+        __m128i blue8 = _mm_or_si128(_mm_slli_epi16(blue5, 3), _mm_srli_epi16(blue5, 2));
+        __m128i alpha8 =
+            _mm_and_si128(_mm_cmpeq_epi16(_mm_and_si128(rgba, alphaBit), alphaBit), alphaMask);
+
+        StoreRGBA8FromRGAndBA(redGreen8, _mm_or_si128(blue8, alpha8), &dest[4 * x]);
+    }
+    return x;
+}
+
+#endif  // defined(ANGLE_USE_SSE)
+
+}  // anonymous namespace
+
 void LoadA8ToRGBA8(size_t width,
                    size_t height,
                    size_t depth,
@@ -172,6 +344,10 @@ void LoadL8ToRGBA8(size_t width,
                    size_t outputRowPitch,
                    size_t outputDepthPitch)
 {
+#if defined(ANGLE_USE_SSE)
+    const bool useSSE2 = gl::supportsSSE2();
+#endif
+
     for (size_t z = 0; z < depth; z++)
     {
         for (size_t y = 0; y < height; y++)
@@ -180,7 +356,15 @@ void LoadL8ToRGBA8(size_t width,
                 priv::OffsetDataPointer<uint8_t>(input, y, z, inputRowPitch, inputDepthPitch);
             uint8_t *dest =
                 priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
+
+            size_t x = 0;
+#if defined(ANGLE_USE_SSE)
+            if (useSSE2)
+            {
+                x = LoadL8ToRGBA8RowSSE2(source, dest, width);
+            }
+#endif
+            for (; x < width; x++)
             {
                 uint8_t sourceVal = source[x];
                 dest[4 * x + 0]   = sourceVal;
@@ -275,6 +459,10 @@ void LoadLA8ToRGBA8(size_t width,
                     size_t outputRowPitch,
                     size_t outputDepthPitch)
 {
+#if defined(ANGLE_USE_SSE)
+    const bool useSSE2 = gl::supportsSSE2();
+#endif
+
     for (size_t z = 0; z < depth; z++)
     {
         for (size_t y = 0; y < height; y++)
@@ -283,7 +471,15 @@ void LoadLA8ToRGBA8(size_t width,
                 priv::OffsetDataPointer<uint8_t>(input, y, z, inputRowPitch, inputDepthPitch);
             uint8_t *dest =
                 priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
+
+            size_t x = 0;
+#if defined(ANGLE_USE_SSE)
+            if (useSSE2)
+            {
+                x = LoadLA8ToRGBA8RowSSE2(source, dest, width);
+            }
+#endif
+            for (; x < width; x++)
             {
                 dest[4 * x + 0] = source[2 * x + 0];
                 dest[4 * x + 1] = source[2 * x + 0];
@@ -441,6 +637,10 @@ void LoadRGB8ToBGRX8(size_t width,
                      size_t outputRowPitch,
                      size_t outputDepthPitch)
 {
+#if defined(ANGLE_USE_SSE)
+    const bool useSSE2 = gl::supportsSSE2();
+#endif
+
     for (size_t z = 0; z < depth; z++)
     {
         for (size_t y = 0; y < height; y++)
@@ -449,7 +649,15 @@ void LoadRGB8ToBGRX8(size_t width,
                 priv::OffsetDataPointer<uint8_t>(input, y, z, inputRowPitch, inputDepthPitch);
             uint8_t *dest =
                 priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
+
+            size_t x = 0;
+#if defined(ANGLE_USE_SSE)
+            if (useSSE2)
+            {
+                x = LoadRGB8ToBGRX8RowSSE2(source, dest, width);
+            }
+#endif
+            for (; x < width; x++)
             {
                 dest[4 * x + 0] = source[x * 3 + 2];
                 dest[4 * x + 1] = source[x * 3 + 1];
@@ -561,6 +769,10 @@ void LoadR5G6B5ToRGBA8(size_t width,
                        size_t outputRowPitch,
                        size_t outputDepthPitch)
 {
+#if defined(ANGLE_USE_SSE)
+    const bool useSSE2 = gl::supportsSSE2();
+#endif
+
     for (size_t z = 0; z < depth; z++)
     {
         for (size_t y = 0; y < height; y++)
@@ -569,7 +781,15 @@ void LoadR5G6B5ToRGBA8(size_t width,
                 priv::OffsetDataPointer<uint16_t>(input, y, z, inputRowPitch, inputDepthPitch);
             uint8_t *dest =
                 priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
+
+            size_t x = 0;
+#if defined(ANGLE_USE_SSE)
+            if (useSSE2)
+            {
+                x = LoadR5G6B5ToRGBA8RowSSE2(source, dest, width);
+            }
+#endif
+            for (; x < width; x++)
             {
                 uint16_t rgb = source[x];
                 dest[4 * x + 0] =
@@ -764,6 +984,10 @@ void LoadRGBA4ToRGBA8(size_t width,
                       size_t outputRowPitch,
                       size_t outputDepthPitch)
 {
+#if defined(ANGLE_USE_SSE)
+    const bool useSSE2 = gl::supportsSSE2();
+#endif
+
     for (size_t z = 0; z < depth; z++)
     {
         for (size_t y = 0; y < height; y++)
@@ -772,7 +996,15 @@ void LoadRGBA4ToRGBA8(size_t width,
                 priv::OffsetDataPointer<uint16_t>(input, y, z, inputRowPitch, inputDepthPitch);
             uint8_t *dest =
                 priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
+
+            size_t x = 0;
+#if defined(ANGLE_USE_SSE)
+            if (useSSE2)
+            {
+                x = LoadRGBA4ToRGBA8RowSSE2(source, dest, width);
+            }
+#endif
+            for (; x < width; x++)
             {
                 uint16_t rgba = source[x];
                 dest[4 * x + 0] =
@@ -955,6 +1187,10 @@ void LoadRGB5A1ToRGBA8(size_t width,
                        size_t outputRowPitch,
                        size_t outputDepthPitch)
 {
+#if defined(ANGLE_USE_SSE)
+    const bool useSSE2 = gl::supportsSSE2();
+#endif
+
     for (size_t z = 0; z < depth; z++)
     {
         for (size_t y = 0; y < height; y++)
@@ -963,7 +1199,15 @@ void LoadRGB5A1ToRGBA8(size_t width,
                 priv::OffsetDataPointer<uint16_t>(input, y, z, inputRowPitch, inputDepthPitch);
             uint8_t *dest =
                 priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
+
+            size_t x = 0;
+#if defined(ANGLE_USE_SSE)
+            if (useSSE2)
+            {
+                x = LoadRGB5A1ToRGBA8RowSSE2(source, dest, width);
+            }
+#endif
+            for (; x < width; x++)
             {
                 uint16_t rgba = source[x];
                 dest[4 * x + 0] =
@@ -46,8 +46,59 @@ static const int intensityModifierNonOpaque[][4] =
 };
 // clang-format on
 
+// Intensity modifiers of the EAC single channel blocks, indexed by table index and pixel index
+// clang-format off
+static const int singleChannelModifierTable[16][8] =
+{
+    { -3, -6,  -9, -15, 2, 5, 8, 14 },
+    { -3, -7, -10, -13, 2, 6, 9, 12 },
+    { -2, -5,  -8, -13, 1, 4, 7, 12 },
+    { -2, -4,  -6, -13, 1, 3, 5, 12 },
+    { -3, -6,  -8, -12, 2, 5, 7, 11 },
+    { -3, -7,  -9, -11, 2, 6, 8, 10 },
+    { -4, -7,  -8, -11, 3, 6, 7, 10 },
+    { -3, -5,  -8, -11, 2, 4, 7, 10 },
+    { -2, -6,  -8, -10, 1, 5, 7,  9 },
+    { -2, -5,  -8, -10, 1, 4, 7,  9 },
+    { -2, -4,  -8, -10, 1, 3, 7,  9 },
+    { -2, -5,  -7, -10, 1, 4, 6,  9 },
+    { -3, -4,  -7, -10, 2, 3, 6,  9 },
+    { -1, -2,  -3, -10, 0, 1, 2,  9 },
+    { -4, -6,  -8,  -9, 3, 5, 7,  8 },
+    { -3, -5,  -7,  -9, 2, 4, 6,  8 }
+};
+// clang-format on
+
 static const int kNumPixelsInBlock = 16;
 
+// Offset of the subblock of each pixel of an individual or differential block in the colors of
+// both subblocks, for each value of the flip bit. The pixel at column i of row j is at j * 4 + i.
+// clang-format off
+static const uint8_t subblockColorOffsets[2][kNumPixelsInBlock] =
+{
+    // Two 2x4 subblocks side by side
+    { 0, 0, 4, 4,
+      0, 0, 4, 4,
+      0, 0, 4, 4,
+      0, 0, 4, 4 },
+    // Two 4x2 subblocks on top of each other
+    { 0, 0, 0, 0,
+      0, 0, 0, 0,
+      4, 4, 4, 4,
+      4, 4, 4, 4 },
+};
+// clang-format on
+
+// clang-format off
+static const uint8_t DefaultETCAlphaValues[4][4] =
+{
+    { 255, 255, 255, 255 },
+    { 255, 255, 255, 255 },
+    { 255, 255, 255, 255 },
+    { 255, 255, 255, 255 },
+};
+// clang-format on
+
 struct ETC2Block
 {
     // Decodes unsigned single or dual channel block to bytes
@@ -60,20 +111,27 @@ struct ETC2Block
                                size_t destRowPitch,
                                bool isSigned) const
     {
-        for (size_t j = 0; j < 4 && (y + j) < h; j++)
+        // The pixels of a block only take 8 values, which are computed once and looked up with the
+        // 3-bit index of each pixel.
+        const int codeword   = isSigned ? u.scblk.base_codeword.s : u.scblk.base_codeword.us;
+        const int *modifiers = singleChannelModifierTable[u.scblk.table_index];
+        uint8_t values[8];
+        for (size_t modifierIdx = 0; modifierIdx < 8; modifierIdx++)
+        {
+            const int value = codeword + modifiers[modifierIdx] * u.scblk.multiplier;
+            values[modifierIdx] =
+                isSigned ? static_cast<uint8_t>(clampSByte(value)) : clampByte(value);
+        }
+
+        const uint64_t indices = getSingleChannelIndices();
+        const size_t columns   = std::min<size_t>(4, w - x);
+        const size_t rows      = std::min<size_t>(4, h - y);
+        for (size_t j = 0; j < rows; j++)
         {
             uint8_t *row = dest + (j * destRowPitch);
-            for (size_t i = 0; i < 4 && (x + i) < w; i++)
+            for (size_t i = 0; i < columns; i++)
             {
-                uint8_t *pixel = row + (i * destPixelStride);
-                if (isSigned)
-                {
-                    *pixel = clampSByte(getSingleChannel(i, j, isSigned));
-                }
-                else
-                {
-                    *pixel = clampByte(getSingleChannel(i, j, isSigned));
-                }
+                row[i * destPixelStride] = values[(indices >> (45 - 3 * (i * 4 + j))) & 7];
             }
         }
     }
@@ -88,6 +146,8 @@ struct ETC2Block
                      const uint8_t alphaValues[4][4],
                      bool punchThroughAlpha) const
     {
+        R8G8B8A8 pixels[kNumPixelsInBlock];
+
         bool opaqueBit                  = u.idht.mode.idm.diffbit;
         bool nonOpaquePunchThroughAlpha = punchThroughAlpha && !opaqueBit;
         // Select mode
@@ -99,28 +159,50 @@ struct ETC2Block
             int b             = (block.B + block.dB);
             if (r < 0 || r > 31)
             {
-                decodeTBlock(dest, x, y, w, h, destRowPitch, alphaValues,
-                             nonOpaquePunchThroughAlpha);
+                decodeTBlock(pixels, nonOpaquePunchThroughAlpha);
             }
             else if (g < 0 || g > 31)
             {
-                decodeHBlock(dest, x, y, w, h, destRowPitch, alphaValues,
-                             nonOpaquePunchThroughAlpha);
+                decodeHBlock(pixels, nonOpaquePunchThroughAlpha);
             }
             else if (b < 0 || b > 31)
             {
-                decodePlanarBlock(dest, x, y, w, h, destRowPitch, alphaValues);
+                decodePlanarBlock(pixels);
             }
             else
             {
-                decodeDifferentialBlock(dest, x, y, w, h, destRowPitch, alphaValues,
-                                        nonOpaquePunchThroughAlpha);
+                decodeDifferentialBlock(pixels, nonOpaquePunchThroughAlpha);
             }
         }
         else
         {
-            decodeIndividualBlock(dest, x, y, w, h, destRowPitch, alphaValues,
-                                  nonOpaquePunchThroughAlpha);
+            decodeIndividualBlock(pixels, nonOpaquePunchThroughAlpha);
+        }
+
+        // The decoded pixels are opaque, except for the transparent punch-through pixels which
+        // stay transparent.
+        if (alphaValues != DefaultETCAlphaValues)
+        {
+            const uint8_t *alpha = &alphaValues[0][0];
+            for (size_t pixelIdx = 0; pixelIdx < kNumPixelsInBlock; pixelIdx++)
+            {
+                pixels[pixelIdx].A &= alpha[pixelIdx];
+            }
+        }
+
+        const size_t columns = std::min<size_t>(4, w - x);
+        const size_t rows    = std::min<size_t>(4, h - y);
+        for (size_t j = 0; j < rows; j++)
+        {
+            uint8_t *row = dest + (j * destRowPitch);
+            if (columns == 4)
+            {
+                memcpy(row, &pixels[j * 4], 4 * sizeof(R8G8B8A8));
+            }
+            else
+            {
+                memcpy(row, &pixels[j * 4], columns * sizeof(R8G8B8A8));
+            }
         }
     }
 
@@ -345,14 +427,7 @@ struct ETC2Block
     static int extend_6to8bits(int x) { return (x << 2) | (x >> 4); }
     static int extend_7to8bits(int x) { return (x << 1) | (x >> 6); }
 
-    void decodeIndividualBlock(uint8_t *dest,
-                               size_t x,
-                               size_t y,
-                               size_t w,
-                               size_t h,
-                               size_t destRowPitch,
-                               const uint8_t alphaValues[4][4],
-                               bool nonOpaquePunchThroughAlpha) const
+    void decodeIndividualBlock(R8G8B8A8 *pixels, bool nonOpaquePunchThroughAlpha) const
     {
         const auto &block = u.idht.mode.idm.colors.indiv;
         int r1            = extend_4to8bits(block.R1);
@@ -361,18 +436,11 @@ struct ETC2Block
         int r2            = extend_4to8bits(block.R2);
         int g2            = extend_4to8bits(block.G2);
         int b2            = extend_4to8bits(block.B2);
-        decodeIndividualOrDifferentialBlock(dest, x, y, w, h, destRowPitch, r1, g1, b1, r2, g2, b2,
-                                            alphaValues, nonOpaquePunchThroughAlpha);
+        decodeIndividualOrDifferentialBlock(pixels, r1, g1, b1, r2, g2, b2,
+                                            nonOpaquePunchThroughAlpha);
     }
 
-    void decodeDifferentialBlock(uint8_t *dest,
-                                 size_t x,
-                                 size_t y,
-                                 size_t w,
-                                 size_t h,
-                                 size_t destRowPitch,
-                                 const uint8_t alphaValues[4][4],
-                                 bool nonOpaquePunchThroughAlpha) const
+    void decodeDifferentialBlock(R8G8B8A8 *pixels, bool nonOpaquePunchThroughAlpha) const
     {
         const auto &block = u.idht.mode.idm.colors.diff;
         int b1            = extend_5to8bits(block.B);
@@ -381,96 +449,123 @@ struct ETC2Block
         int r2            = extend_5to8bits(block.R + block.dR);
         int g2            = extend_5to8bits(block.G + block.dG);
         int b2            = extend_5to8bits(block.B + block.dB);
-        decodeIndividualOrDifferentialBlock(dest, x, y, w, h, destRowPitch, r1, g1, b1, r2, g2, b2,
-                                            alphaValues, nonOpaquePunchThroughAlpha);
+        decodeIndividualOrDifferentialBlock(pixels, r1, g1, b1, r2, g2, b2,
+                                            nonOpaquePunchThroughAlpha);
     }
 
-    void decodeIndividualOrDifferentialBlock(uint8_t *dest,
-                                             size_t x,
-                                             size_t y,
-                                             size_t w,
-                                             size_t h,
-                                             size_t destRowPitch,
+    void decodeIndividualOrDifferentialBlock(R8G8B8A8 *pixels,
                                              int r1,
                                              int g1,
                                              int b1,
                                              int r2,
                                              int g2,
                                              int b2,
-                                             const uint8_t alphaValues[4][4],
                                              bool nonOpaquePunchThroughAlpha) const
     {
-        const auto intensityModifier =
-            nonOpaquePunchThroughAlpha ? intensityModifierNonOpaque : intensityModifierDefault;
+        R8G8B8A8 subblockColors[8];
+        getSubblockColors(subblockColors, r1, g1, b1, r2, g2, b2, nonOpaquePunchThroughAlpha);
 
-        R8G8B8A8 subblockColors0[4];
-        R8G8B8A8 subblockColors1[4];
-        for (size_t modifierIdx = 0; modifierIdx < 4; modifierIdx++)
+        uint8_t indices[kNumPixelsInBlock];
+        getIndices(indices);
+
+        const uint8_t *subblockOffsets = subblockColorOffsets[u.idht.mode.idm.flipbit];
+        for (size_t pixelIdx = 0; pixelIdx < kNumPixelsInBlock; pixelIdx++)
         {
-            const int i1                 = intensityModifier[u.idht.mode.idm.cw1][modifierIdx];
-            subblockColors0[modifierIdx] = createRGBA(r1 + i1, g1 + i1, b1 + i1);
+            pixels[pixelIdx] = subblockColors[subblockOffsets[pixelIdx] + indices[pixelIdx]];
+        }
+    }
+
+    void decodeTBlock(R8G8B8A8 *pixels, bool nonOpaquePunchThroughAlpha) const
+    {
+        R8G8B8A8 paintColors[4];
+        getTBlockColors(paintColors, nonOpaquePunchThroughAlpha);
+        decodePaintColors(pixels, paintColors);
+    }
 
-            const int i2                 = intensityModifier[u.idht.mode.idm.cw2][modifierIdx];
-            subblockColors1[modifierIdx] = createRGBA(r2 + i2, g2 + i2, b2 + i2);
+    void decodeHBlock(R8G8B8A8 *pixels, bool nonOpaquePunchThroughAlpha) const
+    {
+        R8G8B8A8 paintColors[4];
+        getHBlockColors(paintColors, nonOpaquePunchThroughAlpha);
+        decodePaintColors(pixels, paintColors);
+    }
+
+    void decodePaintColors(R8G8B8A8 *pixels, const R8G8B8A8 paintColors[4]) const
+    {
+        uint8_t indices[kNumPixelsInBlock];
+        getIndices(indices);
+
+        for (size_t pixelIdx = 0; pixelIdx < kNumPixelsInBlock; pixelIdx++)
+        {
+            pixels[pixelIdx] = paintColors[indices[pixelIdx]];
         }
+    }
 
-        if (u.idht.mode.idm.flipbit)
+    void decodePlanarBlock(R8G8B8A8 *pixels) const
+    {
+        int ro = extend_6to8bits(u.pblk.RO);
+        int go = extend_7to8bits(u.pblk.GO1 << 6 | u.pblk.GO2);
+        int bo =
+            extend_6to8bits(u.pblk.BO1 << 5 | u.pblk.BO2 << 3 | u.pblk.BO3a << 1 | u.pblk.BO3b);
+        int rh = extend_6to8bits(u.pblk.RH1 << 1 | u.pblk.RH2);
+        int gh = extend_7to8bits(u.pblk.GH);
+        int bh = extend_6to8bits(u.pblk.BHa << 5 | u.pblk.BHb);
+        int rv = extend_6to8bits(u.pblk.RVa << 3 | u.pblk.RVb);
+        int gv = extend_7to8bits(u.pblk.GVa << 2 | u.pblk.GVb);
+        int bv = extend_6to8bits(u.pblk.BV);
+
+        for (size_t j = 0; j < 4; j++)
         {
-            uint8_t *curPixel = dest;
-            for (size_t j = 0; j < 2 && (y + j) < h; j++)
-            {
-                R8G8B8A8 *row = reinterpret_cast<R8G8B8A8 *>(curPixel);
-                for (size_t i = 0; i < 4 && (x + i) < w; i++)
-                {
-                    row[i]   = subblockColors0[getIndex(i, j)];
-                    row[i].A = alphaValues[j][i];
-                }
-                curPixel += destRowPitch;
-            }
-            for (size_t j = 2; j < 4 && (y + j) < h; j++)
+            R8G8B8A8 *row = pixels + (j * 4);
+
+            int ry = static_cast<int>(j) * (rv - ro) + 2;
+            int gy = static_cast<int>(j) * (gv - go) + 2;
+            int by = static_cast<int>(j) * (bv - bo) + 2;
+            for (size_t i = 0; i < 4; i++)
             {
-                R8G8B8A8 *row = reinterpret_cast<R8G8B8A8 *>(curPixel);
-                for (size_t i = 0; i < 4 && (x + i) < w; i++)
-                {
-                    row[i]   = subblockColors1[getIndex(i, j)];
-                    row[i].A = alphaValues[j][i];
-                }
-                curPixel += destRowPitch;
+                row[i] = createRGBA(((static_cast<int>(i) * (rh - ro) + ry) >> 2) + ro,
+                                    ((static_cast<int>(i) * (gh - go) + gy) >> 2) + go,
+                                    ((static_cast<int>(i) * (bh - bo) + by) >> 2) + bo);
             }
         }
-        else
+    }
+
+    // Colors of the two subblocks of individual and differential blocks, indexed by the
+    // subblock's offset in subblockColorOffsets and the pixel index.
+    void getSubblockColors(R8G8B8A8 subblockColors[8],
+                           int r1,
+                           int g1,
+                           int b1,
+                           int r2,
+                           int g2,
+                           int b2,
+                           bool nonOpaquePunchThroughAlpha) const
+    {
+        const auto intensityModifier =
+            nonOpaquePunchThroughAlpha ? intensityModifierNonOpaque : intensityModifierDefault;
+
+        for (size_t modifierIdx = 0; modifierIdx < 4; modifierIdx++)
         {
-            uint8_t *curPixel = dest;
-            for (size_t j = 0; j < 4 && (y + j) < h; j++)
+            if (nonOpaquePunchThroughAlpha && (modifierIdx == 2))
             {
-                R8G8B8A8 *row = reinterpret_cast<R8G8B8A8 *>(curPixel);
-                for (size_t i = 0; i < 2 && (x + i) < w; i++)
-                {
-                    row[i]   = subblockColors0[getIndex(i, j)];
-                    row[i].A = alphaValues[j][i];
-                }
-                for (size_t i = 2; i < 4 && (x + i) < w; i++)
-                {
-                    row[i]   = subblockColors1[getIndex(i, j)];
-                    row[i].A = alphaValues[j][i];
-                }
-                curPixel += destRowPitch;
+                // In ETC opaque punch through formats, individual and
+                // differential blocks take index 2 as transparent pixel.
+                // Thus we don't need to compute its color, just assign it
+                // as black.
+                subblockColors[modifierIdx]     = createRGBA(0, 0, 0, 0);
+                subblockColors[4 + modifierIdx] = createRGBA(0, 0, 0, 0);
+            }
+            else
+            {
+                const int i1                = intensityModifier[u.idht.mode.idm.cw1][modifierIdx];
+                subblockColors[modifierIdx] = createRGBA(r1 + i1, g1 + i1, b1 + i1);
+
+                const int i2 = intensityModifier[u.idht.mode.idm.cw2][modifierIdx];
+                subblockColors[4 + modifierIdx] = createRGBA(r2 + i2, g2 + i2, b2 + i2);
             }
-        }
-        if (nonOpaquePunchThroughAlpha)
-        {
-            decodePunchThroughAlphaBlock(dest, x, y, w, h, destRowPitch);
         }
     }
 
-    void decodeTBlock(uint8_t *dest,
-                      size_t x,
-                      size_t y,
-                      size_t w,
-                      size_t h,
-                      size_t destRowPitch,
-                      const uint8_t alphaValues[4][4],
-                      bool nonOpaquePunchThroughAlpha) const
+    void getTBlockColors(R8G8B8A8 paintColors[4], bool nonOpaquePunchThroughAlpha) const
     {
         // Table C.8, distance index for T and H modes
         const auto &block = u.idht.mode.tm;
@@ -482,40 +577,19 @@ struct ETC2Block
         int g2 = extend_4to8bits(block.TG2);
         int b2 = extend_4to8bits(block.TB2);
 
-        static int distance[8] = {3, 6, 11, 16, 23, 32, 41, 64};
-        const int d            = distance[block.Tda << 1 | block.Tdb];
-
-        const R8G8B8A8 paintColors[4] = {
-            createRGBA(r1, g1, b1), createRGBA(r2 + d, g2 + d, b2 + d), createRGBA(r2, g2, b2),
-            createRGBA(r2 - d, g2 - d, b2 - d),
-        };
-
-        uint8_t *curPixel = dest;
-        for (size_t j = 0; j < 4 && (y + j) < h; j++)
-        {
-            R8G8B8A8 *row = reinterpret_cast<R8G8B8A8 *>(curPixel);
-            for (size_t i = 0; i < 4 && (x + i) < w; i++)
-            {
-                row[i]   = paintColors[getIndex(i, j)];
-                row[i].A = alphaValues[j][i];
-            }
-            curPixel += destRowPitch;
-        }
+        static const int distance[8] = {3, 6, 11, 16, 23, 32, 41, 64};
+        const int d                  = distance[block.Tda << 1 | block.Tdb];
 
-        if (nonOpaquePunchThroughAlpha)
-        {
-            decodePunchThroughAlphaBlock(dest, x, y, w, h, destRowPitch);
-        }
+        // In ETC opaque punch through formats, index == 2 means transparent pixel.
+        // Thus we don't need to compute its color, just assign it as black.
+        paintColors[0] = createRGBA(r1, g1, b1);
+        paintColors[1] = createRGBA(r2 + d, g2 + d, b2 + d);
+        paintColors[2] =
+            nonOpaquePunchThroughAlpha ? createRGBA(0, 0, 0, 0) : createRGBA(r2, g2, b2);
+        paintColors[3] = createRGBA(r2 - d, g2 - d, b2 - d);
     }
 
-    void decodeHBlock(uint8_t *dest,
-                      size_t x,
-                      size_t y,
-                      size_t w,
-                      size_t h,
-                      size_t destRowPitch,
-                      const uint8_t alphaValues[4][4],
-                      bool nonOpaquePunchThroughAlpha) const
+    void getHBlockColors(R8G8B8A8 paintColors[4], bool nonOpaquePunchThroughAlpha) const
     {
         // Table C.8, distance index for T and H modes
         const auto &block = u.idht.mode.hm;
@@ -532,96 +606,29 @@ struct ETC2Block
             ((r1 << 16 | g1 << 8 | b1) >= (r2 << 16 | g2 << 8 | b2) ? 1 : 0);
         const int d = distance[(block.Hda << 2) | (block.Hdb << 1) | orderingTrickBit];
 
-        const R8G8B8A8 paintColors[4] = {
-            createRGBA(r1 + d, g1 + d, b1 + d), createRGBA(r1 - d, g1 - d, b1 - d),
-            createRGBA(r2 + d, g2 + d, b2 + d), createRGBA(r2 - d, g2 - d, b2 - d),
-        };
-
-        uint8_t *curPixel = dest;
-        for (size_t j = 0; j < 4 && (y + j) < h; j++)
-        {
-            R8G8B8A8 *row = reinterpret_cast<R8G8B8A8 *>(curPixel);
-            for (size_t i = 0; i < 4 && (x + i) < w; i++)
-            {
-                row[i]   = paintColors[getIndex(i, j)];
-                row[i].A = alphaValues[j][i];
-            }
-            curPixel += destRowPitch;
-        }
-
-        if (nonOpaquePunchThroughAlpha)
-        {
-            decodePunchThroughAlphaBlock(dest, x, y, w, h, destRowPitch);
-        }
-    }
-
-    void decodePlanarBlock(uint8_t *dest,
-                           size_t x,
-                           size_t y,
-                           size_t w,
-                           size_t h,
-                           size_t pitch,
-                           const uint8_t alphaValues[4][4]) const
-    {
-        int ro = extend_6to8bits(u.pblk.RO);
-        int go = extend_7to8bits(u.pblk.GO1 << 6 | u.pblk.GO2);
-        int bo =
-            extend_6to8bits(u.pblk.BO1 << 5 | u.pblk.BO2 << 3 | u.pblk.BO3a << 1 | u.pblk.BO3b);
-        int rh = extend_6to8bits(u.pblk.RH1 << 1 | u.pblk.RH2);
-        int gh = extend_7to8bits(u.pblk.GH);
-        int bh = extend_6to8bits(u.pblk.BHa << 5 | u.pblk.BHb);
-        int rv = extend_6to8bits(u.pblk.RVa << 3 | u.pblk.RVb);
-        int gv = extend_7to8bits(u.pblk.GVa << 2 | u.pblk.GVb);
-        int bv = extend_6to8bits(u.pblk.BV);
-
-        uint8_t *curPixel = dest;
-        for (size_t j = 0; j < 4 && (y + j) < h; j++)
-        {
-            R8G8B8A8 *row = reinterpret_cast<R8G8B8A8 *>(curPixel);
-
-            int ry = static_cast<int>(j) * (rv - ro) + 2;
-            int gy = static_cast<int>(j) * (gv - go) + 2;
-            int by = static_cast<int>(j) * (bv - bo) + 2;
-            for (size_t i = 0; i < 4 && (x + i) < w; i++)
-            {
-                row[i] = createRGBA(((static_cast<int>(i) * (rh - ro) + ry) >> 2) + ro,
-                                    ((static_cast<int>(i) * (gh - go) + gy) >> 2) + go,
-                                    ((static_cast<int>(i) * (bh - bo) + by) >> 2) + bo,
-                                    alphaValues[j][i]);
-            }
-            curPixel += pitch;
-        }
-    }
-
-    // Index for individual, differential, H and T modes
-    size_t getIndex(size_t x, size_t y) const
-    {
-        size_t bitIndex  = x * 4 + y;
-        size_t bitOffset = bitIndex & 7;
-        size_t lsb       = (u.idht.pixelIndexLSB[1 - (bitIndex >> 3)] >> bitOffset) & 1;
-        size_t msb       = (u.idht.pixelIndexMSB[1 - (bitIndex >> 3)] >> bitOffset) & 1;
-        return (msb << 1) | lsb;
+        // In ETC opaque punch through formats, index == 2 means transparent pixel.
+        // Thus we don't need to compute its color, just assign it as black.
+        paintColors[0] = createRGBA(r1 + d, g1 + d, b1 + d);
+        paintColors[1] = createRGBA(r1 - d, g1 - d, b1 - d);
+        paintColors[2] = nonOpaquePunchThroughAlpha ? createRGBA(0, 0, 0, 0)
+                                                    : createRGBA(r2 + d, g2 + d, b2 + d);
+        paintColors[3] = createRGBA(r2 - d, g2 - d, b2 - d);
     }
 
-    void decodePunchThroughAlphaBlock(uint8_t *dest,
-                                      size_t x,
-                                      size_t y,
-                                      size_t w,
-                                      size_t h,
-                                      size_t destRowPitch) const
+    // Indices for individual, differential, H and T modes, with the index of the pixel at column
+    // i of row j at j * 4 + i. The MSB and LSB planes of the indices store the pixels column by
+    // column, so the bits of a row are 4 bits apart and combine into one index per nibble.
+    void getIndices(uint8_t indices[kNumPixelsInBlock]) const
     {
-        uint8_t *curPixel = dest;
-        for (size_t j = 0; j < 4 && (y + j) < h; j++)
+        const uint32_t msb = u.idht.pixelIndexMSB[0] << 8 | u.idht.pixelIndexMSB[1];
+        const uint32_t lsb = u.idht.pixelIndexLSB[0] << 8 | u.idht.pixelIndexLSB[1];
+        for (size_t j = 0; j < 4; j++)
         {
-            R8G8B8A8 *row = reinterpret_cast<R8G8B8A8 *>(curPixel);
-            for (size_t i = 0; i < 4 && (x + i) < w; i++)
+            const uint32_t rowIndices = ((msb >> j) & 0x1111) << 1 | ((lsb >> j) & 0x1111);
+            for (size_t i = 0; i < 4; i++)
             {
-                if (getIndex(i, j) == 2)  //  msb == 1 && lsb == 0
-                {
-                    row[i] = createRGBA(0, 0, 0, 0);
-                }
+                indices[j * 4 + i] = static_cast<uint8_t>((rowIndices >> (i * 4)) & 0xF);
             }
-            curPixel += destRowPitch;
         }
     }
 
@@ -873,34 +880,32 @@ struct ETC2Block
                                                     alphaValues, nonOpaquePunchThroughAlpha);
     }
 
-    void extractPixelIndices(int *pixelIndices,
-                             int *pixelIndicesCounts,
-                             size_t x,
-                             size_t y,
-                             size_t w,
-                             size_t h,
-                             bool flipbit,
-                             size_t subblockIdx) const
+    // Extracts the index of each pixel in the colors of both subblocks, and counts the pixels
+    // using each color.
+    void extractPixelIndices(int *pixelIndices, int *pixelIndicesCounts, bool flipbit) const
     {
-        size_t dxBegin = 0;
-        size_t dxEnd   = 4;
-        size_t dyBegin = subblockIdx * 2;
-        size_t dyEnd   = dyBegin + 2;
-        if (!flipbit)
+        uint8_t indices[kNumPixelsInBlock];
+        getIndices(indices);
+
+        const uint8_t *subblockOffsets = subblockColorOffsets[flipbit];
+        for (size_t pixelIdx = 0; pixelIdx < kNumPixelsInBlock; pixelIdx++)
         {
-            std::swap(dxBegin, dyBegin);
-            std::swap(dxEnd, dyEnd);
+            const int pixelIndex   = subblockOffsets[pixelIdx] + indices[pixelIdx];
+            pixelIndices[pixelIdx] = pixelIndex;
+            pixelIndicesCounts[pixelIndex]++;
         }
+    }
 
-        for (size_t j = dyBegin; j < dyEnd; j++)
+    // Same for the 4 paint colors of H and T modes.
+    void extractPaintColorIndices(int *pixelIndices, int *pixelIndicesCounts) const
+    {
+        uint8_t indices[kNumPixelsInBlock];
+        getIndices(indices);
+
+        for (size_t pixelIdx = 0; pixelIdx < kNumPixelsInBlock; pixelIdx++)
         {
-            int *row = &pixelIndices[j * 4];
-            for (size_t i = dxBegin; i < dxEnd; i++)
-            {
-                const size_t pixelIndex = subblockIdx * 4 + getIndex(i, j);
-                row[i]                  = static_cast<int>(pixelIndex);
-                pixelIndicesCounts[pixelIndex]++;
-            }
+            pixelIndices[pixelIdx] = indices[pixelIdx];
+            pixelIndicesCounts[indices[pixelIdx]]++;
         }
     }
 
@@ -1078,41 +1083,15 @@ struct ETC2Block
 
         static const size_t kNumColors = 8;
 
-        const auto intensityModifier =
-            nonOpaquePunchThroughAlpha ? intensityModifierNonOpaque : intensityModifierDefault;
-
         // Compute the colors that pixels can have in each subblock both for
         // the decoding of the RGBA data and BC1 encoding
         R8G8B8A8 subblockColors[kNumColors];
-        for (size_t modifierIdx = 0; modifierIdx < 4; modifierIdx++)
-        {
-            if (nonOpaquePunchThroughAlpha && (modifierIdx == 2))
-            {
-                // In ETC opaque punch through formats, individual and
-                // differential blocks take index 2 as transparent pixel.
-                // Thus we don't need to compute its color, just assign it
-                // as black.
-                subblockColors[modifierIdx]     = createRGBA(0, 0, 0, 0);
-                subblockColors[4 + modifierIdx] = createRGBA(0, 0, 0, 0);
-            }
-            else
-            {
-                const int i1                = intensityModifier[u.idht.mode.idm.cw1][modifierIdx];
-                subblockColors[modifierIdx] = createRGBA(r1 + i1, g1 + i1, b1 + i1);
-
-                const int i2 = intensityModifier[u.idht.mode.idm.cw2][modifierIdx];
-                subblockColors[4 + modifierIdx] = createRGBA(r2 + i2, g2 + i2, b2 + i2);
-            }
-        }
+        getSubblockColors(subblockColors, r1, g1, b1, r2, g2, b2, nonOpaquePunchThroughAlpha);
 
         int pixelIndices[kNumPixelsInBlock];
         int pixelIndexCounts[kNumColors] = {0};
         // Extract pixel indices from a ETC block.
-        for (size_t blockIdx = 0; blockIdx < 2; blockIdx++)
-        {
-            extractPixelIndices(pixelIndices, pixelIndexCounts, x, y, w, h, u.idht.mode.idm.flipbit,
-                                blockIdx);
-        }
+        extractPixelIndices(pixelIndices, pixelIndexCounts, u.idht.mode.idm.flipbit);
 
         int minColorIndex, maxColorIndex;
         selectEndPointPCA(pixelIndexCounts, subblockColors, kNumColors, &minColorIndex,
@@ -1132,39 +1111,12 @@ struct ETC2Block
     {
         static const size_t kNumColors = 4;
 
-        // Table C.8, distance index for T and H modes
-        const auto &block = u.idht.mode.tm;
-
-        int r1 = extend_4to8bits(block.TR1a << 2 | block.TR1b);
-        int g1 = extend_4to8bits(block.TG1);
-        int b1 = extend_4to8bits(block.TB1);
-        int r2 = extend_4to8bits(block.TR2);
-        int g2 = extend_4to8bits(block.TG2);
-        int b2 = extend_4to8bits(block.TB2);
-
-        static int distance[8] = {3, 6, 11, 16, 23, 32, 41, 64};
-        const int d            = distance[block.Tda << 1 | block.Tdb];
-
-        // In ETC opaque punch through formats, index == 2 means transparent pixel.
-        // Thus we don't need to compute its color, just assign it as black.
-        const R8G8B8A8 paintColors[kNumColors] = {
-            createRGBA(r1, g1, b1), createRGBA(r2 + d, g2 + d, b2 + d),
-            nonOpaquePunchThroughAlpha ? createRGBA(0, 0, 0, 0) : createRGBA(r2, g2, b2),
-            createRGBA(r2 - d, g2 - d, b2 - d),
-        };
+        R8G8B8A8 paintColors[kNumColors];
+        getTBlockColors(paintColors, nonOpaquePunchThroughAlpha);
 
         int pixelIndices[kNumPixelsInBlock];
         int pixelIndexCounts[kNumColors] = {0};
-        for (size_t j = 0; j < 4; j++)
-        {
-            int *row = &pixelIndices[j * 4];
-            for (size_t i = 0; i < 4; i++)
-            {
-                const size_t pixelIndex = getIndex(i, j);
-                row[i]                  = static_cast<int>(pixelIndex);
-                pixelIndexCounts[pixelIndex]++;
-            }
-        }
+        extractPaintColorIndices(pixelIndices, pixelIndexCounts);
 
         int minColorIndex, maxColorIndex;
         selectEndPointPCA(pixelIndexCounts, paintColors, kNumColors, &minColorIndex,
@@ -1184,42 +1136,12 @@ struct ETC2Block
     {
         static const size_t kNumColors = 4;
 
-        // Table C.8, distance index for T and H modes
-        const auto &block = u.idht.mode.hm;
-
-        int r1 = extend_4to8bits(block.HR1);
-        int g1 = extend_4to8bits(block.HG1a << 1 | block.HG1b);
-        int b1 = extend_4to8bits(block.HB1a << 3 | block.HB1b << 1 | block.HB1c);
-        int r2 = extend_4to8bits(block.HR2);
-        int g2 = extend_4to8bits(block.HG2a << 1 | block.HG2b);
-        int b2 = extend_4to8bits(block.HB2);
-
-        static const int distance[8] = {3, 6, 11, 16, 23, 32, 41, 64};
-        const int orderingTrickBit =
-            ((r1 << 16 | g1 << 8 | b1) >= (r2 << 16 | g2 << 8 | b2) ? 1 : 0);
-        const int d = distance[(block.Hda << 2) | (block.Hdb << 1) | orderingTrickBit];
-
-        // In ETC opaque punch through formats, index == 2 means transparent pixel.
-        // Thus we don't need to compute its color, just assign it as black.
-        const R8G8B8A8 paintColors[kNumColors] = {
-            createRGBA(r1 + d, g1 + d, b1 + d), createRGBA(r1 - d, g1 - d, b1 - d),
-            nonOpaquePunchThroughAlpha ? createRGBA(0, 0, 0, 0)
-                                       : createRGBA(r2 + d, g2 + d, b2 + d),
-            createRGBA(r2 - d, g2 - d, b2 - d),
-        };
+        R8G8B8A8 paintColors[kNumColors];
+        getHBlockColors(paintColors, nonOpaquePunchThroughAlpha);
 
         int pixelIndices[kNumPixelsInBlock];
         int pixelIndexCounts[kNumColors] = {0};
-        for (size_t j = 0; j < 4; j++)
-        {
-            int *row = &pixelIndices[j * 4];
-            for (size_t i = 0; i < 4; i++)
-            {
-                const size_t pixelIndex = getIndex(i, j);
-                row[i]                  = static_cast<int>(pixelIndex);
-                pixelIndexCounts[pixelIndex]++;
-            }
-        }
+        extractPaintColorIndices(pixelIndices, pixelIndexCounts);
 
         int minColorIndex, maxColorIndex;
         selectEndPointPCA(pixelIndexCounts, paintColors, kNumColors, &minColorIndex,
@@ -1239,8 +1161,7 @@ struct ETC2Block
         static const size_t kNumColors = kNumPixelsInBlock;
 
         R8G8B8A8 rgbaBlock[kNumColors];
-        decodePlanarBlock(reinterpret_cast<uint8_t *>(rgbaBlock), x, y, w, h, sizeof(R8G8B8A8) * 4,
-                          alphaValues);
+        decodePlanarBlock(rgbaBlock);
 
         // Planar block doesn't have a color table, fill indices as full
         int pixelIndices[kNumPixelsInBlock] = {0, 1, 2,  3,  4,  5,  6,  7,
@@ -1255,77 +1176,20 @@ struct ETC2Block
     }
 
     // Single channel utility functions
-    int getSingleChannel(size_t x, size_t y, bool isSigned) const
-    {
-        int codeword = isSigned ? u.scblk.base_codeword.s : u.scblk.base_codeword.us;
-        return codeword + getSingleChannelModifier(x, y) * u.scblk.multiplier;
-    }
 
-    int getSingleChannelIndex(size_t x, size_t y) const
+    // The 3-bit indices of a single channel block, with the index of the pixel at column i of row
+    // j at bits 45 - 3 * (i * 4 + j). They are the last 6 bytes of the block, in big endian order.
+    uint64_t getSingleChannelIndices() const
     {
-        ASSERT(x < 4 && y < 4);
-
-        // clang-format off
-        switch (x * 4 + y)
+        const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&u);
+        uint64_t indices     = 0;
+        for (size_t byteIdx = 2; byteIdx < 8; byteIdx++)
         {
-            case 0: return u.scblk.ma;
-            case 1: return u.scblk.mb;
-            case 2: return u.scblk.mc1 << 1 | u.scblk.mc2;
-            case 3: return u.scblk.md;
-            case 4: return u.scblk.me;
-            case 5: return u.scblk.mf1 << 2 | u.scblk.mf2;
-            case 6: return u.scblk.mg;
-            case 7: return u.scblk.mh;
-            case 8: return u.scblk.mi;
-            case 9: return u.scblk.mj;
-            case 10: return u.scblk.mk1 << 1 | u.scblk.mk2;
-            case 11: return u.scblk.ml;
-            case 12: return u.scblk.mm;
-            case 13: return u.scblk.mn1 << 2 | u.scblk.mn2;
-            case 14: return u.scblk.mo;
-            case 15: return u.scblk.mp;
-            default: UNREACHABLE(); return 0;
+            indices = (indices << 8) | bytes[byteIdx];
         }
-        // clang-format on
+        return indices;
     }
-
-    int getSingleChannelModifier(size_t x, size_t y) const
-    {
-        // clang-format off
-        static const int modifierTable[16][8] =
-        {
-            { -3, -6,  -9, -15, 2, 5, 8, 14 },
-            { -3, -7, -10, -13, 2, 6, 9, 12 },
-            { -2, -5,  -8, -13, 1, 4, 7, 12 },
-            { -2, -4,  -6, -13, 1, 3, 5, 12 },
-            { -3, -6,  -8, -12, 2, 5, 7, 11 },
-            { -3, -7,  -9, -11, 2, 6, 8, 10 },
-            { -4, -7,  -8, -11, 3, 6, 7, 10 },
-            { -3, -5,  -8, -11, 2, 4, 7, 10 },
-            { -2, -6,  -8, -10, 1, 5, 7,  9 },
-            { -2, -5,  -8, -10, 1, 4, 7,  9 },
-            { -2, -4,  -8, -10, 1, 3, 7,  9 },
-            { -2, -5,  -7, -10, 1, 4, 6,  9 },
-            { -3, -4,  -7, -10, 2, 3, 6,  9 },
-            { -1, -2,  -3, -10, 0, 1, 2,  9 },
-            { -4, -6,  -8,  -9, 3, 5, 7,  8 },
-            { -3, -5,  -7,  -9, 2, 4, 6,  8 }
-        };
-        // clang-format on
-
-        return modifierTable[u.scblk.table_index][getSingleChannelIndex(x, y)];
-    }
-};
-
-// clang-format off
-static const uint8_t DefaultETCAlphaValues[4][4] =
-{
-    { 255, 255, 255, 255 },
-    { 255, 255, 255, 255 },
-    { 255, 255, 255, 255 },
-    { 255, 255, 255, 255 },
 };
-// clang-format on
 
 void LoadR11EACToR8(size_t width,
                     size_t height,
@@ -0,0 +1,234 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// loadimage_unittest.cpp: Unit tests for the image loading functions. The loaders that have SIMD
+// implementations are checked against per-pixel reference conversions, for every width around
+// the SIMD step and for unaligned rows.
+//
+
+#include "image_util/loadimage.h"
+
+#include <string.h>
+#include <functional>
+#include <ostream>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace angle;
+
+namespace
+{
+
+using LoadFunction = void (*)(size_t width,
+                              size_t height,
+                              size_t depth,
+                              const uint8_t *input,
+                              size_t inputRowPitch,
+                              size_t inputDepthPitch,
+                              uint8_t *output,
+                              size_t outputRowPitch,
+                              size_t outputDepthPitch);
+
+// Converts a single pixel the way the scalar loaders do.
+using ReferenceFunction = std::function<void(const uint8_t *source, uint8_t *dest)>;
+
+uint16_t ReadUInt16(const uint8_t *source)
+{
+    uint16_t value;
+    memcpy(&value, source, sizeof(value));
+    return value;
+}
+
+uint8_t Expand4(unsigned int value)
+{
+    return static_cast<uint8_t>((value << 4) | value);
+}
+
+uint8_t Expand5(unsigned int value)
+{
+    return static_cast<uint8_t>((value << 3) | (value >> 2));
+}
+
+uint8_t Expand6(unsigned int value)
+{
+    return static_cast<uint8_t>((value << 2) | (value >> 4));
+}
+
+void ReferenceL8ToRGBA8(const uint8_t *source, uint8_t *dest)
+{
+    dest[0] = source[0];
+    dest[1] = source[0];
+    dest[2] = source[0];
+    dest[3] = 0xFF;
+}
+
+void ReferenceLA8ToRGBA8(const uint8_t *source, uint8_t *dest)
+{
+    dest[0] = source[0];
+    dest[1] = source[0];
+    dest[2] = source[0];
+    dest[3] = source[1];
+}
+
+void ReferenceRGB8ToBGRX8(const uint8_t *source, uint8_t *dest)
+{
+    dest[0] = source[2];
+    dest[1] = source[1];
+    dest[2] = source[0];
+    dest[3] = 0xFF;
+}
+
+void ReferenceR5G6B5ToRGBA8(const uint8_t *source, uint8_t *dest)
+{
+    uint16_t rgb = ReadUInt16(source);
+    dest[0]      = Expand5(rgb >> 11);
+    dest[1]      = Expand6((rgb >> 5) & 0x3F);
+    dest[2]      = Expand5(rgb & 0x1F);
+    dest[3]      = 0xFF;
+}
+
+void ReferenceRGBA4ToRGBA8(const uint8_t *source, uint8_t *dest)
+{
+    uint16_t rgba = ReadUInt16(source);
+    dest[0]       = Expand4(rgba >> 12);
+    dest[1]       = Expand4((rgba >> 8) & 0xF);
+    dest[2]       = Expand4((rgba >> 4) & 0xF);
+    dest[3]       = Expand4(rgba & 0xF);
+}
+
+void ReferenceRGB5A1ToRGBA8(const uint8_t *source, uint8_t *dest)
+{
+    uint16_t rgba = ReadUInt16(source);
+    dest[0]       = Expand5(rgba >> 11);
+    dest[1]       = Expand5((rgba >> 6) & 0x1F);
+    dest[2]       = Expand5((rgba >> 1) & 0x1F);
+    dest[3]       = (rgba & 0x1) ? 0xFF : 0;
+}
+
+struct LoadFunctionParams
+{
+    const char *name;
+    LoadFunction load;
+    ReferenceFunction reference;
+    size_t sourcePixelBytes;
+    size_t destPixelBytes;
+};
+
+std::ostream &operator<<(std::ostream &os, const LoadFunctionParams &params)
+{
+    return os << params.name;
+}
+
+// Loads a 3D image with padded pitches and compares every pixel with the reference conversion.
+// |sourceOffset| and |destOffset| move the image away from the alignment of the allocations.
+void CheckLoad(const LoadFunctionParams &params,
+               const std::vector<uint8_t> &sourcePixels,
+               size_t width,
+               size_t height,
+               size_t depth,
+               size_t sourceOffset,
+               size_t destOffset)
+{
+    const size_t sourceRowPitch   = width * params.sourcePixelBytes + 6;
+    const size_t sourceDepthPitch = sourceRowPitch * height + 2;
+    const size_t destRowPitch     = width * params.destPixelBytes + 12;
+    const size_t destDepthPitch   = destRowPitch * height + 4;
+
+    std::vector<uint8_t> source(sourceOffset + sourceDepthPitch * depth);
+    for (size_t index = 0; index < source.size(); ++index)
+    {
+        source[index] = sourcePixels[index % sourcePixels.size()];
+    }
+
+    // The padding is filled with a value the loaders never write, to catch writes past a row.
+    std::vector<uint8_t> dest(destOffset + destDepthPitch * depth, 0x5A);
+    std::vector<uint8_t> expected(dest);
+    for (size_t z = 0; z < depth; ++z)
+    {
+        for (size_t y = 0; y < height; ++y)
+        {
+            for (size_t x = 0; x < width; ++x)
+            {
+                params.reference(&source[sourceOffset + z * sourceDepthPitch + y * sourceRowPitch +
+                                         x * params.sourcePixelBytes],
+                                 &expected[destOffset + z * destDepthPitch + y * destRowPitch +
+                                           x * params.destPixelBytes]);
+            }
+        }
+    }
+
+    params.load(width, height, depth, &source[sourceOffset], sourceRowPitch, sourceDepthPitch,
+                &dest[destOffset], destRowPitch, destDepthPitch);
+
+    ASSERT_EQ(expected, dest) << params.name << " " << width << "x" << height << "x" << depth
+                              << ", source offset " << sourceOffset << ", dest offset "
+                              << destOffset;
+}
+
+class LoadImageTest : public testing::TestWithParam<LoadFunctionParams>
+{
+};
+
+// Random pixels, for every width up to a few SIMD steps and for unaligned source and dest rows.
+TEST_P(LoadImageTest, MatchesReference)
+{
+    const LoadFunctionParams &params = GetParam();
+
+    std::vector<uint8_t> sourcePixels(4099);
+    uint32_t random = 0x12345678u;
+    for (uint8_t &value : sourcePixels)
+    {
+        random = random * 1664525u + 1013904223u;
+        value  = static_cast<uint8_t>(random >> 24);
+    }
+
+    // The 16-bit formats are read as uint16_t, so their rows stay 2-byte aligned.
+    const size_t sourceOffsetStep = params.sourcePixelBytes == 2 ? 2 : 1;
+
+    for (size_t width = 1; width <= 40; ++width)
+    {
+        for (size_t sourceOffset = 0; sourceOffset < 16; sourceOffset += sourceOffsetStep)
+        {
+            CheckLoad(params, sourcePixels, width, 3, 2, sourceOffset, (sourceOffset * 4) % 16);
+            if (HasFatalFailure())
+            {
+                return;
+            }
+        }
+    }
+
+    CheckLoad(params, sourcePixels, 1021, 7, 1, 0, 0);
+}
+
+// Every value of the 16-bit formats, and of the bytes of the 8-bit formats.
+TEST_P(LoadImageTest, AllValues)
+{
+    const LoadFunctionParams &params = GetParam();
+
+    std::vector<uint8_t> sourcePixels;
+    for (uint32_t value = 0; value < 0x10000; ++value)
+    {
+        sourcePixels.push_back(static_cast<uint8_t>(value));
+        sourcePixels.push_back(static_cast<uint8_t>(value >> 8));
+    }
+
+    CheckLoad(params, sourcePixels, sourcePixels.size() / params.sourcePixelBytes, 1, 1, 0, 0);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    ,
+    LoadImageTest,
+    testing::Values(LoadFunctionParams{"L8ToRGBA8", LoadL8ToRGBA8, ReferenceL8ToRGBA8, 1, 4},
+                    LoadFunctionParams{"LA8ToRGBA8", LoadLA8ToRGBA8, ReferenceLA8ToRGBA8, 2, 4},
+                    LoadFunctionParams{"RGB8ToBGRX8", LoadRGB8ToBGRX8, ReferenceRGB8ToBGRX8, 3, 4},
+                    LoadFunctionParams{"R5G6B5ToRGBA8", LoadR5G6B5ToRGBA8, ReferenceR5G6B5ToRGBA8,
+                                       2, 4},
+                    LoadFunctionParams{"RGBA4ToRGBA8", LoadRGBA4ToRGBA8, ReferenceRGBA4ToRGBA8, 2,
+                                       4},
+                    LoadFunctionParams{"RGB5A1ToRGBA8", LoadRGB5A1ToRGBA8, ReferenceRGB5A1ToRGBA8,
+                                       2, 4}));
+
+}  // anonymous namespace
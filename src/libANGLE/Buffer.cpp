@@ -85,6 +85,8 @@ Error Buffer::bufferData(const Context *context,
     mState.mUsage = usage;
     mState.mSize  = size;
 
+    mDirtyChannel.signal();
+
     return NoError();
 }
 
@@ -16,6 +16,7 @@
 #include "libANGLE/Error.h"
 #include "libANGLE/IndexRangeCache.h"
 #include "libANGLE/RefCountObject.h"
+#include "libANGLE/signal_utils.h"
 
 namespace rx
 {
@@ -109,9 +110,13 @@ class Buffer final : public RefCountObject, public LabeledObject
 
     rx::BufferImpl *getImplementation() const { return mImpl; }
 
+    // Signaled when the data store is re-specified, for objects that cache the buffer size.
+    angle::BroadcastChannel *getDirtyChannel() { return &mDirtyChannel; }
+
   private:
     BufferState mState;
     rx::BufferImpl *mImpl;
+    angle::BroadcastChannel mDirtyChannel;
 
     mutable IndexRangeCache mIndexRangeCache;
 };
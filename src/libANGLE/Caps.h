@@ -664,6 +664,9 @@ struct DisplayExtensions
 
     // EGL_ANGLE_create_context_robust_resource_initialization
     bool createContextRobustResourceInitialization;
+
+    // EGL_ANGLE_program_cache_control
+    bool programCacheControl;
 };
 
 struct DeviceExtensions
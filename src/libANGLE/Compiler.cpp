@@ -8,10 +8,15 @@
 
 #include "libANGLE/Compiler.h"
 
+#include <mutex>
+
 #include "common/debug.h"
+#include "common/version.h"
+#include "libANGLE/BinaryStream.h"
 #include "libANGLE/ContextState.h"
 #include "libANGLE/renderer/CompilerImpl.h"
 #include "libANGLE/renderer/GLImplFactory.h"
+#include "third_party/murmurhash/MurmurHash3.h"
 
 namespace gl
 {
@@ -19,10 +24,35 @@ namespace gl
 namespace
 {
 
+// Serializes sh::Initialize and sh::Finalize with the creation and destruction of the compiler
+// handles. Compiles on different handles need no lock, the translator's shared state is
+// thread-safe, so they run in parallel off the calling thread.
+std::mutex &GetTranslatorMutex()
+{
+    static std::mutex translatorMutex;
+    return translatorMutex;
+}
+
 // Global count of active shader compiler handles. Needed to know when to call sh::Initialize and
-// sh::Finalize.
+// sh::Finalize. Guarded by the translator mutex.
 size_t activeCompilerHandles = 0;
 
+size_t GetShaderTypeIndex(GLenum shaderType)
+{
+    switch (shaderType)
+    {
+        case GL_VERTEX_SHADER:
+            return 0;
+        case GL_FRAGMENT_SHADER:
+            return 1;
+        case GL_COMPUTE_SHADER:
+            return 2;
+        default:
+            UNREACHABLE();
+            return 0;
+    }
+}
+
 ShShaderSpec SelectShaderSpec(GLint majorVersion, GLint minorVersion, bool isWebGL)
 {
     if (majorVersion >= 3)
@@ -48,9 +78,8 @@ Compiler::Compiler(rx::GLImplFactory *implFactory, const ContextState &state)
                              state.getExtensions().webglCompatibility)),
       mOutputType(mImplementation->getTranslatorOutputType()),
       mResources(),
-      mFragmentCompiler(nullptr),
-      mVertexCompiler(nullptr),
-      mComputeCompiler(nullptr)
+      mInstancesInUse(0),
+      mInstancesToRelease(0)
 {
     ASSERT(state.getClientMajorVersion() == 2 || state.getClientMajorVersion() == 3);
 
@@ -120,82 +149,168 @@ Compiler::Compiler(rx::GLImplFactory *implFactory, const ContextState &state)
 
 Compiler::~Compiler()
 {
-    release();
+    // Compiles in flight hold a reference.
+    ASSERT(mInstancesInUse == 0);
+    releaseResources();
     SafeDelete(mImplementation);
 }
 
-Error Compiler::release()
+Error Compiler::releaseResources()
 {
-    if (mFragmentCompiler)
+    for (std::vector<ShCompilerInstance> &pool : mPools)
     {
-        sh::Destruct(mFragmentCompiler);
-        mFragmentCompiler = nullptr;
-
-        ASSERT(activeCompilerHandles > 0);
-        activeCompilerHandles--;
+        for (ShCompilerInstance &instance : pool)
+        {
+            instance.destroy();
+        }
+        pool.clear();
     }
 
-    if (mVertexCompiler)
-    {
-        sh::Destruct(mVertexCompiler);
-        mVertexCompiler = nullptr;
+    mInstancesToRelease = mInstancesInUse;
+
+    mImplementation->release();
 
-        ASSERT(activeCompilerHandles > 0);
-        activeCompilerHandles--;
+    return gl::NoError();
+}
+
+std::vector<ShCompilerInstance> &Compiler::getPool(GLenum shaderType)
+{
+    return mPools[GetShaderTypeIndex(shaderType)];
+}
+
+ShCompilerInstance Compiler::getInstance(GLenum shaderType)
+{
+    mInstancesInUse++;
+
+    std::vector<ShCompilerInstance> &pool = getPool(shaderType);
+    if (!pool.empty())
+    {
+        ShCompilerInstance instance = std::move(pool.back());
+        pool.pop_back();
+        return instance;
     }
 
-    if (mComputeCompiler)
+    ShHandle handle = nullptr;
     {
-        sh::Destruct(mComputeCompiler);
-        mComputeCompiler = nullptr;
+        std::lock_guard<std::mutex> lock(GetTranslatorMutex());
+        if (activeCompilerHandles == 0)
+        {
+            sh::Initialize();
+        }
 
-        ASSERT(activeCompilerHandles > 0);
-        activeCompilerHandles--;
+        handle = sh::ConstructCompiler(shaderType, mSpec, mOutputType, &mResources);
+        ASSERT(handle);
+        activeCompilerHandles++;
     }
 
-    if (activeCompilerHandles == 0)
+    return ShCompilerInstance(handle, mOutputType, shaderType);
+}
+
+void Compiler::putInstance(ShCompilerInstance &&instance)
+{
+    ASSERT(mInstancesInUse > 0);
+    mInstancesInUse--;
+
+    // The instances are interchangeable, destroying any of them honors the release.
+    if (mInstancesToRelease > 0)
     {
-        sh::Finalize();
+        mInstancesToRelease--;
+        instance.destroy();
+        return;
     }
 
-    mImplementation->release();
+    getPool(instance.getShaderType()).push_back(std::move(instance));
+}
 
-    return gl::NoError();
+void Compiler::computeTranslatedShaderHash(GLenum shaderType,
+                                           const std::string &source,
+                                           ShCompileOptions options,
+                                           TranslatedShaderHash *hashOut) const
+{
+    BinaryOutputStream hashStream;
+
+    // The translator revision, for translations read back from disk. Builds without a commit hash
+    // all share the same placeholder, so the API and layout versions are hashed as well.
+    hashStream.writeBytes(reinterpret_cast<const unsigned char *>(ANGLE_COMMIT_HASH),
+                          ANGLE_COMMIT_HASH_SIZE);
+    hashStream.writeInt(ANGLE_SH_VERSION);
+    hashStream.writeInt(kTranslatedShaderFormatVersion);
+    hashStream.writeInt(shaderType);
+    hashStream.writeInt(static_cast<int>(mSpec));
+    hashStream.writeInt(static_cast<int>(mOutputType));
+
+    // The resources are initialized with sh::InitBuiltInResources, which clears the padding. A
+    // hash function would be hashed by address, which isn't stable across processes.
+    ASSERT(mResources.HashFunction == nullptr);
+    hashStream.writeBytes(reinterpret_cast<const unsigned char *>(&mResources),
+                          sizeof(mResources));
+
+    hashStream.writeBytes(reinterpret_cast<const unsigned char *>(&options), sizeof(options));
+    hashStream.writeString(source);
+
+    static_assert(sizeof(TranslatedShaderHash) == 16, "MurmurHash3_x64_128 produces 128 bits");
+    MurmurHash3_x64_128(hashStream.data(), static_cast<int>(hashStream.length()), 0,
+                        hashOut->data());
 }
 
-ShHandle Compiler::getCompilerHandle(GLenum type)
+ShCompilerInstance::ShCompilerInstance()
+    : mHandle(nullptr), mOutputType(SH_ESSL_OUTPUT), mShaderType(GL_NONE)
 {
-    ShHandle *compiler = nullptr;
-    switch (type)
-    {
-        case GL_VERTEX_SHADER:
-            compiler = &mVertexCompiler;
-            break;
+}
 
-        case GL_FRAGMENT_SHADER:
-            compiler = &mFragmentCompiler;
-            break;
-        case GL_COMPUTE_SHADER:
-            compiler = &mComputeCompiler;
-            break;
-        default:
-            UNREACHABLE();
-            return nullptr;
-    }
+ShCompilerInstance::ShCompilerInstance(ShHandle handle,
+                                       ShShaderOutput outputType,
+                                       GLenum shaderType)
+    : mHandle(handle), mOutputType(outputType), mShaderType(shaderType)
+{
+}
+
+ShCompilerInstance::~ShCompilerInstance()
+{
+    ASSERT(mHandle == nullptr);
+}
+
+ShCompilerInstance::ShCompilerInstance(ShCompilerInstance &&other)
+    : mHandle(other.mHandle), mOutputType(other.mOutputType), mShaderType(other.mShaderType)
+{
+    other.mHandle = nullptr;
+}
+
+ShCompilerInstance &ShCompilerInstance::operator=(ShCompilerInstance &&other)
+{
+    destroy();
+    mHandle       = other.mHandle;
+    other.mHandle = nullptr;
+    mOutputType   = other.mOutputType;
+    mShaderType = other.mShaderType;
+    return *this;
+}
 
-    if (!(*compiler))
+void ShCompilerInstance::destroy()
+{
+    if (mHandle == nullptr)
     {
-        if (activeCompilerHandles == 0)
-        {
-            sh::Initialize();
-        }
+        return;
+    }
 
-        *compiler = sh::ConstructCompiler(type, mSpec, mOutputType, &mResources);
-        ASSERT(*compiler);
-        activeCompilerHandles++;
+    std::lock_guard<std::mutex> lock(GetTranslatorMutex());
+    sh::Destruct(mHandle);
+    mHandle = nullptr;
+
+    ASSERT(activeCompilerHandles > 0);
+    activeCompilerHandles--;
+
+    if (activeCompilerHandles == 0)
+    {
+        sh::Finalize();
     }
+}
 
-    return *compiler;
+bool ShCompilerInstance::compile(const char *const shaderStrings[],
+                                 size_t numStrings,
+                                 ShCompileOptions options)
+{
+    return sh::Compile(mHandle, shaderStrings, numStrings, options);
 }
 
 }  // namespace gl
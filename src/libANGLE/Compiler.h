@@ -10,7 +10,12 @@
 #ifndef LIBANGLE_COMPILER_H_
 #define LIBANGLE_COMPILER_H_
 
+#include <array>
+#include <vector>
+
 #include "libANGLE/Error.h"
+#include "libANGLE/RefCountObject.h"
+#include "libANGLE/TranslatedShaderCache.h"
 #include "GLSLANG/ShaderLang.h"
 
 namespace rx
@@ -23,26 +28,72 @@ namespace gl
 {
 class ContextState;
 
-class Compiler final : angle::NonCopyable
+// Owns a single translator handle. An instance is used by one compile at a time, which may run on
+// a worker thread.
+class ShCompilerInstance final : angle::NonCopyable
+{
+  public:
+    ShCompilerInstance();
+    ShCompilerInstance(ShHandle handle, ShShaderOutput outputType, GLenum shaderType);
+    ~ShCompilerInstance();
+
+    ShCompilerInstance(ShCompilerInstance &&other);
+    ShCompilerInstance &operator=(ShCompilerInstance &&other);
+
+    void destroy();
+
+    // Thread safe, instances on different threads compile in parallel.
+    bool compile(const char *const shaderStrings[], size_t numStrings, ShCompileOptions options);
+
+    ShHandle getHandle() const { return mHandle; }
+    GLenum getShaderType() const { return mShaderType; }
+    ShShaderOutput getShaderOutputType() const { return mOutputType; }
+
+  private:
+    ShHandle mHandle;
+    ShShaderOutput mOutputType;
+    GLenum mShaderType;
+};
+
+// Reference counted so that compiles still in flight keep their compiler alive when the context
+// re-creates or releases it.
+class Compiler final : public RefCountObjectNoID
 {
   public:
     Compiler(rx::GLImplFactory *implFactory, const ContextState &data);
-    ~Compiler();
 
-    Error release();
+    // Implements glReleaseShaderCompiler. Instances in use by pending compiles are destroyed when
+    // they are returned.
+    Error releaseResources();
+
+    ShCompilerInstance getInstance(GLenum shaderType);
+    void putInstance(ShCompilerInstance &&instance);
 
-    ShHandle getCompilerHandle(GLenum type);
     ShShaderOutput getShaderOutputType() const { return mOutputType; }
 
+    // Hashes everything that determines the result of translating |source|.
+    void computeTranslatedShaderHash(GLenum shaderType,
+                                     const std::string &source,
+                                     ShCompileOptions options,
+                                     TranslatedShaderHash *hashOut) const;
+
   private:
+    ~Compiler() override;
+
+    std::vector<ShCompilerInstance> &getPool(GLenum shaderType);
+
     rx::CompilerImpl *mImplementation;
     ShShaderSpec mSpec;
     ShShaderOutput mOutputType;
     ShBuiltInResources mResources;
 
-    ShHandle mFragmentCompiler;
-    ShHandle mVertexCompiler;
-    ShHandle mComputeCompiler;
+    // Idle instances, indexed by vertex, fragment and compute shader type.
+    std::array<std::vector<ShCompilerInstance>, 3> mPools;
+
+    // Instances handed out to compiles, and how many of them are destroyed when they are returned
+    // because releaseResources was called since.
+    size_t mInstancesInUse;
+    size_t mInstancesToRelease;
 };
 
 }  // namespace gl
@@ -31,6 +31,9 @@ enum
 
     IMPLEMENTATION_MAX_TRANSFORM_FEEDBACK_BUFFERS = 4,
 
+    // The texture units are tracked in bit sets of this size.
+    IMPLEMENTATION_MAX_ACTIVE_TEXTURES = 64,
+
     // These are the maximums the implementation can support
     // The actual GL caps are limited by the device caps
     // and should be queried from the Context
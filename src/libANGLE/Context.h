@@ -22,7 +22,9 @@
 #include "libANGLE/Error.h"
 #include "libANGLE/HandleAllocator.h"
 #include "libANGLE/RefCountObject.h"
+#include "libANGLE/ResourceMap.h"
 #include "libANGLE/VertexAttribute.h"
+#include "libANGLE/WorkerThread.h"
 #include "libANGLE/Workarounds.h"
 #include "libANGLE/angletypes.h"
 
@@ -44,6 +46,8 @@ namespace gl
 class Compiler;
 class Shader;
 class Program;
+class ProgramCache;
+class TranslatedShaderCache;
 class Texture;
 class Framebuffer;
 class Renderbuffer;
@@ -63,6 +67,9 @@ class Context final : public ValidationContext
             const egl::Config *config,
             const Context *shareContext,
             TextureManager *shareTextures,
+            ProgramCache *programCache,
+            TranslatedShaderCache *translatedShaderCache,
+            angle::WorkerThreadPool *workerThreadPool,
             const egl::AttributeMap &attribs,
             const egl::DisplayExtensions &displayExtensions);
 
@@ -231,6 +238,15 @@ class Context final : public ValidationContext
 
     Compiler *getCompiler() const;
 
+    // Returns nullptr unless the context was created with the program binary cache enabled.
+    ProgramCache *getProgramCache() const { return mProgramCache; }
+
+    // Holds the results of earlier translations, shared by all contexts of the display.
+    TranslatedShaderCache *getTranslatedShaderCache() const { return mTranslatedShaderCache; }
+
+    // Runs shader compiles and program links off the calling thread.
+    angle::WorkerThreadPool *getWorkerThreadPool() const { return mWorkerThreadPool; }
+
     bool isSampler(GLuint samplerName) const;
 
     bool isVertexArrayGenerated(GLuint vertexArray);
@@ -732,9 +748,14 @@ class Context final : public ValidationContext
     Extensions mExtensions;
     Limitations mLimitations;
 
-    // Shader compiler
+    // Shader compiler, reference counted so that compiles in flight can outlive it.
     Compiler *mCompiler;
 
+    // Owned by the display and shared by all of its contexts.
+    ProgramCache *mProgramCache;
+    TranslatedShaderCache *mTranslatedShaderCache;
+    angle::WorkerThreadPool *mWorkerThreadPool;
+
     State mGLState;
 
     const egl::Config *mConfig;
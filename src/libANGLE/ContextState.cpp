@@ -127,10 +127,45 @@ ValidationContext::ValidationContext(const ValidationContext *shareContext,
              extensions,
              limitations),
       mSkipValidation(skipValidation),
-      mDisplayTextureShareGroup(shareTextures != nullptr)
+      mDisplayTextureShareGroup(shareTextures != nullptr),
+      mCachedHasMappedArrayBuffer(false),
+      mCachedDrawStatesError(GL_NO_ERROR),
+      mCachedDrawStatesSerial(0),
+      mCachedDrawStatesProgram(nullptr),
+      mCachedDrawStatesProgramSerial(0)
 {
 }
 
+bool ValidationContext::isDrawStatesCacheValid() const
+{
+    const State &state = getGLState();
+    if (state.getDrawValidationSerial() != mCachedDrawStatesSerial)
+    {
+        return false;
+    }
+
+    const Program *program = state.getProgram();
+    if (program != mCachedDrawStatesProgram)
+    {
+        return false;
+    }
+
+    return (program == nullptr ||
+            program->getDrawValidationSerial() == mCachedDrawStatesProgramSerial);
+}
+
+void ValidationContext::cacheDrawStates(bool hasMappedArrayBuffer, const Error &error)
+{
+    const State &state = getGLState();
+    const Program *program = state.getProgram();
+
+    mCachedHasMappedArrayBuffer    = hasMappedArrayBuffer;
+    mCachedDrawStatesError         = error;
+    mCachedDrawStatesSerial        = state.getDrawValidationSerial();
+    mCachedDrawStatesProgram       = program;
+    mCachedDrawStatesProgramSerial = program ? program->getDrawValidationSerial() : 0;
+}
+
 bool ValidationContext::getQueryParameterInfo(GLenum pname, GLenum *type, unsigned int *numParams)
 {
     // Please note: the query type returned for DEPTH_CLEAR_VALUE in this implementation
@@ -130,10 +130,26 @@ class ValidationContext : angle::NonCopyable
 
     bool isWebGL1() const { return mState.isWebGL1(); }
 
+    // Draw validation cache. Holds the result of the draw checks that only depend on bound
+    // objects, so redundant draws only need to validate their own parameters. The cached result
+    // is keyed on the State and current Program draw validation serials. The mapped vertex buffer
+    // check is kept apart, because it is reported before the framebuffer errors.
+    bool isDrawStatesCacheValid() const;
+    bool getCachedHasMappedArrayBuffer() const { return mCachedHasMappedArrayBuffer; }
+    const Error &getCachedDrawStatesError() const { return mCachedDrawStatesError; }
+    void cacheDrawStates(bool hasMappedArrayBuffer, const Error &error);
+
   protected:
     ContextState mState;
     bool mSkipValidation;
     bool mDisplayTextureShareGroup;
+
+  private:
+    bool mCachedHasMappedArrayBuffer;
+    Error mCachedDrawStatesError;
+    unsigned int mCachedDrawStatesSerial;
+    const Program *mCachedDrawStatesProgram;
+    unsigned int mCachedDrawStatesProgramSerial;
 };
 }  // namespace gl
 
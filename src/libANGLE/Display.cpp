@@ -11,6 +11,8 @@
 #include "libANGLE/Display.h"
 
 #include <algorithm>
+#include <atomic>
+#include <fstream>
 #include <iterator>
 #include <map>
 #include <sstream>
@@ -19,12 +21,15 @@
 #include <platform/Platform.h>
 #include <EGL/eglext.h>
 
+#include "common/api_trace.h"
 #include "common/debug.h"
 #include "common/mathutil.h"
 #include "common/platform.h"
+#include "common/system_utils.h"
 #include "common/utilities.h"
 #include "libANGLE/Context.h"
 #include "libANGLE/Device.h"
+#include "libANGLE/features.h"
 #include "libANGLE/histogram_macros.h"
 #include "libANGLE/Image.h"
 #include "libANGLE/Surface.h"
@@ -68,6 +73,10 @@ namespace egl
 namespace
 {
 
+constexpr size_t kDefaultMaxProgramCacheMemoryBytes          = 6 * 1024 * 1024;
+constexpr size_t kDefaultMaxTranslatedShaderCacheMemoryBytes = 4 * 1024 * 1024;
+constexpr size_t kDefaultWorkerThreadCount                   = 4;
+
 typedef std::map<EGLNativeWindowType, Surface*> WindowSurfaceMap;
 // Get a map of all EGL window surfaces to validate that no window has more than one EGL surface
 // associated with it.
@@ -254,6 +263,24 @@ void ANGLESetDefaultDisplayPlatform(angle::EGLDisplayType display)
     platformMethods->logInfo    = Display_logInfo;
 }
 
+// The first export of the API trace goes to the file named by ANGLE_API_TRACE_FILE, the later
+// ones get the number of the export before the extension, so that no export overwrites another.
+std::string GetApiTraceFileName(const std::string &baseName, unsigned int exportIndex)
+{
+    if (exportIndex == 0)
+    {
+        return baseName;
+    }
+
+    size_t separator = baseName.find_last_of("/\\");
+    size_t extension = baseName.rfind('.');
+    if (extension == std::string::npos || (separator != std::string::npos && extension < separator))
+    {
+        extension = baseName.size();
+    }
+    return baseName.substr(0, extension) + "." + ToString(exportIndex) + baseName.substr(extension);
+}
+
 }  // anonymous namespace
 
 Display *Display::GetDisplayFromNativeDisplay(EGLNativeDisplayType nativeDisplay,
@@ -358,7 +385,10 @@ Display::Display(EGLenum platform, EGLNativeDisplayType displayId, Device *eglDe
       mDevice(eglDevice),
       mPlatform(platform),
       mTextureManager(nullptr),
-      mGlobalTextureShareGroupUsers(0)
+      mGlobalTextureShareGroupUsers(0),
+      mProgramCache(kDefaultMaxProgramCacheMemoryBytes),
+      mTranslatedShaderCache(kDefaultMaxTranslatedShaderCacheMemoryBytes),
+      mWorkerThreadPool(kDefaultWorkerThreadCount)
 {
 }
 
@@ -441,6 +471,18 @@ Error Display::initialize()
     initDisplayExtensions();
     initVendorString();
 
+    // Program binaries and translated shaders persist across processes only when a cache
+    // directory is provided.
+    mProgramCache.setDiskCacheDirectory(angle::GetEnvironmentVar("ANGLE_PROGRAM_CACHE_DIR"));
+    mTranslatedShaderCache.setDiskCacheDirectory(
+        angle::GetEnvironmentVar("ANGLE_SHADER_CACHE_DIR"));
+
+    // The API calls are traced when a file is provided to export the trace to on termination.
+    if (!angle::GetEnvironmentVar("ANGLE_API_TRACE_FILE").empty())
+    {
+        angle::SetApiTraceEnabled(true);
+    }
+
     // Populate the Display's EGLDeviceEXT if the Display wasn't created using one
     if (mPlatform != EGL_PLATFORM_DEVICE_EXT)
     {
@@ -496,6 +538,26 @@ void Display::terminate()
 
     mConfigSet.clear();
 
+    mProgramCache.clear();
+    mTranslatedShaderCache.clear();
+
+    // Exports the calls traced since the last termination to a new file.
+    const std::string apiTraceFile = angle::GetEnvironmentVar("ANGLE_API_TRACE_FILE");
+    if (!apiTraceFile.empty())
+    {
+        std::vector<angle::ApiTraceRecord> records;
+        size_t dropped = angle::FlushApiTrace(&records);
+        if (dropped > 0)
+        {
+            WARN() << dropped << " API calls were dropped from the trace.";
+        }
+
+        static std::atomic<unsigned int> exportCount(0);
+        std::ofstream traceStream(GetApiTraceFileName(apiTraceFile, exportCount++),
+                                  std::ios::binary);
+        traceStream << angle::ExportApiTraceAsJSON(records);
+    }
+
     if (mDevice != nullptr && mDevice->getOwningDisplay() != nullptr)
     {
         // Don't delete the device if it was created externally using eglCreateDeviceANGLE
@@ -694,8 +756,10 @@ Error Display::createContext(const Config *configuration, gl::Context *shareCont
         shareTextures = mTextureManager;
     }
 
-    gl::Context *context = new gl::Context(mImplementation, configuration, shareContext,
-                                           shareTextures, attribs, mDisplayExtensions);
+    gl::Context *context =
+        new gl::Context(mImplementation, configuration, shareContext, shareTextures,
+                        &mProgramCache, &mTranslatedShaderCache, &mWorkerThreadPool, attribs,
+                        mDisplayExtensions);
 
     ASSERT(context != nullptr);
     mContextSet.insert(context);
@@ -951,6 +1015,9 @@ void Display::initDisplayExtensions()
     mDisplayExtensions.createContextClientArrays          = true;
     mDisplayExtensions.pixelFormatFloat                   = true;
 
+    // The program cache stores binaries in the GL_PROGRAM_BINARY_ANGLE format.
+    mDisplayExtensions.programCacheControl = (ANGLE_PROGRAM_BINARY_LOAD == ANGLE_ENABLED);
+
     // Force EGL_KHR_get_all_proc_addresses on.
     mDisplayExtensions.getAllProcAddresses = true;
 
@@ -19,7 +19,10 @@
 #include "libANGLE/Config.h"
 #include "libANGLE/Error.h"
 #include "libANGLE/LoggingAnnotator.h"
+#include "libANGLE/ProgramCache.h"
+#include "libANGLE/TranslatedShaderCache.h"
 #include "libANGLE/Version.h"
+#include "libANGLE/WorkerThread.h"
 
 namespace gl
 {
@@ -176,6 +179,10 @@ class Display final : angle::NonCopyable
 
     gl::TextureManager *mTextureManager;
     size_t mGlobalTextureShareGroupUsers;
+
+    gl::ProgramCache mProgramCache;
+    gl::TranslatedShaderCache mTranslatedShaderCache;
+    angle::WorkerThreadPool mWorkerThreadPool;
 };
 
 }  // namespace egl
@@ -9,44 +9,95 @@
 
 #include "libANGLE/IndexRangeCache.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "common/debug.h"
 #include "libANGLE/formatutils.h"
 
 namespace gl
 {
 
+constexpr size_t IndexRangeCache::kMaxEntries;
+constexpr size_t IndexRangeCache::kSlotCount;
+
+IndexRangeCache::IndexRangeCache()
+    : mEntryCount(0),
+      mUseCounter(0),
+      mCoveredStart(std::numeric_limits<size_t>::max()),
+      mCoveredEnd(0)
+{
+}
+
+IndexRangeCache::~IndexRangeCache()
+{
+}
+
 void IndexRangeCache::addRange(GLenum type,
                                size_t offset,
                                size_t count,
                                bool primitiveRestartEnabled,
                                const IndexRange &range)
 {
-    mIndexRangeCache[IndexRangeKey(type, offset, count, primitiveRestartEnabled)] = range;
+    if (mSlots.empty())
+    {
+        mSlots.resize(kSlotCount);
+        for (Entry &slot : mSlots)
+        {
+            slot.used = false;
+        }
+    }
+
+    size_t slot = findSlot(type, offset, count, primitiveRestartEnabled);
+    if (mSlots[slot].used)
+    {
+        mSlots[slot].range   = range;
+        mSlots[slot].lastUse = ++mUseCounter;
+        return;
+    }
+
+    if (mEntryCount == kMaxEntries)
+    {
+        evictLeastRecentlyUsed();
+    }
+
+    Entry entry;
+    entry.offset                  = offset;
+    entry.count                   = count;
+    entry.end                     = offset + GetTypeInfo(type).bytes * count;
+    entry.range                   = range;
+    entry.lastUse                 = ++mUseCounter;
+    entry.type                    = type;
+    entry.primitiveRestartEnabled = primitiveRestartEnabled;
+    entry.used                    = true;
+    insertEntry(entry);
 }
 
 bool IndexRangeCache::findRange(GLenum type,
                                 size_t offset,
                                 size_t count,
                                 bool primitiveRestartEnabled,
-                                IndexRange *outRange) const
+                                IndexRange *outRange)
 {
-    auto i = mIndexRangeCache.find(IndexRangeKey(type, offset, count, primitiveRestartEnabled));
-    if (i != mIndexRangeCache.end())
+    if (mEntryCount > 0)
     {
-        if (outRange)
+        size_t slot = findSlot(type, offset, count, primitiveRestartEnabled);
+        if (mSlots[slot].used)
         {
-            *outRange = i->second;
+            mSlots[slot].lastUse = ++mUseCounter;
+            if (outRange)
+            {
+                *outRange = mSlots[slot].range;
+            }
+            return true;
         }
-        return true;
     }
-    else
+
+    if (outRange)
     {
-        if (outRange)
-        {
-            *outRange = IndexRange();
-        }
-        return false;
+        *outRange = IndexRange();
     }
+    return false;
 }
 
 void IndexRangeCache::invalidateRange(size_t offset, size_t size)
@@ -54,60 +105,159 @@ void IndexRangeCache::invalidateRange(size_t offset, size_t size)
     size_t invalidateStart = offset;
     size_t invalidateEnd   = offset + size;
 
-    auto i = mIndexRangeCache.begin();
-    while (i != mIndexRangeCache.end())
+    if (mEntryCount == 0 || invalidateEnd < mCoveredStart || invalidateStart > mCoveredEnd)
     {
-        size_t rangeStart = i->first.offset;
-        size_t rangeEnd   = i->first.offset + (GetTypeInfo(i->first.type).bytes * i->first.count);
+        return;
+    }
 
-        if (invalidateEnd < rangeStart || invalidateStart > rangeEnd)
+    // Erasing shifts later entries of a probe sequence back into the erased slot, so the slot is
+    // checked again before moving on. Only entries that were already checked can end up in the
+    // slots before it.
+    size_t coveredStart = std::numeric_limits<size_t>::max();
+    size_t coveredEnd   = 0;
+    size_t slot         = 0;
+    while (slot < kSlotCount)
+    {
+        const Entry &entry = mSlots[slot];
+        if (!entry.used)
+        {
+            slot++;
+        }
+        else if (invalidateEnd < entry.offset || invalidateStart > entry.end)
         {
-            ++i;
+            coveredStart = std::min(coveredStart, entry.offset);
+            coveredEnd   = std::max(coveredEnd, entry.end);
+            slot++;
         }
         else
         {
-            mIndexRangeCache.erase(i++);
+            eraseSlot(slot);
         }
     }
+
+    mCoveredStart = coveredStart;
+    mCoveredEnd   = coveredEnd;
 }
 
 void IndexRangeCache::clear()
 {
-    mIndexRangeCache.clear();
+    for (Entry &slot : mSlots)
+    {
+        slot.used = false;
+    }
+    mEntryCount   = 0;
+    mCoveredStart = std::numeric_limits<size_t>::max();
+    mCoveredEnd   = 0;
 }
 
-IndexRangeCache::IndexRangeKey::IndexRangeKey()
-    : IndexRangeCache::IndexRangeKey(GL_NONE, 0, 0, false)
+bool IndexRangeCache::Entry::matches(GLenum type_,
+                                     size_t offset_,
+                                     size_t count_,
+                                     bool primitiveRestartEnabled_) const
 {
+    return offset == offset_ && count == count_ && type == type_ &&
+           primitiveRestartEnabled == primitiveRestartEnabled_;
 }
 
-IndexRangeCache::IndexRangeKey::IndexRangeKey(GLenum type_,
-                                              size_t offset_,
-                                              size_t count_,
-                                              bool primitiveRestartEnabled_)
-    : type(type_), offset(offset_), count(count_), primitiveRestartEnabled(primitiveRestartEnabled_)
+// static
+size_t IndexRangeCache::HashKey(GLenum type,
+                                size_t offset,
+                                size_t count,
+                                bool primitiveRestartEnabled)
 {
+    // Offsets are usually multiples of the index size, mix the bits before taking the low ones.
+    uint64_t key = (static_cast<uint64_t>(offset) * 0x9E3779B97F4A7C15ull) ^
+                   (static_cast<uint64_t>(count) * 0xC2B2AE3D27D4EB4Full) ^
+                   (static_cast<uint64_t>(type) << 1) ^ (primitiveRestartEnabled ? 1u : 0u);
+    return static_cast<size_t>(key ^ (key >> 32));
 }
 
-bool IndexRangeCache::IndexRangeKey::operator<(const IndexRangeKey &rhs) const
+size_t IndexRangeCache::findSlot(GLenum type,
+                                 size_t offset,
+                                 size_t count,
+                                 bool primitiveRestartEnabled) const
 {
-    if (type != rhs.type)
-    {
-        return type < rhs.type;
-    }
-    if (offset != rhs.offset)
+    ASSERT(!mSlots.empty());
+
+    // Returns the slot holding the key, or the free slot that ends its probe sequence.
+    size_t slot = HashKey(type, offset, count, primitiveRestartEnabled) & (kSlotCount - 1);
+    while (mSlots[slot].used && !mSlots[slot].matches(type, offset, count, primitiveRestartEnabled))
     {
-        return offset < rhs.offset;
+        slot = (slot + 1) & (kSlotCount - 1);
     }
-    if (count != rhs.count)
+    return slot;
+}
+
+void IndexRangeCache::insertEntry(const Entry &entry)
+{
+    ASSERT(mEntryCount < kMaxEntries);
+
+    size_t slot = findSlot(entry.type, entry.offset, entry.count, entry.primitiveRestartEnabled);
+    ASSERT(!mSlots[slot].used);
+    mSlots[slot] = entry;
+    mEntryCount++;
+
+    mCoveredStart = std::min(mCoveredStart, entry.offset);
+    mCoveredEnd   = std::max(mCoveredEnd, entry.end);
+}
+
+void IndexRangeCache::evictLeastRecentlyUsed()
+{
+    size_t oldestSlot  = kSlotCount;
+    uint32_t oldestAge = 0;
+    for (size_t slot = 0; slot < kSlotCount; ++slot)
     {
-        return count < rhs.count;
+        if (!mSlots[slot].used)
+        {
+            continue;
+        }
+
+        // Ages are distances from the counter, so that wrap-around doesn't reorder them.
+        uint32_t age = mUseCounter - mSlots[slot].lastUse;
+        if (oldestSlot == kSlotCount || age > oldestAge)
+        {
+            oldestSlot = slot;
+            oldestAge  = age;
+        }
     }
-    if (primitiveRestartEnabled != rhs.primitiveRestartEnabled)
+
+    ASSERT(oldestSlot < kSlotCount);
+    eraseSlot(oldestSlot);
+}
+
+void IndexRangeCache::eraseSlot(size_t slot)
+{
+    // Backward shift deletion: move later entries of the probe sequence into the hole, so that
+    // lookups never need tombstones.
+    size_t hole = slot;
+    size_t next = slot;
+    while (true)
     {
-        return primitiveRestartEnabled;
+        next = (next + 1) & (kSlotCount - 1);
+        const Entry &entry = mSlots[next];
+        if (!entry.used)
+        {
+            break;
+        }
+
+        size_t home =
+            HashKey(entry.type, entry.offset, entry.count, entry.primitiveRestartEnabled) &
+            (kSlotCount - 1);
+
+        // The entry can fill the hole if its home slot isn't cyclically in (hole, next].
+        bool homeBetween =
+            (hole <= next) ? (hole < home && home <= next) : (hole < home || home <= next);
+        if (!homeBetween)
+        {
+            mSlots[hole] = entry;
+            hole         = next;
+        }
     }
-    return false;
+
+    mSlots[hole].used = false;
+    mEntryCount--;
+
+    // The covered interval is only shrunk by invalidateRange and clear.
 }
 
 }
@@ -15,14 +15,21 @@
 
 #include "angle_gl.h"
 
-#include <map>
+#include <vector>
 
 namespace gl
 {
 
-class IndexRangeCache
+// A small open-addressed table of index ranges. It holds at most kMaxEntries ranges and evicts the
+// least recently used one when full, so buffers that are drawn from at ever-changing offsets don't
+// grow it without bound. The byte interval covered by all entries is tracked so that writes to
+// other parts of the buffer don't have to look at the entries.
+class IndexRangeCache final
 {
   public:
+    IndexRangeCache();
+    ~IndexRangeCache();
+
     void addRange(GLenum type,
                   size_t offset,
                   size_t count,
@@ -32,27 +39,51 @@ class IndexRangeCache
                    size_t offset,
                    size_t count,
                    bool primitiveRestartEnabled,
-                   IndexRange *outRange) const;
+                   IndexRange *outRange);
 
     void invalidateRange(size_t offset, size_t size);
     void clear();
 
+    size_t size() const { return mEntryCount; }
+
+    static constexpr size_t kMaxEntries = 24;
+
   private:
-    struct IndexRangeKey
-    {
-        IndexRangeKey();
-        IndexRangeKey(GLenum type, size_t offset, size_t count, bool primitiveRestart);
+    // Twice the entries rounded up to a power of two, so probe sequences stay short.
+    static constexpr size_t kSlotCount = 64;
+    static_assert(kMaxEntries < kSlotCount, "Entries must leave free slots to end probing");
 
-        bool operator<(const IndexRangeKey &rhs) const;
+    struct Entry
+    {
+        bool matches(GLenum type, size_t offset, size_t count, bool primitiveRestartEnabled) const;
 
-        GLenum type;
         size_t offset;
         size_t count;
+        // One past the last byte read by the draw.
+        size_t end;
+        IndexRange range;
+        // When the entry was last added or found, for eviction.
+        uint32_t lastUse;
+        GLenum type;
         bool primitiveRestartEnabled;
+        bool used;
     };
 
-    typedef std::map<IndexRangeKey, IndexRange> IndexRangeMap;
-    IndexRangeMap mIndexRangeCache;
+    static size_t HashKey(GLenum type, size_t offset, size_t count, bool primitiveRestartEnabled);
+
+    size_t findSlot(GLenum type, size_t offset, size_t count, bool primitiveRestartEnabled) const;
+    void insertEntry(const Entry &entry);
+    void evictLeastRecentlyUsed();
+    void eraseSlot(size_t slot);
+
+    // Allocated by the first addRange, most buffers are never used for indices.
+    std::vector<Entry> mSlots;
+    size_t mEntryCount;
+    uint32_t mUseCounter;
+
+    // Union of the byte intervals of all entries, possibly larger after entries are removed.
+    size_t mCoveredStart;
+    size_t mCoveredEnd;
 };
 
 }
@@ -0,0 +1,200 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Unit tests for IndexRangeCache.
+//
+
+#include <map>
+#include <random>
+#include <tuple>
+
+#include "gtest/gtest.h"
+
+#include "libANGLE/IndexRangeCache.h"
+
+namespace
+{
+
+using gl::IndexRange;
+using gl::IndexRangeCache;
+
+IndexRange MakeRange(size_t value)
+{
+    return IndexRange(value, value + 10, 11);
+}
+
+void ExpectRange(IndexRangeCache *cache, size_t offset, size_t count, size_t expectedValue)
+{
+    IndexRange range;
+    ASSERT_TRUE(cache->findRange(GL_UNSIGNED_SHORT, offset, count, false, &range));
+    EXPECT_EQ(expectedValue, range.start);
+    EXPECT_EQ(expectedValue + 10, range.end);
+}
+
+// Test that ranges are found only with the exact key they were added with.
+TEST(IndexRangeCacheTest, FindExactKey)
+{
+    IndexRangeCache cache;
+    IndexRange range;
+    EXPECT_FALSE(cache.findRange(GL_UNSIGNED_SHORT, 0, 6, false, &range));
+
+    cache.addRange(GL_UNSIGNED_SHORT, 0, 6, false, MakeRange(1));
+    ExpectRange(&cache, 0, 6, 1);
+
+    EXPECT_FALSE(cache.findRange(GL_UNSIGNED_BYTE, 0, 6, false, &range));
+    EXPECT_FALSE(cache.findRange(GL_UNSIGNED_SHORT, 2, 6, false, &range));
+    EXPECT_FALSE(cache.findRange(GL_UNSIGNED_SHORT, 0, 3, false, &range));
+    EXPECT_FALSE(cache.findRange(GL_UNSIGNED_SHORT, 0, 6, true, &range));
+
+    // Adding the same key again replaces the range.
+    cache.addRange(GL_UNSIGNED_SHORT, 0, 6, false, MakeRange(2));
+    ExpectRange(&cache, 0, 6, 2);
+    EXPECT_EQ(1u, cache.size());
+}
+
+// Test that invalidation removes the ranges that overlap or touch the written bytes only.
+TEST(IndexRangeCacheTest, InvalidateRange)
+{
+    IndexRangeCache cache;
+
+    // Bytes [0, 12), [100, 112) and [200, 212).
+    cache.addRange(GL_UNSIGNED_SHORT, 0, 6, false, MakeRange(1));
+    cache.addRange(GL_UNSIGNED_SHORT, 100, 6, false, MakeRange(2));
+    cache.addRange(GL_UNSIGNED_SHORT, 200, 6, false, MakeRange(3));
+
+    // Outside of every range.
+    cache.invalidateRange(300, 50);
+    cache.invalidateRange(20, 50);
+    EXPECT_EQ(3u, cache.size());
+
+    // Touches the end of the second range.
+    cache.invalidateRange(112, 10);
+    EXPECT_EQ(2u, cache.size());
+    ExpectRange(&cache, 0, 6, 1);
+    ExpectRange(&cache, 200, 6, 3);
+
+    // The remaining ranges can be found and added to after the table was rebuilt.
+    cache.addRange(GL_UNSIGNED_SHORT, 100, 6, false, MakeRange(4));
+    ExpectRange(&cache, 100, 6, 4);
+
+    cache.invalidateRange(0, 1000);
+    EXPECT_EQ(0u, cache.size());
+
+    IndexRange range;
+    EXPECT_FALSE(cache.findRange(GL_UNSIGNED_SHORT, 0, 6, false, &range));
+}
+
+// Test that the cache stays bounded and evicts the least recently used range.
+TEST(IndexRangeCacheTest, EvictsLeastRecentlyUsed)
+{
+    IndexRangeCache cache;
+
+    for (size_t index = 0; index < IndexRangeCache::kMaxEntries; ++index)
+    {
+        cache.addRange(GL_UNSIGNED_SHORT, index * 12, 6, false, MakeRange(index));
+    }
+    EXPECT_EQ(IndexRangeCache::kMaxEntries, cache.size());
+
+    // Use the first range, so the second one is the oldest.
+    ExpectRange(&cache, 0, 6, 0);
+
+    cache.addRange(GL_UNSIGNED_SHORT, 10000, 6, false, MakeRange(1000));
+    EXPECT_EQ(IndexRangeCache::kMaxEntries, cache.size());
+
+    IndexRange range;
+    EXPECT_FALSE(cache.findRange(GL_UNSIGNED_SHORT, 12, 6, false, &range));
+    ExpectRange(&cache, 0, 6, 0);
+    ExpectRange(&cache, 10000, 6, 1000);
+
+    // Streaming at ever-changing offsets doesn't grow the cache.
+    for (size_t index = 0; index < 1000; ++index)
+    {
+        cache.addRange(GL_UNSIGNED_SHORT, 20000 + index * 12, 6, false, MakeRange(index));
+    }
+    EXPECT_EQ(IndexRangeCache::kMaxEntries, cache.size());
+    ExpectRange(&cache, 20000 + 999 * 12, 6, 999);
+}
+
+// Test random operations against a simple model of the cache, including eviction.
+TEST(IndexRangeCacheTest, RandomOperations)
+{
+    using Key = std::tuple<size_t, size_t>;
+    struct ModelEntry
+    {
+        size_t value;
+        size_t lastUse;
+    };
+
+    IndexRangeCache cache;
+    std::map<Key, ModelEntry> model;
+
+    std::mt19937 generator(5);
+    for (size_t iteration = 0; iteration < 20000; ++iteration)
+    {
+        size_t offset = (generator() % 64) * 2;
+        size_t count  = (generator() % 4) + 1;
+        Key key(offset, count);
+
+        switch (generator() % 8)
+        {
+            case 0:
+            {
+                size_t size = generator() % 16;
+                cache.invalidateRange(offset, size);
+                for (auto iter = model.begin(); iter != model.end();)
+                {
+                    size_t rangeStart = std::get<0>(iter->first);
+                    size_t rangeEnd   = rangeStart + std::get<1>(iter->first) * 2;
+                    if (offset + size < rangeStart || offset > rangeEnd)
+                    {
+                        ++iter;
+                    }
+                    else
+                    {
+                        iter = model.erase(iter);
+                    }
+                }
+                break;
+            }
+            case 1:
+            case 2:
+            case 3:
+            {
+                cache.addRange(GL_UNSIGNED_SHORT, offset, count, false, MakeRange(iteration));
+                if (model.count(key) == 0 && model.size() == IndexRangeCache::kMaxEntries)
+                {
+                    auto oldest = model.begin();
+                    for (auto iter = model.begin(); iter != model.end(); ++iter)
+                    {
+                        if (iter->second.lastUse < oldest->second.lastUse)
+                        {
+                            oldest = iter;
+                        }
+                    }
+                    model.erase(oldest);
+                }
+                model[key] = {iteration, iteration};
+                break;
+            }
+            default:
+            {
+                IndexRange range;
+                auto modelIter = model.find(key);
+                bool found = cache.findRange(GL_UNSIGNED_SHORT, offset, count, false, &range);
+                ASSERT_EQ(modelIter != model.end(), found);
+                if (found)
+                {
+                    ASSERT_EQ(modelIter->second.value, range.start);
+                    modelIter->second.lastUse = iteration;
+                }
+                break;
+            }
+        }
+
+        ASSERT_EQ(model.size(), cache.size());
+    }
+}
+
+}  // anonymous namespace
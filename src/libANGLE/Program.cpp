@@ -10,6 +10,7 @@
 #include "libANGLE/Program.h"
 
 #include <algorithm>
+#include <limits>
 
 #include "common/BitSetIterator.h"
 #include "common/debug.h"
@@ -20,12 +21,16 @@
 #include "libANGLE/Context.h"
 #include "libANGLE/ResourceManager.h"
 #include "libANGLE/features.h"
+#include "libANGLE/histogram_macros.h"
+#include "libANGLE/renderer/ContextImpl.h"
 #include "libANGLE/renderer/GLImplFactory.h"
 #include "libANGLE/renderer/ProgramImpl.h"
 #include "libANGLE/VaryingPacking.h"
+#include "libANGLE/WorkerThread.h"
 #include "libANGLE/queryconversions.h"
 #include "libANGLE/Uniform.h"
 #include "libANGLE/UniformLinker.h"
+#include "third_party/murmurhash/MurmurHash3.h"
 
 namespace gl
 {
@@ -33,27 +38,58 @@ namespace gl
 namespace
 {
 
-void WriteShaderVar(BinaryOutputStream *stream, const sh::ShaderVariable &var)
+ProgramBinaryShaderVariable WriteShaderVar(ProgramBinaryWriter *writer,
+                                           const sh::ShaderVariable &var)
 {
-    stream->writeInt(var.type);
-    stream->writeInt(var.precision);
-    stream->writeString(var.name);
-    stream->writeString(var.mappedName);
-    stream->writeInt(var.arraySize);
-    stream->writeInt(var.staticUse);
-    stream->writeString(var.structName);
     ASSERT(var.fields.empty());
+
+    ProgramBinaryShaderVariable record;
+    record.type       = var.type;
+    record.precision  = var.precision;
+    record.name       = writer->addString(var.name);
+    record.mappedName = writer->addString(var.mappedName);
+    record.structName = writer->addString(var.structName);
+    record.arraySize  = var.arraySize;
+    record.staticUse  = var.staticUse;
+    return record;
+}
+
+void LoadShaderVar(ProgramBinaryReader *reader,
+                   const ProgramBinaryShaderVariable &record,
+                   sh::ShaderVariable *var)
+{
+    var->type       = record.type;
+    var->precision  = record.precision;
+    var->name       = reader->getString(record.name);
+    var->mappedName = reader->getString(record.mappedName);
+    var->structName = reader->getString(record.structName);
+    var->arraySize  = record.arraySize;
+    var->staticUse  = record.staticUse != 0;
 }
 
-void LoadShaderVar(BinaryInputStream *stream, sh::ShaderVariable *var)
+ProgramBinaryVariableLocation WriteVariableLocation(ProgramBinaryWriter *writer,
+                                                    int location,
+                                                    const VariableLocation &variable)
 {
-    var->type       = stream->readInt<GLenum>();
-    var->precision  = stream->readInt<GLenum>();
-    var->name       = stream->readString();
-    var->mappedName = stream->readString();
-    var->arraySize  = stream->readInt<unsigned int>();
-    var->staticUse  = stream->readBool();
-    var->structName = stream->readString();
+    ProgramBinaryVariableLocation record;
+    record.location = location;
+    record.name     = writer->addString(variable.name);
+    record.element  = variable.element;
+    record.index    = variable.index;
+    record.used     = variable.used;
+    record.ignored  = variable.ignored;
+    return record;
+}
+
+void LoadVariableLocation(ProgramBinaryReader *reader,
+                          const ProgramBinaryVariableLocation &record,
+                          VariableLocation *variable)
+{
+    variable->name    = reader->getString(record.name);
+    variable->element = record.element;
+    variable->index   = record.index;
+    variable->used    = record.used != 0;
+    variable->ignored = record.ignored != 0;
 }
 
 // This simplified cast function doesn't need to worry about advanced concepts like
@@ -133,7 +169,9 @@ bool ComparePackedVarying(const PackedVarying &x, const PackedVarying &y)
 }
 
 template <typename VarT>
-GLuint GetResourceIndexFromName(const std::vector<VarT> &list, const std::string &name)
+GLuint GetResourceIndexFromName(const std::vector<VarT> &list,
+                                const ResourceNameIndex &nameIndex,
+                                const std::string &name)
 {
     size_t subscript     = GL_INVALID_INDEX;
     std::string baseName = ParseResourceName(name, &subscript);
@@ -144,16 +182,10 @@ GLuint GetResourceIndexFromName(const std::vector<VarT> &list, const std::string
         return GL_INVALID_INDEX;
     }
 
-    for (size_t index = 0; index < list.size(); index++)
+    GLuint index = nameIndex.find(baseName, 0);
+    if (index != GL_INVALID_INDEX && (list[index].isArray() || subscript == GL_INVALID_INDEX))
     {
-        const VarT &resource = list[index];
-        if (resource.name == baseName)
-        {
-            if (resource.isArray() || subscript == GL_INVALID_INDEX)
-            {
-                return static_cast<GLuint>(index);
-            }
-        }
+        return index;
     }
 
     return GL_INVALID_INDEX;
@@ -171,6 +203,13 @@ void CopyStringToBuffer(GLchar *buffer, const std::string &string, GLsizei bufSi
     }
 }
 
+// Returns the offset of the values at a uniform location in ProgramState::getUniformData().
+size_t GetUniformDataOffset(const LinkedUniform &uniform, const VariableLocation &locationInfo)
+{
+    return uniform.dataOffset +
+           (locationInfo.element > 0 ? locationInfo.element * uniform.getElementSize() : 0u);
+}
+
 }  // anonymous namespace
 
 const char *const g_fakepath = "C:\\fakepath";
@@ -248,6 +287,83 @@ VariableLocation::VariableLocation(const std::string &name,
 {
 }
 
+ResourceNameIndex::ResourceNameIndex()
+{
+}
+
+ResourceNameIndex::~ResourceNameIndex()
+{
+}
+
+void ResourceNameIndex::clear()
+{
+    mIndex.clear();
+}
+
+void ResourceNameIndex::add(const std::string &name, unsigned int element, GLuint value)
+{
+    mIndex.emplace(Key{name, element}, value);
+}
+
+GLuint ResourceNameIndex::find(const std::string &name, size_t element) const
+{
+    if (element > std::numeric_limits<unsigned int>::max())
+    {
+        return GL_INVALID_INDEX;
+    }
+
+    auto iter = mIndex.find(Key{name, static_cast<unsigned int>(element)});
+    return (iter != mIndex.end() ? iter->second : GL_INVALID_INDEX);
+}
+
+void ResourceNameIndex::save(ProgramBinaryWriter *writer, ProgramBinaryTableID table) const
+{
+    std::vector<ProgramBinaryNameIndexEntry> entries;
+    entries.reserve(mIndex.size());
+    for (const auto &entry : mIndex)
+    {
+        ProgramBinaryNameIndexEntry record;
+        record.name    = writer->addString(entry.first.name);
+        record.element = entry.first.element;
+        record.value   = entry.second;
+        entries.push_back(record);
+    }
+    writer->setTable(table, entries);
+}
+
+bool ResourceNameIndex::load(ProgramBinaryReader *reader,
+                             ProgramBinaryTableID table,
+                             size_t valueCount)
+{
+    ASSERT(mIndex.empty());
+
+    size_t entryCount = 0;
+    const ProgramBinaryNameIndexEntry *entries =
+        reader->getTable<ProgramBinaryNameIndexEntry>(table, &entryCount);
+    mIndex.reserve(entryCount);
+    for (size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex)
+    {
+        const ProgramBinaryNameIndexEntry &entry = entries[entryIndex];
+        if (entry.value >= valueCount)
+        {
+            return false;
+        }
+        mIndex.emplace(Key{reader->getString(entry.name), entry.element}, entry.value);
+    }
+
+    return !reader->error();
+}
+
+bool ResourceNameIndex::Key::operator==(const Key &other) const
+{
+    return element == other.element && name == other.name;
+}
+
+size_t ResourceNameIndex::KeyHasher::operator()(const Key &key) const
+{
+    return std::hash<std::string>()(key.name) ^ (static_cast<size_t>(key.element) * 0x9E3779B9u);
+}
+
 void Program::Bindings::bindLocation(GLuint index, const std::string &name)
 {
     mBindings[name] = index;
@@ -296,42 +412,25 @@ GLint ProgramState::getUniformLocation(const std::string &name) const
     size_t subscript     = GL_INVALID_INDEX;
     std::string baseName = ParseResourceName(name, &subscript);
 
-    for (size_t location = 0; location < mUniformLocations.size(); ++location)
+    // Without a subscript, the name refers to the first element of an array.
+    GLuint location =
+        mUniformLocationIndex.find(baseName, subscript == GL_INVALID_INDEX ? 0 : subscript);
+    if (location == GL_INVALID_INDEX)
     {
-        const VariableLocation &uniformLocation = mUniformLocations[location];
-        if (!uniformLocation.used)
-        {
-            continue;
-        }
-
-        const LinkedUniform &uniform = mUniforms[uniformLocation.index];
+        return -1;
+    }
 
-        if (uniform.name == baseName)
-        {
-            if (uniform.isArray())
-            {
-                if (uniformLocation.element == subscript ||
-                    (uniformLocation.element == 0 && subscript == GL_INVALID_INDEX))
-                {
-                    return static_cast<GLint>(location);
-                }
-            }
-            else
-            {
-                if (subscript == GL_INVALID_INDEX)
-                {
-                    return static_cast<GLint>(location);
-                }
-            }
-        }
+    if (subscript != GL_INVALID_INDEX && !mUniforms[mUniformLocations[location].index].isArray())
+    {
+        return -1;
     }
 
-    return -1;
+    return static_cast<GLint>(location);
 }
 
 GLuint ProgramState::getUniformIndexFromName(const std::string &name) const
 {
-    return GetResourceIndexFromName(mUniforms, name);
+    return GetResourceIndexFromName(mUniforms, mUniformIndex, name);
 }
 
 GLuint ProgramState::getUniformIndexFromLocation(GLint location) const
@@ -369,7 +468,9 @@ Program::Program(rx::GLImplFactory *factory, ShaderProgramManager *manager, GLui
       mDeleteStatus(false),
       mRefCount(0),
       mResourceManager(manager),
-      mHandle(handle)
+      mHandle(handle),
+      mDrawValidationSerial(0),
+      mDirtyUniformData(0, 0)
 {
     ASSERT(mProgram);
 
@@ -381,11 +482,14 @@ Program::~Program()
 {
     ASSERT(!mState.mAttachedVertexShader && !mState.mAttachedFragmentShader &&
            !mState.mAttachedComputeShader);
+    ASSERT(!mLinkingState);
     SafeDelete(mProgram);
 }
 
 void Program::destroy(const Context *context)
 {
+    resolveLink();
+
     if (mState.mAttachedVertexShader != nullptr)
     {
         mState.mAttachedVertexShader->release(context);
@@ -587,21 +691,110 @@ void Program::pathFragmentInputGen(GLint index,
 // The attached shaders are checked for linking errors by matching up their variables.
 // Uniform, input and output variables get collected.
 // The code gets compiled into binaries.
+// Runs the part of the link that only depends on the program and its attached shaders. The caps
+// are copied since requesting an extension can change them while the task is in flight.
+class Program::LinkTask : public angle::Closure
+{
+  public:
+    LinkTask(Program *program, const Caps &caps, bool isComputeLink, bool webglCompatibility)
+        : mProgram(program),
+          mCaps(caps),
+          mVaryingPacking(isComputeLink ? 0 : caps.maxVaryingVectors,
+                          webglCompatibility ? PackMode::WEBGL_STRICT : PackMode::ANGLE_RELAXED),
+          mResult(false)
+    {
+    }
+
+    void operator()() override
+    {
+        mResult = mProgram->linkFrontEnd(mCaps, &mVaryingPacking, &mMergedVaryings);
+    }
+
+    bool getResult() const { return mResult; }
+    const VaryingPacking &getVaryingPacking() const { return mVaryingPacking; }
+    const MergedVaryings &getMergedVaryings() const { return mMergedVaryings; }
+
+  private:
+    Program *mProgram;
+    Caps mCaps;
+    VaryingPacking mVaryingPacking;
+    MergedVaryings mMergedVaryings;
+    bool mResult;
+};
+
+struct Program::LinkingState
+{
+    // The backend link runs with the context that started the link.
+    const Context *context;
+    std::vector<Shader *> shaders;
+
+    ProgramCache *programCache;
+    ProgramHash programHash;
+
+    std::unique_ptr<LinkTask> linkTask;
+    angle::WaitableEvent linkEvent;
+};
+
 Error Program::link(const gl::Context *context)
 {
     const auto &data = context->getContextState();
 
+    // A link in flight reads the program state that is reset below.
+    resolveLink();
+
     unlink();
 
     mInfoLog.reset();
     resetUniformBlockBindings();
 
-    const Caps &caps = data.getCaps();
-
     auto vertexShader   = mState.mAttachedVertexShader;
     auto fragmentShader = mState.mAttachedFragmentShader;
     auto computeShader  = mState.mAttachedComputeShader;
 
+    // Skip the link entirely if an identical program was linked before. The cache is keyed on
+    // what the shaders were compiled from, so a hit doesn't wait for the compiles either.
+    ProgramCache *cache = context->getProgramCache();
+    ProgramHash programHash;
+    if (cache && !computeCacheHash(context, &programHash))
+    {
+        cache = nullptr;
+    }
+
+    if (cache)
+    {
+        const angle::MemoryBuffer *cachedBinary = cache->get(programHash);
+        if (cachedBinary)
+        {
+            ANGLE_TRY(loadBinary(context, GL_PROGRAM_BINARY_ANGLE, cachedBinary->data(),
+                                 static_cast<GLsizei>(cachedBinary->size())));
+            ANGLE_HISTOGRAM_BOOLEAN("GPU.ANGLE.ProgramCache.LoadBinarySuccess", mLinked);
+
+            if (mLinked)
+            {
+                // Binding qualifiers aren't part of the uniform values kept in the binary.
+                setUniformValuesFromBindingQualifiers();
+                return NoError();
+            }
+
+            // Don't keep a binary the implementation refuses to load, and link from scratch.
+            cache->remove(programHash);
+            unlink();
+            mInfoLog.reset();
+            resetUniformBlockBindings();
+        }
+    }
+
+    // Shaders compile asynchronously as well, their results are needed from here on.
+    std::vector<Shader *> attachedShaders;
+    for (Shader *shader : {vertexShader, fragmentShader, computeShader})
+    {
+        if (shader)
+        {
+            shader->resolveCompile();
+            attachedShaders.push_back(shader);
+        }
+    }
+
     bool isComputeShaderAttached   = (computeShader != nullptr);
     bool nonComputeShadersAttached = (vertexShader != nullptr || fragmentShader != nullptr);
     // Check whether we both have a compute and non-compute shaders attached.
@@ -621,34 +814,6 @@ Error Program::link(const gl::Context *context)
             return NoError();
         }
         ASSERT(computeShader->getType() == GL_COMPUTE_SHADER);
-
-        mState.mComputeShaderLocalSize = computeShader->getWorkGroupSize();
-
-        // GLSL ES 3.10, 4.4.1.1 Compute Shader Inputs
-        // If the work group size is not specified, a link time error should occur.
-        if (!mState.mComputeShaderLocalSize.isDeclared())
-        {
-            mInfoLog << "Work group size is not specified.";
-            return NoError();
-        }
-
-        if (!linkUniforms(mInfoLog, caps, mUniformLocationBindings))
-        {
-            return NoError();
-        }
-
-        if (!linkUniformBlocks(mInfoLog, caps))
-        {
-            return NoError();
-        }
-
-        gl::VaryingPacking noPacking(0, PackMode::ANGLE_RELAXED);
-        ANGLE_TRY_RESULT(mProgram->link(context->getImplementation(), noPacking, mInfoLog),
-                         mLinked);
-        if (!mLinked)
-        {
-            return NoError();
-        }
     }
     else
     {
@@ -669,65 +834,237 @@ Error Program::link(const gl::Context *context)
             mInfoLog << "Fragment shader version does not match vertex shader version.";
             return NoError();
         }
+    }
 
-        if (!linkAttributes(data, mInfoLog))
-        {
-            return NoError();
-        }
+    mLinkingState.reset(new LinkingState());
+    mLinkingState->context      = context;
+    mLinkingState->shaders      = std::move(attachedShaders);
+    mLinkingState->programCache = cache;
+    mLinkingState->programHash  = programHash;
+    mLinkingState->linkTask.reset(new LinkTask(this, data.getCaps(), isComputeShaderAttached,
+                                               data.getExtensions().webglCompatibility));
+
+    for (Shader *shader : mLinkingState->shaders)
+    {
+        shader->addPendingLink();
+    }
 
-        if (!linkVaryings(mInfoLog))
+    mLinkingState->linkEvent =
+        context->getWorkerThreadPool()->postWorkerTask(mLinkingState->linkTask.get());
+
+    // A program that is in use must be ready for the next draw.
+    if (getRefCount() > 0)
+    {
+        resolveLink();
+    }
+
+    return NoError();
+}
+
+bool Program::linkFrontEnd(const Caps &caps,
+                           VaryingPacking *varyingPacking,
+                           MergedVaryings *mergedVaryingsOut)
+{
+    if (mState.mAttachedComputeShader)
+    {
+        mState.mComputeShaderLocalSize = mState.mAttachedComputeShader->getWorkGroupSize();
+
+        // GLSL ES 3.10, 4.4.1.1 Compute Shader Inputs
+        // If the work group size is not specified, a link time error should occur.
+        if (!mState.mComputeShaderLocalSize.isDeclared())
         {
-            return NoError();
+            mInfoLog << "Work group size is not specified.";
+            return false;
         }
 
         if (!linkUniforms(mInfoLog, caps, mUniformLocationBindings))
         {
-            return NoError();
+            return false;
         }
 
         if (!linkUniformBlocks(mInfoLog, caps))
         {
-            return NoError();
+            return false;
         }
 
-        const auto &mergedVaryings = getMergedVaryings();
+        return true;
+    }
+
+    if (!linkAttributes(caps, mInfoLog))
+    {
+        return false;
+    }
+
+    if (!linkVaryings(mInfoLog))
+    {
+        return false;
+    }
+
+    if (!linkUniforms(mInfoLog, caps, mUniformLocationBindings))
+    {
+        return false;
+    }
+
+    if (!linkUniformBlocks(mInfoLog, caps))
+    {
+        return false;
+    }
+
+    *mergedVaryingsOut = getMergedVaryings();
+
+    if (!linkValidateTransformFeedback(mInfoLog, *mergedVaryingsOut, caps))
+    {
+        return false;
+    }
+
+    linkOutputVariables();
+
+    // Validate we can pack the varyings.
+    std::vector<PackedVarying> packedVaryings = getPackedVaryings(*mergedVaryingsOut);
+
+    // Map the varyings to the register file
+    // In WebGL, we use a slightly different handling for packing variables.
+    return varyingPacking->packUserVaryings(mInfoLog, packedVaryings,
+                                            mState.getTransformFeedbackVaryingNames());
+}
+
+void Program::resolveLinkImpl()
+{
+    ASSERT(mLinkingState);
+    mLinkingState->linkEvent.wait();
+
+    std::unique_ptr<LinkingState> linkingState(std::move(mLinkingState));
+    for (Shader *shader : linkingState->shaders)
+    {
+        shader->removePendingLink();
+    }
 
-        if (!linkValidateTransformFeedback(mInfoLog, mergedVaryings, caps))
+    if (linkingState->linkTask->getResult())
+    {
+        Error error = linkBackEnd(*linkingState);
+        if (error.isError())
         {
-            return NoError();
+            // There is no call to report the error from, fail the link instead.
+            mInfoLog << error.getMessage();
+            unlink();
         }
+    }
+
+    // Draw validation results cached while the link was in flight are stale.
+    mDrawValidationSerial++;
+}
 
-        linkOutputVariables();
+Error Program::linkBackEnd(const LinkingState &linkingState)
+{
+    const Context *context = linkingState.context;
+    const LinkTask &linkTask = *linkingState.linkTask;
 
-        // Validate we can pack the varyings.
-        std::vector<PackedVarying> packedVaryings = getPackedVaryings(mergedVaryings);
+    ANGLE_TRY_RESULT(
+        mProgram->link(context->getImplementation(), linkTask.getVaryingPacking(), mInfoLog),
+        mLinked);
+    if (!mLinked)
+    {
+        return NoError();
+    }
 
-        // Map the varyings to the register file
-        // In WebGL, we use a slightly different handling for packing variables.
-        auto packMode = data.getExtensions().webglCompatibility ? PackMode::WEBGL_STRICT
-                                                                : PackMode::ANGLE_RELAXED;
-        VaryingPacking varyingPacking(data.getCaps().maxVaryingVectors, packMode);
-        if (!varyingPacking.packUserVaryings(mInfoLog, packedVaryings,
-                                             mState.getTransformFeedbackVaryingNames()))
+    if (!mState.mAttachedComputeShader)
+    {
+        gatherTransformFeedbackVaryings(linkTask.getMergedVaryings());
+    }
+
+    gatherInterfaceBlockInfo();
+
+    indexResourceNames();
+
+    ANGLE_TRY(initUniformData());
+
+    setUniformValuesFromBindingQualifiers();
+
+    ProgramCache *cache = linkingState.programCache;
+    if (cache)
+    {
+        BinaryOutputStream stream;
+        ANGLE_TRY(serialize(context, &stream));
+
+        angle::MemoryBuffer binary;
+        if (binary.resize(stream.length()))
         {
-            return NoError();
+            memcpy(binary.data(), stream.data(), stream.length());
+            cache->put(linkingState.programHash, std::move(binary));
         }
 
-        ANGLE_TRY_RESULT(mProgram->link(context->getImplementation(), varyingPacking, mInfoLog),
-                         mLinked);
-        if (!mLinked)
+        ANGLE_HISTOGRAM_COUNTS("GPU.ANGLE.ProgramCache.ProgramCacheSizeKB",
+                               static_cast<int>(cache->size() / 1024));
+    }
+
+    return NoError();
+}
+
+bool Program::computeCacheHash(const Context *context, ProgramHash *hashOut) const
+{
+    BinaryOutputStream hashStream;
+
+    // The renderer and ANGLE revision determine the format of the binary.
+    hashStream.writeBytes(reinterpret_cast<const unsigned char *>(ANGLE_COMMIT_HASH),
+                          ANGLE_COMMIT_HASH_SIZE);
+    hashStream.writeString(context->getImplementation()->getRendererDescription());
+    hashStream.writeInt(context->getClientMajorVersion());
+    hashStream.writeInt(context->getClientMinorVersion());
+    hashStream.writeInt(context->getExtensions().webglCompatibility);
+
+    // The shader hashes cover their source, compile options and translator resources. Only the
+    // programs made of compiled shaders are cached, their links are deterministic.
+    const Shader *shaders[] = {mState.mAttachedVertexShader, mState.mAttachedFragmentShader,
+                               mState.mAttachedComputeShader};
+    bool anyShaderAttached = false;
+    for (const Shader *shader : shaders)
+    {
+        hashStream.writeInt(shader ? shader->getType() : GL_NONE);
+        if (shader)
         {
-            return NoError();
+            TranslatedShaderHash shaderHash;
+            if (!shader->getCompileHash(&shaderHash))
+            {
+                return false;
+            }
+            hashStream.writeBytes(shaderHash.data(), shaderHash.size());
+            anyShaderAttached = true;
         }
+    }
 
-        gatherTransformFeedbackVaryings(mergedVaryings);
+    if (!anyShaderAttached)
+    {
+        return false;
     }
 
-    setUniformValuesFromBindingQualifiers();
+    // Bindings are kept in unordered maps, sort them to get a stable hash.
+    for (const Bindings *bindings :
+         {&mAttributeBindings, &mUniformLocationBindings, &mFragmentInputBindings})
+    {
+        std::vector<std::pair<std::string, GLuint>> sortedBindings(bindings->begin(),
+                                                                   bindings->end());
+        std::sort(sortedBindings.begin(), sortedBindings.end());
 
-    gatherInterfaceBlockInfo();
+        hashStream.writeInt(sortedBindings.size());
+        for (const auto &binding : sortedBindings)
+        {
+            hashStream.writeString(binding.first);
+            hashStream.writeInt(binding.second);
+        }
+    }
 
-    return NoError();
+    const auto &transformFeedbackVaryingNames = mState.getTransformFeedbackVaryingNames();
+    hashStream.writeInt(transformFeedbackVaryingNames.size());
+    for (const std::string &name : transformFeedbackVaryingNames)
+    {
+        hashStream.writeString(name);
+    }
+    hashStream.writeInt(mState.getTransformFeedbackBufferMode());
+
+    static_assert(sizeof(ProgramHash) == 16, "MurmurHash3_x64_128 produces 128 bits");
+    MurmurHash3_x64_128(hashStream.data(), static_cast<int>(hashStream.length()), 0,
+                        hashOut->data());
+    return true;
 }
 
 // Returns the program object to an unlinked state, before re-linking, or at destruction
@@ -739,14 +1076,22 @@ void Program::unlink()
     mState.mUniforms.clear();
     mState.mUniformLocations.clear();
     mState.mUniformBlocks.clear();
+    mState.mUniformData.resize(0);
     mState.mOutputVariables.clear();
     mState.mOutputLocations.clear();
     mState.mComputeShaderLocalSize.fill(1);
     mState.mSamplerBindings.clear();
+    mState.mAttributeIndex.clear();
+    mState.mUniformIndex.clear();
+    mState.mUniformLocationIndex.clear();
+    mState.mUniformBlockIndex.clear();
+    mState.mOutputVariableIndex.clear();
 
     mValidated = false;
 
     mLinked = false;
+    mDrawValidationSerial++;
+    mDirtyUniformData = RangeUI(0, 0);
 }
 
 bool Program::isLinked() const
@@ -771,157 +1116,235 @@ Error Program::loadBinary(const Context *context,
         return NoError();
     }
 
-    BinaryInputStream stream(binary, length);
+    ProgramBinaryReader reader;
+    switch (reader.init(binary, static_cast<size_t>(length)))
+    {
+        case ProgramBinaryReader::Validity::Valid:
+            break;
+        case ProgramBinaryReader::Validity::WrongVersion:
+            mInfoLog << "Invalid program binary version.";
+            return NoError();
+        default:
+            mInfoLog << "Invalid program binary.";
+            return NoError();
+    }
 
-    unsigned char commitString[ANGLE_COMMIT_HASH_SIZE];
-    stream.readBytes(commitString, ANGLE_COMMIT_HASH_SIZE);
-    if (memcmp(commitString, ANGLE_COMMIT_HASH, sizeof(unsigned char) * ANGLE_COMMIT_HASH_SIZE) !=
-        0)
+    const ProgramBinaryHeader &header = reader.getHeader();
+    if (header.clientMajorVersion != context->getClientMajorVersion() ||
+        header.clientMinorVersion != context->getClientMinorVersion())
     {
-        mInfoLog << "Invalid program binary version.";
+        mInfoLog << "Cannot load program binaries across different ES context versions.";
         return NoError();
     }
 
-    int majorVersion = stream.readInt<int>();
-    int minorVersion = stream.readInt<int>();
-    if (majorVersion != context->getClientMajorVersion() ||
-        minorVersion != context->getClientMinorVersion())
+    if (!loadTables(&reader))
     {
-        mInfoLog << "Cannot load program binaries across different ES context versions.";
+        unlink();
+        mInfoLog << "Invalid program binary.";
         return NoError();
     }
 
-    mState.mComputeShaderLocalSize[0] = stream.readInt<int>();
-    mState.mComputeShaderLocalSize[1] = stream.readInt<int>();
-    mState.mComputeShaderLocalSize[2] = stream.readInt<int>();
+    ANGLE_TRY(initUniformData());
+
+    // The back-end data keeps its stream encoding, it is read from its range of the binary.
+    BinaryInputStream stream(reader.getImplementationData(), reader.getImplementationDataSize());
+    ANGLE_TRY_RESULT(mProgram->load(context->getImplementation(), mInfoLog, &stream), mLinked);
+
+    return NoError();
+#endif  // #if ANGLE_PROGRAM_BINARY_LOAD == ANGLE_ENABLED
+}
+
+bool Program::loadTables(ProgramBinaryReader *reader)
+{
+    const ProgramBinaryHeader &header = reader->getHeader();
+
+    mState.mComputeShaderLocalSize[0] = header.computeShaderLocalSize[0];
+    mState.mComputeShaderLocalSize[1] = header.computeShaderLocalSize[1];
+    mState.mComputeShaderLocalSize[2] = header.computeShaderLocalSize[2];
 
-    static_assert(MAX_VERTEX_ATTRIBS <= sizeof(unsigned long) * 8,
-                  "Too many vertex attribs for mask");
-    mState.mActiveAttribLocationsMask = stream.readInt<unsigned long>();
+    static_assert(MAX_VERTEX_ATTRIBS <= sizeof(uint32_t) * 8, "Too many vertex attribs for mask");
+    mState.mActiveAttribLocationsMask = header.activeAttribLocationsMask;
 
-    unsigned int attribCount = stream.readInt<unsigned int>();
+    size_t attribCount = 0;
+    const ProgramBinaryLocatedVariable *attribs =
+        reader->getTable<ProgramBinaryLocatedVariable>(PROGRAM_BINARY_ATTRIBUTES, &attribCount);
     ASSERT(mState.mAttributes.empty());
-    for (unsigned int attribIndex = 0; attribIndex < attribCount; ++attribIndex)
+    mState.mAttributes.resize(attribCount);
+    for (size_t attribIndex = 0; attribIndex < attribCount; ++attribIndex)
     {
-        sh::Attribute attrib;
-        LoadShaderVar(&stream, &attrib);
-        attrib.location = stream.readInt<int>();
-        mState.mAttributes.push_back(attrib);
+        sh::Attribute &attrib = mState.mAttributes[attribIndex];
+        LoadShaderVar(reader, attribs[attribIndex].variable, &attrib);
+        attrib.location = attribs[attribIndex].location;
     }
 
-    unsigned int uniformCount = stream.readInt<unsigned int>();
+    size_t uniformCount = 0;
+    const ProgramBinaryUniform *uniforms =
+        reader->getTable<ProgramBinaryUniform>(PROGRAM_BINARY_UNIFORMS, &uniformCount);
     ASSERT(mState.mUniforms.empty());
-    for (unsigned int uniformIndex = 0; uniformIndex < uniformCount; ++uniformIndex)
+    mState.mUniforms.resize(uniformCount);
+    for (size_t uniformIndex = 0; uniformIndex < uniformCount; ++uniformIndex)
     {
-        LinkedUniform uniform;
-        LoadShaderVar(&stream, &uniform);
-
-        uniform.blockIndex                 = stream.readInt<int>();
-        uniform.blockInfo.offset           = stream.readInt<int>();
-        uniform.blockInfo.arrayStride      = stream.readInt<int>();
-        uniform.blockInfo.matrixStride     = stream.readInt<int>();
-        uniform.blockInfo.isRowMajorMatrix = stream.readBool();
+        const ProgramBinaryUniform &record = uniforms[uniformIndex];
+        LinkedUniform &uniform             = mState.mUniforms[uniformIndex];
+        LoadShaderVar(reader, record.variable, &uniform);
 
-        mState.mUniforms.push_back(uniform);
+        uniform.binding                    = record.binding;
+        uniform.blockIndex                 = record.blockIndex;
+        uniform.blockInfo.offset           = record.blockOffset;
+        uniform.blockInfo.arrayStride      = record.blockArrayStride;
+        uniform.blockInfo.matrixStride     = record.blockMatrixStride;
+        uniform.blockInfo.isRowMajorMatrix = record.blockIsRowMajorMatrix != 0;
     }
 
-    const unsigned int uniformIndexCount = stream.readInt<unsigned int>();
+    size_t locationCount = 0;
+    const ProgramBinaryVariableLocation *locations =
+        reader->getTable<ProgramBinaryVariableLocation>(PROGRAM_BINARY_UNIFORM_LOCATIONS,
+                                                        &locationCount);
     ASSERT(mState.mUniformLocations.empty());
-    for (unsigned int uniformIndexIndex = 0; uniformIndexIndex < uniformIndexCount;
-         uniformIndexIndex++)
+    mState.mUniformLocations.resize(locationCount);
+    for (size_t locationIndex = 0; locationIndex < locationCount; ++locationIndex)
     {
-        VariableLocation variable;
-        stream.readString(&variable.name);
-        stream.readInt(&variable.element);
-        stream.readInt(&variable.index);
-        stream.readBool(&variable.used);
-        stream.readBool(&variable.ignored);
+        VariableLocation &variable = mState.mUniformLocations[locationIndex];
+        LoadVariableLocation(reader, locations[locationIndex], &variable);
 
-        mState.mUniformLocations.push_back(variable);
+        // The locations that are not used keep the default index of 0, even without uniforms.
+        if (variable.index >= uniformCount && (variable.used || variable.index != 0))
+        {
+            return false;
+        }
     }
 
-    unsigned int uniformBlockCount = stream.readInt<unsigned int>();
-    ASSERT(mState.mUniformBlocks.empty());
-    for (unsigned int uniformBlockIndex = 0; uniformBlockIndex < uniformBlockCount;
-         ++uniformBlockIndex)
-    {
-        UniformBlock uniformBlock;
-        stream.readString(&uniformBlock.name);
-        stream.readBool(&uniformBlock.isArray);
-        stream.readInt(&uniformBlock.arrayElement);
-        stream.readInt(&uniformBlock.dataSize);
-        stream.readBool(&uniformBlock.vertexStaticUse);
-        stream.readBool(&uniformBlock.fragmentStaticUse);
+    size_t memberCount = 0;
+    const uint32_t *members =
+        reader->getTable<uint32_t>(PROGRAM_BINARY_UNIFORM_BLOCK_MEMBERS, &memberCount);
 
-        unsigned int numMembers = stream.readInt<unsigned int>();
-        for (unsigned int blockMemberIndex = 0; blockMemberIndex < numMembers; blockMemberIndex++)
+    size_t uniformBlockCount = 0;
+    const ProgramBinaryUniformBlock *uniformBlocks =
+        reader->getTable<ProgramBinaryUniformBlock>(PROGRAM_BINARY_UNIFORM_BLOCKS,
+                                                    &uniformBlockCount);
+    ASSERT(mState.mUniformBlocks.empty());
+    mState.mUniformBlocks.resize(uniformBlockCount);
+    for (size_t uniformBlockIndex = 0; uniformBlockIndex < uniformBlockCount; ++uniformBlockIndex)
+    {
+        const ProgramBinaryUniformBlock &record = uniformBlocks[uniformBlockIndex];
+        UniformBlock &uniformBlock              = mState.mUniformBlocks[uniformBlockIndex];
+        uniformBlock.name                       = reader->getString(record.name);
+        uniformBlock.isArray                    = record.isArray != 0;
+        uniformBlock.arrayElement               = record.arrayElement;
+        uniformBlock.dataSize                   = record.dataSize;
+        uniformBlock.vertexStaticUse            = record.vertexStaticUse != 0;
+        uniformBlock.fragmentStaticUse          = record.fragmentStaticUse != 0;
+        uniformBlock.computeStaticUse           = record.computeStaticUse != 0;
+
+        if (record.firstMember > memberCount ||
+            record.memberCount > memberCount - record.firstMember)
         {
-            uniformBlock.memberUniformIndexes.push_back(stream.readInt<unsigned int>());
+            return false;
         }
+        const uint32_t *firstMember = members + record.firstMember;
+        uniformBlock.memberUniformIndexes.assign(firstMember, firstMember + record.memberCount);
+        for (unsigned int memberUniformIndex : uniformBlock.memberUniformIndexes)
+        {
+            if (memberUniformIndex >= uniformCount)
+            {
+                return false;
+            }
+        }
+    }
 
-        mState.mUniformBlocks.push_back(uniformBlock);
+    // Uniforms outside of blocks have a block index of -1.
+    for (const LinkedUniform &uniform : mState.mUniforms)
+    {
+        if (uniform.blockIndex < -1 || uniform.blockIndex >= static_cast<int>(uniformBlockCount))
+        {
+            return false;
+        }
     }
 
     for (GLuint bindingIndex = 0; bindingIndex < mState.mUniformBlockBindings.size();
          ++bindingIndex)
     {
-        stream.readInt(&mState.mUniformBlockBindings[bindingIndex]);
+        mState.mUniformBlockBindings[bindingIndex] = header.uniformBlockBindings[bindingIndex];
         mState.mActiveUniformBlockBindings.set(bindingIndex,
                                                mState.mUniformBlockBindings[bindingIndex] != 0);
     }
 
-    unsigned int transformFeedbackVaryingCount = stream.readInt<unsigned int>();
+    size_t varyingCount = 0;
+    const ProgramBinaryVarying *varyings = reader->getTable<ProgramBinaryVarying>(
+        PROGRAM_BINARY_TRANSFORM_FEEDBACK_VARYINGS, &varyingCount);
     ASSERT(mState.mTransformFeedbackVaryingVars.empty());
-    for (unsigned int transformFeedbackVaryingIndex = 0;
-        transformFeedbackVaryingIndex < transformFeedbackVaryingCount;
-        ++transformFeedbackVaryingIndex)
+    mState.mTransformFeedbackVaryingVars.resize(varyingCount);
+    for (size_t varyingIndex = 0; varyingIndex < varyingCount; ++varyingIndex)
     {
-        sh::Varying varying;
-        stream.readInt(&varying.arraySize);
-        stream.readInt(&varying.type);
-        stream.readString(&varying.name);
-
-        mState.mTransformFeedbackVaryingVars.push_back(varying);
+        sh::Varying &varying = mState.mTransformFeedbackVaryingVars[varyingIndex];
+        varying.name         = reader->getString(varyings[varyingIndex].name);
+        varying.type         = varyings[varyingIndex].type;
+        varying.arraySize    = varyings[varyingIndex].arraySize;
     }
 
-    stream.readInt(&mState.mTransformFeedbackBufferMode);
+    mState.mTransformFeedbackBufferMode = header.transformFeedbackBufferMode;
 
-    unsigned int outputCount = stream.readInt<unsigned int>();
+    size_t outputCount = 0;
+    const ProgramBinaryLocatedVariable *outputs =
+        reader->getTable<ProgramBinaryLocatedVariable>(PROGRAM_BINARY_OUTPUT_VARIABLES,
+                                                       &outputCount);
     ASSERT(mState.mOutputVariables.empty());
-    for (unsigned int outputIndex = 0; outputIndex < outputCount; ++outputIndex)
+    mState.mOutputVariables.resize(outputCount);
+    for (size_t outputIndex = 0; outputIndex < outputCount; ++outputIndex)
     {
-        sh::OutputVariable output;
-        LoadShaderVar(&stream, &output);
-        output.location = stream.readInt<int>();
-        mState.mOutputVariables.push_back(output);
+        sh::OutputVariable &output = mState.mOutputVariables[outputIndex];
+        LoadShaderVar(reader, outputs[outputIndex].variable, &output);
+        output.location = outputs[outputIndex].location;
     }
 
-    unsigned int outputVarCount = stream.readInt<unsigned int>();
-    for (unsigned int outputIndex = 0; outputIndex < outputVarCount; ++outputIndex)
+    size_t outputLocationCount = 0;
+    const ProgramBinaryVariableLocation *outputLocations =
+        reader->getTable<ProgramBinaryVariableLocation>(PROGRAM_BINARY_OUTPUT_LOCATIONS,
+                                                        &outputLocationCount);
+    for (size_t outputIndex = 0; outputIndex < outputLocationCount; ++outputIndex)
     {
-        int locationIndex = stream.readInt<int>();
-        VariableLocation locationData;
-        stream.readInt(&locationData.element);
-        stream.readInt(&locationData.index);
-        stream.readString(&locationData.name);
-        mState.mOutputLocations[locationIndex] = locationData;
+        const ProgramBinaryVariableLocation &record = outputLocations[outputIndex];
+        if (record.index >= outputCount)
+        {
+            return false;
+        }
+        LoadVariableLocation(reader, record, &mState.mOutputLocations[record.location]);
     }
 
-    stream.readInt(&mState.mSamplerUniformRange.start);
-    stream.readInt(&mState.mSamplerUniformRange.end);
-
-    unsigned int samplerCount = stream.readInt<unsigned int>();
-    for (unsigned int samplerIndex = 0; samplerIndex < samplerCount; ++samplerIndex)
+    mState.mSamplerUniformRange.start = header.samplerUniformRangeStart;
+    mState.mSamplerUniformRange.end   = header.samplerUniformRangeEnd;
+    if (mState.mSamplerUniformRange.start > mState.mSamplerUniformRange.end ||
+        mState.mSamplerUniformRange.end > uniformCount)
     {
-        GLenum textureType  = stream.readInt<GLenum>();
-        size_t bindingCount = stream.readInt<size_t>();
-        mState.mSamplerBindings.emplace_back(SamplerBinding(textureType, bindingCount));
+        return false;
     }
 
-    ANGLE_TRY_RESULT(mProgram->load(context->getImplementation(), mInfoLog, &stream), mLinked);
+    size_t samplerCount = 0;
+    const ProgramBinarySamplerBinding *samplers =
+        reader->getTable<ProgramBinarySamplerBinding>(PROGRAM_BINARY_SAMPLER_BINDINGS,
+                                                      &samplerCount);
+    mState.mSamplerBindings.reserve(samplerCount);
+    for (size_t samplerIndex = 0; samplerIndex < samplerCount; ++samplerIndex)
+    {
+        // A sampler array can't have more elements than there are texture units.
+        if (samplers[samplerIndex].elementCount > IMPLEMENTATION_MAX_ACTIVE_TEXTURES)
+        {
+            return false;
+        }
+        mState.mSamplerBindings.emplace_back(samplers[samplerIndex].textureType,
+                                             samplers[samplerIndex].elementCount);
+    }
 
-    return NoError();
-#endif  // #if ANGLE_PROGRAM_BINARY_LOAD == ANGLE_ENABLED
+    // The values of the name indices index the lists loaded above. Without uniforms, no location
+    // can be named, even if there are unused ones.
+    return mState.mAttributeIndex.load(reader, PROGRAM_BINARY_ATTRIBUTE_INDEX, attribCount) &&
+           mState.mUniformIndex.load(reader, PROGRAM_BINARY_UNIFORM_INDEX, uniformCount) &&
+           mState.mUniformLocationIndex.load(reader, PROGRAM_BINARY_UNIFORM_LOCATION_INDEX,
+                                             uniformCount > 0 ? locationCount : 0) &&
+           mState.mUniformBlockIndex.load(reader, PROGRAM_BINARY_UNIFORM_BLOCK_INDEX,
+                                          uniformBlockCount) &&
+           mState.mOutputVariableIndex.load(reader, PROGRAM_BINARY_OUTPUT_VARIABLE_INDEX,
+                                            outputCount);
 }
 
 Error Program::saveBinary(const Context *context,
@@ -936,150 +1359,168 @@ Error Program::saveBinary(const Context *context,
     }
 
     BinaryOutputStream stream;
+    ANGLE_TRY(serialize(context, &stream));
 
-    stream.writeBytes(reinterpret_cast<const unsigned char*>(ANGLE_COMMIT_HASH), ANGLE_COMMIT_HASH_SIZE);
+    GLsizei streamLength   = static_cast<GLsizei>(stream.length());
+    const void *streamState = stream.data();
 
-    // nullptr context is supported when computing binary length.
-    if (context)
+    if (streamLength > bufSize)
     {
-        stream.writeInt(context->getClientVersion().major);
-        stream.writeInt(context->getClientVersion().minor);
+        if (length)
+        {
+            *length = 0;
+        }
+
+        // TODO: This should be moved to the validation layer but computing the size of the binary before saving
+        // it causes the save to happen twice.  It may be possible to write the binary to a separate buffer, validate
+        // sizes and then copy it.
+        return Error(GL_INVALID_OPERATION);
     }
-    else
+
+    if (binary)
     {
-        stream.writeInt(2);
-        stream.writeInt(0);
-    }
+        char *ptr = reinterpret_cast<char*>(binary);
 
-    stream.writeInt(mState.mComputeShaderLocalSize[0]);
-    stream.writeInt(mState.mComputeShaderLocalSize[1]);
-    stream.writeInt(mState.mComputeShaderLocalSize[2]);
+        memcpy(ptr, streamState, streamLength);
+        ptr += streamLength;
 
-    stream.writeInt(mState.mActiveAttribLocationsMask.to_ulong());
+        ASSERT(ptr - streamLength == binary);
+    }
 
-    stream.writeInt(mState.mAttributes.size());
-    for (const sh::Attribute &attrib : mState.mAttributes)
+    if (length)
     {
-        WriteShaderVar(&stream, attrib);
-        stream.writeInt(attrib.location);
+        *length = streamLength;
     }
 
-    stream.writeInt(mState.mUniforms.size());
-    for (const LinkedUniform &uniform : mState.mUniforms)
-    {
-        WriteShaderVar(&stream, uniform);
+    return NoError();
+}
 
-        // FIXME: referenced
+Error Program::serialize(const Context *context, BinaryOutputStream *outStream) const
+{
+    ProgramBinaryWriter writer;
+    ProgramBinaryHeader *header = writer.getHeader();
 
-        stream.writeInt(uniform.blockIndex);
-        stream.writeInt(uniform.blockInfo.offset);
-        stream.writeInt(uniform.blockInfo.arrayStride);
-        stream.writeInt(uniform.blockInfo.matrixStride);
-        stream.writeInt(uniform.blockInfo.isRowMajorMatrix);
-    }
+    // nullptr context is supported when computing binary length.
+    header->clientMajorVersion = context ? context->getClientVersion().major : 2;
+    header->clientMinorVersion = context ? context->getClientVersion().minor : 0;
+
+    header->computeShaderLocalSize[0] = mState.mComputeShaderLocalSize[0];
+    header->computeShaderLocalSize[1] = mState.mComputeShaderLocalSize[1];
+    header->computeShaderLocalSize[2] = mState.mComputeShaderLocalSize[2];
 
-    stream.writeInt(mState.mUniformLocations.size());
-    for (const auto &variable : mState.mUniformLocations)
+    header->activeAttribLocationsMask = static_cast<uint32_t>(
+        mState.mActiveAttribLocationsMask.to_ulong());
+
+    std::vector<ProgramBinaryLocatedVariable> attribs;
+    attribs.reserve(mState.mAttributes.size());
+    for (const sh::Attribute &attrib : mState.mAttributes)
     {
-        stream.writeString(variable.name);
-        stream.writeInt(variable.element);
-        stream.writeInt(variable.index);
-        stream.writeInt(variable.used);
-        stream.writeInt(variable.ignored);
+        attribs.push_back({WriteShaderVar(&writer, attrib), attrib.location});
     }
+    writer.setTable(PROGRAM_BINARY_ATTRIBUTES, attribs);
 
-    stream.writeInt(mState.mUniformBlocks.size());
-    for (const UniformBlock &uniformBlock : mState.mUniformBlocks)
+    std::vector<ProgramBinaryUniform> uniforms;
+    uniforms.reserve(mState.mUniforms.size());
+    for (const LinkedUniform &uniform : mState.mUniforms)
     {
-        stream.writeString(uniformBlock.name);
-        stream.writeInt(uniformBlock.isArray);
-        stream.writeInt(uniformBlock.arrayElement);
-        stream.writeInt(uniformBlock.dataSize);
+        ProgramBinaryUniform record;
+        record.variable = WriteShaderVar(&writer, uniform);
 
-        stream.writeInt(uniformBlock.vertexStaticUse);
-        stream.writeInt(uniformBlock.fragmentStaticUse);
+        // FIXME: referenced
 
-        stream.writeInt(uniformBlock.memberUniformIndexes.size());
-        for (unsigned int memberUniformIndex : uniformBlock.memberUniformIndexes)
-        {
-            stream.writeInt(memberUniformIndex);
-        }
+        record.binding               = uniform.binding;
+        record.blockIndex            = uniform.blockIndex;
+        record.blockOffset           = uniform.blockInfo.offset;
+        record.blockArrayStride      = uniform.blockInfo.arrayStride;
+        record.blockMatrixStride     = uniform.blockInfo.matrixStride;
+        record.blockIsRowMajorMatrix = uniform.blockInfo.isRowMajorMatrix;
+        uniforms.push_back(record);
     }
+    writer.setTable(PROGRAM_BINARY_UNIFORMS, uniforms);
 
-    for (GLuint binding : mState.mUniformBlockBindings)
+    std::vector<ProgramBinaryVariableLocation> locations;
+    locations.reserve(mState.mUniformLocations.size());
+    for (size_t location = 0; location < mState.mUniformLocations.size(); ++location)
     {
-        stream.writeInt(binding);
+        locations.push_back(WriteVariableLocation(&writer, static_cast<int>(location),
+                                                  mState.mUniformLocations[location]));
     }
+    writer.setTable(PROGRAM_BINARY_UNIFORM_LOCATIONS, locations);
 
-    stream.writeInt(mState.mTransformFeedbackVaryingVars.size());
+    std::vector<ProgramBinaryUniformBlock> uniformBlocks;
+    std::vector<uint32_t> members;
+    uniformBlocks.reserve(mState.mUniformBlocks.size());
+    for (const UniformBlock &uniformBlock : mState.mUniformBlocks)
+    {
+        ProgramBinaryUniformBlock record;
+        record.name              = writer.addString(uniformBlock.name);
+        record.isArray           = uniformBlock.isArray;
+        record.arrayElement      = uniformBlock.arrayElement;
+        record.dataSize          = uniformBlock.dataSize;
+        record.vertexStaticUse   = uniformBlock.vertexStaticUse;
+        record.fragmentStaticUse = uniformBlock.fragmentStaticUse;
+        record.computeStaticUse  = uniformBlock.computeStaticUse;
+        record.firstMember       = static_cast<uint32_t>(members.size());
+        record.memberCount       = static_cast<uint32_t>(uniformBlock.memberUniformIndexes.size());
+        members.insert(members.end(), uniformBlock.memberUniformIndexes.begin(),
+                       uniformBlock.memberUniformIndexes.end());
+        uniformBlocks.push_back(record);
+    }
+    writer.setTable(PROGRAM_BINARY_UNIFORM_BLOCKS, uniformBlocks);
+    writer.setTable(PROGRAM_BINARY_UNIFORM_BLOCK_MEMBERS, members);
+
+    std::copy(mState.mUniformBlockBindings.begin(), mState.mUniformBlockBindings.end(),
+              header->uniformBlockBindings);
+
+    std::vector<ProgramBinaryVarying> varyings;
+    varyings.reserve(mState.mTransformFeedbackVaryingVars.size());
     for (const sh::Varying &varying : mState.mTransformFeedbackVaryingVars)
     {
-        stream.writeInt(varying.arraySize);
-        stream.writeInt(varying.type);
-        stream.writeString(varying.name);
+        varyings.push_back({writer.addString(varying.name), varying.type, varying.arraySize});
     }
+    writer.setTable(PROGRAM_BINARY_TRANSFORM_FEEDBACK_VARYINGS, varyings);
 
-    stream.writeInt(mState.mTransformFeedbackBufferMode);
+    header->transformFeedbackBufferMode = mState.mTransformFeedbackBufferMode;
 
-    stream.writeInt(mState.mOutputVariables.size());
+    std::vector<ProgramBinaryLocatedVariable> outputs;
+    outputs.reserve(mState.mOutputVariables.size());
     for (const sh::OutputVariable &output : mState.mOutputVariables)
     {
-        WriteShaderVar(&stream, output);
-        stream.writeInt(output.location);
+        outputs.push_back({WriteShaderVar(&writer, output), output.location});
     }
+    writer.setTable(PROGRAM_BINARY_OUTPUT_VARIABLES, outputs);
 
-    stream.writeInt(mState.mOutputLocations.size());
+    std::vector<ProgramBinaryVariableLocation> outputLocations;
+    outputLocations.reserve(mState.mOutputLocations.size());
     for (const auto &outputPair : mState.mOutputLocations)
     {
-        stream.writeInt(outputPair.first);
-        stream.writeIntOrNegOne(outputPair.second.element);
-        stream.writeInt(outputPair.second.index);
-        stream.writeString(outputPair.second.name);
+        outputLocations.push_back(
+            WriteVariableLocation(&writer, outputPair.first, outputPair.second));
     }
+    writer.setTable(PROGRAM_BINARY_OUTPUT_LOCATIONS, outputLocations);
 
-    stream.writeInt(mState.mSamplerUniformRange.start);
-    stream.writeInt(mState.mSamplerUniformRange.end);
+    header->samplerUniformRangeStart = mState.mSamplerUniformRange.start;
+    header->samplerUniformRangeEnd   = mState.mSamplerUniformRange.end;
 
-    stream.writeInt(mState.mSamplerBindings.size());
+    std::vector<ProgramBinarySamplerBinding> samplers;
+    samplers.reserve(mState.mSamplerBindings.size());
     for (const auto &samplerBinding : mState.mSamplerBindings)
     {
-        stream.writeInt(samplerBinding.textureType);
-        stream.writeInt(samplerBinding.boundTextureUnits.size());
+        samplers.push_back({samplerBinding.textureType,
+                            static_cast<uint32_t>(samplerBinding.boundTextureUnits.size())});
     }
+    writer.setTable(PROGRAM_BINARY_SAMPLER_BINDINGS, samplers);
 
-    ANGLE_TRY(mProgram->save(&stream));
+    mState.mAttributeIndex.save(&writer, PROGRAM_BINARY_ATTRIBUTE_INDEX);
+    mState.mUniformIndex.save(&writer, PROGRAM_BINARY_UNIFORM_INDEX);
+    mState.mUniformLocationIndex.save(&writer, PROGRAM_BINARY_UNIFORM_LOCATION_INDEX);
+    mState.mUniformBlockIndex.save(&writer, PROGRAM_BINARY_UNIFORM_BLOCK_INDEX);
+    mState.mOutputVariableIndex.save(&writer, PROGRAM_BINARY_OUTPUT_VARIABLE_INDEX);
 
-    GLsizei streamLength   = static_cast<GLsizei>(stream.length());
-    const void *streamState = stream.data();
-
-    if (streamLength > bufSize)
-    {
-        if (length)
-        {
-            *length = 0;
-        }
-
-        // TODO: This should be moved to the validation layer but computing the size of the binary before saving
-        // it causes the save to happen twice.  It may be possible to write the binary to a separate buffer, validate
-        // sizes and then copy it.
-        return Error(GL_INVALID_OPERATION);
-    }
-
-    if (binary)
-    {
-        char *ptr = reinterpret_cast<char*>(binary);
-
-        memcpy(ptr, streamState, streamLength);
-        ptr += streamLength;
-
-        ASSERT(ptr - streamLength == binary);
-    }
-
-    if (length)
-    {
-        *length = streamLength;
-    }
+    BinaryOutputStream implementationData;
+    ANGLE_TRY(mProgram->save(&implementationData));
 
+    writer.write(implementationData, outStream);
     return NoError();
 }
 
@@ -1191,15 +1632,13 @@ void Program::getAttachedShaders(GLsizei maxCount, GLsizei *count, GLuint *shade
 
 GLuint Program::getAttributeLocation(const std::string &name) const
 {
-    for (const sh::Attribute &attribute : mState.mAttributes)
+    GLuint attributeIndex = mState.mAttributeIndex.find(name, 0);
+    if (attributeIndex == GL_INVALID_INDEX)
     {
-        if (attribute.name == name)
-        {
-            return attribute.location;
-        }
+        return static_cast<GLuint>(-1);
     }
 
-    return static_cast<GLuint>(-1);
+    return mState.mAttributes[attributeIndex].location;
 }
 
 bool Program::isAttribLocationActive(size_t attribLocation) const
@@ -1274,20 +1713,13 @@ GLint Program::getActiveAttributeMaxLength() const
 
 GLuint Program::getInputResourceIndex(const GLchar *name) const
 {
-    for (GLuint attributeIndex = 0; attributeIndex < mState.mAttributes.size(); ++attributeIndex)
-    {
-        const sh::Attribute &attribute = mState.mAttributes[attributeIndex];
-        if (attribute.name == name)
-        {
-            return attributeIndex;
-        }
-    }
-    return GL_INVALID_INDEX;
+    return mState.mAttributeIndex.find(name, 0);
 }
 
 GLuint Program::getOutputResourceIndex(const GLchar *name) const
 {
-    return GetResourceIndexFromName(mState.mOutputVariables, std::string(name));
+    return GetResourceIndexFromName(mState.mOutputVariables, mState.mOutputVariableIndex,
+                                    std::string(name));
 }
 
 size_t Program::getOutputResourceCount() const
@@ -1491,127 +1923,190 @@ GLuint Program::getUniformIndex(const std::string &name) const
 void Program::setUniform1fv(GLint location, GLsizei count, const GLfloat *v)
 {
     GLsizei clampedCount = setUniformInternal(location, count, 1, v);
-    mProgram->setUniform1fv(location, clampedCount, v);
+    if (clampedCount > 0)
+    {
+        mProgram->setUniform1fv(location, clampedCount, v);
+    }
 }
 
 void Program::setUniform2fv(GLint location, GLsizei count, const GLfloat *v)
 {
     GLsizei clampedCount = setUniformInternal(location, count, 2, v);
-    mProgram->setUniform2fv(location, clampedCount, v);
+    if (clampedCount > 0)
+    {
+        mProgram->setUniform2fv(location, clampedCount, v);
+    }
 }
 
 void Program::setUniform3fv(GLint location, GLsizei count, const GLfloat *v)
 {
     GLsizei clampedCount = setUniformInternal(location, count, 3, v);
-    mProgram->setUniform3fv(location, clampedCount, v);
+    if (clampedCount > 0)
+    {
+        mProgram->setUniform3fv(location, clampedCount, v);
+    }
 }
 
 void Program::setUniform4fv(GLint location, GLsizei count, const GLfloat *v)
 {
     GLsizei clampedCount = setUniformInternal(location, count, 4, v);
-    mProgram->setUniform4fv(location, clampedCount, v);
+    if (clampedCount > 0)
+    {
+        mProgram->setUniform4fv(location, clampedCount, v);
+    }
 }
 
 void Program::setUniform1iv(GLint location, GLsizei count, const GLint *v)
 {
     GLsizei clampedCount = setUniformInternal(location, count, 1, v);
-    mProgram->setUniform1iv(location, clampedCount, v);
+    if (clampedCount > 0)
+    {
+        mProgram->setUniform1iv(location, clampedCount, v);
+    }
 }
 
 void Program::setUniform2iv(GLint location, GLsizei count, const GLint *v)
 {
     GLsizei clampedCount = setUniformInternal(location, count, 2, v);
-    mProgram->setUniform2iv(location, clampedCount, v);
+    if (clampedCount > 0)
+    {
+        mProgram->setUniform2iv(location, clampedCount, v);
+    }
 }
 
 void Program::setUniform3iv(GLint location, GLsizei count, const GLint *v)
 {
     GLsizei clampedCount = setUniformInternal(location, count, 3, v);
-    mProgram->setUniform3iv(location, clampedCount, v);
+    if (clampedCount > 0)
+    {
+        mProgram->setUniform3iv(location, clampedCount, v);
+    }
 }
 
 void Program::setUniform4iv(GLint location, GLsizei count, const GLint *v)
 {
     GLsizei clampedCount = setUniformInternal(location, count, 4, v);
-    mProgram->setUniform4iv(location, clampedCount, v);
+    if (clampedCount > 0)
+    {
+        mProgram->setUniform4iv(location, clampedCount, v);
+    }
 }
 
 void Program::setUniform1uiv(GLint location, GLsizei count, const GLuint *v)
 {
     GLsizei clampedCount = setUniformInternal(location, count, 1, v);
-    mProgram->setUniform1uiv(location, clampedCount, v);
+    if (clampedCount > 0)
+    {
+        mProgram->setUniform1uiv(location, clampedCount, v);
+    }
 }
 
 void Program::setUniform2uiv(GLint location, GLsizei count, const GLuint *v)
 {
     GLsizei clampedCount = setUniformInternal(location, count, 2, v);
-    mProgram->setUniform2uiv(location, clampedCount, v);
+    if (clampedCount > 0)
+    {
+        mProgram->setUniform2uiv(location, clampedCount, v);
+    }
 }
 
 void Program::setUniform3uiv(GLint location, GLsizei count, const GLuint *v)
 {
     GLsizei clampedCount = setUniformInternal(location, count, 3, v);
-    mProgram->setUniform3uiv(location, clampedCount, v);
+    if (clampedCount > 0)
+    {
+        mProgram->setUniform3uiv(location, clampedCount, v);
+    }
 }
 
 void Program::setUniform4uiv(GLint location, GLsizei count, const GLuint *v)
 {
     GLsizei clampedCount = setUniformInternal(location, count, 4, v);
-    mProgram->setUniform4uiv(location, clampedCount, v);
+    if (clampedCount > 0)
+    {
+        mProgram->setUniform4uiv(location, clampedCount, v);
+    }
 }
 
 void Program::setUniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *v)
 {
     GLsizei clampedCount = setMatrixUniformInternal<2, 2>(location, count, transpose, v);
-    mProgram->setUniformMatrix2fv(location, clampedCount, transpose, v);
+    if (clampedCount > 0)
+    {
+        mProgram->setUniformMatrix2fv(location, clampedCount, transpose, v);
+    }
 }
 
 void Program::setUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *v)
 {
     GLsizei clampedCount = setMatrixUniformInternal<3, 3>(location, count, transpose, v);
-    mProgram->setUniformMatrix3fv(location, clampedCount, transpose, v);
+    if (clampedCount > 0)
+    {
+        mProgram->setUniformMatrix3fv(location, clampedCount, transpose, v);
+    }
 }
 
 void Program::setUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *v)
 {
     GLsizei clampedCount = setMatrixUniformInternal<4, 4>(location, count, transpose, v);
-    mProgram->setUniformMatrix4fv(location, clampedCount, transpose, v);
+    if (clampedCount > 0)
+    {
+        mProgram->setUniformMatrix4fv(location, clampedCount, transpose, v);
+    }
 }
 
 void Program::setUniformMatrix2x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *v)
 {
     GLsizei clampedCount = setMatrixUniformInternal<2, 3>(location, count, transpose, v);
-    mProgram->setUniformMatrix2x3fv(location, clampedCount, transpose, v);
+    if (clampedCount > 0)
+    {
+        mProgram->setUniformMatrix2x3fv(location, clampedCount, transpose, v);
+    }
 }
 
 void Program::setUniformMatrix2x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *v)
 {
     GLsizei clampedCount = setMatrixUniformInternal<2, 4>(location, count, transpose, v);
-    mProgram->setUniformMatrix2x4fv(location, clampedCount, transpose, v);
+    if (clampedCount > 0)
+    {
+        mProgram->setUniformMatrix2x4fv(location, clampedCount, transpose, v);
+    }
 }
 
 void Program::setUniformMatrix3x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *v)
 {
     GLsizei clampedCount = setMatrixUniformInternal<3, 2>(location, count, transpose, v);
-    mProgram->setUniformMatrix3x2fv(location, clampedCount, transpose, v);
+    if (clampedCount > 0)
+    {
+        mProgram->setUniformMatrix3x2fv(location, clampedCount, transpose, v);
+    }
 }
 
 void Program::setUniformMatrix3x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *v)
 {
     GLsizei clampedCount = setMatrixUniformInternal<3, 4>(location, count, transpose, v);
-    mProgram->setUniformMatrix3x4fv(location, clampedCount, transpose, v);
+    if (clampedCount > 0)
+    {
+        mProgram->setUniformMatrix3x4fv(location, clampedCount, transpose, v);
+    }
 }
 
 void Program::setUniformMatrix4x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *v)
 {
     GLsizei clampedCount = setMatrixUniformInternal<4, 2>(location, count, transpose, v);
-    mProgram->setUniformMatrix4x2fv(location, clampedCount, transpose, v);
+    if (clampedCount > 0)
+    {
+        mProgram->setUniformMatrix4x2fv(location, clampedCount, transpose, v);
+    }
 }
 
 void Program::setUniformMatrix4x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *v)
 {
     GLsizei clampedCount = setMatrixUniformInternal<4, 3>(location, count, transpose, v);
-    mProgram->setUniformMatrix4x3fv(location, clampedCount, transpose, v);
+    if (clampedCount > 0)
+    {
+        mProgram->setUniformMatrix4x3fv(location, clampedCount, transpose, v);
+    }
 }
 
 void Program::getUniformfv(GLint location, GLfloat *v) const
@@ -1779,23 +2274,9 @@ GLuint Program::getUniformBlockIndex(const std::string &name) const
     size_t subscript     = GL_INVALID_INDEX;
     std::string baseName = ParseResourceName(name, &subscript);
 
-    unsigned int numUniformBlocks = static_cast<unsigned int>(mState.mUniformBlocks.size());
-    for (unsigned int blockIndex = 0; blockIndex < numUniformBlocks; blockIndex++)
-    {
-        const UniformBlock &uniformBlock = mState.mUniformBlocks[blockIndex];
-        if (uniformBlock.name == baseName)
-        {
-            const bool arrayElementZero =
-                (subscript == GL_INVALID_INDEX &&
-                 (!uniformBlock.isArray || uniformBlock.arrayElement == 0));
-            if (subscript == uniformBlock.arrayElement || arrayElementZero)
-            {
-                return blockIndex;
-            }
-        }
-    }
-
-    return GL_INVALID_INDEX;
+    // Blocks that aren't arrays are listed as element zero.
+    return mState.mUniformBlockIndex.find(baseName,
+                                          subscript == GL_INVALID_INDEX ? 0 : subscript);
 }
 
 const UniformBlock &Program::getUniformBlockByIndex(GLuint index) const
@@ -1809,6 +2290,7 @@ void Program::bindUniformBlock(GLuint uniformBlockIndex, GLuint uniformBlockBind
     mState.mUniformBlockBindings[uniformBlockIndex] = uniformBlockBinding;
     mState.mActiveUniformBlockBindings.set(uniformBlockIndex, uniformBlockBinding != 0);
     mProgram->setUniformBlockBinding(uniformBlockIndex, uniformBlockBinding);
+    mDrawValidationSerial++;
 }
 
 GLuint Program::getUniformBlockBinding(GLuint uniformBlockIndex) const
@@ -2036,13 +2518,13 @@ bool Program::linkValidateInterfaceBlockFields(InfoLog &infoLog,
 }
 
 // Assigns locations to all attributes from the bindings and program locations.
-bool Program::linkAttributes(const ContextState &data, InfoLog &infoLog)
+bool Program::linkAttributes(const Caps &caps, InfoLog &infoLog)
 {
     const auto *vertexShader = mState.getAttachedVertexShader();
 
     unsigned int usedLocations = 0;
     mState.mAttributes         = vertexShader->getActiveAttributes();
-    GLuint maxAttribs          = data.getCaps().maxVertexAttributes;
+    GLuint maxAttribs          = caps.maxVertexAttributes;
 
     // TODO(jmadill): handle aliasing robustly
     if (mState.mAttributes.size() > maxAttribs)
@@ -2652,6 +3134,67 @@ void Program::setUniformValuesFromBindingQualifiers()
     }
 }
 
+void Program::indexResourceNames()
+{
+    for (GLuint attributeIndex = 0; attributeIndex < mState.mAttributes.size(); ++attributeIndex)
+    {
+        mState.mAttributeIndex.add(mState.mAttributes[attributeIndex].name, 0, attributeIndex);
+    }
+
+    for (GLuint uniformIndex = 0; uniformIndex < mState.mUniforms.size(); ++uniformIndex)
+    {
+        mState.mUniformIndex.add(mState.mUniforms[uniformIndex].name, 0, uniformIndex);
+    }
+
+    for (GLuint location = 0; location < mState.mUniformLocations.size(); ++location)
+    {
+        const VariableLocation &uniformLocation = mState.mUniformLocations[location];
+        if (uniformLocation.used)
+        {
+            mState.mUniformLocationIndex.add(mState.mUniforms[uniformLocation.index].name,
+                                             uniformLocation.element, location);
+        }
+    }
+
+    for (GLuint blockIndex = 0; blockIndex < mState.mUniformBlocks.size(); ++blockIndex)
+    {
+        const UniformBlock &uniformBlock = mState.mUniformBlocks[blockIndex];
+        mState.mUniformBlockIndex.add(uniformBlock.name, uniformBlock.arrayElement, blockIndex);
+    }
+
+    for (GLuint outputIndex = 0; outputIndex < mState.mOutputVariables.size(); ++outputIndex)
+    {
+        mState.mOutputVariableIndex.add(mState.mOutputVariables[outputIndex].name, 0,
+                                        outputIndex);
+    }
+}
+
+Error Program::initUniformData()
+{
+    size_t dataSize = 0;
+    for (LinkedUniform &uniform : mState.mUniforms)
+    {
+        if (!uniform.isInDefaultBlock())
+        {
+            continue;
+        }
+
+        uniform.dataOffset = dataSize;
+        dataSize += rx::roundUp(uniform.dataSize(), static_cast<size_t>(16));
+    }
+
+    if (!mState.mUniformData.resize(dataSize))
+    {
+        return OutOfMemory() << "Failed to allocate uniform data.";
+    }
+    if (dataSize > 0)
+    {
+        memset(mState.mUniformData.data(), 0, dataSize);
+    }
+
+    return NoError();
+}
+
 void Program::gatherInterfaceBlockInfo()
 {
     ASSERT(mState.mUniformBlocks.empty());
@@ -2872,6 +3415,7 @@ void Program::updateSamplerUniform(const VariableLocation &locationInfo,
 
         std::copy(v, v + clampedCount, boundTextureUnits->begin() + locationInfo.element);
         mCachedValidateSamplersResult.reset();
+        mDrawValidationSerial++;
     }
 }
 
@@ -2888,7 +3432,8 @@ GLsizei Program::setUniformInternal(GLint location, GLsizei countIn, int vectorS
 {
     const VariableLocation &locationInfo = mState.mUniformLocations[location];
     LinkedUniform *linkedUniform         = &mState.mUniforms[locationInfo.index];
-    uint8_t *destPointer                 = linkedUniform->getDataPtrToElement(locationInfo.element);
+    uint8_t *destPointer =
+        mState.mUniformData.data() + GetUniformDataOffset(*linkedUniform, locationInfo);
 
     // OpenGL ES 3.0.4 spec pg 67: "Values for any array element that exceeds the highest array
     // element index used, as reported by GetActiveUniform, will be ignored by the GL."
@@ -2909,15 +3454,31 @@ GLsizei Program::setUniformInternal(GLint location, GLsizei countIn, int vectorS
         // Do a cast conversion for boolean types. From the spec:
         // "The uniform is set to FALSE if the input value is 0 or 0.0f, and set to TRUE otherwise."
         GLint *destAsInt = reinterpret_cast<GLint *>(destPointer);
+        bool changed     = false;
         for (GLsizei component = 0; component < clampedCount; ++component)
         {
-            destAsInt[component] = (v[component] != static_cast<T>(0) ? GL_TRUE : GL_FALSE);
+            GLint value = (v[component] != static_cast<T>(0) ? GL_TRUE : GL_FALSE);
+            changed     = changed || (destAsInt[component] != value);
+            destAsInt[component] = value;
+        }
+
+        if (!changed)
+        {
+            return 0;
         }
+        markUniformDataDirty(destPointer, sizeof(GLint) * clampedCount);
     }
     else
     {
+        // Applications often set uniforms to the values they already have, skip those.
+        if (memcmp(destPointer, v, sizeof(T) * clampedCount) == 0)
+        {
+            return 0;
+        }
+
         updateSamplerUniform(locationInfo, destPointer, clampedCount, v);
         memcpy(destPointer, v, sizeof(T) * clampedCount);
+        markUniformDataDirty(destPointer, sizeof(T) * clampedCount);
     }
 
     return count;
@@ -2937,36 +3498,78 @@ GLsizei Program::setMatrixUniformInternal(GLint location,
     // Perform a transposing copy.
     const VariableLocation &locationInfo = mState.mUniformLocations[location];
     LinkedUniform *linkedUniform         = &mState.mUniforms[locationInfo.index];
-    T *destPtr = reinterpret_cast<T *>(linkedUniform->getDataPtrToElement(locationInfo.element));
+    uint8_t *destPointer =
+        mState.mUniformData.data() + GetUniformDataOffset(*linkedUniform, locationInfo);
+    T *destPtr = reinterpret_cast<T *>(destPointer);
 
     // OpenGL ES 3.0.4 spec pg 67: "Values for any array element that exceeds the highest array
     // element index used, as reported by GetActiveUniform, will be ignored by the GL."
     unsigned int remainingElements = linkedUniform->elementCount() - locationInfo.element;
     GLsizei clampedCount           = std::min(count, static_cast<GLsizei>(remainingElements));
 
+    bool changed = false;
     for (GLsizei element = 0; element < clampedCount; ++element)
     {
         size_t elementOffset = element * rows * cols;
 
+        T transposed[rows * cols];
         for (size_t row = 0; row < rows; ++row)
         {
             for (size_t col = 0; col < cols; ++col)
             {
-                destPtr[col * rows + row + elementOffset] = v[row * cols + col + elementOffset];
+                transposed[col * rows + row] = v[row * cols + col + elementOffset];
             }
         }
+
+        if (memcmp(destPtr + elementOffset, transposed, sizeof(transposed)) != 0)
+        {
+            memcpy(destPtr + elementOffset, transposed, sizeof(transposed));
+            changed = true;
+        }
+    }
+
+    if (!changed)
+    {
+        return 0;
     }
+    markUniformDataDirty(destPointer, sizeof(T) * rows * cols * clampedCount);
 
     return clampedCount;
 }
 
+void Program::markUniformDataDirty(const uint8_t *dataPtr, size_t size)
+{
+    unsigned int start = static_cast<unsigned int>(dataPtr - mState.mUniformData.data());
+    unsigned int end   = start + static_cast<unsigned int>(size);
+
+    if (mDirtyUniformData.empty())
+    {
+        mDirtyUniformData = RangeUI(start, end);
+    }
+    else
+    {
+        mDirtyUniformData.start = std::min(mDirtyUniformData.start, start);
+        mDirtyUniformData.end   = std::max(mDirtyUniformData.end, end);
+    }
+}
+
+void Program::syncState()
+{
+    if (hasDirtyUniforms())
+    {
+        mProgram->syncUniforms(mDirtyUniformData);
+        mDirtyUniformData = RangeUI(0, 0);
+    }
+}
+
 template <typename DestT>
 void Program::getUniformInternal(GLint location, DestT *dataOut) const
 {
     const VariableLocation &locationInfo = mState.mUniformLocations[location];
     const LinkedUniform &uniform         = mState.mUniforms[locationInfo.index];
 
-    const uint8_t *srcPointer = uniform.getDataPtrToElement(locationInfo.element);
+    const uint8_t *srcPointer =
+        mState.mUniformData.data() + GetUniformDataOffset(uniform, locationInfo);
 
     GLenum componentType = VariableComponentType(uniform.type);
     if (componentType == GLTypeToGLenum<DestT>::value)
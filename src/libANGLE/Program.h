@@ -15,19 +15,24 @@
 
 #include <array>
 #include <map>
+#include <memory>
 #include <set>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "common/angleutils.h"
 #include "common/mathutil.h"
+#include "common/MemoryBuffer.h"
 #include "common/Optional.h"
 
 #include "libANGLE/angletypes.h"
 #include "libANGLE/Constants.h"
 #include "libANGLE/Debug.h"
 #include "libANGLE/Error.h"
+#include "libANGLE/ProgramBinaryFormat.h"
+#include "libANGLE/ProgramCache.h"
 #include "libANGLE/RefCountObject.h"
 
 namespace rx
@@ -39,6 +44,7 @@ struct TranslatedAttribute;
 
 namespace gl
 {
+class BinaryOutputStream;
 struct Caps;
 class Context;
 class ContextState;
@@ -51,6 +57,7 @@ class Framebuffer;
 struct UniformBlock;
 struct LinkedUniform;
 struct PackedVarying;
+class VaryingPacking;
 
 extern const char * const g_fakepath;
 
@@ -175,6 +182,46 @@ struct SamplerBinding
     std::vector<GLuint> boundTextureUnits;
 };
 
+// Maps the name of a program resource, and an array element for resources that are listed per
+// element, to its index or location. Built once per link, so that queries by name don't scan the
+// resource lists.
+class ResourceNameIndex final
+{
+  public:
+    ResourceNameIndex();
+    ~ResourceNameIndex();
+
+    void clear();
+
+    // Keeps the first value added for a name and element.
+    void add(const std::string &name, unsigned int element, GLuint value);
+
+    // Returns GL_INVALID_INDEX if there is no such resource.
+    GLuint find(const std::string &name, size_t element) const;
+
+    void save(ProgramBinaryWriter *writer, ProgramBinaryTableID table) const;
+
+    // Returns false if the names of the table are not in the binary, or if a value is not less
+    // than |valueCount|, the size of the list the values index.
+    bool load(ProgramBinaryReader *reader, ProgramBinaryTableID table, size_t valueCount);
+
+  private:
+    struct Key
+    {
+        bool operator==(const Key &other) const;
+
+        std::string name;
+        unsigned int element;
+    };
+
+    struct KeyHasher
+    {
+        size_t operator()(const Key &key) const;
+    };
+
+    std::unordered_map<Key, GLuint, KeyHasher> mIndex;
+};
+
 class ProgramState final : angle::NonCopyable
 {
   public:
@@ -210,6 +257,7 @@ class ProgramState final : angle::NonCopyable
     const std::vector<VariableLocation> &getUniformLocations() const { return mUniformLocations; }
     const std::vector<UniformBlock> &getUniformBlocks() const { return mUniformBlocks; }
     const std::vector<SamplerBinding> &getSamplerBindings() const { return mSamplerBindings; }
+    const angle::MemoryBuffer &getUniformData() const { return mUniformData; }
 
     GLint getUniformLocation(const std::string &name) const;
     GLuint getUniformIndexFromName(const std::string &name) const;
@@ -249,6 +297,10 @@ class ProgramState final : angle::NonCopyable
     std::vector<UniformBlock> mUniformBlocks;
     RangeUI mSamplerUniformRange;
 
+    // The values of all default block uniforms, packed in uniform order. Every uniform starts at
+    // a 16 byte aligned LinkedUniform::dataOffset.
+    angle::MemoryBuffer mUniformData;
+
     // An array of the samplers that are used by the program
     std::vector<gl::SamplerBinding> mSamplerBindings;
 
@@ -256,6 +308,13 @@ class ProgramState final : angle::NonCopyable
     // TODO(jmadill): use unordered/hash map when available
     std::map<int, VariableLocation> mOutputLocations;
 
+    // Name lookups for the lists above, see Program::indexResourceNames.
+    ResourceNameIndex mAttributeIndex;
+    ResourceNameIndex mUniformIndex;
+    ResourceNameIndex mUniformLocationIndex;
+    ResourceNameIndex mUniformBlockIndex;
+    ResourceNameIndex mOutputVariableIndex;
+
     bool mBinaryRetrieveableHint;
     bool mSeparable;
 };
@@ -293,7 +352,19 @@ class Program final : angle::NonCopyable, public LabeledObject
                               GLint components,
                               const GLfloat *coeffs);
 
+    // The front-end link, which matches the shader interfaces and packs the varyings, runs on the
+    // context's worker thread pool. The implementation link runs on the context thread once the
+    // link is resolved, since the GL back-end needs its context current. resolveLink() waits for
+    // the link; looking the program up by name through the context does so, as does linking a
+    // program that is in use.
     Error link(const gl::Context *context);
+    void resolveLink()
+    {
+        if (mLinkingState)
+        {
+            resolveLinkImpl();
+        }
+    }
     bool isLinked() const;
 
     Error loadBinary(const Context *context,
@@ -402,7 +473,17 @@ class Program final : angle::NonCopyable, public LabeledObject
 
     void validate(const Caps &caps);
     bool validateSamplers(InfoLog *infoLog, const Caps &caps);
+
+    // Changes whenever the link result, sampler bindings or uniform block bindings change. Used to
+    // invalidate the context's draw validation cache and active texture units.
+    unsigned int getDrawValidationSerial() const { return mDrawValidationSerial; }
     bool isValidated() const;
+
+    // Uploads the uniform values that changed since the last sync to the implementation. The
+    // context does this before drawing with the program.
+    bool hasDirtyUniforms() const { return !mDirtyUniformData.empty(); }
+    void syncState();
+
     bool samplesFromTexture(const gl::State &state, GLuint textureID) const;
 
     const AttributesMask &getActiveAttribLocationsMask() const
@@ -443,6 +524,9 @@ class Program final : angle::NonCopyable, public LabeledObject
     };
 
   private:
+    class LinkTask;
+    struct LinkingState;
+
     struct VaryingRef
     {
         const sh::Varying *get() const { return vertex ? vertex : fragment; }
@@ -456,7 +540,13 @@ class Program final : angle::NonCopyable, public LabeledObject
     void unlink();
     void resetUniformBlockBindings();
 
-    bool linkAttributes(const ContextState &data, InfoLog &infoLog);
+    bool linkFrontEnd(const Caps &caps,
+                      VaryingPacking *varyingPacking,
+                      MergedVaryings *mergedVaryingsOut);
+    void resolveLinkImpl();
+    Error linkBackEnd(const LinkingState &linkingState);
+
+    bool linkAttributes(const Caps &caps, InfoLog &infoLog);
     bool validateUniformBlocksCount(GLuint maxUniformBlocks,
                                     const std::vector<sh::InterfaceBlock> &block,
                                     const std::string &errorMessage,
@@ -493,7 +583,15 @@ class Program final : angle::NonCopyable, public LabeledObject
 
     void setUniformValuesFromBindingQualifiers();
 
+    Error serialize(const Context *context, BinaryOutputStream *stream) const;
+    // Returns false if the tables of the binary don't describe a consistent program.
+    bool loadTables(ProgramBinaryReader *reader);
+    // Returns false if the program can't be cached.
+    bool computeCacheHash(const Context *context, ProgramHash *hashOut) const;
+
     void gatherInterfaceBlockInfo();
+    void indexResourceNames();
+    Error initUniformData();
     template <typename VarT>
     void defineUniformBlockMembers(const std::vector<VarT> &fields,
                                    const std::string &prefix,
@@ -502,7 +600,8 @@ class Program final : angle::NonCopyable, public LabeledObject
     void defineUniformBlock(const sh::InterfaceBlock &interfaceBlock, GLenum shaderType);
 
     // Both these function update the cached uniform values and return a modified "count"
-    // so that the uniform update doesn't overflow the uniform.
+    // so that the uniform update doesn't overflow the uniform. The count is zero if the values
+    // didn't change, the update doesn't need to reach the implementation then.
     template <typename T>
     GLsizei setUniformInternal(GLint location, GLsizei count, int vectorSize, const T *v);
     template <size_t cols, size_t rows, typename T>
@@ -516,6 +615,8 @@ class Program final : angle::NonCopyable, public LabeledObject
                               GLsizei clampedCount,
                               const T *v);
 
+    void markUniformDataDirty(const uint8_t *dataPtr, size_t size);
+
     template <typename DestT>
     void getUniformInternal(GLint location, DestT *dataOut) const;
 
@@ -546,6 +647,14 @@ class Program final : angle::NonCopyable, public LabeledObject
     // Cache for sampler validation
     Optional<bool> mCachedValidateSamplersResult;
     std::vector<GLenum> mTextureUnitTypesCache;
+
+    unsigned int mDrawValidationSerial;
+
+    // Bytes of ProgramState::mUniformData that the implementation hasn't seen yet.
+    RangeUI mDirtyUniformData;
+
+    // Set while a link is in flight.
+    std::unique_ptr<LinkingState> mLinkingState;
 };
 }  // namespace gl
 
@@ -0,0 +1,187 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ProgramBinaryFormat.cpp:
+//   Implements the classes that write and read the program binaries of GL_PROGRAM_BINARY_ANGLE.
+//
+
+#include "libANGLE/ProgramBinaryFormat.h"
+
+#include <string.h>
+
+#include "common/debug.h"
+#include "common/mathutil.h"
+#include "libANGLE/BinaryStream.h"
+
+namespace gl
+{
+
+namespace
+{
+
+// The size of the records of each table, in the order of ProgramBinaryTableID.
+constexpr size_t kRecordSizes[PROGRAM_BINARY_TABLE_COUNT] = {
+    sizeof(ProgramBinaryLocatedVariable),  sizeof(ProgramBinaryUniform),
+    sizeof(ProgramBinaryVariableLocation), sizeof(ProgramBinaryUniformBlock),
+    sizeof(uint32_t),                      sizeof(ProgramBinaryVarying),
+    sizeof(ProgramBinaryLocatedVariable),  sizeof(ProgramBinaryVariableLocation),
+    sizeof(ProgramBinarySamplerBinding),   sizeof(ProgramBinaryNameIndexEntry),
+    sizeof(ProgramBinaryNameIndexEntry),   sizeof(ProgramBinaryNameIndexEntry),
+    sizeof(ProgramBinaryNameIndexEntry),   sizeof(ProgramBinaryNameIndexEntry),
+};
+
+static_assert(sizeof(ProgramBinaryHeader) % sizeof(uint32_t) == 0,
+              "The header must keep the tables aligned");
+
+size_t AlignToUint32(size_t size)
+{
+    return (size + sizeof(uint32_t) - 1) & ~(sizeof(uint32_t) - 1);
+}
+
+bool IsRangeInBinary(const ProgramBinaryRange &range, size_t elementSize, size_t length)
+{
+    angle::CheckedNumeric<size_t> end(range.count);
+    end *= elementSize;
+    end += range.offset;
+    return end.IsValid() && end.ValueOrDie() <= length;
+}
+
+}  // anonymous namespace
+
+ProgramBinaryWriter::ProgramBinaryWriter() : mTableCounts{}
+{
+    memset(&mHeader, 0, sizeof(mHeader));
+    memcpy(mHeader.commitHash, ANGLE_COMMIT_HASH, ANGLE_COMMIT_HASH_SIZE);
+    mHeader.magic         = kProgramBinaryMagic;
+    mHeader.formatVersion = kProgramBinaryFormatVersion;
+}
+
+ProgramBinaryWriter::~ProgramBinaryWriter()
+{
+}
+
+ProgramBinaryString ProgramBinaryWriter::addString(const std::string &value)
+{
+    auto iter = mStringOffsets.find(value);
+    if (iter == mStringOffsets.end())
+    {
+        iter = mStringOffsets.emplace(value, static_cast<uint32_t>(mStrings.size())).first;
+        mStrings += value;
+    }
+
+    ProgramBinaryString binaryString;
+    binaryString.offset = iter->second;
+    binaryString.length = static_cast<uint32_t>(value.length());
+    return binaryString;
+}
+
+void ProgramBinaryWriter::write(const BinaryOutputStream &implementationData,
+                                BinaryOutputStream *stream)
+{
+    size_t offset = sizeof(ProgramBinaryHeader);
+    for (size_t tableIndex = 0; tableIndex < PROGRAM_BINARY_TABLE_COUNT; ++tableIndex)
+    {
+        mHeader.tables[tableIndex].offset = static_cast<uint32_t>(offset);
+        mHeader.tables[tableIndex].count  = mTableCounts[tableIndex];
+        offset += mTables[tableIndex].size();
+    }
+
+    mHeader.strings.offset = static_cast<uint32_t>(offset);
+    mHeader.strings.count  = static_cast<uint32_t>(mStrings.size());
+    offset                 = AlignToUint32(offset + mStrings.size());
+
+    mHeader.implementationData.offset = static_cast<uint32_t>(offset);
+    mHeader.implementationData.count  = static_cast<uint32_t>(implementationData.length());
+
+    stream->writeBytes(reinterpret_cast<const unsigned char *>(&mHeader), sizeof(mHeader));
+    for (const std::vector<uint8_t> &table : mTables)
+    {
+        stream->writeBytes(table.data(), table.size());
+    }
+
+    const uint8_t kPadding[sizeof(uint32_t)] = {};
+    stream->writeBytes(reinterpret_cast<const unsigned char *>(mStrings.data()), mStrings.size());
+    stream->writeBytes(kPadding, offset - mHeader.strings.offset - mStrings.size());
+
+    stream->writeBytes(static_cast<const unsigned char *>(implementationData.data()),
+                       implementationData.length());
+}
+
+ProgramBinaryReader::ProgramBinaryReader() : mData(nullptr), mStrings(nullptr), mError(false)
+{
+    memset(&mHeader, 0, sizeof(mHeader));
+}
+
+ProgramBinaryReader::~ProgramBinaryReader()
+{
+}
+
+ProgramBinaryReader::Validity ProgramBinaryReader::init(const void *binary, size_t length)
+{
+    if (binary == nullptr || length < sizeof(ProgramBinaryHeader))
+    {
+        return Validity::Malformed;
+    }
+
+    memcpy(&mHeader, binary, sizeof(mHeader));
+    if (memcmp(mHeader.commitHash, ANGLE_COMMIT_HASH, ANGLE_COMMIT_HASH_SIZE) != 0 ||
+        mHeader.magic != kProgramBinaryMagic ||
+        mHeader.formatVersion != kProgramBinaryFormatVersion)
+    {
+        return Validity::WrongVersion;
+    }
+
+    if (!validateTables(length))
+    {
+        return Validity::Malformed;
+    }
+
+    // The tables are read in place, unless the application handed a binary that is not aligned
+    // for them. It is then copied once, rather than record by record.
+    if (reinterpret_cast<uintptr_t>(binary) % sizeof(uint32_t) == 0)
+    {
+        mData = static_cast<const uint8_t *>(binary);
+    }
+    else
+    {
+        mAlignedCopy.resize(AlignToUint32(length) / sizeof(uint32_t));
+        memcpy(mAlignedCopy.data(), binary, length);
+        mData = reinterpret_cast<const uint8_t *>(mAlignedCopy.data());
+    }
+
+    mStrings = reinterpret_cast<const char *>(mData + mHeader.strings.offset);
+    return Validity::Valid;
+}
+
+bool ProgramBinaryReader::validateTables(size_t length)
+{
+    for (size_t tableIndex = 0; tableIndex < PROGRAM_BINARY_TABLE_COUNT; ++tableIndex)
+    {
+        const ProgramBinaryRange &table = mHeader.tables[tableIndex];
+        if (table.offset % sizeof(uint32_t) != 0 ||
+            !IsRangeInBinary(table, kRecordSizes[tableIndex], length))
+        {
+            return false;
+        }
+    }
+
+    return IsRangeInBinary(mHeader.strings, 1, length) &&
+           IsRangeInBinary(mHeader.implementationData, 1, length);
+}
+
+std::string ProgramBinaryReader::getString(const ProgramBinaryString &value)
+{
+    angle::CheckedNumeric<uint32_t> end(value.offset);
+    end += value.length;
+    if (!end.IsValid() || end.ValueOrDie() > mHeader.strings.count)
+    {
+        mError = true;
+        return std::string();
+    }
+
+    return std::string(mStrings + value.offset, value.length);
+}
+
+}  // namespace gl
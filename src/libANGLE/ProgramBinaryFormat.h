@@ -0,0 +1,252 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ProgramBinaryFormat.h:
+//   Defines the layout of the program binaries of GL_PROGRAM_BINARY_ANGLE, and the classes that
+//   write and read it. A binary is a fixed-size header followed by tables of fixed-size records,
+//   one string table that all the names point into, and the data the back-end saved. The header
+//   locates everything by offset, so a binary is read without walking it record by record, and
+//   the tables are used in place when the binary is suitably aligned.
+//
+
+#ifndef LIBANGLE_PROGRAMBINARYFORMAT_H_
+#define LIBANGLE_PROGRAMBINARYFORMAT_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/angleutils.h"
+#include "common/version.h"
+#include "libANGLE/Constants.h"
+
+namespace gl
+{
+
+class BinaryOutputStream;
+
+// Changes whenever the layout below does. The commit hash in the header already rejects the
+// binaries of other builds, this also rejects the binaries of local builds of other layouts.
+constexpr uint32_t kProgramBinaryMagic         = 0x42504E41;  // "ANPB"
+constexpr uint32_t kProgramBinaryFormatVersion = 1;
+
+enum ProgramBinaryTableID
+{
+    PROGRAM_BINARY_ATTRIBUTES,
+    PROGRAM_BINARY_UNIFORMS,
+    PROGRAM_BINARY_UNIFORM_LOCATIONS,
+    PROGRAM_BINARY_UNIFORM_BLOCKS,
+    PROGRAM_BINARY_UNIFORM_BLOCK_MEMBERS,
+    PROGRAM_BINARY_TRANSFORM_FEEDBACK_VARYINGS,
+    PROGRAM_BINARY_OUTPUT_VARIABLES,
+    PROGRAM_BINARY_OUTPUT_LOCATIONS,
+    PROGRAM_BINARY_SAMPLER_BINDINGS,
+    PROGRAM_BINARY_ATTRIBUTE_INDEX,
+    PROGRAM_BINARY_UNIFORM_INDEX,
+    PROGRAM_BINARY_UNIFORM_LOCATION_INDEX,
+    PROGRAM_BINARY_UNIFORM_BLOCK_INDEX,
+    PROGRAM_BINARY_OUTPUT_VARIABLE_INDEX,
+
+    PROGRAM_BINARY_TABLE_COUNT,
+};
+
+// A range of the binary. Counts records for the tables and bytes otherwise.
+struct ProgramBinaryRange
+{
+    uint32_t offset;
+    uint32_t count;
+};
+
+// A string of the string table. Strings are not null-terminated.
+struct ProgramBinaryString
+{
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct ProgramBinaryHeader
+{
+    uint8_t commitHash[ANGLE_COMMIT_HASH_SIZE];
+    uint32_t magic;
+    uint32_t formatVersion;
+
+    int32_t clientMajorVersion;
+    int32_t clientMinorVersion;
+
+    int32_t computeShaderLocalSize[3];
+    uint32_t activeAttribLocationsMask;
+    int32_t transformFeedbackBufferMode;
+    uint32_t samplerUniformRangeStart;
+    uint32_t samplerUniformRangeEnd;
+    uint32_t uniformBlockBindings[IMPLEMENTATION_MAX_COMBINED_SHADER_UNIFORM_BUFFERS];
+
+    ProgramBinaryRange tables[PROGRAM_BINARY_TABLE_COUNT];
+    ProgramBinaryRange strings;
+    ProgramBinaryRange implementationData;
+};
+
+struct ProgramBinaryShaderVariable
+{
+    uint32_t type;
+    uint32_t precision;
+    ProgramBinaryString name;
+    ProgramBinaryString mappedName;
+    ProgramBinaryString structName;
+    uint32_t arraySize;
+    uint32_t staticUse;
+};
+
+// The record of the attributes and output variables.
+struct ProgramBinaryLocatedVariable
+{
+    ProgramBinaryShaderVariable variable;
+    int32_t location;
+};
+
+struct ProgramBinaryUniform
+{
+    ProgramBinaryShaderVariable variable;
+    int32_t binding;
+    int32_t blockIndex;
+    int32_t blockOffset;
+    int32_t blockArrayStride;
+    int32_t blockMatrixStride;
+    uint32_t blockIsRowMajorMatrix;
+};
+
+// The record of the uniform locations, and of the output locations, which also store the
+// location they are at.
+struct ProgramBinaryVariableLocation
+{
+    int32_t location;
+    ProgramBinaryString name;
+    uint32_t element;
+    uint32_t index;
+    uint32_t used;
+    uint32_t ignored;
+};
+
+// The member uniform indexes of a block are a range of PROGRAM_BINARY_UNIFORM_BLOCK_MEMBERS.
+struct ProgramBinaryUniformBlock
+{
+    ProgramBinaryString name;
+    uint32_t isArray;
+    uint32_t arrayElement;
+    uint32_t dataSize;
+    uint32_t vertexStaticUse;
+    uint32_t fragmentStaticUse;
+    uint32_t computeStaticUse;
+    uint32_t firstMember;
+    uint32_t memberCount;
+};
+
+struct ProgramBinaryVarying
+{
+    ProgramBinaryString name;
+    uint32_t type;
+    uint32_t arraySize;
+};
+
+struct ProgramBinarySamplerBinding
+{
+    uint32_t textureType;
+    uint32_t elementCount;
+};
+
+// The record of the resource name indices, see ResourceNameIndex.
+struct ProgramBinaryNameIndexEntry
+{
+    ProgramBinaryString name;
+    uint32_t element;
+    uint32_t value;
+};
+
+// Collects the tables and strings of a binary, and writes it out.
+class ProgramBinaryWriter final : angle::NonCopyable
+{
+  public:
+    ProgramBinaryWriter();
+    ~ProgramBinaryWriter();
+
+    ProgramBinaryHeader *getHeader() { return &mHeader; }
+
+    // Identical strings are stored once.
+    ProgramBinaryString addString(const std::string &value);
+
+    template <typename RecordT>
+    void setTable(ProgramBinaryTableID table, const std::vector<RecordT> &records)
+    {
+        static_assert(sizeof(RecordT) % sizeof(uint32_t) == 0, "Records must keep tables aligned");
+        const uint8_t *bytes = reinterpret_cast<const uint8_t *>(records.data());
+        mTables[table].assign(bytes, bytes + records.size() * sizeof(RecordT));
+        mTableCounts[table] = static_cast<uint32_t>(records.size());
+    }
+
+    // Writes the header, the tables, the strings and the implementation data to |stream|.
+    void write(const BinaryOutputStream &implementationData, BinaryOutputStream *stream);
+
+  private:
+    ProgramBinaryHeader mHeader;
+    std::vector<uint8_t> mTables[PROGRAM_BINARY_TABLE_COUNT];
+    uint32_t mTableCounts[PROGRAM_BINARY_TABLE_COUNT];
+    std::string mStrings;
+    std::unordered_map<std::string, uint32_t> mStringOffsets;
+};
+
+// Checks that a binary is well formed and gives access to its header, tables and strings. The
+// binary must outlive the reader.
+class ProgramBinaryReader final : angle::NonCopyable
+{
+  public:
+    ProgramBinaryReader();
+    ~ProgramBinaryReader();
+
+    enum class Validity
+    {
+        Valid,
+        Malformed,
+        WrongVersion,
+    };
+
+    // Returns WrongVersion for the binaries of another build or layout.
+    Validity init(const void *binary, size_t length);
+
+    const ProgramBinaryHeader &getHeader() const { return mHeader; }
+
+    template <typename RecordT>
+    const RecordT *getTable(ProgramBinaryTableID table, size_t *countOut) const
+    {
+        *countOut = mHeader.tables[table].count;
+        return reinterpret_cast<const RecordT *>(mData + mHeader.tables[table].offset);
+    }
+
+    // Strings are checked when read. Sets the error flag and returns an empty string for the ones
+    // outside the string table.
+    std::string getString(const ProgramBinaryString &value);
+    bool error() const { return mError; }
+
+    const uint8_t *getImplementationData() const
+    {
+        return mData + mHeader.implementationData.offset;
+    }
+    size_t getImplementationDataSize() const { return mHeader.implementationData.count; }
+
+  private:
+    bool validateTables(size_t length);
+
+    ProgramBinaryHeader mHeader;
+    const uint8_t *mData;
+    const char *mStrings;
+    bool mError;
+
+    // Holds a copy of the binary when it is not aligned for the records to be read in place.
+    std::vector<uint32_t> mAlignedCopy;
+};
+
+}  // namespace gl
+
+#endif  // LIBANGLE_PROGRAMBINARYFORMAT_H_
@@ -0,0 +1,216 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ProgramCache.cpp: Implements the gl::ProgramCache class.
+
+#include "libANGLE/ProgramCache.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+
+#include "common/debug.h"
+#include "common/system_utils.h"
+
+namespace gl
+{
+
+namespace
+{
+// Written at the start of every file in the disk tier, so that truncated or foreign files are
+// rejected before the binary reaches Program::loadBinary.
+struct DiskCacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t binarySize;
+};
+
+constexpr uint32_t kDiskCacheMagic   = 0x43504e41;  // "ANPC"
+constexpr uint32_t kDiskCacheVersion = 1;
+
+// The name of the temporary file a binary is written to before it is renamed into place. It is
+// unique to the process and to the write, so that concurrent writers of the same binary never
+// write to the same file.
+std::string GetTemporaryPath(const std::string &path)
+{
+    static std::atomic<unsigned int> writeCount(0);
+
+    std::ostringstream tempPath;
+    tempPath << path << "." << angle::GetCurrentProcessID() << "." << writeCount++ << ".tmp";
+    return tempPath.str();
+}
+
+}  // anonymous namespace
+
+size_t ProgramHashHasher::operator()(const ProgramHash &programHash) const
+{
+    // The hash is already well distributed, any word of it will do.
+    size_t result = 0;
+    memcpy(&result, programHash.data(), sizeof(size_t));
+    return result;
+}
+
+ProgramCache::ProgramCache(size_t maxCacheSizeBytes)
+    : mMemoryCache(maxCacheSizeBytes), mHitCount(0), mDiskHitCount(0), mMissCount(0)
+{
+}
+
+ProgramCache::~ProgramCache()
+{
+}
+
+void ProgramCache::setDiskCacheDirectory(const std::string &directory)
+{
+    mDiskCacheDirectory = directory;
+}
+
+const angle::MemoryBuffer *ProgramCache::get(const ProgramHash &programHash)
+{
+    const angle::MemoryBuffer *binary = nullptr;
+    if (mMemoryCache.get(programHash, &binary))
+    {
+        mHitCount++;
+        return binary;
+    }
+
+    angle::MemoryBuffer diskBinary;
+    if (readFromDisk(programHash, &diskBinary))
+    {
+        // Promote to the memory tier so the returned pointer has an owner.
+        size_t binarySize = diskBinary.size();
+        binary            = mMemoryCache.put(programHash, std::move(diskBinary), binarySize);
+        if (binary)
+        {
+            mDiskHitCount++;
+            return binary;
+        }
+    }
+
+    mMissCount++;
+    return nullptr;
+}
+
+void ProgramCache::put(const ProgramHash &programHash, angle::MemoryBuffer &&binary)
+{
+    writeToDisk(programHash, binary);
+
+    size_t binarySize = binary.size();
+    mMemoryCache.put(programHash, std::move(binary), binarySize);
+}
+
+void ProgramCache::remove(const ProgramHash &programHash)
+{
+    mMemoryCache.eraseByKey(programHash);
+
+    if (!mDiskCacheDirectory.empty())
+    {
+        ::remove(getDiskCachePath(programHash).c_str());
+    }
+}
+
+void ProgramCache::clear()
+{
+    mMemoryCache.clear();
+}
+
+std::string ProgramCache::getDiskCachePath(const ProgramHash &programHash) const
+{
+    static const char kHexDigits[] = "0123456789abcdef";
+
+    std::string path = mDiskCacheDirectory + "/";
+    for (uint8_t byte : programHash)
+    {
+        path += kHexDigits[byte >> 4];
+        path += kHexDigits[byte & 0xF];
+    }
+    path += ".bin";
+    return path;
+}
+
+bool ProgramCache::readFromDisk(const ProgramHash &programHash,
+                                angle::MemoryBuffer *binaryOut) const
+{
+    if (mDiskCacheDirectory.empty())
+    {
+        return false;
+    }
+
+    std::ifstream inFile(getDiskCachePath(programHash).c_str(), std::ios::in | std::ios::binary);
+    if (inFile.fail())
+    {
+        return false;
+    }
+
+    DiskCacheHeader header;
+    inFile.read(reinterpret_cast<char *>(&header), sizeof(header));
+    if (inFile.fail() || header.magic != kDiskCacheMagic || header.version != kDiskCacheVersion ||
+        header.binarySize > mMemoryCache.maxSize())
+    {
+        return false;
+    }
+
+    size_t binarySize = static_cast<size_t>(header.binarySize);
+    if (!binaryOut->resize(binarySize))
+    {
+        return false;
+    }
+
+    inFile.read(reinterpret_cast<char *>(binaryOut->data()), binarySize);
+    if (inFile.gcount() != static_cast<std::streamsize>(binarySize))
+    {
+        binaryOut->resize(0);
+        return false;
+    }
+
+    return true;
+}
+
+void ProgramCache::writeToDisk(const ProgramHash &programHash,
+                               const angle::MemoryBuffer &binary) const
+{
+    if (mDiskCacheDirectory.empty() || binary.empty())
+    {
+        return;
+    }
+
+    // Write to a temporary file first, so that another process never reads a partial binary.
+    std::string path     = getDiskCachePath(programHash);
+    std::string tempPath = GetTemporaryPath(path);
+    {
+        std::ofstream outFile(tempPath.c_str(),
+                              std::ios::out | std::ios::binary | std::ios::trunc);
+        if (outFile.fail())
+        {
+            WARN() << "Failed to open " << tempPath << " for writing a program binary.";
+            return;
+        }
+
+        DiskCacheHeader header;
+        header.magic      = kDiskCacheMagic;
+        header.version    = kDiskCacheVersion;
+        header.binarySize = binary.size();
+
+        outFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        outFile.write(reinterpret_cast<const char *>(binary.data()), binary.size());
+        if (outFile.fail())
+        {
+            outFile.close();
+            ::remove(tempPath.c_str());
+            return;
+        }
+    }
+
+    // rename() fails on some platforms when the destination exists, in which case the binary
+    // already stored there is just as good.
+    if (::rename(tempPath.c_str(), path.c_str()) != 0)
+    {
+        ::remove(tempPath.c_str());
+    }
+}
+
+}  // namespace gl
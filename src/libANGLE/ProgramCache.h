@@ -0,0 +1,75 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ProgramCache.h: Stores linked program binaries, keyed by a hash of everything that affects the
+// result of a link. Binaries are kept in a size-bounded in-memory tier and, optionally, in a
+// directory on disk so they survive across processes.
+
+#ifndef LIBANGLE_PROGRAMCACHE_H_
+#define LIBANGLE_PROGRAMCACHE_H_
+
+#include <array>
+#include <string>
+
+#include "common/MemoryBuffer.h"
+#include "libANGLE/SizedMRUCache.h"
+
+namespace gl
+{
+using ProgramHash = std::array<uint8_t, 16>;
+
+struct ProgramHashHasher
+{
+    size_t operator()(const ProgramHash &programHash) const;
+};
+
+class ProgramCache final : angle::NonCopyable
+{
+  public:
+    explicit ProgramCache(size_t maxCacheSizeBytes);
+    ~ProgramCache();
+
+    // Binaries are also read from and written to this directory when it is non-empty. The
+    // directory must already exist.
+    void setDiskCacheDirectory(const std::string &directory);
+    const std::string &getDiskCacheDirectory() const { return mDiskCacheDirectory; }
+
+    // Returns nullptr on a miss. The binary stays valid until the next call that modifies the
+    // cache.
+    const angle::MemoryBuffer *get(const ProgramHash &programHash);
+
+    void put(const ProgramHash &programHash, angle::MemoryBuffer &&binary);
+
+    // Drops a binary from both tiers, for example when it failed to load.
+    void remove(const ProgramHash &programHash);
+
+    // Empties the in-memory tier. The disk tier is left untouched.
+    void clear();
+
+    size_t size() const { return mMemoryCache.size(); }
+    size_t maxSize() const { return mMemoryCache.maxSize(); }
+    size_t entryCount() const { return mMemoryCache.entryCount(); }
+
+    size_t getHitCount() const { return mHitCount; }
+    size_t getDiskHitCount() const { return mDiskHitCount; }
+    size_t getMissCount() const { return mMissCount; }
+    size_t getEvictionCount() const { return mMemoryCache.evictionCount(); }
+
+  private:
+    std::string getDiskCachePath(const ProgramHash &programHash) const;
+    bool readFromDisk(const ProgramHash &programHash, angle::MemoryBuffer *binaryOut) const;
+    void writeToDisk(const ProgramHash &programHash, const angle::MemoryBuffer &binary) const;
+
+    angle::SizedMRUCache<ProgramHash, angle::MemoryBuffer, ProgramHashHasher> mMemoryCache;
+    std::string mDiskCacheDirectory;
+
+    size_t mHitCount;
+    size_t mDiskHitCount;
+    size_t mMissCount;
+};
+
+}  // namespace gl
+
+#endif  // LIBANGLE_PROGRAMCACHE_H_
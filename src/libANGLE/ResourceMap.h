@@ -0,0 +1,275 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// ResourceMap.h: Defines the gl::ResourceMap class, which maps GL object handles to objects.
+// Handles from the handle allocators are small and dense, so handles below a limit are stored in
+// a flat array indexed by handle, and only larger application-chosen handles are hashed.
+
+#ifndef LIBANGLE_RESOURCEMAP_H_
+#define LIBANGLE_RESOURCEMAP_H_
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "angle_gl.h"
+#include "common/angleutils.h"
+#include "common/debug.h"
+
+namespace gl
+{
+
+template <typename ResourceType>
+class ResourceMap final : angle::NonCopyable
+{
+  public:
+    ResourceMap();
+    ~ResourceMap();
+
+    // Returns nullptr for handles that are not in the map, and for handles that were generated
+    // but don't have an object yet.
+    ResourceType *query(GLuint handle) const;
+    bool contains(GLuint handle) const;
+
+    // Adds the handle, or replaces the object of a handle that is already in the map.
+    void assign(GLuint handle, ResourceType *resource);
+
+    // Returns false if the handle was not in the map.
+    bool erase(GLuint handle, ResourceType **resourceOut);
+
+    void clear();
+    bool empty() const;
+
+    using value_type = std::pair<GLuint, ResourceType *>;
+
+    class Iterator final
+    {
+      public:
+        bool operator==(const Iterator &other) const;
+        bool operator!=(const Iterator &other) const;
+        Iterator &operator++();
+        const value_type *operator->() const { return &mValue; }
+        const value_type &operator*() const { return mValue; }
+
+      private:
+        friend class ResourceMap;
+        using HashedIterator = typename std::unordered_map<GLuint, ResourceType *>::const_iterator;
+
+        Iterator(const ResourceMap &origin, size_t flatIndex, const HashedIterator &hashedIter);
+        void updateValue();
+
+        const ResourceMap &mOrigin;
+        size_t mFlatIndex;
+        HashedIterator mHashedIter;
+        value_type mValue;
+    };
+
+    // Flat handles are visited in increasing order, then the hashed handles in no order.
+    Iterator begin() const;
+    Iterator end() const;
+
+  private:
+    // 16k handles take 64 or 128KB, applications with more objects than that are rare.
+    static constexpr size_t kInitialFlatResourcesSize = 64;
+    static constexpr GLuint kFlatResourcesLimit       = 0x4000;
+
+    // Marks flat slots without a handle, nullptr is a valid object for generated handles.
+    static ResourceType *InvalidPointer() { return reinterpret_cast<ResourceType *>(-1); }
+
+    size_t nextFlatIndex(size_t flatIndex) const;
+
+    std::vector<ResourceType *> mFlatResources;
+    size_t mFlatResourceCount;
+    std::unordered_map<GLuint, ResourceType *> mHashedResources;
+};
+
+template <typename ResourceType>
+constexpr size_t ResourceMap<ResourceType>::kInitialFlatResourcesSize;
+
+template <typename ResourceType>
+constexpr GLuint ResourceMap<ResourceType>::kFlatResourcesLimit;
+
+template <typename ResourceType>
+ResourceMap<ResourceType>::ResourceMap() : mFlatResourceCount(0)
+{
+}
+
+template <typename ResourceType>
+ResourceMap<ResourceType>::~ResourceMap()
+{
+}
+
+template <typename ResourceType>
+ResourceType *ResourceMap<ResourceType>::query(GLuint handle) const
+{
+    if (handle < mFlatResources.size())
+    {
+        ResourceType *value = mFlatResources[handle];
+        return (value == InvalidPointer() ? nullptr : value);
+    }
+
+    if (handle < kFlatResourcesLimit || mHashedResources.empty())
+    {
+        return nullptr;
+    }
+
+    auto iter = mHashedResources.find(handle);
+    return (iter != mHashedResources.end() ? iter->second : nullptr);
+}
+
+template <typename ResourceType>
+bool ResourceMap<ResourceType>::contains(GLuint handle) const
+{
+    if (handle < kFlatResourcesLimit)
+    {
+        return (handle < mFlatResources.size() && mFlatResources[handle] != InvalidPointer());
+    }
+    return (mHashedResources.count(handle) > 0);
+}
+
+template <typename ResourceType>
+void ResourceMap<ResourceType>::assign(GLuint handle, ResourceType *resource)
+{
+    if (handle >= kFlatResourcesLimit)
+    {
+        mHashedResources[handle] = resource;
+        return;
+    }
+
+    if (handle >= mFlatResources.size())
+    {
+        size_t newSize = std::max(mFlatResources.size(), kInitialFlatResourcesSize);
+        while (newSize <= handle)
+        {
+            newSize *= 2;
+        }
+        mFlatResources.resize(newSize, InvalidPointer());
+    }
+
+    if (mFlatResources[handle] == InvalidPointer())
+    {
+        mFlatResourceCount++;
+    }
+    mFlatResources[handle] = resource;
+}
+
+template <typename ResourceType>
+bool ResourceMap<ResourceType>::erase(GLuint handle, ResourceType **resourceOut)
+{
+    if (handle >= kFlatResourcesLimit)
+    {
+        auto iter = mHashedResources.find(handle);
+        if (iter == mHashedResources.end())
+        {
+            return false;
+        }
+        *resourceOut = iter->second;
+        mHashedResources.erase(iter);
+        return true;
+    }
+
+    if (handle >= mFlatResources.size() || mFlatResources[handle] == InvalidPointer())
+    {
+        return false;
+    }
+
+    *resourceOut           = mFlatResources[handle];
+    mFlatResources[handle] = InvalidPointer();
+    mFlatResourceCount--;
+    return true;
+}
+
+template <typename ResourceType>
+void ResourceMap<ResourceType>::clear()
+{
+    mFlatResources.clear();
+    mFlatResourceCount = 0;
+    mHashedResources.clear();
+}
+
+template <typename ResourceType>
+bool ResourceMap<ResourceType>::empty() const
+{
+    return (mFlatResourceCount == 0 && mHashedResources.empty());
+}
+
+template <typename ResourceType>
+typename ResourceMap<ResourceType>::Iterator ResourceMap<ResourceType>::begin() const
+{
+    return Iterator(*this, nextFlatIndex(0), mHashedResources.begin());
+}
+
+template <typename ResourceType>
+typename ResourceMap<ResourceType>::Iterator ResourceMap<ResourceType>::end() const
+{
+    return Iterator(*this, mFlatResources.size(), mHashedResources.end());
+}
+
+template <typename ResourceType>
+size_t ResourceMap<ResourceType>::nextFlatIndex(size_t flatIndex) const
+{
+    while (flatIndex < mFlatResources.size() && mFlatResources[flatIndex] == InvalidPointer())
+    {
+        flatIndex++;
+    }
+    return flatIndex;
+}
+
+template <typename ResourceType>
+ResourceMap<ResourceType>::Iterator::Iterator(const ResourceMap &origin,
+                                              size_t flatIndex,
+                                              const HashedIterator &hashedIter)
+    : mOrigin(origin), mFlatIndex(flatIndex), mHashedIter(hashedIter)
+{
+    updateValue();
+}
+
+template <typename ResourceType>
+bool ResourceMap<ResourceType>::Iterator::operator==(const Iterator &other) const
+{
+    return (mFlatIndex == other.mFlatIndex && mHashedIter == other.mHashedIter);
+}
+
+template <typename ResourceType>
+bool ResourceMap<ResourceType>::Iterator::operator!=(const Iterator &other) const
+{
+    return !(*this == other);
+}
+
+template <typename ResourceType>
+typename ResourceMap<ResourceType>::Iterator &ResourceMap<ResourceType>::Iterator::operator++()
+{
+    if (mFlatIndex < mOrigin.mFlatResources.size())
+    {
+        mFlatIndex = mOrigin.nextFlatIndex(mFlatIndex + 1);
+    }
+    else
+    {
+        ++mHashedIter;
+    }
+    updateValue();
+    return *this;
+}
+
+template <typename ResourceType>
+void ResourceMap<ResourceType>::Iterator::updateValue()
+{
+    if (mFlatIndex < mOrigin.mFlatResources.size())
+    {
+        mValue.first  = static_cast<GLuint>(mFlatIndex);
+        mValue.second = mOrigin.mFlatResources[mFlatIndex];
+    }
+    else if (mHashedIter != mOrigin.mHashedResources.end())
+    {
+        mValue.first  = mHashedIter->first;
+        mValue.second = mHashedIter->second;
+    }
+}
+
+}  // namespace gl
+
+#endif  // LIBANGLE_RESOURCEMAP_H_
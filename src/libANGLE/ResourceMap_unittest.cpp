@@ -0,0 +1,130 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Unit tests for ResourceMap.
+//
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "libANGLE/ResourceMap.h"
+
+using namespace gl;
+
+namespace
+{
+
+// Test that handles in the flat array and in the hash map are found, including handles without
+// an object.
+TEST(ResourceMapTest, AssignAndQuery)
+{
+    int objects[3] = {};
+
+    ResourceMap<int> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(nullptr, map.query(1));
+    EXPECT_FALSE(map.contains(1));
+
+    map.assign(1, &objects[0]);
+    map.assign(5000, nullptr);
+    map.assign(0x7FFFFFFF, &objects[2]);
+    EXPECT_FALSE(map.empty());
+
+    EXPECT_EQ(&objects[0], map.query(1));
+    EXPECT_EQ(nullptr, map.query(5000));
+    EXPECT_TRUE(map.contains(5000));
+    EXPECT_EQ(&objects[2], map.query(0x7FFFFFFF));
+    EXPECT_FALSE(map.contains(2));
+    EXPECT_FALSE(map.contains(0x7FFFFFFE));
+
+    map.assign(5000, &objects[1]);
+    EXPECT_EQ(&objects[1], map.query(5000));
+
+    int *erased = nullptr;
+    EXPECT_TRUE(map.erase(1, &erased));
+    EXPECT_EQ(&objects[0], erased);
+    EXPECT_FALSE(map.erase(1, &erased));
+    EXPECT_TRUE(map.erase(0x7FFFFFFF, &erased));
+    EXPECT_EQ(&objects[2], erased);
+    EXPECT_FALSE(map.contains(0x7FFFFFFF));
+    EXPECT_FALSE(map.empty());
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains(5000));
+}
+
+// Test that iteration visits every handle once, in increasing order for small handles.
+TEST(ResourceMapTest, Iteration)
+{
+    ResourceMap<int> map;
+    EXPECT_TRUE(map.begin() == map.end());
+
+    int object = 0;
+    map.assign(0, nullptr);
+    map.assign(3, &object);
+    map.assign(200, &object);
+    map.assign(1000000, nullptr);
+
+    std::vector<GLuint> handles;
+    for (const auto &resource : map)
+    {
+        handles.push_back(resource.first);
+        EXPECT_EQ(map.query(resource.first), resource.second);
+    }
+
+    std::vector<GLuint> expected = {0, 3, 200, 1000000};
+    EXPECT_EQ(expected, handles);
+}
+
+// Test random operations against a std::map.
+TEST(ResourceMapTest, RandomOperations)
+{
+    ResourceMap<int> map;
+    std::map<GLuint, int *> model;
+    int objects[4] = {};
+
+    std::mt19937 generator(3);
+    for (int iteration = 0; iteration < 20000; ++iteration)
+    {
+        GLuint handle = generator() % 300;
+        if (generator() % 8 == 0)
+        {
+            handle += 0x10000;
+        }
+
+        if (generator() % 2 == 0)
+        {
+            int *object = (generator() % 5 == 0) ? nullptr : &objects[generator() % 4];
+            map.assign(handle, object);
+            model[handle] = object;
+        }
+        else
+        {
+            int *erased = nullptr;
+            auto iter   = model.find(handle);
+            ASSERT_EQ(iter != model.end(), map.erase(handle, &erased));
+            if (iter != model.end())
+            {
+                ASSERT_EQ(iter->second, erased);
+                model.erase(iter);
+            }
+        }
+
+        ASSERT_EQ(model.empty(), map.empty());
+    }
+
+    std::map<GLuint, int *> visited;
+    for (const auto &resource : map)
+    {
+        EXPECT_TRUE(visited.insert(resource).second);
+    }
+    EXPECT_EQ(model, visited);
+}
+
+}  // anonymous namespace
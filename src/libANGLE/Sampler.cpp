@@ -38,6 +38,7 @@ const std::string &Sampler::getLabel() const
 void Sampler::setMinFilter(GLenum minFilter)
 {
     mSamplerState.minFilter = minFilter;
+    mDirtyChannel.signal();
 }
 
 GLenum Sampler::getMinFilter() const
@@ -48,6 +49,7 @@ GLenum Sampler::getMinFilter() const
 void Sampler::setMagFilter(GLenum magFilter)
 {
     mSamplerState.magFilter = magFilter;
+    mDirtyChannel.signal();
 }
 
 GLenum Sampler::getMagFilter() const
@@ -58,6 +60,7 @@ GLenum Sampler::getMagFilter() const
 void Sampler::setWrapS(GLenum wrapS)
 {
     mSamplerState.wrapS = wrapS;
+    mDirtyChannel.signal();
 }
 
 GLenum Sampler::getWrapS() const
@@ -68,6 +71,7 @@ GLenum Sampler::getWrapS() const
 void Sampler::setWrapT(GLenum wrapT)
 {
     mSamplerState.wrapT = wrapT;
+    mDirtyChannel.signal();
 }
 
 GLenum Sampler::getWrapT() const
@@ -118,6 +122,7 @@ GLfloat Sampler::getMaxLod() const
 void Sampler::setCompareMode(GLenum compareMode)
 {
     mSamplerState.compareMode = compareMode;
+    mDirtyChannel.signal();
 }
 
 GLenum Sampler::getCompareMode() const
@@ -13,6 +13,7 @@
 #include "libANGLE/angletypes.h"
 #include "libANGLE/Debug.h"
 #include "libANGLE/RefCountObject.h"
+#include "libANGLE/signal_utils.h"
 
 namespace rx
 {
@@ -71,12 +72,17 @@ class Sampler final : public RefCountObject, public LabeledObject
 
     rx::SamplerImpl *getImplementation() const;
 
+    // Signaled when a parameter the sampler completeness of textures depends on changes.
+    angle::BroadcastChannel *getDirtyChannel() { return &mDirtyChannel; }
+
   private:
     rx::SamplerImpl *mImpl;
 
     std::string mLabel;
 
     SamplerState mSamplerState;
+
+    angle::BroadcastChannel mDirtyChannel;
 };
 
 }
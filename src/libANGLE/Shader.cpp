@@ -21,6 +21,7 @@
 #include "libANGLE/renderer/ShaderImpl.h"
 #include "libANGLE/ResourceManager.h"
 #include "libANGLE/Context.h"
+#include "libANGLE/WorkerThread.h"
 
 namespace gl
 {
@@ -50,6 +51,12 @@ const std::vector<VarT> &GetShaderVariables(const std::vector<VarT> *variableLis
     return *variableList;
 }
 
+bool IsOutputHLSL(ShShaderOutput outputType)
+{
+    return outputType == SH_HLSL_3_0_OUTPUT || outputType == SH_HLSL_4_1_OUTPUT ||
+           outputType == SH_HLSL_4_0_FL9_3_OUTPUT;
+}
+
 }  // anonymous namespace
 
 // true if varying x has a higher priority in packing than y
@@ -74,6 +81,137 @@ bool CompareShaderVar(const sh::ShaderVariable &x, const sh::ShaderVariable &y)
     return gl::VariableSortOrder(x.type) < gl::VariableSortOrder(y.type);
 }
 
+// Runs the translator and gathers its output. Only touches its own members, so that the shader
+// can be used, and even re-compiled, while the task is in flight.
+class Shader::CompileTask : public angle::Closure
+{
+  public:
+    CompileTask(ShCompilerInstance &&compilerInstance,
+                ShCompileOptions compileOptions,
+                std::string &&sourcePath,
+                std::string &&source,
+                std::string &&originalSource)
+        : compilerInstance(std::move(compilerInstance)),
+          compileOptions(compileOptions),
+          sourcePath(std::move(sourcePath)),
+          source(std::move(source)),
+          originalSource(std::move(originalSource)),
+          result(false)
+    {
+    }
+
+    void operator()() override;
+
+    ShCompilerInstance compilerInstance;
+    ShCompileOptions compileOptions;
+    std::string sourcePath;
+    std::string source;
+    std::string originalSource;
+
+    bool result;
+    std::string infoLog;
+    TranslatedShader translatedShader;
+};
+
+void Shader::CompileTask::operator()()
+{
+    std::vector<const char *> sourceCStrings;
+
+    if (!sourcePath.empty())
+    {
+        sourceCStrings.push_back(sourcePath.c_str());
+    }
+
+    sourceCStrings.push_back(source.c_str());
+
+    result =
+        compilerInstance.compile(&sourceCStrings[0], sourceCStrings.size(), compileOptions);
+
+    ShHandle compilerHandle = compilerInstance.getHandle();
+
+    if (!result)
+    {
+        infoLog = sh::GetInfoLog(compilerHandle);
+        return;
+    }
+
+    translatedShader.outputType = compilerInstance.getShaderOutputType();
+    translatedShader.infoLog    = sh::GetInfoLog(compilerHandle);
+    translatedShader.objectCode = sh::GetObjectCode(compilerHandle);
+
+    // Gather the shader information
+    translatedShader.shaderVersion = sh::GetShaderVersion(compilerHandle);
+
+    translatedShader.varyings = GetShaderVariables(sh::GetVaryings(compilerHandle));
+    translatedShader.uniforms = GetShaderVariables(sh::GetUniforms(compilerHandle));
+    translatedShader.interfaceBlocks =
+        GetShaderVariables(sh::GetInterfaceBlocks(compilerHandle));
+
+    switch (compilerInstance.getShaderType())
+    {
+        case GL_COMPUTE_SHADER:
+        {
+            translatedShader.localSize = sh::GetComputeShaderLocalGroupSize(compilerHandle);
+            break;
+        }
+        case GL_VERTEX_SHADER:
+        {
+            translatedShader.activeAttributes =
+                GetActiveShaderVariables(sh::GetAttributes(compilerHandle));
+            break;
+        }
+        case GL_FRAGMENT_SHADER:
+        {
+            // TODO(jmadill): Figure out why we only sort in the FS, and if we need to.
+            std::sort(translatedShader.varyings.begin(), translatedShader.varyings.end(),
+                      CompareShaderVar);
+            translatedShader.activeOutputVariables =
+                GetActiveShaderVariables(sh::GetOutputVariables(compilerHandle));
+            break;
+        }
+        default:
+            UNREACHABLE();
+    }
+
+    if (IsOutputHLSL(translatedShader.outputType))
+    {
+        translatedShader.uniformRegisters = *sh::GetUniformRegisterMap(compilerHandle);
+
+        for (const sh::InterfaceBlock &interfaceBlock : translatedShader.interfaceBlocks)
+        {
+            if (interfaceBlock.staticUse)
+            {
+                unsigned int index = static_cast<unsigned int>(-1);
+                bool blockRegisterResult =
+                    sh::GetInterfaceBlockRegister(compilerHandle, interfaceBlock.name, &index);
+                ASSERT(blockRegisterResult);
+
+                translatedShader.interfaceBlockRegisters[interfaceBlock.name] = index;
+            }
+        }
+    }
+
+    ASSERT(!translatedShader.objectCode.empty());
+}
+
+class Shader::CompilingState final : angle::NonCopyable
+{
+  public:
+    CompilingState(std::unique_ptr<CompileTask> &&compileTask,
+                   TranslatedShaderCache *cache,
+                   const TranslatedShaderHash &shaderHash)
+        : task(std::move(compileTask)), cache(cache), shaderHash(shaderHash)
+    {
+    }
+
+    std::unique_ptr<CompileTask> task;
+    angle::WaitableEvent event;
+
+    // Receives the results of a successful compile, nullptr if they aren't cached.
+    TranslatedShaderCache *cache;
+    TranslatedShaderHash shaderHash;
+};
+
 ShaderState::ShaderState(GLenum shaderType) : mLabel(), mShaderType(shaderType), mShaderVersion(100)
 {
     mLocalSize.fill(-1);
@@ -96,6 +234,9 @@ Shader::Shader(ShaderProgramManager *manager,
       mRefCount(0),
       mDeleteStatus(false),
       mCompiled(false),
+      mHasCompileHash(false),
+      mBoundCompiler(nullptr),
+      mPendingLinkCount(0),
       mResourceManager(manager)
 {
     ASSERT(mImplementation);
@@ -103,9 +244,17 @@ Shader::Shader(ShaderProgramManager *manager,
 
 Shader::~Shader()
 {
+    ASSERT(!mCompilingState && mBoundCompiler == nullptr);
     SafeDelete(mImplementation);
 }
 
+void Shader::destroy(const Context *context)
+{
+    // Programs hold a reference to their attached shaders, so no link can be reading this one.
+    ASSERT(mPendingLinkCount == 0);
+    resolveCompile();
+}
+
 void Shader::setLabel(const std::string &label)
 {
     mState.mLabel = label;
@@ -142,6 +291,8 @@ void Shader::setSource(GLsizei count, const char *const *string, const GLint *le
 
 int Shader::getInfoLogLength() const
 {
+    resolveCompile();
+
     if (mInfoLog.empty())
     {
         return 0;
@@ -152,6 +303,8 @@ int Shader::getInfoLogLength() const
 
 void Shader::getInfoLog(GLsizei bufSize, GLsizei *length, char *infoLog) const
 {
+    resolveCompile();
+
     int index = 0;
 
     if (bufSize > 0)
@@ -175,6 +328,8 @@ int Shader::getSourceLength() const
 
 int Shader::getTranslatedSourceLength() const
 {
+    resolveCompile();
+
     if (mState.mTranslatedSource.empty())
     {
         return 0;
@@ -185,6 +340,8 @@ int Shader::getTranslatedSourceLength() const
 
 int Shader::getTranslatedSourceWithDebugInfoLength() const
 {
+    resolveCompile();
+
     const std::string &debugInfo = mImplementation->getDebugInfo();
     if (debugInfo.empty())
     {
@@ -219,28 +376,30 @@ void Shader::getSource(GLsizei bufSize, GLsizei *length, char *buffer) const
 
 void Shader::getTranslatedSource(GLsizei bufSize, GLsizei *length, char *buffer) const
 {
+    resolveCompile();
     getSourceImpl(mState.mTranslatedSource, bufSize, length, buffer);
 }
 
 void Shader::getTranslatedSourceWithDebugInfo(GLsizei bufSize, GLsizei *length, char *buffer) const
 {
+    resolveCompile();
     const std::string &debugInfo = mImplementation->getDebugInfo();
     getSourceImpl(debugInfo, bufSize, length, buffer);
 }
 
 void Shader::compile(const Context *context)
 {
-    mState.mTranslatedSource.clear();
-    mInfoLog.clear();
-    mState.mShaderVersion = 100;
-    mState.mVaryings.clear();
-    mState.mUniforms.clear();
-    mState.mInterfaceBlocks.clear();
-    mState.mActiveAttributes.clear();
-    mState.mActiveOutputVariables.clear();
+    // Only the latest compile matters, finish any earlier one so its compiler is returned.
+    resolveCompile();
+
+    // Preparing the source resets implementation state that a pending link still reads.
+    if (mPendingLinkCount > 0)
+    {
+        mResourceManager->resolvePendingLinks();
+        ASSERT(mPendingLinkCount == 0);
+    }
 
     Compiler *compiler = context->getCompiler();
-    ShHandle compilerHandle = compiler->getCompilerHandle(mState.mShaderType);
 
     std::stringstream sourceStream;
 
@@ -266,84 +425,147 @@ void Shader::compile(const Context *context)
         compileOptions |= SH_VALIDATE_LOOP_INDEXING;
     }
 
-    std::string sourceString  = sourceStream.str();
-    std::vector<const char *> sourceCStrings;
+    std::string source = sourceStream.str();
 
-    if (!sourcePath.empty())
+    // The program cache identifies the programs by the hashes of their shaders.
+    TranslatedShaderCache *cache = context->getTranslatedShaderCache();
+    mHasCompileHash = (cache != nullptr || context->getProgramCache() != nullptr);
+    if (mHasCompileHash)
     {
-        sourceCStrings.push_back(sourcePath.c_str());
+        compiler->computeTranslatedShaderHash(mState.mShaderType, source, compileOptions,
+                                              &mCompileHash);
+    }
+
+    // A source path names a new temporary file for every compile, those aren't worth caching.
+    TranslatedShaderHash shaderHash = mCompileHash;
+    if (cache && sourcePath.empty())
+    {
+        TranslatedShader translatedShader;
+        if (cache->get(shaderHash, &translatedShader))
+        {
+            mInfoLog = translatedShader.infoLog;
+            setTranslatedShader(translatedShader, mState.mSource);
+            mCompiled = mImplementation->postTranslateCompile(translatedShader, &mInfoLog);
+            return;
+        }
+    }
+    else
+    {
+        cache = nullptr;
     }
 
-    sourceCStrings.push_back(sourceString.c_str());
+    std::unique_ptr<CompileTask> compileTask(
+        new CompileTask(compiler->getInstance(mState.mShaderType), compileOptions,
+                        std::move(sourcePath), std::move(source), std::string(mState.mSource)));
 
-    bool result =
-        sh::Compile(compilerHandle, &sourceCStrings[0], sourceCStrings.size(), compileOptions);
+    // The context may re-create its compiler before this compile is resolved.
+    compiler->addRef();
+    mBoundCompiler = compiler;
 
-    if (!result)
+    mCompilingState.reset(new CompilingState(std::move(compileTask), cache, shaderHash));
+    mCompilingState->event =
+        context->getWorkerThreadPool()->postWorkerTask(mCompilingState->task.get());
+}
+
+void Shader::resolveCompile() const
+{
+    if (!mCompilingState)
     {
-        mInfoLog = sh::GetInfoLog(compilerHandle);
+        return;
+    }
+
+    mCompilingState->event.wait();
+
+    // Links started after this compile resolve it first, and earlier ones were resolved by compile.
+    ASSERT(mPendingLinkCount == 0);
+
+    std::unique_ptr<CompilingState> compilingState(std::move(mCompilingState));
+    CompileTask *task = compilingState->task.get();
+
+    if (task->result)
+    {
+        mInfoLog = task->translatedShader.infoLog;
+        if (compilingState->cache)
+        {
+            compilingState->cache->put(compilingState->shaderHash, task->translatedShader);
+        }
+        setTranslatedShader(task->translatedShader, task->originalSource);
+        mCompiled = mImplementation->postTranslateCompile(task->translatedShader, &mInfoLog);
+    }
+    else
+    {
+        mInfoLog = std::move(task->infoLog);
         WARN() << std::endl << mInfoLog;
         mCompiled = false;
-        return;
+
+        // Leave no results of an earlier compile behind.
+        setTranslatedShader(TranslatedShader(), std::string());
     }
 
-    mState.mTranslatedSource = sh::GetObjectCode(compilerHandle);
+    mBoundCompiler->putInstance(std::move(task->compilerInstance));
+    mBoundCompiler->release();
+    mBoundCompiler = nullptr;
+}
+
+void Shader::setTranslatedShader(const TranslatedShader &translatedShader,
+                                 const std::string &originalSource) const
+{
+    mState.mTranslatedSource = translatedShader.objectCode;
 
 #ifndef NDEBUG
     // Prefix translated shader with commented out un-translated shader.
     // Useful in diagnostics tools which capture the shader source.
-    std::ostringstream shaderStream;
-    shaderStream << "// GLSL\n";
-    shaderStream << "//\n";
-
-    std::istringstream inputSourceStream(mState.mSource);
-    std::string line;
-    while (std::getline(inputSourceStream, line))
+    if (!mState.mTranslatedSource.empty())
     {
-        // Remove null characters from the source line
-        line.erase(std::remove(line.begin(), line.end(), '\0'), line.end());
+        std::ostringstream shaderStream;
+        shaderStream << "// GLSL\n";
+        shaderStream << "//\n";
 
-        shaderStream << "// " << line;
+        std::istringstream inputSourceStream(originalSource);
+        std::string line;
+        while (std::getline(inputSourceStream, line))
+        {
+            // Remove null characters from the source line
+            line.erase(std::remove(line.begin(), line.end(), '\0'), line.end());
+
+            shaderStream << "// " << line;
+        }
+        shaderStream << "\n\n";
+        shaderStream << mState.mTranslatedSource;
+        mState.mTranslatedSource = shaderStream.str();
     }
-    shaderStream << "\n\n";
-    shaderStream << mState.mTranslatedSource;
-    mState.mTranslatedSource = shaderStream.str();
 #endif
 
-    // Gather the shader information
-    mState.mShaderVersion = sh::GetShaderVersion(compilerHandle);
-
-    mState.mVaryings        = GetShaderVariables(sh::GetVaryings(compilerHandle));
-    mState.mUniforms        = GetShaderVariables(sh::GetUniforms(compilerHandle));
-    mState.mInterfaceBlocks = GetShaderVariables(sh::GetInterfaceBlocks(compilerHandle));
+    mState.mShaderVersion         = translatedShader.shaderVersion;
+    mState.mLocalSize             = translatedShader.localSize;
+    mState.mVaryings              = translatedShader.varyings;
+    mState.mUniforms              = translatedShader.uniforms;
+    mState.mInterfaceBlocks       = translatedShader.interfaceBlocks;
+    mState.mActiveAttributes      = translatedShader.activeAttributes;
+    mState.mActiveOutputVariables = translatedShader.activeOutputVariables;
+}
 
-    switch (mState.mShaderType)
+bool Shader::getCompileHash(TranslatedShaderHash *hashOut) const
+{
+    if (!mHasCompileHash)
     {
-        case GL_COMPUTE_SHADER:
-        {
-            mState.mLocalSize = sh::GetComputeShaderLocalGroupSize(compilerHandle);
-            break;
-        }
-        case GL_VERTEX_SHADER:
-        {
-            mState.mActiveAttributes = GetActiveShaderVariables(sh::GetAttributes(compilerHandle));
-            break;
-        }
-        case GL_FRAGMENT_SHADER:
-        {
-            // TODO(jmadill): Figure out why we only sort in the FS, and if we need to.
-            std::sort(mState.mVaryings.begin(), mState.mVaryings.end(), CompareShaderVar);
-            mState.mActiveOutputVariables =
-                GetActiveShaderVariables(sh::GetOutputVariables(compilerHandle));
-            break;
-        }
-        default:
-            UNREACHABLE();
+        return false;
     }
 
-    ASSERT(!mState.mTranslatedSource.empty());
+    *hashOut = mCompileHash;
+    return true;
+}
+
+bool Shader::isCompiled() const
+{
+    resolveCompile();
+    return mCompiled;
+}
 
-    mCompiled = mImplementation->postTranslateCompile(compiler, &mInfoLog);
+void Shader::removePendingLink()
+{
+    ASSERT(mPendingLinkCount > 0);
+    mPendingLinkCount--;
 }
 
 void Shader::addRef()
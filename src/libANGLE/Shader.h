@@ -14,6 +14,7 @@
 
 #include <string>
 #include <list>
+#include <memory>
 #include <vector>
 
 #include "angle_gl.h"
@@ -22,6 +23,7 @@
 #include "common/angleutils.h"
 #include "libANGLE/angletypes.h"
 #include "libANGLE/Debug.h"
+#include "libANGLE/TranslatedShaderCache.h"
 
 namespace rx
 {
@@ -36,6 +38,7 @@ class Compiler;
 class ContextState;
 struct Limitations;
 class ShaderProgramManager;
+class ShCompilerInstance;
 class Context;
 
 class ShaderState final : angle::NonCopyable
@@ -89,7 +92,7 @@ class Shader final : angle::NonCopyable, public LabeledObject
            GLenum type,
            GLuint handle);
 
-    void destroy(const Context *context) {}
+    void destroy(const Context *context);
     virtual ~Shader();
 
     void setLabel(const std::string &label) override;
@@ -112,8 +115,19 @@ class Shader final : angle::NonCopyable, public LabeledObject
     void getTranslatedSource(GLsizei bufSize, GLsizei *length, char *buffer) const;
     void getTranslatedSourceWithDebugInfo(GLsizei bufSize, GLsizei *length, char *buffer) const;
 
+    // Translation runs on the context's worker thread pool. The results, and the compile status,
+    // are applied the next time they are queried or the shader is linked.
     void compile(const Context *context);
-    bool isCompiled() const { return mCompiled; }
+    void resolveCompile() const;
+    bool isCompiled() const;
+
+    // Identifies the source, compile options and translator resources of the latest compile,
+    // without waiting for it. Returns false if the shader was never compiled.
+    bool getCompileHash(TranslatedShaderHash *hashOut) const;
+
+    // Links in flight read the compile results, they are resolved before the results change.
+    void addPendingLink() { mPendingLinkCount++; }
+    void removePendingLink();
 
     void addRef();
     void release(const Context *context);
@@ -134,17 +148,33 @@ class Shader final : angle::NonCopyable, public LabeledObject
     const sh::WorkGroupSize &getWorkGroupSize() const { return mState.mLocalSize; }
 
   private:
+    class CompileTask;
+    class CompilingState;
+
     static void getSourceImpl(const std::string &source, GLsizei bufSize, GLsizei *length, char *buffer);
 
-    ShaderState mState;
+    // Updates the state with the results of translating |originalSource|.
+    void setTranslatedShader(const TranslatedShader &translatedShader,
+                             const std::string &originalSource) const;
+
+    // The results of a compile are applied by resolveCompile, which the const queries call.
+    mutable ShaderState mState;
     rx::ShaderImpl *mImplementation;
     const gl::Limitations &mRendererLimitations;
     const GLuint mHandle;
     const GLenum mType;
     unsigned int mRefCount;     // Number of program objects this shader is attached to
     bool mDeleteStatus;         // Flag to indicate that the shader can be deleted when no longer in use
-    bool mCompiled;             // Indicates if this shader has been successfully compiled
-    std::string mInfoLog;
+    mutable bool mCompiled;     // Indicates if this shader has been successfully compiled
+    mutable std::string mInfoLog;
+
+    bool mHasCompileHash;
+    TranslatedShaderHash mCompileHash;
+
+    // Set while a compile is in flight. The bound compiler receives the compiler instance back.
+    mutable std::unique_ptr<CompilingState> mCompilingState;
+    mutable Compiler *mBoundCompiler;
+    unsigned int mPendingLinkCount;
 
     ShaderProgramManager *mResourceManager;
 };
@@ -0,0 +1,136 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// SizedMRUCache.h: A hashing map that stores blobs of sized, untyped data. Entries are evicted in
+// least-recently-used order once the total size of the stored values exceeds the maximum size.
+
+#ifndef LIBANGLE_SIZED_MRU_CACHE_H_
+#define LIBANGLE_SIZED_MRU_CACHE_H_
+
+#include "common/angleutils.h"
+#include "common/debug.h"
+
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace angle
+{
+
+template <typename Key, typename Value, typename KeyHasher = std::hash<Key>>
+class SizedMRUCache final : angle::NonCopyable
+{
+  public:
+    SizedMRUCache(size_t maximumTotalSize)
+        : mMaximumTotalSize(maximumTotalSize), mCurrentSize(0), mEvictionCount(0)
+    {
+    }
+
+    // Returns nullptr on failure. The returned pointer stays valid until the entry is evicted or
+    // removed.
+    const Value *put(const Key &key, Value &&value, size_t size)
+    {
+        if (size > mMaximumTotalSize)
+        {
+            return nullptr;
+        }
+
+        // Check for existing key.
+        eraseByKey(key);
+
+        mEntries.emplace_front(key, ValueAndSize(std::move(value), size));
+        mLookup[key] = mEntries.begin();
+        mCurrentSize += size;
+
+        shrinkToSize(mMaximumTotalSize);
+
+        return &mEntries.front().second.value;
+    }
+
+    bool get(const Key &key, const Value **valueOut)
+    {
+        auto iter = mLookup.find(key);
+        if (iter == mLookup.end())
+        {
+            return false;
+        }
+
+        // Move the entry to the front of the recently used list.
+        mEntries.splice(mEntries.begin(), mEntries, iter->second);
+        *valueOut = &iter->second->second.value;
+        return true;
+    }
+
+    bool eraseByKey(const Key &key)
+    {
+        auto iter = mLookup.find(key);
+        if (iter == mLookup.end())
+        {
+            return false;
+        }
+
+        ASSERT(mCurrentSize >= iter->second->second.size);
+        mCurrentSize -= iter->second->second.size;
+        mEntries.erase(iter->second);
+        mLookup.erase(iter);
+        return true;
+    }
+
+    // Evicts the least recently used entries until the total size is at most |limit|. Returns
+    // the number of bytes released.
+    size_t shrinkToSize(size_t limit)
+    {
+        size_t initialSize = mCurrentSize;
+
+        while (mCurrentSize > limit)
+        {
+            ASSERT(!mEntries.empty());
+            const auto &last = mEntries.back();
+            ASSERT(mCurrentSize >= last.second.size);
+            mCurrentSize -= last.second.size;
+            mLookup.erase(last.first);
+            mEntries.pop_back();
+            mEvictionCount++;
+        }
+
+        return (initialSize - mCurrentSize);
+    }
+
+    void clear()
+    {
+        mEntries.clear();
+        mLookup.clear();
+        mCurrentSize = 0;
+    }
+
+    bool empty() const { return mEntries.empty(); }
+    size_t entryCount() const { return mEntries.size(); }
+    size_t size() const { return mCurrentSize; }
+    size_t maxSize() const { return mMaximumTotalSize; }
+
+    // Number of entries dropped to stay under the maximum size, over the cache's lifetime.
+    size_t evictionCount() const { return mEvictionCount; }
+
+  private:
+    struct ValueAndSize
+    {
+        ValueAndSize(Value &&valueIn, size_t sizeIn) : value(std::move(valueIn)), size(sizeIn) {}
+
+        Value value;
+        size_t size;
+    };
+
+    using EntryList = std::list<std::pair<Key, ValueAndSize>>;
+
+    EntryList mEntries;
+    std::unordered_map<Key, typename EntryList::iterator, KeyHasher> mLookup;
+    size_t mMaximumTotalSize;
+    size_t mCurrentSize;
+    size_t mEvictionCount;
+};
+
+}  // namespace angle
+
+#endif  // LIBANGLE_SIZED_MRU_CACHE_H_
@@ -0,0 +1,187 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// SizedMRUCache_unittest.cpp: Unit tests for the sized MRU cache and the program cache built on it.
+
+#include <gtest/gtest.h>
+
+#include "libANGLE/ProgramCache.h"
+#include "libANGLE/SizedMRUCache.h"
+
+namespace angle
+{
+
+namespace
+{
+
+using Blob = std::vector<uint8_t>;
+
+Blob MakeBlob(size_t size)
+{
+    Blob blob;
+    for (uint8_t value = 0; value < size; ++value)
+    {
+        blob.push_back(value);
+    }
+    return blob;
+}
+
+}  // anonymous namespace
+
+// Test a cache with a value that takes up maximum size.
+TEST(SizedMRUCacheTest, MaxSizedValue)
+{
+    constexpr size_t kSize = 32;
+    SizedMRUCache<std::string, Blob> sizedCache(kSize);
+
+    EXPECT_NE(nullptr, sizedCache.put("test", MakeBlob(kSize), kSize));
+    EXPECT_EQ(32u, sizedCache.size());
+    EXPECT_FALSE(sizedCache.empty());
+
+    EXPECT_NE(nullptr, sizedCache.put("test2", MakeBlob(kSize), kSize));
+    EXPECT_EQ(32u, sizedCache.size());
+    EXPECT_FALSE(sizedCache.empty());
+    EXPECT_EQ(1u, sizedCache.evictionCount());
+
+    const Blob *blob = nullptr;
+    EXPECT_FALSE(sizedCache.get("test", &blob));
+
+    sizedCache.clear();
+    EXPECT_TRUE(sizedCache.empty());
+}
+
+// Test a cache with many small values, that it can handle unlimited inserts.
+TEST(SizedMRUCacheTest, ManySmallValues)
+{
+    constexpr size_t kSize = 32;
+    SizedMRUCache<size_t, size_t> sizedCache(kSize);
+
+    for (size_t value = 0; value < kSize; ++value)
+    {
+        size_t valueCopy = value;
+        EXPECT_NE(nullptr, sizedCache.put(value, std::move(valueCopy), 1));
+
+        const size_t *qvalue = nullptr;
+        EXPECT_TRUE(sizedCache.get(value, &qvalue));
+        if (qvalue)
+        {
+            EXPECT_EQ(value, *qvalue);
+        }
+    }
+
+    EXPECT_EQ(32u, sizedCache.size());
+    EXPECT_FALSE(sizedCache.empty());
+    EXPECT_EQ(0u, sizedCache.evictionCount());
+
+    // Putting one element evicts the first element.
+    EXPECT_NE(nullptr, sizedCache.put(kSize, static_cast<size_t>(kSize), 1));
+
+    const size_t *qvalue = nullptr;
+    EXPECT_FALSE(sizedCache.get(0, &qvalue));
+    EXPECT_EQ(1u, sizedCache.evictionCount());
+
+    // Putting one large element cleans out the whole stack.
+    EXPECT_NE(nullptr, sizedCache.put(kSize + 1, static_cast<size_t>(kSize + 1), kSize));
+    EXPECT_EQ(32u, sizedCache.size());
+    EXPECT_FALSE(sizedCache.empty());
+
+    for (size_t value = 0; value <= kSize; ++value)
+    {
+        EXPECT_FALSE(sizedCache.get(value, &qvalue));
+    }
+    EXPECT_TRUE(sizedCache.get(kSize + 1, &qvalue));
+    if (qvalue)
+    {
+        EXPECT_EQ(kSize + 1, *qvalue);
+    }
+
+    // Put a bunch of items in the cache sequentially.
+    for (size_t value = 0; value < kSize * 10; ++value)
+    {
+        size_t valueCopy = value;
+        EXPECT_NE(nullptr, sizedCache.put(value, std::move(valueCopy), 1));
+    }
+
+    EXPECT_EQ(32u, sizedCache.size());
+}
+
+// Test that reading an entry protects it from eviction.
+TEST(SizedMRUCacheTest, GetRefreshesEntry)
+{
+    SizedMRUCache<int, int> sizedCache(2);
+
+    EXPECT_NE(nullptr, sizedCache.put(1, 1, 1));
+    EXPECT_NE(nullptr, sizedCache.put(2, 2, 1));
+
+    const int *value = nullptr;
+    EXPECT_TRUE(sizedCache.get(1, &value));
+
+    // Evicts 2, which is now the least recently used.
+    EXPECT_NE(nullptr, sizedCache.put(3, 3, 1));
+    EXPECT_TRUE(sizedCache.get(1, &value));
+    EXPECT_FALSE(sizedCache.get(2, &value));
+    EXPECT_TRUE(sizedCache.get(3, &value));
+}
+
+// Test that values larger than the whole cache are rejected.
+TEST(SizedMRUCacheTest, OversizedValue)
+{
+    SizedMRUCache<int, int> sizedCache(4);
+
+    EXPECT_EQ(nullptr, sizedCache.put(1, 1, 5));
+    EXPECT_TRUE(sizedCache.empty());
+}
+
+}  // namespace angle
+
+namespace gl
+{
+
+namespace
+{
+
+ProgramHash MakeHash(uint8_t seed)
+{
+    ProgramHash hash;
+    hash.fill(seed);
+    return hash;
+}
+
+angle::MemoryBuffer MakeBinary(size_t size)
+{
+    angle::MemoryBuffer binary;
+    EXPECT_TRUE(binary.resize(size));
+    memset(binary.data(), 0xAB, size);
+    return binary;
+}
+
+}  // anonymous namespace
+
+// Test that the program cache counts hits, misses and evictions.
+TEST(ProgramCacheTest, Counters)
+{
+    ProgramCache cache(16);
+
+    EXPECT_EQ(nullptr, cache.get(MakeHash(1)));
+    EXPECT_EQ(1u, cache.getMissCount());
+
+    cache.put(MakeHash(1), MakeBinary(8));
+    const angle::MemoryBuffer *binary = cache.get(MakeHash(1));
+    ASSERT_NE(nullptr, binary);
+    EXPECT_EQ(8u, binary->size());
+    EXPECT_EQ(1u, cache.getHitCount());
+
+    cache.put(MakeHash(2), MakeBinary(8));
+    cache.put(MakeHash(3), MakeBinary(8));
+    EXPECT_EQ(1u, cache.getEvictionCount());
+    EXPECT_EQ(2u, cache.entryCount());
+    EXPECT_EQ(16u, cache.size());
+
+    cache.remove(MakeHash(3));
+    EXPECT_EQ(nullptr, cache.get(MakeHash(3)));
+    EXPECT_EQ(2u, cache.getMissCount());
+}
+
+}  // namespace gl
@@ -59,11 +59,14 @@ State::State()
       mProgram(nullptr),
       mVertexArray(nullptr),
       mActiveSampler(0),
+      mActiveTexturesDirty(true),
+      mActiveTexturesProgramSerial(0),
       mPrimitiveRestart(false),
       mMultiSampling(false),
       mSampleAlphaToOne(false),
       mFramebufferSRGB(true),
-      mRobustResourceInit(false)
+      mRobustResourceInit(false),
+      mDrawValidationSerial(1)
 {
 }
 
@@ -188,6 +191,16 @@ void State::initialize(const Caps &caps,
 
     mSamplers.resize(caps.maxCombinedTextureImageUnits);
 
+    ASSERT(caps.maxCombinedTextureImageUnits <= IMPLEMENTATION_MAX_ACTIVE_TEXTURES);
+    mActiveTextureTypes.resize(caps.maxCombinedTextureImageUnits, GL_NONE);
+    mCompletenessTextureBindings.reserve(caps.maxCombinedTextureImageUnits);
+    mCompletenessSamplerBindings.reserve(caps.maxCombinedTextureImageUnits);
+    for (GLuint textureUnit = 0; textureUnit < caps.maxCombinedTextureImageUnits; ++textureUnit)
+    {
+        mCompletenessTextureBindings.emplace_back(this, textureUnit);
+        mCompletenessSamplerBindings.emplace_back(this, textureUnit);
+    }
+
     mActiveQueries[GL_ANY_SAMPLES_PASSED].set(nullptr);
     mActiveQueries[GL_ANY_SAMPLES_PASSED_CONSERVATIVE].set(nullptr);
     mActiveQueries[GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN].set(nullptr);
@@ -279,6 +292,9 @@ void State::reset(const Context *context)
 
     mProgram = NULL;
 
+    mActiveTexturesDirty = true;
+    mDirtyObjects.set(DIRTY_OBJECT_PROGRAM_TEXTURES);
+
     angle::Matrix<GLfloat>::setToIdentity(mPathMatrixProj);
     angle::Matrix<GLfloat>::setToIdentity(mPathMatrixMV);
     mPathStencilFunc = GL_ALWAYS;
@@ -287,6 +303,7 @@ void State::reset(const Context *context)
 
     // TODO(jmadill): Is this necessary?
     setAllDirtyBits();
+    invalidateDrawValidation();
 }
 
 const RasterizerState &State::getRasterizerState() const
@@ -777,6 +794,7 @@ unsigned int State::getActiveSampler() const
 void State::setSamplerTexture(GLenum type, Texture *texture)
 {
     mSamplerTextures[type][mActiveSampler].set(texture);
+    setTextureUnitDirty(mActiveSampler);
 }
 
 Texture *State::getTargetTexture(GLenum target) const
@@ -824,6 +842,7 @@ void State::detachTexture(const Context *context, const TextureMap &zeroTextures
                 ASSERT(it != zeroTextures.end());
                 // Zero textures are the "default" textures instead of NULL
                 binding.set(it->second.get());
+                setTextureUnitDirty(textureIdx);
             }
         }
     }
@@ -860,6 +879,7 @@ void State::initializeZeroTextures(const TextureMap &zeroTextures)
 void State::setSamplerBinding(GLuint textureUnit, Sampler *sampler)
 {
     mSamplers[textureUnit].set(sampler);
+    setTextureUnitDirty(textureUnit);
 }
 
 GLuint State::getSamplerId(GLuint textureUnit) const
@@ -885,6 +905,7 @@ void State::detachSampler(GLuint sampler)
         if (samplerBinding.id() == sampler)
         {
             samplerBinding.set(NULL);
+            setTextureUnitDirty(textureUnit);
         }
     }
 }
@@ -1016,6 +1037,7 @@ void State::setVertexArrayBinding(VertexArray *vertexArray)
 {
     mVertexArray = vertexArray;
     mDirtyBits.set(DIRTY_BIT_VERTEX_ARRAY_BINDING);
+    invalidateDrawValidation();
 
     if (mVertexArray && mVertexArray->hasAnyDirtyBit())
     {
@@ -1042,6 +1064,7 @@ bool State::removeVertexArrayBinding(GLuint vertexArray)
         mVertexArray = NULL;
         mDirtyBits.set(DIRTY_BIT_VERTEX_ARRAY_BINDING);
         mDirtyObjects.set(DIRTY_OBJECT_VERTEX_ARRAY);
+        invalidateDrawValidation();
         return true;
     }
 
@@ -1061,12 +1084,14 @@ void State::bindVertexBuffer(GLuint bindingIndex,
 {
     getVertexArray()->bindVertexBuffer(bindingIndex, boundBuffer, offset, stride);
     mDirtyObjects.set(DIRTY_OBJECT_VERTEX_ARRAY);
+    invalidateDrawValidation();
 }
 
 void State::setVertexAttribBinding(GLuint attribIndex, GLuint bindingIndex)
 {
     getVertexArray()->setVertexAttribBinding(attribIndex, bindingIndex);
     mDirtyObjects.set(DIRTY_OBJECT_VERTEX_ARRAY);
+    invalidateDrawValidation();
 }
 
 void State::setVertexAttribFormat(GLuint attribIndex,
@@ -1102,6 +1127,11 @@ void State::setProgram(const Context *context, Program *newProgram)
         {
             newProgram->addRef();
         }
+
+        invalidateDrawValidation();
+
+        mActiveTexturesDirty = true;
+        mDirtyObjects.set(DIRTY_OBJECT_PROGRAM_TEXTURES);
     }
 }
 
@@ -1110,6 +1140,87 @@ Program *State::getProgram() const
     return mProgram;
 }
 
+void State::signal(angle::SignalToken token)
+{
+    setTextureUnitDirty(token);
+}
+
+void State::setTextureUnitDirty(size_t textureUnit)
+{
+    // The units the program does not sample from are re-checked when the program changes.
+    if (mActiveTexturesMask[textureUnit])
+    {
+        mDirtyTextureUnits.set(textureUnit);
+        mDirtyObjects.set(DIRTY_OBJECT_PROGRAM_TEXTURES);
+    }
+}
+
+void State::syncProgramTextures(const ContextState &data)
+{
+    if (mActiveTexturesDirty)
+    {
+        mActiveTexturesDirty = false;
+        mActiveTexturesMask.reset();
+        mIncompleteTexturesMask.reset();
+        std::fill(mActiveTextureTypes.begin(), mActiveTextureTypes.end(), GL_NONE);
+
+        if (mProgram)
+        {
+            mActiveTexturesProgramSerial = mProgram->getDrawValidationSerial();
+
+            for (const SamplerBinding &samplerBinding : mProgram->getSamplerBindings())
+            {
+                for (GLuint textureUnit : samplerBinding.boundTextureUnits)
+                {
+                    // Out of range units and units sampled with several texture types fail the
+                    // draw validation.
+                    if (textureUnit < mActiveTextureTypes.size() &&
+                        !mActiveTexturesMask[textureUnit])
+                    {
+                        mActiveTexturesMask.set(textureUnit);
+                        mActiveTextureTypes[textureUnit] = samplerBinding.textureType;
+                    }
+                }
+            }
+        }
+
+        for (size_t textureUnit = 0; textureUnit < mActiveTextureTypes.size(); ++textureUnit)
+        {
+            if (!mActiveTexturesMask[textureUnit])
+            {
+                mCompletenessTextureBindings[textureUnit].reset();
+                mCompletenessSamplerBindings[textureUnit].reset();
+            }
+        }
+
+        mDirtyTextureUnits = mActiveTexturesMask;
+    }
+
+    for (size_t textureUnit : angle::IterateBitSet(mDirtyTextureUnits))
+    {
+        const auto textures = mSamplerTextures.find(mActiveTextureTypes[textureUnit]);
+        Texture *texture =
+            textures != mSamplerTextures.end() ? textures->second[textureUnit].get() : nullptr;
+        Sampler *sampler = mSamplers[textureUnit].get();
+
+        mCompletenessTextureBindings[textureUnit].bind(
+            texture ? texture->getCompletenessChannel() : nullptr);
+        mCompletenessSamplerBindings[textureUnit].bind(sampler ? sampler->getDirtyChannel()
+                                                               : nullptr);
+
+        bool complete = false;
+        if (texture)
+        {
+            const SamplerState &samplerState =
+                sampler ? sampler->getSamplerState() : texture->getSamplerState();
+            complete = texture->getTextureState().isSamplerComplete(samplerState, data);
+        }
+        mIncompleteTexturesMask.set(textureUnit, !complete);
+    }
+
+    mDirtyTextureUnits.reset();
+}
+
 void State::setTransformFeedbackBinding(TransformFeedback *transformFeedback)
 {
     mTransformFeedback.set(transformFeedback);
@@ -1209,6 +1320,7 @@ void State::setGenericUniformBufferBinding(Buffer *buffer)
 void State::setIndexedUniformBufferBinding(GLuint index, Buffer *buffer, GLintptr offset, GLsizeiptr size)
 {
     mUniformBuffers[index].set(buffer, offset, size);
+    invalidateDrawValidation();
 }
 
 const OffsetBindingPointer<Buffer> &State::getIndexedUniformBuffer(size_t index) const
@@ -1322,12 +1434,14 @@ void State::detachBuffer(GLuint bufferName)
     }
 
     getVertexArray()->detachBuffer(bufferName);
+    invalidateDrawValidation();
 }
 
 void State::setEnableVertexAttribArray(unsigned int attribNum, bool enabled)
 {
     getVertexArray()->enableAttribute(attribNum, enabled);
     mDirtyObjects.set(DIRTY_OBJECT_VERTEX_ARRAY);
+    invalidateDrawValidation();
 }
 
 void State::setVertexAttribf(GLuint index, const GLfloat values[4])
@@ -1362,6 +1476,7 @@ void State::setVertexAttribState(unsigned int attribNum,
 {
     getVertexArray()->setAttributeState(attribNum, boundBuffer, size, type, normalized, pureInteger, stride, pointer);
     mDirtyObjects.set(DIRTY_OBJECT_VERTEX_ARRAY);
+    invalidateDrawValidation();
 }
 
 void State::setVertexAttribDivisor(GLuint index, GLuint divisor)
@@ -2106,6 +2221,19 @@ bool State::hasMappedBuffer(GLenum target) const
 
 void State::syncDirtyObjects(const Context *context)
 {
+    // Uniforms are set on the program object directly, not through the State.
+    if (mProgram && mProgram->hasDirtyUniforms())
+    {
+        mDirtyObjects.set(DIRTY_OBJECT_PROGRAM);
+    }
+
+    // So are the sampler uniforms, and the program can be relinked while it is current.
+    if (mProgram && mProgram->getDrawValidationSerial() != mActiveTexturesProgramSerial)
+    {
+        mActiveTexturesDirty = true;
+        mDirtyObjects.set(DIRTY_OBJECT_PROGRAM_TEXTURES);
+    }
+
     if (!mDirtyObjects.any())
         return;
 
@@ -2131,7 +2259,13 @@ void State::syncDirtyObjects(const Context *context, const DirtyObjects &bitset)
                 mVertexArray->syncImplState(context);
                 break;
             case DIRTY_OBJECT_PROGRAM:
-                // TODO(jmadill): implement this
+                if (mProgram)
+                {
+                    mProgram->syncState();
+                }
+                break;
+            case DIRTY_OBJECT_PROGRAM_TEXTURES:
+                syncProgramTextures(context->getContextState());
                 break;
             default:
                 UNREACHABLE();
@@ -24,21 +24,23 @@
 #include "libANGLE/Version.h"
 #include "libANGLE/VertexAttribute.h"
 #include "libANGLE/angletypes.h"
+#include "libANGLE/signal_utils.h"
 
 namespace gl
 {
 class Query;
 class VertexArray;
 class Context;
+class ContextState;
 struct Caps;
 
 typedef std::map<GLenum, BindingPointer<Texture>> TextureMap;
 
-class State : angle::NonCopyable
+class State : public angle::SignalReceiver, angle::NonCopyable
 {
   public:
     State();
-    ~State();
+    ~State() override;
 
     void initialize(const Caps &caps,
                     const Extensions &extensions,
@@ -202,6 +204,21 @@ class State : angle::NonCopyable
     void setProgram(const Context *context, Program *newProgram);
     Program *getProgram() const;
 
+    // The texture units the current program samples from, and those of them whose texture is not
+    // sampler complete with the sampler state it is sampled with. Only up to date after the dirty
+    // objects are synced for a draw.
+    using ActiveTextureMask = std::bitset<IMPLEMENTATION_MAX_ACTIVE_TEXTURES>;
+    const ActiveTextureMask &getActiveTexturesMask() const { return mActiveTexturesMask; }
+    const ActiveTextureMask &getIncompleteTexturesMask() const { return mIncompleteTexturesMask; }
+    GLenum getActiveTextureType(size_t textureUnit) const
+    {
+        return mActiveTextureTypes[textureUnit];
+    }
+
+    // angle::SignalReceiver implementation. The textures and sampler objects bound to the active
+    // texture units signal the index of the unit when the completeness may have changed.
+    void signal(angle::SignalToken token) override;
+
     // Transform feedback object (not buffer) binding manipulation
     void setTransformFeedbackBinding(TransformFeedback *transformFeedback);
     TransformFeedback *getCurrentTransformFeedback() const;
@@ -344,6 +361,11 @@ class State : angle::NonCopyable
     bool hasMappedBuffer(GLenum target) const;
     bool isRobustResourceInitEnabled() const { return mRobustResourceInit; }
 
+    // Changes whenever a binding or buffer state used by the cached draw validation checks may
+    // have changed. See ValidationContext::isDrawStatesCacheValid.
+    unsigned int getDrawValidationSerial() const { return mDrawValidationSerial; }
+    void invalidateDrawValidation() { mDrawValidationSerial++; }
+
     enum DirtyBitType
     {
         DIRTY_BIT_SCISSOR_TEST_ENABLED,
@@ -421,6 +443,7 @@ class State : angle::NonCopyable
         DIRTY_OBJECT_DRAW_FRAMEBUFFER,
         DIRTY_OBJECT_VERTEX_ARRAY,
         DIRTY_OBJECT_PROGRAM,
+        DIRTY_OBJECT_PROGRAM_TEXTURES,
         DIRTY_OBJECT_UNKNOWN,
         DIRTY_OBJECT_MAX = DIRTY_OBJECT_UNKNOWN,
     };
@@ -440,6 +463,9 @@ class State : angle::NonCopyable
     void setObjectDirty(GLenum target);
 
   private:
+    void setTextureUnitDirty(size_t textureUnit);
+    void syncProgramTextures(const ContextState &data);
+
     // Cached values from Context's caps
     GLuint mMaxDrawBuffers;
     GLuint mMaxCombinedTextureImageUnits;
@@ -495,6 +521,18 @@ class State : angle::NonCopyable
     typedef std::vector<BindingPointer<Sampler>> SamplerBindingVector;
     SamplerBindingVector mSamplers;
 
+    // Completeness of the texture units the current program samples from. The program's sampler
+    // bindings are re-read when it changes or its draw validation serial does, and the units that
+    // are signaled or rebound are re-checked.
+    ActiveTextureMask mActiveTexturesMask;
+    ActiveTextureMask mIncompleteTexturesMask;
+    ActiveTextureMask mDirtyTextureUnits;
+    std::vector<GLenum> mActiveTextureTypes;
+    std::vector<angle::ChannelBinding> mCompletenessTextureBindings;
+    std::vector<angle::ChannelBinding> mCompletenessSamplerBindings;
+    bool mActiveTexturesDirty;
+    unsigned int mActiveTexturesProgramSerial;
+
     typedef std::map<GLenum, BindingPointer<Query>> ActiveQueryMap;
     ActiveQueryMap mActiveQueries;
 
@@ -540,6 +578,8 @@ class State : angle::NonCopyable
 
     DirtyBits mDirtyBits;
     DirtyObjects mDirtyObjects;
+
+    unsigned int mDrawValidationSerial;
 };
 
 }  // namespace gl
@@ -209,10 +209,11 @@ bool TextureState::isSamplerComplete(const SamplerState &samplerState,
                         .first;
     }
 
-    auto cacheEntry = cacheIter->second;
+    SamplerCompletenessCache &cacheEntry = cacheIter->second;
     if (!cacheEntry.cacheValid || cacheEntry.samplerState != samplerState)
     {
         cacheEntry.cacheValid      = true;
+        cacheEntry.samplerState    = samplerState;
         cacheEntry.samplerComplete = computeSamplerCompleteness(samplerState, data);
     }
 
@@ -602,6 +603,7 @@ void Texture::setMinFilter(GLenum minFilter)
 {
     mState.mSamplerState.minFilter = minFilter;
     mDirtyBits.set(DIRTY_BIT_MIN_FILTER);
+    mCompletenessChannel.signal();
 }
 
 GLenum Texture::getMinFilter() const
@@ -613,6 +615,7 @@ void Texture::setMagFilter(GLenum magFilter)
 {
     mState.mSamplerState.magFilter = magFilter;
     mDirtyBits.set(DIRTY_BIT_MAG_FILTER);
+    mCompletenessChannel.signal();
 }
 
 GLenum Texture::getMagFilter() const
@@ -624,6 +627,7 @@ void Texture::setWrapS(GLenum wrapS)
 {
     mState.mSamplerState.wrapS = wrapS;
     mDirtyBits.set(DIRTY_BIT_WRAP_S);
+    mCompletenessChannel.signal();
 }
 
 GLenum Texture::getWrapS() const
@@ -635,6 +639,7 @@ void Texture::setWrapT(GLenum wrapT)
 {
     mState.mSamplerState.wrapT = wrapT;
     mDirtyBits.set(DIRTY_BIT_WRAP_T);
+    mCompletenessChannel.signal();
 }
 
 GLenum Texture::getWrapT() const
@@ -690,6 +695,7 @@ void Texture::setCompareMode(GLenum compareMode)
 {
     mState.mSamplerState.compareMode = compareMode;
     mDirtyBits.set(DIRTY_BIT_COMPARE_MODE);
+    mCompletenessChannel.signal();
 }
 
 GLenum Texture::getCompareMode() const
@@ -730,6 +736,7 @@ void Texture::setBaseLevel(GLuint baseLevel)
     {
         mTexture->setBaseLevel(mState.getEffectiveBaseLevel());
         mDirtyBits.set(DIRTY_BIT_BASE_LEVEL);
+        mCompletenessChannel.signal();
     }
 }
 
@@ -742,6 +749,7 @@ void Texture::setMaxLevel(GLuint maxLevel)
 {
     mState.setMaxLevel(maxLevel);
     mDirtyBits.set(DIRTY_BIT_MAX_LEVEL);
+    mCompletenessChannel.signal();
 }
 
 GLuint Texture::getMaxLevel() const
@@ -852,7 +860,13 @@ egl::Stream *Texture::getBoundStream() const
 void Texture::invalidateCompletenessCache()
 {
     mState.invalidateCompletenessCache();
+    signalDirtyImages();
+}
+
+void Texture::signalDirtyImages()
+{
     mDirtyChannel.signal();
+    mCompletenessChannel.signal();
 }
 
 Error Texture::setImage(const Context *context,
@@ -876,7 +890,7 @@ Error Texture::setImage(const Context *context,
                                  format, type, unpackState, pixels));
 
     mState.setImageDesc(target, level, ImageDesc(size, Format(internalFormat, format, type)));
-    mDirtyChannel.signal();
+    signalDirtyImages();
 
     return NoError();
 }
@@ -916,7 +930,7 @@ Error Texture::setCompressedImage(const Context *context,
                                            size, unpackState, imageSize, pixels));
 
     mState.setImageDesc(target, level, ImageDesc(size, Format(internalFormat)));
-    mDirtyChannel.signal();
+    signalDirtyImages();
 
     return NoError();
 }
@@ -957,7 +971,7 @@ Error Texture::copyImage(const Context *context,
     const GLenum sizedFormat = GetSizedInternalFormat(internalFormat, GL_UNSIGNED_BYTE);
     mState.setImageDesc(target, level, ImageDesc(Extents(sourceArea.width, sourceArea.height, 1),
                                                  Format(sizedFormat)));
-    mDirtyChannel.signal();
+    signalDirtyImages();
 
     return NoError();
 }
@@ -1001,7 +1015,7 @@ Error Texture::copyTexture(const Context *context,
     const auto &sourceDesc   = source->mState.getImageDesc(source->getTarget(), 0);
     const GLenum sizedFormat = GetSizedInternalFormat(internalFormat, type);
     mState.setImageDesc(target, level, ImageDesc(sourceDesc.size, Format(sizedFormat)));
-    mDirtyChannel.signal();
+    signalDirtyImages();
 
     return NoError();
 }
@@ -1036,6 +1050,7 @@ Error Texture::copyCompressedTexture(const Context *context, const Texture *sour
     ASSERT(source->getTarget() != GL_TEXTURE_CUBE_MAP && getTarget() != GL_TEXTURE_CUBE_MAP);
     const auto &sourceDesc = source->mState.getImageDesc(source->getTarget(), 0);
     mState.setImageDesc(getTarget(), 0, sourceDesc);
+    signalDirtyImages();
 
     return NoError();
 }
@@ -1066,7 +1081,7 @@ Error Texture::setStorage(const Context *context,
     mDirtyBits.set(DIRTY_BIT_BASE_LEVEL);
     mDirtyBits.set(DIRTY_BIT_MAX_LEVEL);
 
-    mDirtyChannel.signal();
+    signalDirtyImages();
 
     return NoError();
 }
@@ -1093,7 +1108,7 @@ Error Texture::setStorageMultisample(const Context *context,
     mState.setImageDescChainMultisample(size, Format(internalFormat), samples,
                                         fixedSampleLocations);
 
-    mDirtyChannel.signal();
+    signalDirtyImages();
 
     return NoError();
 }
@@ -1123,7 +1138,7 @@ Error Texture::generateMipmap(const Context *context)
         mState.setImageDescChain(baseLevel, maxLevel, baseImageInfo.size, baseImageInfo.format);
     }
 
-    mDirtyChannel.signal();
+    signalDirtyImages();
 
     return NoError();
 }
@@ -1145,7 +1160,7 @@ void Texture::bindTexImageFromSurface(egl::Surface *surface)
     Extents size(surface->getWidth(), surface->getHeight(), 1);
     ImageDesc desc(size, Format(surface->getConfig()->renderTargetFormat));
     mState.setImageDesc(mState.mTarget, 0, desc);
-    mDirtyChannel.signal();
+    signalDirtyImages();
 }
 
 void Texture::releaseTexImageFromSurface()
@@ -1157,7 +1172,7 @@ void Texture::releaseTexImageFromSurface()
     // Erase the image info for level 0
     ASSERT(mState.mTarget == GL_TEXTURE_2D);
     mState.clearImageDesc(mState.mTarget, 0);
-    mDirtyChannel.signal();
+    signalDirtyImages();
 }
 
 void Texture::bindStream(egl::Stream *stream)
@@ -1185,7 +1200,7 @@ void Texture::acquireImageFromStream(const egl::Stream::GLTextureDescription &de
 
     Extents size(desc.width, desc.height, 1);
     mState.setImageDesc(mState.mTarget, 0, ImageDesc(size, Format(desc.internalFormat)));
-    mDirtyChannel.signal();
+    signalDirtyImages();
 }
 
 void Texture::releaseImageFromStream()
@@ -1195,7 +1210,7 @@ void Texture::releaseImageFromStream()
 
     // Set to incomplete
     mState.clearImageDesc(mState.mTarget, 0);
-    mDirtyChannel.signal();
+    signalDirtyImages();
 }
 
 void Texture::releaseTexImageInternal()
@@ -1228,7 +1243,7 @@ Error Texture::setEGLImageTarget(GLenum target, egl::Image *imageTarget)
 
     mState.clearImageDescs();
     mState.setImageDesc(target, 0, ImageDesc(size, imageTarget->getFormat()));
-    mDirtyChannel.signal();
+    signalDirtyImages();
 
     return NoError();
 }
@@ -356,6 +356,10 @@ class Texture final : public egl::ImageSibling,
 
     void invalidateCompletenessCache();
 
+    // Signaled when the sampler completeness of the texture may have changed, because its images
+    // or one of the parameters completeness depends on changed.
+    angle::BroadcastChannel *getCompletenessChannel() { return &mCompletenessChannel; }
+
     rx::TextureImpl *getImplementation() const { return mTexture; }
 
     // FramebufferAttachmentObject implementation
@@ -424,6 +428,12 @@ class Texture final : public egl::ImageSibling,
 
     void releaseTexImageInternal();
 
+    // Notifies the framebuffers the texture is attached to and the contexts sampling from it that
+    // its images changed.
+    void signalDirtyImages();
+
+    angle::BroadcastChannel mCompletenessChannel;
+
     egl::Surface *mBoundSurface;
     egl::Stream *mBoundStream;
 };
@@ -0,0 +1,296 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// TranslatedShaderCache.cpp: Implements the gl::TranslatedShaderCache class.
+
+#include "libANGLE/TranslatedShaderCache.h"
+
+#include <string.h>
+
+#include "angle_gl.h"
+#include "common/debug.h"
+#include "libANGLE/BinaryStream.h"
+
+namespace gl
+{
+
+namespace
+{
+
+void WriteShaderVariable(BinaryOutputStream *stream, const sh::ShaderVariable &var)
+{
+    stream->writeInt(var.type);
+    stream->writeInt(var.precision);
+    stream->writeString(var.name);
+    stream->writeString(var.mappedName);
+    stream->writeInt(var.arraySize);
+    stream->writeInt(var.staticUse);
+    stream->writeString(var.structName);
+
+    stream->writeInt(var.fields.size());
+    for (const sh::ShaderVariable &field : var.fields)
+    {
+        WriteShaderVariable(stream, field);
+    }
+}
+
+void LoadShaderVariable(BinaryInputStream *stream, sh::ShaderVariable *var)
+{
+    var->type       = stream->readInt<GLenum>();
+    var->precision  = stream->readInt<GLenum>();
+    var->name       = stream->readString();
+    var->mappedName = stream->readString();
+    var->arraySize  = stream->readInt<unsigned int>();
+    var->staticUse  = stream->readBool();
+    var->structName = stream->readString();
+
+    size_t fieldCount = stream->readInt<size_t>();
+    for (size_t fieldIndex = 0; fieldIndex < fieldCount && !stream->error(); ++fieldIndex)
+    {
+        var->fields.emplace_back();
+        LoadShaderVariable(stream, &var->fields.back());
+    }
+}
+
+void WriteVariable(BinaryOutputStream *stream, const sh::Varying &varying)
+{
+    WriteShaderVariable(stream, varying);
+    stream->writeInt(static_cast<int>(varying.interpolation));
+    stream->writeInt(varying.isInvariant);
+}
+
+void LoadVariable(BinaryInputStream *stream, sh::Varying *varying)
+{
+    LoadShaderVariable(stream, varying);
+    varying->interpolation = stream->readInt<sh::InterpolationType>();
+    varying->isInvariant   = stream->readBool();
+}
+
+void WriteVariable(BinaryOutputStream *stream, const sh::Uniform &uniform)
+{
+    WriteShaderVariable(stream, uniform);
+    stream->writeInt(uniform.location);
+    stream->writeInt(uniform.binding);
+}
+
+void LoadVariable(BinaryInputStream *stream, sh::Uniform *uniform)
+{
+    LoadShaderVariable(stream, uniform);
+    uniform->location = stream->readInt<int>();
+    uniform->binding  = stream->readInt<int>();
+}
+
+void WriteVariable(BinaryOutputStream *stream, const sh::VariableWithLocation &var)
+{
+    WriteShaderVariable(stream, var);
+    stream->writeInt(var.location);
+}
+
+void LoadVariable(BinaryInputStream *stream, sh::VariableWithLocation *var)
+{
+    LoadShaderVariable(stream, var);
+    var->location = stream->readInt<int>();
+}
+
+void WriteVariable(BinaryOutputStream *stream, const sh::InterfaceBlockField &field)
+{
+    WriteShaderVariable(stream, field);
+    stream->writeInt(field.isRowMajorLayout);
+}
+
+void LoadVariable(BinaryInputStream *stream, sh::InterfaceBlockField *field)
+{
+    LoadShaderVariable(stream, field);
+    field->isRowMajorLayout = stream->readBool();
+}
+
+// Interface blocks contain fields, declared ahead of the templates that write both.
+void WriteVariable(BinaryOutputStream *stream, const sh::InterfaceBlock &block);
+void LoadVariable(BinaryInputStream *stream, sh::InterfaceBlock *block);
+
+template <typename VarT>
+void WriteVariables(BinaryOutputStream *stream, const std::vector<VarT> &variables)
+{
+    stream->writeInt(variables.size());
+    for (const VarT &var : variables)
+    {
+        WriteVariable(stream, var);
+    }
+}
+
+template <typename VarT>
+void LoadVariables(BinaryInputStream *stream, std::vector<VarT> *variables)
+{
+    size_t count = stream->readInt<size_t>();
+    for (size_t index = 0; index < count && !stream->error(); ++index)
+    {
+        variables->emplace_back();
+        LoadVariable(stream, &variables->back());
+    }
+}
+
+void WriteVariable(BinaryOutputStream *stream, const sh::InterfaceBlock &block)
+{
+    stream->writeString(block.name);
+    stream->writeString(block.mappedName);
+    stream->writeString(block.instanceName);
+    stream->writeInt(block.arraySize);
+    stream->writeInt(static_cast<int>(block.layout));
+    stream->writeInt(block.isRowMajorLayout);
+    stream->writeInt(block.staticUse);
+    WriteVariables(stream, block.fields);
+}
+
+void LoadVariable(BinaryInputStream *stream, sh::InterfaceBlock *block)
+{
+    block->name             = stream->readString();
+    block->mappedName       = stream->readString();
+    block->instanceName     = stream->readString();
+    block->arraySize        = stream->readInt<unsigned int>();
+    block->layout           = stream->readInt<sh::BlockLayoutType>();
+    block->isRowMajorLayout = stream->readBool();
+    block->staticUse        = stream->readBool();
+    LoadVariables(stream, &block->fields);
+}
+
+void WriteRegisters(BinaryOutputStream *stream,
+                    const std::map<std::string, unsigned int> &registers)
+{
+    stream->writeInt(registers.size());
+    for (const auto &nameAndRegister : registers)
+    {
+        stream->writeString(nameAndRegister.first);
+        stream->writeInt(nameAndRegister.second);
+    }
+}
+
+void LoadRegisters(BinaryInputStream *stream, std::map<std::string, unsigned int> *registers)
+{
+    size_t count = stream->readInt<size_t>();
+    for (size_t index = 0; index < count && !stream->error(); ++index)
+    {
+        std::string name = stream->readString();
+        (*registers)[name] = stream->readInt<unsigned int>();
+    }
+}
+
+void Serialize(const TranslatedShader &translatedShader, BinaryOutputStream *stream)
+{
+    stream->writeInt(kTranslatedShaderFormatVersion);
+    stream->writeInt(static_cast<int>(translatedShader.outputType));
+    stream->writeString(translatedShader.infoLog);
+    stream->writeString(translatedShader.objectCode);
+    stream->writeInt(translatedShader.shaderVersion);
+    for (size_t index = 0; index < translatedShader.localSize.size(); ++index)
+    {
+        stream->writeInt(translatedShader.localSize[index]);
+    }
+
+    WriteVariables(stream, translatedShader.varyings);
+    WriteVariables(stream, translatedShader.uniforms);
+    WriteVariables(stream, translatedShader.interfaceBlocks);
+    WriteVariables(stream, translatedShader.activeAttributes);
+    WriteVariables(stream, translatedShader.activeOutputVariables);
+
+    WriteRegisters(stream, translatedShader.uniformRegisters);
+    WriteRegisters(stream, translatedShader.interfaceBlockRegisters);
+}
+
+bool Deserialize(BinaryInputStream *stream, TranslatedShader *translatedShader)
+{
+    if (stream->readInt<uint32_t>() != kTranslatedShaderFormatVersion)
+    {
+        return false;
+    }
+
+    translatedShader->outputType    = stream->readInt<ShShaderOutput>();
+    translatedShader->infoLog       = stream->readString();
+    translatedShader->objectCode    = stream->readString();
+    translatedShader->shaderVersion = stream->readInt<int>();
+    for (size_t index = 0; index < translatedShader->localSize.size(); ++index)
+    {
+        translatedShader->localSize[index] = stream->readInt<int>();
+    }
+
+    LoadVariables(stream, &translatedShader->varyings);
+    LoadVariables(stream, &translatedShader->uniforms);
+    LoadVariables(stream, &translatedShader->interfaceBlocks);
+    LoadVariables(stream, &translatedShader->activeAttributes);
+    LoadVariables(stream, &translatedShader->activeOutputVariables);
+
+    LoadRegisters(stream, &translatedShader->uniformRegisters);
+    LoadRegisters(stream, &translatedShader->interfaceBlockRegisters);
+
+    return !stream->error() && stream->endOfStream();
+}
+
+}  // anonymous namespace
+
+TranslatedShader::TranslatedShader() : outputType(SH_ESSL_OUTPUT), shaderVersion(100)
+{
+    localSize.fill(-1);
+}
+
+TranslatedShader::~TranslatedShader()
+{
+}
+
+TranslatedShaderCache::TranslatedShaderCache(size_t maxCacheSizeBytes)
+    : mBinaryCache(maxCacheSizeBytes), mHitCount(0), mMissCount(0)
+{
+}
+
+TranslatedShaderCache::~TranslatedShaderCache()
+{
+}
+
+void TranslatedShaderCache::setDiskCacheDirectory(const std::string &directory)
+{
+    mBinaryCache.setDiskCacheDirectory(directory);
+}
+
+bool TranslatedShaderCache::get(const TranslatedShaderHash &shaderHash,
+                                TranslatedShader *translatedShaderOut)
+{
+    const angle::MemoryBuffer *binary = mBinaryCache.get(shaderHash);
+    if (binary)
+    {
+        BinaryInputStream stream(binary->data(), binary->size());
+        TranslatedShader translatedShader;
+        if (Deserialize(&stream, &translatedShader))
+        {
+            *translatedShaderOut = std::move(translatedShader);
+            mHitCount++;
+            return true;
+        }
+
+        // Drop entries written by an incompatible build, the next compile replaces them.
+        mBinaryCache.remove(shaderHash);
+    }
+
+    mMissCount++;
+    return false;
+}
+
+void TranslatedShaderCache::put(const TranslatedShaderHash &shaderHash,
+                                const TranslatedShader &translatedShader)
+{
+    BinaryOutputStream stream;
+    Serialize(translatedShader, &stream);
+
+    angle::MemoryBuffer binary;
+    if (binary.resize(stream.length()))
+    {
+        memcpy(binary.data(), stream.data(), stream.length());
+        mBinaryCache.put(shaderHash, std::move(binary));
+    }
+}
+
+void TranslatedShaderCache::clear()
+{
+    mBinaryCache.clear();
+}
+
+}  // namespace gl
@@ -0,0 +1,85 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// TranslatedShaderCache.h: Stores the results of successful shader translations, keyed by a hash
+// of the source and of everything else the translator reads, so that compiling the same shader
+// again skips the translator entirely.
+
+#ifndef LIBANGLE_TRANSLATEDSHADERCACHE_H_
+#define LIBANGLE_TRANSLATEDSHADERCACHE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "GLSLANG/ShaderLang.h"
+#include "libANGLE/ProgramCache.h"
+
+namespace gl
+{
+using TranslatedShaderHash = ProgramHash;
+
+// Bumped whenever the serialized layout of TranslatedShader changes. It is part of the hash, so
+// that translations written to disk by another layout are never looked up.
+constexpr uint32_t kTranslatedShaderFormatVersion = 2;
+
+// Everything the shader and its implementation read from the translator after a compile.
+struct TranslatedShader
+{
+    TranslatedShader();
+    ~TranslatedShader();
+
+    ShShaderOutput outputType;
+
+    // The warnings reported by the translator.
+    std::string infoLog;
+    std::string objectCode;
+    int shaderVersion;
+    sh::WorkGroupSize localSize;
+    std::vector<sh::Varying> varyings;
+    std::vector<sh::Uniform> uniforms;
+    std::vector<sh::InterfaceBlock> interfaceBlocks;
+    std::vector<sh::Attribute> activeAttributes;
+    std::vector<sh::OutputVariable> activeOutputVariables;
+
+    // Registers assigned by the HLSL translator, empty for other outputs.
+    std::map<std::string, unsigned int> uniformRegisters;
+    std::map<std::string, unsigned int> interfaceBlockRegisters;
+};
+
+class TranslatedShaderCache final : angle::NonCopyable
+{
+  public:
+    explicit TranslatedShaderCache(size_t maxCacheSizeBytes);
+    ~TranslatedShaderCache();
+
+    // Translations are also read from and written to this directory when it is non-empty. The
+    // directory must already exist.
+    void setDiskCacheDirectory(const std::string &directory);
+
+    bool get(const TranslatedShaderHash &shaderHash, TranslatedShader *translatedShaderOut);
+    void put(const TranslatedShaderHash &shaderHash, const TranslatedShader &translatedShader);
+
+    // Empties the in-memory tier. The disk tier is left untouched.
+    void clear();
+
+    size_t size() const { return mBinaryCache.size(); }
+    size_t entryCount() const { return mBinaryCache.entryCount(); }
+
+    size_t getHitCount() const { return mHitCount; }
+    size_t getMissCount() const { return mMissCount; }
+
+  private:
+    // Translations are kept serialized, which makes their size exact and lets the program cache
+    // provide both tiers.
+    ProgramCache mBinaryCache;
+
+    size_t mHitCount;
+    size_t mMissCount;
+};
+
+}  // namespace gl
+
+#endif  // LIBANGLE_TRANSLATEDSHADERCACHE_H_
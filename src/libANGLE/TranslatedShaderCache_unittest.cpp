@@ -0,0 +1,160 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// TranslatedShaderCache_unittest.cpp: Unit tests for the translated shader cache.
+
+#include <gtest/gtest.h>
+
+#include "angle_gl.h"
+#include "libANGLE/TranslatedShaderCache.h"
+
+namespace gl
+{
+
+namespace
+{
+
+TranslatedShaderHash MakeHash(uint8_t seed)
+{
+    TranslatedShaderHash hash;
+    hash.fill(seed);
+    return hash;
+}
+
+TranslatedShader MakeTranslatedShader(const std::string &objectCode)
+{
+    TranslatedShader translatedShader;
+    translatedShader.outputType    = SH_HLSL_4_1_OUTPUT;
+    translatedShader.objectCode    = objectCode;
+    translatedShader.shaderVersion = 300;
+    return translatedShader;
+}
+
+}  // anonymous namespace
+
+// Test that every result of a translation survives the cache.
+TEST(TranslatedShaderCacheTest, RoundTrip)
+{
+    TranslatedShader translatedShader = MakeTranslatedShader("void main() {}");
+    translatedShader.localSize.setLocalSize(4, 2, 1);
+
+    sh::Varying varying;
+    varying.type          = GL_FLOAT_VEC4;
+    varying.precision     = GL_MEDIUM_FLOAT;
+    varying.name          = "v";
+    varying.mappedName    = "_uv";
+    varying.arraySize     = 2;
+    varying.staticUse     = true;
+    varying.interpolation = sh::INTERPOLATION_FLAT;
+    varying.isInvariant   = true;
+    translatedShader.varyings.push_back(varying);
+
+    sh::ShaderVariable field(GL_FLOAT_MAT2, 3);
+    field.name       = "m";
+    field.mappedName = "_um";
+
+    sh::Uniform uniform;
+    uniform.type       = GL_STRUCT_ANGLEX;
+    uniform.name       = "s";
+    uniform.mappedName = "_us";
+    uniform.structName = "S";
+    uniform.location   = 5;
+    uniform.binding    = 2;
+    uniform.fields.push_back(field);
+    translatedShader.uniforms.push_back(uniform);
+
+    sh::InterfaceBlockField blockField;
+    blockField.type             = GL_FLOAT_VEC3;
+    blockField.name             = "f";
+    blockField.isRowMajorLayout = true;
+
+    sh::InterfaceBlock block;
+    block.name         = "B";
+    block.mappedName   = "_uB";
+    block.instanceName = "b";
+    block.arraySize    = 4;
+    block.layout       = sh::BLOCKLAYOUT_STANDARD;
+    block.staticUse    = true;
+    block.fields.push_back(blockField);
+    translatedShader.interfaceBlocks.push_back(block);
+
+    sh::Attribute attribute;
+    attribute.type     = GL_FLOAT_VEC2;
+    attribute.name     = "a";
+    attribute.location = 1;
+    translatedShader.activeAttributes.push_back(attribute);
+
+    sh::OutputVariable outputVariable;
+    outputVariable.type     = GL_FLOAT_VEC4;
+    outputVariable.name     = "o";
+    outputVariable.location = 3;
+    translatedShader.activeOutputVariables.push_back(outputVariable);
+
+    translatedShader.uniformRegisters["s"]        = 7;
+    translatedShader.interfaceBlockRegisters["B"] = 1;
+
+    TranslatedShaderCache cache(1024 * 1024);
+    cache.put(MakeHash(1), translatedShader);
+
+    TranslatedShader cached;
+    ASSERT_TRUE(cache.get(MakeHash(1), &cached));
+
+    EXPECT_EQ(translatedShader.outputType, cached.outputType);
+    EXPECT_EQ(translatedShader.objectCode, cached.objectCode);
+    EXPECT_EQ(translatedShader.shaderVersion, cached.shaderVersion);
+    for (size_t index = 0; index < translatedShader.localSize.size(); ++index)
+    {
+        EXPECT_EQ(translatedShader.localSize[index], cached.localSize[index]);
+    }
+    EXPECT_EQ(translatedShader.varyings, cached.varyings);
+    EXPECT_EQ(translatedShader.uniforms, cached.uniforms);
+    EXPECT_EQ(translatedShader.activeAttributes, cached.activeAttributes);
+    EXPECT_EQ(translatedShader.activeOutputVariables, cached.activeOutputVariables);
+    EXPECT_EQ(translatedShader.uniformRegisters, cached.uniformRegisters);
+    EXPECT_EQ(translatedShader.interfaceBlockRegisters, cached.interfaceBlockRegisters);
+
+    ASSERT_EQ(1u, cached.interfaceBlocks.size());
+    const sh::InterfaceBlock &cachedBlock = cached.interfaceBlocks[0];
+    EXPECT_EQ(block.name, cachedBlock.name);
+    EXPECT_EQ(block.mappedName, cachedBlock.mappedName);
+    EXPECT_EQ(block.instanceName, cachedBlock.instanceName);
+    EXPECT_EQ(block.arraySize, cachedBlock.arraySize);
+    EXPECT_EQ(block.layout, cachedBlock.layout);
+    EXPECT_EQ(block.isRowMajorLayout, cachedBlock.isRowMajorLayout);
+    EXPECT_EQ(block.staticUse, cachedBlock.staticUse);
+    EXPECT_EQ(block.fields, cachedBlock.fields);
+}
+
+// Test that the cache counts hits and misses, and stays within its size.
+TEST(TranslatedShaderCacheTest, CountersAndSize)
+{
+    // Room for two of the translations below, but not three.
+    constexpr size_t kObjectCodeSize = 1000;
+    TranslatedShaderCache cache(kObjectCodeSize * 5 / 2);
+
+    TranslatedShader translatedShader;
+    EXPECT_FALSE(cache.get(MakeHash(1), &translatedShader));
+    EXPECT_EQ(1u, cache.getMissCount());
+
+    for (uint8_t seed = 1; seed <= 3; ++seed)
+    {
+        cache.put(MakeHash(seed), MakeTranslatedShader(std::string(kObjectCodeSize, 'a' + seed)));
+    }
+    EXPECT_EQ(2u, cache.entryCount());
+    EXPECT_GE(kObjectCodeSize * 5 / 2, cache.size());
+
+    // The least recently used translation was dropped.
+    EXPECT_FALSE(cache.get(MakeHash(1), &translatedShader));
+    ASSERT_TRUE(cache.get(MakeHash(3), &translatedShader));
+    EXPECT_EQ(std::string(kObjectCodeSize, 'd'), translatedShader.objectCode);
+    EXPECT_EQ(1u, cache.getHitCount());
+    EXPECT_EQ(2u, cache.getMissCount());
+
+    cache.clear();
+    EXPECT_EQ(0u, cache.entryCount());
+    EXPECT_FALSE(cache.get(MakeHash(3), &translatedShader));
+}
+
+}  // namespace gl
@@ -8,13 +8,11 @@
 
 #include "common/utilities.h"
 
-#include <cstring>
-
 namespace gl
 {
 
 LinkedUniform::LinkedUniform()
-    : blockIndex(-1), blockInfo(sh::BlockMemberInfo::getDefaultBlockInfo())
+    : blockIndex(-1), blockInfo(sh::BlockMemberInfo::getDefaultBlockInfo()), dataOffset(0)
 {
 }
 
@@ -26,7 +24,7 @@ LinkedUniform::LinkedUniform(GLenum typeIn,
                              const int locationIn,
                              const int blockIndexIn,
                              const sh::BlockMemberInfo &blockInfoIn)
-    : blockIndex(blockIndexIn), blockInfo(blockInfoIn)
+    : blockIndex(blockIndexIn), blockInfo(blockInfoIn), dataOffset(0)
 {
     type      = typeIn;
     precision = precisionIn;
@@ -37,25 +35,27 @@ LinkedUniform::LinkedUniform(GLenum typeIn,
 }
 
 LinkedUniform::LinkedUniform(const sh::Uniform &uniform)
-    : sh::Uniform(uniform), blockIndex(-1), blockInfo(sh::BlockMemberInfo::getDefaultBlockInfo())
+    : sh::Uniform(uniform),
+      blockIndex(-1),
+      blockInfo(sh::BlockMemberInfo::getDefaultBlockInfo()),
+      dataOffset(0)
 {
 }
 
 LinkedUniform::LinkedUniform(const LinkedUniform &uniform)
-    : sh::Uniform(uniform), blockIndex(uniform.blockIndex), blockInfo(uniform.blockInfo)
+    : sh::Uniform(uniform),
+      blockIndex(uniform.blockIndex),
+      blockInfo(uniform.blockInfo),
+      dataOffset(uniform.dataOffset)
 {
-    // This function is not intended to be called during runtime.
-    ASSERT(uniform.mLazyData.empty());
 }
 
 LinkedUniform &LinkedUniform::operator=(const LinkedUniform &uniform)
 {
-    // This function is not intended to be called during runtime.
-    ASSERT(uniform.mLazyData.empty());
-
     sh::Uniform::operator=(uniform);
     blockIndex           = uniform.blockIndex;
     blockInfo            = uniform.blockInfo;
+    dataOffset           = uniform.dataOffset;
 
     return *this;
 }
@@ -69,35 +69,6 @@ bool LinkedUniform::isInDefaultBlock() const
     return blockIndex == -1;
 }
 
-size_t LinkedUniform::dataSize() const
-{
-    ASSERT(type != GL_STRUCT_ANGLEX);
-    if (mLazyData.empty())
-    {
-        mLazyData.resize(VariableExternalSize(type) * elementCount());
-        ASSERT(!mLazyData.empty());
-    }
-
-    return mLazyData.size();
-}
-
-uint8_t *LinkedUniform::data()
-{
-    if (mLazyData.empty())
-    {
-        // dataSize() will init the data store.
-        size_t size = dataSize();
-        memset(mLazyData.data(), 0, size);
-    }
-
-    return mLazyData.data();
-}
-
-const uint8_t *LinkedUniform::data() const
-{
-    return const_cast<LinkedUniform *>(this)->data();
-}
-
 bool LinkedUniform::isSampler() const
 {
     return IsSamplerType(type);
@@ -123,15 +94,10 @@ size_t LinkedUniform::getElementComponents() const
     return VariableComponentCount(type);
 }
 
-uint8_t *LinkedUniform::getDataPtrToElement(size_t elementIndex)
-{
-    ASSERT((!isArray() && elementIndex == 0) || (isArray() && elementIndex < arraySize));
-    return data() + (elementIndex > 0 ? (getElementSize() * elementIndex) : 0u);
-}
-
-const uint8_t *LinkedUniform::getDataPtrToElement(size_t elementIndex) const
+size_t LinkedUniform::dataSize() const
 {
-    return const_cast<LinkedUniform *>(this)->getDataPtrToElement(elementIndex);
+    ASSERT(type != GL_STRUCT_ANGLEX);
+    return getElementSize() * elementCount();
 }
 
 UniformBlock::UniformBlock()
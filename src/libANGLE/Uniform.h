@@ -12,7 +12,6 @@
 
 #include "angle_gl.h"
 #include "common/debug.h"
-#include "common/MemoryBuffer.h"
 #include "compiler/translator/blocklayout.h"
 #include "libANGLE/angletypes.h"
 
@@ -36,23 +35,19 @@ struct LinkedUniform : public sh::Uniform
     LinkedUniform &operator=(const LinkedUniform &uniform);
     ~LinkedUniform();
 
-    size_t dataSize() const;
-    uint8_t *data();
-    const uint8_t *data() const;
     bool isSampler() const;
     bool isImage() const;
     bool isInDefaultBlock() const;
     bool isField() const;
     size_t getElementSize() const;
     size_t getElementComponents() const;
-    uint8_t *getDataPtrToElement(size_t elementIndex);
-    const uint8_t *getDataPtrToElement(size_t elementIndex) const;
+    size_t dataSize() const;
 
     int blockIndex;
     sh::BlockMemberInfo blockInfo;
 
-  private:
-    mutable angle::MemoryBuffer mLazyData;
+    // Offset of the values of default block uniforms in ProgramState::getUniformData().
+    size_t dataOffset;
 };
 
 // Helper struct representing a single shader uniform block
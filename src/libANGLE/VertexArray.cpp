@@ -23,6 +23,7 @@ VertexArrayState::VertexArrayState(size_t maxAttribs, size_t maxAttribBindings)
     for (size_t i = 0; i < maxAttribs; i++)
     {
         mVertexAttributes.emplace_back(static_cast<GLuint>(i));
+        mClientMemoryAttribsMask.set(i);
     }
 }
 
@@ -43,6 +44,10 @@ VertexArray::VertexArray(rx::GLImplFactory *factory,
       mState(maxAttribs, maxAttribBindings),
       mVertexArray(factory->createVertexArray(mState))
 {
+    for (size_t bindingIndex = 0; bindingIndex < maxAttribBindings; ++bindingIndex)
+    {
+        mDirtyBufferBindings.emplace_back(this, static_cast<angle::SignalToken>(bindingIndex));
+    }
 }
 
 VertexArray::~VertexArray()
@@ -67,11 +72,14 @@ const std::string &VertexArray::getLabel() const
 
 void VertexArray::detachBuffer(GLuint bufferName)
 {
-    for (auto &binding : mState.mVertexBindings)
+    for (size_t bindingIndex = 0; bindingIndex < getMaxBindings(); ++bindingIndex)
     {
+        VertexBinding &binding = mState.mVertexBindings[bindingIndex];
         if (binding.buffer.id() == bufferName)
         {
             binding.buffer.set(nullptr);
+            mDirtyBufferBindings[bindingIndex].reset();
+            updateCachedBindingElementLimits(bindingIndex);
         }
     }
 
@@ -114,6 +122,10 @@ void VertexArray::bindVertexBuffer(size_t bindingIndex,
     binding->offset = offset;
     binding->stride = stride;
     mDirtyBits.set(DIRTY_BIT_BINDING_0_BUFFER + bindingIndex);
+
+    mDirtyBufferBindings[bindingIndex].bind(boundBuffer ? boundBuffer->getDirtyChannel()
+                                                        : nullptr);
+    updateCachedBindingElementLimits(bindingIndex);
 }
 
 void VertexArray::setVertexAttribBinding(size_t attribIndex, size_t bindingIndex)
@@ -122,6 +134,7 @@ void VertexArray::setVertexAttribBinding(size_t attribIndex, size_t bindingIndex
 
     mState.mVertexAttributes[attribIndex].bindingIndex = static_cast<GLuint>(bindingIndex);
     mDirtyBits.set(DIRTY_BIT_ATTRIB_0_BINDING + attribIndex);
+    updateCachedElementLimit(attribIndex);
 }
 
 void VertexArray::setVertexBindingDivisor(size_t bindingIndex, GLuint divisor)
@@ -149,6 +162,7 @@ void VertexArray::setVertexAttribFormat(size_t attribIndex,
     attrib->pureInteger    = pureInteger;
     attrib->relativeOffset = relativeOffset;
     mDirtyBits.set(DIRTY_BIT_ATTRIB_0_FORMAT + attribIndex);
+    updateCachedElementLimit(attribIndex);
 }
 
 void VertexArray::setVertexAttribDivisor(size_t index, GLuint divisor)
@@ -164,6 +178,7 @@ void VertexArray::enableAttribute(size_t attribIndex, bool enabledState)
     ASSERT(attribIndex < getMaxAttribs());
 
     mState.mVertexAttributes[attribIndex].enabled = enabledState;
+    mState.mEnabledAttributesMask.set(attribIndex, enabledState);
     mDirtyBits.set(DIRTY_BIT_ATTRIB_0_ENABLED + attribIndex);
 
     // Update state cache
@@ -223,4 +238,55 @@ void VertexArray::syncImplState(const Context *context)
     }
 }
 
+void VertexArray::signal(angle::SignalToken token)
+{
+    // The data store of the buffer bound to this binding was re-specified.
+    updateCachedBindingElementLimits(static_cast<size_t>(token));
+}
+
+void VertexArray::updateCachedElementLimit(size_t attribIndex)
+{
+    VertexAttribute &attrib      = mState.mVertexAttributes[attribIndex];
+    const VertexBinding &binding = mState.mVertexBindings[attrib.bindingIndex];
+    const Buffer *buffer         = binding.buffer.get();
+
+    mState.mClientMemoryAttribsMask.set(attribIndex, buffer == nullptr);
+    if (!buffer)
+    {
+        attrib.cachedElementLimit = 0;
+        return;
+    }
+
+    // The last element doesn't take a full stride, only the size of the attribute's type.
+    uint64_t bufferSize   = static_cast<uint64_t>(buffer->getSize());
+    uint64_t attribOffset = static_cast<uint64_t>(ComputeVertexAttributeOffset(attrib, binding));
+    uint64_t attribSize   = ComputeVertexAttributeTypeSize(attrib);
+    if (attribOffset > bufferSize || bufferSize - attribOffset < attribSize)
+    {
+        attrib.cachedElementLimit = -1;
+        return;
+    }
+
+    // A zero stride fetches the same element for every vertex.
+    uint64_t remainingSize = bufferSize - attribOffset - attribSize;
+    if (binding.stride == 0)
+    {
+        attrib.cachedElementLimit = std::numeric_limits<GLint64>::max();
+        return;
+    }
+
+    attrib.cachedElementLimit = static_cast<GLint64>(remainingSize / binding.stride);
+}
+
+void VertexArray::updateCachedBindingElementLimits(size_t bindingIndex)
+{
+    for (size_t attribIndex = 0; attribIndex < getMaxAttribs(); ++attribIndex)
+    {
+        if (mState.mVertexAttributes[attribIndex].bindingIndex == bindingIndex)
+        {
+            updateCachedElementLimit(attribIndex);
+        }
+    }
+}
+
 }  // namespace gl
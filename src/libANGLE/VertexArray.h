@@ -18,6 +18,7 @@
 #include "libANGLE/Debug.h"
 #include "libANGLE/State.h"
 #include "libANGLE/VertexAttribute.h"
+#include "libANGLE/signal_utils.h"
 
 #include <vector>
 
@@ -61,6 +62,8 @@ class VertexArrayState final : public angle::NonCopyable
     {
         return mVertexAttributes[attribIndex].bindingIndex;
     }
+    const AttributesMask &getEnabledAttributesMask() const { return mEnabledAttributesMask; }
+    const AttributesMask &getClientMemoryAttribsMask() const { return mClientMemoryAttribsMask; }
 
   private:
     friend class VertexArray;
@@ -69,9 +72,11 @@ class VertexArrayState final : public angle::NonCopyable
     BindingPointer<Buffer> mElementArrayBuffer;
     std::vector<VertexBinding> mVertexBindings;
     size_t mMaxEnabledAttribute;
+    AttributesMask mEnabledAttributesMask;
+    AttributesMask mClientMemoryAttribsMask;
 };
 
-class VertexArray final : public LabeledObject
+class VertexArray final : public LabeledObject, public angle::SignalReceiver
 {
   public:
     VertexArray(rx::GLImplFactory *factory, GLuint id, size_t maxAttribs, size_t maxAttribBindings);
@@ -135,6 +140,16 @@ class VertexArray final : public LabeledObject
 
     size_t getMaxEnabledAttribute() const { return mState.getMaxEnabledAttribute(); }
 
+    // Attributes that are enabled, and attributes whose binding has no buffer bound.
+    const AttributesMask &getEnabledAttributesMask() const
+    {
+        return mState.getEnabledAttributesMask();
+    }
+    const AttributesMask &getClientMemoryAttribsMask() const
+    {
+        return mState.getClientMemoryAttribsMask();
+    }
+
     enum DirtyBitType
     {
         DIRTY_BIT_ELEMENT_ARRAY_BUFFER,
@@ -175,13 +190,22 @@ class VertexArray final : public LabeledObject
     void syncImplState(const Context *context);
     bool hasAnyDirtyBit() const { return mDirtyBits.any(); }
 
+    // angle::SignalReceiver implementation
+    void signal(angle::SignalToken token) override;
+
   private:
+    void updateCachedElementLimit(size_t attribIndex);
+    void updateCachedBindingElementLimits(size_t bindingIndex);
+
     GLuint mId;
 
     VertexArrayState mState;
     DirtyBits mDirtyBits;
 
     rx::VertexArrayImpl *mVertexArray;
+
+    // One per vertex binding, signaled when the bound buffer's data store changes.
+    std::vector<angle::ChannelBinding> mDirtyBufferBindings;
 };
 
 }  // namespace gl
@@ -45,7 +45,8 @@ VertexAttribute::VertexAttribute(GLuint bindingIndex)
       pointer(nullptr),
       relativeOffset(0),
       vertexAttribArrayStride(0),
-      bindingIndex(bindingIndex)
+      bindingIndex(bindingIndex),
+      cachedElementLimit(0)
 {
 }
 
@@ -58,7 +59,8 @@ VertexAttribute::VertexAttribute(VertexAttribute &&attrib)
       pointer(attrib.pointer),
       relativeOffset(attrib.relativeOffset),
       vertexAttribArrayStride(attrib.vertexAttribArrayStride),
-      bindingIndex(attrib.bindingIndex)
+      bindingIndex(attrib.bindingIndex),
+      cachedElementLimit(attrib.cachedElementLimit)
 {
 }
 
@@ -75,6 +77,7 @@ VertexAttribute &VertexAttribute::operator=(VertexAttribute &&attrib)
         relativeOffset          = attrib.relativeOffset;
         vertexAttribArrayStride = attrib.vertexAttribArrayStride;
         bindingIndex            = attrib.bindingIndex;
+        cachedElementLimit      = attrib.cachedElementLimit;
     }
     return *this;
 }
@@ -51,6 +51,10 @@ struct VertexAttribute final : angle::NonCopyable
 
     GLuint vertexAttribArrayStride;  // ONLY for queries of VERTEX_ATTRIB_ARRAY_STRIDE
     GLuint bindingIndex;
+
+    // The largest vertex element that fits in the bound buffer, or -1 if none does. Kept up to
+    // date by VertexArray so draw validation doesn't need to recompute buffer ranges.
+    GLint64 cachedElementLimit;
 };
 
 bool operator==(const VertexAttribute &a, const VertexAttribute &b);
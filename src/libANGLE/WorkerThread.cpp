@@ -74,25 +74,75 @@ void SingleThreadedWaitableEvent::signalImpl()
 
 #if (ANGLE_STD_ASYNC_WORKERS == ANGLE_ENABLED)
 // AsyncWorkerPool implementation.
-AsyncWorkerPool::AsyncWorkerPool(size_t maxThreads) : WorkerThreadPoolBase(maxThreads)
+AsyncWorkerPool::AsyncWorkerPool(size_t maxThreads)
+    : WorkerThreadPoolBase(maxThreads), mIdleThreadCount(0), mTerminated(false)
 {
 }
 
 AsyncWorkerPool::~AsyncWorkerPool()
 {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mTerminated = true;
+    }
+    mCondition.notify_all();
+
+    // The threads run the tasks still queued before they exit.
+    for (std::thread &thread : mThreads)
+    {
+        thread.join();
+    }
 }
 
 AsyncWaitableEvent AsyncWorkerPool::postWorkerTaskImpl(Closure *task)
 {
-    auto future = std::async(std::launch::async, [task] { (*task)(); });
+    std::packaged_task<void()> packagedTask([task] { (*task)(); });
 
     AsyncWaitableEvent waitable(EventResetPolicy::Automatic, EventInitialState::NonSignaled);
 
-    waitable.setFuture(std::move(future));
+    waitable.setFuture(packagedTask.get_future());
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mTaskQueue.push_back(std::move(packagedTask));
+
+        if (mIdleThreadCount < mTaskQueue.size() && mThreads.size() < getMaxThreads())
+        {
+            mThreads.emplace_back(&AsyncWorkerPool::threadLoop, this);
+        }
+    }
+    mCondition.notify_one();
 
     return waitable;
 }
 
+void AsyncWorkerPool::threadLoop()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true)
+    {
+        if (mTaskQueue.empty())
+        {
+            if (mTerminated)
+            {
+                return;
+            }
+
+            mIdleThreadCount++;
+            mCondition.wait(lock);
+            mIdleThreadCount--;
+            continue;
+        }
+
+        std::packaged_task<void()> task = std::move(mTaskQueue.front());
+        mTaskQueue.pop_front();
+
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
+
 // AsyncWaitableEvent implementation.
 AsyncWaitableEvent::AsyncWaitableEvent()
     : AsyncWaitableEvent(EventResetPolicy::Automatic, EventInitialState::NonSignaled)
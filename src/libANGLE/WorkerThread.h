@@ -18,7 +18,11 @@
 #include "libANGLE/features.h"
 
 #if (ANGLE_STD_ASYNC_WORKERS == ANGLE_ENABLED)
+#include <condition_variable>
+#include <deque>
 #include <future>
+#include <mutex>
+#include <thread>
 #endif  // (ANGLE_STD_ASYNC_WORKERS == ANGLE_ENABLED)
 
 namespace angle
@@ -230,10 +234,16 @@ class WorkerThreadPoolBase : angle::NonCopyable
     // Returns an event to wait on for the task to finish.
     // If the pool fails to create the task, returns null.
     WaitableEventType postWorkerTask(Closure *task);
+
+    // The number of tasks worth splitting work into for the pool.
+    size_t getMaxThreads() const { return mMaxThreads; }
+
+  private:
+    size_t mMaxThreads;
 };
 
 template <typename Impl>
-WorkerThreadPoolBase<Impl>::WorkerThreadPoolBase(size_t maxThreads)
+WorkerThreadPoolBase<Impl>::WorkerThreadPoolBase(size_t maxThreads) : mMaxThreads(maxThreads)
 {
 }
 
@@ -259,6 +269,8 @@ class SingleThreadedWorkerPool : public WorkerThreadPoolBase<SingleThreadedWorke
 };
 
 #if (ANGLE_STD_ASYNC_WORKERS == ANGLE_ENABLED)
+// Starts threads as tasks are posted, up to the maximum, and keeps them until the pool is
+// destroyed. std::async may start a new thread for every task, which costs more than most tasks.
 class AsyncWorkerPool : public WorkerThreadPoolBase<AsyncWorkerPool>
 {
   public:
@@ -266,6 +278,16 @@ class AsyncWorkerPool : public WorkerThreadPoolBase<AsyncWorkerPool>
     ~AsyncWorkerPool();
 
     AsyncWaitableEvent postWorkerTaskImpl(Closure *task);
+
+  private:
+    void threadLoop();
+
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::deque<std::packaged_task<void()>> mTaskQueue;
+    std::vector<std::thread> mThreads;
+    size_t mIdleThreadCount;
+    bool mTerminated;
 };
 #endif  // (ANGLE_STD_ASYNC_WORKERS == ANGLE_ENABLED)
 
@@ -7,6 +7,7 @@
 //   Simple tests for the worker thread class.
 
 #include <array>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include "libANGLE/WorkerThread.h"
@@ -56,4 +57,33 @@ TYPED_TEST(WorkerPoolTest, SimpleTask)
     }
 }
 
+// Tests posting more tasks than the pool has threads, which queues them.
+TYPED_TEST(WorkerPoolTest, MoreTasksThanThreads)
+{
+    class TestTask : public Closure
+    {
+      public:
+        void operator()() override { fired = true; }
+
+        bool fired = false;
+    };
+
+    std::array<TestTask, 64> tasks;
+    std::vector<typename TypeParam::WaitableEventType> waitables;
+    for (TestTask &task : tasks)
+    {
+        waitables.push_back(this->workerPool.postWorkerTask(&task));
+    }
+
+    for (auto &waitable : waitables)
+    {
+        waitable.wait();
+    }
+
+    for (const auto &task : tasks)
+    {
+        EXPECT_TRUE(task.fired);
+    }
+}
+
 }  // anonymous namespace
@@ -74,6 +74,11 @@ class ProgramImpl : angle::NonCopyable
     virtual void setUniformMatrix3x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) = 0;
     virtual void setUniformMatrix4x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) = 0;
 
+    // Called before drawing with the program, with the bytes of ProgramState::getUniformData()
+    // that changed since the last call. Implementations that keep their own copy of the uniforms
+    // up to date in setUniform* can ignore it.
+    virtual void syncUniforms(const gl::RangeUI &dirtyRange) = 0;
+
     // TODO: synchronize in syncState when dirty bits exist.
     virtual void setUniformBlockBinding(GLuint uniformBlockIndex, GLuint uniformBlockBinding) = 0;
 
@@ -24,8 +24,10 @@ class ShaderImpl : angle::NonCopyable
     // Returns additional sh::Compile options.
     virtual ShCompileOptions prepareSourceAndReturnOptions(std::stringstream *sourceStream,
                                                            std::string *sourcePath) = 0;
-    // Returns success for compiling on the driver. Returns success.
-    virtual bool postTranslateCompile(gl::Compiler *compiler, std::string *infoLog) = 0;
+    // Returns success for compiling on the driver. Called once the shader state holds the results
+    // in |translatedShader|, which may come from the translated shader cache.
+    virtual bool postTranslateCompile(const gl::TranslatedShader &translatedShader,
+                                      std::string *infoLog) = 0;
 
     virtual std::string getDebugInfo() const = 0;
 
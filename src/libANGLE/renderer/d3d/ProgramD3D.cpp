@@ -1854,6 +1854,12 @@ void ProgramD3D::setUniformMatrix4x3fv(GLint location,
     setUniformMatrixfv<4, 3>(location, count, transpose, value, GL_FLOAT_MAT4x3);
 }
 
+void ProgramD3D::syncUniforms(const gl::RangeUI &dirtyRange)
+{
+    // The D3D uniforms are updated in setUniform*, and uploaded per shader stage from their own
+    // dirty state.
+}
+
 void ProgramD3D::setUniform1iv(GLint location, GLsizei count, const GLint *v)
 {
     setUniform(location, count, v, GL_INT);
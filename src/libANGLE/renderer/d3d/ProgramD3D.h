@@ -247,6 +247,7 @@ class ProgramD3D : public ProgramImpl
                                GLsizei count,
                                GLboolean transpose,
                                const GLfloat *value);
+    void syncUniforms(const gl::RangeUI &dirtyRange) override;
 
     void setUniformBlockBinding(GLuint uniformBlockIndex, GLuint uniformBlockBinding) override;
 
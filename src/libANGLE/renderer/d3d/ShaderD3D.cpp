@@ -173,17 +173,11 @@ bool ShaderD3D::hasUniform(const D3DUniform *d3dUniform) const
     return mUniformRegisterMap.find(d3dUniform->name) != mUniformRegisterMap.end();
 }
 
-const std::map<std::string, unsigned int> &GetUniformRegisterMap(
-    const std::map<std::string, unsigned int> *uniformRegisterMap)
-{
-    ASSERT(uniformRegisterMap);
-    return *uniformRegisterMap;
-}
-
-bool ShaderD3D::postTranslateCompile(gl::Compiler *compiler, std::string *infoLog)
+bool ShaderD3D::postTranslateCompile(const gl::TranslatedShader &translatedShader,
+                                     std::string *infoLog)
 {
     // TODO(jmadill): We shouldn't need to cache this.
-    mCompilerOutputType = compiler->getShaderOutputType();
+    mCompilerOutputType = translatedShader.outputType;
 
     const std::string &translatedSource = mData.getTranslatedSource();
 
@@ -202,22 +196,8 @@ bool ShaderD3D::postTranslateCompile(gl::Compiler *compiler, std::string *infoLo
     mRequiresIEEEStrictCompiling =
         translatedSource.find("ANGLE_REQUIRES_IEEE_STRICT_COMPILING") != std::string::npos;
 
-    ShHandle compilerHandle = compiler->getCompilerHandle(mData.getShaderType());
-
-    mUniformRegisterMap = GetUniformRegisterMap(sh::GetUniformRegisterMap(compilerHandle));
-
-    for (const sh::InterfaceBlock &interfaceBlock : mData.getInterfaceBlocks())
-    {
-        if (interfaceBlock.staticUse)
-        {
-            unsigned int index = static_cast<unsigned int>(-1);
-            bool blockRegisterResult =
-                sh::GetInterfaceBlockRegister(compilerHandle, interfaceBlock.name, &index);
-            ASSERT(blockRegisterResult);
-
-            mInterfaceBlockRegisterMap[interfaceBlock.name] = index;
-        }
-    }
+    mUniformRegisterMap        = translatedShader.uniformRegisters;
+    mInterfaceBlockRegisterMap = translatedShader.interfaceBlockRegisters;
 
     mDebugInfo +=
         std::string("// ") + GetShaderTypeString(mData.getShaderType()) + " SHADER BEGIN\n";
@@ -65,9 +65,10 @@ gl::Error Image11::generateMipmap(Image11 *dest,
 
     auto mipGenerationFunction =
         d3d11::Format::Get(src->getInternalFormat(), rendererCaps).format().mipGenerationFunction;
-    mipGenerationFunction(src->getWidth(), src->getHeight(), src->getDepth(), sourceData,
-                          srcMapped.RowPitch, srcMapped.DepthPitch, destData, destMapped.RowPitch,
-                          destMapped.DepthPitch);
+    GenerateMipInTiles(dest->mRenderer->getWorkerThreadPool(), mipGenerationFunction,
+                       src->getWidth(), src->getHeight(), src->getDepth(), sourceData,
+                       srcMapped.RowPitch, srcMapped.DepthPitch, destData, destMapped.RowPitch,
+                       destMapped.DepthPitch);
 
     dest->unmap();
     src->unmap();
@@ -286,8 +287,7 @@ gl::Error Image11::loadCompressedData(const gl::Box &area, const void *input)
 
     const d3d11::Format &d3dFormatInfo =
         d3d11::Format::Get(mInternalFormat, mRenderer->getRenderer11DeviceCaps());
-    LoadImageFunction loadFunction =
-        d3dFormatInfo.getLoadFunctions()(GL_UNSIGNED_BYTE).loadFunction;
+    LoadImageFunctionInfo loadFunctionInfo = d3dFormatInfo.getLoadFunctions()(GL_UNSIGNED_BYTE);
 
     D3D11_MAPPED_SUBRESOURCE mappedImage;
     ANGLE_TRY(map(D3D11_MAP_WRITE, &mappedImage));
@@ -297,9 +297,24 @@ gl::Error Image11::loadCompressedData(const gl::Box &area, const void *input)
         ((area.y / outputBlockHeight) * mappedImage.RowPitch +
          (area.x / outputBlockWidth) * outputPixelSize + area.z * mappedImage.DepthPitch);
 
-    loadFunction(area.width, area.height, area.depth, reinterpret_cast<const uint8_t *>(input),
-                 inputRowPitch, inputDepthPitch, offsetMappedData, mappedImage.RowPitch,
-                 mappedImage.DepthPitch);
+    if (loadFunctionInfo.requiresConversion)
+    {
+        // Formats the device doesn't support, like ETC, are decoded or transcoded on the CPU,
+        // which takes long enough on large images to split between the worker threads.
+        LoadCompressedImageInTiles(mRenderer->getWorkerThreadPool(), loadFunctionInfo.loadFunction,
+                                   area.width, area.height, area.depth,
+                                   formatInfo.compressedBlockHeight,
+                                   reinterpret_cast<const uint8_t *>(input), inputRowPitch,
+                                   inputDepthPitch, outputBlockHeight, offsetMappedData,
+                                   mappedImage.RowPitch, mappedImage.DepthPitch);
+    }
+    else
+    {
+        loadFunctionInfo.loadFunction(area.width, area.height, area.depth,
+                                      reinterpret_cast<const uint8_t *>(input), inputRowPitch,
+                                      inputDepthPitch, offsetMappedData, mappedImage.RowPitch,
+                                      mappedImage.DepthPitch);
+    }
 
     unmap();
 
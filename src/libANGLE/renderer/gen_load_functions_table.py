@@ -89,6 +89,18 @@ LoadFunctionMap GetLoadFunctionsMap(GLenum {internal_format}, Format::ID {angle_
 
 }}  // GetLoadFunctionsMap
 
+Format::ID GetLoadFormatID(GLenum {internal_format})
+{{
+    // clang-format off
+    switch ({internal_format})
+    {{
+{format_id_data}
+        default:
+            return Format::ID::NONE;
+    }}
+    // clang-format on
+}}  // GetLoadFormatID
+
 }}  // namespace angle
 """
 
@@ -177,13 +189,33 @@ def parse_json(json_data):
 
     return table_data, load_functions_data
 
+# The format an internal format is loaded to when the back-end is free to pick any: the first one
+# with load functions, or the format the internal format maps to when its load functions keep the
+# data as it is.
+def parse_format_ids(json_data, gl_to_angle):
+    format_id_data = ''
+    for internal_format, angle_to_type_map in sorted(json_data.iteritems()):
+        angle_formats = sorted([angle_format for angle_format in angle_to_type_map.keys()
+                                if angle_format != angle_format_unknown])
+        if len(angle_formats) > 0:
+            angle_format = angle_formats[0]
+        else:
+            angle_format = gl_to_angle.get(internal_format, angle_format_unknown)
+        if angle_format == angle_format_unknown:
+            continue
+        format_id_data += '        case ' + internal_format + ':\n'
+        format_id_data += '            return Format::ID::' + angle_format + ';\n'
+    return format_id_data
+
 json_data = angle_format.load_json('load_functions_data.json')
+format_id_data = parse_format_ids(json_data, angle_format.load_without_override())
 
 switch_data, load_functions_data = parse_json(json_data)
 output = template.format(internal_format = internal_format_param,
                          angle_format = angle_format_param,
                          switch_data = switch_data,
                          load_functions_data = load_functions_data,
+                         format_id_data = format_id_data,
                          copyright_year = date.today().year)
 
 with open('load_functions_table_autogen.cpp', 'wt') as out_file:
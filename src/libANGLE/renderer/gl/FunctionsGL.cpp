@@ -1046,6 +1046,17 @@ void FunctionsGL::initializeProcsDesktopGL()
     AssignGLExtensionEntryPoint(extensions, "GL_ARB_invalidate_subdata", loadProcAddress("glInvalidateFramebuffer"), &invalidateFramebuffer);
     AssignGLExtensionEntryPoint(extensions, "GL_ARB_invalidate_subdata", loadProcAddress("glInvalidateSubFramebuffer"), &invalidateSubFramebuffer);
 
+    // GL_ARB_buffer_storage
+    AssignGLExtensionEntryPoint(extensions, "GL_ARB_buffer_storage", loadProcAddress("glBufferStorage"), &bufferStorage);
+
+    // GL_ARB_multi_bind
+    AssignGLExtensionEntryPoint(extensions, "GL_ARB_multi_bind", loadProcAddress("glBindBuffersBase"), &bindBuffersBase);
+    AssignGLExtensionEntryPoint(extensions, "GL_ARB_multi_bind", loadProcAddress("glBindBuffersRange"), &bindBuffersRange);
+    AssignGLExtensionEntryPoint(extensions, "GL_ARB_multi_bind", loadProcAddress("glBindImageTextures"), &bindImageTextures);
+    AssignGLExtensionEntryPoint(extensions, "GL_ARB_multi_bind", loadProcAddress("glBindSamplers"), &bindSamplers);
+    AssignGLExtensionEntryPoint(extensions, "GL_ARB_multi_bind", loadProcAddress("glBindTextures"), &bindTextures);
+    AssignGLExtensionEntryPoint(extensions, "GL_ARB_multi_bind", loadProcAddress("glBindVertexBuffers"), &bindVertexBuffers);
+
     // 1.0
     if (isAtLeastGL(gl::Version(1, 0)))
     {
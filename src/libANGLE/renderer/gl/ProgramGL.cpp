@@ -207,282 +207,282 @@ GLboolean ProgramGL::validate(const gl::Caps & /*caps*/, gl::InfoLog * /*infoLog
     return true;
 }
 
+// The setUniform* overrides below have nothing to do. The values are kept in the program state,
+// and syncUniforms uploads the ranges that changed before the next draw.
 void ProgramGL::setUniform1fv(GLint location, GLsizei count, const GLfloat *v)
 {
-    if (mFunctions->programUniform1fv != nullptr)
-    {
-        mFunctions->programUniform1fv(mProgramID, uniLoc(location), count, v);
-    }
-    else
-    {
-        mStateManager->useProgram(mProgramID);
-        mFunctions->uniform1fv(uniLoc(location), count, v);
-    }
 }
 
 void ProgramGL::setUniform2fv(GLint location, GLsizei count, const GLfloat *v)
 {
-    if (mFunctions->programUniform2fv != nullptr)
-    {
-        mFunctions->programUniform2fv(mProgramID, uniLoc(location), count, v);
-    }
-    else
-    {
-        mStateManager->useProgram(mProgramID);
-        mFunctions->uniform2fv(uniLoc(location), count, v);
-    }
 }
 
 void ProgramGL::setUniform3fv(GLint location, GLsizei count, const GLfloat *v)
 {
-    if (mFunctions->programUniform3fv != nullptr)
-    {
-        mFunctions->programUniform3fv(mProgramID, uniLoc(location), count, v);
-    }
-    else
-    {
-        mStateManager->useProgram(mProgramID);
-        mFunctions->uniform3fv(uniLoc(location), count, v);
-    }
 }
 
 void ProgramGL::setUniform4fv(GLint location, GLsizei count, const GLfloat *v)
 {
-    if (mFunctions->programUniform4fv != nullptr)
-    {
-        mFunctions->programUniform4fv(mProgramID, uniLoc(location), count, v);
-    }
-    else
-    {
-        mStateManager->useProgram(mProgramID);
-        mFunctions->uniform4fv(uniLoc(location), count, v);
-    }
 }
 
 void ProgramGL::setUniform1iv(GLint location, GLsizei count, const GLint *v)
 {
-    if (mFunctions->programUniform1iv != nullptr)
-    {
-        mFunctions->programUniform1iv(mProgramID, uniLoc(location), count, v);
-    }
-    else
-    {
-        mStateManager->useProgram(mProgramID);
-        mFunctions->uniform1iv(uniLoc(location), count, v);
-    }
 }
 
 void ProgramGL::setUniform2iv(GLint location, GLsizei count, const GLint *v)
 {
-    if (mFunctions->programUniform2iv != nullptr)
-    {
-        mFunctions->programUniform2iv(mProgramID, uniLoc(location), count, v);
-    }
-    else
-    {
-        mStateManager->useProgram(mProgramID);
-        mFunctions->uniform2iv(uniLoc(location), count, v);
-    }
 }
 
 void ProgramGL::setUniform3iv(GLint location, GLsizei count, const GLint *v)
 {
-    if (mFunctions->programUniform3iv != nullptr)
-    {
-        mFunctions->programUniform3iv(mProgramID, uniLoc(location), count, v);
-    }
-    else
-    {
-        mStateManager->useProgram(mProgramID);
-        mFunctions->uniform3iv(uniLoc(location), count, v);
-    }
 }
 
 void ProgramGL::setUniform4iv(GLint location, GLsizei count, const GLint *v)
 {
-    if (mFunctions->programUniform4iv != nullptr)
-    {
-        mFunctions->programUniform4iv(mProgramID, uniLoc(location), count, v);
-    }
-    else
-    {
-        mStateManager->useProgram(mProgramID);
-        mFunctions->uniform4iv(uniLoc(location), count, v);
-    }
 }
 
 void ProgramGL::setUniform1uiv(GLint location, GLsizei count, const GLuint *v)
 {
-    if (mFunctions->programUniform1uiv != nullptr)
-    {
-        mFunctions->programUniform1uiv(mProgramID, uniLoc(location), count, v);
-    }
-    else
-    {
-        mStateManager->useProgram(mProgramID);
-        mFunctions->uniform1uiv(uniLoc(location), count, v);
-    }
 }
 
 void ProgramGL::setUniform2uiv(GLint location, GLsizei count, const GLuint *v)
 {
-    if (mFunctions->programUniform2uiv != nullptr)
-    {
-        mFunctions->programUniform2uiv(mProgramID, uniLoc(location), count, v);
-    }
-    else
-    {
-        mStateManager->useProgram(mProgramID);
-        mFunctions->uniform2uiv(uniLoc(location), count, v);
-    }
 }
 
 void ProgramGL::setUniform3uiv(GLint location, GLsizei count, const GLuint *v)
 {
-    if (mFunctions->programUniform3uiv != nullptr)
-    {
-        mFunctions->programUniform3uiv(mProgramID, uniLoc(location), count, v);
-    }
-    else
-    {
-        mStateManager->useProgram(mProgramID);
-        mFunctions->uniform3uiv(uniLoc(location), count, v);
-    }
 }
 
 void ProgramGL::setUniform4uiv(GLint location, GLsizei count, const GLuint *v)
 {
-    if (mFunctions->programUniform4uiv != nullptr)
-    {
-        mFunctions->programUniform4uiv(mProgramID, uniLoc(location), count, v);
-    }
-    else
-    {
-        mStateManager->useProgram(mProgramID);
-        mFunctions->uniform4uiv(uniLoc(location), count, v);
-    }
 }
 
-void ProgramGL::setUniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+void ProgramGL::setUniformMatrix2fv(GLint location,
+                                    GLsizei count,
+                                    GLboolean transpose,
+                                    const GLfloat *value)
 {
-    if (mFunctions->programUniformMatrix2fv != nullptr)
-    {
-        mFunctions->programUniformMatrix2fv(mProgramID, uniLoc(location), count, transpose, value);
-    }
-    else
-    {
-        mStateManager->useProgram(mProgramID);
-        mFunctions->uniformMatrix2fv(uniLoc(location), count, transpose, value);
-    }
 }
 
-void ProgramGL::setUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+void ProgramGL::setUniformMatrix3fv(GLint location,
+                                    GLsizei count,
+                                    GLboolean transpose,
+                                    const GLfloat *value)
 {
-    if (mFunctions->programUniformMatrix3fv != nullptr)
-    {
-        mFunctions->programUniformMatrix3fv(mProgramID, uniLoc(location), count, transpose, value);
-    }
-    else
-    {
-        mStateManager->useProgram(mProgramID);
-        mFunctions->uniformMatrix3fv(uniLoc(location), count, transpose, value);
-    }
 }
 
-void ProgramGL::setUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+void ProgramGL::setUniformMatrix4fv(GLint location,
+                                    GLsizei count,
+                                    GLboolean transpose,
+                                    const GLfloat *value)
 {
-    if (mFunctions->programUniformMatrix4fv != nullptr)
-    {
-        mFunctions->programUniformMatrix4fv(mProgramID, uniLoc(location), count, transpose, value);
-    }
-    else
-    {
-        mStateManager->useProgram(mProgramID);
-        mFunctions->uniformMatrix4fv(uniLoc(location), count, transpose, value);
-    }
 }
 
-void ProgramGL::setUniformMatrix2x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+void ProgramGL::setUniformMatrix2x3fv(GLint location,
+                                      GLsizei count,
+                                      GLboolean transpose,
+                                      const GLfloat *value)
 {
-    if (mFunctions->programUniformMatrix2x3fv != nullptr)
-    {
-        mFunctions->programUniformMatrix2x3fv(mProgramID, uniLoc(location), count, transpose,
-                                              value);
-    }
-    else
-    {
-        mStateManager->useProgram(mProgramID);
-        mFunctions->uniformMatrix2x3fv(uniLoc(location), count, transpose, value);
-    }
 }
 
-void ProgramGL::setUniformMatrix3x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+void ProgramGL::setUniformMatrix3x2fv(GLint location,
+                                      GLsizei count,
+                                      GLboolean transpose,
+                                      const GLfloat *value)
 {
-    if (mFunctions->programUniformMatrix3x2fv != nullptr)
-    {
-        mFunctions->programUniformMatrix3x2fv(mProgramID, uniLoc(location), count, transpose,
-                                              value);
-    }
-    else
-    {
-        mStateManager->useProgram(mProgramID);
-        mFunctions->uniformMatrix3x2fv(uniLoc(location), count, transpose, value);
-    }
 }
 
-void ProgramGL::setUniformMatrix2x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+void ProgramGL::setUniformMatrix2x4fv(GLint location,
+                                      GLsizei count,
+                                      GLboolean transpose,
+                                      const GLfloat *value)
 {
-    if (mFunctions->programUniformMatrix2x4fv != nullptr)
-    {
-        mFunctions->programUniformMatrix2x4fv(mProgramID, uniLoc(location), count, transpose,
-                                              value);
-    }
-    else
-    {
-        mStateManager->useProgram(mProgramID);
-        mFunctions->uniformMatrix2x4fv(uniLoc(location), count, transpose, value);
-    }
 }
 
-void ProgramGL::setUniformMatrix4x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+void ProgramGL::setUniformMatrix4x2fv(GLint location,
+                                      GLsizei count,
+                                      GLboolean transpose,
+                                      const GLfloat *value)
 {
-    if (mFunctions->programUniformMatrix4x2fv != nullptr)
-    {
-        mFunctions->programUniformMatrix4x2fv(mProgramID, uniLoc(location), count, transpose,
-                                              value);
-    }
-    else
+}
+
+void ProgramGL::setUniformMatrix3x4fv(GLint location,
+                                      GLsizei count,
+                                      GLboolean transpose,
+                                      const GLfloat *value)
+{
+}
+
+void ProgramGL::setUniformMatrix4x3fv(GLint location,
+                                      GLsizei count,
+                                      GLboolean transpose,
+                                      const GLfloat *value)
+{
+}
+
+void ProgramGL::syncUniforms(const gl::RangeUI &dirtyRange)
+{
+    const uint8_t *uniformData = mState.getUniformData().data();
+    const auto &uniforms       = mState.getUniforms();
+    for (size_t uniformIndex = 0; uniformIndex < mUniformRealLocations.size(); ++uniformIndex)
     {
-        mStateManager->useProgram(mProgramID);
-        mFunctions->uniformMatrix4x2fv(uniLoc(location), count, transpose, value);
+        const gl::LinkedUniform &uniform = uniforms[uniformIndex];
+        if (!uniform.isInDefaultBlock())
+        {
+            continue;
+        }
+
+        size_t dataStart = uniform.dataOffset;
+        size_t dataEnd   = dataStart + uniform.dataSize();
+        if (dataEnd <= dirtyRange.start || dataStart >= dirtyRange.end)
+        {
+            continue;
+        }
+
+        // Upload from the first element, array element locations don't have to be sequential.
+        size_t elementSize = uniform.getElementSize();
+        size_t dirtyEnd    = std::min(dataEnd, static_cast<size_t>(dirtyRange.end));
+        size_t count       = (dirtyEnd - dataStart + elementSize - 1) / elementSize;
+        uploadUniform(uniform.type, mUniformRealLocations[uniformIndex],
+                      static_cast<GLsizei>(count), uniformData + dataStart);
     }
 }
 
-void ProgramGL::setUniformMatrix3x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+template <typename ProgramUniformT, typename UniformT, typename T>
+void ProgramGL::uploadUniformVector(ProgramUniformT FunctionsGL::*programUniform,
+                                    UniformT FunctionsGL::*uniform,
+                                    GLint location,
+                                    GLsizei count,
+                                    const T *v)
 {
-    if (mFunctions->programUniformMatrix3x4fv != nullptr)
+    if (mFunctions->*programUniform != nullptr)
     {
-        mFunctions->programUniformMatrix3x4fv(mProgramID, uniLoc(location), count, transpose,
-                                              value);
+        (mFunctions->*programUniform)(mProgramID, location, count, v);
     }
     else
     {
         mStateManager->useProgram(mProgramID);
-        mFunctions->uniformMatrix3x4fv(uniLoc(location), count, transpose, value);
+        (mFunctions->*uniform)(location, count, v);
     }
 }
 
-void ProgramGL::setUniformMatrix4x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+template <typename ProgramUniformT, typename UniformT>
+void ProgramGL::uploadUniformMatrix(ProgramUniformT FunctionsGL::*programUniform,
+                                    UniformT FunctionsGL::*uniform,
+                                    GLint location,
+                                    GLsizei count,
+                                    const GLfloat *v)
 {
-    if (mFunctions->programUniformMatrix4x3fv != nullptr)
+    // The uniform data is stored column-major.
+    if (mFunctions->*programUniform != nullptr)
     {
-        mFunctions->programUniformMatrix4x3fv(mProgramID, uniLoc(location), count, transpose,
-                                              value);
+        (mFunctions->*programUniform)(mProgramID, location, count, GL_FALSE, v);
     }
     else
     {
         mStateManager->useProgram(mProgramID);
-        mFunctions->uniformMatrix4x3fv(uniLoc(location), count, transpose, value);
+        (mFunctions->*uniform)(location, count, GL_FALSE, v);
+    }
+}
+
+void ProgramGL::uploadUniform(GLenum type, GLint location, GLsizei count, const uint8_t *data)
+{
+    const GLfloat *floatData = reinterpret_cast<const GLfloat *>(data);
+    const GLint *intData     = reinterpret_cast<const GLint *>(data);
+    const GLuint *uintData   = reinterpret_cast<const GLuint *>(data);
+
+    switch (type)
+    {
+        case GL_FLOAT:
+            uploadUniformVector(&FunctionsGL::programUniform1fv, &FunctionsGL::uniform1fv, location,
+                                count, floatData);
+            break;
+        case GL_FLOAT_VEC2:
+            uploadUniformVector(&FunctionsGL::programUniform2fv, &FunctionsGL::uniform2fv, location,
+                                count, floatData);
+            break;
+        case GL_FLOAT_VEC3:
+            uploadUniformVector(&FunctionsGL::programUniform3fv, &FunctionsGL::uniform3fv, location,
+                                count, floatData);
+            break;
+        case GL_FLOAT_VEC4:
+            uploadUniformVector(&FunctionsGL::programUniform4fv, &FunctionsGL::uniform4fv, location,
+                                count, floatData);
+            break;
+        case GL_INT_VEC2:
+        case GL_BOOL_VEC2:
+            uploadUniformVector(&FunctionsGL::programUniform2iv, &FunctionsGL::uniform2iv, location,
+                                count, intData);
+            break;
+        case GL_INT_VEC3:
+        case GL_BOOL_VEC3:
+            uploadUniformVector(&FunctionsGL::programUniform3iv, &FunctionsGL::uniform3iv, location,
+                                count, intData);
+            break;
+        case GL_INT_VEC4:
+        case GL_BOOL_VEC4:
+            uploadUniformVector(&FunctionsGL::programUniform4iv, &FunctionsGL::uniform4iv, location,
+                                count, intData);
+            break;
+        case GL_UNSIGNED_INT:
+            uploadUniformVector(&FunctionsGL::programUniform1uiv, &FunctionsGL::uniform1uiv,
+                                location, count, uintData);
+            break;
+        case GL_UNSIGNED_INT_VEC2:
+            uploadUniformVector(&FunctionsGL::programUniform2uiv, &FunctionsGL::uniform2uiv,
+                                location, count, uintData);
+            break;
+        case GL_UNSIGNED_INT_VEC3:
+            uploadUniformVector(&FunctionsGL::programUniform3uiv, &FunctionsGL::uniform3uiv,
+                                location, count, uintData);
+            break;
+        case GL_UNSIGNED_INT_VEC4:
+            uploadUniformVector(&FunctionsGL::programUniform4uiv, &FunctionsGL::uniform4uiv,
+                                location, count, uintData);
+            break;
+        case GL_FLOAT_MAT2:
+            uploadUniformMatrix(&FunctionsGL::programUniformMatrix2fv,
+                                &FunctionsGL::uniformMatrix2fv, location, count, floatData);
+            break;
+        case GL_FLOAT_MAT3:
+            uploadUniformMatrix(&FunctionsGL::programUniformMatrix3fv,
+                                &FunctionsGL::uniformMatrix3fv, location, count, floatData);
+            break;
+        case GL_FLOAT_MAT4:
+            uploadUniformMatrix(&FunctionsGL::programUniformMatrix4fv,
+                                &FunctionsGL::uniformMatrix4fv, location, count, floatData);
+            break;
+        case GL_FLOAT_MAT2x3:
+            uploadUniformMatrix(&FunctionsGL::programUniformMatrix2x3fv,
+                                &FunctionsGL::uniformMatrix2x3fv, location, count, floatData);
+            break;
+        case GL_FLOAT_MAT3x2:
+            uploadUniformMatrix(&FunctionsGL::programUniformMatrix3x2fv,
+                                &FunctionsGL::uniformMatrix3x2fv, location, count, floatData);
+            break;
+        case GL_FLOAT_MAT2x4:
+            uploadUniformMatrix(&FunctionsGL::programUniformMatrix2x4fv,
+                                &FunctionsGL::uniformMatrix2x4fv, location, count, floatData);
+            break;
+        case GL_FLOAT_MAT4x2:
+            uploadUniformMatrix(&FunctionsGL::programUniformMatrix4x2fv,
+                                &FunctionsGL::uniformMatrix4x2fv, location, count, floatData);
+            break;
+        case GL_FLOAT_MAT3x4:
+            uploadUniformMatrix(&FunctionsGL::programUniformMatrix3x4fv,
+                                &FunctionsGL::uniformMatrix3x4fv, location, count, floatData);
+            break;
+        case GL_FLOAT_MAT4x3:
+            uploadUniformMatrix(&FunctionsGL::programUniformMatrix4x3fv,
+                                &FunctionsGL::uniformMatrix4x3fv, location, count, floatData);
+            break;
+        default:
+            // GL_INT, GL_BOOL, samplers and images.
+            ASSERT(gl::VariableComponentType(type) == GL_INT ||
+                   gl::VariableComponentType(type) == GL_BOOL);
+            uploadUniformVector(&FunctionsGL::programUniform1iv, &FunctionsGL::uniform1iv, location,
+                                count, intData);
+            break;
     }
 }
 
@@ -581,7 +581,7 @@ void ProgramGL::setPathFragmentInputGen(const std::string &inputName,
 void ProgramGL::preLink()
 {
     // Reset the program state
-    mUniformRealLocationMap.clear();
+    mUniformRealLocations.clear();
     mUniformBlockRealLocationMap.clear();
     mPathRenderingFragmentInputs.clear();
 }
@@ -625,31 +625,23 @@ bool ProgramGL::checkLinkStatus(gl::InfoLog &infoLog)
 void ProgramGL::postLink()
 {
     // Query the uniform information
-    ASSERT(mUniformRealLocationMap.empty());
-    const auto &uniformLocations = mState.getUniformLocations();
+    ASSERT(mUniformRealLocations.empty());
     const auto &uniforms = mState.getUniforms();
-    mUniformRealLocationMap.resize(uniformLocations.size(), GL_INVALID_INDEX);
-    for (size_t uniformLocation = 0; uniformLocation < uniformLocations.size(); uniformLocation++)
+    mUniformRealLocations.resize(uniforms.size(), -1);
+    for (size_t uniformIndex = 0; uniformIndex < uniforms.size(); uniformIndex++)
     {
-        const auto &entry = uniformLocations[uniformLocation];
-        if (!entry.used)
+        const gl::LinkedUniform &uniform = uniforms[uniformIndex];
+        if (!uniform.isInDefaultBlock())
         {
             continue;
         }
 
         // From the spec:
         // "Locations for sequential array indices are not required to be sequential."
-        const gl::LinkedUniform &uniform = uniforms[entry.index];
-        std::stringstream fullNameStr;
-        fullNameStr << uniform.name;
-        if (uniform.isArray())
-        {
-            fullNameStr << "[" << entry.element << "]";
-        }
-        const std::string &fullName = fullNameStr.str();
-
-        GLint realLocation = mFunctions->getUniformLocation(mProgramID, fullName.c_str());
-        mUniformRealLocationMap[uniformLocation] = realLocation;
+        // Uniforms are always uploaded from their first element, so only that one is needed.
+        std::string fullName = uniform.name + (uniform.isArray() ? "[0]" : "");
+        mUniformRealLocations[uniformIndex] =
+            mFunctions->getUniformLocation(mProgramID, fullName.c_str());
     }
 
     // Discover CHROMIUM_path_rendering fragment inputs if enabled.
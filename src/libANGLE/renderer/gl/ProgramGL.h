@@ -64,6 +64,7 @@ class ProgramGL : public ProgramImpl
     void setUniformMatrix4x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) override;
     void setUniformMatrix3x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) override;
     void setUniformMatrix4x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) override;
+    void syncUniforms(const gl::RangeUI &dirtyRange) override;
 
     void setUniformBlockBinding(GLuint uniformBlockIndex, GLuint uniformBlockBinding) override;
 
@@ -83,14 +84,28 @@ class ProgramGL : public ProgramImpl
     bool checkLinkStatus(gl::InfoLog &infoLog);
     void postLink();
 
-    // Helper function, makes it simpler to type.
-    GLint uniLoc(GLint glLocation) const { return mUniformRealLocationMap[glLocation]; }
+    void uploadUniform(GLenum type, GLint location, GLsizei count, const uint8_t *data);
+    template <typename ProgramUniformT, typename UniformT, typename T>
+    void uploadUniformVector(ProgramUniformT FunctionsGL::*programUniform,
+                             UniformT FunctionsGL::*uniform,
+                             GLint location,
+                             GLsizei count,
+                             const T *v);
+    template <typename ProgramUniformT, typename UniformT>
+    void uploadUniformMatrix(ProgramUniformT FunctionsGL::*programUniform,
+                             UniformT FunctionsGL::*uniform,
+                             GLint location,
+                             GLsizei count,
+                             const GLfloat *v);
 
     const FunctionsGL *mFunctions;
     const WorkaroundsGL &mWorkarounds;
     StateManagerGL *mStateManager;
 
-    std::vector<GLint> mUniformRealLocationMap;
+    // The driver location of the first element of each uniform, indexed like
+    // ProgramState::getUniforms(). Uniform block members are added to the uniforms after the
+    // link, so they may not have an entry.
+    std::vector<GLint> mUniformRealLocations;
     std::vector<GLuint> mUniformBlockRealLocationMap;
 
     struct PathRenderingFragmentInput
@@ -10,6 +10,10 @@
 
 #include <EGL/eglext.h>
 
+#include <map>
+#include <mutex>
+#include <sstream>
+
 #include "common/debug.h"
 #include "libANGLE/AttributeMap.h"
 #include "libANGLE/ContextState.h"
@@ -52,6 +56,56 @@ std::vector<GLuint> GatherPaths(const std::vector<gl::Path *> &paths)
     return ret;
 }
 
+// The caps generated for a driver. They are shared by the renderers of every display using the
+// same driver, so that initializing displays again, after eglTerminate or for other native
+// displays, does not query the driver again.
+struct CapsSnapshot
+{
+    bool capsGenerated = false;
+    gl::Version maxSupportedESVersion;
+    gl::Caps caps;
+    gl::Extensions extensions;
+
+    bool textureCapsGenerated = false;
+    gl::TextureCapsMap textureCaps;
+};
+
+std::mutex &GetCapsSnapshotMutex()
+{
+    static std::mutex *mutex = new std::mutex();
+    return *mutex;
+}
+
+// Must be called with the mutex locked.
+CapsSnapshot *GetCapsSnapshot(const std::string &driverIdentity)
+{
+    static std::map<std::string, CapsSnapshot> *snapshots =
+        new std::map<std::string, CapsSnapshot>();
+    return &(*snapshots)[driverIdentity];
+}
+
+std::string GetGLString(const rx::FunctionsGL *functions, GLenum name)
+{
+    const GLubyte *value = functions->getString(name);
+    return value != nullptr ? reinterpret_cast<const char *>(value) : "";
+}
+
+// Everything the generated caps depend on, other than the values queried from the driver.
+std::string GetDriverIdentity(const rx::FunctionsGL *functions)
+{
+    std::ostringstream identity;
+    identity << functions->standard << " " << functions->version.major << "."
+             << functions->version.minor << " " << functions->profile << "\n"
+             << GetGLString(functions, GL_VENDOR) << "\n"
+             << GetGLString(functions, GL_RENDERER) << "\n"
+             << GetGLString(functions, GL_VERSION) << "\n";
+    for (const std::string &extension : functions->extensions)
+    {
+        identity << extension << " ";
+    }
+    return identity.str();
+}
+
 }  // namespace
 
 #ifndef NDEBUG
@@ -125,11 +179,16 @@ RendererGL::RendererGL(const FunctionsGL *functions, const egl::AttributeMap &at
       mBlitter(nullptr),
       mHasDebugOutput(false),
       mSkipDrawCalls(false),
-      mCapsInitialized(false)
+      mCapsInitialized(false),
+      mTextureCapsInitialized(false)
 {
     ASSERT(mFunctions);
     nativegl_gl::GenerateWorkarounds(mFunctions, &mWorkarounds);
-    mStateManager = new StateManagerGL(mFunctions, getNativeCaps());
+    mDriverIdentity = GetDriverIdentity(mFunctions);
+
+    // The texture caps are not needed until contexts are created.
+    ensureCapsInitialized();
+    mStateManager = new StateManagerGL(mFunctions, mNativeCaps);
     mBlitter = new BlitGL(functions, mWorkarounds, mStateManager);
 
     mHasDebugOutput = mFunctions->isAtLeastGL(gl::Version(4, 3)) ||
@@ -544,19 +603,11 @@ std::string RendererGL::getRendererDescription() const
 const gl::Version &RendererGL::getMaxSupportedESVersion() const
 {
     // Force generation of caps
-    getNativeCaps();
+    ensureCapsInitialized();
 
     return mMaxSupportedESVersion;
 }
 
-void RendererGL::generateCaps(gl::Caps *outCaps, gl::TextureCapsMap* outTextureCaps,
-                              gl::Extensions *outExtensions,
-                              gl::Limitations * /* outLimitations */) const
-{
-    nativegl_gl::GenerateCaps(mFunctions, mWorkarounds, outCaps, outTextureCaps, outExtensions,
-                              &mMaxSupportedESVersion);
-}
-
 GLint RendererGL::getGPUDisjoint()
 {
     // TODO(ewell): On GLES backends we should find a way to reliably query disjoint events
@@ -572,34 +623,71 @@ GLint64 RendererGL::getTimestamp()
 
 void RendererGL::ensureCapsInitialized() const
 {
-    if (!mCapsInitialized)
+    if (mCapsInitialized)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(GetCapsSnapshotMutex());
+    CapsSnapshot *snapshot = GetCapsSnapshot(mDriverIdentity);
+    if (!snapshot->capsGenerated)
     {
-        generateCaps(&mNativeCaps, &mNativeTextureCaps, &mNativeExtensions, &mNativeLimitations);
-        mCapsInitialized = true;
+        nativegl_gl::GenerateCaps(mFunctions, mWorkarounds, &snapshot->caps,
+                                  &snapshot->extensions, &snapshot->maxSupportedESVersion);
+        snapshot->capsGenerated = true;
     }
+
+    mMaxSupportedESVersion = snapshot->maxSupportedESVersion;
+    mNativeCaps            = snapshot->caps;
+    mNativeExtensions      = snapshot->extensions;
+    mCapsInitialized       = true;
 }
 
-const gl::Caps &RendererGL::getNativeCaps() const
+void RendererGL::ensureTextureCapsInitialized() const
 {
+    if (mTextureCapsInitialized)
+    {
+        return;
+    }
+
     ensureCapsInitialized();
+
+    std::lock_guard<std::mutex> lock(GetCapsSnapshotMutex());
+    CapsSnapshot *snapshot = GetCapsSnapshot(mDriverIdentity);
+    if (!snapshot->textureCapsGenerated)
+    {
+        nativegl_gl::GenerateTextureCaps(mFunctions, &snapshot->caps, &snapshot->textureCaps,
+                                         &snapshot->extensions);
+        snapshot->textureCapsGenerated = true;
+    }
+
+    mNativeCaps             = snapshot->caps;
+    mNativeTextureCaps      = snapshot->textureCaps;
+    mNativeExtensions       = snapshot->extensions;
+    mTextureCapsInitialized = true;
+}
+
+const gl::Caps &RendererGL::getNativeCaps() const
+{
+    ensureTextureCapsInitialized();
     return mNativeCaps;
 }
 
 const gl::TextureCapsMap &RendererGL::getNativeTextureCaps() const
 {
-    ensureCapsInitialized();
+    ensureTextureCapsInitialized();
     return mNativeTextureCaps;
 }
 
 const gl::Extensions &RendererGL::getNativeExtensions() const
 {
-    ensureCapsInitialized();
+    ensureTextureCapsInitialized();
     return mNativeExtensions;
 }
 
 const gl::Limitations &RendererGL::getNativeLimitations() const
 {
-    ensureCapsInitialized();
+    ensureTextureCapsInitialized();
     return mNativeLimitations;
 }
 
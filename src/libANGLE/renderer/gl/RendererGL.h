@@ -167,11 +167,10 @@ class RendererGL : angle::NonCopyable
     const gl::Limitations &getNativeLimitations() const;
 
   private:
+    // Initializing displays only needs the caps that do not depend on the texture formats, the
+    // others are generated when contexts are created.
     void ensureCapsInitialized() const;
-    void generateCaps(gl::Caps *outCaps,
-                      gl::TextureCapsMap *outTextureCaps,
-                      gl::Extensions *outExtensions,
-                      gl::Limitations *outLimitations) const;
+    void ensureTextureCapsInitialized() const;
 
     mutable gl::Version mMaxSupportedESVersion;
 
@@ -187,7 +186,11 @@ class RendererGL : angle::NonCopyable
     // For performance debugging
     bool mSkipDrawCalls;
 
+    // Identifies the driver, whose caps are generated once per process.
+    std::string mDriverIdentity;
+
     mutable bool mCapsInitialized;
+    mutable bool mTextureCapsInitialized;
     mutable gl::Caps mNativeCaps;
     mutable gl::TextureCapsMap mNativeTextureCaps;
     mutable gl::Extensions mNativeExtensions;
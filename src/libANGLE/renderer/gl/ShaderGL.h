@@ -27,7 +27,8 @@ class ShaderGL : public ShaderImpl
     // ShaderImpl implementation
     ShCompileOptions prepareSourceAndReturnOptions(std::stringstream *sourceStream,
                                                    std::string *sourcePath) override;
-    bool postTranslateCompile(gl::Compiler *compiler, std::string *infoLog) override;
+    bool postTranslateCompile(const gl::TranslatedShader &translatedShader,
+                              std::string *infoLog) override;
     std::string getDebugInfo() const override;
 
     GLuint getShaderID() const;
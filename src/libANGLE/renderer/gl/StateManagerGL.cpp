@@ -8,6 +8,7 @@
 
 #include "libANGLE/renderer/gl/StateManagerGL.h"
 
+#include <algorithm>
 #include <limits>
 #include <string.h>
 
@@ -28,6 +29,7 @@
 #include "libANGLE/renderer/gl/TransformFeedbackGL.h"
 #include "libANGLE/renderer/gl/VertexArrayGL.h"
 #include "libANGLE/renderer/gl/QueryGL.h"
+#include "third_party/trace_event/trace_event.h"
 
 namespace rx
 {
@@ -50,6 +52,8 @@ StateManagerGL::StateManagerGL(const FunctionsGL *functions, const gl::Caps &ren
       mTextureUnitIndex(0),
       mTextures(),
       mSamplers(rendererCaps.maxCombinedTextureImageUnits, 0),
+      mBindingCallCount(0),
+      mLastDrawBindingCallCount(0),
       mTransformFeedback(0),
       mQueries(),
       mPrevDrawTransformFeedback(nullptr),
@@ -360,6 +364,7 @@ void StateManagerGL::bindBufferBase(GLenum type, size_t index, GLuint buffer)
         binding.offset = static_cast<size_t>(-1);
         binding.size = static_cast<size_t>(-1);
         mFunctions->bindBufferBase(type, static_cast<GLuint>(index), buffer);
+        mBindingCallCount++;
     }
 }
 
@@ -376,6 +381,7 @@ void StateManagerGL::bindBufferRange(GLenum type,
         binding.offset = offset;
         binding.size = size;
         mFunctions->bindBufferRange(type, static_cast<GLuint>(index), buffer, offset, size);
+        mBindingCallCount++;
     }
 }
 
@@ -385,6 +391,7 @@ void StateManagerGL::activeTexture(size_t unit)
     {
         mTextureUnitIndex = unit;
         mFunctions->activeTexture(GL_TEXTURE0 + static_cast<GLenum>(mTextureUnitIndex));
+        mBindingCallCount++;
     }
 }
 
@@ -394,6 +401,7 @@ void StateManagerGL::bindTexture(GLenum type, GLuint texture)
     {
         mTextures[type][mTextureUnitIndex] = texture;
         mFunctions->bindTexture(type, texture);
+        mBindingCallCount++;
     }
 }
 
@@ -403,6 +411,7 @@ void StateManagerGL::bindSampler(size_t unit, GLuint sampler)
     {
         mSamplers[unit] = sampler;
         mFunctions->bindSampler(static_cast<GLuint>(unit), sampler);
+        mBindingCallCount++;
     }
 }
 
@@ -764,77 +773,251 @@ gl::Error StateManagerGL::onMakeCurrent(const gl::ContextState &data)
 
 void StateManagerGL::setGenericShaderState(const gl::ContextState &data)
 {
-    const gl::State &state = data.getState();
+    const gl::State &state        = data.getState();
+    const size_t bindingCallCount = mBindingCallCount;
 
     // Sync the current program state
     const gl::Program *program = state.getProgram();
     const ProgramGL *programGL = GetImplAs<ProgramGL>(program);
     useProgram(programGL->getProgramID());
 
+    syncUniformBufferBindings(state, program);
+    syncTextureBindings(state);
+
+    mLastDrawBindingCallCount = mBindingCallCount - bindingCallCount;
+    TRACE_COUNTER1("gpu.angle", "StateManagerGL::BindingCallsPerDraw", mLastDrawBindingCallCount);
+}
+
+void StateManagerGL::syncUniformBufferBindings(const gl::State &state, const gl::Program *program)
+{
+    const bool multiBind = mFunctions->bindBuffersBase != nullptr;
+    std::vector<IndexedBufferBinding> &appliedBindings = mIndexedBuffers[GL_UNIFORM_BUFFER];
+
+    mPendingUniformBuffers.clear();
     for (size_t uniformBlockIndex = 0; uniformBlockIndex < program->getActiveUniformBlockCount();
          uniformBlockIndex++)
     {
         GLuint binding = program->getUniformBlockBinding(static_cast<GLuint>(uniformBlockIndex));
         const auto &uniformBuffer = state.getIndexedUniformBuffer(binding);
+        if (uniformBuffer.get() == nullptr)
+        {
+            continue;
+        }
 
-        if (uniformBuffer.get() != nullptr)
+        GLuint bufferID = GetImplAs<BufferGL>(uniformBuffer.get())->getBufferID();
+        size_t offset   = static_cast<size_t>(-1);
+        size_t size     = static_cast<size_t>(-1);
+        if (uniformBuffer.getSize() != 0)
         {
-            BufferGL *bufferGL = GetImplAs<BufferGL>(uniformBuffer.get());
+            offset = uniformBuffer.getOffset();
+            size   = uniformBuffer.getSize();
+        }
 
-            if (uniformBuffer.getSize() == 0)
+        if (!multiBind)
+        {
+            if (size == static_cast<size_t>(-1))
             {
-                bindBufferBase(GL_UNIFORM_BUFFER, binding, bufferGL->getBufferID());
+                bindBufferBase(GL_UNIFORM_BUFFER, binding, bufferID);
             }
             else
             {
-                bindBufferRange(GL_UNIFORM_BUFFER, binding, bufferGL->getBufferID(),
-                                uniformBuffer.getOffset(), uniformBuffer.getSize());
+                bindBufferRange(GL_UNIFORM_BUFFER, binding, bufferID, offset, size);
             }
+            continue;
+        }
+
+        const IndexedBufferBinding &applied = appliedBindings[binding];
+        if (applied.buffer != bufferID || applied.offset != offset || applied.size != size)
+        {
+            mPendingUniformBuffers.push_back({binding, GL_UNIFORM_BUFFER, bufferID, offset, size});
+        }
+    }
+
+    if (mPendingUniformBuffers.empty())
+    {
+        return;
+    }
+
+    // Several blocks can share a binding point, and the block order is not the binding order.
+    std::sort(mPendingUniformBuffers.begin(), mPendingUniformBuffers.end(),
+              [](const PendingBinding &a, const PendingBinding &b) { return a.unit < b.unit; });
+    mPendingUniformBuffers.erase(
+        std::unique(mPendingUniformBuffers.begin(), mPendingUniformBuffers.end(),
+                    [](const PendingBinding &a, const PendingBinding &b) {
+                        return a.unit == b.unit;
+                    }),
+        mPendingUniformBuffers.end());
+
+    // A run is made of consecutive binding points that are all bound whole, or all bound ranges.
+    size_t runStart = 0;
+    for (size_t index = 0; index < mPendingUniformBuffers.size(); ++index)
+    {
+        const PendingBinding &pending = mPendingUniformBuffers[index];
+        IndexedBufferBinding &applied = appliedBindings[pending.unit];
+        applied.buffer                = pending.object;
+        applied.offset                = pending.offset;
+        applied.size                  = pending.size;
+
+        bool wholeBuffer = pending.size == static_cast<size_t>(-1);
+        size_t next      = index + 1;
+        if (next < mPendingUniformBuffers.size() &&
+            mPendingUniformBuffers[next].unit == pending.unit + 1 &&
+            (mPendingUniformBuffers[next].size == static_cast<size_t>(-1)) == wholeBuffer)
+        {
+            continue;
+        }
+
+        mMultiBindObjects.clear();
+        mMultiBindOffsets.clear();
+        mMultiBindSizes.clear();
+        for (size_t runIndex = runStart; runIndex < next; ++runIndex)
+        {
+            const PendingBinding &runBinding = mPendingUniformBuffers[runIndex];
+            mMultiBindObjects.push_back(runBinding.object);
+            mMultiBindOffsets.push_back(static_cast<GLintptr>(runBinding.offset));
+            mMultiBindSizes.push_back(static_cast<GLsizeiptr>(runBinding.size));
         }
+
+        GLuint first  = static_cast<GLuint>(mPendingUniformBuffers[runStart].unit);
+        GLsizei count = static_cast<GLsizei>(next - runStart);
+        if (wholeBuffer)
+        {
+            mFunctions->bindBuffersBase(GL_UNIFORM_BUFFER, first, count, mMultiBindObjects.data());
+        }
+        else
+        {
+            mFunctions->bindBuffersRange(GL_UNIFORM_BUFFER, first, count,
+                                         mMultiBindObjects.data(), mMultiBindOffsets.data(),
+                                         mMultiBindSizes.data());
+        }
+        mBindingCallCount++;
+        runStart = next;
     }
+}
 
-    for (const gl::SamplerBinding &samplerUniform : program->getSamplerBindings())
+void StateManagerGL::syncTextureBindings(const gl::State &state)
+{
+    const bool multiBind = mFunctions->bindTextures != nullptr;
+
+    mPendingTextures.clear();
+    mPendingSamplers.clear();
+    for (size_t textureUnitIndex : angle::IterateBitSet(state.getActiveTexturesMask()))
     {
-        GLenum textureType = samplerUniform.textureType;
-        for (GLuint textureUnitIndex : samplerUniform.boundTextureUnits)
+        GLenum textureType   = state.getActiveTextureType(textureUnitIndex);
+        gl::Texture *texture = state.getSamplerTexture(static_cast<unsigned int>(textureUnitIndex),
+                                                       textureType);
+        GLuint textureID = 0;
+        if (texture != nullptr)
         {
-            gl::Texture *texture = state.getSamplerTexture(textureUnitIndex, textureType);
-            if (texture != nullptr)
+            const TextureGL *textureGL = GetImplAs<TextureGL>(texture);
+            textureID                  = textureGL->getTextureID();
+
+            if (texture->hasAnyDirtyBit() || textureGL->hasAnyDirtyBit())
             {
-                const TextureGL *textureGL = GetImplAs<TextureGL>(texture);
+                // Syncing binds the texture to the active unit, so it is bound there first.
+                activeTexture(textureUnitIndex);
+                bindTexture(textureType, textureID);
 
-                if (mTextures[textureType][textureUnitIndex] != textureGL->getTextureID() ||
-                    texture->hasAnyDirtyBit() || textureGL->hasAnyDirtyBit())
-                {
-                    activeTexture(textureUnitIndex);
-                    bindTexture(textureType, textureGL->getTextureID());
+                // TODO: Call this from the gl:: layer once other backends use dirty bits for
+                // texture state.
+                texture->syncImplState();
+            }
+        }
 
-                    // TODO: Call this from the gl:: layer once other backends use dirty bits for
-                    // texture state.
-                    texture->syncImplState();
-                }
+        if (mTextures[textureType][textureUnitIndex] != textureID)
+        {
+            if (multiBind)
+            {
+                mPendingTextures.push_back({textureUnitIndex, textureType, textureID, 0, 0});
             }
             else
             {
-                if (mTextures[textureType][textureUnitIndex] != 0)
-                {
-                    activeTexture(textureUnitIndex);
-                    bindTexture(textureType, 0);
-                }
+                activeTexture(textureUnitIndex);
+                bindTexture(textureType, textureID);
             }
+        }
+
+        GLuint samplerID           = 0;
+        const gl::Sampler *sampler = state.getSampler(static_cast<GLuint>(textureUnitIndex));
+        if (sampler != nullptr)
+        {
+            const SamplerGL *samplerGL = GetImplAs<SamplerGL>(sampler);
+            samplerGL->syncState(sampler->getSamplerState());
+            samplerID = samplerGL->getSamplerID();
+        }
 
-            const gl::Sampler *sampler = state.getSampler(textureUnitIndex);
-            if (sampler != nullptr)
+        if (mSamplers[textureUnitIndex] != samplerID)
+        {
+            if (multiBind)
             {
-                const SamplerGL *samplerGL = GetImplAs<SamplerGL>(sampler);
-                samplerGL->syncState(sampler->getSamplerState());
-                bindSampler(textureUnitIndex, samplerGL->getSamplerID());
+                mPendingSamplers.push_back({textureUnitIndex, GL_NONE, samplerID, 0, 0});
             }
             else
             {
-                bindSampler(textureUnitIndex, 0);
+                bindSampler(textureUnitIndex, samplerID);
+            }
+        }
+    }
+
+    // The units are visited in order, so the pending bindings are sorted.
+    size_t runStart = 0;
+    for (size_t index = 0; index < mPendingTextures.size(); ++index)
+    {
+        const PendingBinding &pending = mPendingTextures[index];
+        if (pending.object == 0)
+        {
+            // Binding zero with glBindTextures unbinds every target of the unit.
+            for (auto &textureTypeIter : mTextures)
+            {
+                if (pending.unit < textureTypeIter.second.size())
+                {
+                    textureTypeIter.second[pending.unit] = 0;
+                }
             }
         }
+        else
+        {
+            mTextures[pending.type][pending.unit] = pending.object;
+        }
+
+        size_t next = index + 1;
+        if (next < mPendingTextures.size() && mPendingTextures[next].unit == pending.unit + 1)
+        {
+            continue;
+        }
+
+        mMultiBindObjects.clear();
+        for (size_t runIndex = runStart; runIndex < next; ++runIndex)
+        {
+            mMultiBindObjects.push_back(mPendingTextures[runIndex].object);
+        }
+        mFunctions->bindTextures(static_cast<GLuint>(mPendingTextures[runStart].unit),
+                                 static_cast<GLsizei>(next - runStart), mMultiBindObjects.data());
+        mBindingCallCount++;
+        runStart = next;
+    }
+
+    runStart = 0;
+    for (size_t index = 0; index < mPendingSamplers.size(); ++index)
+    {
+        const PendingBinding &pending = mPendingSamplers[index];
+        mSamplers[pending.unit]       = pending.object;
+
+        size_t next = index + 1;
+        if (next < mPendingSamplers.size() && mPendingSamplers[next].unit == pending.unit + 1)
+        {
+            continue;
+        }
+
+        mMultiBindObjects.clear();
+        for (size_t runIndex = runStart; runIndex < next; ++runIndex)
+        {
+            mMultiBindObjects.push_back(mPendingSamplers[runIndex].object);
+        }
+        mFunctions->bindSamplers(static_cast<GLuint>(mPendingSamplers[runStart].unit),
+                                 static_cast<GLsizei>(next - runStart), mMultiBindObjects.data());
+        mBindingCallCount++;
+        runStart = next;
     }
 }
 
@@ -164,10 +164,20 @@ class StateManagerGL final : angle::NonCopyable
 
     GLuint getBoundBuffer(GLenum type);
 
+    // The driver calls that bound textures, samplers and indexed buffers since the state manager
+    // was created, and those of them that applied the shader state of the last draw.
+    size_t getBindingCallCount() const { return mBindingCallCount; }
+    size_t getLastDrawBindingCallCount() const { return mLastDrawBindingCallCount; }
+
   private:
     // Set state that's common among draw commands and compute invocations.
     void setGenericShaderState(const gl::ContextState &data);
 
+    // Only the units and binding points the program uses are visited. With GL_ARB_multi_bind the
+    // bindings that changed are applied with one call for each run of consecutive units.
+    void syncUniformBufferBindings(const gl::State &state, const gl::Program *program);
+    void syncTextureBindings(const gl::State &state);
+
     // Set state that's common among draw commands.
     gl::Error setGenericDrawState(const gl::ContextState &data);
 
@@ -196,6 +206,28 @@ class StateManagerGL final : angle::NonCopyable
     std::map<GLenum, std::vector<GLuint>> mTextures;
     std::vector<GLuint> mSamplers;
 
+    // A binding that differs from the applied one, waiting for a multi-bind call. Buffer bindings
+    // made with bindBufferBase have the offset and size of IndexedBufferBinding, -1.
+    struct PendingBinding
+    {
+        size_t unit;
+        GLenum type;
+        GLuint object;
+        size_t offset;
+        size_t size;
+    };
+    std::vector<PendingBinding> mPendingTextures;
+    std::vector<PendingBinding> mPendingSamplers;
+    std::vector<PendingBinding> mPendingUniformBuffers;
+
+    // The arguments of the multi-bind calls, kept to avoid allocating them for every draw.
+    std::vector<GLuint> mMultiBindObjects;
+    std::vector<GLintptr> mMultiBindOffsets;
+    std::vector<GLsizeiptr> mMultiBindSizes;
+
+    size_t mBindingCallCount;
+    size_t mLastDrawBindingCallCount;
+
     GLuint mTransformFeedback;
 
     std::map<GLenum, GLuint> mQueries;
@@ -0,0 +1,318 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// StreamingBufferGL.cpp: Implements the class methods for StreamingBufferGL.
+
+#include "libANGLE/renderer/gl/StreamingBufferGL.h"
+
+#include "common/debug.h"
+#include "common/mathutil.h"
+#include "libANGLE/renderer/gl/FunctionsGL.h"
+#include "libANGLE/renderer/gl/StateManagerGL.h"
+
+namespace rx
+{
+
+namespace
+{
+
+// Grown by doubling, which keeps it a multiple of the segment count.
+constexpr size_t kInitialCapacity = 512 * 1024;
+
+// The waits on the fences of the regions are retried with this timeout, in nanoseconds.
+constexpr GLuint64 kFenceWaitTimeout = 1000000000ull;
+
+}  // anonymous namespace
+
+StreamingBufferGL::StreamingBufferGL(const FunctionsGL *functions,
+                                     StateManagerGL *stateManager,
+                                     GLenum target)
+    : mFunctions(functions),
+      mStateManager(stateManager),
+      mTarget(target),
+      mPersistent(functions->bufferStorage != nullptr && functions->mapBufferRange != nullptr &&
+                  functions->fenceSync != nullptr && functions->clientWaitSync != nullptr &&
+                  functions->deleteSync != nullptr),
+      mBufferID(0),
+      mCapacity(0),
+      mHead(0),
+      mSerial(0),
+      mMappedOffset(0),
+      mMappedSize(0),
+      mPersistentPointer(nullptr)
+{
+    mSegmentFences.fill(nullptr);
+    mSegmentOpen.fill(false);
+}
+
+StreamingBufferGL::~StreamingBufferGL()
+{
+    release();
+}
+
+gl::Error StreamingBufferGL::map(size_t size,
+                                 size_t alignment,
+                                 size_t minOffset,
+                                 uint8_t **bufferPointerOut,
+                                 size_t *offsetOut)
+{
+    ASSERT(mMappedSize == 0);
+
+    // Empty ranges can't be mapped.
+    size = std::max<size_t>(size, 1);
+
+    size_t offset = roundUp(std::max(mHead, minOffset), alignment);
+    if (mBufferID == 0 || offset + size > mCapacity)
+    {
+        offset = roundUp(minOffset, alignment);
+        if (mBufferID == 0 || offset + size > mCapacity)
+        {
+            size_t capacity = std::max(mCapacity, kInitialCapacity);
+            while (capacity < offset + size)
+            {
+                capacity *= 2;
+            }
+            ANGLE_TRY(allocate(capacity));
+        }
+        else
+        {
+            wrap();
+        }
+    }
+
+    mStateManager->bindBuffer(mTarget, mBufferID);
+
+    uint8_t *bufferPointer = nullptr;
+    if (mPersistent)
+    {
+        ANGLE_TRY(waitForSegments(offset, offset + size));
+        bufferPointer = mPersistentPointer + offset;
+    }
+    else if (mFunctions->mapBufferRange != nullptr)
+    {
+        // Nothing written to the range since the last wrap, so there is nothing to wait for.
+        const GLbitfield access =
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+        bufferPointer =
+            static_cast<uint8_t *>(mFunctions->mapBufferRange(mTarget, offset, size, access));
+        if (bufferPointer == nullptr)
+        {
+            return gl::Error(GL_OUT_OF_MEMORY, "Failed to map the client data streaming buffer.");
+        }
+    }
+    else
+    {
+        mStagingData.resize(size);
+        bufferPointer = mStagingData.data();
+    }
+
+    mHead         = offset + size;
+    mMappedOffset = offset;
+    mMappedSize   = size;
+
+    *bufferPointerOut = bufferPointer;
+    *offsetOut        = offset;
+    return gl::NoError();
+}
+
+bool StreamingBufferGL::unmap()
+{
+    ASSERT(mMappedSize != 0);
+
+    bool result = true;
+    if (!mPersistent)
+    {
+        mStateManager->bindBuffer(mTarget, mBufferID);
+        if (mFunctions->mapBufferRange != nullptr)
+        {
+            result = (mFunctions->unmapBuffer(mTarget) == GL_TRUE);
+        }
+        else
+        {
+            mFunctions->bufferSubData(mTarget, mMappedOffset, mMappedSize, mStagingData.data());
+        }
+    }
+
+    // Nothing previously written can be relied on after a failed unmap.
+    if (!result)
+    {
+        mSerial++;
+    }
+
+    mMappedSize = 0;
+    return result;
+}
+
+void StreamingBufferGL::markUsed(size_t offset, size_t size)
+{
+    ASSERT(offset + size <= mCapacity);
+
+    if (!mPersistent || size == 0)
+    {
+        return;
+    }
+
+    // The regions are opened again without waiting, they are not written to before the next wrap.
+    // The fence set when writing leaves them next also covers the draws issued before the old one.
+    const size_t segmentSize  = mCapacity / kSegmentCount;
+    const size_t firstSegment = offset / segmentSize;
+    const size_t lastSegment  = std::min((offset + size - 1) / segmentSize, kSegmentCount - 1);
+    for (size_t segment = firstSegment; segment <= lastSegment; ++segment)
+    {
+        if (mSegmentOpen[segment])
+        {
+            continue;
+        }
+
+        if (mSegmentFences[segment] != nullptr)
+        {
+            mFunctions->deleteSync(mSegmentFences[segment]);
+            mSegmentFences[segment] = nullptr;
+        }
+        mSegmentOpen[segment] = true;
+    }
+}
+
+gl::Error StreamingBufferGL::allocate(size_t capacity)
+{
+    release();
+
+    mFunctions->genBuffers(1, &mBufferID);
+    mStateManager->bindBuffer(mTarget, mBufferID);
+
+    if (mPersistent)
+    {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        mFunctions->bufferStorage(mTarget, capacity, nullptr, flags);
+        mPersistentPointer =
+            static_cast<uint8_t *>(mFunctions->mapBufferRange(mTarget, 0, capacity, flags));
+        if (mPersistentPointer == nullptr)
+        {
+            return gl::Error(GL_OUT_OF_MEMORY, "Failed to map the client data streaming buffer.");
+        }
+    }
+    else
+    {
+        mFunctions->bufferData(mTarget, capacity, nullptr, GL_STREAM_DRAW);
+    }
+
+    mCapacity = capacity;
+    mHead     = 0;
+    mSerial++;
+    return gl::NoError();
+}
+
+void StreamingBufferGL::release()
+{
+    for (size_t segment = 0; segment < kSegmentCount; ++segment)
+    {
+        if (mSegmentFences[segment] != nullptr)
+        {
+            mFunctions->deleteSync(mSegmentFences[segment]);
+            mSegmentFences[segment] = nullptr;
+        }
+        mSegmentOpen[segment] = false;
+    }
+
+    // Deleting the buffer also ends its persistent mapping. The draws that still read it keep its
+    // storage alive.
+    mStateManager->deleteBuffer(mBufferID);
+    mBufferID          = 0;
+    mPersistentPointer = nullptr;
+    mCapacity          = 0;
+    mHead              = 0;
+}
+
+void StreamingBufferGL::wrap()
+{
+    if (mPersistent)
+    {
+        // Fencing every region, even the ones written last, makes writing them again wait.
+        for (size_t segment = 0; segment < kSegmentCount; ++segment)
+        {
+            if (mSegmentOpen[segment])
+            {
+                fenceSegment(segment);
+            }
+        }
+    }
+    else
+    {
+        // Orphan the storage once per wrap rather than on every write.
+        mStateManager->bindBuffer(mTarget, mBufferID);
+        mFunctions->bufferData(mTarget, mCapacity, nullptr, GL_STREAM_DRAW);
+    }
+
+    mHead = 0;
+    mSerial++;
+}
+
+gl::Error StreamingBufferGL::waitForSegments(size_t begin, size_t end)
+{
+    ASSERT(begin < end && end <= mCapacity);
+
+    const size_t segmentSize  = mCapacity / kSegmentCount;
+    const size_t firstSegment = begin / segmentSize;
+    const size_t lastSegment  = std::min((end - 1) / segmentSize, kSegmentCount - 1);
+
+    // Writing moves on from the regions outside of the range, the draws reading them are all
+    // issued by now.
+    for (size_t segment = 0; segment < kSegmentCount; ++segment)
+    {
+        if (mSegmentOpen[segment] && (segment < firstSegment || segment > lastSegment))
+        {
+            fenceSegment(segment);
+        }
+    }
+
+    for (size_t segment = firstSegment; segment <= lastSegment; ++segment)
+    {
+        if (mSegmentOpen[segment])
+        {
+            continue;
+        }
+
+        GLsync fence = mSegmentFences[segment];
+        if (fence != nullptr)
+        {
+            GLenum result = GL_TIMEOUT_EXPIRED;
+            do
+            {
+                result = mFunctions->clientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                                    kFenceWaitTimeout);
+            } while (result == GL_TIMEOUT_EXPIRED);
+
+            mFunctions->deleteSync(fence);
+            mSegmentFences[segment] = nullptr;
+
+            if (result == GL_WAIT_FAILED)
+            {
+                return gl::Error(GL_OUT_OF_MEMORY,
+                                 "Failed to wait on the client data streaming buffer.");
+            }
+        }
+
+        mSegmentOpen[segment] = true;
+    }
+
+    return gl::NoError();
+}
+
+void StreamingBufferGL::fenceSegment(size_t segment)
+{
+    ASSERT(mSegmentOpen[segment] && mSegmentFences[segment] == nullptr);
+
+    mSegmentFences[segment] = mFunctions->fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    if (mSegmentFences[segment] == nullptr)
+    {
+        // Without a fence, the region can only be written again once everything is done.
+        mFunctions->finish();
+    }
+
+    mSegmentOpen[segment] = false;
+}
+
+}  // namespace rx
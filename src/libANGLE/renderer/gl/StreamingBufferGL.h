@@ -0,0 +1,97 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// StreamingBufferGL.h: Defines the class interface for StreamingBufferGL, the ring buffer that
+// client-side vertex and index data is streamed into.
+
+#ifndef LIBANGLE_RENDERER_GL_STREAMINGBUFFERGL_H_
+#define LIBANGLE_RENDERER_GL_STREAMINGBUFFERGL_H_
+
+#include <array>
+#include <vector>
+
+#include "common/angleutils.h"
+#include "libANGLE/Error.h"
+#include "libANGLE/renderer/gl/functionsgl_typedefs.h"
+
+namespace rx
+{
+
+class FunctionsGL;
+class StateManagerGL;
+
+// Each write is appended after the previous one, so the draws reading the earlier writes never
+// wait on it. When the end of the buffer is reached, writing starts over from the beginning:
+//  - With GL_ARB_buffer_storage and sync objects, the buffer is mapped persistently once, and the
+//    regions about to be written again are waited on with the fences set when they were left.
+//  - Otherwise the storage is orphaned, and each write maps its range unsynchronized, or goes
+//    through glBufferSubData when buffers can't be mapped.
+// The buffer only grows, into new storage, when a single write does not fit in it.
+class StreamingBufferGL final : angle::NonCopyable
+{
+  public:
+    StreamingBufferGL(const FunctionsGL *functions, StateManagerGL *stateManager, GLenum target);
+    ~StreamingBufferGL();
+
+    // Reserves |size| bytes at an offset that is a multiple of |alignment| and no less than
+    // |minOffset|, binds the buffer to its target and returns where to write the bytes. unmap()
+    // must be called once they are written.
+    gl::Error map(size_t size,
+                  size_t alignment,
+                  size_t minOffset,
+                  uint8_t **bufferPointerOut,
+                  size_t *offsetOut);
+
+    // Returns false if the data written since map() was lost, and must be written again.
+    bool unmap();
+
+    // Must be called for the range of a previous write that a draw reads again, since the fence
+    // of its region may have been set before that draw.
+    void markUsed(size_t offset, size_t size);
+
+    GLuint getBufferID() const { return mBufferID; }
+
+    // Changes whenever the data written so far may be overwritten or orphaned. The offset of a
+    // previous write can be reused for the same data as long as the serial has not changed.
+    unsigned int getSerial() const { return mSerial; }
+
+  private:
+    gl::Error allocate(size_t capacity);
+    void release();
+    void wrap();
+    gl::Error waitForSegments(size_t begin, size_t end);
+    void fenceSegment(size_t segment);
+
+    const FunctionsGL *mFunctions;
+    StateManagerGL *mStateManager;
+    GLenum mTarget;
+    bool mPersistent;
+
+    GLuint mBufferID;
+    size_t mCapacity;
+    size_t mHead;
+    unsigned int mSerial;
+
+    size_t mMappedOffset;
+    size_t mMappedSize;
+
+    // The start of the persistent mapping.
+    uint8_t *mPersistentPointer;
+
+    // Fences of the regions of the persistently mapped buffer. A region is written to or read
+    // again between the wait on its fence and the next one being set, which happens once writing
+    // moves on to other regions.
+    static constexpr size_t kSegmentCount = 4;
+    std::array<GLsync, kSegmentCount> mSegmentFences;
+    std::array<bool, kSegmentCount> mSegmentOpen;
+
+    // Holds the data of a write until unmap() when the buffer can't be mapped.
+    std::vector<uint8_t> mStagingData;
+};
+
+}  // namespace rx
+
+#endif  // LIBANGLE_RENDERER_GL_STREAMINGBUFFERGL_H_
@@ -33,6 +33,73 @@ bool AttributeNeedsStreaming(const VertexAttribute &attrib, const VertexBinding
 }
 }  // anonymous namespace
 
+bool VertexArrayGL::StreamedData::matches(unsigned int bufferSerial,
+                                          const uint8_t *sourcePointer,
+                                          size_t sourceStride,
+                                          size_t firstElement,
+                                          size_t elementSize,
+                                          size_t elementCount) const
+{
+    if (!valid || serial != bufferSerial || source != sourcePointer || stride != sourceStride ||
+        first != firstElement || size != elementSize || data.size() != elementSize * elementCount)
+    {
+        return false;
+    }
+
+    if (elementCount == 0)
+    {
+        return true;
+    }
+
+    // The application may have changed the data in place.
+    const uint8_t *element = sourcePointer + sourceStride * firstElement;
+    if (sourceStride == elementSize)
+    {
+        return memcmp(data.data(), element, data.size()) == 0;
+    }
+
+    for (size_t elementIndex = 0; elementIndex < elementCount; elementIndex++)
+    {
+        if (memcmp(data.data() + elementSize * elementIndex, element + sourceStride * elementIndex,
+                   elementSize) != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void VertexArrayGL::StreamedData::update(const uint8_t *sourcePointer,
+                                         size_t sourceStride,
+                                         size_t firstElement,
+                                         size_t elementSize,
+                                         size_t elementCount)
+{
+    // Not valid until the data is written to the streaming buffer.
+    valid  = false;
+    source = sourcePointer;
+    stride = sourceStride;
+    first  = firstElement;
+    size   = elementSize;
+
+    data.resize(elementSize * elementCount);
+    const uint8_t *element = sourcePointer + sourceStride * firstElement;
+    if (sourceStride == elementSize)
+    {
+        // Can copy in one go, the data is packed
+        memcpy(data.data(), element, data.size());
+    }
+    else
+    {
+        // Copy each element individually
+        for (size_t elementIndex = 0; elementIndex < elementCount; elementIndex++)
+        {
+            memcpy(data.data() + elementSize * elementIndex, element + sourceStride * elementIndex,
+                   elementSize);
+        }
+    }
+}
+
 VertexArrayGL::VertexArrayGL(const VertexArrayState &state,
                              const FunctionsGL *functions,
                              StateManagerGL *stateManager)
@@ -42,10 +109,11 @@ VertexArrayGL::VertexArrayGL(const VertexArrayState &state,
       mVertexArrayID(0),
       mAppliedElementArrayBuffer(),
       mAppliedBindings(state.getMaxBindings()),
-      mStreamingElementArrayBufferSize(0),
-      mStreamingElementArrayBuffer(0),
-      mStreamingArrayBufferSize(0),
-      mStreamingArrayBuffer(0)
+      mStreamingElementArrayBuffer(functions, stateManager, GL_ELEMENT_ARRAY_BUFFER),
+      mStreamedIndexRangeValid(false),
+      mStreamedIndexRangePrimitiveRestart(false),
+      mStreamingArrayBuffer(functions, stateManager, GL_ARRAY_BUFFER),
+      mStreamedAttributes(state.getMaxAttribs())
 {
     ASSERT(mFunctions);
     ASSERT(mStateManager);
@@ -64,14 +132,6 @@ VertexArrayGL::~VertexArrayGL()
     mStateManager->deleteVertexArray(mVertexArrayID);
     mVertexArrayID = 0;
 
-    mStateManager->deleteBuffer(mStreamingElementArrayBuffer);
-    mStreamingElementArrayBufferSize = 0;
-    mStreamingElementArrayBuffer     = 0;
-
-    mStateManager->deleteBuffer(mStreamingArrayBuffer);
-    mStreamingArrayBufferSize = 0;
-    mStreamingArrayBuffer     = 0;
-
     mAppliedElementArrayBuffer.set(nullptr);
     for (auto &binding : mAppliedBindings)
     {
@@ -202,43 +262,66 @@ gl::Error VertexArrayGL::syncIndexData(GLsizei count,
     {
         // Need to stream the index buffer
         // TODO: if GLES, nothing needs to be streamed
+        const Type &indexTypeInfo   = GetTypeInfo(type);
+        const uint8_t *indexPointer = static_cast<const uint8_t *>(indices);
+        const size_t indexCount     = static_cast<size_t>(count);
 
-        // Only compute the index range if the attributes also need to be streamed
-        if (attributesNeedStreaming)
+        // The indices of the previous draw that streamed some are reused if they are the same.
+        if (mStreamedIndices.matches(mStreamingElementArrayBuffer.getSerial(), indexPointer,
+                                     indexTypeInfo.bytes, 0, indexTypeInfo.bytes, indexCount))
         {
-            *outIndexRange = ComputeIndexRange(type, indices, count, primitiveRestartEnabled);
+            mStreamingElementArrayBuffer.markUsed(mStreamedIndices.offset,
+                                                  mStreamedIndices.data.size());
+            mStateManager->bindBuffer(GL_ELEMENT_ARRAY_BUFFER,
+                                      mStreamingElementArrayBuffer.getBufferID());
         }
-
-        // Allocate the streaming element array buffer
-        if (mStreamingElementArrayBuffer == 0)
+        else
         {
-            mFunctions->genBuffers(1, &mStreamingElementArrayBuffer);
-            mStreamingElementArrayBufferSize = 0;
-        }
+            mStreamedIndices.update(indexPointer, indexTypeInfo.bytes, 0, indexTypeInfo.bytes,
+                                    indexCount);
+            mStreamedIndexRangeValid = false;
+
+            // Unmapping a buffer can return GL_FALSE to indicate that the system has corrupted
+            // the data somehow (such as by a screen change), retry writing the data a few times
+            // and return OUT_OF_MEMORY if that fails.
+            bool unmapResult          = false;
+            size_t unmapRetryAttempts = 5;
+            while (!unmapResult && --unmapRetryAttempts > 0)
+            {
+                uint8_t *bufferPointer = nullptr;
+                ANGLE_TRY(mStreamingElementArrayBuffer.map(mStreamedIndices.data.size(),
+                                                           indexTypeInfo.bytes, 0, &bufferPointer,
+                                                           &mStreamedIndices.offset));
+                memcpy(bufferPointer, mStreamedIndices.data.data(), mStreamedIndices.data.size());
+                unmapResult = mStreamingElementArrayBuffer.unmap();
+            }
 
-        mStateManager->bindBuffer(GL_ELEMENT_ARRAY_BUFFER, mStreamingElementArrayBuffer);
-        mAppliedElementArrayBuffer.set(nullptr);
+            if (!unmapResult)
+            {
+                return Error(GL_OUT_OF_MEMORY, "Failed to unmap the client data streaming buffer.");
+            }
 
-        // Make sure the element array buffer is large enough
-        const Type &indexTypeInfo          = GetTypeInfo(type);
-        size_t requiredStreamingBufferSize = indexTypeInfo.bytes * count;
-        if (requiredStreamingBufferSize > mStreamingElementArrayBufferSize)
-        {
-            // Copy the indices in while resizing the buffer
-            mFunctions->bufferData(GL_ELEMENT_ARRAY_BUFFER, requiredStreamingBufferSize, indices,
-                                   GL_DYNAMIC_DRAW);
-            mStreamingElementArrayBufferSize = requiredStreamingBufferSize;
+            mStreamedIndices.valid  = true;
+            mStreamedIndices.serial = mStreamingElementArrayBuffer.getSerial();
         }
-        else
+        mAppliedElementArrayBuffer.set(nullptr);
+
+        // Only compute the index range if the attributes also need to be streamed
+        if (attributesNeedStreaming)
         {
-            // Put the indices at the beginning of the buffer
-            mFunctions->bufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, requiredStreamingBufferSize,
-                                      indices);
+            if (!mStreamedIndexRangeValid ||
+                mStreamedIndexRangePrimitiveRestart != primitiveRestartEnabled)
+            {
+                mStreamedIndexRange =
+                    ComputeIndexRange(type, indices, count, primitiveRestartEnabled);
+                mStreamedIndexRangeValid            = true;
+                mStreamedIndexRangePrimitiveRestart = primitiveRestartEnabled;
+            }
+            *outIndexRange = mStreamedIndexRange;
         }
 
-        // Set the index offset for the draw call to zero since the supplied index pointer is to
-        // client data
-        *outIndices = nullptr;
+        // The indices are at an offset of the streaming element array buffer
+        *outIndices = reinterpret_cast<const GLvoid *>(mStreamedIndices.offset);
     }
 
     return NoError();
@@ -289,38 +372,26 @@ gl::Error VertexArrayGL::streamAttributes(const gl::AttributesMask &activeAttrib
         return gl::NoError();
     }
 
-    if (mStreamingArrayBuffer == 0)
-    {
-        mFunctions->genBuffers(1, &mStreamingArrayBuffer);
-        mStreamingArrayBufferSize = 0;
-    }
+    // If first is greater than zero, a slack space needs to be left before the data so that the
+    // same 'first' argument can be passed into the draw call.
+    const size_t bufferEmptySpace = maxAttributeDataSize * indexRange.start;
 
-    // If first is greater than zero, a slack space needs to be left at the beginning of the buffer
-    // so that the same 'first' argument can be passed into the draw call.
-    const size_t bufferEmptySpace   = maxAttributeDataSize * indexRange.start;
-    const size_t requiredBufferSize = streamingDataSize + bufferEmptySpace;
-
-    mStateManager->bindBuffer(GL_ARRAY_BUFFER, mStreamingArrayBuffer);
-    if (requiredBufferSize > mStreamingArrayBufferSize)
-    {
-        mFunctions->bufferData(GL_ARRAY_BUFFER, requiredBufferSize, nullptr, GL_DYNAMIC_DRAW);
-        mStreamingArrayBufferSize = requiredBufferSize;
-    }
+    const auto &attribs                    = mData.getVertexAttributes();
+    const auto &bindings                   = mData.getVertexBindings();
+    const gl::AttributesMask streamingMask = mAttributesNeedStreaming & activeAttributesMask;
 
     // Unmapping a buffer can return GL_FALSE to indicate that the system has corrupted the data
     // somehow (such as by a screen change), retry writing the data a few times and return
     // OUT_OF_MEMORY if that fails.
-    GLboolean unmapResult     = GL_FALSE;
+    bool unmapResult          = false;
     size_t unmapRetryAttempts = 5;
-    while (unmapResult != GL_TRUE && --unmapRetryAttempts > 0)
+    while (!unmapResult && --unmapRetryAttempts > 0)
     {
-        uint8_t *bufferPointer = MapBufferRangeWithFallback(mFunctions, GL_ARRAY_BUFFER, 0,
-                                                            requiredBufferSize, GL_MAP_WRITE_BIT);
-        size_t curBufferOffset = bufferEmptySpace;
-
-        const auto &attribs  = mData.getVertexAttributes();
-        const auto &bindings = mData.getVertexBindings();
-        for (auto idx : angle::IterateBitSet(mAttributesNeedStreaming & activeAttributesMask))
+        // The attributes that stream the same data as the last time they did reuse it.
+        const unsigned int bufferSerial = mStreamingArrayBuffer.getSerial();
+        gl::AttributesMask reusedMask;
+        size_t copiedDataSize = 0;
+        for (auto idx : angle::IterateBitSet(streamingMask))
         {
             const auto &attrib  = attribs[idx];
             const auto &binding = bindings[attrib.bindingIndex];
@@ -328,7 +399,6 @@ gl::Error VertexArrayGL::streamAttributes(const gl::AttributesMask &activeAttrib
 
             const size_t streamedVertexCount =
                 ComputeVertexBindingElementCount(binding, indexRange.vertexCount(), instanceCount);
-
             const size_t sourceStride = ComputeVertexAttributeStride(attrib, binding);
             const size_t destStride   = ComputeVertexAttributeTypeSize(attrib);
 
@@ -340,27 +410,68 @@ gl::Error VertexArrayGL::streamAttributes(const gl::AttributesMask &activeAttrib
             // https://www.opengl.org/registry/specs/ARB/vertex_attrib_binding.txt
             const uint8_t *inputPointer = reinterpret_cast<const uint8_t *>(attrib.pointer);
 
-            // Pack the data when copying it, user could have supplied a very large stride that
-            // would cause the buffer to be much larger than needed.
-            if (destStride == sourceStride)
+            if (mStreamedAttributes[idx].matches(bufferSerial, inputPointer, sourceStride,
+                                                 firstIndex, destStride, streamedVertexCount))
+            {
+                reusedMask.set(idx);
+            }
+            else
+            {
+                // Pack the data when copying it, user could have supplied a very large stride
+                // that would cause the buffer to be much larger than needed.
+                mStreamedAttributes[idx].update(inputPointer, sourceStride, firstIndex, destStride,
+                                                streamedVertexCount);
+                copiedDataSize += mStreamedAttributes[idx].data.size();
+            }
+        }
+
+        uint8_t *bufferPointer = nullptr;
+        size_t bufferOffset    = 0;
+        if (copiedDataSize > 0)
+        {
+            ANGLE_TRY(mStreamingArrayBuffer.map(copiedDataSize, sizeof(float), bufferEmptySpace,
+                                                &bufferPointer, &bufferOffset));
+
+            // Making room for the data may have wrapped the buffer over the reused data, which is
+            // then streamed again along with the rest.
+            if (mStreamingArrayBuffer.getSerial() != bufferSerial && reusedMask.any())
+            {
+                mStreamingArrayBuffer.unmap();
+                reusedMask.reset();
+                ANGLE_TRY(mStreamingArrayBuffer.map(streamingDataSize, sizeof(float),
+                                                    bufferEmptySpace, &bufferPointer,
+                                                    &bufferOffset));
+            }
+        }
+        else
+        {
+            mStateManager->bindBuffer(GL_ARRAY_BUFFER, mStreamingArrayBuffer.getBufferID());
+        }
+
+        size_t curBufferOffset = bufferOffset;
+        for (auto idx : angle::IterateBitSet(streamingMask))
+        {
+            const auto &attrib      = attribs[idx];
+            StreamedData &streamed  = mStreamedAttributes[idx];
+            const size_t destStride = ComputeVertexAttributeTypeSize(attrib);
+
+            if (reusedMask[idx])
             {
-                // Can copy in one go, the data is packed
-                memcpy(bufferPointer + curBufferOffset, inputPointer + (sourceStride * firstIndex),
-                       destStride * streamedVertexCount);
+                // After map(), which may have fenced the region of the reused data.
+                mStreamingArrayBuffer.markUsed(streamed.offset, streamed.data.size());
             }
             else
             {
-                // Copy each vertex individually
-                for (size_t vertexIdx = 0; vertexIdx < streamedVertexCount; vertexIdx++)
-                {
-                    uint8_t *out      = bufferPointer + curBufferOffset + (destStride * vertexIdx);
-                    const uint8_t *in = inputPointer + sourceStride * (vertexIdx + firstIndex);
-                    memcpy(out, in, destStride);
-                }
+                memcpy(bufferPointer + (curBufferOffset - bufferOffset), streamed.data.data(),
+                       streamed.data.size());
+                streamed.valid  = true;
+                streamed.serial = mStreamingArrayBuffer.getSerial();
+                streamed.offset = curBufferOffset;
+                curBufferOffset += streamed.data.size();
             }
 
             // Compute where the 0-index vertex would be.
-            const size_t vertexStartOffset = curBufferOffset - (firstIndex * destStride);
+            const size_t vertexStartOffset = streamed.offset - (streamed.first * destStride);
 
             if (attrib.pureInteger)
             {
@@ -378,17 +489,15 @@ gl::Error VertexArrayGL::streamAttributes(const gl::AttributesMask &activeAttrib
                     reinterpret_cast<const GLvoid *>(vertexStartOffset));
             }
 
-            curBufferOffset += destStride * streamedVertexCount;
-
             // Mark the applied attribute as dirty by setting an invalid size so that if it doesn't
             // need to be streamed later, there is no chance that the caching will skip it.
             mAppliedAttributes[idx].size = static_cast<GLuint>(-1);
         }
 
-        unmapResult = mFunctions->unmapBuffer(GL_ARRAY_BUFFER);
+        unmapResult = (copiedDataSize == 0 || mStreamingArrayBuffer.unmap());
     }
 
-    if (unmapResult != GL_TRUE)
+    if (!unmapResult)
     {
         return Error(GL_OUT_OF_MEMORY, "Failed to unmap the client data streaming buffer.");
     }
@@ -405,7 +514,7 @@ GLuint VertexArrayGL::getAppliedElementArrayBufferID() const
 {
     if (mAppliedElementArrayBuffer.get() == nullptr)
     {
-        return mStreamingElementArrayBuffer;
+        return mStreamingElementArrayBuffer.getBufferID();
     }
 
     return GetImplAs<BufferGL>(mAppliedElementArrayBuffer.get())->getBufferID();
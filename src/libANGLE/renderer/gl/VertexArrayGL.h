@@ -10,6 +10,7 @@
 #define LIBANGLE_RENDERER_GL_VERTEXARRAYGL_H_
 
 #include "libANGLE/renderer/VertexArrayImpl.h"
+#include "libANGLE/renderer/gl/StreamingBufferGL.h"
 
 namespace rx
 {
@@ -44,6 +45,35 @@ class VertexArrayGL : public VertexArrayImpl
     void syncState(ContextImpl *contextImpl, const gl::VertexArray::DirtyBits &dirtyBits) override;
 
   private:
+    // The data last streamed for an attribute or for the indices. It stays in the streaming buffer
+    // as long as the serial of the buffer does not change, so the draws streaming the same data
+    // again only point to it.
+    struct StreamedData
+    {
+        bool matches(unsigned int bufferSerial,
+                     const uint8_t *sourcePointer,
+                     size_t sourceStride,
+                     size_t firstElement,
+                     size_t elementSize,
+                     size_t elementCount) const;
+        void update(const uint8_t *sourcePointer,
+                    size_t sourceStride,
+                    size_t firstElement,
+                    size_t elementSize,
+                    size_t elementCount);
+
+        bool valid            = false;
+        unsigned int serial   = 0;
+        const uint8_t *source = nullptr;
+        size_t stride         = 0;
+        size_t first          = 0;
+        size_t size           = 0;
+        size_t offset         = 0;
+
+        // The packed elements.
+        std::vector<uint8_t> data;
+    };
+
     gl::Error syncDrawState(const gl::AttributesMask &activeAttributesMask,
                             GLint first,
                             GLsizei count,
@@ -90,11 +120,14 @@ class VertexArrayGL : public VertexArrayImpl
     mutable std::vector<gl::VertexAttribute> mAppliedAttributes;
     mutable std::vector<gl::VertexBinding> mAppliedBindings;
 
-    mutable size_t mStreamingElementArrayBufferSize;
-    mutable GLuint mStreamingElementArrayBuffer;
+    mutable StreamingBufferGL mStreamingElementArrayBuffer;
+    mutable StreamedData mStreamedIndices;
+    mutable bool mStreamedIndexRangeValid;
+    mutable bool mStreamedIndexRangePrimitiveRestart;
+    mutable gl::IndexRange mStreamedIndexRange;
 
-    mutable size_t mStreamingArrayBufferSize;
-    mutable GLuint mStreamingArrayBuffer;
+    mutable StreamingBufferGL mStreamingArrayBuffer;
+    mutable std::vector<StreamedData> mStreamedAttributes;
 
     gl::AttributesMask mAttributesNeedStreaming;
 };
@@ -186,23 +186,9 @@ static void LimitVersion(gl::Version *curVersion, const gl::Version &maxVersion)
 void GenerateCaps(const FunctionsGL *functions,
                   const WorkaroundsGL &workarounds,
                   gl::Caps *caps,
-                  gl::TextureCapsMap *textureCapsMap,
                   gl::Extensions *extensions,
                   gl::Version *maxSupportedESVersion)
 {
-    // Texture format support checks
-    const gl::FormatSet &allFormats = gl::GetAllSizedInternalFormats();
-    for (GLenum internalFormat : allFormats)
-    {
-        gl::TextureCaps textureCaps = GenerateTextureFormatCaps(functions, internalFormat);
-        textureCapsMap->insert(internalFormat, textureCaps);
-
-        if (gl::GetInternalFormatInfo(internalFormat).compressed)
-        {
-            caps->compressedTextureFormats.push_back(internalFormat);
-        }
-    }
-
     // Start by assuming ES3.1 support and work down
     *maxSupportedESVersion = gl::Version(3, 1);
 
@@ -796,7 +782,6 @@ void GenerateCaps(const FunctionsGL *functions,
     }
 
     // Extension support
-    extensions->setTextureExtensionSupport(*textureCapsMap);
     extensions->elementIndexUint = functions->standard == STANDARD_GL_DESKTOP ||
                                    functions->isAtLeastGLES(gl::Version(3, 0)) || functions->hasGLESExtension("GL_OES_element_index_uint");
     extensions->getProgramBinary = caps->programBinaryFormats.size() > 0;
@@ -926,6 +911,27 @@ void GenerateCaps(const FunctionsGL *functions,
     extensions->translatedShaderSource = true;
 }
 
+void GenerateTextureCaps(const FunctionsGL *functions,
+                         gl::Caps *caps,
+                         gl::TextureCapsMap *textureCapsMap,
+                         gl::Extensions *extensions)
+{
+    // Texture format support checks
+    const gl::FormatSet &allFormats = gl::GetAllSizedInternalFormats();
+    for (GLenum internalFormat : allFormats)
+    {
+        gl::TextureCaps textureCaps = GenerateTextureFormatCaps(functions, internalFormat);
+        textureCapsMap->insert(internalFormat, textureCaps);
+
+        if (gl::GetInternalFormatInfo(internalFormat).compressed)
+        {
+            caps->compressedTextureFormats.push_back(internalFormat);
+        }
+    }
+
+    extensions->setTextureExtensionSupport(*textureCapsMap);
+}
+
 void GenerateWorkarounds(const FunctionsGL *functions, WorkaroundsGL *workarounds)
 {
     VendorID vendor = GetVendorID(functions);
@@ -37,13 +37,21 @@ std::string GetDriverVersion(const FunctionsGL *functions);
 namespace nativegl_gl
 {
 
+// Generates the caps and extensions that do not depend on the support of the texture formats, and
+// the highest ES version that can be supported.
 void GenerateCaps(const FunctionsGL *functions,
                   const WorkaroundsGL &workarounds,
                   gl::Caps *caps,
-                  gl::TextureCapsMap *textureCapsMap,
                   gl::Extensions *extensions,
                   gl::Version *maxSupportedESVersion);
 
+// Checks the support of every sized format, which takes many queries, and completes the caps and
+// extensions that depend on it.
+void GenerateTextureCaps(const FunctionsGL *functions,
+                         gl::Caps *caps,
+                         gl::TextureCapsMap *textureCapsMap,
+                         gl::Extensions *extensions);
+
 void GenerateWorkarounds(const FunctionsGL *functions, WorkaroundsGL *workarounds);
 }
 
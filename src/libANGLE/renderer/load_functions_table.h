@@ -17,6 +17,14 @@ namespace angle
 
 rx::LoadFunctionMap GetLoadFunctionsMap(GLenum internalFormat, Format::ID angleFormat);
 
+// An ANGLE format the internal format has load functions into, for the back-ends that store the
+// images without the constraints of a graphics API: the first such format by name, or the format
+// the internal format maps to when it has no load functions of its own. Returns Format::ID::NONE
+// for the internal formats the table doesn't know. Unsized formats get the format of one of their
+// types, for example GL_ALPHA, GL_LUMINANCE and GL_LUMINANCE_ALPHA get the R16G16B16A16_FLOAT of
+// their half-float loads, so callers should pass sized formats.
+Format::ID GetLoadFormatID(GLenum internalFormat);
+
 }  // namespace angle
 
 #endif  // LIBANGLE_RENDERER_LOADFUNCTIONSTABLE_H_
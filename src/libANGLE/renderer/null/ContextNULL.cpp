@@ -58,17 +58,23 @@ bool AllocationTrackerNULL::updateMemoryAllocation(size_t oldSize, size_t newSiz
     return true;
 }
 
-ContextNULL::ContextNULL(const gl::ContextState &state, AllocationTrackerNULL *allocationTracker)
-    : ContextImpl(state), mAllocationTracker(allocationTracker)
+ContextNULL::ContextNULL(const gl::ContextState &state,
+                         AllocationTrackerNULL *allocationTracker,
+                         bool retainImageData)
+    : ContextImpl(state), mAllocationTracker(allocationTracker), mRetainImageData(retainImageData)
 {
     ASSERT(mAllocationTracker != nullptr);
 
     const gl::Version maxClientVersion(3, 1);
     mCaps        = GenerateMinimumCaps(maxClientVersion);
+    mCaps.programBinaryFormats.push_back(GL_PROGRAM_BINARY_ANGLE);
 
     mExtensions  = gl::Extensions();
     mExtensions.copyTexture           = true;
     mExtensions.copyCompressedTexture = true;
+    mExtensions.textureStorage        = true;
+    mExtensions.rgb8rgba8             = true;
+    mExtensions.getProgramBinary      = true;
 
     mTextureCaps = GenerateMinimumTextureCapsMap(maxClientVersion, mExtensions);
 }
@@ -310,12 +316,12 @@ FramebufferImpl *ContextNULL::createFramebuffer(const gl::FramebufferState &data
 
 TextureImpl *ContextNULL::createTexture(const gl::TextureState &state)
 {
-    return new TextureNULL(state);
+    return new TextureNULL(state, mRetainImageData ? mAllocationTracker : nullptr);
 }
 
 RenderbufferImpl *ContextNULL::createRenderbuffer()
 {
-    return new RenderbufferNULL();
+    return new RenderbufferNULL(mRetainImageData ? mAllocationTracker : nullptr);
 }
 
 BufferImpl *ContextNULL::createBuffer(const gl::BufferState &state)
@@ -33,7 +33,11 @@ class AllocationTrackerNULL : angle::NonCopyable
 class ContextNULL : public ContextImpl
 {
   public:
-    ContextNULL(const gl::ContextState &state, AllocationTrackerNULL *allocationTracker);
+    // When |retainImageData| is set, the textures and renderbuffers keep their data so that it
+    // can be uploaded, copied, blitted and read back like with a real device.
+    ContextNULL(const gl::ContextState &state,
+                AllocationTrackerNULL *allocationTracker,
+                bool retainImageData);
     ~ContextNULL() override;
 
     gl::Error initialize() override;
@@ -185,6 +189,7 @@ class ContextNULL : public ContextImpl
     gl::Limitations mLimitations;
 
     AllocationTrackerNULL *mAllocationTracker;
+    bool mRetainImageData;
 };
 
 }  // namespace rx
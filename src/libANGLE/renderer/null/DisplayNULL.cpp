@@ -11,6 +11,7 @@
 
 #include "common/debug.h"
 
+#include "libANGLE/Display.h"
 #include "libANGLE/renderer/null/ContextNULL.h"
 #include "libANGLE/renderer/null/DeviceNULL.h"
 #include "libANGLE/renderer/null/ImageNULL.h"
@@ -19,7 +20,8 @@
 namespace rx
 {
 
-DisplayNULL::DisplayNULL(const egl::DisplayState &state) : DisplayImpl(state), mDevice(nullptr)
+DisplayNULL::DisplayNULL(const egl::DisplayState &state)
+    : DisplayImpl(state), mDevice(nullptr), mRetainImageData(false)
 {
 }
 
@@ -34,6 +36,10 @@ egl::Error DisplayNULL::initialize(egl::Display *display)
     constexpr size_t kMaxTotalAllocationSize = 1 << 28;  // 256MB
     mAllocationTracker.reset(new AllocationTrackerNULL(kMaxTotalAllocationSize));
 
+    EGLint requestedDeviceType = static_cast<EGLint>(display->getAttributeMap().get(
+        EGL_PLATFORM_ANGLE_DEVICE_TYPE_ANGLE, EGL_PLATFORM_ANGLE_DEVICE_TYPE_HARDWARE_ANGLE));
+    mRetainImageData = requestedDeviceType == EGL_PLATFORM_ANGLE_DEVICE_TYPE_REFERENCE_ANGLE;
+
     return egl::NoError();
 }
 
@@ -173,7 +179,7 @@ ImageImpl *DisplayNULL::createImage(EGLenum target,
 
 ContextImpl *DisplayNULL::createContext(const gl::ContextState &state)
 {
-    return new ContextNULL(state, mAllocationTracker.get());
+    return new ContextNULL(state, mAllocationTracker.get(), mRetainImageData);
 }
 
 StreamProducerImpl *DisplayNULL::createStreamProducerD3DTextureNV12(
@@ -77,6 +77,9 @@ class DisplayNULL : public DisplayImpl
     DeviceImpl *mDevice;
 
     std::unique_ptr<AllocationTrackerNULL> mAllocationTracker;
+
+    // Set by the reference device type, which keeps the texture and renderbuffer data.
+    bool mRetainImageData;
 };
 
 }  // namespace rx
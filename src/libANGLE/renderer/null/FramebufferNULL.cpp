@@ -9,7 +9,11 @@
 
 #include "libANGLE/renderer/null/FramebufferNULL.h"
 
+#include "libANGLE/Buffer.h"
 #include "libANGLE/formatutils.h"
+#include "libANGLE/renderer/ContextImpl.h"
+#include "libANGLE/renderer/null/BufferNULL.h"
+#include "libANGLE/renderer/null/ShadowImageNULL.h"
 
 #include "common/debug.h"
 
@@ -111,6 +115,36 @@ gl::Error FramebufferNULL::readPixels(ContextImpl *context,
                                       GLenum type,
                                       GLvoid *pixels) const
 {
+    GLint layer                  = 0;
+    const ShadowImageNULL *image = GetAttachmentShadowImage(mState.getReadAttachment(), &layer);
+    if (image == nullptr)
+    {
+        return gl::NoError();
+    }
+
+    const gl::PixelPackState &packState = context->getGLState().getPackState();
+
+    GLenum sizedInternalFormat = gl::GetSizedInternalFormat(format, type);
+    const gl::InternalFormat &sizedFormatInfo = gl::GetInternalFormatInfo(sizedInternalFormat);
+
+    GLuint outputPitch = 0;
+    ANGLE_TRY_RESULT(
+        sizedFormatInfo.computeRowPitch(type, area.width, packState.alignment, packState.rowLength),
+        outputPitch);
+    GLuint outputSkipBytes = 0;
+    ANGLE_TRY_RESULT(sizedFormatInfo.computeSkipBytes(outputPitch, 0, packState, false),
+                     outputSkipBytes);
+
+    // The pixels are an offset into the pack buffer when one is bound.
+    uint8_t *destination = reinterpret_cast<uint8_t *>(pixels);
+    if (packState.pixelBuffer.get() != nullptr)
+    {
+        BufferNULL *bufferNULL = GetImplAs<BufferNULL>(packState.pixelBuffer.get());
+        destination = bufferNULL->getDataPtr() + reinterpret_cast<ptrdiff_t>(pixels);
+    }
+
+    image->readPixels(area, layer, format, type, outputPitch, packState,
+                      destination + outputSkipBytes);
     return gl::NoError();
 }
 
@@ -120,6 +154,49 @@ gl::Error FramebufferNULL::blit(ContextImpl *context,
                                 GLbitfield mask,
                                 GLenum filter)
 {
+    // The linear filter is approximated with the nearest one. Depth and stencil are blitted
+    // together when the images have both.
+    const auto &glState                      = context->getGLState();
+    const gl::Framebuffer *sourceFramebuffer = glState.getReadFramebuffer();
+    const gl::Rectangle *scissor = glState.isScissorTestEnabled() ? &glState.getScissor() : nullptr;
+
+    if ((mask & GL_COLOR_BUFFER_BIT) != 0)
+    {
+        GLint sourceLayer = 0;
+        const ShadowImageNULL *sourceImage =
+            GetAttachmentShadowImage(sourceFramebuffer->getReadColorbuffer(), &sourceLayer);
+        if (sourceImage != nullptr)
+        {
+            for (size_t drawBufferIndex = 0; drawBufferIndex < mState.getDrawBufferCount();
+                 ++drawBufferIndex)
+            {
+                GLint destLayer = 0;
+                ShadowImageNULL *destImage =
+                    GetAttachmentShadowImage(mState.getDrawBuffer(drawBufferIndex), &destLayer);
+                if (destImage != nullptr)
+                {
+                    destImage->blitFrom(*sourceImage, sourceLayer, sourceArea, destLayer, destArea,
+                                        scissor);
+                }
+            }
+        }
+    }
+
+    if ((mask & (GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT)) != 0)
+    {
+        GLint sourceLayer = 0;
+        const ShadowImageNULL *sourceImage = GetAttachmentShadowImage(
+            sourceFramebuffer->getDepthOrStencilbuffer(), &sourceLayer);
+        GLint destLayer = 0;
+        ShadowImageNULL *destImage =
+            GetAttachmentShadowImage(mState.getDepthOrStencilAttachment(), &destLayer);
+        if (sourceImage != nullptr && destImage != nullptr)
+        {
+            destImage->blitFrom(*sourceImage, sourceLayer, sourceArea, destLayer, destArea,
+                                scissor);
+        }
+    }
+
     return gl::NoError();
 }
 
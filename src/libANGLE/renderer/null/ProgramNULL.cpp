@@ -10,10 +10,64 @@
 #include "libANGLE/renderer/null/ProgramNULL.h"
 
 #include "common/debug.h"
+#include "common/utilities.h"
+#include "libANGLE/Program.h"
+#include "libANGLE/Shader.h"
 
 namespace rx
 {
 
+namespace
+{
+
+bool IsRowMajorLayout(const sh::InterfaceBlockField &var)
+{
+    return var.isRowMajorLayout;
+}
+
+bool IsRowMajorLayout(const sh::ShaderVariable &var)
+{
+    return false;
+}
+
+template <typename VarT>
+void GetUniformBlockInfo(const std::vector<VarT> &fields,
+                         const std::string &prefix,
+                         sh::BlockLayoutEncoder *encoder,
+                         bool inRowMajorLayout,
+                         std::map<std::string, sh::BlockMemberInfo> *blockInfoOut)
+{
+    for (const VarT &field : fields)
+    {
+        const std::string &fieldName = (prefix.empty() ? field.name : prefix + "." + field.name);
+
+        if (field.isStruct())
+        {
+            bool rowMajorLayout = (inRowMajorLayout || IsRowMajorLayout(field));
+
+            for (unsigned int arrayElement = 0; arrayElement < field.elementCount(); arrayElement++)
+            {
+                encoder->enterAggregateType();
+
+                const std::string uniformElementName =
+                    fieldName + (field.isArray() ? ArrayString(arrayElement) : "");
+                GetUniformBlockInfo(field.fields, uniformElementName, encoder, rowMajorLayout,
+                                    blockInfoOut);
+
+                encoder->exitAggregateType();
+            }
+        }
+        else
+        {
+            bool isRowMajorMatrix = (gl::IsMatrixType(field.type) && inRowMajorLayout);
+            (*blockInfoOut)[fieldName] =
+                encoder->encodeType(field.type, field.arraySize, isRowMajorMatrix);
+        }
+    }
+}
+
+}  // anonymous namespace
+
 ProgramNULL::ProgramNULL(const gl::ProgramState &state) : ProgramImpl(state)
 {
 }
@@ -46,6 +100,19 @@ LinkResult ProgramNULL::link(ContextImpl *contextImpl,
                              const gl::VaryingPacking &packing,
                              gl::InfoLog &infoLog)
 {
+    mBlockDataSizes.clear();
+    mBlockInfo.clear();
+
+    for (const gl::Shader *shader : {mState.getAttachedVertexShader(),
+                                     mState.getAttachedFragmentShader(),
+                                     mState.getAttachedComputeShader()})
+    {
+        if (shader != nullptr)
+        {
+            defineUniformBlocks(shader);
+        }
+    }
+
     return true;
 }
 
@@ -165,24 +232,51 @@ void ProgramNULL::setUniformMatrix4x3fv(GLint location,
 {
 }
 
+void ProgramNULL::syncUniforms(const gl::RangeUI &dirtyRange)
+{
+}
+
 void ProgramNULL::setUniformBlockBinding(GLuint uniformBlockIndex, GLuint uniformBlockBinding)
 {
 }
 
 bool ProgramNULL::getUniformBlockSize(const std::string &blockName, size_t *sizeOut) const
 {
-    // TODO(geofflang): Compute reasonable sizes?
-    *sizeOut = 0;
+    std::string baseName = blockName;
+    gl::ParseAndStripArrayIndex(&baseName);
+
+    // Every block is active, since nothing is optimized out.
+    auto sizeIter = mBlockDataSizes.find(baseName);
+    *sizeOut      = (sizeIter != mBlockDataSizes.end() ? sizeIter->second : 0);
     return true;
 }
 
 bool ProgramNULL::getUniformBlockMemberInfo(const std::string &memberUniformName,
                                             sh::BlockMemberInfo *memberInfoOut) const
 {
-    // TODO(geofflang): Compute reasonable values?
+    auto infoIter  = mBlockInfo.find(memberUniformName);
+    *memberInfoOut = (infoIter != mBlockInfo.end() ? infoIter->second
+                                                   : sh::BlockMemberInfo::getDefaultBlockInfo());
     return true;
 }
 
+void ProgramNULL::defineUniformBlocks(const gl::Shader *shader)
+{
+    // The shared and packed layouts can be laid out as std140.
+    for (const sh::InterfaceBlock &interfaceBlock : shader->getInterfaceBlocks())
+    {
+        if (mBlockDataSizes.count(interfaceBlock.name) > 0)
+        {
+            continue;
+        }
+
+        sh::Std140BlockEncoder encoder;
+        GetUniformBlockInfo(interfaceBlock.fields, interfaceBlock.fieldPrefix(), &encoder,
+                            interfaceBlock.isRowMajorLayout, &mBlockInfo);
+        mBlockDataSizes[interfaceBlock.name] = encoder.getBlockSize();
+    }
+}
+
 void ProgramNULL::setPathFragmentInputGen(const std::string &inputName,
                                           GLenum genMode,
                                           GLint components,
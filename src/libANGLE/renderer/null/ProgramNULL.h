@@ -10,6 +10,10 @@
 #ifndef LIBANGLE_RENDERER_NULL_PROGRAMNULL_H_
 #define LIBANGLE_RENDERER_NULL_PROGRAMNULL_H_
 
+#include <map>
+#include <string>
+
+#include "compiler/translator/blocklayout.h"
 #include "libANGLE/renderer/ProgramImpl.h"
 
 namespace rx
@@ -81,6 +85,7 @@ class ProgramNULL : public ProgramImpl
                                GLsizei count,
                                GLboolean transpose,
                                const GLfloat *value) override;
+    void syncUniforms(const gl::RangeUI &dirtyRange) override;
 
     // TODO: synchronize in syncState when dirty bits exist.
     void setUniformBlockBinding(GLuint uniformBlockIndex, GLuint uniformBlockBinding) override;
@@ -99,6 +104,13 @@ class ProgramNULL : public ProgramImpl
                                  GLenum genMode,
                                  GLint components,
                                  const GLfloat *coeffs) override;
+
+  private:
+    void defineUniformBlocks(const gl::Shader *shader);
+
+    // The std140 layout of the uniform blocks, which validation checks the bound buffers against.
+    std::map<std::string, size_t> mBlockDataSizes;
+    std::map<std::string, sh::BlockMemberInfo> mBlockInfo;
 };
 
 }  // namespace rx
@@ -10,12 +10,17 @@
 #include "libANGLE/renderer/null/RenderbufferNULL.h"
 
 #include "common/debug.h"
+#include "libANGLE/renderer/null/ShadowImageNULL.h"
 
 namespace rx
 {
 
-RenderbufferNULL::RenderbufferNULL() : RenderbufferImpl()
+RenderbufferNULL::RenderbufferNULL(AllocationTrackerNULL *allocationTracker) : RenderbufferImpl()
 {
+    if (allocationTracker != nullptr)
+    {
+        mShadowImage.reset(new ShadowImageNULL(allocationTracker));
+    }
 }
 
 RenderbufferNULL::~RenderbufferNULL()
@@ -24,7 +29,7 @@ RenderbufferNULL::~RenderbufferNULL()
 
 gl::Error RenderbufferNULL::setStorage(GLenum internalformat, size_t width, size_t height)
 {
-    return gl::NoError();
+    return setStorageMultisample(0, internalformat, width, height);
 }
 
 gl::Error RenderbufferNULL::setStorageMultisample(size_t samples,
@@ -32,11 +37,23 @@ gl::Error RenderbufferNULL::setStorageMultisample(size_t samples,
                                                   size_t width,
                                                   size_t height)
 {
+    if (mShadowImage)
+    {
+        // The samples are not emulated, the image is stored with one sample.
+        ANGLE_TRY(mShadowImage->redefine(
+            internalformat,
+            gl::Extents(static_cast<int>(width), static_cast<int>(height), 1)));
+    }
     return gl::NoError();
 }
 
 gl::Error RenderbufferNULL::setStorageEGLImageTarget(egl::Image *image)
 {
+    // The data of EGL images is not retained.
+    if (mShadowImage)
+    {
+        ANGLE_TRY(mShadowImage->redefine(GL_NONE, gl::Extents(0, 0, 0)));
+    }
     return gl::NoError();
 }
 
@@ -10,15 +10,21 @@
 #ifndef LIBANGLE_RENDERER_NULL_RENDERBUFFERNULL_H_
 #define LIBANGLE_RENDERER_NULL_RENDERBUFFERNULL_H_
 
+#include <memory>
+
 #include "libANGLE/renderer/RenderbufferImpl.h"
 
 namespace rx
 {
 
+class AllocationTrackerNULL;
+class ShadowImageNULL;
+
 class RenderbufferNULL : public RenderbufferImpl
 {
   public:
-    RenderbufferNULL();
+    // The renderbuffer data is only retained when it is given an allocation tracker.
+    explicit RenderbufferNULL(AllocationTrackerNULL *allocationTracker);
     ~RenderbufferNULL() override;
 
     gl::Error setStorage(GLenum internalformat, size_t width, size_t height) override;
@@ -27,6 +33,12 @@ class RenderbufferNULL : public RenderbufferImpl
                                     size_t width,
                                     size_t height) override;
     gl::Error setStorageEGLImageTarget(egl::Image *image) override;
+
+    // Returns nullptr when the data is not retained.
+    ShadowImageNULL *getShadowImage() const { return mShadowImage.get(); }
+
+  private:
+    std::unique_ptr<ShadowImageNULL> mShadowImage;
 };
 
 }  // namespace rx
@@ -29,7 +29,8 @@ ShCompileOptions ShaderNULL::prepareSourceAndReturnOptions(std::stringstream *so
     return 0;
 }
 
-bool ShaderNULL::postTranslateCompile(gl::Compiler *compiler, std::string *infoLog)
+bool ShaderNULL::postTranslateCompile(const gl::TranslatedShader &translatedShader,
+                                      std::string *infoLog)
 {
     return true;
 }
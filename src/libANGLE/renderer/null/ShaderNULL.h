@@ -25,7 +25,8 @@ class ShaderNULL : public ShaderImpl
     ShCompileOptions prepareSourceAndReturnOptions(std::stringstream *sourceStream,
                                                    std::string *sourcePath) override;
     // Returns success for compiling on the driver. Returns success.
-    bool postTranslateCompile(gl::Compiler *compiler, std::string *infoLog) override;
+    bool postTranslateCompile(const gl::TranslatedShader &translatedShader,
+                              std::string *infoLog) override;
 
     std::string getDebugInfo() const override;
 };
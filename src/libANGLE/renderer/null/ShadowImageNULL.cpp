@@ -0,0 +1,434 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ShadowImageNULL.cpp:
+//    Implements the class methods for ShadowImageNULL.
+//
+
+#include "libANGLE/renderer/null/ShadowImageNULL.h"
+
+#include <math.h>
+
+#include "common/debug.h"
+#include "common/mathutil.h"
+#include "libANGLE/FramebufferAttachment.h"
+#include "libANGLE/Renderbuffer.h"
+#include "libANGLE/Texture.h"
+#include "libANGLE/formatutils.h"
+#include "libANGLE/renderer/load_functions_table.h"
+#include "libANGLE/renderer/null/ContextNULL.h"
+#include "libANGLE/renderer/null/RenderbufferNULL.h"
+#include "libANGLE/renderer/null/TextureNULL.h"
+#include "libANGLE/renderer/renderer_utils.h"
+
+namespace rx
+{
+
+namespace
+{
+
+// Maps the columns or rows of a destination range to the source ones the nearest filter samples.
+// Returns the range of destination coordinates, clipped to |destMin| and |destMax|, whose samples
+// are within [0, sourceSize).
+void MapNearestSamples(GLint sourceStart,
+                       GLint sourceExtent,
+                       GLint destStart,
+                       GLint destExtent,
+                       GLint sourceSize,
+                       GLint destMin,
+                       GLint destMax,
+                       std::vector<GLint> *samples,
+                       GLint *firstOut,
+                       GLint *lastOut)
+{
+    ASSERT(destExtent > 0);
+
+    const GLint first = std::max(destStart, destMin);
+    const GLint last  = std::min(destStart + destExtent, destMax);
+
+    samples->clear();
+    *firstOut = first;
+    *lastOut  = first;
+
+    const double scale = static_cast<double>(sourceExtent) / static_cast<double>(destExtent);
+    for (GLint dest = first; dest < last; ++dest)
+    {
+        GLint sample = static_cast<GLint>(
+            floor(sourceStart + (static_cast<double>(dest - destStart) + 0.5) * scale));
+        if (sample < 0 || sample >= sourceSize)
+        {
+            // The samples are monotonic, so the ones in the source are contiguous.
+            if (samples->empty())
+            {
+                *firstOut = dest + 1;
+                continue;
+            }
+            break;
+        }
+        samples->push_back(sample);
+        *lastOut = dest + 1;
+    }
+}
+
+}  // anonymous namespace
+
+ShadowImageNULL::ShadowImageNULL(AllocationTrackerNULL *allocationTracker)
+    : mAllocationTracker(allocationTracker),
+      mInternalFormat(GL_NONE),
+      mFormatID(angle::Format::ID::NONE),
+      mSize(0, 0, 0),
+      mPixelBytes(0),
+      mBlockWidth(1),
+      mBlockHeight(1),
+      mRowPitch(0),
+      mDepthPitch(0)
+{
+    ASSERT(mAllocationTracker != nullptr);
+}
+
+ShadowImageNULL::~ShadowImageNULL()
+{
+    bool memoryReleaseResult = mAllocationTracker->updateMemoryAllocation(mData.size(), 0);
+    ASSERT(memoryReleaseResult);
+}
+
+gl::Error ShadowImageNULL::redefine(GLenum sizedInternalFormat, const gl::Extents &size)
+{
+    angle::Format::ID formatID = angle::GetLoadFormatID(sizedInternalFormat);
+
+    size_t pixelBytes  = 0;
+    GLuint blockWidth  = 1;
+    GLuint blockHeight = 1;
+    angle::CheckedNumeric<size_t> rowPitch   = 0;
+    angle::CheckedNumeric<size_t> depthPitch = 0;
+    angle::CheckedNumeric<size_t> dataSize   = 0;
+    if (formatID != angle::Format::ID::NONE)
+    {
+        const gl::InternalFormat &storageInfo =
+            gl::GetInternalFormatInfo(angle::Format::Get(formatID).glInternalFormat);
+        pixelBytes = storageInfo.pixelBytes;
+        if (storageInfo.compressed)
+        {
+            blockWidth  = storageInfo.compressedBlockWidth;
+            blockHeight = storageInfo.compressedBlockHeight;
+        }
+
+        rowPitch   = UnsignedCeilDivide(size.width, blockWidth);
+        rowPitch *= pixelBytes;
+        depthPitch = rowPitch * UnsignedCeilDivide(size.height, blockHeight);
+        dataSize   = depthPitch * size.depth;
+    }
+
+    if (!dataSize.IsValid() ||
+        !mAllocationTracker->updateMemoryAllocation(mData.size(), dataSize.ValueOrDie()))
+    {
+        return gl::OutOfMemory() << "Unable to allocate internal image storage.";
+    }
+
+    mInternalFormat = sizedInternalFormat;
+    mFormatID       = formatID;
+    mSize           = size;
+    mPixelBytes     = pixelBytes;
+    mBlockWidth     = blockWidth;
+    mBlockHeight    = blockHeight;
+    mRowPitch       = rowPitch.ValueOrDie();
+    mDepthPitch     = depthPitch.ValueOrDie();
+
+    // Releases the previous storage rather than zeroing it in place.
+    std::vector<uint8_t>(dataSize.ValueOrDie(), 0).swap(mData);
+
+    return gl::NoError();
+}
+
+gl::Error ShadowImageNULL::loadData(const gl::Box &area,
+                                    const gl::PixelUnpackState &unpack,
+                                    GLenum type,
+                                    const uint8_t *input,
+                                    bool applySkipImages)
+{
+    if (mData.empty() || area.width == 0 || area.height == 0 || area.depth == 0)
+    {
+        return gl::NoError();
+    }
+
+    const gl::InternalFormat &formatInfo = gl::GetInternalFormatInfo(mInternalFormat);
+    GLuint inputRowPitch                 = 0;
+    ANGLE_TRY_RESULT(
+        formatInfo.computeRowPitch(type, area.width, unpack.alignment, unpack.rowLength),
+        inputRowPitch);
+    GLuint inputDepthPitch = 0;
+    ANGLE_TRY_RESULT(formatInfo.computeDepthPitch(area.height, unpack.imageHeight, inputRowPitch),
+                     inputDepthPitch);
+    GLuint inputSkipBytes = 0;
+    ANGLE_TRY_RESULT(
+        formatInfo.computeSkipBytes(inputRowPitch, inputDepthPitch, unpack, applySkipImages),
+        inputSkipBytes);
+
+    LoadImageFunction loadFunction =
+        angle::GetLoadFunctionsMap(mInternalFormat, mFormatID)(type).loadFunction;
+    ASSERT(loadFunction != nullptr);
+
+    loadFunction(area.width, area.height, area.depth, input + inputSkipBytes, inputRowPitch,
+                 inputDepthPitch, getPixel(area.x, area.y, area.z), mRowPitch, mDepthPitch);
+
+    return gl::NoError();
+}
+
+gl::Error ShadowImageNULL::loadCompressedData(const gl::Box &area, const uint8_t *input)
+{
+    if (mData.empty() || area.width == 0 || area.height == 0 || area.depth == 0)
+    {
+        return gl::NoError();
+    }
+
+    const gl::InternalFormat &formatInfo = gl::GetInternalFormatInfo(mInternalFormat);
+    GLuint inputRowPitch                 = 0;
+    ANGLE_TRY_RESULT(formatInfo.computeRowPitch(GL_UNSIGNED_BYTE, area.width, 1, 0),
+                     inputRowPitch);
+    GLuint inputDepthPitch = 0;
+    ANGLE_TRY_RESULT(formatInfo.computeCompressedImageSize(
+                         GL_UNSIGNED_BYTE, gl::Extents(area.width, area.height, 1)),
+                     inputDepthPitch);
+
+    LoadImageFunction loadFunction =
+        angle::GetLoadFunctionsMap(mInternalFormat, mFormatID)(GL_UNSIGNED_BYTE).loadFunction;
+    ASSERT(loadFunction != nullptr);
+
+    loadFunction(area.width, area.height, area.depth, input, inputRowPitch, inputDepthPitch,
+                 getPixel(area.x, area.y, area.z), mRowPitch, mDepthPitch);
+
+    return gl::NoError();
+}
+
+void ShadowImageNULL::readPixels(const gl::Rectangle &area,
+                                 GLint layer,
+                                 GLenum format,
+                                 GLenum type,
+                                 GLuint outputPitch,
+                                 const gl::PixelPackState &pack,
+                                 uint8_t *pixels) const
+{
+    const gl::Rectangle imageArea(0, 0, mSize.width, mSize.height);
+    gl::Rectangle clippedArea;
+    if (mData.empty() || mBlockWidth > 1 || !gl::ClipRectangle(area, imageArea, &clippedArea))
+    {
+        return;
+    }
+
+    const angle::Format &storageFormat    = angle::Format::Get(mFormatID);
+    const gl::InternalFormat &storageInfo =
+        gl::GetInternalFormatInfo(storageFormat.glInternalFormat);
+    bool directCopy = storageInfo.format == format && storageInfo.type == type;
+    if (!directCopy && storageFormat.colorReadFunction == nullptr)
+    {
+        return;
+    }
+
+    const gl::InternalFormat &packInfo =
+        gl::GetInternalFormatInfo(gl::GetSizedInternalFormat(format, type));
+    ptrdiff_t offset = (clippedArea.y - area.y) * static_cast<ptrdiff_t>(outputPitch) +
+                       (clippedArea.x - area.x) * static_cast<ptrdiff_t>(packInfo.pixelBytes);
+    if (pack.reverseRowOrder)
+    {
+        offset = (area.y + area.height - clippedArea.y - clippedArea.height) *
+                     static_cast<ptrdiff_t>(outputPitch) +
+                 (clippedArea.x - area.x) * static_cast<ptrdiff_t>(packInfo.pixelBytes);
+    }
+
+    PackPixelsParams packParams(clippedArea, format, type, outputPitch, pack, offset);
+    PackPixels(packParams, storageFormat, static_cast<int>(mRowPitch),
+               getPixel(clippedArea.x, clippedArea.y, layer), pixels);
+}
+
+void ShadowImageNULL::blitFrom(const ShadowImageNULL &source,
+                               GLint sourceLayer,
+                               const gl::Rectangle &sourceArea,
+                               GLint destLayer,
+                               const gl::Rectangle &destArea,
+                               const gl::Rectangle *scissor)
+{
+    if (mData.empty() || source.mData.empty() || mBlockWidth > 1 || source.mBlockWidth > 1 ||
+        destArea.width == 0 || destArea.height == 0)
+    {
+        return;
+    }
+
+    // Flips the areas so that the destination one is not flipped.
+    gl::Rectangle flippedSource = sourceArea;
+    gl::Rectangle flippedDest   = destArea;
+    if (flippedDest.width < 0)
+    {
+        flippedDest.x += flippedDest.width;
+        flippedDest.width = -flippedDest.width;
+        flippedSource.x += flippedSource.width;
+        flippedSource.width = -flippedSource.width;
+    }
+    if (flippedDest.height < 0)
+    {
+        flippedDest.y += flippedDest.height;
+        flippedDest.height = -flippedDest.height;
+        flippedSource.y += flippedSource.height;
+        flippedSource.height = -flippedSource.height;
+    }
+
+    gl::Rectangle bounds(0, 0, mSize.width, mSize.height);
+    if (scissor != nullptr && !gl::ClipRectangle(bounds, *scissor, &bounds))
+    {
+        return;
+    }
+
+    std::vector<GLint> sourceColumns;
+    std::vector<GLint> sourceRows;
+    GLint firstColumn = 0;
+    GLint lastColumn  = 0;
+    GLint firstRow    = 0;
+    GLint lastRow     = 0;
+    MapNearestSamples(flippedSource.x, flippedSource.width, flippedDest.x, flippedDest.width,
+                      source.mSize.width, bounds.x, bounds.x + bounds.width, &sourceColumns,
+                      &firstColumn, &lastColumn);
+    MapNearestSamples(flippedSource.y, flippedSource.height, flippedDest.y, flippedDest.height,
+                      source.mSize.height, bounds.y, bounds.y + bounds.height, &sourceRows,
+                      &firstRow, &lastRow);
+    if (sourceColumns.empty() || sourceRows.empty())
+    {
+        return;
+    }
+
+    const GLint columnCount = lastColumn - firstColumn;
+
+    if (source.mFormatID == mFormatID)
+    {
+        bool contiguous = sourceColumns.back() - sourceColumns.front() + 1 == columnCount;
+        for (GLint row = firstRow; row < lastRow; ++row)
+        {
+            uint8_t *dest = getPixel(firstColumn, row, destLayer);
+            const GLint sourceRow = sourceRows[row - firstRow];
+            if (contiguous)
+            {
+                memcpy(dest, source.getPixel(sourceColumns.front(), sourceRow, sourceLayer),
+                       columnCount * mPixelBytes);
+                continue;
+            }
+            for (GLint column = 0; column < columnCount; ++column)
+            {
+                memcpy(dest + column * mPixelBytes,
+                       source.getPixel(sourceColumns[column], sourceRow, sourceLayer),
+                       mPixelBytes);
+            }
+        }
+        return;
+    }
+
+    // The pixels are converted to the type the internal format of this image is specified with,
+    // and loaded like uploaded rows. Depth and stencil can only be blitted between equal formats.
+    const angle::Format &sourceFormat = angle::Format::Get(source.mFormatID);
+    const gl::InternalFormat &destInfo = gl::GetInternalFormatInfo(mInternalFormat);
+    if (sourceFormat.colorReadFunction == nullptr || destInfo.depthBits > 0 ||
+        destInfo.stencilBits > 0)
+    {
+        return;
+    }
+
+    ColorWriteFunction colorWriteFunction =
+        GetColorWriteFunction(gl::FormatType(destInfo.format, destInfo.type));
+    LoadImageFunction loadFunction =
+        angle::GetLoadFunctionsMap(mInternalFormat, mFormatID)(destInfo.type).loadFunction;
+    if (colorWriteFunction == nullptr || loadFunction == nullptr)
+    {
+        return;
+    }
+
+    const size_t convertedPixelBytes = destInfo.computePixelBytes(destInfo.type);
+    const size_t convertedRowPitch   = convertedPixelBytes * columnCount;
+    std::vector<uint8_t> convertedRow(convertedRowPitch);
+
+    // Maximum size of any Color<T> type used.
+    uint8_t color[16];
+    static_assert(sizeof(color) >= sizeof(gl::ColorF) && sizeof(color) >= sizeof(gl::ColorUI) &&
+                      sizeof(color) >= sizeof(gl::ColorI),
+                  "Unexpected size of gl::Color struct.");
+
+    for (GLint row = firstRow; row < lastRow; ++row)
+    {
+        const GLint sourceRow = sourceRows[row - firstRow];
+        for (GLint column = 0; column < columnCount; ++column)
+        {
+            sourceFormat.colorReadFunction(
+                source.getPixel(sourceColumns[column], sourceRow, sourceLayer), color);
+            colorWriteFunction(color, convertedRow.data() + column * convertedPixelBytes);
+        }
+        loadFunction(columnCount, 1, 1, convertedRow.data(), convertedRowPitch, convertedRowPitch,
+                     getPixel(firstColumn, row, destLayer), mRowPitch, mDepthPitch);
+    }
+}
+
+void ShadowImageNULL::generateMipFrom(const ShadowImageNULL &source)
+{
+    ASSERT(source.mFormatID == mFormatID);
+
+    MipGenerationFunction mipFunction = angle::Format::Get(mFormatID).mipGenerationFunction;
+    if (mData.empty() || source.mData.empty() || mipFunction == nullptr)
+    {
+        return;
+    }
+
+    // The layers of array textures are not reduced.
+    if (source.mSize.depth == mSize.depth)
+    {
+        for (GLint layer = 0; layer < mSize.depth; ++layer)
+        {
+            mipFunction(source.mSize.width, source.mSize.height, 1, source.getPixel(0, 0, layer),
+                        source.mRowPitch, source.mDepthPitch, getPixel(0, 0, layer), mRowPitch,
+                        mDepthPitch);
+        }
+        return;
+    }
+
+    mipFunction(source.mSize.width, source.mSize.height, source.mSize.depth, source.mData.data(),
+                source.mRowPitch, source.mDepthPitch, mData.data(), mRowPitch, mDepthPitch);
+}
+
+const uint8_t *ShadowImageNULL::getPixel(GLint x, GLint y, GLint layer) const
+{
+    ASSERT(x >= 0 && x < std::max(mSize.width, 1) && y >= 0 && y < std::max(mSize.height, 1));
+    ASSERT(layer >= 0 && layer < std::max(mSize.depth, 1));
+    return mData.data() + (x / mBlockWidth) * mPixelBytes + (y / mBlockHeight) * mRowPitch +
+           layer * mDepthPitch;
+}
+
+uint8_t *ShadowImageNULL::getPixel(GLint x, GLint y, GLint layer)
+{
+    return const_cast<uint8_t *>(static_cast<const ShadowImageNULL *>(this)->getPixel(x, y, layer));
+}
+
+ShadowImageNULL *GetAttachmentShadowImage(const gl::FramebufferAttachment *attachment,
+                                          GLint *layerOut)
+{
+    *layerOut = 0;
+    if (attachment == nullptr)
+    {
+        return nullptr;
+    }
+
+    switch (attachment->type())
+    {
+        case GL_TEXTURE:
+        {
+            const gl::ImageIndex &index = attachment->getTextureImageIndex();
+            if (index.is3D())
+            {
+                *layerOut = index.layerIndex;
+            }
+            TextureNULL *textureNULL = GetImplAs<TextureNULL>(attachment->getTexture());
+            return textureNULL->getShadowImage(index.type, index.mipIndex);
+        }
+        case GL_RENDERBUFFER:
+            return GetImplAs<RenderbufferNULL>(attachment->getRenderbuffer())->getShadowImage();
+        default:
+            return nullptr;
+    }
+}
+
+}  // namespace rx
@@ -0,0 +1,101 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ShadowImageNULL.h:
+//    Defines the class interface for ShadowImageNULL, the CPU copy of an image the NULL back-end
+//    keeps when it is asked to retain the texture and renderbuffer data.
+//
+
+#ifndef LIBANGLE_RENDERER_NULL_SHADOWIMAGENULL_H_
+#define LIBANGLE_RENDERER_NULL_SHADOWIMAGENULL_H_
+
+#include <vector>
+
+#include "libANGLE/Error.h"
+#include "libANGLE/angletypes.h"
+#include "libANGLE/renderer/Format.h"
+
+namespace gl
+{
+class FramebufferAttachment;
+}
+
+namespace rx
+{
+
+class AllocationTrackerNULL;
+
+// The data of one mip level of one texture target or of a renderbuffer, stored tightly packed in
+// the ANGLE format the back-ends would load the internal format into. The layers of 3D and array
+// textures are the slices of the image.
+class ShadowImageNULL : angle::NonCopyable
+{
+  public:
+    explicit ShadowImageNULL(AllocationTrackerNULL *allocationTracker);
+    ~ShadowImageNULL();
+
+    // Replaces the storage with zeroed storage for an image of |sizedInternalFormat|.
+    gl::Error redefine(GLenum sizedInternalFormat, const gl::Extents &size);
+
+    gl::Error loadData(const gl::Box &area,
+                       const gl::PixelUnpackState &unpack,
+                       GLenum type,
+                       const uint8_t *input,
+                       bool applySkipImages);
+    gl::Error loadCompressedData(const gl::Box &area, const uint8_t *input);
+
+    // Packs |area| of a layer into |pixels|, which has rows of |outputPitch| bytes. The part of the
+    // area outside the image is left untouched.
+    void readPixels(const gl::Rectangle &area,
+                    GLint layer,
+                    GLenum format,
+                    GLenum type,
+                    GLuint outputPitch,
+                    const gl::PixelPackState &pack,
+                    uint8_t *pixels) const;
+
+    // Copies |sourceArea| of a layer of |source| to |destArea| of a layer of this image with the
+    // nearest filter, converting the pixels when the formats differ. The areas may be flipped.
+    void blitFrom(const ShadowImageNULL &source,
+                  GLint sourceLayer,
+                  const gl::Rectangle &sourceArea,
+                  GLint destLayer,
+                  const gl::Rectangle &destArea,
+                  const gl::Rectangle *scissor);
+
+    // Generates this image as the next mip of |source|, which has the same format.
+    void generateMipFrom(const ShadowImageNULL &source);
+
+    GLenum getInternalFormat() const { return mInternalFormat; }
+    const gl::Extents &getSize() const { return mSize; }
+
+  private:
+    const uint8_t *getPixel(GLint x, GLint y, GLint layer) const;
+    uint8_t *getPixel(GLint x, GLint y, GLint layer);
+
+    AllocationTrackerNULL *mAllocationTracker;
+
+    GLenum mInternalFormat;
+    angle::Format::ID mFormatID;
+    gl::Extents mSize;
+
+    // The bytes of a pixel, or of a block of a compressed format.
+    size_t mPixelBytes;
+    GLuint mBlockWidth;
+    GLuint mBlockHeight;
+    size_t mRowPitch;
+    size_t mDepthPitch;
+
+    std::vector<uint8_t> mData;
+};
+
+// Returns the shadow image of a texture or renderbuffer attachment, and the layer of it the
+// attachment uses. Returns nullptr when the attachment has no shadow image.
+ShadowImageNULL *GetAttachmentShadowImage(const gl::FramebufferAttachment *attachment,
+                                          GLint *layerOut);
+
+}  // namespace rx
+
+#endif  // LIBANGLE_RENDERER_NULL_SHADOWIMAGENULL_H_
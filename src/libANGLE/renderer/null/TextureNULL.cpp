@@ -10,11 +10,40 @@
 #include "libANGLE/renderer/null/TextureNULL.h"
 
 #include "common/debug.h"
+#include "common/utilities.h"
+#include "libANGLE/Buffer.h"
+#include "libANGLE/Framebuffer.h"
+#include "libANGLE/formatutils.h"
+#include "libANGLE/renderer/null/BufferNULL.h"
+#include "libANGLE/renderer/null/ShadowImageNULL.h"
 
 namespace rx
 {
 
-TextureNULL::TextureNULL(const gl::TextureState &state) : TextureImpl(state)
+namespace
+{
+
+const uint8_t *GetUnpackPointer(const gl::PixelUnpackState &unpack, const uint8_t *pixels)
+{
+    if (unpack.pixelBuffer.get() != nullptr)
+    {
+        // The pixels are an offset into the unpack buffer.
+        const BufferNULL *bufferNULL = GetImplAs<BufferNULL>(unpack.pixelBuffer.get());
+        return bufferNULL->getDataPtr() + reinterpret_cast<ptrdiff_t>(pixels);
+    }
+
+    return pixels;
+}
+
+bool IsLayeredTarget(GLenum target)
+{
+    return target == GL_TEXTURE_3D || target == GL_TEXTURE_2D_ARRAY;
+}
+
+}  // anonymous namespace
+
+TextureNULL::TextureNULL(const gl::TextureState &state, AllocationTrackerNULL *allocationTracker)
+    : TextureImpl(state), mAllocationTracker(allocationTracker)
 {
 }
 
@@ -34,6 +63,21 @@ gl::Error TextureNULL::setImage(ContextImpl *contextImpl,
 {
     // TODO(geofflang): Read all incoming pixel data (maybe hash it?) to make sure we don't read out
     // of bounds due to validation bugs.
+    if (mAllocationTracker == nullptr)
+    {
+        return gl::NoError();
+    }
+
+    ShadowImageNULL *image = nullptr;
+    ANGLE_TRY(redefineShadowImage(target, level, gl::GetSizedInternalFormat(internalFormat, type),
+                                  size, &image));
+
+    const uint8_t *pixelData = GetUnpackPointer(unpack, pixels);
+    if (pixelData != nullptr)
+    {
+        ANGLE_TRY(image->loadData(gl::Box(0, 0, 0, size.width, size.height, size.depth), unpack,
+                                  type, pixelData, IsLayeredTarget(target)));
+    }
     return gl::NoError();
 }
 
@@ -46,6 +90,12 @@ gl::Error TextureNULL::setSubImage(ContextImpl *contextImpl,
                                    const gl::PixelUnpackState &unpack,
                                    const uint8_t *pixels)
 {
+    ShadowImageNULL *image   = getShadowImage(target, level);
+    const uint8_t *pixelData = GetUnpackPointer(unpack, pixels);
+    if (image != nullptr && pixelData != nullptr)
+    {
+        ANGLE_TRY(image->loadData(area, unpack, type, pixelData, IsLayeredTarget(target)));
+    }
     return gl::NoError();
 }
 
@@ -58,6 +108,20 @@ gl::Error TextureNULL::setCompressedImage(ContextImpl *contextImpl,
                                           size_t imageSize,
                                           const uint8_t *pixels)
 {
+    if (mAllocationTracker == nullptr)
+    {
+        return gl::NoError();
+    }
+
+    ShadowImageNULL *image = nullptr;
+    ANGLE_TRY(redefineShadowImage(target, level, internalFormat, size, &image));
+
+    const uint8_t *pixelData = GetUnpackPointer(unpack, pixels);
+    if (pixelData != nullptr)
+    {
+        ANGLE_TRY(image->loadCompressedData(
+            gl::Box(0, 0, 0, size.width, size.height, size.depth), pixelData));
+    }
     return gl::NoError();
 }
 
@@ -70,6 +134,12 @@ gl::Error TextureNULL::setCompressedSubImage(ContextImpl *contextImpl,
                                              size_t imageSize,
                                              const uint8_t *pixels)
 {
+    ShadowImageNULL *image   = getShadowImage(target, level);
+    const uint8_t *pixelData = GetUnpackPointer(unpack, pixels);
+    if (image != nullptr && pixelData != nullptr)
+    {
+        ANGLE_TRY(image->loadCompressedData(area, pixelData));
+    }
     return gl::NoError();
 }
 
@@ -80,6 +150,25 @@ gl::Error TextureNULL::copyImage(ContextImpl *contextImpl,
                                  GLenum internalFormat,
                                  const gl::Framebuffer *source)
 {
+    if (mAllocationTracker == nullptr)
+    {
+        return gl::NoError();
+    }
+
+    GLenum sizedInternalFormat =
+        gl::GetSizedInternalFormat(internalFormat, source->getImplementationColorReadType());
+    ShadowImageNULL *image = nullptr;
+    ANGLE_TRY(redefineShadowImage(target, level, sizedInternalFormat,
+                                  gl::Extents(sourceArea.width, sourceArea.height, 1), &image));
+
+    GLint sourceLayer = 0;
+    const ShadowImageNULL *sourceImage =
+        GetAttachmentShadowImage(source->getReadColorbuffer(), &sourceLayer);
+    if (sourceImage != nullptr)
+    {
+        image->blitFrom(*sourceImage, sourceLayer, sourceArea, 0,
+                        gl::Rectangle(0, 0, sourceArea.width, sourceArea.height), nullptr);
+    }
     return gl::NoError();
 }
 
@@ -90,6 +179,17 @@ gl::Error TextureNULL::copySubImage(ContextImpl *contextImpl,
                                     const gl::Rectangle &sourceArea,
                                     const gl::Framebuffer *source)
 {
+    ShadowImageNULL *image = getShadowImage(target, level);
+    GLint sourceLayer      = 0;
+    const ShadowImageNULL *sourceImage =
+        GetAttachmentShadowImage(source->getReadColorbuffer(), &sourceLayer);
+    if (image != nullptr && sourceImage != nullptr)
+    {
+        image->blitFrom(
+            *sourceImage, sourceLayer, sourceArea, destOffset.z,
+            gl::Rectangle(destOffset.x, destOffset.y, sourceArea.width, sourceArea.height),
+            nullptr);
+    }
     return gl::NoError();
 }
 
@@ -99,11 +199,38 @@ gl::Error TextureNULL::setStorage(ContextImpl *contextImpl,
                                   GLenum internalFormat,
                                   const gl::Extents &size)
 {
+    if (mAllocationTracker == nullptr)
+    {
+        return gl::NoError();
+    }
+
+    mShadowImages.clear();
+    for (size_t level = 0; level < levels; ++level)
+    {
+        gl::Extents levelSize(std::max(size.width >> level, 1), std::max(size.height >> level, 1),
+                              target == GL_TEXTURE_3D ? std::max(size.depth >> level, 1)
+                                                      : size.depth);
+        ShadowImageNULL *image = nullptr;
+        if (target == GL_TEXTURE_CUBE_MAP)
+        {
+            for (GLenum face = gl::FirstCubeMapTextureTarget; face <= gl::LastCubeMapTextureTarget;
+                 ++face)
+            {
+                ANGLE_TRY(redefineShadowImage(face, level, internalFormat, levelSize, &image));
+            }
+        }
+        else
+        {
+            ANGLE_TRY(redefineShadowImage(target, level, internalFormat, levelSize, &image));
+        }
+    }
     return gl::NoError();
 }
 
 gl::Error TextureNULL::setEGLImageTarget(GLenum target, egl::Image *image)
 {
+    // The data of EGL images is not retained.
+    mShadowImages.clear();
     return gl::NoError();
 }
 
@@ -116,6 +243,41 @@ gl::Error TextureNULL::setImageExternal(GLenum target,
 
 gl::Error TextureNULL::generateMipmap(ContextImpl *contextImpl)
 {
+    if (mAllocationTracker == nullptr)
+    {
+        return gl::NoError();
+    }
+
+    const GLuint baseLevel = mState.getEffectiveBaseLevel();
+    const GLuint maxLevel  = mState.getMipmapMaxLevel();
+
+    const GLenum textureTarget = mState.getTarget();
+    const GLenum firstTarget =
+        textureTarget == GL_TEXTURE_CUBE_MAP ? gl::FirstCubeMapTextureTarget : textureTarget;
+    const GLenum lastTarget =
+        textureTarget == GL_TEXTURE_CUBE_MAP ? gl::LastCubeMapTextureTarget : textureTarget;
+
+    for (GLenum target = firstTarget; target <= lastTarget; ++target)
+    {
+        for (GLuint level = baseLevel + 1; level <= maxLevel; ++level)
+        {
+            const ShadowImageNULL *sourceImage = getShadowImage(target, level - 1);
+            if (sourceImage == nullptr)
+            {
+                break;
+            }
+
+            const gl::Extents &sourceSize = sourceImage->getSize();
+            gl::Extents levelSize(std::max(sourceSize.width >> 1, 1),
+                                  std::max(sourceSize.height >> 1, 1),
+                                  target == GL_TEXTURE_3D ? std::max(sourceSize.depth >> 1, 1)
+                                                          : sourceSize.depth);
+            ShadowImageNULL *image = nullptr;
+            ANGLE_TRY(redefineShadowImage(target, level, sourceImage->getInternalFormat(),
+                                          levelSize, &image));
+            image->generateMipFrom(*sourceImage);
+        }
+    }
     return gl::NoError();
 }
 
@@ -125,6 +287,8 @@ void TextureNULL::setBaseLevel(GLuint baseLevel)
 
 void TextureNULL::bindTexImage(egl::Surface *surface)
 {
+    // The data of surfaces is not retained.
+    mShadowImages.clear();
 }
 
 void TextureNULL::releaseTexImage()
@@ -142,6 +306,40 @@ gl::Error TextureNULL::setStorageMultisample(ContextImpl *contextImpl,
                                              const gl::Extents &size,
                                              GLboolean fixedSampleLocations)
 {
+    if (mAllocationTracker == nullptr)
+    {
+        return gl::NoError();
+    }
+
+    // The samples are not emulated, the image is stored with one sample.
+    ShadowImageNULL *image = nullptr;
+    return redefineShadowImage(target, 0, internalformat, size, &image);
+}
+
+ShadowImageNULL *TextureNULL::getShadowImage(GLenum target, size_t level) const
+{
+    auto imageIter =
+        mShadowImages.find(gl::ImageIndex::MakeGeneric(target, static_cast<GLint>(level)));
+    return imageIter != mShadowImages.end() ? imageIter->second.get() : nullptr;
+}
+
+gl::Error TextureNULL::redefineShadowImage(GLenum target,
+                                           size_t level,
+                                           GLenum sizedInternalFormat,
+                                           const gl::Extents &size,
+                                           ShadowImageNULL **imageOut)
+{
+    ASSERT(mAllocationTracker != nullptr);
+
+    std::unique_ptr<ShadowImageNULL> &image =
+        mShadowImages[gl::ImageIndex::MakeGeneric(target, static_cast<GLint>(level))];
+    if (!image)
+    {
+        image.reset(new ShadowImageNULL(mAllocationTracker));
+    }
+    ANGLE_TRY(image->redefine(sizedInternalFormat, size));
+
+    *imageOut = image.get();
     return gl::NoError();
 }
 
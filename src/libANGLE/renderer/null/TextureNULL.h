@@ -10,15 +10,23 @@
 #ifndef LIBANGLE_RENDERER_NULL_TEXTURENULL_H_
 #define LIBANGLE_RENDERER_NULL_TEXTURENULL_H_
 
+#include <map>
+#include <memory>
+
+#include "libANGLE/ImageIndex.h"
 #include "libANGLE/renderer/TextureImpl.h"
 
 namespace rx
 {
 
+class AllocationTrackerNULL;
+class ShadowImageNULL;
+
 class TextureNULL : public TextureImpl
 {
   public:
-    TextureNULL(const gl::TextureState &state);
+    // The texture data is only retained when it is given an allocation tracker.
+    TextureNULL(const gl::TextureState &state, AllocationTrackerNULL *allocationTracker);
     ~TextureNULL() override;
 
     gl::Error setImage(ContextImpl *contextImpl,
@@ -96,6 +104,19 @@ class TextureNULL : public TextureImpl
                                     GLint internalformat,
                                     const gl::Extents &size,
                                     GLboolean fixedSampleLocations) override;
+
+    // Returns nullptr when the image is not defined or its data is not retained.
+    ShadowImageNULL *getShadowImage(GLenum target, size_t level) const;
+
+  private:
+    gl::Error redefineShadowImage(GLenum target,
+                                  size_t level,
+                                  GLenum sizedInternalFormat,
+                                  const gl::Extents &size,
+                                  ShadowImageNULL **imageOut);
+
+    AllocationTrackerNULL *mAllocationTracker;
+    std::map<gl::ImageIndex, std::unique_ptr<ShadowImageNULL>> mShadowImages;
 };
 
 }  // namespace rx
@@ -16,6 +16,8 @@
 #include "libANGLE/renderer/Format.h"
 
 #include <string.h>
+#include <algorithm>
+#include <vector>
 
 namespace rx
 {
@@ -147,6 +149,173 @@ static FormatWriteFunctionMap BuildFormatWriteFunctionMap()
 
     return map;
 }
+
+// Below this number of pixels, decoding a tile takes about as long as posting its task.
+constexpr size_t kMinPixelsPerLoadTile = 128 * 1024;
+
+// The part of a compressed image load that a tile decodes: rows of blocks [firstBlockRow,
+// lastBlockRow), counted through the slices of the image.
+class LoadImageTileTask : public angle::Closure
+{
+  public:
+    LoadImageTileTask(LoadImageFunction loadFunction,
+                      size_t width,
+                      size_t height,
+                      size_t inputBlockHeight,
+                      const uint8_t *input,
+                      size_t inputRowPitch,
+                      size_t inputDepthPitch,
+                      size_t outputBlockHeight,
+                      uint8_t *output,
+                      size_t outputRowPitch,
+                      size_t outputDepthPitch,
+                      size_t firstBlockRow,
+                      size_t lastBlockRow)
+        : mLoadFunction(loadFunction),
+          mWidth(width),
+          mHeight(height),
+          mInputBlockHeight(inputBlockHeight),
+          mInput(input),
+          mInputRowPitch(inputRowPitch),
+          mInputDepthPitch(inputDepthPitch),
+          mOutputBlockHeight(outputBlockHeight),
+          mOutput(output),
+          mOutputRowPitch(outputRowPitch),
+          mOutputDepthPitch(outputDepthPitch),
+          mFirstBlockRow(firstBlockRow),
+          mLastBlockRow(lastBlockRow)
+    {
+    }
+
+    void operator()() override
+    {
+        const size_t blockRowsPerSlice = (mHeight + mInputBlockHeight - 1) / mInputBlockHeight;
+
+        size_t blockRow = mFirstBlockRow;
+        while (blockRow < mLastBlockRow)
+        {
+            const size_t z             = blockRow / blockRowsPerSlice;
+            const size_t sliceFirstRow = blockRow - z * blockRowsPerSlice;
+            const size_t sliceLastRow =
+                std::min(mLastBlockRow - z * blockRowsPerSlice, blockRowsPerSlice);
+
+            const size_t y      = sliceFirstRow * mInputBlockHeight;
+            const size_t height = std::min(sliceLastRow * mInputBlockHeight, mHeight) - y;
+            ASSERT(y % mOutputBlockHeight == 0);
+
+            const uint8_t *input = mInput + z * mInputDepthPitch + sliceFirstRow * mInputRowPitch;
+            uint8_t *output =
+                mOutput + z * mOutputDepthPitch + (y / mOutputBlockHeight) * mOutputRowPitch;
+            mLoadFunction(mWidth, height, 1, input, mInputRowPitch, mInputDepthPitch, output,
+                          mOutputRowPitch, mOutputDepthPitch);
+
+            blockRow = z * blockRowsPerSlice + sliceLastRow;
+        }
+    }
+
+  private:
+    LoadImageFunction mLoadFunction;
+    size_t mWidth;
+    size_t mHeight;
+    size_t mInputBlockHeight;
+    const uint8_t *mInput;
+    size_t mInputRowPitch;
+    size_t mInputDepthPitch;
+    size_t mOutputBlockHeight;
+    uint8_t *mOutput;
+    size_t mOutputRowPitch;
+    size_t mOutputDepthPitch;
+    size_t mFirstBlockRow;
+    size_t mLastBlockRow;
+};
+
+// Averaging pixels is much cheaper than decoding them, so the mip tiles are larger.
+constexpr size_t kMinPixelsPerMipTile = 512 * 1024;
+
+// The part of a mip that a tile generates: its rows [firstRow, lastRow) when the source is a 2D
+// image, and its slices when it is a 3D image.
+class GenerateMipTileTask : public angle::Closure
+{
+  public:
+    GenerateMipTileTask(MipGenerationFunction mipFunction,
+                        size_t sourceWidth,
+                        size_t sourceHeight,
+                        size_t sourceDepth,
+                        const uint8_t *sourceData,
+                        size_t sourceRowPitch,
+                        size_t sourceDepthPitch,
+                        uint8_t *destData,
+                        size_t destRowPitch,
+                        size_t destDepthPitch,
+                        size_t firstRow,
+                        size_t lastRow)
+        : mMipFunction(mipFunction),
+          mSourceWidth(sourceWidth),
+          mSourceHeight(sourceHeight),
+          mSourceDepth(sourceDepth),
+          mSourceData(sourceData),
+          mSourceRowPitch(sourceRowPitch),
+          mSourceDepthPitch(sourceDepthPitch),
+          mDestData(destData),
+          mDestRowPitch(destRowPitch),
+          mDestDepthPitch(destDepthPitch),
+          mFirstRow(firstRow),
+          mLastRow(lastRow)
+    {
+    }
+
+    void operator()() override
+    {
+        // Each row or slice of the mip averages two of the source, which keeps the dimension the
+        // tile is cut along larger than one and the mip function the same as for the whole image.
+        const size_t rowCount = mLastRow - mFirstRow;
+        if (mSourceDepth > 1)
+        {
+            mMipFunction(mSourceWidth, mSourceHeight, rowCount * 2,
+                         mSourceData + mFirstRow * 2 * mSourceDepthPitch, mSourceRowPitch,
+                         mSourceDepthPitch, mDestData + mFirstRow * mDestDepthPitch,
+                         mDestRowPitch, mDestDepthPitch);
+        }
+        else
+        {
+            mMipFunction(mSourceWidth, rowCount * 2, 1,
+                         mSourceData + mFirstRow * 2 * mSourceRowPitch, mSourceRowPitch,
+                         mSourceDepthPitch, mDestData + mFirstRow * mDestRowPitch, mDestRowPitch,
+                         mDestDepthPitch);
+        }
+    }
+
+  private:
+    MipGenerationFunction mMipFunction;
+    size_t mSourceWidth;
+    size_t mSourceHeight;
+    size_t mSourceDepth;
+    const uint8_t *mSourceData;
+    size_t mSourceRowPitch;
+    size_t mSourceDepthPitch;
+    uint8_t *mDestData;
+    size_t mDestRowPitch;
+    size_t mDestDepthPitch;
+    size_t mFirstRow;
+    size_t mLastRow;
+};
+
+// Runs the tiles, the first one on the calling thread while the workers run the others.
+template <typename TileTask>
+void RunTiles(angle::WorkerThreadPool *workerPool, std::vector<TileTask> *tiles)
+{
+    std::vector<angle::WaitableEvent> waitEvents;
+    waitEvents.reserve(tiles->size() - 1);
+    for (size_t tileIndex = 1; tileIndex < tiles->size(); ++tileIndex)
+    {
+        waitEvents.push_back(workerPool->postWorkerTask(&(*tiles)[tileIndex]));
+    }
+    (*tiles)[0]();
+    for (angle::WaitableEvent &waitEvent : waitEvents)
+    {
+        waitEvent.wait();
+    }
+}
 }  // anonymous namespace
 
 PackPixelsParams::PackPixelsParams()
@@ -271,6 +440,81 @@ ColorCopyFunction GetFastCopyFunction(const FastCopyFunctionMap &fastCopyFunctio
     return fastCopyFunctions.get(formatType);
 }
 
+void LoadCompressedImageInTiles(angle::WorkerThreadPool *workerPool,
+                                LoadImageFunction loadFunction,
+                                size_t width,
+                                size_t height,
+                                size_t depth,
+                                size_t inputBlockHeight,
+                                const uint8_t *input,
+                                size_t inputRowPitch,
+                                size_t inputDepthPitch,
+                                size_t outputBlockHeight,
+                                uint8_t *output,
+                                size_t outputRowPitch,
+                                size_t outputDepthPitch)
+{
+    const size_t blockRows = ((height + inputBlockHeight - 1) / inputBlockHeight) * depth;
+    const size_t tileCount =
+        std::min(std::min(workerPool->getMaxThreads(), blockRows),
+                 width * height * depth / kMinPixelsPerLoadTile);
+    if (tileCount <= 1)
+    {
+        loadFunction(width, height, depth, input, inputRowPitch, inputDepthPitch, output,
+                     outputRowPitch, outputDepthPitch);
+        return;
+    }
+
+    std::vector<LoadImageTileTask> tiles;
+    tiles.reserve(tileCount);
+    for (size_t tileIndex = 0; tileIndex < tileCount; ++tileIndex)
+    {
+        tiles.emplace_back(loadFunction, width, height, inputBlockHeight, input, inputRowPitch,
+                           inputDepthPitch, outputBlockHeight, output, outputRowPitch,
+                           outputDepthPitch, blockRows * tileIndex / tileCount,
+                           blockRows * (tileIndex + 1) / tileCount);
+    }
+
+    RunTiles(workerPool, &tiles);
+}
+
+void GenerateMipInTiles(angle::WorkerThreadPool *workerPool,
+                        MipGenerationFunction mipFunction,
+                        size_t sourceWidth,
+                        size_t sourceHeight,
+                        size_t sourceDepth,
+                        const uint8_t *sourceData,
+                        size_t sourceRowPitch,
+                        size_t sourceDepthPitch,
+                        uint8_t *destData,
+                        size_t destRowPitch,
+                        size_t destDepthPitch)
+{
+    // The tiles are cut along the depth of 3D images, and along the height of 2D ones.
+    const size_t rows       = sourceDepth > 1 ? sourceDepth / 2 : sourceHeight / 2;
+    const size_t pixelCount = sourceWidth * sourceHeight * sourceDepth;
+    const size_t tileCount  = std::min(std::min(workerPool->getMaxThreads(), rows),
+                                       pixelCount / kMinPixelsPerMipTile);
+    if (tileCount <= 1)
+    {
+        mipFunction(sourceWidth, sourceHeight, sourceDepth, sourceData, sourceRowPitch,
+                    sourceDepthPitch, destData, destRowPitch, destDepthPitch);
+        return;
+    }
+
+    std::vector<GenerateMipTileTask> tiles;
+    tiles.reserve(tileCount);
+    for (size_t tileIndex = 0; tileIndex < tileCount; ++tileIndex)
+    {
+        tiles.emplace_back(mipFunction, sourceWidth, sourceHeight, sourceDepth, sourceData,
+                           sourceRowPitch, sourceDepthPitch, destData, destRowPitch,
+                           destDepthPitch, rows * tileIndex / tileCount,
+                           rows * (tileIndex + 1) / tileCount);
+    }
+
+    RunTiles(workerPool, &tiles);
+}
+
 bool FastCopyFunctionMap::has(const gl::FormatType &formatType) const
 {
     return (get(formatType) != nullptr);
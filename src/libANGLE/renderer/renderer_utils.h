@@ -14,6 +14,7 @@
 
 #include <map>
 
+#include "libANGLE/WorkerThread.h"
 #include "libANGLE/angletypes.h"
 
 namespace angle
@@ -126,6 +127,38 @@ struct LoadImageFunctionInfo
 
 using LoadFunctionMap = LoadImageFunctionInfo (*)(GLenum);
 
+// Loads a block compressed image in tiles of whole rows of blocks, which are decoded on the worker
+// pool when the image is large enough for the tiles to pay for their tasks. The load functions of
+// the compressed formats decode each row of blocks on its own. |outputBlockHeight| is the block
+// height of the output format when the image is transcoded, and 1 when it is decompressed.
+void LoadCompressedImageInTiles(angle::WorkerThreadPool *workerPool,
+                                LoadImageFunction loadFunction,
+                                size_t width,
+                                size_t height,
+                                size_t depth,
+                                size_t inputBlockHeight,
+                                const uint8_t *input,
+                                size_t inputRowPitch,
+                                size_t inputDepthPitch,
+                                size_t outputBlockHeight,
+                                uint8_t *output,
+                                size_t outputRowPitch,
+                                size_t outputDepthPitch);
+
+// Generates a mip in tiles of whole rows, or of whole slices for 3D images, which are generated on
+// the worker pool when the image is large enough for the tiles to pay for their tasks.
+void GenerateMipInTiles(angle::WorkerThreadPool *workerPool,
+                        MipGenerationFunction mipFunction,
+                        size_t sourceWidth,
+                        size_t sourceHeight,
+                        size_t sourceDepth,
+                        const uint8_t *sourceData,
+                        size_t sourceRowPitch,
+                        size_t sourceDepthPitch,
+                        uint8_t *destData,
+                        size_t destRowPitch,
+                        size_t destDepthPitch);
+
 }  // namespace rx
 
 #endif  // LIBANGLE_RENDERER_RENDERER_UTILS_H_
@@ -0,0 +1,171 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// renderer_utils_unittest:
+//   Tests of the helpers shared by the back-ends.
+//
+
+#include <gtest/gtest.h>
+
+#include <ostream>
+#include <random>
+#include <vector>
+
+#include "image_util/generatemip.h"
+#include "image_util/loadimage.h"
+#include "libANGLE/renderer/renderer_utils.h"
+
+using namespace rx;
+
+namespace
+{
+
+struct CompressedLoadParams
+{
+    const char *name;
+    LoadImageFunction loadFunction;
+    size_t inputBlockBytes;
+    // Bytes per output pixel when the image is decompressed, or per output block when it is
+    // transcoded.
+    size_t outputBytes;
+    size_t outputBlockHeight;
+};
+
+std::ostream &operator<<(std::ostream &os, const CompressedLoadParams &params)
+{
+    return os << params.name;
+}
+
+class LoadCompressedImageInTilesTest : public testing::TestWithParam<CompressedLoadParams>
+{
+  protected:
+    // Loads random blocks in tiles on a pool of |threadCount| threads, and checks the image is the
+    // same as one loaded in a single call.
+    void checkTiledLoad(size_t threadCount, size_t width, size_t height, size_t depth);
+};
+
+void LoadCompressedImageInTilesTest::checkTiledLoad(size_t threadCount,
+                                                    size_t width,
+                                                    size_t height,
+                                                    size_t depth)
+{
+    const CompressedLoadParams &params = GetParam();
+
+    const size_t blocksWide       = (width + 3) / 4;
+    const size_t blocksHigh       = (height + 3) / 4;
+    const size_t inputRowPitch    = blocksWide * params.inputBlockBytes;
+    const size_t inputDepthPitch  = inputRowPitch * blocksHigh;
+    const bool transcoded         = params.outputBlockHeight > 1;
+    const size_t outputRowPitch   = (transcoded ? blocksWide : width) * params.outputBytes + 16;
+    const size_t outputDepthPitch = outputRowPitch * (transcoded ? blocksHigh : height);
+
+    std::vector<uint8_t> input(inputDepthPitch * depth);
+    std::mt19937 generator(static_cast<unsigned int>(width * height * depth));
+    for (uint8_t &value : input)
+    {
+        value = static_cast<uint8_t>(generator());
+    }
+
+    // The padding of the rows is never written.
+    std::vector<uint8_t> expected(outputDepthPitch * depth, 0x5A);
+    std::vector<uint8_t> tiled(expected);
+
+    params.loadFunction(width, height, depth, input.data(), inputRowPitch, inputDepthPitch,
+                        expected.data(), outputRowPitch, outputDepthPitch);
+
+    angle::WorkerThreadPool workerPool(threadCount);
+    LoadCompressedImageInTiles(&workerPool, params.loadFunction, width, height, depth, 4,
+                               input.data(), inputRowPitch, inputDepthPitch,
+                               params.outputBlockHeight, tiled.data(), outputRowPitch,
+                               outputDepthPitch);
+
+    ASSERT_EQ(expected, tiled) << params.name << " " << width << "x" << height << "x" << depth
+                               << " on " << threadCount << " threads";
+}
+
+// Images too small to be split.
+TEST_P(LoadCompressedImageInTilesTest, SmallImages)
+{
+    checkTiledLoad(4, 4, 4, 1);
+    checkTiledLoad(4, 13, 6, 2);
+    checkTiledLoad(4, 256, 256, 1);
+}
+
+// Images split in tiles, with partial blocks on the last row and tiles that cross slices.
+TEST_P(LoadCompressedImageInTilesTest, TiledImages)
+{
+    checkTiledLoad(4, 512, 512, 1);
+    checkTiledLoad(4, 515, 517, 1);
+    checkTiledLoad(3, 301, 302, 5);
+    checkTiledLoad(16, 1027, 1030, 1);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    ,
+    LoadCompressedImageInTilesTest,
+    testing::Values(CompressedLoadParams{"ETC1RGB8ToRGBA8", angle::LoadETC1RGB8ToRGBA8, 8, 4, 1},
+                    CompressedLoadParams{"ETC2RGB8A1ToRGBA8", angle::LoadETC2RGB8A1ToRGBA8, 8, 4,
+                                         1},
+                    CompressedLoadParams{"ETC2RGBA8ToRGBA8", angle::LoadETC2RGBA8ToRGBA8, 16, 4, 1},
+                    CompressedLoadParams{"EACR11ToR8", angle::LoadEACR11ToR8, 8, 1, 1},
+                    CompressedLoadParams{"EACRG11SToRG8", angle::LoadEACRG11SToRG8, 16, 2, 1},
+                    CompressedLoadParams{"ETC2RGB8ToBC1", angle::LoadETC2RGB8ToBC1, 8, 8, 4},
+                    CompressedLoadParams{"ETC2RGB8A1ToBC1", angle::LoadETC2RGB8A1ToBC1, 8, 8,
+                                         4}));
+
+// Generates a mip of a random image in tiles on a pool of |threadCount| threads, and checks it is
+// the same as one generated in a single call.
+void CheckTiledMip(MipGenerationFunction mipFunction,
+                   size_t pixelBytes,
+                   size_t threadCount,
+                   size_t width,
+                   size_t height,
+                   size_t depth)
+{
+    const size_t sourceRowPitch   = width * pixelBytes + 4;
+    const size_t sourceDepthPitch = sourceRowPitch * height;
+    const size_t destWidth        = std::max<size_t>(1, width >> 1);
+    const size_t destHeight       = std::max<size_t>(1, height >> 1);
+    const size_t destDepth        = std::max<size_t>(1, depth >> 1);
+    const size_t destRowPitch     = destWidth * pixelBytes + 8;
+    const size_t destDepthPitch   = destRowPitch * destHeight;
+
+    // Byte patterns of finite floats and half floats, so that no NaN payload is averaged.
+    std::vector<uint8_t> source(sourceDepthPitch * depth);
+    std::mt19937 generator(static_cast<unsigned int>(width * height * depth));
+    for (uint8_t &value : source)
+    {
+        value = static_cast<uint8_t>(generator() & 0x3F);
+    }
+
+    std::vector<uint8_t> expected(destDepthPitch * destDepth, 0x5A);
+    std::vector<uint8_t> tiled(expected);
+
+    mipFunction(width, height, depth, source.data(), sourceRowPitch, sourceDepthPitch,
+                expected.data(), destRowPitch, destDepthPitch);
+
+    angle::WorkerThreadPool workerPool(threadCount);
+    GenerateMipInTiles(&workerPool, mipFunction, width, height, depth, source.data(),
+                       sourceRowPitch, sourceDepthPitch, tiled.data(), destRowPitch,
+                       destDepthPitch);
+
+    ASSERT_EQ(expected, tiled) << width << "x" << height << "x" << depth << " on " << threadCount
+                               << " threads";
+}
+
+// 2D images split along their rows, 3D images along their slices, and images too small or too
+// thin to be split.
+TEST(GenerateMipInTilesTest, MatchesSingleCall)
+{
+    CheckTiledMip(angle::GenerateMip<angle::R8G8B8A8>, 4, 4, 64, 64, 1);
+    CheckTiledMip(angle::GenerateMip<angle::R8G8B8A8>, 4, 4, 1 << 20, 1, 1);
+    CheckTiledMip(angle::GenerateMip<angle::R8G8B8A8>, 4, 4, 1031, 1029, 1);
+    CheckTiledMip(angle::GenerateMip<angle::R8G8B8A8>, 4, 3, 2, 1 << 20, 1);
+    CheckTiledMip(angle::GenerateMip<angle::R8G8B8A8>, 4, 16, 129, 131, 67);
+    CheckTiledMip(angle::GenerateMip<angle::R16G16B16A16F>, 8, 4, 1030, 1030, 1);
+    CheckTiledMip(angle::GenerateMip<angle::R16G16B16A16F>, 8, 5, 1, 1024, 1025);
+}
+
+}  // anonymous namespace
@@ -252,6 +252,12 @@ void ProgramVk::setUniformMatrix4x3fv(GLint location,
     UNIMPLEMENTED();
 }
 
+void ProgramVk::syncUniforms(const gl::RangeUI &dirtyRange)
+{
+    // There is no uniform storage to upload to yet. The values are kept in the program state, so
+    // this is called before every draw that follows a uniform update and must not warn.
+}
+
 void ProgramVk::setUniformBlockBinding(GLuint uniformBlockIndex, GLuint uniformBlockBinding)
 {
     UNIMPLEMENTED();
@@ -83,6 +83,7 @@ class ProgramVk : public ProgramImpl
                                GLsizei count,
                                GLboolean transpose,
                                const GLfloat *value) override;
+    void syncUniforms(const gl::RangeUI &dirtyRange) override;
 
     // TODO: synchronize in syncState when dirty bits exist.
     void setUniformBlockBinding(GLuint uniformBlockIndex, GLuint uniformBlockBinding) override;
@@ -29,7 +29,8 @@ ShCompileOptions ShaderVk::prepareSourceAndReturnOptions(std::stringstream *sour
     return 0;
 }
 
-bool ShaderVk::postTranslateCompile(gl::Compiler *compiler, std::string *infoLog)
+bool ShaderVk::postTranslateCompile(const gl::TranslatedShader &translatedShader,
+                                    std::string *infoLog)
 {
     // No work to do here.
     return true;
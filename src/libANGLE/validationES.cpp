@@ -23,6 +23,7 @@
 #include "libANGLE/TransformFeedback.h"
 #include "libANGLE/VertexArray.h"
 
+#include "common/BitSetIterator.h"
 #include "common/mathutil.h"
 #include "common/utilities.h"
 
@@ -44,51 +45,55 @@ bool ValidateDrawAttribs(ValidationContext *context,
 
     bool webglCompatibility = context->getExtensions().webglCompatibility;
 
-    const VertexArray *vao    = state.getVertexArray();
-    const auto &vertexAttribs = vao->getVertexAttributes();
+    const VertexArray *vao     = state.getVertexArray();
+    const auto &vertexAttribs  = vao->getVertexAttributes();
     const auto &vertexBindings = vao->getVertexBindings();
-    size_t maxEnabledAttrib   = vao->getMaxEnabledAttribute();
-    for (size_t attributeIndex = 0; attributeIndex < maxEnabledAttrib; ++attributeIndex)
+
+    // Only attributes that are both enabled and used by the program need checking.
+    AttributesMask activeAttribs =
+        program->getActiveAttribLocationsMask() & vao->getEnabledAttributesMask();
+
+    // If we have no buffer, then we either get an error, or there are no more checks to be done.
+    AttributesMask clientAttribs = activeAttribs & vao->getClientMemoryAttribsMask();
+    if (clientAttribs.any())
     {
-        const VertexAttribute &attrib = vertexAttribs[attributeIndex];
-        if (!program->isAttribLocationActive(attributeIndex) || !attrib.enabled)
+        if (webglCompatibility || !state.areClientArraysEnabled())
         {
-            continue;
+            // [WebGL 1.0] Section 6.5 Enabled Vertex Attributes and Range Checking
+            // If a vertex attribute is enabled as an array via enableVertexAttribArray but
+            // no buffer is bound to that attribute via bindBuffer and vertexAttribPointer,
+            // then calls to drawArrays or drawElements will generate an INVALID_OPERATION
+            // error.
+            context->handleError(
+                Error(GL_INVALID_OPERATION, "An enabled vertex array has no buffer."));
+            return false;
         }
 
-        const VertexBinding &binding = vertexBindings[attrib.bindingIndex];
-        // If we have no buffer, then we either get an error, or there are no more checks to be done.
-        gl::Buffer *buffer = binding.buffer.get();
-        if (!buffer)
+        for (size_t attributeIndex : angle::IterateBitSet(clientAttribs))
         {
-            if (webglCompatibility || !state.areClientArraysEnabled())
-            {
-                // [WebGL 1.0] Section 6.5 Enabled Vertex Attributes and Range Checking
-                // If a vertex attribute is enabled as an array via enableVertexAttribArray but
-                // no buffer is bound to that attribute via bindBuffer and vertexAttribPointer,
-                // then calls to drawArrays or drawElements will generate an INVALID_OPERATION
-                // error.
-                context->handleError(
-                    Error(GL_INVALID_OPERATION, "An enabled vertex array has no buffer."));
-                return false;
-            }
-            else if (attrib.pointer == nullptr)
+            if (vertexAttribs[attributeIndex].pointer == nullptr)
             {
                 // This is an application error that would normally result in a crash,
                 // but we catch it and return an error
-                context->handleError(
-                    Error(GL_INVALID_OPERATION,
-                          "An enabled vertex array has no buffer and no pointer."));
+                context->handleError(Error(
+                    GL_INVALID_OPERATION, "An enabled vertex array has no buffer and no pointer."));
                 return false;
             }
-            continue;
         }
+    }
 
-        // If we're drawing zero vertices, we have enough data.
-        if (vertexCount <= 0 || primcount <= 0)
-        {
-            continue;
-        }
+    // If we're drawing zero vertices, we have enough data.
+    if (vertexCount <= 0 || primcount <= 0)
+    {
+        return true;
+    }
+
+    // The range of elements each buffer can hold is cached on the attribute by the vertex array
+    // and refreshed whenever the format, binding or buffer size changes.
+    for (size_t attributeIndex : angle::IterateBitSet(activeAttribs & ~clientAttribs))
+    {
+        const VertexAttribute &attrib = vertexAttribs[attributeIndex];
+        const VertexBinding &binding  = vertexBindings[attrib.bindingIndex];
 
         GLint maxVertexElement = 0;
         if (binding.divisor == 0)
@@ -100,40 +105,10 @@ bool ValidateDrawAttribs(ValidationContext *context,
             maxVertexElement = (primcount - 1) / binding.divisor;
         }
 
-        // We do manual overflow checks here instead of using safe_math.h because it was
-        // a bottleneck. Thanks to some properties of GL we know inequalities that can
-        // help us make the overflow checks faster.
-
-        // The max possible attribSize is 16 for a vector of 4 32 bit values.
-        constexpr uint64_t kMaxAttribSize = 16;
-        constexpr uint64_t kIntMax        = std::numeric_limits<int>::max();
-        constexpr uint64_t kUint64Max     = std::numeric_limits<uint64_t>::max();
-
-        // We know attribStride is given as a GLsizei which is typedefed to int.
-        // We also know an upper bound for attribSize.
-        static_assert(std::is_same<int, GLsizei>::value, "");
-        uint64_t attribStride = ComputeVertexAttributeStride(attrib, binding);
-        uint64_t attribSize   = ComputeVertexAttributeTypeSize(attrib);
-        ASSERT(attribStride <= kIntMax && attribSize <= kMaxAttribSize);
-
-        // Computing the max offset using uint64_t without attrib.offset is overflow
-        // safe. Note: Last vertex element does not take the full stride!
-        static_assert(kIntMax * kIntMax < kUint64Max - kMaxAttribSize, "");
-        uint64_t attribDataSizeNoOffset = maxVertexElement * attribStride + attribSize;
-
-        // An overflow can happen when adding the offset, check for it.
-        uint64_t attribOffset = ComputeVertexAttributeOffset(attrib, binding);
-        if (attribDataSizeNoOffset > kUint64Max - attribOffset)
-        {
-            context->handleError(Error(GL_INVALID_OPERATION, "Integer overflow."));
-            return false;
-        }
-        uint64_t attribDataSizeWithOffset = attribDataSizeNoOffset + attribOffset;
-
         // [OpenGL ES 3.0.2] section 2.9.4 page 40:
         // We can return INVALID_OPERATION if our vertex attribute does not have
         // enough backing data.
-        if (attribDataSizeWithOffset > static_cast<uint64_t>(buffer->getSize()))
+        if (static_cast<GLint64>(maxVertexElement) > attrib.cachedElementLimit)
         {
             context->handleError(Error(GL_INVALID_OPERATION,
                                        "Vertex buffer is not big enough for the draw call"));
@@ -3294,6 +3269,58 @@ bool ValidateCopyTexImageParametersBase(ValidationContext *context,
     return true;
 }
 
+// Checks the program and uniform buffer states, which only depend on bound objects and not on the
+// draw call parameters. The result is cached on the context, see
+// ValidationContext::isDrawStatesCacheValid.
+static Error ValidateDrawStates(ValidationContext *context)
+{
+    const State &state = context->getGLState();
+
+    gl::Program *program = state.getProgram();
+    if (!program)
+    {
+        return Error(GL_INVALID_OPERATION);
+    }
+
+    if (!program->validateSamplers(nullptr, context->getCaps()))
+    {
+        return Error(GL_INVALID_OPERATION);
+    }
+
+    // Uniform buffer validation
+    for (unsigned int uniformBlockIndex = 0;
+         uniformBlockIndex < program->getActiveUniformBlockCount(); uniformBlockIndex++)
+    {
+        const gl::UniformBlock &uniformBlock = program->getUniformBlockByIndex(uniformBlockIndex);
+        GLuint blockBinding                  = program->getUniformBlockBinding(uniformBlockIndex);
+        const OffsetBindingPointer<Buffer> &uniformBuffer =
+            state.getIndexedUniformBuffer(blockBinding);
+
+        if (uniformBuffer.get() == nullptr)
+        {
+            // undefined behaviour
+            return Error(GL_INVALID_OPERATION,
+                         "It is undefined behaviour to have a used but unbound uniform buffer.");
+        }
+
+        size_t uniformBufferSize = uniformBuffer.getSize();
+        if (uniformBufferSize == 0)
+        {
+            // Bind the whole buffer.
+            uniformBufferSize = static_cast<size_t>(uniformBuffer->getSize());
+        }
+
+        if (uniformBufferSize < uniformBlock.dataSize)
+        {
+            // undefined behaviour
+            return Error(GL_INVALID_OPERATION,
+                         "It is undefined behaviour to use a uniform buffer that is too small.");
+        }
+    }
+
+    return NoError();
+}
+
 bool ValidateDrawBase(ValidationContext *context, GLenum mode, GLsizei count)
 {
     switch (mode)
@@ -3319,8 +3346,14 @@ bool ValidateDrawBase(ValidationContext *context, GLenum mode, GLsizei count)
 
     const State &state = context->getGLState();
 
+    if (!context->isDrawStatesCacheValid())
+    {
+        context->cacheDrawStates(state.hasMappedBuffer(GL_ARRAY_BUFFER),
+                                 ValidateDrawStates(context));
+    }
+
     // Check for mapped buffers
-    if (state.hasMappedBuffer(GL_ARRAY_BUFFER))
+    if (context->getCachedHasMappedArrayBuffer())
     {
         context->handleError(Error(GL_INVALID_OPERATION));
         return false;
@@ -3357,60 +3390,20 @@ bool ValidateDrawBase(ValidationContext *context, GLenum mode, GLsizei count)
         }
     }
 
+    // The framebuffer keeps its own completeness cache, which is reset by attachment changes.
     if (framebuffer->checkStatus(context) != GL_FRAMEBUFFER_COMPLETE)
     {
         context->handleError(Error(GL_INVALID_FRAMEBUFFER_OPERATION));
         return false;
     }
 
-    gl::Program *program = state.getProgram();
-    if (!program)
+    const Error &drawStatesError = context->getCachedDrawStatesError();
+    if (drawStatesError.isError())
     {
-        context->handleError(Error(GL_INVALID_OPERATION));
-        return false;
-    }
-
-    if (!program->validateSamplers(NULL, context->getCaps()))
-    {
-        context->handleError(Error(GL_INVALID_OPERATION));
+        context->handleError(drawStatesError);
         return false;
     }
 
-    // Uniform buffer validation
-    for (unsigned int uniformBlockIndex = 0;
-         uniformBlockIndex < program->getActiveUniformBlockCount(); uniformBlockIndex++)
-    {
-        const gl::UniformBlock &uniformBlock = program->getUniformBlockByIndex(uniformBlockIndex);
-        GLuint blockBinding                  = program->getUniformBlockBinding(uniformBlockIndex);
-        const OffsetBindingPointer<Buffer> &uniformBuffer =
-            state.getIndexedUniformBuffer(blockBinding);
-
-        if (uniformBuffer.get() == nullptr)
-        {
-            // undefined behaviour
-            context->handleError(
-                Error(GL_INVALID_OPERATION,
-                      "It is undefined behaviour to have a used but unbound uniform buffer."));
-            return false;
-        }
-
-        size_t uniformBufferSize = uniformBuffer.getSize();
-        if (uniformBufferSize == 0)
-        {
-            // Bind the whole buffer.
-            uniformBufferSize = static_cast<size_t>(uniformBuffer->getSize());
-        }
-
-        if (uniformBufferSize < uniformBlock.dataSize)
-        {
-            // undefined behaviour
-            context->handleError(
-                Error(GL_INVALID_OPERATION,
-                      "It is undefined behaviour to use a uniform buffer that is too small."));
-            return false;
-        }
-    }
-
     // Detect rendering feedback loops for WebGL.
     if (context->getExtensions().webglCompatibility)
     {
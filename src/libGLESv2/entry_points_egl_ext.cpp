@@ -326,8 +326,11 @@ EGLDisplay EGLAPIENTRY GetPlatformDisplayEXT(EGLenum platform, void *native_disp
             return EGL_NO_DISPLAY;
         }
 
+        // The null back-end retains the texture and renderbuffer data with the reference device.
         if (deviceTypeSpecified && platformType != EGL_PLATFORM_ANGLE_TYPE_D3D9_ANGLE &&
-            platformType != EGL_PLATFORM_ANGLE_TYPE_D3D11_ANGLE)
+            platformType != EGL_PLATFORM_ANGLE_TYPE_D3D11_ANGLE &&
+            !(platformType == EGL_PLATFORM_ANGLE_TYPE_NULL_ANGLE &&
+              deviceType == EGL_PLATFORM_ANGLE_DEVICE_TYPE_REFERENCE_ANGLE))
         {
             thread->setError(
                 Error(EGL_BAD_ATTRIBUTE,
@@ -1934,7 +1934,7 @@ void GL_APIENTRY ReleaseShaderCompiler(void)
     if (context)
     {
         Compiler *compiler = context->getCompiler();
-        Error error = compiler->release();
+        Error error = compiler->releaseResources();
         if (error.isError())
         {
             context->handleError(error);
@@ -0,0 +1,227 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CompilerPerfTest:
+//   Performance test for the shader translator, which doesn't need a GPU. Translates the shader
+//   corpus to each output and reports the time taken by each stage of the translation, along with
+//   the most memory the pool allocator used for a shader.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "compiler/preprocessor/Preprocessor.h"
+#include "compiler/preprocessor/Token.h"
+#include "perf_tests/third_party/perf/perf_test.h"
+#include "test_utils/preprocessor_perf_utils.h"
+#include "tests/compiler_perf_tests/ShaderCorpus.h"
+
+using namespace angle;
+
+namespace
+{
+
+constexpr double kRunTimeSeconds = 5.0;
+
+double PreprocessShader(const char *source)
+{
+    auto startTime = std::chrono::steady_clock::now();
+
+    NullDiagnostics diagnostics;
+    NullDirectiveHandler directiveHandler;
+    pp::Preprocessor preprocessor(&diagnostics, &directiveHandler, pp::PreprocessorSettings());
+    if (preprocessor.init(1, &source, nullptr))
+    {
+        pp::Token token;
+        do
+        {
+            preprocessor.lex(&token);
+        } while (token.type != pp::Token::LAST);
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+    return elapsed.count();
+}
+
+const char *GetOutputName(ShShaderOutput output)
+{
+    switch (output)
+    {
+        case SH_ESSL_OUTPUT:
+            return "essl";
+        case SH_GLSL_450_CORE_OUTPUT:
+            return "glsl";
+        case SH_HLSL_4_1_OUTPUT:
+            return "hlsl";
+        case SH_GLSL_VULKAN_OUTPUT:
+            return "vulkan";
+        default:
+            return "unknown";
+    }
+}
+
+// The HLSL output doesn't support the ESSL 3.10 features yet, so those shaders are left out.
+bool IsSpecSupported(ShShaderOutput output, ShShaderSpec spec)
+{
+    return !(output == SH_HLSL_4_1_OUTPUT && spec == SH_GLES3_1_SPEC);
+}
+
+// Time spent in each stage of the translation of the corpus, in seconds.
+struct StageTimes
+{
+    StageTimes() : preprocess(0.0), parse(0.0), passes(0.0), output(0.0) {}
+
+    double preprocess;
+    double parse;
+    double passes;
+    double output;
+};
+
+class CompilerPerfTest : public testing::TestWithParam<ShShaderOutput>
+{
+  protected:
+    void TearDown() override
+    {
+        for (ShHandle compiler : mCompilers)
+        {
+            if (compiler != nullptr)
+            {
+                sh::Destruct(compiler);
+            }
+        }
+        mCompilers.clear();
+    }
+
+    // Creates a compiler for every shader of the corpus the output supports, leaving null handles
+    // for the others. Returns false if the output isn't supported by this build.
+    bool createCompilers();
+
+    // Translates the whole corpus once, adding the time taken by each stage to |times|.
+    void translateCorpus(StageTimes *times, size_t *peakPoolBytes);
+
+    void printResult(const std::string &trace, double value, const std::string &units) const
+    {
+        perf_test::PrintResult("CompilerPerf", std::string("_") + GetOutputName(GetParam()),
+                               trace, value, units, true);
+    }
+
+    std::vector<ShHandle> mCompilers;
+};
+
+bool CompilerPerfTest::createCompilers()
+{
+    ShBuiltInResources resources;
+    sh::InitBuiltInResources(&resources);
+    resources.MaxDrawBuffers           = 8;
+    resources.OES_standard_derivatives = 1;
+
+    for (const CorpusShader &shader : GetShaderCorpus())
+    {
+        if (!IsSpecSupported(GetParam(), shader.spec))
+        {
+            mCompilers.push_back(nullptr);
+            continue;
+        }
+
+        ShHandle compiler = sh::ConstructCompiler(shader.type, shader.spec, GetParam(), &resources);
+        if (compiler == nullptr)
+        {
+            return false;
+        }
+        mCompilers.push_back(compiler);
+    }
+    return true;
+}
+
+void CompilerPerfTest::translateCorpus(StageTimes *times, size_t *peakPoolBytes)
+{
+    const std::vector<CorpusShader> &corpus = GetShaderCorpus();
+    for (size_t index = 0; index < corpus.size(); ++index)
+    {
+        const CorpusShader &shader = corpus[index];
+        ShHandle compiler          = mCompilers[index];
+        if (compiler == nullptr)
+        {
+            continue;
+        }
+
+        // Preprocessing is interleaved with parsing in the translator, so it is measured on its
+        // own as well. The parse time below includes it.
+        times->preprocess += PreprocessShader(shader.source);
+
+        const char *source = shader.source;
+        ASSERT_TRUE(sh::Compile(compiler, &source, 1, SH_OBJECT_CODE | SH_VARIABLES))
+            << shader.name << ":\n"
+            << sh::GetInfoLog(compiler);
+
+        for (const sh::PassTiming &timing : *sh::GetPassTimings(compiler))
+        {
+            if (timing.name == "Parse")
+            {
+                times->parse += timing.seconds;
+            }
+            else if (timing.name == "Translate")
+            {
+                times->output += timing.seconds;
+            }
+            else
+            {
+                times->passes += timing.seconds;
+            }
+        }
+
+        *peakPoolBytes = std::max(*peakPoolBytes, sh::GetPeakPoolAllocatorBytes(compiler));
+    }
+}
+
+TEST_P(CompilerPerfTest, Run)
+{
+    if (!createCompilers())
+    {
+        std::cout << "Test skipped because the " << GetOutputName(GetParam())
+                  << " output is not supported." << std::endl;
+        return;
+    }
+
+    StageTimes times;
+    size_t peakPoolBytes = 0;
+    size_t iterations    = 0;
+
+    auto startTime = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed(0.0);
+    while (elapsed.count() < kRunTimeSeconds)
+    {
+        translateCorpus(&times, &peakPoolBytes);
+        if (HasFatalFailure())
+        {
+            return;
+        }
+        ++iterations;
+        elapsed = std::chrono::steady_clock::now() - startTime;
+    }
+
+    // Times are per translation of the whole corpus.
+    const double kMicroseconds = 1000000.0 / static_cast<double>(iterations);
+    printResult("preprocess", times.preprocess * kMicroseconds, "us");
+    printResult("parse", times.parse * kMicroseconds, "us");
+    printResult("passes", times.passes * kMicroseconds, "us");
+    printResult("output", times.output * kMicroseconds, "us");
+    printResult("total", (times.parse + times.passes + times.output) * kMicroseconds, "us");
+    printResult("peak_pool_allocator", static_cast<double>(peakPoolBytes), "bytes");
+}
+
+INSTANTIATE_TEST_CASE_P(,
+                        CompilerPerfTest,
+                        testing::Values(SH_ESSL_OUTPUT,
+                                        SH_GLSL_450_CORE_OUTPUT,
+                                        SH_HLSL_4_1_OUTPUT,
+                                        SH_GLSL_VULKAN_OUTPUT));
+
+}  // anonymous namespace
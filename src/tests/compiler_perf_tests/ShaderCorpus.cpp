@@ -0,0 +1,492 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ShaderCorpus.cpp:
+//   Shaders the compiler performance tests translate.
+//
+
+#include "tests/compiler_perf_tests/ShaderCorpus.h"
+
+namespace angle
+{
+
+namespace
+{
+
+// ESSL 1.00
+
+const char kSkinnedVertexShader[] =
+    "precision highp float;\n"
+    "attribute vec3 aPosition;\n"
+    "attribute vec3 aNormal;\n"
+    "attribute vec4 aTangent;\n"
+    "attribute vec2 aTexCoord;\n"
+    "attribute vec4 aBoneIndices;\n"
+    "attribute vec4 aBoneWeights;\n"
+    "uniform mat4 uBones[32];\n"
+    "uniform mat4 uModelView;\n"
+    "uniform mat4 uProjection;\n"
+    "uniform mat3 uNormalMatrix;\n"
+    "uniform vec3 uLightPosition;\n"
+    "uniform vec4 uTexCoordTransform;\n"
+    "varying vec3 vViewPosition;\n"
+    "varying vec3 vLightDirection;\n"
+    "varying vec3 vNormal;\n"
+    "varying vec3 vTangent;\n"
+    "varying vec3 vBitangent;\n"
+    "varying vec2 vTexCoord;\n"
+    "varying float vFogDepth;\n"
+    "mat4 getBoneMatrix(float index)\n"
+    "{\n"
+    "    return uBones[int(index)];\n"
+    "}\n"
+    "mat4 getSkinMatrix()\n"
+    "{\n"
+    "    mat4 skin = getBoneMatrix(aBoneIndices.x) * aBoneWeights.x;\n"
+    "    skin += getBoneMatrix(aBoneIndices.y) * aBoneWeights.y;\n"
+    "    skin += getBoneMatrix(aBoneIndices.z) * aBoneWeights.z;\n"
+    "    skin += getBoneMatrix(aBoneIndices.w) * aBoneWeights.w;\n"
+    "    return skin;\n"
+    "}\n"
+    "void main()\n"
+    "{\n"
+    "    mat4 skin = getSkinMatrix();\n"
+    "    vec4 skinnedPosition = skin * vec4(aPosition, 1.0);\n"
+    "    vec3 skinnedNormal = normalize((skin * vec4(aNormal, 0.0)).xyz);\n"
+    "    vec3 skinnedTangent = normalize((skin * vec4(aTangent.xyz, 0.0)).xyz);\n"
+    "    vec4 viewPosition = uModelView * skinnedPosition;\n"
+    "    vViewPosition = viewPosition.xyz;\n"
+    "    vLightDirection = uLightPosition - viewPosition.xyz;\n"
+    "    vNormal = uNormalMatrix * skinnedNormal;\n"
+    "    vTangent = uNormalMatrix * skinnedTangent;\n"
+    "    vBitangent = cross(vNormal, vTangent) * aTangent.w;\n"
+    "    vTexCoord = aTexCoord * uTexCoordTransform.xy + uTexCoordTransform.zw;\n"
+    "    vFogDepth = -viewPosition.z;\n"
+    "    gl_Position = uProjection * viewPosition;\n"
+    "}\n";
+
+const char kLightingFragmentShader[] =
+    "precision mediump float;\n"
+    "#define LIGHT_COUNT 4\n"
+    "#define SATURATE(x) clamp((x), 0.0, 1.0)\n"
+    "struct Light\n"
+    "{\n"
+    "    vec3 position;\n"
+    "    vec3 color;\n"
+    "    float range;\n"
+    "    float intensity;\n"
+    "};\n"
+    "struct Material\n"
+    "{\n"
+    "    vec3 albedo;\n"
+    "    vec3 specular;\n"
+    "    float shininess;\n"
+    "    float opacity;\n"
+    "};\n"
+    "uniform Light uLights[LIGHT_COUNT];\n"
+    "uniform Material uMaterial;\n"
+    "uniform sampler2D uDiffuseMap;\n"
+    "uniform sampler2D uNormalMap;\n"
+    "uniform sampler2D uSpecularMap;\n"
+    "uniform samplerCube uEnvironmentMap;\n"
+    "uniform vec3 uAmbient;\n"
+    "uniform vec3 uFogColor;\n"
+    "uniform vec2 uFogRange;\n"
+    "varying vec3 vViewPosition;\n"
+    "varying vec3 vLightDirection;\n"
+    "varying vec3 vNormal;\n"
+    "varying vec3 vTangent;\n"
+    "varying vec3 vBitangent;\n"
+    "varying vec2 vTexCoord;\n"
+    "varying float vFogDepth;\n"
+    "vec3 perturbNormal(vec3 normal, vec3 tangent, vec3 bitangent)\n"
+    "{\n"
+    "    vec3 mapped = texture2D(uNormalMap, vTexCoord).xyz * 2.0 - 1.0;\n"
+    "    mat3 tbn = mat3(normalize(tangent), normalize(bitangent), normalize(normal));\n"
+    "    return normalize(tbn * mapped);\n"
+    "}\n"
+    "float attenuation(Light light, float distance)\n"
+    "{\n"
+    "    float falloff = SATURATE(1.0 - pow(distance / light.range, 4.0));\n"
+    "    return light.intensity * falloff * falloff / (distance * distance + 1.0);\n"
+    "}\n"
+    "vec3 shadeLight(Light light, vec3 normal, vec3 viewDirection, vec3 specularColor)\n"
+    "{\n"
+    "    vec3 toLight = light.position - vViewPosition;\n"
+    "    float distance = length(toLight);\n"
+    "    vec3 lightDirection = toLight / distance;\n"
+    "    float diffuse = max(dot(normal, lightDirection), 0.0);\n"
+    "    vec3 halfVector = normalize(lightDirection + viewDirection);\n"
+    "    float specular = pow(max(dot(normal, halfVector), 0.0), uMaterial.shininess);\n"
+    "    vec3 color = uMaterial.albedo * diffuse + specularColor * specular;\n"
+    "    return color * light.color * attenuation(light, distance);\n"
+    "}\n"
+    "void main()\n"
+    "{\n"
+    "    vec4 diffuseSample = texture2D(uDiffuseMap, vTexCoord);\n"
+    "    if (diffuseSample.a * uMaterial.opacity < 0.1)\n"
+    "    {\n"
+    "        discard;\n"
+    "    }\n"
+    "    vec3 normal = perturbNormal(vNormal, vTangent, vBitangent);\n"
+    "    vec3 viewDirection = normalize(-vViewPosition);\n"
+    "    vec3 specularColor = uMaterial.specular * texture2D(uSpecularMap, vTexCoord).rgb;\n"
+    "    vec3 color = uAmbient * uMaterial.albedo;\n"
+    "    for (int i = 0; i < LIGHT_COUNT; ++i)\n"
+    "    {\n"
+    "        color += shadeLight(uLights[i], normal, viewDirection, specularColor);\n"
+    "    }\n"
+    "    vec3 reflected = reflect(-viewDirection, normal);\n"
+    "    color += textureCube(uEnvironmentMap, reflected).rgb * specularColor * 0.25;\n"
+    "    color *= diffuseSample.rgb;\n"
+    "    float fog = SATURATE((vFogDepth - uFogRange.x) / (uFogRange.y - uFogRange.x));\n"
+    "    gl_FragColor = vec4(mix(color, uFogColor, fog), diffuseSample.a * "
+    "uMaterial.opacity);\n"
+    "}\n";
+
+const char kBlurFragmentShader[] =
+    "precision mediump float;\n"
+    "uniform sampler2D uSource;\n"
+    "uniform sampler2D uDepth;\n"
+    "uniform vec2 uTexelSize;\n"
+    "uniform vec2 uDirection;\n"
+    "uniform float uWeights[9];\n"
+    "uniform float uDepthThreshold;\n"
+    "uniform float uExposure;\n"
+    "uniform float uBloomThreshold;\n"
+    "varying vec2 vTexCoord;\n"
+    "float luminance(vec3 color)\n"
+    "{\n"
+    "    return dot(color, vec3(0.2126, 0.7152, 0.0722));\n"
+    "}\n"
+    "vec3 toneMap(vec3 color)\n"
+    "{\n"
+    "    color *= uExposure;\n"
+    "    vec3 x = max(vec3(0.0), color - 0.004);\n"
+    "    return (x * (6.2 * x + 0.5)) / (x * (6.2 * x + 1.7) + 0.06);\n"
+    "}\n"
+    "vec4 bilateralSample(vec2 offset, float centerDepth, inout float totalWeight, float weight)\n"
+    "{\n"
+    "    vec2 coord = vTexCoord + offset * uTexelSize;\n"
+    "    float sampleDepth = texture2D(uDepth, coord).r;\n"
+    "    float depthWeight = abs(sampleDepth - centerDepth) < uDepthThreshold ? 1.0 : 0.0;\n"
+    "    totalWeight += weight * depthWeight;\n"
+    "    return texture2D(uSource, coord) * weight * depthWeight;\n"
+    "}\n"
+    "void main()\n"
+    "{\n"
+    "    float centerDepth = texture2D(uDepth, vTexCoord).r;\n"
+    "    float totalWeight = uWeights[0];\n"
+    "    vec4 sum = texture2D(uSource, vTexCoord) * uWeights[0];\n"
+    "    for (int i = 1; i < 9; ++i)\n"
+    "    {\n"
+    "        vec2 offset = uDirection * float(i);\n"
+    "        sum += bilateralSample(offset, centerDepth, totalWeight, uWeights[i]);\n"
+    "        sum += bilateralSample(-offset, centerDepth, totalWeight, uWeights[i]);\n"
+    "    }\n"
+    "    vec4 blurred = sum / max(totalWeight, 0.0001);\n"
+    "    float bright = luminance(blurred.rgb) > uBloomThreshold ? 1.0 : 0.0;\n"
+    "    gl_FragColor = vec4(toneMap(blurred.rgb) + blurred.rgb * bright, blurred.a);\n"
+    "}\n";
+
+// Reads gl_DepthRange, whose structure is a built-in shared by every compiler.
+const char kFogFragmentShader[] =
+    "precision mediump float;\n"
+    "uniform sampler2D uDepth;\n"
+    "uniform vec2 uNearFar;\n"
+    "uniform vec4 uFogColor;\n"
+    "varying vec2 vTexCoord;\n"
+    "float viewDepth(float windowDepth)\n"
+    "{\n"
+    "    float ndcDepth =\n"
+    "        (2.0 * windowDepth - gl_DepthRange.near - gl_DepthRange.far) / gl_DepthRange.diff;\n"
+    "    float near = uNearFar.x;\n"
+    "    float far = uNearFar.y;\n"
+    "    return 2.0 * near * far / (far + near - ndcDepth * (far - near));\n"
+    "}\n"
+    "void main()\n"
+    "{\n"
+    "    float depth = viewDepth(texture2D(uDepth, vTexCoord).r);\n"
+    "    float fog = clamp((depth - uNearFar.x) / (uNearFar.y - uNearFar.x), 0.0, 1.0);\n"
+    "    gl_FragColor = mix(vec4(vec3(depth / uNearFar.y), 1.0), uFogColor, fog * fog);\n"
+    "}\n";
+
+// ESSL 3.00
+
+const char kInstancedVertexShader[] =
+    "#version 300 es\n"
+    "precision highp float;\n"
+    "layout(location = 0) in vec3 aPosition;\n"
+    "layout(location = 1) in vec3 aNormal;\n"
+    "layout(location = 2) in vec2 aTexCoord;\n"
+    "layout(location = 3) in mat4 aInstanceTransform;\n"
+    "layout(location = 7) in vec4 aInstanceColor;\n"
+    "layout(std140) uniform Camera\n"
+    "{\n"
+    "    mat4 view;\n"
+    "    mat4 projection;\n"
+    "    vec4 position;\n"
+    "    vec4 frustumPlanes[6];\n"
+    "} uCamera;\n"
+    "uniform float uTime;\n"
+    "uniform vec3 uWindDirection;\n"
+    "out vec3 vWorldPosition;\n"
+    "out vec3 vNormal;\n"
+    "out vec2 vTexCoord;\n"
+    "flat out vec4 vColor;\n"
+    "flat out int vInstance;\n"
+    "bool isVisible(vec3 center, float radius)\n"
+    "{\n"
+    "    for (int i = 0; i < 6; ++i)\n"
+    "    {\n"
+    "        vec4 plane = uCamera.frustumPlanes[i];\n"
+    "        if (dot(plane.xyz, center) + plane.w < -radius)\n"
+    "        {\n"
+    "            return false;\n"
+    "        }\n"
+    "    }\n"
+    "    return true;\n"
+    "}\n"
+    "vec3 applyWind(vec3 position, float height)\n"
+    "{\n"
+    "    float phase = uTime * 2.0 + float(gl_InstanceID) * 0.37;\n"
+    "    float sway = sin(phase) * 0.5 + sin(phase * 2.3) * 0.25;\n"
+    "    return position + uWindDirection * sway * height * height;\n"
+    "}\n"
+    "void main()\n"
+    "{\n"
+    "    vec3 center = aInstanceTransform[3].xyz;\n"
+    "    if (!isVisible(center, 2.0))\n"
+    "    {\n"
+    "        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);\n"
+    "        return;\n"
+    "    }\n"
+    "    vec4 world = aInstanceTransform * vec4(aPosition, 1.0);\n"
+    "    world.xyz = applyWind(world.xyz, aPosition.y);\n"
+    "    vWorldPosition = world.xyz;\n"
+    "    vNormal = mat3(aInstanceTransform) * aNormal;\n"
+    "    vTexCoord = aTexCoord;\n"
+    "    vColor = aInstanceColor;\n"
+    "    vInstance = gl_InstanceID;\n"
+    "    gl_Position = uCamera.projection * uCamera.view * world;\n"
+    "}\n";
+
+const char kDeferredFragmentShader[] =
+    "#version 300 es\n"
+    "precision highp float;\n"
+    "precision highp int;\n"
+    "struct PointLight\n"
+    "{\n"
+    "    vec4 positionAndRadius;\n"
+    "    vec4 color;\n"
+    "};\n"
+    "layout(std140) uniform Lights\n"
+    "{\n"
+    "    PointLight pointLights[32];\n"
+    "    ivec4 counts;\n"
+    "};\n"
+    "uniform highp sampler2D uPositions;\n"
+    "uniform highp sampler2D uNormals;\n"
+    "uniform highp sampler2D uAlbedo;\n"
+    "uniform highp usampler2D uMaterialIds;\n"
+    "uniform highp sampler2DArray uShadowMaps;\n"
+    "uniform mat4 uShadowMatrices[4];\n"
+    "uniform vec3 uCameraPosition;\n"
+    "in vec2 vTexCoord;\n"
+    "layout(location = 0) out vec4 outColor;\n"
+    "layout(location = 1) out vec4 outBloom;\n"
+    "float shadowFactor(vec3 position, int cascade)\n"
+    "{\n"
+    "    vec4 shadowCoord = uShadowMatrices[cascade] * vec4(position, 1.0);\n"
+    "    shadowCoord.xyz /= shadowCoord.w;\n"
+    "    float lit = 0.0;\n"
+    "    for (int y = -1; y <= 1; ++y)\n"
+    "    {\n"
+    "        for (int x = -1; x <= 1; ++x)\n"
+    "        {\n"
+    "            vec2 offset = vec2(x, y) / 2048.0;\n"
+    "            float depth = texture(uShadowMaps, vec3(shadowCoord.xy + offset, "
+    "float(cascade))).r;\n"
+    "            lit += shadowCoord.z - 0.002 > depth ? 0.0 : 1.0;\n"
+    "        }\n"
+    "    }\n"
+    "    return lit / 9.0;\n"
+    "}\n"
+    "vec3 shade(uint materialId, vec3 albedo, vec3 normal, vec3 lightDirection, vec3 "
+    "viewDirection)\n"
+    "{\n"
+    "    float nDotL = max(dot(normal, lightDirection), 0.0);\n"
+    "    switch (materialId)\n"
+    "    {\n"
+    "        case 0u:\n"
+    "            return albedo * nDotL;\n"
+    "        case 1u:\n"
+    "        {\n"
+    "            vec3 halfVector = normalize(lightDirection + viewDirection);\n"
+    "            return albedo * nDotL + pow(max(dot(normal, halfVector), 0.0), 64.0);\n"
+    "        }\n"
+    "        case 2u:\n"
+    "        {\n"
+    "            float wrap = max((dot(normal, lightDirection) + 0.5) / 1.5, 0.0);\n"
+    "            return albedo * wrap;\n"
+    "        }\n"
+    "        default:\n"
+    "            return vec3(1.0, 0.0, 1.0);\n"
+    "    }\n"
+    "}\n"
+    "void main()\n"
+    "{\n"
+    "    ivec2 pixel = ivec2(gl_FragCoord.xy);\n"
+    "    vec3 position = texelFetch(uPositions, pixel, 0).xyz;\n"
+    "    vec3 normal = normalize(texelFetch(uNormals, pixel, 0).xyz);\n"
+    "    vec4 albedo = texelFetch(uAlbedo, pixel, 0);\n"
+    "    uint materialId = texelFetch(uMaterialIds, pixel, 0).r;\n"
+    "    vec3 viewDirection = normalize(uCameraPosition - position);\n"
+    "    float viewDistance = length(uCameraPosition - position);\n"
+    "    int cascade = viewDistance < 10.0 ? 0 : viewDistance < 30.0 ? 1 : viewDistance < 90.0 "
+    "? 2 : 3;\n"
+    "    vec3 color = albedo.rgb * 0.05;\n"
+    "    for (int i = 0; i < counts.x; ++i)\n"
+    "    {\n"
+    "        vec3 toLight = pointLights[i].positionAndRadius.xyz - position;\n"
+    "        float distance = length(toLight);\n"
+    "        if (distance > pointLights[i].positionAndRadius.w)\n"
+    "        {\n"
+    "            continue;\n"
+    "        }\n"
+    "        float falloff = 1.0 - distance / pointLights[i].positionAndRadius.w;\n"
+    "        vec3 lit = shade(materialId, albedo.rgb, normal, toLight / distance, "
+    "viewDirection);\n"
+    "        color += lit * pointLights[i].color.rgb * falloff * falloff;\n"
+    "    }\n"
+    "    color *= shadowFactor(position, cascade);\n"
+    "    outColor = vec4(color, albedo.a);\n"
+    "    outBloom = dot(color, vec3(0.33)) > 1.0 ? vec4(color, 1.0) : vec4(0.0);\n"
+    "}\n";
+
+// ESSL 3.10
+
+const char kReductionComputeShader[] =
+    "#version 310 es\n"
+    "precision highp float;\n"
+    "precision highp image2D;\n"
+    "layout(local_size_x = 16, local_size_y = 16) in;\n"
+    "layout(r32f, binding = 0) readonly uniform highp image2D uLuminanceIn;\n"
+    "layout(r32f, binding = 1) writeonly uniform highp image2D uLuminanceOut;\n"
+    "uniform float uAdaptationRate;\n"
+    "shared float sLuminance[256];\n"
+    "shared float sMaxLuminance[256];\n"
+    "void main()\n"
+    "{\n"
+    "    uint index = gl_LocalInvocationIndex;\n"
+    "    ivec2 size = imageSize(uLuminanceIn);\n"
+    "    ivec2 coord = ivec2(gl_GlobalInvocationID.xy);\n"
+    "    float value = 0.0;\n"
+    "    if (coord.x < size.x && coord.y < size.y)\n"
+    "    {\n"
+    "        value = log(max(imageLoad(uLuminanceIn, coord).r, 0.0001));\n"
+    "    }\n"
+    "    sLuminance[index] = value;\n"
+    "    sMaxLuminance[index] = value;\n"
+    "    memoryBarrierShared();\n"
+    "    barrier();\n"
+    "    for (uint stride = 128u; stride > 0u; stride >>= 1u)\n"
+    "    {\n"
+    "        if (index < stride)\n"
+    "        {\n"
+    "            sLuminance[index] += sLuminance[index + stride];\n"
+    "            sMaxLuminance[index] = max(sMaxLuminance[index], sMaxLuminance[index + "
+    "stride]);\n"
+    "        }\n"
+    "        memoryBarrierShared();\n"
+    "        barrier();\n"
+    "    }\n"
+    "    if (index == 0u)\n"
+    "    {\n"
+    "        float average = exp(sLuminance[0] / 256.0);\n"
+    "        float adapted = mix(average, exp(sMaxLuminance[0]), uAdaptationRate);\n"
+    "        imageStore(uLuminanceOut, ivec2(gl_WorkGroupID.xy), vec4(adapted));\n"
+    "    }\n"
+    "}\n";
+
+const char kMaterialFragmentShader[] =
+    "#version 310 es\n"
+    "precision highp float;\n"
+    "struct Layer\n"
+    "{\n"
+    "    vec4 tint;\n"
+    "    vec2 scale;\n"
+    "    float blend;\n"
+    "};\n"
+    "uniform Layer uLayers[4];\n"
+    "uniform sampler2D uLayerMaps[4];\n"
+    "uniform sampler2D uSplatMap;\n"
+    "uniform vec3 uSunDirection;\n"
+    "uniform vec3 uSunColor;\n"
+    "in vec3 vNormal;\n"
+    "in vec2 vTexCoord;\n"
+    "in vec3 vWorldPosition;\n"
+    "layout(location = 0) out vec4 outColor;\n"
+    "const float kCurve[12] = float[12](0.0, 0.2, 0.4, 0.1, 0.3, 0.5, 0.2, 0.4, 0.6, 0.3, 0.5, "
+    "0.7);\n"
+    "vec4 sampleLayer(int layer, vec2 texCoord)\n"
+    "{\n"
+    "    vec2 scaled = texCoord * uLayers[layer].scale;\n"
+    "    switch (layer)\n"
+    "    {\n"
+    "        case 0:\n"
+    "            return texture(uLayerMaps[0], scaled) * uLayers[0].tint;\n"
+    "        case 1:\n"
+    "            return texture(uLayerMaps[1], scaled) * uLayers[1].tint;\n"
+    "        case 2:\n"
+    "            return texture(uLayerMaps[2], scaled) * uLayers[2].tint;\n"
+    "        default:\n"
+    "            return texture(uLayerMaps[3], scaled) * uLayers[3].tint;\n"
+    "    }\n"
+    "}\n"
+    "float curve(int layer, float x)\n"
+    "{\n"
+    "    float result = 0.0;\n"
+    "    for (int i = 0; i < 3; ++i)\n"
+    "    {\n"
+    "        result += kCurve[layer * 3 + i] * pow(x, float(i));\n"
+    "    }\n"
+    "    return result;\n"
+    "}\n"
+    "void main()\n"
+    "{\n"
+    "    vec4 splat = texture(uSplatMap, vTexCoord);\n"
+    "    vec4 neighbour = textureLodOffset(uSplatMap, vTexCoord, 1.0, ivec2(1, 0));\n"
+    "    vec4 weights = mix(splat, neighbour, 0.5);\n"
+    "    weights /= max(dot(weights, vec4(1.0)), 0.0001);\n"
+    "    vec4 color = vec4(0.0);\n"
+    "    for (int layer = 0; layer < 4; ++layer)\n"
+    "    {\n"
+    "        float weight = weights[layer] * uLayers[layer].blend;\n"
+    "        color += sampleLayer(layer, vTexCoord) * curve(layer, weight);\n"
+    "    }\n"
+    "    float nDotL = max(dot(normalize(vNormal), uSunDirection), 0.0);\n"
+    "    float height = fract(vWorldPosition.y * 0.01);\n"
+    "    outColor = vec4(color.rgb * (uSunColor * nDotL + 0.2) * (0.8 + height * 0.2), 1.0);\n"
+    "}\n";
+
+}  // anonymous namespace
+
+const std::vector<CorpusShader> &GetShaderCorpus()
+{
+    static const std::vector<CorpusShader> kCorpus = {
+        {"skinned_vs_100", GL_VERTEX_SHADER, SH_GLES2_SPEC, kSkinnedVertexShader},
+        {"lighting_fs_100", GL_FRAGMENT_SHADER, SH_GLES2_SPEC, kLightingFragmentShader},
+        {"blur_fs_100", GL_FRAGMENT_SHADER, SH_GLES2_SPEC, kBlurFragmentShader},
+        {"fog_fs_100", GL_FRAGMENT_SHADER, SH_GLES2_SPEC, kFogFragmentShader},
+        {"instanced_vs_300", GL_VERTEX_SHADER, SH_GLES3_SPEC, kInstancedVertexShader},
+        {"deferred_fs_300", GL_FRAGMENT_SHADER, SH_GLES3_SPEC, kDeferredFragmentShader},
+        {"reduction_cs_310", GL_COMPUTE_SHADER, SH_GLES3_1_SPEC, kReductionComputeShader},
+        {"material_fs_310", GL_FRAGMENT_SHADER, SH_GLES3_1_SPEC, kMaterialFragmentShader},
+    };
+    return kCorpus;
+}
+
+}  // namespace angle
@@ -0,0 +1,34 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ShaderCorpus.h:
+//   Shaders the compiler performance tests translate, written after the shaders of games and web
+//   applications: skinning, lighting, post-processing and compute, in ESSL 1.00, 3.00 and 3.10.
+//
+
+#ifndef COMPILER_PERF_TESTS_SHADER_CORPUS_H_
+#define COMPILER_PERF_TESTS_SHADER_CORPUS_H_
+
+#include <vector>
+
+#include "angle_gl.h"
+#include "GLSLANG/ShaderLang.h"
+
+namespace angle
+{
+
+struct CorpusShader
+{
+    const char *name;
+    GLenum type;
+    ShShaderSpec spec;
+    const char *source;
+};
+
+const std::vector<CorpusShader> &GetShaderCorpus();
+
+}  // namespace angle
+
+#endif  // COMPILER_PERF_TESTS_SHADER_CORPUS_H_
@@ -24,3 +24,48 @@ TEST(APITest, CompareShBuiltInResources)
     EXPECT_TRUE(memcmp(&a_resources, &b_resources, sizeof(a_resources)) == 0);
 }
 
+// Test that the time taken by each step of the compilation is reported, with the passes that
+// share a traversal of the AST reported as one step.
+TEST(APITest, PassTimings)
+{
+    ShBuiltInResources resources;
+    sh::InitBuiltInResources(&resources);
+    ShHandle compiler = sh::ConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC,
+                                              SH_GLSL_COMPATIBILITY_OUTPUT, &resources);
+    ASSERT_NE(nullptr, compiler);
+
+    const char *shaderString =
+        "precision mediump float;\n"
+        "uniform float u;\n"
+        "void main() {\n"
+        "    gl_FragColor = vec4(u > 0.0 && u < 1.0 ? pow(u, 2.0) : 0.0);\n"
+        "}";
+    ShCompileOptions compileOptions =
+        SH_OBJECT_CODE | SH_UNFOLD_SHORT_CIRCUIT | SH_REMOVE_POW_WITH_CONSTANT_EXPONENT;
+    ASSERT_TRUE(sh::Compile(compiler, &shaderString, 1, compileOptions));
+
+    const std::vector<sh::PassTiming> *timings = sh::GetPassTimings(compiler);
+    ASSERT_NE(nullptr, timings);
+    ASSERT_LE(3u, timings->size());
+    EXPECT_EQ("Parse", timings->front().name);
+    EXPECT_EQ("Translate", timings->back().name);
+
+    bool foundSharedTraversal = false;
+    for (const sh::PassTiming &timing : *timings)
+    {
+        EXPECT_LE(0.0, timing.seconds);
+        if (timing.name.find("UnfoldShortCircuit+RemovePow") != std::string::npos)
+        {
+            foundSharedTraversal = true;
+        }
+    }
+    EXPECT_TRUE(foundSharedTraversal);
+
+    // Only the parsing is reported for a shader that fails to parse.
+    const char *invalidShaderString = "void main() {";
+    EXPECT_FALSE(sh::Compile(compiler, &invalidShaderString, 1, compileOptions));
+    ASSERT_EQ(1u, timings->size());
+    EXPECT_EQ("Parse", timings->front().name);
+
+    sh::Destruct(compiler);
+}
@@ -43,3 +43,55 @@ TEST(ConstructCompilerTest, InvalidMaxDualSourceDrawBuffers)
                                               SH_GLSL_COMPATIBILITY_OUTPUT, &resources);
     ASSERT_EQ(nullptr, compiler);
 }
+
+// Test that compilers constructed with different resources don't see each other's built-ins.
+TEST(ConstructCompilerTest, BuiltInsDependOnResources)
+{
+    ShBuiltInResources resources;
+    sh::InitBuiltInResources(&resources);
+    ShHandle compilerWithoutFragDepth = sh::ConstructCompiler(
+        GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_GLSL_COMPATIBILITY_OUTPUT, &resources);
+    ASSERT_NE(nullptr, compilerWithoutFragDepth);
+
+    resources.EXT_frag_depth       = 1;
+    ShHandle compilerWithFragDepth = sh::ConstructCompiler(
+        GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_GLSL_COMPATIBILITY_OUTPUT, &resources);
+    ASSERT_NE(nullptr, compilerWithFragDepth);
+
+    const char *shaderString =
+        "#extension GL_EXT_frag_depth : require\n"
+        "precision mediump float;\n"
+        "void main() { gl_FragDepthEXT = 1.0; }\n";
+
+    EXPECT_FALSE(sh::Compile(compilerWithoutFragDepth, &shaderString, 1, SH_OBJECT_CODE));
+    EXPECT_TRUE(sh::Compile(compilerWithFragDepth, &shaderString, 1, SH_OBJECT_CODE));
+
+    sh::Destruct(compilerWithoutFragDepth);
+    sh::Destruct(compilerWithFragDepth);
+}
+
+// Test that the built-ins shared between compilers outlive any one of them.
+TEST(ConstructCompilerTest, SharedBuiltInsOutliveCompiler)
+{
+    ShBuiltInResources resources;
+    sh::InitBuiltInResources(&resources);
+
+    const char *shaderString =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "out vec4 color;\n"
+        "void main() { color = clamp(u, 0.0, 1.0) * dot(u.xyz, u.xyz); }\n";
+
+    ShHandle firstCompiler = sh::ConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES3_SPEC,
+                                                   SH_GLSL_COMPATIBILITY_OUTPUT, &resources);
+    ASSERT_NE(nullptr, firstCompiler);
+    EXPECT_TRUE(sh::Compile(firstCompiler, &shaderString, 1, SH_OBJECT_CODE));
+    sh::Destruct(firstCompiler);
+
+    ShHandle secondCompiler = sh::ConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES3_SPEC,
+                                                    SH_GLSL_COMPATIBILITY_OUTPUT, &resources);
+    ASSERT_NE(nullptr, secondCompiler);
+    EXPECT_TRUE(sh::Compile(secondCompiler, &shaderString, 1, SH_OBJECT_CODE));
+    sh::Destruct(secondCompiler);
+}
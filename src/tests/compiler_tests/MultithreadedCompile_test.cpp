@@ -0,0 +1,134 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// MultithreadedCompile_test.cpp:
+//   Compiles the shader corpus with independent compilers on several threads at once, and checks
+//   that every thread gets the same translation as a compile on its own.
+//
+
+#include <array>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "tests/compiler_perf_tests/ShaderCorpus.h"
+
+using namespace angle;
+
+namespace
+{
+
+constexpr size_t kThreadCount = 8;
+constexpr size_t kIterations  = 4;
+
+class MultithreadedCompileTest : public testing::TestWithParam<ShShaderOutput>
+{
+  protected:
+    void SetUp() override
+    {
+        sh::InitBuiltInResources(&mResources);
+
+        // Resources no other test uses, so that the threads also race to build the built-ins.
+        mResources.MaxDrawBuffers           = 7;
+        mResources.MaxVertexAttribs         = 13;
+        mResources.OES_standard_derivatives = 1;
+    }
+
+    // Translates the corpus once with new compilers. Returns false if the output isn't supported
+    // by this build. The translations of the shaders that fail to compile are replaced with their
+    // info logs.
+    bool translateCorpus(std::vector<std::string> *translations) const;
+
+    ShBuiltInResources mResources;
+};
+
+bool MultithreadedCompileTest::translateCorpus(std::vector<std::string> *translations) const
+{
+    for (const CorpusShader &shader : GetShaderCorpus())
+    {
+        // The HLSL output doesn't support the ESSL 3.10 features yet.
+        if (GetParam() == SH_HLSL_4_1_OUTPUT && shader.spec == SH_GLES3_1_SPEC)
+        {
+            continue;
+        }
+
+        ShHandle compiler =
+            sh::ConstructCompiler(shader.type, shader.spec, GetParam(), &mResources);
+        if (compiler == nullptr)
+        {
+            return false;
+        }
+
+        const char *source = shader.source;
+        if (sh::Compile(compiler, &source, 1, SH_OBJECT_CODE))
+        {
+            translations->push_back(sh::GetObjectCode(compiler));
+        }
+        else
+        {
+            translations->push_back(std::string(shader.name) + " failed:\n" +
+                                    sh::GetInfoLog(compiler));
+        }
+
+        sh::Destruct(compiler);
+    }
+    return true;
+}
+
+TEST_P(MultithreadedCompileTest, CorpusTranslationsMatch)
+{
+    std::vector<std::vector<std::string>> threadTranslations(kThreadCount);
+    // Not a std::vector<bool>, its elements can't be written from different threads.
+    std::array<bool, kThreadCount> threadSupported;
+    threadSupported.fill(true);
+
+    std::vector<std::thread> threads;
+    for (size_t threadIndex = 0; threadIndex < kThreadCount; ++threadIndex)
+    {
+        threads.emplace_back([this, threadIndex, &threadTranslations, &threadSupported]() {
+            for (size_t iteration = 0; iteration < kIterations && threadSupported[threadIndex];
+                 ++iteration)
+            {
+                threadSupported[threadIndex] = translateCorpus(&threadTranslations[threadIndex]);
+            }
+        });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    std::vector<std::string> expected;
+    if (!translateCorpus(&expected))
+    {
+        std::cout << "Test skipped because the output is not supported." << std::endl;
+        return;
+    }
+
+    for (size_t threadIndex = 0; threadIndex < kThreadCount; ++threadIndex)
+    {
+        ASSERT_TRUE(threadSupported[threadIndex]);
+
+        const std::vector<std::string> &translations = threadTranslations[threadIndex];
+        ASSERT_EQ(expected.size() * kIterations, translations.size());
+        for (size_t index = 0; index < translations.size(); ++index)
+        {
+            EXPECT_EQ(expected[index % expected.size()], translations[index])
+                << "thread " << threadIndex << ", translation " << index;
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(,
+                        MultithreadedCompileTest,
+                        testing::Values(SH_ESSL_OUTPUT,
+                                        SH_GLSL_450_CORE_OUTPUT,
+                                        SH_HLSL_4_1_OUTPUT));
+
+}  // anonymous namespace
@@ -0,0 +1,152 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// SharedTraversal_test.cpp:
+//   Checks that the AST passes that share a traversal translate the shader corpus to the same
+//   output as when every pass runs in a traversal of its own.
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "tests/compiler_perf_tests/ShaderCorpus.h"
+
+using namespace angle;
+
+namespace
+{
+
+// Enables every traversal pass that can share a traversal.
+constexpr ShCompileOptions kCompileOptions =
+    SH_OBJECT_CODE | SH_CLAMP_INDIRECT_ARRAY_BOUNDS | SH_REWRITE_DO_WHILE_LOOPS |
+    SH_ADD_AND_TRUE_TO_LOOP_CONDITION | SH_UNFOLD_SHORT_CIRCUIT |
+    SH_REMOVE_POW_WITH_CONSTANT_EXPONENT | SH_EMULATE_ABS_INT_FUNCTION |
+    SH_EMULATE_ISNAN_FLOAT_FUNCTION | SH_EMULATE_ATAN2_FLOAT_FUNCTION;
+
+// The corpus is written after real applications, which rarely use do-while loops, so this shader
+// makes sure that every pass has something to rewrite, in the same subtrees as the others.
+const char kAllPassesShader[] =
+    "#version 300 es\n"
+    "precision highp float;\n"
+    "uniform float uValues[4];\n"
+    "uniform int uIndex;\n"
+    "out vec4 color;\n"
+    "float weight(float x)\n"
+    "{\n"
+    "    return pow(x, 2.0) + abs(x);\n"
+    "}\n"
+    "void main()\n"
+    "{\n"
+    "    int i = 0;\n"
+    "    float sum = 0.0;\n"
+    "    do\n"
+    "    {\n"
+    "        sum += (sum > 1.0 && uValues[i] < 2.0) ? weight(uValues[i]) : pow(sum, 3.0);\n"
+    "        i++;\n"
+    "    } while (i < uIndex && sum < 10.0);\n"
+    "    for (int j = 0; j < 4 || sum > 100.0; ++j)\n"
+    "    {\n"
+    "        sum += uValues[j] * pow(uValues[uIndex], 4.0);\n"
+    "    }\n"
+    "    int k = abs(uIndex);\n"
+    "    color = vec4(sum, atan(sum, uValues[k]), isnan(sum) ? 1.0 : 0.0, float(k));\n"
+    "}\n";
+
+class SharedTraversalTest : public testing::TestWithParam<ShShaderOutput>
+{
+  protected:
+    void SetUp() override
+    {
+        // The same resources as the compiler performance tests, which the corpus is written for.
+        sh::InitBuiltInResources(&mResources);
+        mResources.MaxDrawBuffers           = 8;
+        mResources.OES_standard_derivatives = 1;
+    }
+
+    // Returns false if the output isn't supported by this build. sharedTraversalCount is
+    // incremented for every traversal that more than one pass shares.
+    bool translate(const CorpusShader &shader,
+                   ShCompileOptions compileOptions,
+                   std::string *translation,
+                   size_t *sharedTraversalCount) const;
+
+    ShBuiltInResources mResources;
+};
+
+bool SharedTraversalTest::translate(const CorpusShader &shader,
+                                    ShCompileOptions compileOptions,
+                                    std::string *translation,
+                                    size_t *sharedTraversalCount) const
+{
+    ShHandle compiler = sh::ConstructCompiler(shader.type, shader.spec, GetParam(), &mResources);
+    if (compiler == nullptr)
+    {
+        return false;
+    }
+
+    const char *source = shader.source;
+    EXPECT_TRUE(sh::Compile(compiler, &source, 1, compileOptions))
+        << shader.name << " failed:\n"
+        << sh::GetInfoLog(compiler);
+    *translation = sh::GetObjectCode(compiler);
+
+    for (const sh::PassTiming &timing : *sh::GetPassTimings(compiler))
+    {
+        if (timing.name.find('+') != std::string::npos)
+        {
+            ++(*sharedTraversalCount);
+        }
+    }
+
+    sh::Destruct(compiler);
+    return true;
+}
+
+TEST_P(SharedTraversalTest, CorpusTranslationsMatch)
+{
+    std::vector<CorpusShader> shaders = GetShaderCorpus();
+    shaders.push_back(
+        {"all_passes.frag", GL_FRAGMENT_SHADER, SH_GLES3_SPEC, kAllPassesShader});
+
+    size_t sharedTraversalCount   = 0;
+    size_t separateTraversalCount = 0;
+    for (const CorpusShader &shader : shaders)
+    {
+        // The HLSL output doesn't support the ESSL 3.10 features yet.
+        if (GetParam() == SH_HLSL_4_1_OUTPUT && shader.spec == SH_GLES3_1_SPEC)
+        {
+            continue;
+        }
+
+        std::string sharedTranslation;
+        if (!translate(shader, kCompileOptions, &sharedTranslation, &sharedTraversalCount))
+        {
+            std::cout << "Test skipped because the output is not supported." << std::endl;
+            return;
+        }
+
+        std::string separateTranslation;
+        ASSERT_TRUE(translate(shader, kCompileOptions | SH_DONT_SHARE_AST_TRAVERSALS,
+                              &separateTranslation, &separateTraversalCount));
+
+        EXPECT_EQ(separateTranslation, sharedTranslation) << shader.name;
+    }
+
+    // Otherwise the test doesn't compare anything.
+    EXPECT_LT(0u, sharedTraversalCount);
+    EXPECT_EQ(0u, separateTraversalCount);
+}
+
+INSTANTIATE_TEST_CASE_P(,
+                        SharedTraversalTest,
+                        testing::Values(SH_ESSL_OUTPUT,
+                                        SH_GLSL_450_CORE_OUTPUT,
+                                        SH_HLSL_4_1_OUTPUT));
+
+}  // anonymous namespace
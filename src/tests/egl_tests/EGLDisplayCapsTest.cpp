@@ -0,0 +1,190 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// EGLDisplayCapsTest.cpp: checks that the displays of the same back-end expose the same caps,
+// whether they query the driver or reuse the caps another display generated.
+
+#include <gtest/gtest.h>
+
+#include <array>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include "OSWindow.h"
+#include "test_utils/ANGLETest.h"
+
+using namespace angle;
+
+namespace
+{
+
+// The limits queried from the contexts, along with the extension strings.
+constexpr GLenum kQueriedLimits[] = {
+    GL_MAX_TEXTURE_SIZE,
+    GL_MAX_CUBE_MAP_TEXTURE_SIZE,
+    GL_MAX_RENDERBUFFER_SIZE,
+    GL_MAX_VERTEX_ATTRIBS,
+    GL_MAX_VERTEX_UNIFORM_VECTORS,
+    GL_MAX_VARYING_VECTORS,
+    GL_MAX_FRAGMENT_UNIFORM_VECTORS,
+    GL_MAX_VERTEX_TEXTURE_IMAGE_UNITS,
+    GL_MAX_TEXTURE_IMAGE_UNITS,
+    GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS,
+    GL_NUM_COMPRESSED_TEXTURE_FORMATS,
+};
+
+struct QueriedCaps
+{
+    std::string eglExtensions;
+    std::string glVersion;
+    std::string glExtensions;
+    std::vector<GLint> limits;
+    std::vector<GLint> compressedTextureFormats;
+};
+
+class EGLDisplayCapsTest : public ::testing::TestWithParam<angle::PlatformParameters>
+{
+  protected:
+    EGLDisplayCapsTest() : mOSWindows{} {}
+
+    void SetUp() override
+    {
+        for (OSWindow *&osWindow : mOSWindows)
+        {
+            osWindow = CreateOSWindow();
+            osWindow->initialize("EGLDisplayCapsTest", 64, 64);
+        }
+    }
+
+    void TearDown() override
+    {
+        for (OSWindow *&osWindow : mOSWindows)
+        {
+            SafeDelete(osWindow);
+        }
+    }
+
+    // Initializes a display for the native display of the window, creates a context to query its
+    // caps, and terminates the display.
+    void queryCaps(const OSWindow *osWindow, QueriedCaps *capsOut);
+
+    std::array<OSWindow *, 2> mOSWindows;
+};
+
+void EGLDisplayCapsTest::queryCaps(const OSWindow *osWindow, QueriedCaps *capsOut)
+{
+    auto eglGetPlatformDisplayEXT = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+        eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    ASSERT_NE(nullptr, eglGetPlatformDisplayEXT);
+
+    const auto &platform = GetParam().eglParameters;
+
+    std::vector<EGLint> displayAttributes;
+    displayAttributes.push_back(EGL_PLATFORM_ANGLE_TYPE_ANGLE);
+    displayAttributes.push_back(platform.renderer);
+    displayAttributes.push_back(EGL_PLATFORM_ANGLE_MAX_VERSION_MAJOR_ANGLE);
+    displayAttributes.push_back(platform.majorVersion);
+    displayAttributes.push_back(EGL_PLATFORM_ANGLE_MAX_VERSION_MINOR_ANGLE);
+    displayAttributes.push_back(platform.minorVersion);
+
+    if (platform.deviceType != EGL_DONT_CARE)
+    {
+        displayAttributes.push_back(EGL_PLATFORM_ANGLE_DEVICE_TYPE_ANGLE);
+        displayAttributes.push_back(platform.deviceType);
+    }
+
+    displayAttributes.push_back(EGL_NONE);
+
+    EGLDisplay display = eglGetPlatformDisplayEXT(
+        EGL_PLATFORM_ANGLE_ANGLE, reinterpret_cast<void *>(osWindow->getNativeDisplay()),
+        &displayAttributes[0]);
+    ASSERT_NE(EGL_NO_DISPLAY, display);
+    ASSERT_EGL_TRUE(eglInitialize(display, nullptr, nullptr));
+
+    const EGLint configAttributes[] = {EGL_RED_SIZE,     8, EGL_GREEN_SIZE,   8,
+                                       EGL_BLUE_SIZE,    8, EGL_ALPHA_SIZE,   8,
+                                       EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_NONE};
+    EGLConfig config   = nullptr;
+    EGLint configCount = 0;
+    ASSERT_EGL_TRUE(eglChooseConfig(display, configAttributes, &config, 1, &configCount));
+    ASSERT_EQ(1, configCount);
+
+    const EGLint surfaceAttributes[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+    EGLSurface surface = eglCreatePbufferSurface(display, config, surfaceAttributes);
+    ASSERT_NE(EGL_NO_SURFACE, surface);
+
+    const EGLint contextAttributes[] = {EGL_CONTEXT_CLIENT_VERSION, GetParam().majorVersion,
+                                        EGL_NONE};
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+    ASSERT_NE(EGL_NO_CONTEXT, context);
+    ASSERT_EGL_TRUE(eglMakeCurrent(display, surface, surface, context));
+
+    capsOut->eglExtensions = eglQueryString(display, EGL_EXTENSIONS);
+    capsOut->glVersion     = reinterpret_cast<const char *>(glGetString(GL_VERSION));
+    capsOut->glExtensions  = reinterpret_cast<const char *>(glGetString(GL_EXTENSIONS));
+
+    capsOut->limits.clear();
+    for (GLenum limit : kQueriedLimits)
+    {
+        GLint value = 0;
+        glGetIntegerv(limit, &value);
+        capsOut->limits.push_back(value);
+    }
+
+    capsOut->compressedTextureFormats.resize(capsOut->limits.back());
+    if (!capsOut->compressedTextureFormats.empty())
+    {
+        glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, capsOut->compressedTextureFormats.data());
+    }
+    EXPECT_GL_NO_ERROR();
+
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(display, context);
+    eglDestroySurface(display, surface);
+    eglTerminate(display);
+    ASSERT_EGL_SUCCESS();
+}
+
+void ExpectSameCaps(const QueriedCaps &expected, const QueriedCaps &actual)
+{
+    EXPECT_EQ(expected.eglExtensions, actual.eglExtensions);
+    EXPECT_EQ(expected.glVersion, actual.glVersion);
+    EXPECT_EQ(expected.glExtensions, actual.glExtensions);
+    for (size_t limitIndex = 0; limitIndex < ArraySize(kQueriedLimits); ++limitIndex)
+    {
+        EXPECT_EQ(expected.limits[limitIndex], actual.limits[limitIndex])
+            << "Limit 0x" << std::hex << kQueriedLimits[limitIndex];
+    }
+    EXPECT_EQ(expected.compressedTextureFormats, actual.compressedTextureFormats);
+}
+
+// Test that a second display, and a display initialized again after eglTerminate, get the same
+// caps and extensions as the first one, even when they come from the caps it generated.
+TEST_P(EGLDisplayCapsTest, SameCapsAcrossDisplays)
+{
+    QueriedCaps firstCaps;
+    ASSERT_NO_FATAL_FAILURE(queryCaps(mOSWindows[0], &firstCaps));
+
+    QueriedCaps secondCaps;
+    ASSERT_NO_FATAL_FAILURE(queryCaps(mOSWindows[1], &secondCaps));
+    ExpectSameCaps(firstCaps, secondCaps);
+
+    QueriedCaps reinitializedCaps;
+    ASSERT_NO_FATAL_FAILURE(queryCaps(mOSWindows[0], &reinitializedCaps));
+    ExpectSameCaps(firstCaps, reinitializedCaps);
+}
+
+}  // anonymous namespace
+
+ANGLE_INSTANTIATE_TEST(EGLDisplayCapsTest,
+                       ES2_D3D9(),
+                       ES2_D3D11(),
+                       ES2_OPENGL(),
+                       ES3_OPENGL(),
+                       ES2_OPENGLES(),
+                       ES3_OPENGLES(),
+                       ES2_NULL());
@@ -0,0 +1,252 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ImageDataRoundTripTest:
+//   Tests that the data of textures and renderbuffers survives uploads, copies, blits and mipmap
+//   generation and reads back unchanged. None of the tests draw, so that they also run on the null
+//   back-end with the reference device, which keeps the image data. The null back-end runs the ES2
+//   tests in an ES3 context, where the 8-bit formats are renderable.
+//
+
+#include "test_utils/ANGLETest.h"
+#include "test_utils/gl_raii.h"
+
+using namespace angle;
+
+namespace
+{
+
+class ImageDataRoundTripTest : public ANGLETest
+{
+  protected:
+    ImageDataRoundTripTest()
+    {
+        setWindowWidth(16);
+        setWindowHeight(16);
+        setConfigRedBits(8);
+        setConfigGreenBits(8);
+        setConfigBlueBits(8);
+        setConfigAlphaBits(8);
+    }
+
+    // Fills a |width|x|height| image with a pattern that differs for every pixel.
+    static std::vector<GLColor> MakePattern(GLsizei width, GLsizei height)
+    {
+        std::vector<GLColor> pixels;
+        for (GLsizei y = 0; y < height; ++y)
+        {
+            for (GLsizei x = 0; x < width; ++x)
+            {
+                pixels.push_back(GLColor(static_cast<GLubyte>(x * 16), static_cast<GLubyte>(y * 16),
+                                         static_cast<GLubyte>(x + y), 255));
+            }
+        }
+        return pixels;
+    }
+
+    // Attaches a mip of a 2D texture to |framebuffer| and checks it contains |expected|.
+    void expectTextureData(GLuint framebuffer,
+                           GLuint texture,
+                           GLint level,
+                           GLsizei width,
+                           GLsizei height,
+                           const std::vector<GLColor> &expected)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, level);
+        ASSERT_GLENUM_EQ(GL_FRAMEBUFFER_COMPLETE, glCheckFramebufferStatus(GL_FRAMEBUFFER));
+
+        std::vector<GLColor> actual(width * height);
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, actual.data());
+        ASSERT_GL_NO_ERROR();
+        EXPECT_EQ(expected, actual);
+    }
+};
+
+class ImageDataRoundTripTestES3 : public ImageDataRoundTripTest
+{
+};
+
+// Uploads and sub-uploads read back unchanged.
+TEST_P(ImageDataRoundTripTest, TexImageAndSubImage)
+{
+    std::vector<GLColor> pixels = MakePattern(8, 8);
+
+    GLTexture texture;
+    glBindTexture(GL_TEXTURE_2D, texture.get());
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 8, 8, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+    GLFramebuffer framebuffer;
+    expectTextureData(framebuffer.get(), texture.get(), 0, 8, 8, pixels);
+
+    std::vector<GLColor> subPixels(2 * 3, GLColor::cyan);
+    glBindTexture(GL_TEXTURE_2D, texture.get());
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 5, 4, 2, 3, GL_RGBA, GL_UNSIGNED_BYTE, subPixels.data());
+    for (GLint y = 4; y < 7; ++y)
+    {
+        pixels[y * 8 + 5] = GLColor::cyan;
+        pixels[y * 8 + 6] = GLColor::cyan;
+    }
+    expectTextureData(framebuffer.get(), texture.get(), 0, 8, 8, pixels);
+}
+
+// Uploads of a format that is stored converted read back the same values.
+TEST_P(ImageDataRoundTripTest, ConvertedUpload)
+{
+    std::vector<GLubyte> rgbPixels;
+    std::vector<GLColor> expected;
+    for (GLubyte index = 0; index < 16; ++index)
+    {
+        rgbPixels.push_back(index * 16);
+        rgbPixels.push_back(255 - index);
+        rgbPixels.push_back(index);
+        expected.push_back(GLColor(index * 16, 255 - index, index, 255));
+    }
+
+    GLTexture texture;
+    glBindTexture(GL_TEXTURE_2D, texture.get());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 4, 4, 0, GL_RGB, GL_UNSIGNED_BYTE, rgbPixels.data());
+
+    GLFramebuffer framebuffer;
+    expectTextureData(framebuffer.get(), texture.get(), 0, 4, 4, expected);
+}
+
+// Copies from a texture framebuffer into textures read back the copied area.
+TEST_P(ImageDataRoundTripTest, CopyTexImage)
+{
+    std::vector<GLColor> pixels = MakePattern(8, 8);
+
+    GLTexture source;
+    glBindTexture(GL_TEXTURE_2D, source.get());
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 8, 8, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+    GLFramebuffer sourceFramebuffer;
+    glBindFramebuffer(GL_FRAMEBUFFER, sourceFramebuffer.get());
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, source.get(), 0);
+
+    GLTexture dest;
+    glBindTexture(GL_TEXTURE_2D, dest.get());
+    glCopyTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 2, 3, 4, 4, 0);
+    glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 6, 6, 2, 1);
+    ASSERT_GL_NO_ERROR();
+
+    std::vector<GLColor> expected;
+    for (GLint y = 0; y < 4; ++y)
+    {
+        for (GLint x = 0; x < 4; ++x)
+        {
+            bool subCopied = y == 0 && x < 2;
+            expected.push_back(subCopied ? pixels[6 * 8 + 6 + x] : pixels[(3 + y) * 8 + 2 + x]);
+        }
+    }
+
+    GLFramebuffer destFramebuffer;
+    expectTextureData(destFramebuffer.get(), dest.get(), 0, 4, 4, expected);
+}
+
+// Generated mips are the averages of the previous level.
+TEST_P(ImageDataRoundTripTest, GenerateMipmap)
+{
+    std::vector<GLColor> pixels = {GLColor(0, 40, 100, 255), GLColor(20, 40, 100, 255),
+                                   GLColor(40, 80, 100, 255), GLColor(60, 80, 100, 255)};
+
+    GLTexture texture;
+    glBindTexture(GL_TEXTURE_2D, texture.get());
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 2, 2, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    glGenerateMipmap(GL_TEXTURE_2D);
+    ASSERT_GL_NO_ERROR();
+
+    GLFramebuffer framebuffer;
+    expectTextureData(framebuffer.get(), texture.get(), 1, 1, 1, {GLColor(30, 60, 100, 255)});
+}
+
+// Blits between textures and renderbuffers read back the blitted area, scaled and flipped.
+TEST_P(ImageDataRoundTripTestES3, BlitFramebuffer)
+{
+    std::vector<GLColor> pixels = MakePattern(4, 4);
+
+    GLTexture source;
+    glBindTexture(GL_TEXTURE_2D, source.get());
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 4, 4, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+    GLFramebuffer sourceFramebuffer;
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, sourceFramebuffer.get());
+    glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, source.get(),
+                           0);
+
+    GLRenderbuffer renderbuffer;
+    glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer.get());
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, 8, 8);
+
+    GLFramebuffer destFramebuffer;
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, destFramebuffer.get());
+    glFramebufferRenderbuffer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER,
+                              renderbuffer.get());
+    ASSERT_GLENUM_EQ(GL_FRAMEBUFFER_COMPLETE, glCheckFramebufferStatus(GL_DRAW_FRAMEBUFFER));
+
+    // Upscaled twice, and flipped vertically.
+    glBlitFramebuffer(0, 0, 4, 4, 0, 8, 8, 0, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    ASSERT_GL_NO_ERROR();
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, destFramebuffer.get());
+    std::vector<GLColor> actual(8 * 8);
+    glReadPixels(0, 0, 8, 8, GL_RGBA, GL_UNSIGNED_BYTE, actual.data());
+    ASSERT_GL_NO_ERROR();
+
+    for (GLint y = 0; y < 8; ++y)
+    {
+        for (GLint x = 0; x < 8; ++x)
+        {
+            EXPECT_EQ(pixels[(3 - y / 2) * 4 + x / 2], actual[y * 8 + x]) << x << ", " << y;
+        }
+    }
+}
+
+// Pixel buffers are unpacked from and packed into.
+TEST_P(ImageDataRoundTripTestES3, PixelBuffers)
+{
+    std::vector<GLColor> pixels = MakePattern(4, 4);
+
+    GLBuffer unpackBuffer;
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, unpackBuffer.get());
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, pixels.size() * sizeof(GLColor), pixels.data(),
+                 GL_STATIC_DRAW);
+
+    GLTexture texture;
+    glBindTexture(GL_TEXTURE_2D, texture.get());
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 4, 4, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    GLFramebuffer framebuffer;
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer.get());
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture.get(), 0);
+
+    GLBuffer packBuffer;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, packBuffer.get());
+    glBufferData(GL_PIXEL_PACK_BUFFER, pixels.size() * sizeof(GLColor), nullptr, GL_STATIC_READ);
+    glReadPixels(0, 0, 4, 4, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    const GLColor *mapped = static_cast<const GLColor *>(glMapBufferRange(
+        GL_PIXEL_PACK_BUFFER, 0, pixels.size() * sizeof(GLColor), GL_MAP_READ_BIT));
+    ASSERT_NE(nullptr, mapped);
+    EXPECT_EQ(pixels, std::vector<GLColor>(mapped, mapped + pixels.size()));
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    ASSERT_GL_NO_ERROR();
+}
+
+}  // anonymous namespace
+
+ANGLE_INSTANTIATE_TEST(ImageDataRoundTripTest,
+                       ES2_D3D9(),
+                       ES2_D3D11(),
+                       ES2_OPENGL(),
+                       ES2_OPENGLES(),
+                       ES3_NULL_REFERENCE());
+ANGLE_INSTANTIATE_TEST(ImageDataRoundTripTestES3,
+                       ES3_D3D11(),
+                       ES3_OPENGL(),
+                       ES3_OPENGLES(),
+                       ES3_NULL_REFERENCE());
@@ -0,0 +1,262 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ParallelShaderCompileTest:
+//   Tests that shader compiles and program links, which may finish on worker threads, are
+//   resolved correctly whenever their results are observed.
+//
+
+#include "test_utils/ANGLETest.h"
+
+#include <sstream>
+
+using namespace angle;
+
+namespace
+{
+
+constexpr char kVertexShader[] =
+    "attribute vec4 position;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_Position = position;\n"
+    "}\n";
+
+constexpr char kBrokenShader[] =
+    "void main()\n"
+    "{\n"
+    "    undefinedVariable = 1.0;\n"
+    "}\n";
+
+std::string MakeFragmentShader(unsigned int index)
+{
+    std::stringstream strstr;
+    strstr << "precision mediump float;\n"
+              "uniform vec4 color"
+           << index << ";\n"
+                       "void main()\n"
+                       "{\n"
+                       "    gl_FragColor = color"
+           << index << ";\n"
+                       "}\n";
+    return strstr.str();
+}
+
+GLuint CreateShader(GLenum type, const std::string &source)
+{
+    GLuint shader           = glCreateShader(type);
+    const char *sourceArray = source.c_str();
+    glShaderSource(shader, 1, &sourceArray, nullptr);
+    return shader;
+}
+
+GLint GetShaderParameter(GLuint shader, GLenum pname)
+{
+    GLint value = 0;
+    glGetShaderiv(shader, pname, &value);
+    return value;
+}
+
+GLint GetProgramParameter(GLuint program, GLenum pname)
+{
+    GLint value = 0;
+    glGetProgramiv(program, pname, &value);
+    return value;
+}
+
+class ParallelShaderCompileTest : public ANGLETest
+{
+  protected:
+    ParallelShaderCompileTest()
+    {
+        setWindowWidth(64);
+        setWindowHeight(64);
+        setConfigRedBits(8);
+        setConfigGreenBits(8);
+        setConfigBlueBits(8);
+        setConfigAlphaBits(8);
+    }
+};
+
+// Test that compiling and linking many programs before querying any results works.
+TEST_P(ParallelShaderCompileTest, ManyProgramsBeforeQuery)
+{
+    constexpr unsigned int kProgramCount = 16;
+
+    std::vector<GLuint> vertexShaders;
+    std::vector<GLuint> fragmentShaders;
+    std::vector<GLuint> programs;
+
+    for (unsigned int index = 0; index < kProgramCount; ++index)
+    {
+        GLuint vertexShader   = CreateShader(GL_VERTEX_SHADER, kVertexShader);
+        GLuint fragmentShader = CreateShader(GL_FRAGMENT_SHADER, MakeFragmentShader(index));
+        glCompileShader(vertexShader);
+        glCompileShader(fragmentShader);
+        vertexShaders.push_back(vertexShader);
+        fragmentShaders.push_back(fragmentShader);
+    }
+
+    for (unsigned int index = 0; index < kProgramCount; ++index)
+    {
+        GLuint program = glCreateProgram();
+        glAttachShader(program, vertexShaders[index]);
+        glAttachShader(program, fragmentShaders[index]);
+        glLinkProgram(program);
+        programs.push_back(program);
+    }
+    ASSERT_GL_NO_ERROR();
+
+    for (unsigned int index = 0; index < kProgramCount; ++index)
+    {
+        EXPECT_GL_TRUE(GetShaderParameter(vertexShaders[index], GL_COMPILE_STATUS));
+        EXPECT_GL_TRUE(GetShaderParameter(fragmentShaders[index], GL_COMPILE_STATUS));
+        EXPECT_GL_TRUE(GetProgramParameter(programs[index], GL_LINK_STATUS));
+
+        std::stringstream uniformName;
+        uniformName << "color" << index;
+        EXPECT_NE(-1, glGetUniformLocation(programs[index], uniformName.str().c_str()));
+    }
+
+    for (unsigned int index = 0; index < kProgramCount; ++index)
+    {
+        glDeleteProgram(programs[index]);
+        glDeleteShader(vertexShaders[index]);
+        glDeleteShader(fragmentShaders[index]);
+    }
+    ASSERT_GL_NO_ERROR();
+}
+
+// Test that the info log of a failed compile is available without querying the status first.
+TEST_P(ParallelShaderCompileTest, InfoLogOfPendingCompile)
+{
+    GLuint shader = CreateShader(GL_FRAGMENT_SHADER, kBrokenShader);
+    glCompileShader(shader);
+
+    EXPECT_GT(GetShaderParameter(shader, GL_INFO_LOG_LENGTH), 1);
+    EXPECT_GL_FALSE(GetShaderParameter(shader, GL_COMPILE_STATUS));
+
+    glDeleteShader(shader);
+    ASSERT_GL_NO_ERROR();
+}
+
+// Test that recompiling a shader while a link that uses it is pending doesn't affect the link.
+TEST_P(ParallelShaderCompileTest, RecompileDuringLink)
+{
+    GLuint vertexShader   = CreateShader(GL_VERTEX_SHADER, kVertexShader);
+    GLuint fragmentShader = CreateShader(GL_FRAGMENT_SHADER, MakeFragmentShader(0));
+    glCompileShader(vertexShader);
+    glCompileShader(fragmentShader);
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+
+    const char *brokenSource = kBrokenShader;
+    glShaderSource(fragmentShader, 1, &brokenSource, nullptr);
+    glCompileShader(fragmentShader);
+
+    EXPECT_GL_TRUE(GetProgramParameter(program, GL_LINK_STATUS));
+    EXPECT_NE(-1, glGetUniformLocation(program, "color0"));
+    EXPECT_GL_FALSE(GetShaderParameter(fragmentShader, GL_COMPILE_STATUS));
+
+    // The next link sees the failed compile.
+    glLinkProgram(program);
+    EXPECT_GL_FALSE(GetProgramParameter(program, GL_LINK_STATUS));
+
+    glDeleteProgram(program);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+    ASSERT_GL_NO_ERROR();
+}
+
+// Test that deleting shaders and programs with a pending compile or link is safe.
+TEST_P(ParallelShaderCompileTest, DeleteWhilePending)
+{
+    GLuint vertexShader   = CreateShader(GL_VERTEX_SHADER, kVertexShader);
+    GLuint fragmentShader = CreateShader(GL_FRAGMENT_SHADER, MakeFragmentShader(0));
+    glCompileShader(vertexShader);
+    glCompileShader(fragmentShader);
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+
+    // Shaders are only flagged for deletion while attached.
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+    glDeleteProgram(program);
+    ASSERT_GL_NO_ERROR();
+
+    GLuint unusedShader = CreateShader(GL_FRAGMENT_SHADER, MakeFragmentShader(1));
+    glCompileShader(unusedShader);
+    glDeleteShader(unusedShader);
+    ASSERT_GL_NO_ERROR();
+}
+
+// Test that relinking the program in use takes effect for the next draw.
+TEST_P(ParallelShaderCompileTest, RelinkProgramInUse)
+{
+    GLuint vertexShader   = CreateShader(GL_VERTEX_SHADER, kVertexShader);
+    GLuint fragmentShader = CreateShader(GL_FRAGMENT_SHADER, MakeFragmentShader(0));
+    glCompileShader(vertexShader);
+    glCompileShader(fragmentShader);
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+    glUseProgram(program);
+    ASSERT_GL_NO_ERROR();
+
+    GLuint newFragmentShader = CreateShader(GL_FRAGMENT_SHADER, MakeFragmentShader(1));
+    glCompileShader(newFragmentShader);
+    glDetachShader(program, fragmentShader);
+    glAttachShader(program, newFragmentShader);
+    glLinkProgram(program);
+
+    drawQuad(program, "position", 0.5f);
+    ASSERT_GL_NO_ERROR();
+
+    EXPECT_EQ(-1, glGetUniformLocation(program, "color0"));
+    EXPECT_NE(-1, glGetUniformLocation(program, "color1"));
+
+    glUseProgram(0);
+    glDeleteProgram(program);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+    glDeleteShader(newFragmentShader);
+    ASSERT_GL_NO_ERROR();
+}
+
+// Test that releasing the shader compiler with a compile in flight doesn't lose its result.
+TEST_P(ParallelShaderCompileTest, ReleaseCompilerDuringCompile)
+{
+    GLuint shader = CreateShader(GL_FRAGMENT_SHADER, MakeFragmentShader(0));
+    glCompileShader(shader);
+    glReleaseShaderCompiler();
+
+    EXPECT_GL_TRUE(GetShaderParameter(shader, GL_COMPILE_STATUS));
+
+    // The compiler is usable again after a release.
+    glCompileShader(shader);
+    EXPECT_GL_TRUE(GetShaderParameter(shader, GL_COMPILE_STATUS));
+
+    glDeleteShader(shader);
+    ASSERT_GL_NO_ERROR();
+}
+
+ANGLE_INSTANTIATE_TEST(ParallelShaderCompileTest,
+                       ES2_D3D9(),
+                       ES2_D3D11(),
+                       ES2_OPENGL(),
+                       ES2_OPENGLES(),
+                       ES2_VULKAN(),
+                       ES2_NULL(),
+                       ES3_NULL());
+
+}  // anonymous namespace
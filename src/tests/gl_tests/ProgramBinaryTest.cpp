@@ -11,6 +11,7 @@
 
 #include "EGLWindow.h"
 #include "OSWindow.h"
+#include "libANGLE/ProgramBinaryFormat.h"
 #include "test_utils/angle_test_configs.h"
 #include "test_utils/gl_raii.h"
 
@@ -335,6 +336,258 @@ TEST_P(ProgramBinaryES3Test, UniformBlockBindingNoDraw)
 
 ANGLE_INSTANTIATE_TEST(ProgramBinaryES3Test, ES3_D3D11(), ES3_OPENGL(), ES3_OPENGLES());
 
+class ProgramBinaryIntrospectionTest : public ANGLETest
+{
+  protected:
+    void SetUp() override
+    {
+        ANGLETest::SetUp();
+
+        const std::string &vertexShader =
+            "#version 300 es\n"
+            "uniform block {\n"
+            "    mat2 m;\n"
+            "    float f[3];\n"
+            "};\n"
+            "uniform vec3 offsets[4];\n"
+            "uniform float scale;\n"
+            "in vec4 position;\n"
+            "in vec2 texCoord;\n"
+            "out vec2 coord;\n"
+            "void main() {\n"
+            "    gl_Position = position * scale + vec4(offsets[3], m[1][1] + f[2]);\n"
+            "    coord = texCoord;\n"
+            "}";
+        const std::string &fragmentShader =
+            "#version 300 es\n"
+            "precision mediump float;\n"
+            "uniform sampler2D tex[2];\n"
+            "in vec2 coord;\n"
+            "layout(location = 1) out vec4 colorOut;\n"
+            "void main() {\n"
+            "    colorOut = texture(tex[0], coord) + texture(tex[1], coord);\n"
+            "}";
+
+        mProgram = CompileProgram(vertexShader, fragmentShader);
+        ASSERT_NE(0u, mProgram);
+
+        GLint programLength = 0;
+        glGetProgramiv(mProgram, GL_PROGRAM_BINARY_LENGTH, &programLength);
+        mBinary.resize(programLength);
+
+        GLsizei readLength = 0;
+        glGetProgramBinary(mProgram, programLength, &readLength, &mBinaryFormat, mBinary.data());
+        ASSERT_GL_NO_ERROR();
+        ASSERT_EQ(programLength, readLength);
+    }
+
+    void TearDown() override
+    {
+        glDeleteProgram(mProgram);
+        ANGLETest::TearDown();
+    }
+
+    // Loads |binary| in a new program and returns its link status.
+    GLint loadBinary(GLuint program, const uint8_t *binary, size_t length)
+    {
+        glProgramBinary(program, mBinaryFormat, binary, static_cast<GLsizei>(length));
+        EXPECT_GL_NO_ERROR();
+
+        GLint linkStatus = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+        return linkStatus;
+    }
+
+    // Checks that the active resources of |program| are those of mProgram.
+    void expectSameResources(GLuint program)
+    {
+        for (GLenum query : {GL_ACTIVE_ATTRIBUTES, GL_ACTIVE_UNIFORMS, GL_ACTIVE_UNIFORM_BLOCKS})
+        {
+            GLint expected = 0;
+            GLint actual   = 0;
+            glGetProgramiv(mProgram, query, &expected);
+            glGetProgramiv(program, query, &actual);
+            EXPECT_EQ(expected, actual);
+        }
+
+        GLint attribCount = 0;
+        glGetProgramiv(mProgram, GL_ACTIVE_ATTRIBUTES, &attribCount);
+        for (GLint index = 0; index < attribCount; ++index)
+        {
+            std::string name = getActiveAttrib(mProgram, index);
+            EXPECT_EQ(name, getActiveAttrib(program, index));
+            EXPECT_EQ(glGetAttribLocation(mProgram, name.c_str()),
+                      glGetAttribLocation(program, name.c_str()));
+        }
+
+        GLint uniformCount = 0;
+        glGetProgramiv(mProgram, GL_ACTIVE_UNIFORMS, &uniformCount);
+        for (GLint index = 0; index < uniformCount; ++index)
+        {
+            std::string name = getActiveUniform(mProgram, index);
+            EXPECT_EQ(name, getActiveUniform(program, index));
+            EXPECT_EQ(glGetUniformLocation(mProgram, name.c_str()),
+                      glGetUniformLocation(program, name.c_str()));
+
+            GLuint uniformIndex = static_cast<GLuint>(index);
+            for (GLenum pname : {GL_UNIFORM_BLOCK_INDEX, GL_UNIFORM_OFFSET,
+                                 GL_UNIFORM_ARRAY_STRIDE, GL_UNIFORM_MATRIX_STRIDE})
+            {
+                GLint expected = 0;
+                GLint actual   = 0;
+                glGetActiveUniformsiv(mProgram, 1, &uniformIndex, pname, &expected);
+                glGetActiveUniformsiv(program, 1, &uniformIndex, pname, &actual);
+                EXPECT_EQ(expected, actual) << name;
+            }
+        }
+
+        GLuint blockIndex = glGetUniformBlockIndex(mProgram, "block");
+        ASSERT_NE(GL_INVALID_INDEX, blockIndex);
+        EXPECT_EQ(blockIndex, glGetUniformBlockIndex(program, "block"));
+        for (GLenum pname : {GL_UNIFORM_BLOCK_DATA_SIZE, GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS})
+        {
+            GLint expected = 0;
+            GLint actual   = 0;
+            glGetActiveUniformBlockiv(mProgram, blockIndex, pname, &expected);
+            glGetActiveUniformBlockiv(program, blockIndex, pname, &actual);
+            EXPECT_EQ(expected, actual);
+        }
+
+        EXPECT_EQ(1, glGetFragDataLocation(program, "colorOut"));
+        ASSERT_GL_NO_ERROR();
+    }
+
+    // Returns a copy of mBinary in which |modify| changed the first record of |table|.
+    template <typename RecordT, typename ModifyT>
+    std::vector<uint8_t> modifyFirstRecord(gl::ProgramBinaryTableID table, ModifyT modify) const
+    {
+        gl::ProgramBinaryHeader header;
+        memcpy(&header, mBinary.data(), sizeof(header));
+        EXPECT_LT(0u, header.tables[table].count);
+
+        std::vector<uint8_t> binary = mBinary;
+        RecordT record;
+        memcpy(&record, &binary[header.tables[table].offset], sizeof(record));
+        modify(&record);
+        memcpy(&binary[header.tables[table].offset], &record, sizeof(record));
+        return binary;
+    }
+
+    static std::string getActiveAttrib(GLuint program, GLint index)
+    {
+        char name[64] = {};
+        GLint size    = 0;
+        GLenum type   = GL_NONE;
+        glGetActiveAttrib(program, index, sizeof(name), nullptr, &size, &type, name);
+        return name;
+    }
+
+    static std::string getActiveUniform(GLuint program, GLint index)
+    {
+        char name[64] = {};
+        GLint size    = 0;
+        GLenum type   = GL_NONE;
+        glGetActiveUniform(program, index, sizeof(name), nullptr, &size, &type, name);
+        return name;
+    }
+
+    GLuint mProgram      = 0;
+    GLenum mBinaryFormat = GL_NONE;
+    std::vector<uint8_t> mBinary;
+};
+
+// A reloaded binary has the same resources, locations and block layout as the linked program.
+TEST_P(ProgramBinaryIntrospectionTest, ReloadedResources)
+{
+    GLuint program = glCreateProgram();
+    ASSERT_EQ(GL_TRUE, loadBinary(program, mBinary.data(), mBinary.size()));
+    expectSameResources(program);
+    glDeleteProgram(program);
+}
+
+// A binary that isn't aligned in the application's memory loads the same.
+TEST_P(ProgramBinaryIntrospectionTest, UnalignedBinary)
+{
+    std::vector<uint8_t> unaligned(mBinary.size() + 1);
+    std::copy(mBinary.begin(), mBinary.end(), unaligned.begin() + 1);
+
+    GLuint program = glCreateProgram();
+    ASSERT_EQ(GL_TRUE, loadBinary(program, unaligned.data() + 1, mBinary.size()));
+    expectSameResources(program);
+    glDeleteProgram(program);
+}
+
+// Truncated and corrupted binaries fail to link rather than load garbage.
+TEST_P(ProgramBinaryIntrospectionTest, InvalidBinaries)
+{
+    GLuint program = glCreateProgram();
+
+    EXPECT_EQ(GL_FALSE, loadBinary(program, mBinary.data(), mBinary.size() / 2));
+    EXPECT_EQ(GL_FALSE, loadBinary(program, mBinary.data(), 8));
+
+    std::vector<uint8_t> corrupted = mBinary;
+    corrupted[0] ^= 0xFF;
+    EXPECT_EQ(GL_FALSE, loadBinary(program, corrupted.data(), corrupted.size()));
+
+    // Points every table and string past the end of the binary.
+    corrupted = mBinary;
+    for (size_t offset = 32; offset < std::min<size_t>(corrupted.size(), 512); offset += 4)
+    {
+        corrupted[offset + 3] |= 0x40;
+    }
+    EXPECT_EQ(GL_FALSE, loadBinary(program, corrupted.data(), corrupted.size()));
+
+    // The program still loads a valid binary afterwards.
+    EXPECT_EQ(GL_TRUE, loadBinary(program, mBinary.data(), mBinary.size()));
+    glDeleteProgram(program);
+}
+
+// Binaries whose records refer to resources that aren't in them fail to link, rather than make
+// the queries by name read past the resource lists.
+TEST_P(ProgramBinaryIntrospectionTest, OutOfRangeReferences)
+{
+    using namespace gl;
+
+    constexpr uint32_t kOutOfRange = 1000;
+    auto setNameIndexValue         = [](ProgramBinaryNameIndexEntry *entry) {
+        entry->value = kOutOfRange;
+    };
+
+    std::vector<std::vector<uint8_t>> binaries;
+    binaries.push_back(modifyFirstRecord<ProgramBinaryNameIndexEntry>(
+        PROGRAM_BINARY_ATTRIBUTE_INDEX, setNameIndexValue));
+    binaries.push_back(modifyFirstRecord<ProgramBinaryNameIndexEntry>(
+        PROGRAM_BINARY_UNIFORM_INDEX, setNameIndexValue));
+    binaries.push_back(modifyFirstRecord<ProgramBinaryNameIndexEntry>(
+        PROGRAM_BINARY_UNIFORM_LOCATION_INDEX, setNameIndexValue));
+    binaries.push_back(modifyFirstRecord<ProgramBinaryNameIndexEntry>(
+        PROGRAM_BINARY_UNIFORM_BLOCK_INDEX, setNameIndexValue));
+    binaries.push_back(modifyFirstRecord<ProgramBinaryNameIndexEntry>(
+        PROGRAM_BINARY_OUTPUT_VARIABLE_INDEX, setNameIndexValue));
+    binaries.push_back(modifyFirstRecord<ProgramBinaryVariableLocation>(
+        PROGRAM_BINARY_OUTPUT_LOCATIONS,
+        [](ProgramBinaryVariableLocation *location) { location->index = kOutOfRange; }));
+    binaries.push_back(modifyFirstRecord<ProgramBinaryUniform>(
+        PROGRAM_BINARY_UNIFORMS,
+        [](ProgramBinaryUniform *uniform) { uniform->blockIndex = kOutOfRange; }));
+
+    GLuint program = glCreateProgram();
+    for (size_t binaryIndex = 0; binaryIndex < binaries.size(); ++binaryIndex)
+    {
+        const std::vector<uint8_t> &binary = binaries[binaryIndex];
+        EXPECT_EQ(GL_FALSE, loadBinary(program, binary.data(), binary.size())) << binaryIndex;
+    }
+
+    EXPECT_EQ(GL_TRUE, loadBinary(program, mBinary.data(), mBinary.size()));
+    glDeleteProgram(program);
+}
+
+ANGLE_INSTANTIATE_TEST(ProgramBinaryIntrospectionTest,
+                       ES3_D3D11(),
+                       ES3_OPENGL(),
+                       ES3_OPENGLES(),
+                       ES3_NULL());
+
 class ProgramBinaryES31Test : public ANGLETest
 {
   protected:
@@ -527,6 +780,107 @@ ANGLE_INSTANTIATE_TEST(ProgramBinaryTransformFeedbackTest,
                        ES3_D3D11(),
                        ES3_OPENGL());
 
+class ProgramCacheTest : public ANGLETest
+{
+  protected:
+    ProgramCacheTest()
+    {
+        setWindowWidth(64);
+        setWindowHeight(64);
+        setConfigRedBits(8);
+        setConfigGreenBits(8);
+        setConfigBlueBits(8);
+        setConfigAlphaBits(8);
+        setProgramCacheEnabled(true);
+    }
+};
+
+// Tests that a program loaded from the program cache draws like the original link.
+TEST_P(ProgramCacheTest, RelinkIdenticalProgram)
+{
+    const std::string vertexShader =
+        "attribute vec4 position;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_Position = position;\n"
+        "}";
+    const std::string fragmentShader =
+        "precision mediump float;\n"
+        "uniform vec4 color;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = color;\n"
+        "}";
+
+    // The second link is served from the cache.
+    for (int iteration = 0; iteration < 2; ++iteration)
+    {
+        ANGLE_GL_PROGRAM(program, vertexShader, fragmentShader);
+        glUseProgram(program);
+
+        GLint colorLocation = glGetUniformLocation(program, "color");
+        ASSERT_NE(-1, colorLocation);
+        glUniform4f(colorLocation, 0.0f, 1.0f, 0.0f, 1.0f);
+
+        glClear(GL_COLOR_BUFFER_BIT);
+        drawQuad(program, "position", 0.5f);
+        ASSERT_GL_NO_ERROR();
+        EXPECT_PIXEL_COLOR_EQ(getWindowWidth() / 2, getWindowHeight() / 2, GLColor::green);
+    }
+}
+
+// Tests that attribute bindings are part of the cache key.
+TEST_P(ProgramCacheTest, DifferentAttribBindings)
+{
+    const std::string vertexShader =
+        "attribute vec4 position;\n"
+        "attribute vec4 color;\n"
+        "varying vec4 v_color;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_Position = position;\n"
+        "    v_color = color;\n"
+        "}";
+    const std::string fragmentShader =
+        "precision mediump float;\n"
+        "varying vec4 v_color;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = v_color;\n"
+        "}";
+
+    for (GLuint colorLocation = 1; colorLocation <= 2; ++colorLocation)
+    {
+        GLuint program = glCreateProgram();
+        GLuint vs      = CompileShader(GL_VERTEX_SHADER, vertexShader);
+        GLuint fs      = CompileShader(GL_FRAGMENT_SHADER, fragmentShader);
+        ASSERT_NE(0u, vs);
+        ASSERT_NE(0u, fs);
+        glAttachShader(program, vs);
+        glAttachShader(program, fs);
+        glDeleteShader(vs);
+        glDeleteShader(fs);
+
+        glBindAttribLocation(program, 0, "position");
+        glBindAttribLocation(program, colorLocation, "color");
+        glLinkProgram(program);
+
+        GLint linkStatus = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+        EXPECT_GL_TRUE(linkStatus);
+        EXPECT_EQ(static_cast<GLint>(colorLocation), glGetAttribLocation(program, "color"));
+
+        glDeleteProgram(program);
+    }
+    ASSERT_GL_NO_ERROR();
+}
+
+ANGLE_INSTANTIATE_TEST(ProgramCacheTest,
+                       ES2_D3D9(),
+                       ES2_D3D11(),
+                       ES2_OPENGL(),
+                       ES2_OPENGLES());
+
 // For the ProgramBinariesAcrossPlatforms tests, we need two sets of params:
 // - a set to save the program binary
 // - a set to load the program binary
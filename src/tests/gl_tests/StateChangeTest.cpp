@@ -582,6 +582,245 @@ TEST_P(StateChangeRenderTest, GenerateMipmap)
     EXPECT_GL_NO_ERROR();
 }
 
+// Unlike StateChangeTest, these tests run with validation enabled. They check that the draw
+// validation cache notices state changes between otherwise identical draw calls.
+class StateChangeValidationTest : public ANGLETest
+{
+  protected:
+    StateChangeValidationTest()
+    {
+        setWindowWidth(64);
+        setWindowHeight(64);
+        setConfigRedBits(8);
+        setConfigGreenBits(8);
+        setConfigBlueBits(8);
+        setConfigAlphaBits(8);
+    }
+
+    void setupVertexBuffer(GLuint program)
+    {
+        const std::array<GLfloat, 6> positions = {{-1.0f, -1.0f, 1.0f, -1.0f, 0.0f, 1.0f}};
+        glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(positions), positions.data(), GL_STATIC_DRAW);
+
+        GLint positionLocation = glGetAttribLocation(program, "position");
+        ASSERT_NE(-1, positionLocation);
+        glVertexAttribPointer(positionLocation, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+        glEnableVertexAttribArray(positionLocation);
+    }
+
+    GLBuffer mVertexBuffer;
+};
+
+class StateChangeValidationTestES3 : public StateChangeValidationTest
+{
+  protected:
+    StateChangeValidationTestES3() {}
+};
+
+// Tests that changing sampler uniforms between draws is caught by draw validation.
+TEST_P(StateChangeValidationTest, ConflictingSamplerTypes)
+{
+    const std::string vertexShader =
+        "attribute vec2 position;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_Position = vec4(position, 0, 1);\n"
+        "}";
+    const std::string fragmentShader =
+        "precision mediump float;\n"
+        "uniform sampler2D tex2D;\n"
+        "uniform samplerCube texCube;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = texture2D(tex2D, vec2(0)) + textureCube(texCube, vec3(0));\n"
+        "}";
+    ANGLE_GL_PROGRAM(program, vertexShader, fragmentShader);
+    glUseProgram(program);
+    setupVertexBuffer(program);
+
+    GLint tex2DLocation   = glGetUniformLocation(program, "tex2D");
+    GLint texCubeLocation = glGetUniformLocation(program, "texCube");
+    ASSERT_NE(-1, tex2DLocation);
+    ASSERT_NE(-1, texCubeLocation);
+
+    glUniform1i(tex2DLocation, 0);
+    glUniform1i(texCubeLocation, 1);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    EXPECT_GL_NO_ERROR();
+
+    // Point both samplers at the same texture unit.
+    glUniform1i(texCubeLocation, 0);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    EXPECT_GL_ERROR(GL_INVALID_OPERATION);
+
+    glUniform1i(texCubeLocation, 1);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    EXPECT_GL_NO_ERROR();
+}
+
+// Tests that switching to no program between draws is caught by draw validation.
+TEST_P(StateChangeValidationTest, UnbindProgram)
+{
+    const std::string vertexShader =
+        "attribute vec2 position;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_Position = vec4(position, 0, 1);\n"
+        "}";
+    const std::string fragmentShader =
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = vec4(1, 0, 0, 1);\n"
+        "}";
+    ANGLE_GL_PROGRAM(program, vertexShader, fragmentShader);
+    glUseProgram(program);
+    setupVertexBuffer(program);
+
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    EXPECT_GL_NO_ERROR();
+
+    glUseProgram(0);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    EXPECT_GL_ERROR(GL_INVALID_OPERATION);
+
+    glUseProgram(program);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    EXPECT_GL_NO_ERROR();
+}
+
+// Tests that re-specifying a vertex buffer's data store between draws is caught by the vertex
+// range checks in draw validation.
+TEST_P(StateChangeValidationTest, ResizeVertexBuffer)
+{
+    const std::string vertexShader =
+        "attribute vec2 position;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_Position = vec4(position, 0, 1);\n"
+        "}";
+    const std::string fragmentShader =
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = vec4(1, 0, 0, 1);\n"
+        "}";
+    ANGLE_GL_PROGRAM(program, vertexShader, fragmentShader);
+    glUseProgram(program);
+    setupVertexBuffer(program);
+
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    EXPECT_GL_NO_ERROR();
+
+    // Shrink the buffer through a binding point that is not the attribute's.
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mVertexBuffer);
+    const std::array<GLfloat, 2> smallData = {{0.0f, 0.0f}};
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(smallData), smallData.data(), GL_STATIC_DRAW);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    EXPECT_GL_ERROR(GL_INVALID_OPERATION);
+
+    // Drawing a single vertex still fits.
+    glDrawArrays(GL_POINTS, 0, 1);
+    EXPECT_GL_NO_ERROR();
+
+    const std::array<GLfloat, 6> largeData = {{-1.0f, -1.0f, 1.0f, -1.0f, 0.0f, 1.0f}};
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(largeData), largeData.data(), GL_STATIC_DRAW);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    EXPECT_GL_NO_ERROR();
+}
+
+// Tests that mapping a bound vertex buffer between draws is caught by draw validation.
+TEST_P(StateChangeValidationTestES3, MapVertexBuffer)
+{
+    const std::string vertexShader =
+        "attribute vec2 position;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_Position = vec4(position, 0, 1);\n"
+        "}";
+    const std::string fragmentShader =
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = vec4(1, 0, 0, 1);\n"
+        "}";
+    ANGLE_GL_PROGRAM(program, vertexShader, fragmentShader);
+    glUseProgram(program);
+    setupVertexBuffer(program);
+
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    EXPECT_GL_NO_ERROR();
+
+    void *mapPointer = glMapBufferRange(GL_ARRAY_BUFFER, 0, 4, GL_MAP_WRITE_BIT);
+    ASSERT_NE(nullptr, mapPointer);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    EXPECT_GL_ERROR(GL_INVALID_OPERATION);
+
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    EXPECT_GL_NO_ERROR();
+
+    // The mapped buffer error is reported before the framebuffer completeness error.
+    GLFramebuffer framebuffer;
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    ASSERT_GLENUM_NE(GL_FRAMEBUFFER_COMPLETE, glCheckFramebufferStatus(GL_FRAMEBUFFER));
+
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    EXPECT_GL_ERROR(GL_INVALID_FRAMEBUFFER_OPERATION);
+
+    mapPointer = glMapBufferRange(GL_ARRAY_BUFFER, 0, 4, GL_MAP_WRITE_BIT);
+    ASSERT_NE(nullptr, mapPointer);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    EXPECT_GL_ERROR(GL_INVALID_OPERATION);
+
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+// Tests that shrinking a bound uniform buffer between draws is caught by draw validation.
+TEST_P(StateChangeValidationTestES3, ShrinkUniformBuffer)
+{
+    const std::string vertexShader =
+        "#version 300 es\n"
+        "in vec2 position;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_Position = vec4(position, 0, 1);\n"
+        "}";
+    const std::string fragmentShader =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "uniform block { vec4 color; };\n"
+        "out vec4 fragColor;\n"
+        "void main()\n"
+        "{\n"
+        "    fragColor = color;\n"
+        "}";
+    ANGLE_GL_PROGRAM(program, vertexShader, fragmentShader);
+    glUseProgram(program);
+    setupVertexBuffer(program);
+
+    GLuint blockIndex = glGetUniformBlockIndex(program, "block");
+    ASSERT_NE(GL_INVALID_INDEX, blockIndex);
+    glUniformBlockBinding(program, blockIndex, 0);
+
+    const std::array<GLfloat, 4> color = {{1.0f, 0.0f, 0.0f, 1.0f}};
+    GLBuffer uniformBuffer;
+    glBindBuffer(GL_UNIFORM_BUFFER, uniformBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(color), color.data(), GL_STATIC_DRAW);
+    glBindBufferBase(GL_UNIFORM_BUFFER, 0, uniformBuffer);
+
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    EXPECT_GL_NO_ERROR();
+
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(GLfloat), color.data(), GL_STATIC_DRAW);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    EXPECT_GL_ERROR(GL_INVALID_OPERATION);
+
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(color), color.data(), GL_STATIC_DRAW);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    EXPECT_GL_NO_ERROR();
+}
+
 ANGLE_INSTANTIATE_TEST(StateChangeTest, ES2_D3D9(), ES2_D3D11(), ES2_OPENGL());
 ANGLE_INSTANTIATE_TEST(StateChangeRenderTest,
                        ES2_D3D9(),
@@ -589,3 +828,9 @@ ANGLE_INSTANTIATE_TEST(StateChangeRenderTest,
                        ES2_OPENGL(),
                        ES2_D3D11_FL9_3());
 ANGLE_INSTANTIATE_TEST(StateChangeTestES3, ES3_D3D11(), ES3_OPENGL());
+ANGLE_INSTANTIATE_TEST(StateChangeValidationTest,
+                       ES2_D3D9(),
+                       ES2_D3D11(),
+                       ES2_OPENGL(),
+                       ES2_NULL());
+ANGLE_INSTANTIATE_TEST(StateChangeValidationTestES3, ES3_D3D11(), ES3_OPENGL(), ES3_NULL());
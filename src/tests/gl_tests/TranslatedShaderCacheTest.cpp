@@ -0,0 +1,213 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// TranslatedShaderCacheTest:
+//   Tests that shaders whose translation comes from the translated shader cache behave the same
+//   as shaders that were translated.
+//
+
+#include "test_utils/ANGLETest.h"
+
+#include <vector>
+
+using namespace angle;
+
+namespace
+{
+
+constexpr char kVertexShader[] =
+    "attribute vec4 position;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_Position = position;\n"
+    "}\n";
+
+constexpr char kFragmentShader[] =
+    "precision mediump float;\n"
+    "struct S\n"
+    "{\n"
+    "    float a;\n"
+    "    vec4 b[2];\n"
+    "};\n"
+    "uniform S s;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_FragColor = s.b[1] * s.a;\n"
+    "}\n";
+
+// The unsupported extension makes the translator report a warning.
+constexpr char kWarningShader[] =
+    "#extension GL_ANGLE_unsupported_extension : enable\n"
+    "precision mediump float;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_FragColor = vec4(0.0, 1.0, 0.0, 1.0);\n"
+    "}\n";
+
+constexpr char kBrokenShader[] =
+    "void main()\n"
+    "{\n"
+    "    undefinedVariable = 1.0;\n"
+    "}\n";
+
+GLuint CompileShaderSource(GLenum type, const char *source)
+{
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+    return shader;
+}
+
+GLint GetShaderParameter(GLuint shader, GLenum pname)
+{
+    GLint value = 0;
+    glGetShaderiv(shader, pname, &value);
+    return value;
+}
+
+class TranslatedShaderCacheTest : public ANGLETest
+{
+  protected:
+    TranslatedShaderCacheTest()
+    {
+        setWindowWidth(64);
+        setWindowHeight(64);
+        setConfigRedBits(8);
+        setConfigGreenBits(8);
+        setConfigBlueBits(8);
+        setConfigAlphaBits(8);
+    }
+
+    std::string getTranslatedSource(GLuint shader)
+    {
+        GLint length = GetShaderParameter(shader, GL_TRANSLATED_SHADER_SOURCE_LENGTH_ANGLE);
+        std::vector<GLchar> source(std::max(length, 1));
+        glGetTranslatedShaderSourceANGLE(shader, length, nullptr, source.data());
+        return std::string(source.data());
+    }
+
+    std::string getInfoLog(GLuint shader)
+    {
+        GLint length = GetShaderParameter(shader, GL_INFO_LOG_LENGTH);
+        std::vector<GLchar> infoLog(std::max(length, 1));
+        glGetShaderInfoLog(shader, length, nullptr, infoLog.data());
+        return std::string(infoLog.data());
+    }
+
+    // Links a program from the given shaders and draws with the uniforms set, so that the
+    // results of the translation are used all the way to the draw.
+    void drawWithShaders(GLuint vertexShader, GLuint fragmentShader)
+    {
+        GLuint program = glCreateProgram();
+        glAttachShader(program, vertexShader);
+        glAttachShader(program, fragmentShader);
+        glLinkProgram(program);
+
+        GLint linkStatus = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+        ASSERT_GL_TRUE(linkStatus);
+
+        GLint aLocation = glGetUniformLocation(program, "s.a");
+        GLint bLocation = glGetUniformLocation(program, "s.b[1]");
+        ASSERT_NE(-1, aLocation);
+        ASSERT_NE(-1, bLocation);
+
+        glUseProgram(program);
+        glUniform1f(aLocation, 1.0f);
+        glUniform4f(bLocation, 0.0f, 1.0f, 0.0f, 1.0f);
+
+        drawQuad(program, "position", 0.5f);
+
+        // The NULL renderer doesn't produce any pixels.
+        if (!IsNULL())
+        {
+            EXPECT_PIXEL_COLOR_EQ(getWindowWidth() / 2, getWindowHeight() / 2, GLColor::green);
+        }
+
+        glDeleteProgram(program);
+        ASSERT_GL_NO_ERROR();
+    }
+};
+
+// Test that shaders with the same source get the same translation, and that both work.
+TEST_P(TranslatedShaderCacheTest, IdenticalShaders)
+{
+    GLuint vertexShader = CompileShaderSource(GL_VERTEX_SHADER, kVertexShader);
+    GLuint firstShader  = CompileShaderSource(GL_FRAGMENT_SHADER, kFragmentShader);
+
+    // Translations are cached once the compile that produced them is resolved.
+    EXPECT_GL_TRUE(GetShaderParameter(firstShader, GL_COMPILE_STATUS));
+
+    GLuint secondShader = CompileShaderSource(GL_FRAGMENT_SHADER, kFragmentShader);
+    EXPECT_GL_TRUE(GetShaderParameter(secondShader, GL_COMPILE_STATUS));
+    EXPECT_EQ(getInfoLog(firstShader), getInfoLog(secondShader));
+
+    if (extensionEnabled("GL_ANGLE_translated_shader_source"))
+    {
+        EXPECT_EQ(getTranslatedSource(firstShader), getTranslatedSource(secondShader));
+    }
+
+    drawWithShaders(vertexShader, firstShader);
+    drawWithShaders(vertexShader, secondShader);
+
+    glDeleteShader(vertexShader);
+    glDeleteShader(firstShader);
+    glDeleteShader(secondShader);
+}
+
+// Test that the warnings of a translation are reported again when the translation is reused.
+TEST_P(TranslatedShaderCacheTest, WarningsAreKept)
+{
+    GLuint firstShader = CompileShaderSource(GL_FRAGMENT_SHADER, kWarningShader);
+    EXPECT_GL_TRUE(GetShaderParameter(firstShader, GL_COMPILE_STATUS));
+    std::string infoLog = getInfoLog(firstShader);
+    EXPECT_NE(std::string::npos, infoLog.find("WARNING")) << infoLog;
+
+    GLuint secondShader = CompileShaderSource(GL_FRAGMENT_SHADER, kWarningShader);
+    EXPECT_GL_TRUE(GetShaderParameter(secondShader, GL_COMPILE_STATUS));
+    EXPECT_EQ(infoLog, getInfoLog(secondShader));
+
+    glDeleteShader(firstShader);
+    glDeleteShader(secondShader);
+}
+
+// Test that a failed compile between two compiles of a cached source doesn't leave stale results.
+TEST_P(TranslatedShaderCacheTest, RecompileAfterFailure)
+{
+    GLuint vertexShader   = CompileShaderSource(GL_VERTEX_SHADER, kVertexShader);
+    GLuint fragmentShader = CompileShaderSource(GL_FRAGMENT_SHADER, kFragmentShader);
+    EXPECT_GL_TRUE(GetShaderParameter(fragmentShader, GL_COMPILE_STATUS));
+
+    const char *brokenSource = kBrokenShader;
+    glShaderSource(fragmentShader, 1, &brokenSource, nullptr);
+    glCompileShader(fragmentShader);
+    EXPECT_GL_FALSE(GetShaderParameter(fragmentShader, GL_COMPILE_STATUS));
+    EXPECT_NE(0, GetShaderParameter(fragmentShader, GL_INFO_LOG_LENGTH));
+    if (extensionEnabled("GL_ANGLE_translated_shader_source"))
+    {
+        EXPECT_EQ(0,
+                  GetShaderParameter(fragmentShader, GL_TRANSLATED_SHADER_SOURCE_LENGTH_ANGLE));
+    }
+
+    const char *source = kFragmentShader;
+    glShaderSource(fragmentShader, 1, &source, nullptr);
+    glCompileShader(fragmentShader);
+    EXPECT_GL_TRUE(GetShaderParameter(fragmentShader, GL_COMPILE_STATUS));
+    EXPECT_EQ(0, GetShaderParameter(fragmentShader, GL_INFO_LOG_LENGTH));
+
+    drawWithShaders(vertexShader, fragmentShader);
+
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+}
+
+ANGLE_INSTANTIATE_TEST(TranslatedShaderCacheTest,
+                       ES2_D3D9(),
+                       ES2_D3D11(),
+                       ES2_OPENGL(),
+                       ES2_OPENGLES(),
+                       ES2_NULL());
+
+}  // anonymous namespace
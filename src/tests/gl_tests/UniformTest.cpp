@@ -169,6 +169,53 @@ TEST_P(UniformTest, UniformArrayLocations)
     glDeleteProgram(program);
 }
 
+// Test the subscripts accepted when looking up uniform locations by name.
+TEST_P(UniformTest, UniformLocationSubscripts)
+{
+    const std::string vertexShader = SHADER_SOURCE
+    (
+        precision mediump float;
+        uniform float uPosition[4];
+        uniform float uScale;
+        void main(void)
+        {
+            gl_Position = vec4(uPosition[0], uPosition[1], uPosition[2], uPosition[3]) * uScale;
+        }
+    );
+
+    const std::string fragShader = SHADER_SOURCE
+    (
+        precision mediump float;
+        void main(void)
+        {
+            gl_FragColor = vec4(1.0);
+        }
+    );
+
+    GLuint program = CompileProgram(vertexShader, fragShader);
+    ASSERT_NE(program, 0u);
+
+    // Only arrays may be indexed, and only within their size.
+    EXPECT_NE(-1, glGetUniformLocation(program, "uScale"));
+    EXPECT_EQ(-1, glGetUniformLocation(program, "uScale[0]"));
+    EXPECT_NE(-1, glGetUniformLocation(program, "uPosition[3]"));
+    EXPECT_EQ(-1, glGetUniformLocation(program, "uPosition[4]"));
+    EXPECT_EQ(-1, glGetUniformLocation(program, "uPositio"));
+
+    // Uniform indices only accept the first element of an array.
+    if (getClientMajorVersion() >= 3)
+    {
+        const char *uniformNames[] = {"uPosition[0]", "uPosition[1]", "uScale[0]"};
+        GLuint indices[3]          = {};
+        glGetUniformIndices(program, 3, uniformNames, indices);
+        EXPECT_NE(GL_INVALID_INDEX, indices[0]);
+        EXPECT_EQ(GL_INVALID_INDEX, indices[1]);
+        EXPECT_EQ(GL_INVALID_INDEX, indices[2]);
+    }
+
+    glDeleteProgram(program);
+}
+
 // Test that float to integer GetUniform rounds values correctly.
 TEST_P(UniformTest, FloatUniformStateQuery)
 {
@@ -626,6 +626,117 @@ TEST_P(VertexAttributeTest, DrawArraysWithBufferOffset)
     EXPECT_GL_NO_ERROR();
 }
 
+// Verify that client memory changed in place between draws is streamed again, rather than the
+// data streamed for the previous draw being reused.
+TEST_P(VertexAttributeTest, ClientMemoryChangedBetweenDraws)
+{
+    std::array<GLfloat, kVertexCount> inputData;
+    std::array<GLfloat, kVertexCount> expectedData;
+    InitTestData(inputData, expectedData);
+
+    TestData data(GL_FLOAT, GL_FALSE, Source::IMMEDIATE, inputData.data(), expectedData.data());
+    setupTest(data, 1);
+
+    // Draw the same data more than once.
+    for (int drawIndex = 0; drawIndex < 2; ++drawIndex)
+    {
+        drawQuad(mProgram, "position", 0.5f);
+        checkPixels();
+    }
+
+    // Only the test data changes, the comparison of the first component fails.
+    for (GLfloat &value : inputData)
+    {
+        value += 100.0f;
+    }
+    drawQuad(mProgram, "position", 0.5f);
+    EXPECT_PIXEL_EQ(getWindowWidth() / 2, getWindowHeight() / 2, 0, 255, 255, 255);
+
+    // Both change the same way.
+    for (GLfloat &value : expectedData)
+    {
+        value += 100.0f;
+    }
+    drawQuad(mProgram, "position", 0.5f);
+    checkPixels();
+
+    EXPECT_GL_NO_ERROR();
+}
+
+// Verify that client memory drawn again after the streaming buffer moved on from it is not
+// overwritten by the draws that make the buffer wrap before the GPU is done reading it.
+TEST_P(VertexAttributeTest, ClientMemoryReusedAcrossStreamingBufferWrap)
+{
+    initBasicProgram();
+
+    // Each draw streams about 200KB, so a few of them make the streaming buffer wrap.
+    constexpr size_t kQuadCount        = 2048;
+    constexpr size_t kLargeVertexCount = kQuadCount * 6;
+
+    std::vector<angle::Vector3> positions;
+    positions.reserve(kLargeVertexCount);
+    for (size_t quadIndex = 0; quadIndex < kQuadCount; ++quadIndex)
+    {
+        for (const angle::Vector3 &vertex : GetQuadVertices())
+        {
+            positions.push_back(vertex);
+        }
+    }
+
+    // Every draw streams its own data, except the one that is drawn twice.
+    constexpr size_t kDrawDataCount = 6;
+    std::array<std::vector<angle::Vector3>, kDrawDataCount> drawPositions;
+    std::array<std::vector<GLfloat>, kDrawDataCount> drawData;
+    for (size_t dataIndex = 0; dataIndex < kDrawDataCount; ++dataIndex)
+    {
+        drawPositions[dataIndex] = positions;
+        drawData[dataIndex].resize(kLargeVertexCount);
+        for (size_t vertexIndex = 0; vertexIndex < kLargeVertexCount; ++vertexIndex)
+        {
+            drawData[dataIndex][vertexIndex] =
+                static_cast<GLfloat>(dataIndex * 100 + vertexIndex % 64);
+        }
+    }
+
+    GLint positionLocation = glGetAttribLocation(mProgram, "position");
+    ASSERT_NE(-1, positionLocation);
+    glEnableVertexAttribArray(positionLocation);
+    glEnableVertexAttribArray(mTestAttrib);
+    glEnableVertexAttribArray(mExpectedAttrib);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    auto draw = [&](size_t dataIndex) {
+        glVertexAttribPointer(positionLocation, 3, GL_FLOAT, GL_FALSE, 0,
+                              drawPositions[dataIndex].data());
+        glVertexAttribPointer(mTestAttrib, 1, GL_FLOAT, GL_FALSE, 0, drawData[dataIndex].data());
+        glVertexAttribPointer(mExpectedAttrib, 1, GL_FLOAT, GL_FALSE, 0,
+                              drawData[dataIndex].data());
+        glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(kLargeVertexCount));
+    };
+
+    const GLint halfWidth = getWindowWidth() / 2;
+
+    // The reused data is drawn on the left half, everything else on the right one.
+    glViewport(halfWidth, 0, halfWidth, getWindowHeight());
+    draw(0);
+    draw(1);
+
+    glViewport(0, 0, halfWidth, getWindowHeight());
+    draw(0);
+
+    glViewport(halfWidth, 0, halfWidth, getWindowHeight());
+    for (size_t dataIndex = 2; dataIndex < kDrawDataCount; ++dataIndex)
+    {
+        draw(dataIndex);
+    }
+    checkPixels();
+
+    glViewport(0, 0, halfWidth, getWindowHeight());
+    checkPixels();
+
+    EXPECT_GL_NO_ERROR();
+}
+
 class VertexAttributeTestES31 : public VertexAttributeTestES3
 {
   protected:
@@ -91,6 +91,11 @@ std::string RenderTestParams::suffix() const
             return "_default";
         case EGL_PLATFORM_ANGLE_TYPE_VULKAN_ANGLE:
             return "_vulkan";
+        case EGL_PLATFORM_ANGLE_TYPE_NULL_ANGLE:
+            // The reference device keeps the image data.
+            return eglParameters.deviceType == EGL_PLATFORM_ANGLE_DEVICE_TYPE_REFERENCE_ANGLE
+                       ? "_null_reference"
+                       : "_null";
         default:
             assert(0);
             return "_unk";
@@ -103,6 +108,9 @@ ANGLERenderTest::ANGLERenderTest(const std::string &name, const RenderTestParams
       mEGLWindow(nullptr),
       mOSWindow(nullptr)
 {
+    mEGLWindow = new EGLWindow(mTestParams.majorVersion, mTestParams.minorVersion,
+                               mTestParams.eglParameters);
+    mEGLWindow->setSwapInterval(0);
 }
 
 ANGLERenderTest::~ANGLERenderTest()
@@ -114,9 +122,6 @@ ANGLERenderTest::~ANGLERenderTest()
 void ANGLERenderTest::SetUp()
 {
     mOSWindow = CreateOSWindow();
-    mEGLWindow = new EGLWindow(mTestParams.majorVersion, mTestParams.minorVersion,
-                               mTestParams.eglParameters);
-    mEGLWindow->setSwapInterval(0);
 
     if (!mOSWindow->initialize(mName, mTestParams.windowWidth, mTestParams.windowHeight))
     {
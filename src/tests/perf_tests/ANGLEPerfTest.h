@@ -96,6 +96,9 @@ class ANGLERenderTest : public ANGLEPerfTest
     OSWindow *getWindow();
 
   protected:
+    // Context creation options can be changed from the test's constructor.
+    EGLWindow *getEGLWindow() { return mEGLWindow; }
+
     const RenderTestParams &mTestParams;
 
   private:
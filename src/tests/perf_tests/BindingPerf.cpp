@@ -192,6 +192,14 @@ BindingsParams OpenGLParams(AllocationStyle allocationStyle)
     return params;
 }
 
+BindingsParams NullParams(AllocationStyle allocationStyle)
+{
+    BindingsParams params;
+    params.eglParameters   = EGLPlatformParameters(EGL_PLATFORM_ANGLE_TYPE_NULL_ANGLE);
+    params.allocationStyle = allocationStyle;
+    return params;
+}
+
 TEST_P(BindingsBenchmark, Run)
 {
     run();
@@ -203,6 +211,8 @@ ANGLE_INSTANTIATE_TEST(BindingsBenchmark,
                        D3D9Params(EVERY_ITERATION),
                        D3D9Params(AT_INITIALIZATION),
                        OpenGLParams(EVERY_ITERATION),
-                       OpenGLParams(AT_INITIALIZATION));
+                       OpenGLParams(AT_INITIALIZATION),
+                       NullParams(EVERY_ITERATION),
+                       NullParams(AT_INITIALIZATION));
 
 }  // namespace angle
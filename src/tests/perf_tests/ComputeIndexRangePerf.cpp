@@ -0,0 +1,167 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ComputeIndexRangePerf:
+//   Performance test for scanning index data for its range, which is done for every draw with
+//   indices that aren't in the index range cache. Compares the SIMD and the scalar paths.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "angle_gl.h"
+#include "common/utilities.h"
+
+using namespace testing;
+
+namespace
+{
+
+struct ComputeIndexRangeParams final
+{
+    GLenum type;
+    bool primitiveRestart;
+    bool scalar;
+    size_t indexCount;
+
+    std::string suffix() const
+    {
+        std::stringstream strstr;
+
+        switch (type)
+        {
+            case GL_UNSIGNED_BYTE:
+                strstr << "_ubyte";
+                break;
+            case GL_UNSIGNED_SHORT:
+                strstr << "_ushort";
+                break;
+            case GL_UNSIGNED_INT:
+                strstr << "_uint";
+                break;
+            default:
+                UNREACHABLE();
+                break;
+        }
+
+        if (primitiveRestart)
+        {
+            strstr << "_restart";
+        }
+
+        strstr << (scalar ? "_scalar" : "_simd");
+        strstr << "_" << indexCount;
+
+        return strstr.str();
+    }
+};
+
+std::ostream &operator<<(std::ostream &os, const ComputeIndexRangeParams &params)
+{
+    os << params.suffix().substr(1);
+    return os;
+}
+
+class ComputeIndexRangePerfTest : public ANGLEPerfTest,
+                                  public WithParamInterface<ComputeIndexRangeParams>
+{
+  public:
+    ComputeIndexRangePerfTest();
+
+    void SetUp() override;
+    void step() override;
+
+  private:
+    std::vector<uint8_t> mIndexData;
+};
+
+ComputeIndexRangePerfTest::ComputeIndexRangePerfTest()
+    : ANGLEPerfTest("ComputeIndexRange", GetParam().suffix())
+{
+}
+
+void ComputeIndexRangePerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    const ComputeIndexRangeParams &params = GetParam();
+
+    // Triangle strips of random indices, separated by restart indices every 64 indices.
+    size_t indexSize = 4;
+    if (params.type == GL_UNSIGNED_BYTE)
+    {
+        indexSize = 1;
+    }
+    else if (params.type == GL_UNSIGNED_SHORT)
+    {
+        indexSize = 2;
+    }
+    mIndexData.resize(params.indexCount * indexSize);
+
+    std::mt19937 generator(7);
+    for (size_t index = 0; index < params.indexCount; ++index)
+    {
+        GLuint value = (index % 64 == 63) ? 0xFFFFFFFFu : generator() % 250;
+        memcpy(&mIndexData[index * indexSize], &value, indexSize);
+    }
+}
+
+void ComputeIndexRangePerfTest::step()
+{
+    const ComputeIndexRangeParams &params = GetParam();
+
+    constexpr int kIterations = 10;
+    size_t checksum           = 0;
+    for (int iteration = 0; iteration < kIterations; ++iteration)
+    {
+        gl::IndexRange range =
+            params.scalar
+                ? gl::ComputeIndexRangeScalar(params.type, mIndexData.data(), params.indexCount,
+                                              params.primitiveRestart)
+                : gl::ComputeIndexRange(params.type, mIndexData.data(), params.indexCount,
+                                        params.primitiveRestart);
+        checksum += range.end;
+    }
+
+    if (checksum == 0)
+    {
+        abortTest();
+        FAIL() << "Unexpected index range.";
+    }
+}
+
+ComputeIndexRangeParams IndexRangeParams(GLenum type, bool primitiveRestart, bool scalar)
+{
+    ComputeIndexRangeParams params;
+    params.type             = type;
+    params.primitiveRestart = primitiveRestart;
+    params.scalar           = scalar;
+    params.indexCount       = 128 * 1024;
+    return params;
+}
+
+TEST_P(ComputeIndexRangePerfTest, Run)
+{
+    run();
+}
+
+INSTANTIATE_TEST_CASE_P(,
+                        ComputeIndexRangePerfTest,
+                        ::testing::Values(IndexRangeParams(GL_UNSIGNED_BYTE, false, true),
+                                          IndexRangeParams(GL_UNSIGNED_BYTE, false, false),
+                                          IndexRangeParams(GL_UNSIGNED_SHORT, false, true),
+                                          IndexRangeParams(GL_UNSIGNED_SHORT, false, false),
+                                          IndexRangeParams(GL_UNSIGNED_SHORT, true, true),
+                                          IndexRangeParams(GL_UNSIGNED_SHORT, true, false),
+                                          IndexRangeParams(GL_UNSIGNED_INT, false, true),
+                                          IndexRangeParams(GL_UNSIGNED_INT, false, false),
+                                          IndexRangeParams(GL_UNSIGNED_INT, true, true),
+                                          IndexRangeParams(GL_UNSIGNED_INT, true, false)));
+
+}  // anonymous namespace
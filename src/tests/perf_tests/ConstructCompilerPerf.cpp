@@ -0,0 +1,144 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ConstructCompilerPerf:
+//   Performance test for creating and destroying shader compilers. Every context creates a vertex
+//   and a fragment shader compiler, so this is part of the cost of context creation.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <sstream>
+
+#include "angle_gl.h"
+#include "GLSLANG/ShaderLang.h"
+
+using namespace testing;
+
+namespace
+{
+
+struct ConstructCompilerParams final
+{
+    ShShaderSpec spec;
+    ShShaderOutput output;
+
+    std::string suffix() const
+    {
+        std::stringstream strstr;
+
+        switch (output)
+        {
+            case SH_ESSL_OUTPUT:
+                strstr << "_essl";
+                break;
+            case SH_GLSL_COMPATIBILITY_OUTPUT:
+                strstr << "_glsl";
+                break;
+            default:
+                strstr << "_output" << static_cast<int>(output);
+                break;
+        }
+
+        switch (spec)
+        {
+            case SH_GLES2_SPEC:
+                strstr << "_gles2";
+                break;
+            case SH_GLES3_SPEC:
+                strstr << "_gles3";
+                break;
+            case SH_WEBGL2_SPEC:
+                strstr << "_webgl2";
+                break;
+            default:
+                strstr << "_spec" << static_cast<int>(spec);
+                break;
+        }
+
+        return strstr.str();
+    }
+};
+
+std::ostream &operator<<(std::ostream &os, const ConstructCompilerParams &params)
+{
+    os << params.suffix().substr(1);
+    return os;
+}
+
+class ConstructCompilerPerfTest : public ANGLEPerfTest,
+                                  public WithParamInterface<ConstructCompilerParams>
+{
+  public:
+    ConstructCompilerPerfTest();
+
+    void SetUp() override;
+    void TearDown() override;
+    void step() override;
+
+  private:
+    ShBuiltInResources mResources;
+};
+
+ConstructCompilerPerfTest::ConstructCompilerPerfTest()
+    : ANGLEPerfTest("ConstructCompiler", GetParam().suffix())
+{
+}
+
+void ConstructCompilerPerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    ASSERT_TRUE(sh::Initialize());
+    sh::InitBuiltInResources(&mResources);
+    mResources.FragmentPrecisionHigh = 1;
+}
+
+void ConstructCompilerPerfTest::TearDown()
+{
+    ASSERT_TRUE(sh::Finalize());
+    ANGLEPerfTest::TearDown();
+}
+
+void ConstructCompilerPerfTest::step()
+{
+    const ConstructCompilerParams &params = GetParam();
+
+    ShHandle vertexCompiler =
+        sh::ConstructCompiler(GL_VERTEX_SHADER, params.spec, params.output, &mResources);
+    ShHandle fragmentCompiler =
+        sh::ConstructCompiler(GL_FRAGMENT_SHADER, params.spec, params.output, &mResources);
+
+    if (vertexCompiler == nullptr || fragmentCompiler == nullptr)
+    {
+        abortTest();
+        FAIL() << "Failed to construct compilers.";
+    }
+
+    sh::Destruct(vertexCompiler);
+    sh::Destruct(fragmentCompiler);
+}
+
+ConstructCompilerParams CompilerParams(ShShaderSpec spec, ShShaderOutput output)
+{
+    ConstructCompilerParams params;
+    params.spec   = spec;
+    params.output = output;
+    return params;
+}
+
+TEST_P(ConstructCompilerPerfTest, Run)
+{
+    run();
+}
+
+INSTANTIATE_TEST_CASE_P(,
+                        ConstructCompilerPerfTest,
+                        ::testing::Values(CompilerParams(SH_GLES2_SPEC, SH_ESSL_OUTPUT),
+                                          CompilerParams(SH_GLES3_SPEC, SH_ESSL_OUTPUT),
+                                          CompilerParams(SH_WEBGL2_SPEC,
+                                                         SH_GLSL_COMPATIBILITY_OUTPUT)));
+
+}  // anonymous namespace
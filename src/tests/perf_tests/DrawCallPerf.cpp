@@ -30,6 +30,8 @@ class DrawCallPerfBenchmark : public ANGLERenderTest,
     GLuint mFBO     = 0;
     GLuint mTexture = 0;
     int mNumTris    = GetParam().numTris;
+
+    std::vector<GLfloat> mClientVertexData;
 };
 
 DrawCallPerfBenchmark::DrawCallPerfBenchmark() : ANGLERenderTest("DrawCallPerf", GetParam())
@@ -48,9 +50,17 @@ void DrawCallPerfBenchmark::initializeBenchmark()
 
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
 
-    mBuffer = Create2DTriangleBuffer(mNumTris, GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, 0);
+    if (params.useClientArrays)
+    {
+        // The same data is streamed by every draw.
+        Generate2DTriangleData(mNumTris, &mClientVertexData);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, mClientVertexData.data());
+    }
+    else
+    {
+        mBuffer = Create2DTriangleBuffer(mNumTris, GL_STATIC_DRAW);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, 0);
+    }
     glEnableVertexAttribArray(0);
 
     // Set the viewport
@@ -109,7 +119,11 @@ ANGLE_INSTANTIATE_TEST(DrawCallPerfBenchmark,
                        DrawCallPerfOpenGLParams(false, false),
                        DrawCallPerfOpenGLParams(true, false),
                        DrawCallPerfOpenGLParams(true, true),
+                       WithClientArrays(DrawCallPerfOpenGLParams(false, false)),
                        DrawCallPerfValidationOnly(),
-                       DrawCallPerfVulkanParams(false));
+                       DrawCallPerfVulkanParams(false),
+                       DrawCallPerfNULLParams(false),
+                       DrawCallPerfNULLParams(true),
+                       WithClientArrays(DrawCallPerfNULLParams(false)));
 
 } // namespace
@@ -33,6 +33,11 @@ std::string DrawCallPerfParams::suffix() const
         strstr << "_render_to_texture";
     }
 
+    if (useClientArrays)
+    {
+        strstr << "_client_arrays";
+    }
+
     if (eglParameters.deviceType == EGL_PLATFORM_ANGLE_DEVICE_TYPE_NULL_ANGLE)
     {
         strstr << "_null";
@@ -84,3 +89,17 @@ DrawCallPerfParams DrawCallPerfVulkanParams(bool renderToTexture)
     params.useFBO        = renderToTexture;
     return params;
 }
+
+DrawCallPerfParams DrawCallPerfNULLParams(bool renderToTexture)
+{
+    DrawCallPerfParams params;
+    params.eglParameters = EGLPlatformParameters(EGL_PLATFORM_ANGLE_TYPE_NULL_ANGLE);
+    params.useFBO        = renderToTexture;
+    return params;
+}
+
+DrawCallPerfParams WithClientArrays(DrawCallPerfParams params)
+{
+    params.useClientArrays = true;
+    return params;
+}
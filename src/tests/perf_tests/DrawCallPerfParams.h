@@ -31,6 +31,9 @@ struct DrawCallPerfParams final : public RenderTestParams
     double runTimeSeconds   = 10.0;
     int numTris             = 1;
     bool useFBO             = false;
+
+    // Draw from client memory rather than from a buffer, like legacy applications do.
+    bool useClientArrays = false;
 };
 
 std::ostream &operator<<(std::ostream &os, const DrawCallPerfParams &params);
@@ -45,4 +48,8 @@ DrawCallPerfParams DrawCallPerfValidationOnly();
 
 DrawCallPerfParams DrawCallPerfVulkanParams(bool renderToTexture);
 
+DrawCallPerfParams DrawCallPerfNULLParams(bool renderToTexture);
+
+DrawCallPerfParams WithClientArrays(DrawCallPerfParams params);
+
 #endif  // TESTS_PERF_TESTS_DRAW_CALL_PERF_PARAMS_H_
@@ -142,9 +142,14 @@ void EGLInitializePerfTest::step()
 void EGLInitializePerfTest::TearDown()
 {
     ANGLEPerfTest::TearDown();
-    printResult("LoadDLLs", normalizedTime(mCaptures.loadDLLsMS), "ms", true);
-    printResult("D3D11CreateDevice", normalizedTime(mCaptures.createDeviceMS), "ms", true);
-    printResult("InitResources", normalizedTime(mCaptures.initResourcesMS), "ms", true);
+
+    // The other back-ends don't record these histograms.
+    if (GetParam().getRenderer() == EGL_PLATFORM_ANGLE_TYPE_D3D11_ANGLE)
+    {
+        printResult("LoadDLLs", normalizedTime(mCaptures.loadDLLsMS), "ms", true);
+        printResult("D3D11CreateDevice", normalizedTime(mCaptures.createDeviceMS), "ms", true);
+        printResult("InitResources", normalizedTime(mCaptures.initResourcesMS), "ms", true);
+    }
 
     ANGLEResetDisplayPlatform(mDisplay);
 }
@@ -154,6 +159,10 @@ TEST_P(EGLInitializePerfTest, Run)
     run();
 }
 
-ANGLE_INSTANTIATE_TEST(EGLInitializePerfTest, angle::ES2_D3D11());
+ANGLE_INSTANTIATE_TEST(EGLInitializePerfTest,
+                       angle::ES2_D3D11(),
+                       angle::ES2_OPENGL(),
+                       angle::ES2_OPENGLES(),
+                       angle::ES2_NULL());
 
 } // namespace
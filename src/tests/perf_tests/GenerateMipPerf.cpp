@@ -0,0 +1,236 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// GenerateMipPerf:
+//   Performance test for the mip generation the back-ends do on the CPU. Compares the templates
+//   with the vectorized functions, a mip generated in tiles on the worker thread pool, and a whole
+//   mip chain generated in one pass with one generated a level at a time.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "image_util/generatemip.h"
+#include "libANGLE/renderer/renderer_utils.h"
+
+using namespace testing;
+
+namespace
+{
+
+enum class MipMode
+{
+    // A mip generated by the templates, without the vectorized functions.
+    Templates,
+    Vectorized,
+    Tiled,
+    // All the levels, one at a time.
+    Levels,
+    // All the levels, in one pass.
+    Chain,
+};
+
+const char *GetMipModeName(MipMode mode)
+{
+    switch (mode)
+    {
+        case MipMode::Templates:
+            return "templates";
+        case MipMode::Vectorized:
+            return "vectorized";
+        case MipMode::Tiled:
+            return "tiled";
+        case MipMode::Levels:
+            return "levels";
+        case MipMode::Chain:
+            return "chain";
+        default:
+            return "unknown";
+    }
+}
+
+using GenerateMipChainFunction = void (*)(size_t width,
+                                          size_t height,
+                                          size_t depth,
+                                          size_t levelCount,
+                                          uint8_t *const *levelData,
+                                          const size_t *rowPitches,
+                                          const size_t *depthPitches);
+
+struct GenerateMipParams final
+{
+    const char *name;
+    rx::MipGenerationFunction generateMip;
+    rx::MipGenerationFunction generateMipTemplates;
+    GenerateMipChainFunction generateMipChain;
+    size_t pixelBytes;
+    MipMode mode;
+    size_t size;
+
+    std::string suffix() const
+    {
+        std::stringstream strstr;
+        strstr << "_" << name << "_" << GetMipModeName(mode) << "_" << size;
+        return strstr.str();
+    }
+};
+
+std::ostream &operator<<(std::ostream &os, const GenerateMipParams &params)
+{
+    os << params.suffix().substr(1);
+    return os;
+}
+
+template <typename T>
+void GenerateMipTemplates(size_t sourceWidth,
+                          size_t sourceHeight,
+                          size_t sourceDepth,
+                          const uint8_t *sourceData,
+                          size_t sourceRowPitch,
+                          size_t sourceDepthPitch,
+                          uint8_t *destData,
+                          size_t destRowPitch,
+                          size_t destDepthPitch)
+{
+    angle::priv::GetMipGenerationFunction<T>(sourceWidth, sourceHeight, sourceDepth)(
+        sourceWidth, sourceHeight, sourceDepth, sourceData, sourceRowPitch, sourceDepthPitch,
+        std::max<size_t>(1, sourceWidth >> 1), std::max<size_t>(1, sourceHeight >> 1),
+        std::max<size_t>(1, sourceDepth >> 1), destData, destRowPitch, destDepthPitch);
+}
+
+class GenerateMipPerfTest : public ANGLEPerfTest, public WithParamInterface<GenerateMipParams>
+{
+  public:
+    GenerateMipPerfTest();
+
+    void SetUp() override;
+    void TearDown() override;
+    void step() override;
+
+  private:
+    std::vector<std::vector<uint8_t>> mLevels;
+    std::vector<uint8_t *> mLevelData;
+    std::vector<size_t> mRowPitches;
+    std::vector<size_t> mDepthPitches;
+    angle::WorkerThreadPool mWorkerPool;
+};
+
+GenerateMipPerfTest::GenerateMipPerfTest()
+    : ANGLEPerfTest("GenerateMip", GetParam().suffix()), mWorkerPool(4)
+{
+}
+
+void GenerateMipPerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    const GenerateMipParams &params = GetParam();
+
+    for (size_t levelSize = params.size; levelSize > 0; levelSize >>= 1)
+    {
+        mRowPitches.push_back(levelSize * params.pixelBytes);
+        mDepthPitches.push_back(mRowPitches.back() * levelSize);
+        mLevels.push_back(std::vector<uint8_t>(mDepthPitches.back()));
+        mLevelData.push_back(mLevels.back().data());
+    }
+
+    // Finite floats and half floats.
+    std::mt19937 generator(7);
+    for (uint8_t &value : mLevels[0])
+    {
+        value = static_cast<uint8_t>(generator() & 0x3F);
+    }
+}
+
+void GenerateMipPerfTest::TearDown()
+{
+    if (getNumStepsPerformed() > 0)
+    {
+        printResult("mip_time", 1000.0 * mTimer->getElapsedTime() / getNumStepsPerformed(), "ms",
+                    true);
+    }
+    ANGLEPerfTest::TearDown();
+}
+
+void GenerateMipPerfTest::step()
+{
+    const GenerateMipParams &params = GetParam();
+
+    switch (params.mode)
+    {
+        case MipMode::Templates:
+            params.generateMipTemplates(params.size, params.size, 1, mLevelData[0], mRowPitches[0],
+                                        mDepthPitches[0], mLevelData[1], mRowPitches[1],
+                                        mDepthPitches[1]);
+            break;
+        case MipMode::Vectorized:
+            params.generateMip(params.size, params.size, 1, mLevelData[0], mRowPitches[0],
+                               mDepthPitches[0], mLevelData[1], mRowPitches[1], mDepthPitches[1]);
+            break;
+        case MipMode::Tiled:
+            rx::GenerateMipInTiles(&mWorkerPool, params.generateMip, params.size, params.size, 1,
+                                   mLevelData[0], mRowPitches[0], mDepthPitches[0], mLevelData[1],
+                                   mRowPitches[1], mDepthPitches[1]);
+            break;
+        case MipMode::Levels:
+            for (size_t level = 1; level < mLevelData.size(); ++level)
+            {
+                const size_t sourceSize = params.size >> (level - 1);
+                params.generateMip(sourceSize, sourceSize, 1, mLevelData[level - 1],
+                                   mRowPitches[level - 1], mDepthPitches[level - 1],
+                                   mLevelData[level], mRowPitches[level], mDepthPitches[level]);
+            }
+            break;
+        case MipMode::Chain:
+            params.generateMipChain(params.size, params.size, 1, mLevelData.size(),
+                                    mLevelData.data(), mRowPitches.data(), mDepthPitches.data());
+            break;
+        default:
+            UNREACHABLE();
+            break;
+    }
+}
+
+template <typename T>
+GenerateMipParams MipParams(const char *name, MipMode mode)
+{
+    GenerateMipParams params;
+    params.name                 = name;
+    params.generateMip          = angle::GenerateMip<T>;
+    params.generateMipTemplates = GenerateMipTemplates<T>;
+    params.generateMipChain     = angle::GenerateMipChain<T>;
+    params.pixelBytes           = sizeof(T);
+    params.mode                 = mode;
+    params.size                 = 2048;
+    return params;
+}
+
+TEST_P(GenerateMipPerfTest, Run)
+{
+    run();
+}
+
+INSTANTIATE_TEST_CASE_P(,
+                        GenerateMipPerfTest,
+                        ::testing::Values(MipParams<angle::R8G8B8A8>("rgba8", MipMode::Templates),
+                                          MipParams<angle::R8G8B8A8>("rgba8", MipMode::Vectorized),
+                                          MipParams<angle::R8G8B8A8>("rgba8", MipMode::Tiled),
+                                          MipParams<angle::R8G8B8A8>("rgba8", MipMode::Levels),
+                                          MipParams<angle::R8G8B8A8>("rgba8", MipMode::Chain),
+                                          MipParams<angle::R8>("r8", MipMode::Templates),
+                                          MipParams<angle::R8>("r8", MipMode::Vectorized),
+                                          MipParams<angle::R16G16B16A16F>("rgba16f",
+                                                                          MipMode::Templates),
+                                          MipParams<angle::R16G16B16A16F>("rgba16f",
+                                                                          MipMode::Vectorized),
+                                          MipParams<angle::R32G32B32A32F>("rgba32f",
+                                                                          MipMode::Templates),
+                                          MipParams<angle::R32G32B32A32F>("rgba32f",
+                                                                          MipMode::Vectorized)));
+
+}  // anonymous namespace
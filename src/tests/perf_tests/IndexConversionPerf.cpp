@@ -4,7 +4,8 @@
 // found in the LICENSE file.
 //
 // IndexConversionPerf:
-//   Performance tests for ANGLE index conversion in D3D11.
+//   Performance tests for ANGLE index conversion in D3D11, and for index range caching while
+//   index data is streamed into a buffer.
 //
 
 #include <sstream>
@@ -23,7 +24,11 @@ struct IndexConversionPerfParams final : public RenderTestParams
     {
         std::stringstream strstr;
 
-        if (indexRangeOffset > 0)
+        if (streamIndices)
+        {
+            strstr << "_streaming";
+        }
+        else if (indexRangeOffset > 0)
         {
             strstr << "_index_range";
         }
@@ -38,6 +43,10 @@ struct IndexConversionPerfParams final : public RenderTestParams
 
     // A second test, which covers using index ranges with an offset.
     unsigned int indexRangeOffset;
+
+    // A third test, which rewrites part of the index buffer before each draw from it while also
+    // drawing a range that is never written.
+    bool streamIndices;
 };
 
 // Provide a custom gtest parameter name function for IndexConversionPerfParams.
@@ -61,6 +70,7 @@ class IndexConversionPerfTest : public ANGLERenderTest,
     void updateBufferData();
     void drawConversion();
     void drawIndexRange();
+    void drawStreaming();
 
     GLuint mProgram;
     GLuint mVertexBuffer;
@@ -139,7 +149,11 @@ void IndexConversionPerfTest::drawBenchmark()
 {
     const auto &params = GetParam();
 
-    if (params.indexRangeOffset == 0)
+    if (params.streamIndices)
+    {
+        drawStreaming();
+    }
+    else if (params.indexRangeOffset == 0)
     {
         drawConversion();
     }
@@ -188,6 +202,37 @@ void IndexConversionPerfTest::drawIndexRange()
     ASSERT_GL_NO_ERROR();
 }
 
+void IndexConversionPerfTest::drawStreaming()
+{
+    const auto &params = GetParam();
+
+    // The first half of the buffer is never written. It is drawn from as a whole, which stays
+    // cached, and one triangle at a time at ever-changing offsets, which is never cached. The
+    // second half is streamed into in chunks, like a dynamic index ring buffer.
+    constexpr unsigned int kChunkIndexCount = 3 * 16;
+    const unsigned int staticIndexCount     = (params.numIndexTris * 3) / 2;
+    const unsigned int chunkCount = (params.numIndexTris * 3 - staticIndexCount) / kChunkIndexCount;
+    const size_t chunkSize        = kChunkIndexCount * sizeof(GLushort);
+
+    for (unsigned int it = 0; it < params.iterations; it++)
+    {
+        unsigned int step       = getNumStepsPerformed() * params.iterations + it;
+        unsigned int chunkStart = staticIndexCount + (step % chunkCount) * kChunkIndexCount;
+        size_t chunkOffset      = chunkStart * sizeof(GLushort);
+        size_t triangleOffset   = ((step * 3) % staticIndexCount) * sizeof(GLushort);
+
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, chunkOffset, chunkSize, &mIndexData[0]);
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(kChunkIndexCount), GL_UNSIGNED_SHORT,
+                       reinterpret_cast<GLvoid *>(chunkOffset));
+        glDrawElements(GL_TRIANGLES, 3, GL_UNSIGNED_SHORT,
+                       reinterpret_cast<GLvoid *>(triangleOffset));
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(staticIndexCount), GL_UNSIGNED_SHORT,
+                       reinterpret_cast<GLvoid *>(0));
+    }
+
+    ASSERT_GL_NO_ERROR();
+}
+
 IndexConversionPerfParams IndexConversionPerfD3D11Params()
 {
     IndexConversionPerfParams params;
@@ -199,6 +244,7 @@ IndexConversionPerfParams IndexConversionPerfD3D11Params()
     params.iterations    = 225;
     params.numIndexTris = 3000;
     params.indexRangeOffset = 0;
+    params.streamIndices    = false;
     return params;
 }
 
@@ -213,6 +259,22 @@ IndexConversionPerfParams IndexRangeOffsetPerfD3D11Params()
     params.iterations       = 16;
     params.numIndexTris     = 50000;
     params.indexRangeOffset = 64;
+    params.streamIndices    = false;
+    return params;
+}
+
+IndexConversionPerfParams IndexStreamingPerfParams(const EGLPlatformParameters &egl)
+{
+    IndexConversionPerfParams params;
+    params.eglParameters    = egl;
+    params.majorVersion     = 2;
+    params.minorVersion     = 0;
+    params.windowWidth      = 256;
+    params.windowHeight     = 256;
+    params.iterations       = 100;
+    params.numIndexTris     = 20000;
+    params.indexRangeOffset = 64;
+    params.streamIndices    = true;
     return params;
 }
 
@@ -223,6 +285,10 @@ TEST_P(IndexConversionPerfTest, Run)
 
 ANGLE_INSTANTIATE_TEST(IndexConversionPerfTest,
                        IndexConversionPerfD3D11Params(),
-                       IndexRangeOffsetPerfD3D11Params());
+                       IndexRangeOffsetPerfD3D11Params(),
+                       IndexStreamingPerfParams(egl_platform::D3D11_NULL()),
+                       IndexStreamingPerfParams(egl_platform::OPENGL_NULL()),
+                       IndexStreamingPerfParams(
+                           EGLPlatformParameters(EGL_PLATFORM_ANGLE_TYPE_NULL_ANGLE)));
 
 }  // namespace
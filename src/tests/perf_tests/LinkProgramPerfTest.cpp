@@ -10,6 +10,9 @@
 #include "ANGLEPerfTest.h"
 
 #include <array>
+#include <sstream>
+#include <string>
+#include <vector>
 
 #include "common/vector_utils.h"
 #include "shader_utils.h"
@@ -19,6 +22,88 @@ using namespace angle;
 namespace
 {
 
+const char *kVertexShader =
+    "attribute vec2 position;\n"
+    "void main() {\n"
+    "    gl_Position = vec4(position, 0, 1);\n"
+    "}";
+const char *kFragmentShader =
+    "precision mediump float;\n"
+    "void main() {\n"
+    "    gl_FragColor = vec4(1, 0, 0, 1);\n"
+    "}";
+
+// A program with the resources of a typical material shader: a skinning palette, lights in an
+// array of structs, samplers and several varyings. Its binary is mostly the names and the records
+// of those resources, which is what loading a binary has to parse.
+constexpr unsigned int kLargeProgramVaryingCount = 8;
+constexpr unsigned int kLargeProgramLightCount   = 8;
+constexpr unsigned int kLargeProgramSamplerCount = 4;
+constexpr unsigned int kLargeProgramParamCount   = 16;
+
+std::string GetLargeVertexShader()
+{
+    std::stringstream shader;
+    shader << "attribute vec2 position;\n"
+              "attribute vec4 boneIndices;\n"
+              "attribute vec4 boneWeights;\n"
+              "uniform mat4 uBones[16];\n"
+              "uniform mat4 uViewProjection;\n";
+    for (unsigned int index = 0; index < kLargeProgramVaryingCount; ++index)
+    {
+        shader << "varying vec4 vData" << index << ";\n";
+    }
+    shader << "void main() {\n"
+              "    mat4 skin = uBones[int(boneIndices.x)] * boneWeights.x +\n"
+              "                uBones[int(boneIndices.y)] * boneWeights.y;\n"
+              "    vec4 skinned = skin * vec4(position, 0, 1);\n";
+    for (unsigned int index = 0; index < kLargeProgramVaryingCount; ++index)
+    {
+        shader << "    vData" << index << " = skinned * " << (index + 1) << ".0;\n";
+    }
+    shader << "    gl_Position = uViewProjection * skinned;\n"
+              "}";
+    return shader.str();
+}
+
+std::string GetLargeFragmentShader()
+{
+    std::stringstream shader;
+    shader << "precision mediump float;\n"
+              "struct Light {\n"
+              "    vec4 position;\n"
+              "    vec4 color;\n"
+              "    float range;\n"
+              "};\n"
+              "uniform Light uLights["
+           << kLargeProgramLightCount << "];\n"
+           << "uniform sampler2D uTextures[" << kLargeProgramSamplerCount << "];\n"
+           << "uniform vec4 uParams[" << kLargeProgramParamCount << "];\n";
+    for (unsigned int index = 0; index < kLargeProgramVaryingCount; ++index)
+    {
+        shader << "varying vec4 vData" << index << ";\n";
+    }
+    shader << "void main() {\n"
+              "    vec4 color = vec4(0);\n";
+    for (unsigned int index = 0; index < kLargeProgramLightCount; ++index)
+    {
+        shader << "    color += uLights[" << index << "].color * uLights[" << index
+               << "].range * dot(uLights[" << index << "].position, vData"
+               << (index % kLargeProgramVaryingCount) << ");\n";
+    }
+    for (unsigned int index = 0; index < kLargeProgramSamplerCount; ++index)
+    {
+        shader << "    color *= texture2D(uTextures[" << index << "], vData" << index << ".xy);\n";
+    }
+    for (unsigned int index = 0; index < kLargeProgramParamCount; ++index)
+    {
+        shader << "    color += uParams[" << index << "];\n";
+    }
+    shader << "    gl_FragColor = color;\n"
+              "}";
+    return shader.str();
+}
+
 struct LinkProgramParams final : public RenderTestParams
 {
     LinkProgramParams()
@@ -39,8 +124,41 @@ struct LinkProgramParams final : public RenderTestParams
             strstr << "_null";
         }
 
+        if (programCacheEnabled)
+        {
+            strstr << "_warm_cache";
+        }
+
+        if (programsPerStep > 1)
+        {
+            strstr << "_batch" << programsPerStep;
+        }
+
+        if (loadFromBinary)
+        {
+            strstr << "_binary";
+        }
+
+        if (largeProgram)
+        {
+            strstr << "_large";
+        }
+
         return strstr.str();
     }
+
+    // With the program cache every link after the first one loads the cached binary.
+    bool programCacheEnabled = false;
+
+    // Programs compiled and linked before the first one is used, so that compiles and links can
+    // overlap on worker threads.
+    unsigned int programsPerStep = 1;
+
+    // Programs are loaded with glProgramBinaryOES from the binary of a program linked once.
+    bool loadFromBinary = false;
+
+    // The program has the many resources of the large shaders above instead of none.
+    bool largeProgram = false;
 };
 
 std::ostream &operator<<(std::ostream &os, const LinkProgramParams &params)
@@ -60,11 +178,17 @@ class LinkProgramBenchmark : public ANGLERenderTest,
     void drawBenchmark() override;
 
   protected:
+    void useAndDeleteProgram(GLuint program);
+
     GLuint mVertexBuffer = 0;
+
+    GLenum mBinaryFormat = GL_NONE;
+    std::vector<uint8_t> mBinary;
 };
 
 LinkProgramBenchmark::LinkProgramBenchmark() : ANGLERenderTest("LinkProgram", GetParam())
 {
+    getEGLWindow()->setProgramCacheEnabled(GetParam().programCacheEnabled);
 }
 
 void LinkProgramBenchmark::initializeBenchmark()
@@ -77,6 +201,30 @@ void LinkProgramBenchmark::initializeBenchmark()
     glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vector3), vertices.data(),
                  GL_STATIC_DRAW);
+
+    if (GetParam().loadFromBinary)
+    {
+        GLint binaryFormatCount = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS_OES, &binaryFormatCount);
+        if (binaryFormatCount == 0)
+        {
+            std::cout << "Test skipped because no program binary formats available." << std::endl;
+            abortTest();
+            return;
+        }
+
+        GLuint program = GetParam().largeProgram
+                             ? CompileProgram(GetLargeVertexShader(), GetLargeFragmentShader())
+                             : CompileProgram(kVertexShader, kFragmentShader);
+        ASSERT_NE(0u, program);
+
+        GLint binaryLength = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH_OES, &binaryLength);
+        mBinary.resize(binaryLength);
+        glGetProgramBinaryOES(program, binaryLength, nullptr, &mBinaryFormat, mBinary.data());
+        glDeleteProgram(program);
+        ASSERT_GL_NO_ERROR();
+    }
 };
 
 void LinkProgramBenchmark::destroyBenchmark()
@@ -86,20 +234,65 @@ void LinkProgramBenchmark::destroyBenchmark()
 
 void LinkProgramBenchmark::drawBenchmark()
 {
-    static const char *vertexShader =
-        "attribute vec2 position;\n"
-        "void main() {\n"
-        "    gl_Position = vec4(position, 0, 1);\n"
-        "}";
-    static const char *fragmentShader =
-        "precision mediump float;\n"
-        "void main() {\n"
-        "    gl_FragColor = vec4(1, 0, 0, 1);\n"
-        "}";
+    const unsigned int programsPerStep = GetParam().programsPerStep;
+    if (GetParam().loadFromBinary)
+    {
+        for (unsigned int index = 0; index < programsPerStep; ++index)
+        {
+            GLuint program = glCreateProgram();
+            glProgramBinaryOES(program, mBinaryFormat, mBinary.data(),
+                               static_cast<GLint>(mBinary.size()));
 
-    GLuint program = CompileProgram(vertexShader, fragmentShader);
-    ASSERT_NE(0u, program);
+            GLint linkStatus = GL_FALSE;
+            glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+            ASSERT_EQ(GL_TRUE, linkStatus);
+            useAndDeleteProgram(program);
+        }
+        return;
+    }
 
+    if (programsPerStep == 1)
+    {
+        GLuint program = CompileProgram(kVertexShader, kFragmentShader);
+        ASSERT_NE(0u, program);
+        useAndDeleteProgram(program);
+        return;
+    }
+
+    // CompileProgram queries the status of every compile and link, which would wait for each of
+    // them in turn.
+    std::vector<GLuint> programs;
+    for (unsigned int index = 0; index < programsPerStep; ++index)
+    {
+        GLuint vs = glCreateShader(GL_VERTEX_SHADER);
+        glShaderSource(vs, 1, &kVertexShader, nullptr);
+        glCompileShader(vs);
+
+        GLuint fs = glCreateShader(GL_FRAGMENT_SHADER);
+        glShaderSource(fs, 1, &kFragmentShader, nullptr);
+        glCompileShader(fs);
+
+        GLuint program = glCreateProgram();
+        glAttachShader(program, vs);
+        glAttachShader(program, fs);
+        glLinkProgram(program);
+
+        glDeleteShader(vs);
+        glDeleteShader(fs);
+        programs.push_back(program);
+    }
+
+    for (GLuint program : programs)
+    {
+        GLint linkStatus = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+        ASSERT_EQ(GL_TRUE, linkStatus);
+        useAndDeleteProgram(program);
+    }
+}
+
+void LinkProgramBenchmark::useAndDeleteProgram(GLuint program)
+{
     glUseProgram(program);
 
     GLint positionLoc = glGetAttribLocation(program, "position");
@@ -135,6 +328,40 @@ LinkProgramParams LinkProgramOpenGLParams()
     return params;
 }
 
+LinkProgramParams LinkProgramNULLParams()
+{
+    LinkProgramParams params;
+    params.eglParameters = EGLPlatformParameters(EGL_PLATFORM_ANGLE_TYPE_NULL_ANGLE);
+    return params;
+}
+
+LinkProgramParams WithProgramCache(LinkProgramParams params)
+{
+    params.programCacheEnabled = true;
+    return params;
+}
+
+LinkProgramParams InBatches(LinkProgramParams params)
+{
+    params.programsPerStep = 8;
+    return params;
+}
+
+// Loads a batch of programs from a binary each step, like an application warming up its own
+// binary cache at startup.
+LinkProgramParams FromBinary(LinkProgramParams params)
+{
+    params.loadFromBinary  = true;
+    params.programsPerStep = 64;
+    return params;
+}
+
+LinkProgramParams WithLargeProgram(LinkProgramParams params)
+{
+    params.largeProgram = true;
+    return params;
+}
+
 TEST_P(LinkProgramBenchmark, Run)
 {
     run();
@@ -142,7 +369,21 @@ TEST_P(LinkProgramBenchmark, Run)
 
 ANGLE_INSTANTIATE_TEST(LinkProgramBenchmark,
                        LinkProgramD3D11Params(),
+                       WithProgramCache(LinkProgramD3D11Params()),
+                       InBatches(LinkProgramD3D11Params()),
+                       FromBinary(LinkProgramD3D11Params()),
+                       WithLargeProgram(FromBinary(LinkProgramD3D11Params())),
                        LinkProgramD3D9Params(),
-                       LinkProgramOpenGLParams());
+                       WithProgramCache(LinkProgramD3D9Params()),
+                       LinkProgramOpenGLParams(),
+                       WithProgramCache(LinkProgramOpenGLParams()),
+                       InBatches(LinkProgramOpenGLParams()),
+                       FromBinary(LinkProgramOpenGLParams()),
+                       WithLargeProgram(FromBinary(LinkProgramOpenGLParams())),
+                       LinkProgramNULLParams(),
+                       WithProgramCache(LinkProgramNULLParams()),
+                       InBatches(LinkProgramNULLParams()),
+                       FromBinary(LinkProgramNULLParams()),
+                       WithLargeProgram(FromBinary(LinkProgramNULLParams())));
 
 }  // anonymous namespace
@@ -0,0 +1,272 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// LoadCompressedImagePerf:
+//   Performance test for decoding and transcoding the ETC and EAC textures, which the back-ends
+//   without native support do on the CPU at upload time. Compares a load in a single call with a
+//   load in tiles on the worker thread pool.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "image_util/loadimage.h"
+#include "libANGLE/renderer/renderer_utils.h"
+
+using namespace testing;
+
+namespace
+{
+
+struct LoadCompressedImageParams final
+{
+    const char *name;
+    rx::LoadImageFunction loadFunction;
+    bool eac;
+    size_t inputBlockBytes;
+    // Bytes per output pixel when the image is decompressed, or per output block when it is
+    // transcoded.
+    size_t outputBytes;
+    size_t outputBlockHeight;
+    bool tiled;
+    size_t size;
+
+    std::string suffix() const
+    {
+        std::stringstream strstr;
+        strstr << "_" << name << (tiled ? "_tiled" : "_single") << "_" << size;
+        return strstr.str();
+    }
+};
+
+std::ostream &operator<<(std::ostream &os, const LoadCompressedImageParams &params)
+{
+    os << params.suffix().substr(1);
+    return os;
+}
+
+// The mode of an ETC1/ETC2 RGB block, from its first 4 bytes.
+enum class ETCMode
+{
+    Individual,
+    Differential,
+    T,
+    H,
+    Planar,
+};
+
+ETCMode GetETCMode(const uint8_t *block)
+{
+    if ((block[3] & 0x2) == 0)
+    {
+        return ETCMode::Individual;
+    }
+
+    // Each base color channel is 5 bits followed by a signed 3 bits difference. The channel
+    // that overflows selects the T, H or planar mode.
+    for (size_t channel = 0; channel < 3; ++channel)
+    {
+        int base       = block[channel] >> 3;
+        int difference = static_cast<int8_t>(block[channel] << 5) >> 5;
+        if (base + difference < 0 || base + difference > 31)
+        {
+            return static_cast<ETCMode>(static_cast<int>(ETCMode::T) + channel);
+        }
+    }
+    return ETCMode::Differential;
+}
+
+// Encoders mostly pick the individual and differential modes. The other modes are for blocks with
+// sharp edges or gradients.
+ETCMode PickETCMode(std::mt19937 *generator)
+{
+    unsigned int percentile = (*generator)() % 100;
+    if (percentile < 35)
+    {
+        return ETCMode::Individual;
+    }
+    if (percentile < 80)
+    {
+        return ETCMode::Differential;
+    }
+    if (percentile < 88)
+    {
+        return ETCMode::T;
+    }
+    if (percentile < 95)
+    {
+        return ETCMode::H;
+    }
+    return ETCMode::Planar;
+}
+
+class LoadCompressedImagePerfTest : public ANGLEPerfTest,
+                                    public WithParamInterface<LoadCompressedImageParams>
+{
+  public:
+    LoadCompressedImagePerfTest();
+
+    void SetUp() override;
+    void TearDown() override;
+    void step() override;
+
+  private:
+    std::vector<uint8_t> mInput;
+    std::vector<uint8_t> mOutput;
+    size_t mInputRowPitch;
+    size_t mOutputRowPitch;
+    angle::WorkerThreadPool mWorkerPool;
+};
+
+LoadCompressedImagePerfTest::LoadCompressedImagePerfTest()
+    : ANGLEPerfTest("LoadCompressedImage", GetParam().suffix()),
+      mInputRowPitch(0),
+      mOutputRowPitch(0),
+      mWorkerPool(4)
+{
+}
+
+void LoadCompressedImagePerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    const LoadCompressedImageParams &params = GetParam();
+
+    const size_t blocksWide = params.size / 4;
+    mInputRowPitch          = blocksWide * params.inputBlockBytes;
+    mInput.resize(mInputRowPitch * blocksWide);
+
+    // The RGB blocks follow the mix of modes of encoded textures, the EAC blocks are random.
+    std::mt19937 generator(11);
+    for (size_t offset = 0; offset < mInput.size(); offset += 8)
+    {
+        uint8_t *block = &mInput[offset];
+        const bool rgb = !params.eac && (params.inputBlockBytes == 8 || offset % 16 == 8);
+        const ETCMode mode = PickETCMode(&generator);
+        do
+        {
+            for (size_t byte = 0; byte < 8; ++byte)
+            {
+                block[byte] = static_cast<uint8_t>(generator());
+            }
+        } while (rgb && GetETCMode(block) != mode);
+    }
+
+    const bool transcoded = params.outputBlockHeight > 1;
+    mOutputRowPitch       = (transcoded ? blocksWide : params.size) * params.outputBytes;
+    mOutput.resize(mOutputRowPitch * (transcoded ? blocksWide : params.size));
+}
+
+void LoadCompressedImagePerfTest::TearDown()
+{
+    if (getNumStepsPerformed() > 0)
+    {
+        printResult("load_time", 1000.0 * mTimer->getElapsedTime() / getNumStepsPerformed(), "ms",
+                    true);
+    }
+    ANGLEPerfTest::TearDown();
+}
+
+void LoadCompressedImagePerfTest::step()
+{
+    const LoadCompressedImageParams &params = GetParam();
+
+    const size_t inputDepthPitch  = mInput.size();
+    const size_t outputDepthPitch = mOutput.size();
+    if (params.tiled)
+    {
+        rx::LoadCompressedImageInTiles(&mWorkerPool, params.loadFunction, params.size, params.size,
+                                       1, 4, mInput.data(), mInputRowPitch, inputDepthPitch,
+                                       params.outputBlockHeight, mOutput.data(), mOutputRowPitch,
+                                       outputDepthPitch);
+    }
+    else
+    {
+        params.loadFunction(params.size, params.size, 1, mInput.data(), mInputRowPitch,
+                            inputDepthPitch, mOutput.data(), mOutputRowPitch, outputDepthPitch);
+    }
+}
+
+LoadCompressedImageParams LoadParams(const char *name,
+                                     rx::LoadImageFunction loadFunction,
+                                     bool eac,
+                                     size_t inputBlockBytes,
+                                     size_t outputBytes,
+                                     size_t outputBlockHeight,
+                                     bool tiled)
+{
+    LoadCompressedImageParams params;
+    params.name              = name;
+    params.loadFunction      = loadFunction;
+    params.eac               = eac;
+    params.inputBlockBytes   = inputBlockBytes;
+    params.outputBytes       = outputBytes;
+    params.outputBlockHeight = outputBlockHeight;
+    params.tiled             = tiled;
+    params.size              = 2048;
+    return params;
+}
+
+LoadCompressedImageParams ETC1ToRGBA8(bool tiled)
+{
+    return LoadParams("etc1_rgba8", angle::LoadETC1RGB8ToRGBA8, false, 8, 4, 1, tiled);
+}
+
+LoadCompressedImageParams ETC2A1ToRGBA8(bool tiled)
+{
+    return LoadParams("etc2_a1_rgba8", angle::LoadETC2RGB8A1ToRGBA8, false, 8, 4, 1, tiled);
+}
+
+LoadCompressedImageParams ETC2RGBA8ToRGBA8(bool tiled)
+{
+    return LoadParams("etc2_rgba8_rgba8", angle::LoadETC2RGBA8ToRGBA8, false, 16, 4, 1, tiled);
+}
+
+LoadCompressedImageParams EACR11ToR8(bool tiled)
+{
+    return LoadParams("eac_r11_r8", angle::LoadEACR11ToR8, true, 8, 1, 1, tiled);
+}
+
+LoadCompressedImageParams EACRG11ToRG8(bool tiled)
+{
+    return LoadParams("eac_rg11_rg8", angle::LoadEACRG11ToRG8, true, 16, 2, 1, tiled);
+}
+
+LoadCompressedImageParams ETC2ToBC1(bool tiled)
+{
+    return LoadParams("etc2_bc1", angle::LoadETC2RGB8ToBC1, false, 8, 8, 4, tiled);
+}
+
+LoadCompressedImageParams ETC2A1ToBC1(bool tiled)
+{
+    return LoadParams("etc2_a1_bc1", angle::LoadETC2RGB8A1ToBC1, false, 8, 8, 4, tiled);
+}
+
+TEST_P(LoadCompressedImagePerfTest, Run)
+{
+    run();
+}
+
+INSTANTIATE_TEST_CASE_P(,
+                        LoadCompressedImagePerfTest,
+                        ::testing::Values(ETC1ToRGBA8(false),
+                                          ETC1ToRGBA8(true),
+                                          ETC2A1ToRGBA8(false),
+                                          ETC2A1ToRGBA8(true),
+                                          ETC2RGBA8ToRGBA8(false),
+                                          ETC2RGBA8ToRGBA8(true),
+                                          EACR11ToR8(false),
+                                          EACR11ToR8(true),
+                                          EACRG11ToRG8(false),
+                                          EACRG11ToRG8(true),
+                                          ETC2ToBC1(false),
+                                          ETC2ToBC1(true),
+                                          ETC2A1ToBC1(false),
+                                          ETC2A1ToBC1(true)));
+
+}  // anonymous namespace
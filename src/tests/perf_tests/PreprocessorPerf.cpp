@@ -0,0 +1,222 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PreprocessorPerf:
+//   Performance test for the shader preprocessor, which sees every token of every shader that is
+//   compiled. Reports the number of tokens preprocessed per second, for large shaders with and
+//   without preprocessor directives and macros.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "compiler/preprocessor/Preprocessor.h"
+#include "compiler/preprocessor/Token.h"
+#include "test_utils/preprocessor_perf_utils.h"
+
+using namespace testing;
+
+namespace
+{
+
+// Writes a shader in the style of the large uber-shaders of game engines: many uniforms, helper
+// functions and lighting loops. With directives, the helpers are macros and the features are
+// selected with conditionals, the way those shaders usually are.
+std::string GenerateShader(bool directives, int functionCount)
+{
+    std::stringstream shader;
+
+    if (directives)
+    {
+        shader << "#define LIGHT_COUNT 4\n"
+                  "#define SATURATE(x) clamp((x), 0.0, 1.0)\n"
+                  "#define LUMINANCE(c) dot((c).rgb, vec3(0.2126, 0.7152, 0.0722))\n"
+                  "#define MAD(a, b, c) ((a) * (b) + (c))\n"
+                  "#define USE_FOG 1\n"
+                  "#ifdef GL_ES\n"
+                  "precision highp float;\n"
+                  "#endif\n";
+    }
+    else
+    {
+        shader << "precision highp float;\n";
+    }
+
+    shader << "uniform vec3 uLightPositions[4];\n"
+              "uniform vec3 uLightColors[4];\n"
+              "uniform vec3 uCameraPosition;\n"
+              "uniform sampler2D uAlbedo;\n"
+              "uniform sampler2D uNormals;\n"
+              "uniform float uFogDensity;\n"
+              "varying vec3 vPosition;\n"
+              "varying vec3 vNormal;\n"
+              "varying vec2 vTexCoord;\n";
+
+    const char *saturate    = directives ? "SATURATE" : "clamp";
+    const char *saturateEnd = directives ? ")" : ", 0.0, 1.0)";
+
+    for (int function = 0; function < functionCount; ++function)
+    {
+        shader << "// Lighting term " << function << ".\n"
+               << "vec3 shade" << function
+               << "(vec3 albedo, vec3 normal, vec3 viewDir, float roughness)\n"
+                  "{\n"
+                  "    vec3 color = vec3(0.0);\n";
+
+        shader << (directives ? "    for (int i = 0; i < LIGHT_COUNT; ++i)\n"
+                              : "    for (int i = 0; i < 4; ++i)\n");
+
+        shader << "    {\n"
+                  "        vec3 lightDir = normalize(uLightPositions[i] - vPosition);\n"
+                  "        vec3 halfDir = normalize(lightDir + viewDir);\n"
+                  "        float nDotL = "
+               << saturate << "(dot(normal, lightDir)" << saturateEnd
+               << ";\n"
+                  "        float nDotH = "
+               << saturate << "(dot(normal, halfDir)" << saturateEnd
+               << ";\n"
+                  "        float specular = pow(nDotH, 2.0 / (roughness * roughness + 0.0001));\n";
+
+        if (directives)
+        {
+            shader << "        color += MAD(albedo, vec3(nDotL), vec3(specular)) * "
+                      "uLightColors[i];\n";
+        }
+        else
+        {
+            shader << "        color += (albedo * vec3(nDotL) + vec3(specular)) * "
+                      "uLightColors[i];\n";
+        }
+
+        shader << "    }\n";
+
+        if (directives)
+        {
+            shader << "#if USE_FOG\n"
+                      "    float fog = exp(-uFogDensity * length(uCameraPosition - vPosition));\n"
+                      "    color = mix(vec3(LUMINANCE(color)), color, fog);\n"
+                      "#endif\n";
+        }
+        else
+        {
+            shader << "    float fog = exp(-uFogDensity * length(uCameraPosition - vPosition));\n"
+                      "    color = mix(vec3(dot(color.rgb, vec3(0.2126, 0.7152, 0.0722))), "
+                      "color, fog);\n";
+        }
+
+        shader << "    return color;\n"
+                  "}\n";
+    }
+
+    shader << "void main()\n"
+              "{\n"
+              "    vec3 albedo = texture2D(uAlbedo, vTexCoord).rgb;\n"
+              "    vec3 normal = normalize(vNormal + texture2D(uNormals, vTexCoord).xyz);\n"
+              "    vec3 viewDir = normalize(uCameraPosition - vPosition);\n"
+              "    vec3 color = vec3(0.0);\n";
+    for (int function = 0; function < functionCount; ++function)
+    {
+        shader << "    color += shade" << function << "(albedo, normal, viewDir, "
+               << (function + 1) << ".0 / " << functionCount << ".0);\n";
+    }
+    shader << "    gl_FragColor = vec4(color, 1.0);\n"
+              "}\n";
+
+    return shader.str();
+}
+
+struct PreprocessorParams final
+{
+    bool directives;
+
+    std::string suffix() const { return directives ? "_directives" : "_directive_free"; }
+};
+
+std::ostream &operator<<(std::ostream &os, const PreprocessorParams &params)
+{
+    os << params.suffix().substr(1);
+    return os;
+}
+
+class PreprocessorPerfTest : public ANGLEPerfTest, public WithParamInterface<PreprocessorParams>
+{
+  public:
+    PreprocessorPerfTest();
+
+    void SetUp() override;
+    void TearDown() override;
+    void step() override;
+
+  private:
+    std::vector<std::string> mCorpus;
+    size_t mTokenCount;
+};
+
+PreprocessorPerfTest::PreprocessorPerfTest()
+    : ANGLEPerfTest("Preprocessor", GetParam().suffix()), mTokenCount(0)
+{
+}
+
+void PreprocessorPerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    // A corpus of shaders of increasing size, the largest a few hundred kilobytes.
+    for (int functionCount : {8, 64, 512})
+    {
+        mCorpus.push_back(GenerateShader(GetParam().directives, functionCount));
+    }
+}
+
+void PreprocessorPerfTest::TearDown()
+{
+    ANGLEPerfTest::TearDown();
+
+    double tokensPerSecond = static_cast<double>(mTokenCount) / mTimer->getElapsedTime();
+    printResult("tokens_per_second", static_cast<size_t>(tokensPerSecond), "tokens/s", true);
+}
+
+void PreprocessorPerfTest::step()
+{
+    for (const std::string &shader : mCorpus)
+    {
+        angle::NullDiagnostics diagnostics;
+        angle::NullDirectiveHandler directiveHandler;
+        pp::Preprocessor preprocessor(&diagnostics, &directiveHandler, pp::PreprocessorSettings());
+
+        const char *source = shader.c_str();
+        if (!preprocessor.init(1, &source, nullptr))
+        {
+            abortTest();
+            FAIL() << "Failed to initialize the preprocessor.";
+        }
+
+        pp::Token token;
+        for (preprocessor.lex(&token); token.type != pp::Token::LAST; preprocessor.lex(&token))
+        {
+            ++mTokenCount;
+        }
+
+        if (diagnostics.getErrorCount() != 0)
+        {
+            abortTest();
+            FAIL() << "Unexpected preprocessor error.";
+        }
+    }
+}
+
+TEST_P(PreprocessorPerfTest, Run)
+{
+    run();
+}
+
+INSTANTIATE_TEST_CASE_P(,
+                        PreprocessorPerfTest,
+                        ::testing::Values(PreprocessorParams{false}, PreprocessorParams{true}));
+
+}  // anonymous namespace
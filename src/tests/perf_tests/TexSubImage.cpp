@@ -32,6 +32,9 @@ struct TexSubImageParams final : public RenderTestParams
         subImageWidth = 64;
         subImageHeight = 64;
         iterations     = 9;
+
+        internalFormat = GL_RGBA8;
+        format         = GL_RGBA;
     }
 
     std::string suffix() const override;
@@ -42,8 +45,26 @@ struct TexSubImageParams final : public RenderTestParams
     int subImageWidth;
     int subImageHeight;
     unsigned int iterations;
+
+    // The uploads are GL_UNSIGNED_BYTE data of this format. Formats the texture stores differently
+    // are converted on upload, by the loaders of image_util on the D3D backends.
+    GLenum internalFormat;
+    GLenum format;
 };
 
+GLuint GetPixelBytes(GLenum format)
+{
+    switch (format)
+    {
+        case GL_LUMINANCE:
+            return 1;
+        case GL_RGB:
+            return 3;
+        default:
+            return 4;
+    }
+}
+
 std::ostream &operator<<(std::ostream &os, const TexSubImageParams &params)
 {
     os << params.suffix().substr(1);
@@ -85,8 +106,20 @@ class TexSubImageBenchmark : public ANGLERenderTest,
 
 std::string TexSubImageParams::suffix() const
 {
-    // TODO(jmadill)
-    return RenderTestParams::suffix();
+    std::stringstream strstr;
+
+    strstr << RenderTestParams::suffix();
+
+    if (format == GL_LUMINANCE)
+    {
+        strstr << "_luminance";
+    }
+    else if (format == GL_RGB)
+    {
+        strstr << "_rgb";
+    }
+
+    return strstr.str();
 }
 
 TexSubImageBenchmark::TexSubImageBenchmark()
@@ -118,7 +151,8 @@ GLuint TexSubImageBenchmark::createTexture()
     // Bind the texture object
     glBindTexture(GL_TEXTURE_2D, texture);
 
-    glTexStorage2DEXT(GL_TEXTURE_2D, 1, GL_RGBA8, params.imageWidth, params.imageHeight);
+    glTexStorage2DEXT(GL_TEXTURE_2D, 1, params.internalFormat, params.imageWidth,
+                      params.imageHeight);
 
     // Set the filtering mode
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -191,18 +225,23 @@ void TexSubImageBenchmark::initializeBenchmark()
 
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
 
-    mPixels = new GLubyte[params.subImageWidth * params.subImageHeight * 4];
+    GLuint pixelBytes = GetPixelBytes(params.format);
+    mPixels = new GLubyte[params.subImageWidth * params.subImageHeight * pixelBytes];
 
     // Fill the pixels structure with random data:
     for (int y = 0; y < params.subImageHeight; ++y)
     {
         for (int x = 0; x < params.subImageWidth; ++x)
         {
-            int offset = (x + (y * params.subImageWidth)) * 4;
-            mPixels[offset + 0] = rand() % 255; // Red
-            mPixels[offset + 1] = rand() % 255; // Green
-            mPixels[offset + 2] = rand() % 255; // Blue
-            mPixels[offset + 3] = 255; // Alpha
+            int offset = (x + (y * params.subImageWidth)) * pixelBytes;
+            for (GLuint component = 0; component < pixelBytes; ++component)
+            {
+                mPixels[offset + component] = rand() % 255;
+            }
+            if (pixelBytes == 4)
+            {
+                mPixels[offset + 3] = 255;  // Alpha
+            }
         }
     }
 
@@ -216,6 +255,14 @@ void TexSubImageBenchmark::destroyBenchmark()
     glDeleteBuffers(1, &mIndexBuffer);
     glDeleteTextures(1, &mTexture);
     delete[] mPixels;
+
+    // The rate at which the texture data is uploaded, including the conversions to the format of
+    // the texture.
+    const auto &params = GetParam();
+    double uploadedBytes = static_cast<double>(getNumStepsPerformed()) * params.iterations *
+                           params.subImageWidth * params.subImageHeight *
+                           GetPixelBytes(params.format);
+    printResult("upload_rate", uploadedBytes / mTimer->getElapsedTime() / 1e9, "GB/s", true);
 }
 
 void TexSubImageBenchmark::drawBenchmark()
@@ -258,7 +305,7 @@ void TexSubImageBenchmark::drawBenchmark()
                         rand() % (params.imageWidth - params.subImageWidth),
                         rand() % (params.imageHeight - params.subImageHeight),
                         params.subImageWidth, params.subImageHeight,
-                        GL_RGBA, GL_UNSIGNED_BYTE, mPixels);
+                        params.format, GL_UNSIGNED_BYTE, mPixels);
 
         glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0);
     }
@@ -287,6 +334,20 @@ TexSubImageParams OpenGLParams()
     return params;
 }
 
+TexSubImageParams NullReferenceParams()
+{
+    TexSubImageParams params;
+    params.eglParameters = egl_platform::NULL_REFERENCE();
+    return params;
+}
+
+TexSubImageParams WithFormat(TexSubImageParams params, GLenum internalFormat, GLenum format)
+{
+    params.internalFormat = internalFormat;
+    params.format         = format;
+    return params;
+}
+
 } // namespace
 
 TEST_P(TexSubImageBenchmark, Run)
@@ -295,4 +356,13 @@ TEST_P(TexSubImageBenchmark, Run)
 }
 
 ANGLE_INSTANTIATE_TEST(TexSubImageBenchmark,
-                       D3D11Params(), D3D9Params(), OpenGLParams());
+                       D3D11Params(),
+                       D3D9Params(),
+                       OpenGLParams(),
+                       NullReferenceParams(),
+                       WithFormat(D3D11Params(), GL_LUMINANCE8_EXT, GL_LUMINANCE),
+                       WithFormat(D3D11Params(), GL_RGB8_OES, GL_RGB),
+                       WithFormat(OpenGLParams(), GL_LUMINANCE8_EXT, GL_LUMINANCE),
+                       WithFormat(OpenGLParams(), GL_RGB8_OES, GL_RGB),
+                       WithFormat(NullReferenceParams(), GL_LUMINANCE8_EXT, GL_LUMINANCE),
+                       WithFormat(NullReferenceParams(), GL_RGB8_OES, GL_RGB));
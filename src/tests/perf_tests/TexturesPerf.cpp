@@ -33,6 +33,7 @@ struct TexturesParams final : public RenderTestParams
         textureRebindFrequency      = 5;
         textureStateUpdateFrequency = 3;
         textureMipCount             = 8;
+        numPrograms                 = 1;
     }
 
     std::string suffix() const override;
@@ -41,6 +42,9 @@ struct TexturesParams final : public RenderTestParams
     size_t textureStateUpdateFrequency;
     size_t textureMipCount;
 
+    // Programs drawn with in turn. Each one samples the textures from different units.
+    size_t numPrograms;
+
     // static parameters
     size_t iterations;
 };
@@ -61,6 +65,11 @@ std::string TexturesParams::suffix() const
     strstr << "_" << textureStateUpdateFrequency << "_state";
     strstr << "_" << textureMipCount << "_mips";
 
+    if (numPrograms > 1)
+    {
+        strstr << "_" << numPrograms << "_programs";
+    }
+
     return strstr.str();
 }
 
@@ -80,11 +89,10 @@ class TexturesBenchmark : public ANGLERenderTest,
 
     std::vector<GLuint> mTextures;
 
-    GLuint mProgram;
-    std::vector<GLuint> mUniformLocations;
+    std::vector<GLuint> mPrograms;
 };
 
-TexturesBenchmark::TexturesBenchmark() : ANGLERenderTest("Textures", GetParam()), mProgram(0u)
+TexturesBenchmark::TexturesBenchmark() : ANGLERenderTest("Textures", GetParam())
 {
 }
 
@@ -143,21 +151,26 @@ void TexturesBenchmark::initShaders()
     fstrstr << ";\n"
                "}\n";
 
-    mProgram = CompileProgram(vs, fstrstr.str());
-    ASSERT_NE(0u, mProgram);
-
-    for (size_t i = 0; i < params.numTextures; ++i)
+    for (size_t programIndex = 0; programIndex < params.numPrograms; ++programIndex)
     {
-        std::stringstream uniformName;
-        uniformName << "tex" << i;
+        GLuint program = CompileProgram(vs, fstrstr.str());
+        ASSERT_NE(0u, program);
+        mPrograms.push_back(program);
+
+        glUseProgram(program);
+        for (size_t i = 0; i < params.numTextures; ++i)
+        {
+            std::stringstream uniformName;
+            uniformName << "tex" << i;
 
-        GLint location = glGetUniformLocation(mProgram, uniformName.str().c_str());
-        ASSERT_NE(-1, location);
-        mUniformLocations.push_back(location);
+            GLint location = glGetUniformLocation(program, uniformName.str().c_str());
+            ASSERT_NE(-1, location);
+            glUniform1i(location, static_cast<GLint>((i + programIndex) % params.numTextures));
+        }
     }
 
-    // Use the program object
-    glUseProgram(mProgram);
+    // Use the first program object
+    glUseProgram(mPrograms[0]);
 }
 
 void TexturesBenchmark::initTextures()
@@ -185,14 +198,15 @@ void TexturesBenchmark::initTextures()
                          GL_RGBA, GL_UNSIGNED_BYTE, textureData.data());
         }
         mTextures.push_back(tex);
-
-        glUniform1i(mUniformLocations[texIndex], static_cast<GLint>(texIndex));
     }
 }
 
 void TexturesBenchmark::destroyBenchmark()
 {
-    glDeleteProgram(mProgram);
+    for (GLuint program : mPrograms)
+    {
+        glDeleteProgram(program);
+    }
 }
 
 void TexturesBenchmark::drawBenchmark()
@@ -201,6 +215,11 @@ void TexturesBenchmark::drawBenchmark()
 
     for (size_t it = 0; it < params.iterations; ++it)
     {
+        if (params.numPrograms > 1)
+        {
+            glUseProgram(mPrograms[it % params.numPrograms]);
+        }
+
         if (it % params.textureRebindFrequency == 0)
         {
             // Swap two textures
@@ -283,11 +302,30 @@ TexturesParams OpenGLParams()
     return params;
 }
 
+TexturesParams NullParams()
+{
+    TexturesParams params;
+    params.eglParameters = EGLPlatformParameters(EGL_PLATFORM_ANGLE_TYPE_NULL_ANGLE);
+    return params;
+}
+
+TexturesParams WithProgramSwitches(TexturesParams params)
+{
+    params.numPrograms = 2;
+    return params;
+}
+
 TEST_P(TexturesBenchmark, Run)
 {
     run();
 }
 
-ANGLE_INSTANTIATE_TEST(TexturesBenchmark, D3D11Params(), D3D9Params(), OpenGLParams());
+ANGLE_INSTANTIATE_TEST(TexturesBenchmark,
+                       D3D11Params(),
+                       D3D9Params(),
+                       OpenGLParams(),
+                       NullParams(),
+                       WithProgramSwitches(OpenGLParams()),
+                       WithProgramSwitches(NullParams()));
 
 }  // namespace angle
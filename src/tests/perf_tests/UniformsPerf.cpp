@@ -26,8 +26,15 @@ enum DataMode
 {
     UPDATE,
     REPEAT,
+    // Only every eighth uniform changes, like per-object data between shared per-frame data.
+    MIXED,
 };
 
+bool UniformChanges(DataMode dataMode, size_t uniform)
+{
+    return (dataMode == DataMode::UPDATE || (dataMode == DataMode::MIXED && uniform % 8 == 0));
+}
+
 // TODO(jmadill): Use an ANGLE enum for this?
 enum DataType
 {
@@ -53,6 +60,13 @@ struct UniformsParams final : public RenderTestParams
     DataType dataType = DataType::VEC4;
     DataMode dataMode = DataMode::REPEAT;
 
+    // Declare each shader's uniforms as the elements of one array.
+    bool arrayUniforms = false;
+
+    // Look up every uniform location by name before setting it, as engines that don't cache
+    // locations do.
+    bool queryLocations = false;
+
     // static parameters
     size_t iterations = 4;
 };
@@ -83,6 +97,20 @@ std::string UniformsParams::suffix() const
     {
         strstr << "_repeating";
     }
+    else if (dataMode == DataMode::MIXED)
+    {
+        strstr << "_mixed";
+    }
+
+    if (arrayUniforms)
+    {
+        strstr << "_array";
+    }
+
+    if (queryLocations)
+    {
+        strstr << "_query_locations";
+    }
 
     return strstr.str();
 }
@@ -101,7 +129,8 @@ class UniformsBenchmark : public ANGLERenderTest,
     void initShaders();
 
     GLuint mProgram;
-    std::vector<GLuint> mUniformLocations;
+    std::vector<std::string> mUniformNames;
+    std::vector<GLint> mUniformLocations;
     std::vector<Matrix4> mMatrixData[2];
 };
 
@@ -171,23 +200,32 @@ void UniformsBenchmark::initializeBenchmark()
         size_t count = params.numVertexUniforms + params.numFragmentUniforms;
 
         mMatrixData[0] = GenMatrixData(count, 0);
-        if (params.dataMode == DataMode::REPEAT)
-        {
-            mMatrixData[1] = GenMatrixData(count, 0);
-        }
-        else
+        mMatrixData[1] = GenMatrixData(count, 0);
+
+        std::vector<Matrix4> changedData = GenMatrixData(count, 1);
+        for (size_t uniform = 0; uniform < count; ++uniform)
         {
-            mMatrixData[1] = GenMatrixData(count, 1);
+            if (UniformChanges(params.dataMode, uniform))
+            {
+                mMatrixData[1][uniform] = changedData[uniform];
+            }
         }
     }
 
     ASSERT_GL_NO_ERROR();
 }
 
-std::string GetUniformLocationName(size_t idx, bool vertexShader)
+std::string GetUniformLocationName(size_t idx, bool vertexShader, bool arrayUniforms)
 {
     std::stringstream strstr;
-    strstr << (vertexShader ? "vs" : "fs") << "_u_" << idx;
+    if (arrayUniforms)
+    {
+        strstr << (vertexShader ? "vs" : "fs") << "_u[" << idx << "]";
+    }
+    else
+    {
+        strstr << (vertexShader ? "vs" : "fs") << "_u_" << idx;
+    }
     return strstr.str();
 }
 
@@ -206,9 +244,17 @@ void UniformsBenchmark::initShaders()
         vstrstr << constVector;
     }
 
-    for (size_t i = 0; i < params.numVertexUniforms; i++)
+    if (params.arrayUniforms)
     {
-        vstrstr << "uniform " << typeString << " " << GetUniformLocationName(i, true) << ";\n";
+        vstrstr << "uniform " << typeString << " vs_u[" << params.numVertexUniforms << "];\n";
+    }
+    else
+    {
+        for (size_t i = 0; i < params.numVertexUniforms; i++)
+        {
+            vstrstr << "uniform " << typeString << " " << GetUniformLocationName(i, true, false)
+                    << ";\n";
+        }
     }
 
     vstrstr << "void main()\n"
@@ -216,7 +262,7 @@ void UniformsBenchmark::initShaders()
                "    gl_Position = vec4(0, 0, 0, 0);\n";
     for (size_t i = 0; i < params.numVertexUniforms; i++)
     {
-        vstrstr << "    gl_Position += " << GetUniformLocationName(i, true);
+        vstrstr << "    gl_Position += " << GetUniformLocationName(i, true, params.arrayUniforms);
         if (isMatrix)
         {
             vstrstr << " * one";
@@ -233,16 +279,25 @@ void UniformsBenchmark::initShaders()
         fstrstr << constVector;
     }
 
-    for (size_t i = 0; i < params.numFragmentUniforms; i++)
+    if (params.arrayUniforms)
     {
-        fstrstr << "uniform " << typeString << " " << GetUniformLocationName(i, false) << ";\n";
+        fstrstr << "uniform " << typeString << " fs_u[" << params.numFragmentUniforms << "];\n";
+    }
+    else
+    {
+        for (size_t i = 0; i < params.numFragmentUniforms; i++)
+        {
+            fstrstr << "uniform " << typeString << " " << GetUniformLocationName(i, false, false)
+                    << ";\n";
+        }
     }
     fstrstr << "void main()\n"
                "{\n"
                "    gl_FragColor = vec4(0, 0, 0, 0);\n";
     for (size_t i = 0; i < params.numFragmentUniforms; i++)
     {
-        fstrstr << "    gl_FragColor += " << GetUniformLocationName(i, false);
+        fstrstr << "    gl_FragColor += "
+                << GetUniformLocationName(i, false, params.arrayUniforms);
         if (isMatrix)
         {
             fstrstr << " * one";
@@ -256,13 +311,16 @@ void UniformsBenchmark::initShaders()
 
     for (size_t i = 0; i < params.numVertexUniforms; ++i)
     {
-        GLint location = glGetUniformLocation(mProgram, GetUniformLocationName(i, true).c_str());
-        ASSERT_NE(-1, location);
-        mUniformLocations.push_back(location);
+        mUniformNames.push_back(GetUniformLocationName(i, true, params.arrayUniforms));
     }
     for (size_t i = 0; i < params.numFragmentUniforms; ++i)
     {
-        GLint location = glGetUniformLocation(mProgram, GetUniformLocationName(i, false).c_str());
+        mUniformNames.push_back(GetUniformLocationName(i, false, params.arrayUniforms));
+    }
+
+    for (const std::string &name : mUniformNames)
+    {
+        GLint location = glGetUniformLocation(mProgram, name.c_str());
         ASSERT_NE(-1, location);
         mUniformLocations.push_back(location);
     }
@@ -286,15 +344,24 @@ void UniformsBenchmark::drawBenchmark()
     {
         for (size_t uniform = 0; uniform < mUniformLocations.size(); ++uniform)
         {
+            GLint location = mUniformLocations[uniform];
+            if (params.queryLocations)
+            {
+                location = glGetUniformLocation(mProgram, mUniformNames[uniform].c_str());
+            }
+
             if (params.dataType == DataType::MAT4)
             {
-                glUniformMatrix4fv(mUniformLocations[uniform], 1, GL_FALSE,
-                                   mMatrixData[frameIndex][uniform].data);
+                glUniformMatrix4fv(location, 1, GL_FALSE, mMatrixData[frameIndex][uniform].data);
             }
             else
             {
                 float value = static_cast<float>(uniform);
-                glUniform4f(mUniformLocations[uniform], value, value, value, value);
+                if (UniformChanges(params.dataMode, uniform))
+                {
+                    value += static_cast<float>(frameIndex);
+                }
+                glUniform4f(location, value, value, value, value);
             }
         }
 
@@ -325,6 +392,23 @@ UniformsParams MatrixUniforms(const EGLPlatformParameters &egl, DataMode dataMod
     params.numVertexUniforms   = 100;
     params.numFragmentUniforms = 100;
 
+    // The NULL back-end exposes 256 vectors per shader stage.
+    if (egl.renderer == EGL_PLATFORM_ANGLE_TYPE_NULL_ANGLE)
+    {
+        params.numVertexUniforms   = 60;
+        params.numFragmentUniforms = 60;
+    }
+
+    return params;
+}
+
+UniformsParams ArrayUniformsWithLocationQueries(const EGLPlatformParameters &egl)
+{
+    UniformsParams params;
+    params.eglParameters  = egl;
+    params.dataMode       = DataMode::REPEAT;
+    params.arrayUniforms  = true;
+    params.queryLocations = true;
     return params;
 }
 
@@ -344,4 +428,23 @@ ANGLE_INSTANTIATE_TEST(UniformsBenchmark,
                        MatrixUniforms(D3D11(), DataMode::REPEAT),
                        MatrixUniforms(D3D11(), DataMode::UPDATE),
                        MatrixUniforms(OPENGL(), DataMode::REPEAT),
-                       MatrixUniforms(OPENGL(), DataMode::UPDATE));
+                       MatrixUniforms(OPENGL(), DataMode::UPDATE),
+                       MatrixUniforms(OPENGL(), DataMode::MIXED),
+                       MatrixUniforms(D3D11(), DataMode::MIXED),
+                       VectorUniforms(OPENGL_NULL(), DataMode::REPEAT),
+                       VectorUniforms(OPENGL_NULL(), DataMode::UPDATE),
+                       MatrixUniforms(OPENGL_NULL(), DataMode::REPEAT),
+                       MatrixUniforms(OPENGL_NULL(), DataMode::UPDATE),
+                       MatrixUniforms(OPENGL_NULL(), DataMode::MIXED),
+                       VectorUniforms(EGLPlatformParameters(EGL_PLATFORM_ANGLE_TYPE_NULL_ANGLE),
+                                      DataMode::UPDATE),
+                       MatrixUniforms(EGLPlatformParameters(EGL_PLATFORM_ANGLE_TYPE_NULL_ANGLE),
+                                      DataMode::REPEAT),
+                       MatrixUniforms(EGLPlatformParameters(EGL_PLATFORM_ANGLE_TYPE_NULL_ANGLE),
+                                      DataMode::UPDATE),
+                       MatrixUniforms(EGLPlatformParameters(EGL_PLATFORM_ANGLE_TYPE_NULL_ANGLE),
+                                      DataMode::MIXED),
+                       ArrayUniformsWithLocationQueries(D3D11()),
+                       ArrayUniformsWithLocationQueries(OPENGL()),
+                       ArrayUniformsWithLocationQueries(
+                           EGLPlatformParameters(EGL_PLATFORM_ANGLE_TYPE_NULL_ANGLE)));
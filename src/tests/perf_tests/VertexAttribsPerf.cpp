@@ -0,0 +1,136 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// VertexAttribsPerf:
+//   Performance tests for draw calls with many enabled vertex attributes, each sourced from its
+//   own buffer. Stresses the per-attribute range checks done when validating a draw.
+//
+
+#include "ANGLEPerfTest.h"
+#include "DrawCallPerfParams.h"
+#include "shader_utils.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace
+{
+
+constexpr GLuint kMaxAttribs = 16;
+
+class VertexAttribsPerfBenchmark : public ANGLERenderTest,
+                                   public ::testing::WithParamInterface<DrawCallPerfParams>
+{
+  public:
+    VertexAttribsPerfBenchmark();
+
+    void initializeBenchmark() override;
+    void destroyBenchmark() override;
+    void drawBenchmark() override;
+
+  private:
+    GLuint mProgram = 0;
+    std::vector<GLuint> mBuffers;
+};
+
+VertexAttribsPerfBenchmark::VertexAttribsPerfBenchmark()
+    : ANGLERenderTest("VertexAttribsPerf", GetParam())
+{
+    mRunTimeSeconds = GetParam().runTimeSeconds;
+}
+
+void VertexAttribsPerfBenchmark::initializeBenchmark()
+{
+    const auto &params = GetParam();
+
+    ASSERT_LT(0u, params.iterations);
+
+    GLint maxAttribs = 0;
+    glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &maxAttribs);
+    GLuint numAttribs = std::min(static_cast<GLuint>(maxAttribs), kMaxAttribs);
+
+    // Every attribute contributes to the position so none of them is optimized out.
+    std::stringstream vsStream;
+    for (GLuint attribIndex = 0; attribIndex < numAttribs; ++attribIndex)
+    {
+        vsStream << "attribute vec2 a" << attribIndex << ";\n";
+    }
+    vsStream << "void main()\n"
+                "{\n"
+                "    vec2 pos = vec2(0.0);\n";
+    for (GLuint attribIndex = 0; attribIndex < numAttribs; ++attribIndex)
+    {
+        vsStream << "    pos += a" << attribIndex << ";\n";
+    }
+    vsStream << "    gl_Position = vec4(pos, 0.0, 1.0);\n"
+                "}\n";
+
+    const std::string fs =
+        "precision mediump float;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = vec4(1.0, 0.0, 0.0, 1.0);\n"
+        "}\n";
+
+    mProgram = CompileProgram(vsStream.str(), fs);
+    ASSERT_NE(0u, mProgram);
+
+    for (GLuint attribIndex = 0; attribIndex < numAttribs; ++attribIndex)
+    {
+        std::stringstream nameStream;
+        nameStream << "a" << attribIndex;
+        glBindAttribLocation(mProgram, attribIndex, nameStream.str().c_str());
+    }
+    glLinkProgram(mProgram);
+    glUseProgram(mProgram);
+
+    std::vector<GLfloat> vertexData(3 * 2 * params.numTris, 0.0f);
+
+    mBuffers.resize(numAttribs);
+    glGenBuffers(numAttribs, mBuffers.data());
+    for (GLuint attribIndex = 0; attribIndex < numAttribs; ++attribIndex)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, mBuffers[attribIndex]);
+        glBufferData(GL_ARRAY_BUFFER, vertexData.size() * sizeof(GLfloat), vertexData.data(),
+                     GL_STATIC_DRAW);
+        glVertexAttribPointer(attribIndex, 2, GL_FLOAT, GL_FALSE, 0, 0);
+        glEnableVertexAttribArray(attribIndex);
+    }
+
+    glViewport(0, 0, getWindow()->getWidth(), getWindow()->getHeight());
+
+    ASSERT_GL_NO_ERROR();
+}
+
+void VertexAttribsPerfBenchmark::destroyBenchmark()
+{
+    glDeleteProgram(mProgram);
+    glDeleteBuffers(static_cast<GLsizei>(mBuffers.size()), mBuffers.data());
+    mBuffers.clear();
+}
+
+void VertexAttribsPerfBenchmark::drawBenchmark()
+{
+    const auto &params = GetParam();
+
+    for (unsigned int it = 0; it < params.iterations; it++)
+    {
+        glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(3 * params.numTris));
+    }
+
+    ASSERT_GL_NO_ERROR();
+}
+
+TEST_P(VertexAttribsPerfBenchmark, Run)
+{
+    run();
+}
+
+ANGLE_INSTANTIATE_TEST(VertexAttribsPerfBenchmark,
+                       DrawCallPerfD3D11Params(true, false),
+                       DrawCallPerfOpenGLParams(true, false),
+                       DrawCallPerfNULLParams(false));
+
+}  // namespace
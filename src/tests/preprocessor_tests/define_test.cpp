@@ -848,6 +848,22 @@ TEST_F(DefineTest, Predefined_VERSION)
     preprocess(input, expected);
 }
 
+// Test that predefined macros are expanded wherever they are used in a source without directives,
+// and that the tokens around them are kept.
+TEST_F(DefineTest, PredefinedInSourceWithoutDirectives)
+{
+    const char* input =
+        "a b\n"
+        "GL_ES c\n"
+        "__VERSION__ GL_ES d\n";
+    const char* expected =
+        "a b\n"
+        "1 c\n"
+        "100 1 d\n";
+
+    preprocess(input, expected);
+}
+
 TEST_F(DefineTest, Predefined_LINE1)
 {
     const char* str = "\n\n__LINE__";
@@ -717,6 +717,11 @@ void ANGLETest::setRobustResourceInit(bool enabled)
     mEGLWindow->setRobustResourceInit(enabled);
 }
 
+void ANGLETest::setProgramCacheEnabled(bool enabled)
+{
+    mEGLWindow->setProgramCacheEnabled(enabled);
+}
+
 void ANGLETest::setDeferContextInit(bool enabled)
 {
     mDeferContextInit = enabled;
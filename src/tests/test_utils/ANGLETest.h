@@ -242,6 +242,7 @@ class ANGLETest : public ::testing::TestWithParam<angle::PlatformParameters>
     void setVulkanLayersEnabled(bool enabled);
     void setClientArraysEnabled(bool enabled);
     void setRobustResourceInit(bool enabled);
+    void setProgramCacheEnabled(bool enabled);
 
     // Some EGL extension tests would like to defer the Context init until the test body.
     void setDeferContextInit(bool enabled);
@@ -378,6 +378,12 @@ EGLPlatformParameters VULKAN()
     return EGLPlatformParameters(EGL_PLATFORM_ANGLE_TYPE_VULKAN_ANGLE);
 }
 
+EGLPlatformParameters NULL_REFERENCE()
+{
+    return EGLPlatformParameters(EGL_PLATFORM_ANGLE_TYPE_NULL_ANGLE, EGL_DONT_CARE, EGL_DONT_CARE,
+                                 EGL_PLATFORM_ANGLE_DEVICE_TYPE_REFERENCE_ANGLE);
+}
+
 }  // namespace egl_platform
 
 // ANGLE tests platforms
@@ -621,6 +627,11 @@ PlatformParameters ES31_NULL()
     return PlatformParameters(3, 1, EGLPlatformParameters(EGL_PLATFORM_ANGLE_TYPE_NULL_ANGLE));
 }
 
+PlatformParameters ES3_NULL_REFERENCE()
+{
+    return PlatformParameters(3, 0, egl_platform::NULL_REFERENCE());
+}
+
 PlatformParameters ES2_VULKAN()
 {
     return PlatformParameters(2, 0, egl_platform::VULKAN());
@@ -84,6 +84,9 @@ EGLPlatformParameters OPENGLES(EGLint major, EGLint minor);
 
 EGLPlatformParameters VULKAN();
 
+// The null back-end, keeping the texture and renderbuffer data.
+EGLPlatformParameters NULL_REFERENCE();
+
 }  // namespace egl_platform
 
 // ANGLE tests platforms
@@ -144,6 +147,7 @@ PlatformParameters ES31_OPENGLES(EGLint major, EGLint minor);
 PlatformParameters ES2_NULL();
 PlatformParameters ES3_NULL();
 PlatformParameters ES31_NULL();
+PlatformParameters ES3_NULL_REFERENCE();
 
 PlatformParameters ES2_VULKAN();
 
@@ -63,6 +63,8 @@ const char *SimpleFragmentShaderSource()
     // clang-format on
 }
 
+}  // anonymous namespace
+
 void Generate2DTriangleData(size_t numTris, std::vector<float> *floatData)
 {
     for (size_t triIndex = 0; triIndex < numTris; ++triIndex)
@@ -78,8 +80,6 @@ void Generate2DTriangleData(size_t numTris, std::vector<float> *floatData)
     }
 }
 
-}  // anonymous namespace
-
 GLuint SetupSimpleScaleAndOffsetProgram()
 {
     const std::string vs = SimpleScaleAndOffsetVertexShaderSource();
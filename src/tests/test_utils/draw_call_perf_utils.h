@@ -12,6 +12,8 @@
 
 #include <stddef.h>
 
+#include <vector>
+
 #include "angle_gl.h"
 
 // Returns program ID. The program is left in use, no uniforms.
@@ -29,6 +31,9 @@ GLuint SetupSimpleScaleAndOffsetProgram();
 // B-----C
 GLuint Create2DTriangleBuffer(size_t numTris, GLenum usage);
 
+// Appends the coordinates of the triangles of Create2DTriangleBuffer to floatData.
+void Generate2DTriangleData(size_t numTris, std::vector<float> *floatData);
+
 // Creates an FBO with a texture color attachment. The texture is GL_RGBA and has dimensions
 // width/height. The FBO and texture ids are written to the out parameters.
 void CreateColorFBO(GLsizei width, GLsizei height, GLuint *fbo, GLuint *texture);
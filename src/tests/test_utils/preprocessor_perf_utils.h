@@ -0,0 +1,62 @@
+//
+// Copyright 2017 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// preprocessor_perf_utils.h:
+//   Diagnostics and directive handler for performance tests that run the shader preprocessor on
+//   its own, and only need to know whether it reported errors.
+//
+
+#ifndef TESTS_TEST_UTILS_PREPROCESSOR_PERF_UTILS_H_
+#define TESTS_TEST_UTILS_PREPROCESSOR_PERF_UTILS_H_
+
+#include <stddef.h>
+
+#include <string>
+
+#include "compiler/preprocessor/DiagnosticsBase.h"
+#include "compiler/preprocessor/DirectiveHandlerBase.h"
+
+namespace angle
+{
+
+// Counts the errors and warnings instead of formatting them.
+class NullDiagnostics : public pp::Diagnostics
+{
+  public:
+    NullDiagnostics() : mErrorCount(0) {}
+
+    size_t getErrorCount() const { return mErrorCount; }
+
+  protected:
+    void print(ID id, const pp::SourceLocation &loc, const std::string &text) override
+    {
+        ++mErrorCount;
+    }
+
+  private:
+    size_t mErrorCount;
+};
+
+class NullDirectiveHandler : public pp::DirectiveHandler
+{
+  public:
+    void handleError(const pp::SourceLocation &loc, const std::string &msg) override {}
+    void handlePragma(const pp::SourceLocation &loc,
+                      const std::string &name,
+                      const std::string &value,
+                      bool stdgl) override
+    {
+    }
+    void handleExtension(const pp::SourceLocation &loc,
+                         const std::string &name,
+                         const std::string &behavior) override
+    {
+    }
+    void handleVersion(const pp::SourceLocation &loc, int version) override {}
+};
+
+}  // namespace angle
+
+#endif  // TESTS_TEST_UTILS_PREPROCESSOR_PERF_UTILS_H_
@@ -204,6 +204,20 @@
                         'angle_perftests_main.cpp',
                     ],
                 },
+                {
+                    'target_name': 'angle_compiler_perftests',
+                    'type': 'executable',
+                    'includes':
+                    [
+                        '../../gyp/common_defines.gypi',
+                        'angle_compiler_perftests.gypi',
+                    ],
+                    'sources':
+                    [
+                        # The translator is initialized the same way as for the unit tests.
+                        'angle_unittests_main.cpp',
+                    ],
+                },
             ],
         }],
         ['OS=="win"',
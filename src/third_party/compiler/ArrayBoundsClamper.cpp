@@ -25,6 +25,8 @@
 
 #include "third_party/compiler/ArrayBoundsClamper.h"
 
+#include "compiler/translator/PassManager.h"
+
 // The built-in 'clamp' instruction only accepts floats and returns a float.  I
 // iterated a few times with our driver team who examined the output from our
 // compiler - they said the multiple casts generates more code than a single
@@ -44,11 +46,11 @@ namespace sh
 namespace
 {
 
-class ArrayBoundsClamperMarker : public TIntermTraverser {
+class ArrayBoundsClamperMarker : public TTraversalPass {
 public:
-    ArrayBoundsClamperMarker()
-        : TIntermTraverser(true, false, false),
-          mNeedsClamp(false)
+    ArrayBoundsClamperMarker(bool *needsClamp)
+        : TTraversalPass(TreeEdits::DURING_TRAVERSAL),
+          mNeedsClamp(needsClamp)
    {
    }
 
@@ -60,16 +62,14 @@ public:
            if (left->isArray() || left->isVector() || left->isMatrix())
            {
                node->setAddIndexClamp();
-               mNeedsClamp = true;
+               *mNeedsClamp = true;
            }
        }
        return true;
    }
 
-    bool GetNeedsClamp() { return mNeedsClamp; }
-
 private:
-    bool mNeedsClamp;
+    bool *mNeedsClamp;
 };
 
 }  // anonymous namespace
@@ -89,12 +89,14 @@ void ArrayBoundsClamper::MarkIndirectArrayBoundsForClamping(TIntermNode* root)
 {
     ASSERT(root);
 
-    ArrayBoundsClamperMarker clamper;
+    ArrayBoundsClamperMarker clamper(&mArrayBoundsClampDefinitionNeeded);
     root->traverse(&clamper);
-    if (clamper.GetNeedsClamp())
-    {
-        SetArrayBoundsClampDefinitionNeeded();
-    }
+}
+
+std::unique_ptr<TTraversalPass> ArrayBoundsClamper::CreateMarkingPass()
+{
+    return std::unique_ptr<TTraversalPass>(
+        new ArrayBoundsClamperMarker(&mArrayBoundsClampDefinitionNeeded));
 }
 
 void ArrayBoundsClamper::OutputClampingFunctionDefinition(TInfoSinkBase& out) const
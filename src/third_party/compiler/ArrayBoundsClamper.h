@@ -26,12 +26,16 @@
 #ifndef THIRD_PARTY_COMPILER_ARRAYBOUNDSCLAMPER_H_
 #define THIRD_PARTY_COMPILER_ARRAYBOUNDSCLAMPER_H_
 
+#include <memory>
+
 #include "compiler/translator/InfoSink.h"
 #include "compiler/translator/IntermNode.h"
 
 namespace sh
 {
 
+class TTraversalPass;
+
 class ArrayBoundsClamper
 {
   public:
@@ -45,6 +49,10 @@ class ArrayBoundsClamper
     // requiring clamping.
     void MarkIndirectArrayBoundsForClamping(TIntermNode* root);
 
+    // Does the same marking as a pass that can share a traversal with
+    // other passes.
+    std::unique_ptr<TTraversalPass> CreateMarkingPass();
+
     // If necessary, output array clamp function source into the shader source.
     void OutputClampingFunctionDefinition(TInfoSinkBase& out) const;
 
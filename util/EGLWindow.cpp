@@ -117,6 +117,7 @@ EGLWindow::EGLWindow(EGLint glesMajorVersion,
       mBindGeneratesResource(true),
       mClientArraysEnabled(true),
       mRobustResourceInit(false),
+      mProgramCacheEnabled(false),
       mSwapInterval(-1)
 {
 }
@@ -326,6 +327,15 @@ bool EGLWindow::initializeContext()
         return false;
     }
 
+    bool hasProgramCacheControl =
+        strstr(displayExtensions, "EGL_ANGLE_program_cache_control") != nullptr;
+    if (mProgramCacheEnabled && !hasProgramCacheControl)
+    {
+        // Non-default state requested without the extension present
+        destroyGL();
+        return false;
+    }
+
     eglBindAPI(EGL_OPENGL_ES_API);
     if (eglGetError() != EGL_SUCCESS)
     {
@@ -375,6 +385,12 @@ bool EGLWindow::initializeContext()
             contextAttributes.push_back(EGL_CONTEXT_ROBUST_RESOURCE_INITIALIZATION_ANGLE);
             contextAttributes.push_back(mRobustResourceInit ? EGL_TRUE : EGL_FALSE);
         }
+
+        if (hasProgramCacheControl)
+        {
+            contextAttributes.push_back(EGL_CONTEXT_PROGRAM_BINARY_CACHE_ENABLED_ANGLE);
+            contextAttributes.push_back(mProgramCacheEnabled ? EGL_TRUE : EGL_FALSE);
+        }
     }
     contextAttributes.push_back(EGL_NONE);
 
@@ -81,6 +81,7 @@ class ANGLE_EXPORT EGLWindow : angle::NonCopyable
     void setVulkanLayersEnabled(bool enabled) { mVulkanLayersEnabled = enabled; }
     void setClientArraysEnabled(bool enabled) { mClientArraysEnabled = enabled; }
     void setRobustResourceInit(bool enabled) { mRobustResourceInit = enabled; }
+    void setProgramCacheEnabled(bool enabled) { mProgramCacheEnabled = enabled; }
     void setSwapInterval(EGLint swapInterval) { mSwapInterval = swapInterval; }
 
     static EGLBoolean FindEGLConfig(EGLDisplay dpy, const EGLint *attrib_list, EGLConfig *config);
@@ -141,6 +142,7 @@ class ANGLE_EXPORT EGLWindow : angle::NonCopyable
     bool mBindGeneratesResource;
     bool mClientArraysEnabled;
     bool mRobustResourceInit;
+    bool mProgramCacheEnabled;
     EGLint mSwapInterval;
     Optional<bool> mVulkanLayersEnabled;
 };